@@ -0,0 +1,270 @@
+#!/usr/bin/env python3
+"""
+Run the fixed-step benchmark decks in benchmarks/inputs as strong- and/or
+weak-scaling series and summarize the performance summaries written by
+src/exec/main (see 'performance_summary_filename' in the Main database).
+
+Each deck names the initial conditions file it needs in a header comment of
+the form
+
+    // Initial conditions: problems/<application>/initial_conditions/<file>.cpp
+
+When a build directory is given, the script links the initial conditions of
+the application to that file (as described in README.md), rebuilds the main
+executable and keeps a copy of it for the case. The original symlink is
+restored afterwards.
+
+For strong scaling the deck is run unchanged at every process count. For weak
+scaling the number of cells and the extent of the domain in the x-direction
+are multiplied by np/np_min so that the number of cells per process stays
+fixed.
+
+Example:
+
+    python3 benchmarks/run_scaling.py --build-dir build --np 1,2,4,8 \\
+        --threads 1 --mode both --output-dir scaling_results
+"""
+
+import argparse
+import csv
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+BENCHMARKS_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.dirname(BENCHMARKS_DIR)
+INPUTS_DIR = os.path.join(BENCHMARKS_DIR, 'inputs')
+
+APPLICATION_DIRS = {
+    'Euler': ('Euler', 'EulerInitialConditions.cpp'),
+    'NavierStokes': ('Navier-Stokes', 'NavierStokesInitialConditions.cpp'),
+}
+
+SUMMARY_FILENAME = 'performance_summary.json'
+
+CSV_FIELDS = [
+    'case', 'mode', 'np', 'threads', 'cores', 'num_time_steps', 'wallclock_time',
+    'num_cell_updates', 'cell_updates_per_second_per_core', 'parallel_efficiency',
+    'regrid_fraction', 'io_fraction', 'communication_fraction',
+]
+
+
+def parse_int_list(string):
+    return [int(s) for s in string.split(',') if s.strip()]
+
+
+def read_deck_header(deck_path):
+    """
+    Return the application and the initial conditions file named by a deck.
+    """
+    application = None
+    initial_conditions = None
+    with open(deck_path) as f:
+        for line in f:
+            m = re.match(r'\s*//\s*Initial conditions:\s*(\S+)', line)
+            if m:
+                initial_conditions = m.group(1)
+            m = re.match(r'\s*Application\s*=\s*"(\w+)"', line)
+            if m:
+                application = m.group(1)
+    if application is None or initial_conditions is None:
+        raise RuntimeError("Deck '%s' does not name its application and initial conditions." % deck_path)
+    if application not in APPLICATION_DIRS:
+        raise RuntimeError("Unknown application '%s' in deck '%s'." % (application, deck_path))
+    return application, initial_conditions
+
+
+def scale_deck_in_x(deck_text, factor):
+    """
+    Multiply the number of cells and the extent of the domain in the
+    x-direction by an integer factor.
+    """
+    def scale_boxes(m):
+        lo = [int(s) for s in m.group(1).split(',')]
+        hi = [int(s) for s in m.group(2).split(',')]
+        hi[0] = lo[0] + (hi[0] - lo[0] + 1)*factor - 1
+        return 'domain_boxes = [(%s), (%s)]' % (', '.join(map(str, lo)), ', '.join(map(str, hi)))
+
+    def read_reals(name):
+        m = re.search(r'\b%s\s*=\s*([^\n]+)' % name, deck_text)
+        return [float(s) for s in m.group(1).split(',')]
+
+    x_lo = read_reals('x_lo')
+    x_up = read_reals('x_up')
+    x_up[0] = x_lo[0] + (x_up[0] - x_lo[0])*factor
+
+    text, n = re.subn(r'domain_boxes\s*=\s*\[\(([^)]*)\),\s*\(([^)]*)\)\]', scale_boxes, deck_text)
+    if n != 1:
+        raise RuntimeError('Weak scaling needs exactly one box in domain_boxes.')
+    text = re.sub(r'\bx_up\s*=\s*[^\n]+', 'x_up = ' + ', '.join(repr(x) for x in x_up), text)
+    return text
+
+
+def build_executable(build_dir, application, initial_conditions, case_dir):
+    """
+    Link the initial conditions of the application, rebuild main and copy the
+    executable into the case directory.
+    """
+    app_dir, link_name = APPLICATION_DIRS[application]
+    link_path = os.path.join(REPO_DIR, 'src', 'apps', app_dir, link_name)
+    original_target = os.readlink(link_path)
+    try:
+        os.remove(link_path)
+        os.symlink(os.path.join(REPO_DIR, initial_conditions), link_path)
+        subprocess.check_call(['cmake', '--build', build_dir, '--target', 'main'])
+    finally:
+        os.remove(link_path)
+        os.symlink(original_target, link_path)
+
+    executable = os.path.join(case_dir, 'main')
+    shutil.copy2(os.path.join(build_dir, 'src', 'exec', 'main'), executable)
+    return executable
+
+
+def run_case(executable, deck_text, run_dir, launcher, np, threads, dry_run):
+    """
+    Run one deck and return its performance summary.
+    """
+    os.makedirs(run_dir, exist_ok=True)
+    deck_path = os.path.join(run_dir, 'benchmark.input')
+    with open(deck_path, 'w') as f:
+        f.write(deck_text)
+
+    command = launcher.format(np=np).split() + [executable, deck_path]
+    env = dict(os.environ, OMP_NUM_THREADS=str(threads))
+
+    print('[%s] %s' % (run_dir, ' '.join(command)))
+    if dry_run:
+        return None
+
+    with open(os.path.join(run_dir, 'stdout.log'), 'w') as log:
+        status = subprocess.call(command, cwd=run_dir, env=env, stdout=log, stderr=subprocess.STDOUT)
+    if status != 0:
+        print('  run failed with exit status %d, see %s' % (status, os.path.join(run_dir, 'stdout.log')))
+        return None
+
+    with open(os.path.join(run_dir, SUMMARY_FILENAME)) as f:
+        return json.load(f)
+
+
+def write_report(rows, output_dir):
+    csv_path = os.path.join(output_dir, 'scaling_summary.csv')
+    with open(csv_path, 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=CSV_FIELDS)
+        writer.writeheader()
+        for row in rows:
+            writer.writerow(row)
+
+    header = '%-40s %-6s %5s %7s %10s %14s %10s %8s %8s %8s' % (
+        'case', 'mode', 'np', 'threads', 'wall [s]', 'updates/s/core', 'eff', 'regrid', 'I/O', 'comm')
+    print('')
+    print(header)
+    print('-'*len(header))
+    for row in rows:
+        print('%-40s %-6s %5d %7d %10.3f %14.4e %10.3f %8.3f %8.3f %8.3f' % (
+            row['case'], row['mode'], row['np'], row['threads'], row['wallclock_time'],
+            row['cell_updates_per_second_per_core'], row['parallel_efficiency'],
+            row['regrid_fraction'], row['io_fraction'], row['communication_fraction']))
+    print('')
+    print('Summary written to %s' % csv_path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run strong/weak-scaling series of the HAMeRS benchmark decks.')
+    parser.add_argument('--cases', default='',
+        help='Comma-separated deck names without extension (default: all decks in benchmarks/inputs).')
+    parser.add_argument('--mode', choices=['strong', 'weak', 'both'], default='strong')
+    parser.add_argument('--np', type=parse_int_list, default=[1, 2, 4],
+        help='Comma-separated numbers of MPI processes.')
+    parser.add_argument('--threads', type=parse_int_list, default=[1],
+        help='Comma-separated numbers of OpenMP threads per process.')
+    parser.add_argument('--launcher', default='mpirun -np {np}',
+        help="MPI launcher template, '{np}' is replaced by the number of processes.")
+    parser.add_argument('--build-dir', default=None,
+        help='CMake build directory used to rebuild main for the initial conditions of each deck.')
+    parser.add_argument('--executable', default=None,
+        help='Prebuilt executable to use for every deck instead of rebuilding.')
+    parser.add_argument('--output-dir', default='scaling_results')
+    parser.add_argument('--dry-run', action='store_true', help='Only print the commands.')
+    args = parser.parse_args()
+
+    if (args.build_dir is None) == (args.executable is None):
+        parser.error("Exactly one of '--build-dir' and '--executable' has to be given.")
+
+    if args.cases:
+        cases = args.cases.split(',')
+    else:
+        cases = sorted(os.path.splitext(f)[0] for f in os.listdir(INPUTS_DIR) if f.endswith('.input'))
+
+    modes = ['strong', 'weak'] if args.mode == 'both' else [args.mode]
+    np_min = min(args.np)
+
+    output_dir = os.path.abspath(args.output_dir)
+    os.makedirs(output_dir, exist_ok=True)
+
+    rows = []
+    for case in cases:
+        deck_path = os.path.join(INPUTS_DIR, case + '.input')
+        application, initial_conditions = read_deck_header(deck_path)
+        with open(deck_path) as f:
+            deck_text = f.read()
+
+        case_dir = os.path.join(output_dir, case)
+        os.makedirs(case_dir, exist_ok=True)
+
+        if args.executable is not None:
+            executable = os.path.abspath(args.executable)
+        elif args.dry_run:
+            executable = os.path.join(case_dir, 'main')
+        else:
+            executable = build_executable(os.path.abspath(args.build_dir), application, initial_conditions,
+                case_dir)
+
+        for mode in modes:
+            for threads in args.threads:
+                reference = None
+                for np in sorted(args.np):
+                    if mode == 'weak':
+                        if np % np_min != 0:
+                            print('Skipping np = %d for weak scaling: not a multiple of %d.' % (np, np_min))
+                            continue
+                        text = scale_deck_in_x(deck_text, np//np_min)
+                    else:
+                        text = deck_text
+
+                    run_dir = os.path.join(case_dir, '%s_np%d_t%d' % (mode, np, threads))
+                    summary = run_case(executable, text, run_dir, args.launcher, np, threads, args.dry_run)
+                    if summary is None:
+                        continue
+
+                    throughput = summary['cell_updates_per_second_per_core']
+                    if reference is None:
+                        reference = throughput
+
+                    rows.append({
+                        'case': case,
+                        'mode': mode,
+                        'np': np,
+                        'threads': threads,
+                        'cores': summary['num_processes']*summary['num_threads_per_process'],
+                        'num_time_steps': summary['num_time_steps'],
+                        'wallclock_time': summary['wallclock_time'],
+                        'num_cell_updates': summary['num_cell_updates'],
+                        'cell_updates_per_second_per_core': throughput,
+                        'parallel_efficiency': throughput/reference if reference > 0.0 else 0.0,
+                        'regrid_fraction': summary['regrid_fraction'],
+                        'io_fraction': summary['io_fraction'],
+                        'communication_fraction': summary['communication_fraction'],
+                    })
+
+    if not args.dry_run:
+        write_report(rows, output_dir)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -435,6 +435,34 @@ class ExtendedTagAndInitStrategy
             const bool uses_multiresolution_detector_too,
             const bool uses_richardson_extrapolation_too);
         
+        /**
+         * Set integer tags to "one" in cells where refinement of the given
+         * level should occur according to all of the value, gradient,
+         * multiresolution and integral detectors that are used.  The boolean
+         * arguments uses_value_detector, uses_gradient_detector,
+         * uses_multiresolution_detector and uses_integral_detector indicate
+         * which detectors are used.  The other arguments are the same as those
+         * of the individual detectors.
+         *
+         * The default implementation applies the detectors one after another in
+         * the order integral, multiresolution, gradient and value detection.
+         * Implementations may override it to share the ghost cell filling and
+         * the patch loop among the detectors but have to preserve the same
+         * order of tagging on each patch.
+         */
+        virtual void
+        applyMultipleDetectors(
+            const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+            const int level_number,
+            const double error_data_time,
+            const int tag_index,
+            const bool initial_time,
+            const bool uses_value_detector,
+            const bool uses_gradient_detector,
+            const bool uses_multiresolution_detector,
+            const bool uses_integral_detector,
+            const bool uses_richardson_extrapolation_too);
+        
         /**
          * Set integer tags to "one" in cells where refinement of the given
          * level should occur according to some user-supplied Richardson
@@ -483,6 +483,23 @@ class ExtendedTagAndInitialize:
             const hier::BoxContainer& refine_boxes,
             const int level_number);
         
+        /*!
+         * Set the refine boxes of the levels of the initial hierarchy. The refine boxes of a level
+         * are in the index space of the level. While they are set, the refinement only uses these
+         * boxes and no cells are tagged. This is used to rebuild the hierarchy of a restart written
+         * with a different number of processes.
+         */
+        void
+        setInitialHierarchyRefineBoxes(
+            const std::vector<hier::BoxContainer>& refine_boxes);
+        
+        /*!
+         * Clear the refine boxes of the levels of the initial hierarchy so that the refinement
+         * follows the tagging criteria again.
+         */
+        void
+        clearInitialHierarchyRefineBoxes();
+        
         /*!
          * Turn on refine boxes criteria at the specified time programmatically.
          *
@@ -851,6 +868,13 @@ class ExtendedTagAndInitialize:
          */
         int d_old_cycle;
         
+        /*
+         * Refine boxes of the levels of the initial hierarchy (set by the
+         * setInitialHierarchyRefineBoxes() method) and whether they are used.
+         */
+        std::vector<hier::BoxContainer> d_initial_hierarchy_refine_boxes;
+        bool d_use_initial_hierarchy_refine_boxes;
+        
 };
 
 #endif /* EXTENDED_TAG_AND_INITIALIZE_HPP */
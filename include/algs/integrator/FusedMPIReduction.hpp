@@ -0,0 +1,129 @@
+#ifndef FUSED_MPI_REDUCTION_HPP
+#define FUSED_MPI_REDUCTION_HPP
+
+#include "HAMeRS_config.hpp"
+
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+
+#include <vector>
+
+using namespace SAMRAI;
+
+/*!
+ * @brief Class FusedMPIReduction collects the local values of several global reductions of doubles
+ * and reduces them over all processes with as few messages as possible.
+ *
+ * The maxima and the minima (reduced as the maxima of the negated values) are reduced in a single
+ * message and the sums are reduced in another one. The reductions are posted as non-blocking
+ * reductions with post() when MPI-3 is available and are completed with complete(), so that any
+ * local work done in between hides the latency of the reductions and the wait for the slowest
+ * process. Without MPI-3, post() does blocking reductions.
+ *
+ * Usage:
+ *
+ *     FusedMPIReduction reduction(mpi);
+ *     const int dt_idx = reduction.addMin(dt_local);
+ *     reduction.post();
+ *     ... local work ...
+ *     reduction.complete();
+ *     const double dt_global = reduction.getValue(dt_idx);
+ */
+class FusedMPIReduction
+{
+    public:
+        explicit FusedMPIReduction(const tbox::SAMRAI_MPI& mpi);
+        
+        /*
+         * Complete the reductions if they are still pending.
+         */
+        ~FusedMPIReduction();
+        
+        /*!
+         * Add a local value to reduce with the maximum. The index of the value is returned.
+         */
+        int
+        addMax(const double value);
+        
+        /*!
+         * Add a local value to reduce with the minimum. The index of the value is returned.
+         */
+        int
+        addMin(const double value);
+        
+        /*!
+         * Add a local value to reduce with the sum. The index of the value is returned.
+         */
+        int
+        addSum(const double value);
+        
+        /*!
+         * Post the reductions of all the added values.
+         */
+        void
+        post();
+        
+        /*!
+         * Wait for the reductions to complete.
+         */
+        void
+        complete();
+        
+        /*!
+         * Check whether the reductions are posted and not completed yet.
+         */
+        bool
+        isPending() const
+        {
+            return d_is_pending;
+        }
+        
+        /*!
+         * Get the global value of the given index. The reductions must be completed.
+         */
+        double
+        getValue(const int value_idx) const;
+        
+    private:
+        FusedMPIReduction(const FusedMPIReduction&);
+        
+        FusedMPIReduction&
+        operator=(const FusedMPIReduction&);
+        
+        /*
+         * MPI communicator object of the processes to reduce over.
+         */
+        tbox::SAMRAI_MPI d_mpi;
+        
+        /*
+         * Local and global values reduced with the maximum (the minima are negated) and with the
+         * sum.
+         */
+        std::vector<double> d_max_local;
+        std::vector<double> d_max_global;
+        std::vector<double> d_sum_local;
+        std::vector<double> d_sum_global;
+        
+        /*
+         * Location of each added value: the index in the buffers of the maxima or the sums and
+         * whether it is a sum or a negated minimum.
+         */
+        std::vector<int> d_value_buffer_idx;
+        std::vector<int> d_value_types;
+        
+        /*
+         * Whether the reductions are posted and whether they are completed.
+         */
+        bool d_is_pending;
+        bool d_is_completed;
+        
+#if defined(HAVE_MPI) && (MPI_VERSION >= 3)
+        /*
+         * Requests of the non-blocking reductions of the maxima and the sums.
+         */
+        MPI_Request d_requests[2];
+        int d_num_requests;
+#endif
+        
+};
+
+#endif /* FUSED_MPI_REDUCTION_HPP */
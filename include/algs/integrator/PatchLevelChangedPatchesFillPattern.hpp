@@ -0,0 +1,146 @@
+#ifndef PATCH_LEVEL_CHANGED_PATCHES_FILL_PATTERN_HPP
+#define PATCH_LEVEL_CHANGED_PATCHES_FILL_PATTERN_HPP
+
+#include "HAMeRS_config.hpp"
+
+#include "SAMRAI/hier/BoxId.h"
+#include "SAMRAI/hier/BoxLevel.h"
+#include "SAMRAI/hier/Connector.h"
+#include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/xfer/PatchLevelFillPattern.h"
+
+#include "boost/shared_ptr.hpp"
+#include <set>
+#include <string>
+
+using namespace SAMRAI;
+
+/*!
+ * @brief Class PatchLevelChangedPatchesFillPattern is a fill pattern that fills the full ghost
+ * boxes of the destination patches, as xfer::PatchLevelFullFillPattern, except for the patches
+ * that are marked as unchanged.
+ *
+ * The fill pattern is used when a level is regridded. The patches of the new level that have the
+ * same box and owner as the patches of the old level take the patch data of the old patches
+ * without copying and are not filled by the refine schedule. Only the new or changed patches get
+ * fill boxes, so the work of the schedule scales with the change of the level instead of the size
+ * of the level.
+ *
+ * Since the processors owning the source patches do not know which destination patches are
+ * unchanged, the fill boxes are communicated to the source processors.
+ */
+class PatchLevelChangedPatchesFillPattern: public xfer::PatchLevelFillPattern
+{
+    public:
+        /*!
+         * Construct the fill pattern with the box ids of the unchanged local destination patches.
+         */
+        explicit PatchLevelChangedPatchesFillPattern(
+            const std::set<hier::BoxId>& unchanged_box_ids);
+        
+        ~PatchLevelChangedPatchesFillPattern();
+        
+        /*!
+         * Compute the fill boxes of the destination level. The fill box of each changed patch is
+         * its box grown by the fill ghost width. The unchanged patches have no fill boxes.
+         */
+        void
+        computeFillBoxesAndNeighborhoodSets(
+            boost::shared_ptr<hier::BoxLevel>& fill_box_level,
+            boost::shared_ptr<hier::Connector>& dst_to_fill,
+            const hier::BoxLevel& dst_box_level,
+            const hier::IntVector& fill_ghost_width,
+            bool data_on_patch_border);
+        
+        /*!
+         * The destination fill boxes cannot be computed on the source processors and are
+         * communicated. Calling this function is an error.
+         */
+        void
+        computeDestinationFillBoxesOnSourceProc(
+            FillSet& dst_fill_boxes_on_src_proc,
+            const hier::BoxLevel& dst_box_level,
+            const hier::Connector& src_to_dst,
+            const hier::IntVector& fill_ghost_width);
+        
+        /*!
+         * Return true since the source processors do not know the unchanged destination patches.
+         */
+        bool
+        needsToCommunicateDestinationFillBoxes() const
+        {
+            return true;
+        }
+        
+        /*!
+         * Return true since the data is filled from the source level.
+         */
+        bool
+        doesSourceLevelCommunicateToDestination() const
+        {
+            return true;
+        }
+        
+        /*!
+         * Return the maximum number of fill boxes of any destination patch.
+         */
+        int
+        getMaxFillBoxes() const
+        {
+            return d_max_fill_boxes;
+        }
+        
+        /*!
+         * Return true since the ghost cells at the coarse-fine boundaries of the changed patches
+         * are filled.
+         */
+        bool
+        fillingCoarseFineGhosts() const
+        {
+            return true;
+        }
+        
+        /*!
+         * Return false since the fill pattern is not restricted to enhanced connectivity.
+         */
+        bool
+        fillingEnhancedConnectivityOnly() const
+        {
+            return false;
+        }
+        
+        /*!
+         * Return the name of the fill pattern.
+         */
+        const std::string&
+        getPatternName() const
+        {
+            return s_name_id;
+        }
+        
+    private:
+        PatchLevelChangedPatchesFillPattern(
+            const PatchLevelChangedPatchesFillPattern&);
+        
+        PatchLevelChangedPatchesFillPattern&
+        operator=(
+            const PatchLevelChangedPatchesFillPattern&);
+        
+        /*
+         * Box ids of the unchanged local destination patches.
+         */
+        std::set<hier::BoxId> d_unchanged_box_ids;
+        
+        /*
+         * Maximum number of fill boxes of any destination patch.
+         */
+        int d_max_fill_boxes;
+        
+        /*
+         * Name of the fill pattern.
+         */
+        static const std::string s_name_id;
+        
+};
+
+#endif /* PATCH_LEVEL_CHANGED_PATCHES_FILL_PATTERN_HPP */
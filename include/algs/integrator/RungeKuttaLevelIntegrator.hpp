@@ -18,10 +18,14 @@
 
 #include "algs/integrator/ExtendedTagAndInitialize.hpp"
 #include "algs/patch_strategy/RungeKuttaPatchStrategy.hpp"
+#include "extn/restart_hierarchy_data/RestartHierarchyDataReader.hpp"
 
 #include "SAMRAI/algs/TimeRefinementLevelStrategy.h"
 #include "SAMRAI/hier/ComponentSelector.h"
 #include "SAMRAI/hier/BaseGridGeometry.h"
+#include "SAMRAI/hier/BoxContainer.h"
+#include "SAMRAI/hier/BoxId.h"
+#include "SAMRAI/hier/GlobalId.h"
 #include "SAMRAI/hier/Variable.h"
 #include "SAMRAI/hier/VariableContext.h"
 #include "SAMRAI/mesh/GriddingAlgorithm.h"
@@ -29,6 +33,7 @@
 #include "SAMRAI/tbox/Serializable.h"
 #include "SAMRAI/tbox/Timer.h"
 #include "SAMRAI/xfer/CoarsenAlgorithm.h"
+#include "SAMRAI/xfer/CoarsenSchedule.h"
 #include "SAMRAI/xfer/RefineAlgorithm.h"
 #include "SAMRAI/xfer/RefineSchedule.h"
 
@@ -44,6 +49,8 @@
 #include "boost/multi_array.hpp"
 #include <iostream>
 #include <list>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -694,6 +701,32 @@ class RungeKuttaLevelIntegrator:
             const bool uses_multiresolution_detector_too,
             const bool uses_richardson_extrapolation_too);
         
+        /**
+         * Set integer tags to "one" in cells where refinement of the given level should occur
+         * according to all of the value, gradient, multiresolution and integral detectors that are
+         * used. The ghost cells of the scratch data are filled only once for all the detectors and
+         * the cells are tagged by all the detectors in a single loop over the patches. On each patch,
+         * the detectors are applied in the same order as in ExtendedTagAndInitialize, i.e. integral,
+         * multiresolution, gradient and value detection.
+         *
+         * @pre hierarchy
+         * @pre (level_number >= 0) &&
+         *      (level_number <= hierarchy->getFinestLevelNumber())
+         * @pre hierarchy->getPatchLevel(level_number)
+         */
+        virtual void
+        applyMultipleDetectors(
+            const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+            const int level_number,
+            const double error_data_time,
+            const int tag_index,
+            const bool initial_time,
+            const bool uses_value_detector,
+            const bool uses_gradient_detector,
+            const bool uses_multiresolution_detector,
+            const bool uses_integral_detector,
+            const bool uses_richardson_extrapolation_too);
+        
         /**
          * Set integer tags to "one" in cells where refinement of the given level should occur
          * according to some user-supplied Richardson extrapolation criteria. The "error_data_time"
@@ -860,6 +893,16 @@ class RungeKuttaLevelIntegrator:
             return d_scratch;
         }
         
+        /**
+         * Return the variable contexts of the intermediate data of the Runge-Kutta sub-steps. As
+         * the scratch data, the intermediate data contain ghost cells.
+         */
+        const std::vector<boost::shared_ptr<hier::VariableContext> >&
+        getIntermediateContexts() const
+        {
+            return d_intermediate;
+        }
+        
         /**
          * Return pointer to variable context used for plotting. This context corresponds to the
          * data storage that should be written to plot files. Typically, this is the same as the
@@ -881,6 +924,38 @@ class RungeKuttaLevelIntegrator:
            return d_use_time_refinement;
         }
         
+        /*
+         * Return the number of cells advanced by the local processor, accumulated over all the
+         * level advances that are not for regridding.
+         */
+        double
+        getNumberOfLocalCellUpdates() const
+        {
+           return d_num_local_cell_updates;
+        }
+        
+        /**
+         * Return the patch data indices of the time-dependent variables in the "current" context,
+         * which are the patch data written to the restart files.
+         */
+        std::vector<int>
+        getCurrentTimeDependentPatchDataIndices() const;
+        
+#ifdef HAVE_HDF5
+        /**
+         * Set the reader of the hierarchy data of a restart written with a different number of
+         * processes. While the reader is set, the time-dependent data on the levels initialized at
+         * the initial time is read from the restart after the initial conditions are set. The
+         * reader is unset with a null pointer.
+         */
+        void
+        setRestartHierarchyDataReader(
+            const boost::shared_ptr<RestartHierarchyDataReader>& restart_hierarchy_data_reader)
+        {
+            d_restart_hierarchy_data_reader = restart_hierarchy_data_reader;
+        }
+#endif
+        
         /*
          * Write out statistics recorded on numbers of cells and patches generated.
          */
@@ -888,6 +963,18 @@ class RungeKuttaLevelIntegrator:
         printStatistics(
             std::ostream& s = tbox::plog) const;
         
+        /**
+         * Compute the boxes of the cells of a coarse patch that are next to the given footprint of
+         * the finer level on the coarser level and not covered by it. These are the cells refluxed
+         * by the sparse refluxing. The boxes do not overlap, so that the conservative difference is
+         * repeated only once on each cell.
+         */
+        static void
+        computePatchRefluxBoxes(
+            hier::BoxContainer& patch_reflux_boxes,
+            const hier::Box& patch_box,
+            const hier::BoxContainer& fine_footprint);
+        
         /**
          * Returns the object name.
          */
@@ -934,6 +1021,53 @@ class RungeKuttaLevelIntegrator:
         virtual void
         getFromRestart();
         
+        /*
+         * Group the patches of a level into batches. Patches with at most
+         * d_batch_patch_num_cells_threshold cells and the same box dimensions are put into the same
+         * batch. Every other patch forms a batch by itself.
+         */
+        void
+        buildPatchBatches(
+            std::vector<std::vector<boost::shared_ptr<hier::Patch> > >& patch_batches,
+            const boost::shared_ptr<hier::PatchLevel>& level) const;
+        
+        /*
+         * Compute the boxes of the cells of the local patches of the coarser level that are next
+         * to the boundaries of the finer level and not covered by it. Only the patches that
+         * have such cells are inserted into the map.
+         */
+        void
+        computeRefluxBoxes(
+            std::map<hier::GlobalId, hier::BoxContainer>& reflux_boxes,
+            const boost::shared_ptr<hier::PatchLevel>& coarse_level,
+            const boost::shared_ptr<hier::PatchLevel>& fine_level) const;
+        
+        /*
+         * Let the local patches of a new level that have the same boxes as the local patches of
+         * the old level take the patch data of the old patches instead of copying it. The box ids
+         * of the new patches that take the patch data are returned.
+         */
+        void
+        reuseUnchangedPatchData(
+            std::set<hier::BoxId>& unchanged_box_ids,
+            const boost::shared_ptr<hier::PatchLevel>& level,
+            const boost::shared_ptr<hier::PatchLevel>& old_level,
+            const double init_data_time) const;
+        
+        /*
+         * Get the coarsen schedule of the given algorithm between a pair of levels. The schedule
+         * cached in the given container is returned if the levels are the ones in the hierarchy
+         * that it may be cached for. Otherwise, a new schedule is created and it is only cached for
+         * levels in the hierarchy.
+         */
+        boost::shared_ptr<xfer::CoarsenSchedule>
+        getCoarsenSchedule(
+            std::vector<boost::shared_ptr<xfer::CoarsenSchedule> >& coarsen_schedules,
+            const boost::shared_ptr<xfer::CoarsenAlgorithm>& coarsen_algorithm,
+            const boost::shared_ptr<hier::PatchLevel>& coarse_level,
+            const boost::shared_ptr<hier::PatchLevel>& fine_level,
+            xfer::CoarsenPatchStrategy* coarsen_strategy);
+        
         /*
          * Pre-process flux and source storage before advancing solution on level from cur_time to
          * new_time. The boolean flags are used to  determine how flux and flux integral storage
@@ -971,6 +1105,121 @@ class RungeKuttaLevelIntegrator:
             const boost::shared_ptr<hier::VariableContext>& src_context,
             const boost::shared_ptr<hier::VariableContext>& dst_context);
         
+        /*
+         * Copy time-dependent data from source space to destination space on a patch.
+         */
+        void
+        copyTimeDependentDataOnPatch(
+            hier::Patch& patch,
+            const boost::shared_ptr<hier::VariableContext>& src_context,
+            const boost::shared_ptr<hier::VariableContext>& dst_context);
+        
+        /*
+         * Set the time-dependent scratch data on the interior of a patch to the linear
+         * interpolation of the current data and the new data with weight theta for the new data.
+         */
+        void
+        interpolateTimeDependentDataOnPatch(
+            hier::Patch& patch,
+            const double theta);
+        
+        /*
+         * Swap time-dependent data between the scratch space and the intermediate space of a
+         * Runge-Kutta sub-step. The ghost cells of the scratch space are preserved. The data of the
+         * time-dependent variables that are not advanced by the Runge-Kutta update are copied.
+         */
+        void
+        swapTimeDependentData(
+            const boost::shared_ptr<hier::PatchLevel>& level,
+            const boost::shared_ptr<hier::VariableContext>& scratch_context,
+            const boost::shared_ptr<hier::VariableContext>& intermediate_context);
+        
+        /*
+         * Fill the flux and source data of the given context on a patch with zero values.
+         */
+        void
+        fillZeroFluxAndSourceData(
+            hier::Patch& patch,
+            const boost::shared_ptr<hier::VariableContext>& context);
+        
+        /*
+         * Advance the given batches of patches of a level through the sub-steps of the Runge-Kutta
+         * scheme from current_time to current_time + dt. The scratch data is filled at the
+         * beginning of the first sub-step only if fill_first_sub_step is true and the flux and
+         * source data is zeroed at the beginning of the first sub-step only if
+         * zero_fluxes_and_sources is true.
+         */
+        void
+        advanceRungeKuttaSubSteps(
+            const boost::shared_ptr<hier::PatchLevel>& level,
+            const std::vector<std::vector<boost::shared_ptr<hier::Patch> > >& patch_batches,
+            const double current_time,
+            const double dt,
+            const bool fill_first_sub_step,
+            const bool zero_fluxes_and_sources,
+            const bool regrid_advance);
+        
+        /*
+         * Store the stable time increments of the local patches of a level scaled by the given CFL
+         * number.
+         */
+        void
+        storePatchStableDt(
+            const boost::shared_ptr<hier::PatchLevel>& level,
+            const std::map<hier::GlobalId, double>& patch_stable_dt,
+            const double cfl);
+        
+        /*
+         * Check the step just taken on a level with the embedded Runge-Kutta method. The maximum
+         * normalized error estimate over all processes is returned and is_admissible is set to
+         * false if the new solution is not admissible on any patch.
+         */
+        double
+        checkRungeKuttaStep(
+            const boost::shared_ptr<hier::PatchLevel>& level,
+            bool& is_admissible);
+        
+        /*
+         * Compute the maximum normalized error estimate of the embedded Runge-Kutta method on a
+         * patch. is_finite is set to false if any error estimate is not finite.
+         */
+        double
+        computeErrorEstimateOnPatch(
+            const hier::Patch& patch,
+            bool& is_finite) const;
+        
+        /*
+         * Adapt the CFL number with the given normalized error estimate.
+         */
+        void
+        adaptCflNumber(
+            const double error);
+        
+        /*
+         * Advance a level from current_time to current_time + dt with local time stepping. The
+         * patches whose stable time increments are smaller than dt take
+         * d_local_time_stepping_ratio steps of dt/d_local_time_stepping_ratio.
+         */
+        void
+        advanceLevelWithLocalTimeStepping(
+            const boost::shared_ptr<hier::PatchLevel>& level,
+            const std::vector<std::vector<boost::shared_ptr<hier::Patch> > >& patch_batches,
+            const double current_time,
+            const double dt);
+        
+        /*
+         * Replace the fluxes of the slow patches at the faces shared with fast patches by the
+         * fluxes accumulated by the fast patches and repeat the conservative difference on the
+         * cells next to these faces.
+         */
+        void
+        correctFluxesAtLocalTimeSteppingInterfaces(
+            const boost::shared_ptr<hier::PatchLevel>& level,
+            const std::vector<boost::shared_ptr<hier::Patch> >& slow_patches,
+            const std::set<hier::GlobalId>& fast_patch_ids,
+            const double current_time,
+            const double dt);
+        
         /**
          * Apply the standard AMR Runge-Kutta flux synchronization process preserve conservation
          * properties in the solution between the fine level and the coarse level. The sync_time
@@ -1065,6 +1314,15 @@ class RungeKuttaLevelIntegrator:
         std::vector<std::vector<double> > d_beta;
         std::vector<std::vector<double> > d_gamma;
         
+        /*
+         * Weights of the intermediate solutions at the beginning of the sub-steps and of the new
+         * solution that give the difference between the new solution and the solution of the
+         * embedded lower order method, and the order of the embedded method. They are only used
+         * with the adaptive CFL number.
+         */
+        std::vector<double> d_error_estimate_weights;
+        int d_error_estimate_order;
+        
         /*
          * Boolean flags for indicating whether face or side data types are used for fluxes (choice
          * is determined by numerical routines in Runge-Kutta patch model).
@@ -1112,7 +1370,20 @@ class RungeKuttaLevelIntegrator:
          */
         boost::shared_ptr<xfer::RefineAlgorithm> d_bdry_fill_advance_old;
         
+        /*
+         * The "intermediate" algorithms fill the ghost cells of the intermediate data of the
+         * Runge-Kutta sub-steps. The schedules of the levels in the hierarchy are indexed by
+         * [level number][sub-step number] and must be reset each time a level is regridded. The
+         * schedules of the first sub-step are never created since no ghost cells are filled there.
+         */
         std::vector<boost::shared_ptr<xfer::RefineAlgorithm> > d_bdry_fill_intermediate;
+        std::vector<std::vector<boost::shared_ptr<xfer::RefineSchedule> > >
+            d_bdry_sched_intermediate;
+        
+        /*
+         * The levels that the intermediate schedules were created for.
+         */
+        std::vector<boost::shared_ptr<hier::PatchLevel> > d_bdry_sched_intermediate_level;
         
         /*
          * Coarsen algorithms for conservative data synchronization (e.g., flux correction or
@@ -1122,6 +1393,18 @@ class RungeKuttaLevelIntegrator:
         boost::shared_ptr<xfer::CoarsenAlgorithm> d_coarsen_sync_data;
         boost::shared_ptr<xfer::CoarsenAlgorithm> d_sync_initial_data;
         
+        /*
+         * Coarsen schedules for conservative data synchronization, indexed by the number of the
+         * finer level of each pair of levels. The schedules are created the first time they are
+         * needed and are discarded each time the hierarchy configuration is reset. The coarser and
+         * finer levels that the schedules may be cached for are recorded alongside them.
+         */
+        std::vector<boost::shared_ptr<xfer::CoarsenSchedule> > d_coarsen_fluxsum_sched;
+        std::vector<boost::shared_ptr<xfer::CoarsenSchedule> > d_coarsen_sync_sched;
+        std::vector<boost::shared_ptr<xfer::CoarsenSchedule> > d_sync_initial_sched;
+        std::vector<boost::shared_ptr<hier::PatchLevel> > d_coarsen_sched_coarse_level;
+        std::vector<boost::shared_ptr<hier::PatchLevel> > d_coarsen_sched_fine_level;
+        
         /*
          * Coarsen algorithms for Richardson extrapolation.
          */
@@ -1231,6 +1514,116 @@ class RungeKuttaLevelIntegrator:
          */
         bool d_distinguish_mpi_reduction_costs;
         
+        /*
+         * Maximum number of cells of the patches that are batched together when advancing a
+         * level. Batching is disabled if it is zero.
+         */
+        int d_batch_patch_num_cells_threshold;
+        
+        /*
+         * Batches of patches of each hierarchy level and the levels that they are built for. The
+         * batches are rebuilt when the hierarchy configuration is reset after regridding.
+         */
+        std::vector<std::vector<std::vector<boost::shared_ptr<hier::Patch> > > > d_patch_batches;
+        std::vector<boost::shared_ptr<hier::PatchLevel> > d_patch_batches_level;
+        
+        /*
+         * Option to only repeat the conservative difference on the coarse cells next to the
+         * coarse-fine boundaries when synchronizing a level with its coarser level.
+         */
+        bool d_use_sparse_refluxing;
+        
+        /*
+         * Boxes of the cells of the local coarse patches that are refluxed, indexed by the number
+         * of the finer level of each pair of levels. The boxes are recomputed each time the
+         * hierarchy configuration is reset and are only used for the levels recorded in
+         * d_coarsen_sched_coarse_level and d_coarsen_sched_fine_level.
+         */
+        std::vector<std::map<hier::GlobalId, hier::BoxContainer> > d_reflux_boxes;
+        
+        /*
+         * Option to swap the time-dependent patch data between the scratch space and the
+         * intermediate spaces of the Runge-Kutta sub-steps instead of copying them, and whether
+         * the registered time-dependent variables allow the swapping.
+         */
+        bool d_swap_intermediate_data;
+        bool d_intermediate_data_swappable;
+        
+        /*
+         * Time-dependent variables whose data are swapped between the scratch space and the
+         * intermediate spaces (the variables advanced by the Runge-Kutta update) and those whose
+         * data are always copied (e.g. the sensor fields of the refinement taggers).
+         */
+        std::list<boost::shared_ptr<hier::Variable> > d_swapped_time_dep_variables;
+        std::list<boost::shared_ptr<hier::Variable> > d_copied_time_dep_variables;
+        
+        /*
+         * Option to let the patches of a regridded level that have the same box and owner as the
+         * patches of the old level take the patch data of the old patches instead of filling them
+         * with the refine schedule.
+         */
+        bool d_reuse_unchanged_patches_in_regrid;
+        
+        /*
+         * Option to advance the patches of a level with local time stepping and the ratio between
+         * the time increments of the slow patches and the fast patches.
+         */
+        bool d_use_local_time_stepping;
+        int d_local_time_stepping_ratio;
+        
+#ifdef HAVE_HDF5
+        /*
+         * Reader of the hierarchy data of a restart written with a different number of processes.
+         */
+        boost::shared_ptr<RestartHierarchyDataReader> d_restart_hierarchy_data_reader;
+#endif
+        
+        /*
+         * Option to adapt the CFL number (d_cfl) between d_cfl_min and d_cfl_max with the error
+         * estimates of the embedded Runge-Kutta method, the tolerances of the error estimates and
+         * the maximum number of times that a rejected step is retried with smaller sub-steps.
+         */
+        bool d_use_adaptive_cfl;
+        double d_cfl_min;
+        double d_cfl_max;
+        double d_adaptive_cfl_relative_tolerance;
+        double d_adaptive_cfl_absolute_tolerance;
+        int d_max_step_retries;
+        
+        /*
+         * Maximum normalized error estimate of the steps taken on all levels since the CFL number
+         * was last adapted.
+         */
+        double d_adaptive_cfl_error;
+        
+        /*
+         * Number of cells advanced by the local processor.
+         */
+        double d_num_local_cell_updates;
+        
+        /*
+         * Stable time increments of the local patches of each hierarchy level and the levels that
+         * they are computed for.
+         */
+        std::vector<std::map<hier::GlobalId, double> > d_patch_stable_dt;
+        std::vector<boost::shared_ptr<hier::PatchLevel> > d_patch_stable_dt_level;
+        
+        /*
+         * Registers for exchanging the fluxes at the boundaries of the fast patches and the ratios
+         * of the time increments of the patches when local time stepping is used.
+         */
+        std::list<boost::shared_ptr<hier::Variable> > d_flux_register_variables;
+        boost::shared_ptr<hier::Variable> d_patch_rate_variable;
+        hier::ComponentSelector d_flux_register_data;
+        boost::shared_ptr<xfer::RefineAlgorithm> d_fill_flux_register;
+        
+        /*
+         * The schedules of the flux registers of the levels in the hierarchy and the levels that
+         * they were created for. The schedules are reset each time a level is regridded.
+         */
+        std::vector<boost::shared_ptr<xfer::RefineSchedule> > d_fill_flux_register_sched;
+        std::vector<boost::shared_ptr<hier::PatchLevel> > d_fill_flux_register_sched_level;
+        
         static bool s_barrier_after_error_bdry_fill_comm;
         
         /*
@@ -1251,6 +1644,7 @@ class RungeKuttaLevelIntegrator:
         static boost::shared_ptr<tbox::Timer> t_apply_gradient_detector;
         static boost::shared_ptr<tbox::Timer> t_apply_multiresolution_detector;
         static boost::shared_ptr<tbox::Timer> t_apply_integral_detector;
+        static boost::shared_ptr<tbox::Timer> t_apply_multiple_detectors;
         static boost::shared_ptr<tbox::Timer> t_tag_cells;
         static boost::shared_ptr<tbox::Timer> t_coarsen_rich_extrap;
         static boost::shared_ptr<tbox::Timer> t_get_level_dt;
@@ -1258,6 +1652,7 @@ class RungeKuttaLevelIntegrator:
         static boost::shared_ptr<tbox::Timer> t_advance_level;
         static boost::shared_ptr<tbox::Timer> t_new_advance_bdry_fill_comm;
         static boost::shared_ptr<tbox::Timer> t_patch_num_kernel;
+        static boost::shared_ptr<tbox::Timer> t_advance_copy_intermediate_data;
         static boost::shared_ptr<tbox::Timer> t_advance_level_sync;
         static boost::shared_ptr<tbox::Timer> t_std_level_sync;
         static boost::shared_ptr<tbox::Timer> t_sync_new_levels;
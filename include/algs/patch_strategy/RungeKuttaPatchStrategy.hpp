@@ -16,6 +16,7 @@
 
 #include "HAMeRS_config.hpp"
 
+#include "SAMRAI/hier/BoxContainer.h"
 #include "SAMRAI/hier/IntVector.h"
 #include "SAMRAI/hier/PatchData.h"
 #include "SAMRAI/hier/PatchLevel.h"
@@ -174,6 +175,34 @@ class RungeKuttaPatchStrategy:
             const std::vector<boost::shared_ptr<hier::VariableContext> >& intermediate_context)
                 = 0;
         
+        /**
+         * Compute TIME INTEGRALS of fluxes and sources on a batch of patches. The batches are built
+         * by the level integrator and small patches with the same box dimensions are grouped in the
+         * same batch so that the per-patch setup of the numerical routines can be shared. The
+         * default implementation calls computeFluxesAndSourcesOnPatch() on each patch of the batch.
+         */
+        virtual void
+        computeFluxesAndSourcesOnPatchBatch(
+            const std::vector<boost::shared_ptr<hier::Patch> >& patches,
+            const double time,
+            const double dt,
+            const int RK_step_number,
+            const boost::shared_ptr<hier::VariableContext>& data_context = boost::shared_ptr<hier::VariableContext>());
+        
+        /**
+         * Advance a single Runge-Kutta step on a batch of patches. The default implementation calls
+         * advanceSingleStepOnPatch() on each patch of the batch.
+         */
+        virtual void
+        advanceSingleStepOnPatchBatch(
+            const std::vector<boost::shared_ptr<hier::Patch> >& patches,
+            const double time,
+            const double dt,
+            const std::vector<double>& alpha,
+            const std::vector<double>& beta,
+            const std::vector<double>& gamma,
+            const std::vector<boost::shared_ptr<hier::VariableContext> >& intermediate_context);
+        
         /**
          * Correct the fluxes at the coarse-fine boundaries during a flux synchronization step. Note
          * that the computeFluxesAndSourcesOnPatch() routine computes TIME INTEGRALs of the numerical
@@ -186,6 +215,20 @@ class RungeKuttaPatchStrategy:
             const double time,
             const double dt) = 0;
         
+        /**
+         * Correct the fluxes at the coarse-fine boundaries during a flux synchronization step only
+         * on the given boxes of cells of the patch. This is used when the sparse refluxing is
+         * enabled in the level integrator, in which case the ghost cells of the data context are
+         * not filled and only the interior data is valid. The default implementation corrects the
+         * whole patch through synchronizeFluxes().
+         */
+        virtual void
+        synchronizeFluxesOnBoxes(
+            hier::Patch& patch,
+            const double time,
+            const double dt,
+            const hier::BoxContainer& sync_boxes);
+        
         /**
          * This is an optional routine for user to process any application-specific patch strategy
          * data BEFORE patches are advanced on the given level. This routine is called after patch
@@ -484,6 +527,50 @@ class RungeKuttaPatchStrategy:
            const bool uses_multiresolution_detector_too,
            const bool uses_richardson_extrapolation_too);
         
+        /**
+         * This is an optional routine for user to process any application-specific patch strategy
+         * data BEFORE cells are tagged on the given level using more than one of the value,
+         * gradient, multiresolution and integral detectors in a single pass. The booleans
+         * uses_value_detector, uses_gradient_detector, uses_multiresolution_detector and
+         * uses_integral_detector indicate which detectors are used.
+         *
+         * The default implementation calls the preprocessing routines of the detectors that are used
+         * in the order integral, multiresolution, gradient and value detection. Users may override it
+         * to compute the data of all detectors in one loop over the patches and to combine the
+         * reductions of their statistics.
+         */
+        virtual void
+        preprocessTagCellsMultipleDetectors(
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+            const int level_number,
+            const double regrid_time,
+            const bool initial_error,
+            const bool uses_value_detector,
+            const bool uses_gradient_detector,
+            const bool uses_multiresolution_detector,
+            const bool uses_integral_detector,
+            const bool uses_richardson_extrapolation_too);
+        
+        /**
+         * This is an optional routine for user to process any application-specific patch strategy
+         * data AFTER cells are tagged on the given level using more than one of the value, gradient,
+         * multiresolution and integral detectors in a single pass.
+         *
+         * The default implementation calls the postprocessing routines of the detectors that are used
+         * in the order integral, multiresolution, gradient and value detection.
+         */
+        virtual void
+        postprocessTagCellsMultipleDetectors(
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+            const int level_number,
+            const double regrid_time,
+            const bool initial_error,
+            const bool uses_value_detector,
+            const bool uses_gradient_detector,
+            const bool uses_multiresolution_detector,
+            const bool uses_integral_detector,
+            const bool uses_richardson_extrapolation_too);
+        
         /**
          * Tag cells based from differences computed in the Richardson extrapolation. The Richardson
          * extrapolation algorithm creates a coarsened version of some hierarchy patch level and
@@ -551,6 +638,34 @@ class RungeKuttaPatchStrategy:
             const double fill_time,
             const hier::IntVector& ghost_width_to_fill) = 0;
         
+        /**
+         * This is an optional routine for user to check whether the state of the current data
+         * context on the interior of the patch is admissible (e.g. positive density and pressure).
+         * This routine is called by the integrator after each step when the adaptive CFL number is
+         * used and the steps with inadmissible states are rejected and retried.
+         *
+         * Note that this function is not pure virtual. It is given a dummy implementation here so
+         * that users may ignore it when inheriting from this class.
+         */
+        virtual bool
+        isStateAdmissibleOnPatch(
+            hier::Patch& patch);
+        
+        /**
+         * This is an optional routine for user to update any application-specific patch strategy
+         * data that depends on the configuration of the patches (e.g. data cached per patch) after
+         * the levels in the range coarsest_level to finest_level of the hierarchy are reset. This
+         * routine is called from RungeKuttaLevelIntegrator::resetHierarchyConfiguration().
+         *
+         * Note that this function is not pure virtual. It is given a dummy implementation here so
+         * that users may ignore it when inheriting from this class.
+         */
+        virtual void
+        resetHierarchyConfiguration(
+            const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+            const int coarsest_level,
+            const int finest_level);
+        
         /**
          * Output the statistics of data.
          */
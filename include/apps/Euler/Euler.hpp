@@ -12,6 +12,7 @@
 #include "flow/flow_models/FlowModelManager.hpp"
 #include "flow/refinement_taggers/GradientTagger.hpp"
 #include "flow/refinement_taggers/MultiresolutionTagger.hpp"
+#include "flow/refinement_taggers/RefinementTaggerStatistics.hpp"
 #include "flow/refinement_taggers/ValueTagger.hpp"
 
 #include "SAMRAI/appu/VisDerivedDataStrategy.h"
@@ -160,6 +161,17 @@ class Euler:
             const double time,
             const double dt);
         
+        /**
+         * Correct the solution variables on the given boxes of cells at coarse-fine boundaries by
+         * repeating conservative differencing with corrected fluxes.
+         */
+        void
+        synchronizeFluxesOnBoxes(
+            hier::Patch& patch,
+            const double time,
+            const double dt,
+            const hier::BoxContainer& sync_boxes);
+        
         /**
          * Preprocess before tagging cells using value detector.
          */
@@ -244,6 +256,42 @@ class Euler:
             const bool uses_integral_detector_too,
             const bool uses_richardson_extrapolation_too);
         
+        /**
+         * Preprocess before tagging cells using more than one detector. The values of all the
+         * taggers are computed in a single loop over the patches and their statistics are reduced
+         * together.
+         */
+        void
+        preprocessTagCellsMultipleDetectors(
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+            const int level_number,
+            const double regrid_time,
+            const bool initial_error,
+            const bool uses_value_detector,
+            const bool uses_gradient_detector,
+            const bool uses_multiresolution_detector,
+            const bool uses_integral_detector,
+            const bool uses_richardson_extrapolation_too);
+        
+        /**
+         * Update the descriptors of the physical boundary boxes of the patches cached by the
+         * boundary conditions object after the levels in the range coarsest_level to finest_level
+         * of the hierarchy are reset.
+         */
+        void
+        resetHierarchyConfiguration(
+            const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+            const int coarsest_level,
+            const int finest_level);
+        
+        /**
+         * Check whether the density and the pressure of the state of the current data context
+         * are positive and finite on the interior of the patch.
+         */
+        bool
+        isStateAdmissibleOnPatch(
+            hier::Patch& patch);
+        
         //@{
         //! @name Required implementations of RungeKuttaPatchStrategy pure virtuals.
         
@@ -8,6 +8,10 @@
 #include "util/basic_boundary_conditions/BasicBoundaryConditions.hpp"
 #include "util/basic_boundary_conditions/BoundaryUtilityStrategy.hpp"
 #include "util/basic_boundary_conditions/CartesianBoundaryDefines.hpp"
+#include "util/basic_boundary_conditions/PatchBoundaryDescriptor.hpp"
+
+#include "SAMRAI/hier/GlobalId.h"
+#include "SAMRAI/hier/PatchHierarchy.h"
 
 #include "boost/shared_ptr.hpp"
 #include <map>
@@ -83,7 +87,27 @@ class NavierStokesBoundaryConditions:
             const hier::IntVector& ghost_width_to_fill,
             const boost::shared_ptr<hier::VariableContext>& data_context);
         
+        /*
+         * Build the descriptors of the physical boundary boxes of the patches on the levels in
+         * the range coarsest_level to finest_level of the hierarchy. The descriptors are used to
+         * fill the ghost cells at the physical boundaries until the levels are reset again.
+         */
+        void
+        resetHierarchyConfiguration(
+            const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+            const int coarsest_level,
+            const int finest_level);
+    
     private:
+        /*
+         * Get the descriptor of the physical boundary boxes of the patch. The cached descriptor is
+         * returned if it is built for the patch. Otherwise (e.g. the patch is a temporary patch
+         * created by a communication schedule), a new descriptor is built.
+         */
+        boost::shared_ptr<PatchBoundaryDescriptor>
+        getPatchBoundaryDescriptor(
+            const hier::Patch& patch) const;
+        
         std::vector<double>
         readPrimitiveDataEntry(
             boost::shared_ptr<tbox::Database> db,
@@ -160,6 +184,12 @@ class NavierStokesBoundaryConditions:
         std::vector<std::vector<double> > d_bdry_edge_conservative_var;
         std::vector<std::vector<double> > d_bdry_face_conservative_var;
         
+        /*
+         * Cached descriptors of the physical boundary boxes of the patches on each level.
+         */
+        std::vector<std::map<hier::GlobalId, boost::shared_ptr<PatchBoundaryDescriptor> > >
+            d_patch_bdry_descriptors;
+        
         /*
          * boost::shared_ptr to the special boundary conditions.
          */
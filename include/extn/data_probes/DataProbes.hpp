@@ -0,0 +1,266 @@
+#ifndef DATA_PROBES_HPP
+#define DATA_PROBES_HPP
+
+#include "HAMeRS_config.hpp"
+
+#include "SAMRAI/geom/CartesianGridGeometry.h"
+#include "SAMRAI/hier/BoxId.h"
+#include "SAMRAI/hier/Index.h"
+#include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/hier/PatchHierarchy.h"
+#include "SAMRAI/hier/PatchLevel.h"
+#include "SAMRAI/hier/VariableContext.h"
+#include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/Dimension.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/Timer.h"
+
+#include "boost/shared_ptr.hpp"
+#include "boost/weak_ptr.hpp"
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace SAMRAI;
+
+namespace DATA_PROBE
+{
+    enum TYPE { POINT,
+                LINE,
+                PLANE,
+                SURFACE_INTEGRAL };
+}
+
+/*!
+ * @brief Class DataProbes samples the cell data of the hierarchy at a few locations every given
+ * number of steps and records the time series in memory, which is much cheaper than dumping the
+ * whole hierarchy for high-frequency diagnostics.
+ *
+ * The probes are:
+ *
+ *     POINT            - the cell values at a point
+ *     LINE             - the cell values at equally spaced points on a line segment
+ *     PLANE            - the cell values at equally spaced points on a parallelogram
+ *     SURFACE_INTEGRAL - the integrals of the cell values over a plane normal to a coordinate
+ *                        direction that cuts through the whole domain
+ *
+ * All the probes use the data of the finest level that covers each location. The cells of the
+ * local patches sampled by the probes and the weights of the cells are looked up once and reused
+ * until the hierarchy is regridded, so each sample only costs a few memory reads per probe
+ * location. The samples of all the probes are summed to the first process in a single reduction,
+ * where they are buffered and appended to one text file per probe when the buffer is full or the
+ * data is flushed.
+ *
+ * Input database parameters:
+ *
+ *     probe_dirname   - directory of the files of the probes (default "probes")
+ *     sample_interval - number of steps between the samples (default 1)
+ *     buffer_size     - number of samples buffered in memory before they are appended to the
+ *                       files (default 1000)
+ *     variables       - names of the cell variables to sample
+ *
+ * and one sub-database for each probe, whose name is the name of the probe:
+ *
+ *     type               - "POINT", "LINE", "PLANE" or "SURFACE_INTEGRAL"
+ *     point              - coordinates of the point (POINT)
+ *     start_point        - coordinates of the start of the line segment (LINE)
+ *     end_point          - coordinates of the end of the line segment (LINE)
+ *     number_of_points   - number of points on the line segment (LINE) or along the two edges
+ *                          of the parallelogram (PLANE)
+ *     corner_point       - coordinates of a corner of the parallelogram (PLANE)
+ *     first_edge         - vector of the first edge of the parallelogram from the corner (PLANE)
+ *     second_edge        - vector of the second edge of the parallelogram from the corner (PLANE)
+ *     normal_direction   - coordinate direction normal to the plane (SURFACE_INTEGRAL)
+ *     coordinate         - coordinate of the plane in the normal direction (SURFACE_INTEGRAL)
+ *
+ * Each row of the file of a probe has the time followed by all the components of the variables
+ * at each point of the probe, or by the integrals of all the components of the variables.
+ */
+class DataProbes
+{
+    public:
+        DataProbes(
+            const std::string& object_name,
+            const tbox::Dimension& dim,
+            const boost::shared_ptr<tbox::Database>& input_db,
+            const boost::shared_ptr<geom::CartesianGridGeometry>& grid_geometry,
+            const boost::shared_ptr<hier::VariableContext>& data_context);
+        
+        /*
+         * Write the data that is still buffered.
+         */
+        ~DataProbes();
+        
+        /*!
+         * Sample the data of all the probes if the step number is a multiple of the sample
+         * interval. This function must be called by all processes.
+         */
+        void
+        sampleData(
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+            const int step_num,
+            const double time);
+        
+        /*!
+         * Append the buffered samples to the files of the probes.
+         */
+        void
+        flushData();
+        
+        /*!
+         * Print all characteristics of the data probes.
+         */
+        void
+        printClassData(std::ostream& os) const;
+        
+    private:
+        DataProbes(const DataProbes&);
+        
+        DataProbes&
+        operator=(const DataProbes&);
+        
+        /*
+         * Read the probes from the input database.
+         */
+        void
+        getFromInput(const boost::shared_ptr<tbox::Database>& input_db);
+        
+        /*
+         * Read the coordinates of a point or the components of a vector of a probe from the input
+         * database.
+         */
+        std::vector<double>
+        getCoordinatesFromInput(
+            const boost::shared_ptr<tbox::Database>& probe_db,
+            const std::string& probe_name,
+            const std::string& key) const;
+        
+        /*
+         * Get the name of the file of a probe.
+         */
+        std::string
+        getProbeFilename(const int probe_index) const;
+        
+        /*
+         * Write the headers describing the columns to the files of the probes.
+         */
+        void
+        writeFileHeaders() const;
+        
+        /*
+         * Check whether the levels of the hierarchy are the ones of the looked up probe cells.
+         */
+        bool
+        isProbeCellsUpToDate(
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy) const;
+        
+        /*
+         * Look up the cells of the local patches sampled by the probes and their weights.
+         */
+        void
+        setupProbeCells(
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy);
+        
+        /*
+         * Get the index of the cell containing a point on a level with the given refinement ratio
+         * to level zero. The points on the boundary of the domain are moved into the domain.
+         */
+        hier::Index
+        getCellIndexOfPoint(
+            const std::vector<double>& point,
+            const hier::IntVector& ratio_to_level_zero) const;
+        
+        /*
+         * The object name is used for error/warning reporting.
+         */
+        const std::string d_object_name;
+        
+        /*
+         * Problem dimension.
+         */
+        const tbox::Dimension d_dim;
+        
+        /*
+         * boost::shared_ptr to the grid geometry.
+         */
+        const boost::shared_ptr<geom::CartesianGridGeometry> d_grid_geometry;
+        
+        /*
+         * MPI communicator object of the processes sampling the data.
+         */
+        const tbox::SAMRAI_MPI d_mpi;
+        
+        /*
+         * Settings of the sampling and of the output.
+         */
+        std::string d_probe_dirname;
+        int d_sample_interval;
+        int d_buffer_size;
+        
+        /*
+         * Names, depths and patch data indices of the sampled variables, and the total number of
+         * their components.
+         */
+        std::vector<std::string> d_variable_names;
+        std::vector<int> d_variable_depths;
+        std::vector<int> d_data_ids;
+        int d_num_components;
+        
+        /*
+         * Names, types and points of the probes. The point probes, the line probes and the plane
+         * probes are all sets of points.
+         */
+        std::vector<std::string> d_probe_names;
+        std::vector<DATA_PROBE::TYPE> d_probe_types;
+        std::vector<std::vector<std::vector<double> > > d_probe_points;
+        
+        /*
+         * Normal directions and coordinates of the planes of the surface integrals. They are not
+         * used by the other probes.
+         */
+        std::vector<int> d_probe_normal_directions;
+        std::vector<double> d_probe_coordinates;
+        
+        /*
+         * Number of samples of each probe, which is the number of points or one for the surface
+         * integrals, and the offsets of the samples of the probes in the sample buffer.
+         */
+        std::vector<int> d_probe_num_samples;
+        std::vector<int> d_probe_sample_offsets;
+        int d_sample_buffer_size;
+        
+        /*
+         * Struct of a cell of a local patch sampled by a probe. The weighted values of the
+         * components of the variables in the cell are added to the sample buffer from the offset.
+         */
+        struct probeCellStruct
+        {
+            hier::Index cell_index;
+            int sample_offset;
+            double weight;
+        };
+        
+        /*
+         * Cells of the local patches sampled by the probes on all the levels and the levels
+         * they were looked up on.
+         */
+        std::vector<std::map<hier::BoxId, std::vector<probeCellStruct> > > d_probe_cells;
+        std::vector<boost::weak_ptr<hier::PatchLevel> > d_probe_cell_levels;
+        
+        /*
+         * Times and samples buffered on the first process.
+         */
+        std::vector<double> d_buffered_times;
+        std::vector<double> d_buffered_samples;
+        
+        /*
+         * Timers of the samples and the writes of the data.
+         */
+        static boost::shared_ptr<tbox::Timer> t_sample_data;
+        static boost::shared_ptr<tbox::Timer> t_setup_probe_cells;
+        static boost::shared_ptr<tbox::Timer> t_flush_data;
+        
+};
+
+#endif /* DATA_PROBES_HPP */
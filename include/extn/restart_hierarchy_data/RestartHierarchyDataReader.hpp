@@ -0,0 +1,149 @@
+#ifndef RESTART_HIERARCHY_DATA_READER_HPP
+#define RESTART_HIERARCHY_DATA_READER_HPP
+
+#include "HAMeRS_config.hpp"
+
+/*
+ * This class is undefined if the library is built without HDF5.
+ */
+#ifdef HAVE_HDF5
+
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/BoxContainer.h"
+#include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/hier/PatchHierarchy.h"
+#include "SAMRAI/hier/PatchLevel.h"
+#include "SAMRAI/tbox/Dimension.h"
+#include "SAMRAI/tbox/Timer.h"
+
+#include "boost/shared_ptr.hpp"
+#include <string>
+#include <vector>
+
+using namespace SAMRAI;
+
+/*!
+ * @brief Class RestartHierarchyDataReader reads the hierarchy data written by
+ * RestartHierarchyDataWriter to restart a simulation with a number of processes different from
+ * the number of processes that wrote the restart files.
+ *
+ * The time, the step number and the boxes of all the levels are read by the first process and
+ * broadcast to the others when the reader is constructed. The boxes are used to build the levels
+ * of the initial hierarchy, which are then load balanced for the current number of processes.
+ * After that, each process reads the data of only its own patches with hyperslab selections of
+ * the overlapping boxes in the file.
+ */
+class RestartHierarchyDataReader
+{
+    public:
+        RestartHierarchyDataReader(
+            const std::string& object_name,
+            const std::string& filename,
+            const tbox::Dimension& dim);
+        
+        ~RestartHierarchyDataReader();
+        
+        /*!
+         * Get the simulation time of the data.
+         */
+        double
+        getTime() const
+        {
+            return d_time;
+        }
+        
+        /*!
+         * Get the step number of the data.
+         */
+        int
+        getStep() const
+        {
+            return d_step;
+        }
+        
+        /*!
+         * Get the number of levels of the hierarchy.
+         */
+        int
+        getNumberOfLevels() const
+        {
+            return static_cast<int>(d_level_boxes.size());
+        }
+        
+        /*!
+         * Get the refine boxes of the coarser levels that reproduce the finer levels of the
+         * hierarchy. The refine boxes of a level are the boxes of the next finer level coarsened
+         * to the index space of the level. The refinement ratios of the given hierarchy should be
+         * the same as the ones of the hierarchy data.
+         */
+        void
+        getRefineBoxes(
+            std::vector<hier::BoxContainer>& refine_boxes,
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy) const;
+        
+        /*!
+         * Read the cell data of the given patch data indices on the local patches of the level.
+         * All the patch data should be allocated pdat::CellData<double>. The cells that are not
+         * covered by the boxes of the level in the file are left unchanged. This function must be
+         * called by all processes.
+         */
+        void
+        readLevelData(
+            const boost::shared_ptr<hier::PatchLevel>& level,
+            const std::vector<int>& data_ids) const;
+        
+    private:
+        RestartHierarchyDataReader(const RestartHierarchyDataReader&);
+        
+        RestartHierarchyDataReader&
+        operator=(const RestartHierarchyDataReader&);
+        
+        /*
+         * Read the time, the step number and the boxes of all the levels from the file. This
+         * function is only called by the first process.
+         */
+        void
+        readHierarchyMetadata(
+            std::vector<int>& int_buffer,
+            double& time) const;
+        
+        /*
+         * The object name is used for error/warning reporting.
+         */
+        const std::string d_object_name;
+        
+        /*
+         * Name of the file of the hierarchy data.
+         */
+        const std::string d_filename;
+        
+        /*
+         * Problem dimension.
+         */
+        const tbox::Dimension d_dim;
+        
+        /*
+         * Simulation time and step number of the data.
+         */
+        double d_time;
+        int d_step;
+        
+        /*
+         * Refinement ratios to level zero, boxes and offsets of the data of the boxes in the
+         * datasets of all the levels.
+         */
+        std::vector<hier::IntVector> d_level_ratios_to_level_zero;
+        std::vector<std::vector<hier::Box> > d_level_boxes;
+        std::vector<std::vector<size_t> > d_level_box_offsets;
+        std::vector<size_t> d_level_num_cells;
+        
+        /*
+         * Timer of the reads of the hierarchy data.
+         */
+        static boost::shared_ptr<tbox::Timer> t_read_level_data;
+        
+};
+
+#endif /* HAVE_HDF5 */
+
+#endif /* RESTART_HIERARCHY_DATA_READER_HPP */
@@ -0,0 +1,102 @@
+#ifndef RESTART_HIERARCHY_DATA_WRITER_HPP
+#define RESTART_HIERARCHY_DATA_WRITER_HPP
+
+#include "HAMeRS_config.hpp"
+
+/*
+ * This class is undefined if the library is built without HDF5.
+ */
+#ifdef HAVE_HDF5
+
+#include "SAMRAI/hier/PatchHierarchy.h"
+#include "SAMRAI/tbox/Dimension.h"
+#include "SAMRAI/tbox/Timer.h"
+
+#include "boost/shared_ptr.hpp"
+#include <string>
+#include <vector>
+
+using namespace SAMRAI;
+
+/*!
+ * @brief Class RestartHierarchyDataWriter writes the boxes and the cell data of a patch hierarchy
+ * to a single HDF5 file whose layout does not depend on the number of processes or on the
+ * decomposition of the levels into patches. The file is read with RestartHierarchyDataReader to
+ * restart a simulation with a different number of processes.
+ *
+ * Layout of the file:
+ *
+ *     dim                            - dimension of the problem
+ *     time                           - simulation time of the data
+ *     step                           - step number of the data
+ *     number_of_levels               - number of levels of the hierarchy
+ *     level_NNNN/ratio_to_level_zero - refinement ratio of the level to level zero
+ *     level_NNNN/boxes               - lower and upper indices of all the boxes of the level,
+ *                                      ordered by the box ids
+ *     level_NNNN/<variable name>     - cell data of the variable on the level
+ *
+ * The cell data of a variable on a level is stored box after box in the order of the boxes. The
+ * data of each box is stored component after component without ghost cells and with the first
+ * index varying the fastest, which is the layout of pdat::ArrayData. A sub-box of a box is then
+ * selected with a few strided hyperslabs.
+ *
+ * If HDF5 is built with MPI-IO, the processes write the data of their patches to the file
+ * concurrently. Otherwise, they write to the file one after another.
+ */
+class RestartHierarchyDataWriter
+{
+    public:
+        RestartHierarchyDataWriter(
+            const std::string& object_name,
+            const tbox::Dimension& dim);
+        
+        ~RestartHierarchyDataWriter();
+        
+        /*!
+         * Write the cell data of the given patch data indices on all the levels of the hierarchy
+         * to the file. All the patch data should be pdat::CellData<double>. This function must be
+         * called by all processes.
+         */
+        void
+        writeHierarchyData(
+            const std::string& filename,
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+            const std::vector<int>& data_ids,
+            const double time,
+            const int step) const;
+        
+        /*!
+         * Get the name of the file of the hierarchy data of a restore number in the restart
+         * directory.
+         */
+        static std::string
+        getHierarchyDataFilename(
+            const std::string& restart_dirname,
+            const int restore_num);
+        
+    private:
+        RestartHierarchyDataWriter(const RestartHierarchyDataWriter&);
+        
+        RestartHierarchyDataWriter&
+        operator=(const RestartHierarchyDataWriter&);
+        
+        /*
+         * The object name is used for error/warning reporting.
+         */
+        const std::string d_object_name;
+        
+        /*
+         * Problem dimension.
+         */
+        const tbox::Dimension d_dim;
+        
+        /*
+         * Timer of the writes of the hierarchy data.
+         */
+        static boost::shared_ptr<tbox::Timer> t_write_hierarchy_data;
+        
+};
+
+#endif /* HAVE_HDF5 */
+
+#endif /* RESTART_HIERARCHY_DATA_WRITER_HPP */
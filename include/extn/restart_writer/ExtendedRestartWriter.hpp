@@ -0,0 +1,231 @@
+#ifndef EXTENDED_RESTART_WRITER_HPP
+#define EXTENDED_RESTART_WRITER_HPP
+
+#include "HAMeRS_config.hpp"
+
+#include "extn/restart_hierarchy_data/RestartHierarchyDataWriter.hpp"
+
+#include "SAMRAI/hier/PatchHierarchy.h"
+#include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/Timer.h"
+
+#include "boost/shared_ptr.hpp"
+#include <deque>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SAMRAI;
+
+/*!
+ * @brief Class ExtendedRestartWriter writes the restart files with SAMRAI::tbox::RestartManager
+ * and adds an asynchronous mode and a retention policy to it.
+ *
+ * In the blocking mode, the restart files are written directly to the restart directory as
+ * tbox::RestartManager::writeRestartFile() does.
+ *
+ * In the asynchronous mode, the restart files are first written to a staging directory, which
+ * should be on node-local storage such as a local disk or a memory file system (e.g. /dev/shm).
+ * Writing the snapshot there is much faster than writing to the parallel file system. Each process
+ * then copies its own restart file from the staging directory to the restart directory in a
+ * background thread while the simulation continues, and removes the staged file. The background
+ * thread only does file I/O and never calls MPI or SAMRAI. A restart is complete once all processes
+ * have finished copying, which is checked collectively before the next restart is written and in
+ * finalize().
+ *
+ * With the retention policy, only the given number of the most recent complete restarts written
+ * in the run are kept in the restart directory and the older ones are removed. The restarts of
+ * previous runs are never removed.
+ *
+ * The restart files written in either mode have the same layout as the ones written by
+ * tbox::RestartManager and are read in the usual way, which requires the same number of
+ * processes. With write_hierarchy_data, the boxes and the data of the hierarchy are also written
+ * to a single file of each restart with RestartHierarchyDataWriter, which can be read with any
+ * number of processes. This file is written directly to the restart directory, also in the
+ * asynchronous mode.
+ *
+ * Input database parameters (all optional):
+ *
+ *     use_asynchronous_writes    - whether the restart files are written asynchronously
+ *                                  (default FALSE)
+ *     staging_dirname            - staging directory of the asynchronous writes (required if
+ *                                  use_asynchronous_writes is TRUE)
+ *     number_of_restarts_to_keep - number of the most recent restarts kept in the restart
+ *                                  directory, zero to keep all restarts (default 0)
+ *     write_hierarchy_data       - whether the hierarchy data that can be read with a different
+ *                                  number of processes is also written (default FALSE)
+ */
+class ExtendedRestartWriter
+{
+    public:
+        /*!
+         * Construct the restart writer for the given restart directory. The input database may
+         * be null, in which case the restart files are written in the blocking mode and all of
+         * them are kept.
+         */
+        ExtendedRestartWriter(
+            const std::string& object_name,
+            const std::string& restart_write_dirname,
+            const boost::shared_ptr<tbox::Database>& input_db);
+        
+        /*
+         * Wait for the background copy if it is still running.
+         */
+        ~ExtendedRestartWriter();
+        
+        /*!
+         * Set the hierarchy and the patch data indices of the hierarchy data. This function must be
+         * called before any restart is written if the hierarchy data is written.
+         */
+        void
+        setHierarchyData(
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+            const std::vector<int>& data_ids);
+        
+        /*!
+         * Write the restart files of the given restore number and simulation time. This function
+         * must be called by all processes.
+         */
+        void
+        writeRestartFile(
+            const int restore_num,
+            const double restore_time);
+        
+        /*!
+         * Wait for the restart files written asynchronously to be copied to the restart directory
+         * and apply the retention policy. This function must be called by all processes before
+         * MPI is finalized.
+         */
+        void
+        finalize();
+        
+        /*!
+         * Print all characteristics of the restart writer.
+         */
+        void
+        printClassData(std::ostream& os) const;
+        
+    private:
+        ExtendedRestartWriter(const ExtendedRestartWriter&);
+        
+        ExtendedRestartWriter&
+        operator=(const ExtendedRestartWriter&);
+        
+        /*
+         * Wait for the background copy of the last asynchronous restart to finish, check that it
+         * succeeded on all processes and apply the retention policy.
+         */
+        void
+        waitForPendingRestart();
+        
+        /*
+         * Remove the oldest complete restarts from the restart directory so that only the given
+         * number of the most recent ones are kept.
+         */
+        void
+        removeOldRestarts();
+        
+        /*
+         * Write the hierarchy data of the given restore number and simulation time to the restart
+         * directory.
+         */
+        void
+        writeHierarchyData(
+            const int restore_num,
+            const double restore_time);
+        
+        /*
+         * Get the name of the directory of the restart files of a restore number in a root
+         * directory, without the sub-directory of the number of processes.
+         */
+        static std::string
+        getRestoreDirname(
+            const std::string& root_dirname,
+            const int restore_num);
+        
+        /*
+         * Get the name of the directory of the restart files of a restore number in a root
+         * directory, including the sub-directory of the number of processes.
+         */
+        static std::string
+        getRestoreNodesDirname(
+            const std::string& root_dirname,
+            const int restore_num,
+            const int num_procs);
+        
+        /*
+         * Copy a staged restart file to the restart directory and remove the staged file. This
+         * function is run in the background thread and does not call MPI or SAMRAI.
+         */
+        static void
+        drainStagedRestartFile(
+            const std::string staged_filename,
+            const std::string restart_filename,
+            bool* is_drain_successful);
+        
+        /*
+         * Remove a directory and all its contents.
+         */
+        static void
+        removeDirectory(const std::string& dirname);
+        
+        /*
+         * The object name is used for error/warning reporting.
+         */
+        const std::string d_object_name;
+        
+        /*
+         * MPI communicator object of the processes writing the restart files.
+         */
+        const tbox::SAMRAI_MPI d_mpi;
+        
+        /*
+         * Directory of the restart files.
+         */
+        const std::string d_restart_write_dirname;
+        
+        /*
+         * Settings of the asynchronous writes.
+         */
+        bool d_use_asynchronous_writes;
+        std::string d_staging_dirname;
+        
+        /*
+         * Number of the most recent restarts to keep. All restarts are kept if it is zero.
+         */
+        int d_num_restarts_to_keep;
+        
+        /*
+         * Settings and data of the writes of the hierarchy data.
+         */
+        bool d_write_hierarchy_data;
+        boost::shared_ptr<hier::PatchHierarchy> d_patch_hierarchy;
+        std::vector<int> d_hierarchy_data_ids;
+#ifdef HAVE_HDF5
+        boost::shared_ptr<RestartHierarchyDataWriter> d_hierarchy_data_writer;
+#endif
+        
+        /*
+         * Restore numbers of the complete restarts in the restart directory that are subject to
+         * the retention policy, from the oldest to the most recent.
+         */
+        std::deque<int> d_complete_restore_nums;
+        
+        /*
+         * Background thread copying the staged restart file of this process, the restore number
+         * it copies and whether the copy is successful.
+         */
+        std::thread d_drain_thread;
+        int d_pending_restore_num;
+        bool d_is_drain_successful;
+        
+        /*
+         * Timer of the waits for the background copies.
+         */
+        static boost::shared_ptr<tbox::Timer> t_wait_for_pending_restart;
+        
+};
+
+#endif /* EXTENDED_RESTART_WRITER_HPP */
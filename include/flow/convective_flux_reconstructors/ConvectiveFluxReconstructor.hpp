@@ -76,6 +76,15 @@ class ConvectiveFluxReconstructor
             const double time,
             const double dt,
             const int RK_step_number) = 0;
+        
+        /*
+         * Print the statistics of the schemes used by the convective flux reconstructor.
+         */
+        virtual void
+        printSchemeStatistics(std::ostream& os)
+        {
+            NULL_USE(os);
+        }
     
     protected:
         /*
@@ -31,6 +31,14 @@ class ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL: public ConvectiveFluxReconstr
             const boost::shared_ptr<tbox::Database>& restart_db) const;
     
     private:
+        /*
+         * Get the coefficients of the linear interpolation used on smooth patches.
+         */
+        void
+        getLinearInterpolationCoefficients(
+            std::vector<double>& coeffs_minus,
+            std::vector<double>& coeffs_plus) const;
+        
         /*
          * Perform WENO interpolation.
          */
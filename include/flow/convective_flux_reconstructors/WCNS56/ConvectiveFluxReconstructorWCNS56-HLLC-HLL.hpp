@@ -5,7 +5,11 @@
 #include "util/derivatives/DerivativeFirstOrder.hpp"
 #include "util/Directions.hpp"
 
+#include "SAMRAI/hier/GlobalId.h"
+
 #include "boost/multi_array.hpp"
+#include <limits>
+#include <map>
 
 class ConvectiveFluxReconstructorWCNS56: public ConvectiveFluxReconstructor
 {
@@ -47,6 +51,13 @@ class ConvectiveFluxReconstructorWCNS56: public ConvectiveFluxReconstructor
             const double dt,
             const int RK_step_number);
         
+        /*
+         * Print the fractions of cells computed with the linear and nonlinear schemes since the
+         * last call.
+         */
+        void
+        printSchemeStatistics(std::ostream& os);
+        
     protected:
         /*
          * Perform WENO interpolation.
@@ -57,6 +68,75 @@ class ConvectiveFluxReconstructorWCNS56: public ConvectiveFluxReconstructor
             std::vector<boost::shared_ptr<pdat::SideData<double> > >& variables_plus,
             const std::vector<std::vector<boost::shared_ptr<pdat::SideData<double> > > >& variables) = 0;
         
+        /*
+         * Compute the projection variables for the transformation between primitive variables
+         * and characteristic variables on a patch.
+         */
+        void
+        computeProjectionVariables(
+            std::vector<boost::shared_ptr<pdat::SideData<double> > >& projection_variables,
+            const hier::Patch& patch,
+            const double time,
+            const int RK_step_number);
+        
+        /*
+         * Get temporary patch data. The data is taken from pools that are reused by consecutive
+         * patches with the same box dimensions and is only valid until the next patch is
+         * processed. The values of the data are undefined.
+         */
+        boost::shared_ptr<pdat::SideData<double> >
+        getTemporarySideData(
+            const hier::Box& interior_box,
+            const int depth,
+            const hier::IntVector& num_ghosts);
+        
+        boost::shared_ptr<pdat::CellData<double> >
+        getTemporaryCellData(
+            const hier::Box& interior_box,
+            const int depth,
+            const hier::IntVector& num_ghosts);
+        
+        /*
+         * Get the coefficients of the linear interpolation used on smooth patches. The six
+         * coefficients are for the cells at offsets -3 to 2 from the cell on the right of the
+         * mid-point.
+         */
+        virtual void
+        getLinearInterpolationCoefficients(
+            std::vector<double>& coeffs_minus,
+            std::vector<double>& coeffs_plus) const;
+        
+        /*
+         * Check whether a patch is smooth enough for the linear scheme.
+         */
+        bool
+        isPatchSmooth(
+            const std::vector<boost::shared_ptr<pdat::CellData<double> > >& primitive_variables,
+            const boost::shared_ptr<pdat::CellData<double> >& dilatation,
+            const boost::shared_ptr<pdat::CellData<double> >& vorticity_magnitude) const;
+        
+        /*
+         * Perform linear interpolation.
+         */
+        void
+        performLinearInterpolation(
+            std::vector<boost::shared_ptr<pdat::SideData<double> > >& variables_minus,
+            std::vector<boost::shared_ptr<pdat::SideData<double> > >& variables_plus,
+            const std::vector<boost::shared_ptr<pdat::CellData<double> > >& variables);
+        
+        /*
+         * Print the settings shared by all WCNS56 schemes.
+         */
+        void
+        printCommonClassData(std::ostream& os) const;
+        
+        /*
+         * Put the settings shared by all WCNS56 schemes into the restart database.
+         */
+        void
+        putCommonDataToRestart(
+            const boost::shared_ptr<tbox::Database>& restart_db) const;
+        
         /*
          * Forms of equations.
          */
@@ -68,6 +148,42 @@ class ConvectiveFluxReconstructorWCNS56: public ConvectiveFluxReconstructor
          */
         boost::shared_ptr<FlowModelRiemannSolver> d_riemann_solver;
         
+        /*
+         * Settings of the hybrid scheme. The linear scheme is used on patches with normalized second
+         * order differences of the primitive variables below the threshold.
+         */
+        bool d_use_hybrid_scheme;
+        double d_hybrid_smoothness_threshold;
+        
+        /*
+         * Numbers of cells computed with the linear and nonlinear schemes since the last report.
+         */
+        double d_num_cells_linear_scheme;
+        double d_num_cells_nonlinear_scheme;
+        
+        /*
+         * Whether the projection variables are frozen at the first Runge-Kutta stage of each time
+         * step.
+         */
+        bool d_freeze_projection_variables;
+        
+        /*
+         * Projection variables frozen at the first Runge-Kutta stage of each level, stored per
+         * patch, and the times of the frozen data.
+         */
+        std::vector<std::map<hier::GlobalId, std::vector<boost::shared_ptr<pdat::SideData<double> > > > >
+            d_projection_variables_cache;
+        std::vector<double> d_projection_variables_time;
+        
+        /*
+         * Pools of temporary patch data and the numbers of pooled data handed out for the current
+         * patch.
+         */
+        std::vector<boost::shared_ptr<pdat::SideData<double> > > d_temp_side_data;
+        std::vector<boost::shared_ptr<pdat::CellData<double> > > d_temp_cell_data;
+        int d_num_temp_side_data_used;
+        int d_num_temp_cell_data_used;
+        
 };
 
 #endif /* CONVECTIVE_FLUX_RECONSTRUCTOR_56_HLLC_HLL_HPP */
@@ -307,6 +307,28 @@ class FlowModel:
         virtual std::vector<boost::shared_ptr<pdat::CellData<double> > >
         getGlobalCellDataConservativeVariables() = 0;
         
+        /*
+         * Check that all the conservative variables are registered with the same numbers of ghost
+         * cells in the given data context. This is required by
+         * getGlobalCellDataPointersConservativeVariables() and should be checked after the
+         * conservative variables are registered.
+         */
+        void
+        checkGhostCellWidthsOfConservativeVariables(
+            const boost::shared_ptr<hier::VariableContext>& data_context);
+        
+        /*
+         * Get the pointers to the components of the global cell data of the conservative variables
+         * in the registered patch, one pointer for each equation. All the components must have the
+         * same numbers of ghost cells, which are returned with the dimensions of the ghost box, so
+         * that the same linear index can be used for every equation.
+         */
+        void
+        getGlobalCellDataPointersConservativeVariables(
+            std::vector<double*>& conservative_variables_pointers,
+            hier::IntVector& num_ghosts,
+            hier::IntVector& ghostcell_dims);
+        
         /*
          * Get the global cell data of the primitive variables in the registered patch.
          */
@@ -397,6 +419,30 @@ class FlowModel:
             boost::shared_ptr<pdat::SideData<int> >& bounded_flag,
             const std::vector<boost::shared_ptr<pdat::SideData<double> > >& primitive_variables) = 0;
         
+        /*
+         * Get the indices of the primitive variables that have to be within bounds, such as the
+         * density and the pressure, and their lower and upper bounds.
+         */
+        virtual void
+        getBoundsOfPrimitiveVariables(
+            std::vector<int>& bounded_var_idx,
+            std::vector<double>& bounds_lo,
+            std::vector<double>& bounds_up) const = 0;
+        
+        /*
+         * Limit the side primitive variables interpolated from the cells on the left (minus) and on
+         * the right (plus) of the sides with the Zhang-Shu scaling limiter. The deviation of all
+         * the side primitive variables from the primitive variables of the cell is scaled by the
+         * same factor in [0, 1], which is the largest factor that keeps the bounded primitive
+         * variables within the bounds. The side data is not changed where it is already bounded
+         * and becomes the first order interpolation where the cell data is out of bounds.
+         */
+        void
+        limitGlobalSideDataPrimitiveVariables(
+            std::vector<boost::shared_ptr<pdat::SideData<double> > >& primitive_variables_minus,
+            std::vector<boost::shared_ptr<pdat::SideData<double> > >& primitive_variables_plus,
+            const std::vector<boost::shared_ptr<pdat::CellData<double> > >& primitive_variables);
+        
         /*
          * Convert vector of pointers of conservative cell data to vectors of pointers of primitive cell data.
          */
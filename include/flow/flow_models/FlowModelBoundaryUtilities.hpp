@@ -3,6 +3,7 @@
 
 #include "HAMeRS_config.hpp"
 
+#include "util/basic_boundary_conditions/PatchBoundaryDescriptor.hpp"
 #include "util/mixing_rules/equations_of_state/EquationOfStateMixingRulesManager.hpp"
 
 #include "SAMRAI/pdat/CellData.h"
@@ -102,7 +103,7 @@ class FlowModelBoundaryUtilities
         virtual void
         fill1dNodeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<std::vector<double> >& bdry_node_values,
@@ -115,7 +116,7 @@ class FlowModelBoundaryUtilities
         virtual void
         fill2dEdgeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_edge_locs,
             const std::vector<int>& bdry_edge_conds,
             const std::vector<std::vector<double> >& bdry_edge_values,
@@ -128,7 +129,7 @@ class FlowModelBoundaryUtilities
         virtual void
         fill2dNodeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<std::vector<double> >& bdry_edge_values,
@@ -141,7 +142,7 @@ class FlowModelBoundaryUtilities
         virtual void
         fill3dFaceBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_face_locs,
             const std::vector<int>& bdry_face_conds,
             const std::vector<std::vector<double> >& bdry_face_values,
@@ -154,7 +155,7 @@ class FlowModelBoundaryUtilities
         virtual void
         fill3dEdgeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_edge_locs,
             const std::vector<int>& bdry_edge_conds,
             const std::vector<std::vector<double> >& bdry_face_values,
@@ -167,7 +168,7 @@ class FlowModelBoundaryUtilities
         virtual void
         fill3dNodeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<std::vector<double> >& bdry_face_values,
@@ -70,7 +70,7 @@ class FlowModelBoundaryUtilitiesFiveEqnAllaire: public FlowModelBoundaryUtilitie
         void
         fill1dNodeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<std::vector<double> >& bdry_node_values,
@@ -83,7 +83,7 @@ class FlowModelBoundaryUtilitiesFiveEqnAllaire: public FlowModelBoundaryUtilitie
         void
         fill2dEdgeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_edge_locs,
             const std::vector<int>& bdry_edge_conds,
             const std::vector<std::vector<double> >& bdry_edge_values,
@@ -96,7 +96,7 @@ class FlowModelBoundaryUtilitiesFiveEqnAllaire: public FlowModelBoundaryUtilitie
         void
         fill2dNodeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<std::vector<double> >& bdry_edge_values,
@@ -109,7 +109,7 @@ class FlowModelBoundaryUtilitiesFiveEqnAllaire: public FlowModelBoundaryUtilitie
         void
         fill3dFaceBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_face_locs,
             const std::vector<int>& bdry_face_conds,
             const std::vector<std::vector<double> >& bdry_face_values,
@@ -122,7 +122,7 @@ class FlowModelBoundaryUtilitiesFiveEqnAllaire: public FlowModelBoundaryUtilitie
         void
         fill3dEdgeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_edge_locs,
             const std::vector<int>& bdry_edge_conds,
             const std::vector<std::vector<double> >& bdry_face_values,
@@ -135,7 +135,7 @@ class FlowModelBoundaryUtilitiesFiveEqnAllaire: public FlowModelBoundaryUtilitie
         void
         fill3dNodeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<std::vector<double> >& bdry_face_values,
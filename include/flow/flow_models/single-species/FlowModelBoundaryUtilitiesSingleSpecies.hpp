@@ -63,7 +63,7 @@ class FlowModelBoundaryUtilitiesSingleSpecies: public FlowModelBoundaryUtilities
         void
         fill1dNodeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<std::vector<double> >& bdry_node_values,
@@ -76,7 +76,7 @@ class FlowModelBoundaryUtilitiesSingleSpecies: public FlowModelBoundaryUtilities
         void
         fill2dEdgeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_edge_locs,
             const std::vector<int>& bdry_edge_conds,
             const std::vector<std::vector<double> >& bdry_edge_values,
@@ -89,7 +89,7 @@ class FlowModelBoundaryUtilitiesSingleSpecies: public FlowModelBoundaryUtilities
         void
         fill2dNodeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<std::vector<double> >& bdry_edge_values,
@@ -102,7 +102,7 @@ class FlowModelBoundaryUtilitiesSingleSpecies: public FlowModelBoundaryUtilities
         void
         fill3dFaceBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_face_locs,
             const std::vector<int>& bdry_face_conds,
             const std::vector<std::vector<double> >& bdry_face_values,
@@ -115,7 +115,7 @@ class FlowModelBoundaryUtilitiesSingleSpecies: public FlowModelBoundaryUtilities
         void
         fill3dEdgeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_edge_locs,
             const std::vector<int>& bdry_edge_conds,
             const std::vector<std::vector<double> >& bdry_face_values,
@@ -128,7 +128,7 @@ class FlowModelBoundaryUtilitiesSingleSpecies: public FlowModelBoundaryUtilities
         void
         fill3dNodeBoundaryData(
             const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<std::vector<double> >& bdry_face_values,
@@ -240,6 +240,16 @@ class FlowModelSingleSpecies: public FlowModel
             boost::shared_ptr<pdat::SideData<int> >& bounded_flag,
             const std::vector<boost::shared_ptr<pdat::SideData<double> > >& primitive_variables);
         
+        /*
+         * Get the indices of the primitive variables that have to be within bounds and their lower
+         * and upper bounds.
+         */
+        void
+        getBoundsOfPrimitiveVariables(
+            std::vector<int>& bounded_var_idx,
+            std::vector<double>& bounds_lo,
+            std::vector<double>& bounds_up) const;
+        
         /*
          * Convert vector of pointers of conservative cell data to vectors of pointers of primitive cell data.
          */
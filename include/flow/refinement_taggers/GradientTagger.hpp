@@ -88,6 +88,20 @@ class GradientTagger
             const int level_number,
             const boost::shared_ptr<hier::VariableContext>& data_context);
         
+        /*
+         * Get the statistics of the sensor values that are required by the
+         * gradient sensors on the patches owned by the local process without
+         * reducing them. Pointers to the statistics are appended to the vector
+         * so that the caller can reduce them together with the statistics of
+         * other taggers.
+         */
+        void
+        getLocalSensorValueStatistics(
+            std::vector<double*>& statistics,
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+            const int level_number,
+            const boost::shared_ptr<hier::VariableContext>& data_context);
+        
         /*
          * Tag cells on a patch for refinement using gradient sensors.
          */
@@ -99,15 +113,15 @@ class GradientTagger
         
     private:
         /*
-         * Tag cells on a patch using value of gradient sensor.
+         * Tag cells on a patch using values of gradient sensor of multiple variables.
          */
         void
         tagCellsOnPatchWithGradientSensor(
             hier::Patch& patch,
             const boost::shared_ptr<pdat::CellData<int> >& tags,
-            const boost::shared_ptr<pdat::CellData<double> >& gradient,
+            const std::vector<boost::shared_ptr<pdat::CellData<double> > >& gradients,
             const std::string& sensor_key,
-            const double tol);
+            const std::vector<double>& tols);
         
         /*
          * Tag cells on a patch using difference sensor.
@@ -0,0 +1,41 @@
+#ifndef REFINEMENT_TAGGER_STATISTICS_HPP
+#define REFINEMENT_TAGGER_STATISTICS_HPP
+
+#include "HAMeRS_config.hpp"
+
+#include "SAMRAI/hier/PatchLevel.h"
+
+#include "boost/shared_ptr.hpp"
+#include <vector>
+
+using namespace SAMRAI;
+
+/*
+ * Utilities shared by the refinement taggers to compute the statistics of the sensor values. The
+ * statistics are first computed on the patches owned by the local process and the global values
+ * are then obtained with a single reduction so that the statistics of different taggers can be
+ * reduced together.
+ */
+class RefinementTaggerStatistics
+{
+    public:
+        /*
+         * Get the maximum of the interior values of the cell data on the patches of a level that
+         * are owned by the local process. No communication is involved.
+         */
+        static double
+        getMaxOnLocalPatches(
+            const boost::shared_ptr<hier::PatchLevel>& level,
+            const int data_id);
+        
+        /*
+         * Replace the local statistics pointed to by the maxima over all processes with a single
+         * reduction.
+         */
+        static void
+        reduceMaxStatistics(
+            const std::vector<double*>& statistics);
+
+};
+
+#endif /* REFINEMENT_TAGGER_STATISTICS_HPP */
@@ -85,6 +85,20 @@ class ValueTagger
             const int level_number,
             const boost::shared_ptr<hier::VariableContext>& data_context);
         
+        /*
+         * Get the statistics of the values that are required by the value
+         * tagger on the patches owned by the local process without reducing
+         * them. Pointers to the statistics are appended to the vector so that
+         * the caller can reduce them together with the statistics of other
+         * taggers.
+         */
+        void
+        getLocalValueStatistics(
+            std::vector<double*>& statistics,
+            const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+            const int level_number,
+            const boost::shared_ptr<hier::VariableContext>& data_context);
+        
         /*
          * Tag cells on a patch for refinement using value tagger.
          */
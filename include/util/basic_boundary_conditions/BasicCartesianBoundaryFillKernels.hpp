@@ -0,0 +1,81 @@
+#ifndef BASIC_CARTESIAN_BOUNDARY_FILL_KERNELS_HPP
+#define BASIC_CARTESIAN_BOUNDARY_FILL_KERNELS_HPP
+
+#include "HAMeRS_config.hpp"
+
+#include "SAMRAI/pdat/CellData.h"
+#include "SAMRAI/hier/Index.h"
+
+#include "boost/shared_ptr.hpp"
+
+using namespace SAMRAI;
+
+/*!
+ * @brief Struct BasicCartesianBoundaryFillKernels contains the slab kernels shared by the basic
+ * Cartesian boundary utilities to fill the ghost cells of cell-centered double data inside a
+ * boundary fill box.
+ *
+ * All the basic boundary conditions either set constant values (DIRICHLET) or copy the data from
+ * the interior of the patch along a single boundary direction. The interior cell copied from is
+ * either the first interior cell next to the boundary (FLOW) or the mirror image of the ghost cell
+ * about the boundary (REFLECT and SYMMETRY).
+ *
+ * The kernels traverse the fill box once, with the cells along the first direction (the
+ * contiguous direction of the data) in the innermost loop and all the depths of the data filled
+ * in each row. The pointers to the depths are obtained once before the loops, so the innermost
+ * loops are plain broadcasts or (reversed) contiguous copies that can be vectorized.
+ *
+ * The indices of the fill box and the interior box are offset by the lower index of the interior
+ * box of the patch, as in the basic Cartesian boundary utilities.
+ */
+struct BasicCartesianBoundaryFillKernels
+{
+    public:
+        /*!
+         * Fill the cells of all depths of the data inside the fill box with constant values, one
+         * value for each depth.
+         *
+         * @param var_data        Cell-centered patch data object to fill.
+         * @param fill_box_lo_idx Offset lower index of the fill box.
+         * @param fill_box_hi_idx Offset upper index of the fill box.
+         * @param values          Pointer to the values of the depths of the data.
+         */
+        static void
+        fillBoxWithConstantValues(
+            const boost::shared_ptr<pdat::CellData<double> >& var_data,
+            const hier::Index& fill_box_lo_idx,
+            const hier::Index& fill_box_hi_idx,
+            const double* const values);
+        
+        /*!
+         * Fill the cells of all depths of the data inside the fill box with the data in the
+         * interior along the given boundary direction.
+         *
+         * @param var_data            Cell-centered patch data object to fill.
+         * @param fill_box_lo_idx     Offset lower index of the fill box.
+         * @param fill_box_hi_idx     Offset upper index of the fill box.
+         * @param interior_box_lo_idx Offset lower index of the interior box.
+         * @param interior_box_hi_idx Offset upper index of the interior box.
+         * @param bdry_direction      Direction normal to the boundary.
+         * @param is_lower_bdry       Whether the boundary is at the lower side of the patch.
+         * @param use_mirror_image    Whether the ghost cells are filled with the mirror images
+         *                            about the boundary instead of the cells next to the boundary.
+         * @param negated_depth       Depth of the data that is negated (e.g. the normal velocity
+         *                            component of REFLECT condition). No depth is negated if it is
+         *                            negative.
+         */
+        static void
+        fillBoxFromInterior(
+            const boost::shared_ptr<pdat::CellData<double> >& var_data,
+            const hier::Index& fill_box_lo_idx,
+            const hier::Index& fill_box_hi_idx,
+            const hier::Index& interior_box_lo_idx,
+            const hier::Index& interior_box_hi_idx,
+            const int bdry_direction,
+            const bool is_lower_bdry,
+            const bool use_mirror_image,
+            const int negated_depth = -1);
+        
+};
+
+#endif /* BASIC_CARTESIAN_BOUNDARY_FILL_KERNELS_HPP */
@@ -4,6 +4,7 @@
 #include "HAMeRS_config.hpp"
 
 #include "util/basic_boundary_conditions/BoundaryUtilityStrategy.hpp"
+#include "util/basic_boundary_conditions/PatchBoundaryDescriptor.hpp"
 
 #include "SAMRAI/pdat/CellData.h"
 #include "SAMRAI/hier/BoundaryBox.h"
@@ -130,7 +131,8 @@ struct BasicCartesianBoundaryUtilities1
          *
          * @param var_name            String name of variable (for error reporting).
          * @param var_data            Cell-centered patch data object to fill.
-         * @param patch               hier::Patch on which data object lives.
+         * @param bdry_descriptor     Descriptor of the physical boundary boxes of the patch on
+         *                            which data object lives.
          * @param bdry_node_locs      tbox::Array of locations of nodes for applying
          *                            boundary conditions.
          * @param bdry_node_conds     tbox::Array of boundary condition types for
@@ -150,7 +152,7 @@ struct BasicCartesianBoundaryUtilities1
         fillNodeBoundaryData(
             const std::string& var_name,
             const boost::shared_ptr<pdat::CellData<double> >& var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             const std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<double>& bdry_node_values,
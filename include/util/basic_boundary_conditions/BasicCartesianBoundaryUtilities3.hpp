@@ -15,6 +15,7 @@
 #include "HAMeRS_config.hpp"
 
 #include "util/basic_boundary_conditions/BoundaryUtilityStrategy.hpp"
+#include "util/basic_boundary_conditions/PatchBoundaryDescriptor.hpp"
 
 #include "SAMRAI/pdat/CellData.h"
 #include "SAMRAI/hier/BoundaryBox.h"
@@ -187,7 +188,8 @@ struct BasicCartesianBoundaryUtilities3
         *
         * @param var_name            String name of variable (for error reporting).
         * @param var_data            Cell-centered patch data object to fill.
-        * @param patch               hier::Patch on which data object lives.
+        * @param bdry_descriptor     Descriptor of the physical boundary boxes of the patch on
+        *                            which data object lives.
         * @param bdry_face_locs      tbox::Array of locations of faces for applying
         *                            boundary conditions.
         * @param bdry_face_conds     tbox::Array of boundary condition types for
@@ -209,7 +211,7 @@ struct BasicCartesianBoundaryUtilities3
         fillFaceBoundaryData(
             const std::string& var_name,
             const boost::shared_ptr<pdat::CellData<double> >& var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             const std::vector<int>& bdry_face_locs,
             const std::vector<int>& bdry_face_conds,
             const std::vector<double>& bdry_face_values,
@@ -224,7 +226,8 @@ struct BasicCartesianBoundaryUtilities3
         *
         * @param var_name            String name of variable (for error reporting).
         * @param var_data            Cell-centered patch data object to fill.
-        * @param patch               hier::Patch on which data object lives.
+        * @param bdry_descriptor     Descriptor of the physical boundary boxes of the patch on
+        *                            which data object lives.
         * @param bdry_edge_locs      tbox::Array of locations of edges for applying
         *                            boundary conditions.
         * @param bdry_edge_conds     tbox::Array of boundary condition types for
@@ -246,7 +249,7 @@ struct BasicCartesianBoundaryUtilities3
         fillEdgeBoundaryData(
             const std::string& var_name,
             const boost::shared_ptr<pdat::CellData<double> >& var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             const std::vector<int>& bdry_edge_locs,
             const std::vector<int>& bdry_edge_conds,
             const std::vector<double>& bdry_face_values,
@@ -261,7 +264,8 @@ struct BasicCartesianBoundaryUtilities3
         *
         * @param var_name            String name of variable (for error reporting).
         * @param var_data            Cell-centered patch data object to fill.
-        * @param patch               hier::Patch on which data object lives.
+        * @param bdry_descriptor     Descriptor of the physical boundary boxes of the patch on
+        *                            which data object lives.
         * @param bdry_node_locs      tbox::Array of locations of nodes for applying
         *                            boundary conditions.
         * @param bdry_node_conds     tbox::Array of boundary condition types for
@@ -283,7 +287,7 @@ struct BasicCartesianBoundaryUtilities3
         fillNodeBoundaryData(
             const std::string& var_name,
             const boost::shared_ptr<pdat::CellData<double> >& var_data,
-            const hier::Patch& patch,
+            const PatchBoundaryDescriptor& bdry_descriptor,
             const std::vector<int>& bdry_node_locs,
             const std::vector<int>& bdry_node_conds,
             const std::vector<double>& bdry_face_values,
@@ -0,0 +1,148 @@
+#ifndef PATCH_BOUNDARY_DESCRIPTOR_HPP
+#define PATCH_BOUNDARY_DESCRIPTOR_HPP
+
+#include "HAMeRS_config.hpp"
+
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/Index.h"
+#include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/hier/Patch.h"
+
+#include <vector>
+
+using namespace SAMRAI;
+
+/*!
+ * @brief Class PatchBoundaryDescriptor stores the geometry of the physical boundary boxes of a
+ * patch in flat arrays so that the boundary utilities do not need to query the patch geometry for
+ * the boundary boxes and the boundary fill boxes whenever the ghost cells are filled.
+ *
+ * The boundary boxes are stored per codimension (1 for faces in 3D, edges in 2D and nodes in 1D,
+ * 2 for edges in 3D and nodes in 2D, 3 for nodes in 3D) in the same order as the boundary boxes
+ * from CartesianPatchGeometry::getCodimensionBoundaries(). For each boundary box, the location
+ * index, the box and the side of the patch in each direction (-1 for lower side, 1 for upper side
+ * and 0 if the box is inside the patch in that direction) are stored. The boundary fill box for
+ * any ghost cell width to fill can then be computed without the patch geometry.
+ *
+ * All indices are offset by the lower index of the interior box of the patch, as in the basic
+ * Cartesian boundary utilities.
+ */
+class PatchBoundaryDescriptor
+{
+    public:
+        /*!
+         * Construct the descriptor of the physical boundary boxes of the patch.
+         */
+        explicit PatchBoundaryDescriptor(const hier::Patch& patch);
+        
+        /*!
+         * Get the dimension of the problem.
+         */
+        const tbox::Dimension&
+        getDim() const
+        {
+            return d_patch_box.getDim();
+        }
+        
+        /*!
+         * Get the interior box of the patch that the descriptor is built for.
+         */
+        const hier::Box&
+        getPatchBox() const
+        {
+            return d_patch_box;
+        }
+        
+        /*!
+         * Check whether the descriptor is built for a patch with the same interior box as the
+         * given patch.
+         */
+        bool
+        isValidForPatch(const hier::Patch& patch) const
+        {
+            return d_patch_box.isSpatiallyEqual(patch.getBox());
+        }
+        
+        /*!
+         * Get the offset lower index of the interior box of the patch.
+         */
+        const hier::Index&
+        getInteriorBoxLowerIndex() const
+        {
+            return d_interior_box_lo_idx;
+        }
+        
+        /*!
+         * Get the offset upper index of the interior box of the patch.
+         */
+        const hier::Index&
+        getInteriorBoxUpperIndex() const
+        {
+            return d_interior_box_hi_idx;
+        }
+        
+        /*!
+         * Get the number of boundary boxes of the given codimension.
+         */
+        int
+        getNumberOfBoundaryBoxes(const int codim) const
+        {
+            return static_cast<int>(d_bdry_locs[codim - 1].size());
+        }
+        
+        /*!
+         * Get the location index of a boundary box of the given codimension.
+         */
+        int
+        getBoundaryLocationIndex(const int codim, const int bi) const
+        {
+            return d_bdry_locs[codim - 1][bi];
+        }
+        
+        /*!
+         * Get the offset lower and upper indices of the boundary fill box of a boundary box of the
+         * given codimension for the ghost cell width to fill. The fill box is identical to the one
+         * from CartesianPatchGeometry::getBoundaryFillBox() and is empty if the ghost cell width
+         * to fill is zero in any direction that the boundary box is outside the patch.
+         */
+        void
+        getBoundaryFillBox(
+            hier::Index& fill_box_lo_idx,
+            hier::Index& fill_box_hi_idx,
+            const int codim,
+            const int bi,
+            const hier::IntVector& gcw_to_fill) const;
+        
+    private:
+        /*
+         * Interior box of the patch.
+         */
+        hier::Box d_patch_box;
+        
+        /*
+         * Offset lower and upper indices of the interior box of the patch.
+         */
+        hier::Index d_interior_box_lo_idx;
+        hier::Index d_interior_box_hi_idx;
+        
+        /*
+         * Location indices of the boundary boxes of each codimension.
+         */
+        std::vector<std::vector<int> > d_bdry_locs;
+        
+        /*
+         * Offset lower and upper indices of the boundary boxes of each codimension, stored
+         * contiguously with dim entries per boundary box.
+         */
+        std::vector<std::vector<int> > d_bdry_box_lo;
+        std::vector<std::vector<int> > d_bdry_box_hi;
+        
+        /*
+         * Sides of the patch that the boundary boxes of each codimension are at, stored
+         * contiguously with dim entries per boundary box.
+         */
+        std::vector<std::vector<int> > d_bdry_box_sides;
+        
+};
+
+#endif /* PATCH_BOUNDARY_DESCRIPTOR_HPP */
@@ -46,6 +46,24 @@ class GradientSensor
             hier::Patch& patch,
             const int depth = 0) = 0;
         
+        /*
+         * Compute the gradients of multiple cell data. The default implementation computes the
+         * gradient of each cell data separately.
+         */
+        virtual void
+        computeGradients(
+            std::vector<boost::shared_ptr<pdat::CellData<double> > >& gradients,
+            const std::vector<boost::shared_ptr<pdat::CellData<double> > >& cell_data,
+            hier::Patch& patch)
+        {
+            TBOX_ASSERT(gradients.size() == cell_data.size());
+            
+            for (int vi = 0; vi < static_cast<int>(cell_data.size()); vi++)
+            {
+                computeGradient(gradients[vi], cell_data[vi], patch);
+            }
+        }
+        
     protected:
         /*
          * The object name is used for error/warning reporting.
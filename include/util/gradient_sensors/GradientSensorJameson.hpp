@@ -22,6 +22,15 @@ class GradientSensorJameson: public GradientSensor
             hier::Patch& patch,
             const int depth = 0);
         
+        /*
+         * Compute the gradients of multiple cell data in a single sweep over the patch.
+         */
+        void
+        computeGradients(
+            std::vector<boost::shared_ptr<pdat::CellData<double> > >& gradients,
+            const std::vector<boost::shared_ptr<pdat::CellData<double> > >& cell_data,
+            hier::Patch& patch);
+        
 };
 
 #endif /* GRADIENT_SENSOR_JAMESON_HPP */
@@ -43,6 +43,22 @@ class WaveletTransformHarten: public WaveletTransform
          */
         const int d_k;
         
+        /*
+         * Compute the scaling and wavelet coefficients at all levels along the lines in one
+         * direction with the lines processed in cache-resident blocks.
+         */
+        void
+        transformLinesInDirection(
+            std::vector<double*>& w,
+            std::vector<double*>& f_mean,
+            const double* const f,
+            const int direction,
+            const hier::IntVector& interior_dims,
+            const hier::IntVector& num_ghosts_cell_data,
+            const hier::IntVector& ghostcell_dims_cell_data,
+            const hier::IntVector& num_ghosts_wavelet_coeffs,
+            const hier::IntVector& ghostcell_dims_wavelet_coeffs);
+        
         /*
          * Smooth the given cell data in different directions.
          */
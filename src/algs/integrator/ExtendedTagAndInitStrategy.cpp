@@ -139,6 +139,77 @@ ExtendedTagAndInitStrategy::applyIntegralDetector(
 }
 
 
+void
+ExtendedTagAndInitStrategy::applyMultipleDetectors(
+    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+    const int level_number,
+    const double error_data_time,
+    const int tag_index,
+    const bool initial_time,
+    const bool uses_value_detector,
+    const bool uses_gradient_detector,
+    const bool uses_multiresolution_detector,
+    const bool uses_integral_detector,
+    const bool uses_richardson_extrapolation_too)
+{
+    if (uses_integral_detector)
+    {
+        applyIntegralDetector(
+            hierarchy,
+            level_number,
+            error_data_time,
+            tag_index,
+            initial_time,
+            uses_value_detector,
+            uses_gradient_detector,
+            uses_multiresolution_detector,
+            uses_richardson_extrapolation_too);
+    }
+    
+    if (uses_multiresolution_detector)
+    {
+        applyMultiresolutionDetector(
+            hierarchy,
+            level_number,
+            error_data_time,
+            tag_index,
+            initial_time,
+            uses_value_detector,
+            uses_gradient_detector,
+            uses_integral_detector,
+            uses_richardson_extrapolation_too);
+    }
+    
+    if (uses_gradient_detector)
+    {
+        applyGradientDetector(
+            hierarchy,
+            level_number,
+            error_data_time,
+            tag_index,
+            initial_time,
+            uses_value_detector,
+            uses_multiresolution_detector,
+            uses_integral_detector,
+            uses_richardson_extrapolation_too);
+    }
+    
+    if (uses_value_detector)
+    {
+        applyValueDetector(
+            hierarchy,
+            level_number,
+            error_data_time,
+            tag_index,
+            initial_time,
+            uses_gradient_detector,
+            uses_multiresolution_detector,
+            uses_integral_detector,
+            uses_richardson_extrapolation_too);
+    }
+}
+
+
 void
 ExtendedTagAndInitStrategy::applyRichardsonExtrapolation(
     const boost::shared_ptr<hier::PatchLevel>& level,
@@ -108,7 +108,8 @@ ExtendedTagAndInitialize::ExtendedTagAndInitialize(
     d_ever_uses_value_detector(false),
     d_ever_uses_refine_boxes(false),
     d_boxes_changed(false),
-    d_old_cycle(-1)
+    d_old_cycle(-1),
+    d_use_initial_hierarchy_refine_boxes(false)
 {
     TBOX_ASSERT(!object_name.empty());
     
@@ -292,7 +293,33 @@ ExtendedTagAndInitialize::tagCellsForRefinement(
             can_be_refined);
     }
     
-    if (usesIntegral)
+    /*
+     * If more than one of the detectors is used, let the strategy apply them together so that
+     * the ghost cells are filled only once. The strategy preserves the order of the detectors.
+     */
+    const int num_detectors_used =
+        static_cast<int>(usesIntegral) +
+        static_cast<int>(usesMultiresolution) +
+        static_cast<int>(usesGradient) +
+        static_cast<int>(usesValue);
+    
+    if (num_detectors_used > 1)
+    {
+        TBOX_ASSERT(d_tag_strategy != 0);
+        
+        d_tag_strategy->applyMultipleDetectors(
+            hierarchy,
+            level_number,
+            regrid_time,
+            tag_index,
+            initial_time,
+            usesValue,
+            usesGradient,
+            usesMultiresolution,
+            usesIntegral,
+            usesRichExtrap);
+    }
+    else if (usesIntegral)
     {
         TBOX_ASSERT(d_tag_strategy != 0);
         
@@ -307,8 +334,7 @@ ExtendedTagAndInitialize::tagCellsForRefinement(
             usesMultiresolution,
             usesRichExtrap);
     }
-    
-    if (usesMultiresolution)
+    else if (usesMultiresolution)
     {
         TBOX_ASSERT(d_tag_strategy != 0);
         
@@ -323,8 +349,7 @@ ExtendedTagAndInitialize::tagCellsForRefinement(
             usesIntegral,
             usesRichExtrap);
     }
-    
-    if (usesGradient)
+    else if (usesGradient)
     {
         TBOX_ASSERT(d_tag_strategy != 0);
         
@@ -339,8 +364,7 @@ ExtendedTagAndInitialize::tagCellsForRefinement(
             usesIntegral,
             usesRichExtrap);
     }
-    
-    if (usesValue)
+    else if (usesValue)
     {
         TBOX_ASSERT(d_tag_strategy != 0);
         
@@ -1534,6 +1558,11 @@ ExtendedTagAndInitialize::refineUserBoxInputOnly(
     int cycle,
     double time)
 {
+    if (d_use_initial_hierarchy_refine_boxes)
+    {
+        return true;
+    }
+    
     bool use_only_refine_boxes = false;
     if (usesRefineBoxes(cycle, time))
     {
@@ -2001,6 +2030,20 @@ ExtendedTagAndInitialize::getUserSuppliedRefineBoxes(
     TBOX_ASSERT(time >= 0.);
     TBOX_ASSERT(!d_use_cycle_criteria || !d_use_time_criteria);
     
+    /*
+     * The refine boxes of the initial hierarchy take precedence over all the other refine boxes.
+     * A level without them is not refined.
+     */
+    if (d_use_initial_hierarchy_refine_boxes)
+    {
+        if (static_cast<int>(d_initial_hierarchy_refine_boxes.size()) > level_num)
+        {
+            refine_boxes = d_initial_hierarchy_refine_boxes[level_num];
+        }
+        
+        return true;
+    }
+    
     setCurrentTaggingCriteria(cycle, time);
     
     /*
@@ -2114,6 +2157,31 @@ ExtendedTagAndInitialize::resetRefineBoxes(
 }
 
 
+/*
+ *************************************************************************
+ *
+ * Sets and clears the refine boxes of the levels of the initial
+ * hierarchy.
+ *
+ *************************************************************************
+ */
+void
+ExtendedTagAndInitialize::setInitialHierarchyRefineBoxes(
+    const std::vector<hier::BoxContainer>& refine_boxes)
+{
+    d_initial_hierarchy_refine_boxes = refine_boxes;
+    d_use_initial_hierarchy_refine_boxes = true;
+}
+
+
+void
+ExtendedTagAndInitialize::clearInitialHierarchyRefineBoxes()
+{
+    d_initial_hierarchy_refine_boxes.clear();
+    d_use_initial_hierarchy_refine_boxes = false;
+}
+
+
 void
 ExtendedTagAndInitialize::turnOnRefineBoxes(
     double time)
@@ -0,0 +1,207 @@
+#include "algs/integrator/FusedMPIReduction.hpp"
+
+#include "SAMRAI/tbox/Utilities.h"
+
+#define VALUE_TYPE_MAX 0
+#define VALUE_TYPE_MIN 1
+#define VALUE_TYPE_SUM 2
+
+FusedMPIReduction::FusedMPIReduction(const tbox::SAMRAI_MPI& mpi):
+    d_mpi(mpi),
+    d_is_pending(false),
+    d_is_completed(false)
+{
+#if defined(HAVE_MPI) && (MPI_VERSION >= 3)
+    d_num_requests = 0;
+#endif
+}
+
+
+FusedMPIReduction::~FusedMPIReduction()
+{
+    if (d_is_pending)
+    {
+        complete();
+    }
+}
+
+
+/*
+ * Add a local value to reduce with the maximum.
+ */
+int
+FusedMPIReduction::addMax(const double value)
+{
+    TBOX_ASSERT(!d_is_pending && !d_is_completed);
+    
+    d_value_buffer_idx.push_back(static_cast<int>(d_max_local.size()));
+    d_value_types.push_back(VALUE_TYPE_MAX);
+    d_max_local.push_back(value);
+    
+    return static_cast<int>(d_value_types.size()) - 1;
+}
+
+
+/*
+ * Add a local value to reduce with the minimum. The minimum is reduced as the maximum of the
+ * negated value so that it is reduced in the same message as the maxima.
+ */
+int
+FusedMPIReduction::addMin(const double value)
+{
+    TBOX_ASSERT(!d_is_pending && !d_is_completed);
+    
+    d_value_buffer_idx.push_back(static_cast<int>(d_max_local.size()));
+    d_value_types.push_back(VALUE_TYPE_MIN);
+    d_max_local.push_back(-value);
+    
+    return static_cast<int>(d_value_types.size()) - 1;
+}
+
+
+/*
+ * Add a local value to reduce with the sum.
+ */
+int
+FusedMPIReduction::addSum(const double value)
+{
+    TBOX_ASSERT(!d_is_pending && !d_is_completed);
+    
+    d_value_buffer_idx.push_back(static_cast<int>(d_sum_local.size()));
+    d_value_types.push_back(VALUE_TYPE_SUM);
+    d_sum_local.push_back(value);
+    
+    return static_cast<int>(d_value_types.size()) - 1;
+}
+
+
+/*
+ * Post the reductions of all the added values.
+ */
+void
+FusedMPIReduction::post()
+{
+    TBOX_ASSERT(!d_is_pending && !d_is_completed);
+    
+    const int num_max = static_cast<int>(d_max_local.size());
+    const int num_sum = static_cast<int>(d_sum_local.size());
+    
+    if (d_mpi.getSize() == 1)
+    {
+        d_max_global = d_max_local;
+        d_sum_global = d_sum_local;
+        
+        d_is_completed = true;
+        
+        return;
+    }
+    
+    d_max_global.resize(num_max, 0.0);
+    d_sum_global.resize(num_sum, 0.0);
+    
+#if defined(HAVE_MPI) && (MPI_VERSION >= 3)
+    d_num_requests = 0;
+    
+    if (num_max > 0)
+    {
+        MPI_Iallreduce(
+            d_max_local.data(),
+            d_max_global.data(),
+            num_max,
+            MPI_DOUBLE,
+            MPI_MAX,
+            d_mpi.getCommunicator(),
+            &d_requests[d_num_requests]);
+        
+        d_num_requests++;
+    }
+    
+    if (num_sum > 0)
+    {
+        MPI_Iallreduce(
+            d_sum_local.data(),
+            d_sum_global.data(),
+            num_sum,
+            MPI_DOUBLE,
+            MPI_SUM,
+            d_mpi.getCommunicator(),
+            &d_requests[d_num_requests]);
+        
+        d_num_requests++;
+    }
+    
+    d_is_pending = true;
+#else
+    if (num_max > 0)
+    {
+        d_mpi.Allreduce(
+            d_max_local.data(),
+            d_max_global.data(),
+            num_max,
+            MPI_DOUBLE,
+            MPI_MAX);
+    }
+    
+    if (num_sum > 0)
+    {
+        d_mpi.Allreduce(
+            d_sum_local.data(),
+            d_sum_global.data(),
+            num_sum,
+            MPI_DOUBLE,
+            MPI_SUM);
+    }
+    
+    d_is_completed = true;
+#endif
+}
+
+
+/*
+ * Wait for the reductions to complete.
+ */
+void
+FusedMPIReduction::complete()
+{
+    TBOX_ASSERT(d_is_pending || d_is_completed);
+    
+    if (d_is_completed)
+    {
+        return;
+    }
+    
+#if defined(HAVE_MPI) && (MPI_VERSION >= 3)
+    if (d_num_requests > 0)
+    {
+        MPI_Waitall(d_num_requests, d_requests, MPI_STATUSES_IGNORE);
+        d_num_requests = 0;
+    }
+#endif
+    
+    d_is_pending = false;
+    d_is_completed = true;
+}
+
+
+/*
+ * Get the global value of the given index.
+ */
+double
+FusedMPIReduction::getValue(const int value_idx) const
+{
+    TBOX_ASSERT(d_is_completed);
+    TBOX_ASSERT(value_idx >= 0 && value_idx < static_cast<int>(d_value_types.size()));
+    
+    const int buffer_idx = d_value_buffer_idx[value_idx];
+    
+    if (d_value_types[value_idx] == VALUE_TYPE_MAX)
+    {
+        return d_max_global[buffer_idx];
+    }
+    else if (d_value_types[value_idx] == VALUE_TYPE_MIN)
+    {
+        return -d_max_global[buffer_idx];
+    }
+    
+    return d_sum_global[buffer_idx];
+}
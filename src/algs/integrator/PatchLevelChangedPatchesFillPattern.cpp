@@ -0,0 +1,93 @@
+#include "algs/integrator/PatchLevelChangedPatchesFillPattern.hpp"
+
+#include "SAMRAI/hier/BoxContainer.h"
+#include "SAMRAI/hier/RealBoxConstIterator.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+const std::string PatchLevelChangedPatchesFillPattern::s_name_id = "CHANGED_PATCHES_FILL_PATTERN";
+
+
+PatchLevelChangedPatchesFillPattern::PatchLevelChangedPatchesFillPattern(
+    const std::set<hier::BoxId>& unchanged_box_ids):
+        d_unchanged_box_ids(unchanged_box_ids),
+        d_max_fill_boxes(0)
+{
+}
+
+
+PatchLevelChangedPatchesFillPattern::~PatchLevelChangedPatchesFillPattern()
+{
+}
+
+
+/*
+ * Compute the fill boxes of the destination level. The fill box of each changed patch is its box
+ * grown by the fill ghost width. The unchanged patches have no fill boxes.
+ */
+void
+PatchLevelChangedPatchesFillPattern::computeFillBoxesAndNeighborhoodSets(
+    boost::shared_ptr<hier::BoxLevel>& fill_box_level,
+    boost::shared_ptr<hier::Connector>& dst_to_fill,
+    const hier::BoxLevel& dst_box_level,
+    const hier::IntVector& fill_ghost_width,
+    bool data_on_patch_border)
+{
+    NULL_USE(data_on_patch_border);
+    TBOX_ASSERT_OBJDIM_EQUALITY2(dst_box_level, fill_ghost_width);
+    
+    fill_box_level.reset(new hier::BoxLevel(
+        dst_box_level.getRefinementRatio(),
+        dst_box_level.getGridGeometry(),
+        dst_box_level.getMPI()));
+    
+    dst_to_fill.reset(new hier::Connector(
+        dst_box_level,
+        *fill_box_level,
+        fill_ghost_width));
+    
+    const hier::BoxContainer& dst_boxes = dst_box_level.getBoxes();
+    
+    for (hier::RealBoxConstIterator ni(dst_boxes.realBegin());
+         ni != dst_boxes.realEnd();
+         ++ni)
+    {
+        if (d_unchanged_box_ids.find(ni->getBoxId()) != d_unchanged_box_ids.end())
+        {
+            continue;
+        }
+        
+        hier::Box fill_box(*ni);
+        fill_box.grow(fill_ghost_width);
+        
+        hier::Connector::NeighborhoodIterator base_box_itr =
+            dst_to_fill->makeEmptyLocalNeighborhood(ni->getBoxId());
+        dst_to_fill->insertLocalNeighbor(fill_box, base_box_itr);
+        
+        fill_box_level->addBoxWithoutUpdate(fill_box);
+        
+        d_max_fill_boxes = 1;
+    }
+    
+    fill_box_level->finalize();
+}
+
+
+/*
+ * The destination fill boxes cannot be computed on the source processors and are communicated.
+ */
+void
+PatchLevelChangedPatchesFillPattern::computeDestinationFillBoxesOnSourceProc(
+    FillSet& dst_fill_boxes_on_src_proc,
+    const hier::BoxLevel& dst_box_level,
+    const hier::Connector& src_to_dst,
+    const hier::IntVector& fill_ghost_width)
+{
+    NULL_USE(dst_fill_boxes_on_src_proc);
+    NULL_USE(dst_box_level);
+    NULL_USE(src_to_dst);
+    NULL_USE(fill_ghost_width);
+    
+    TBOX_ERROR("PatchLevelChangedPatchesFillPattern::computeDestinationFillBoxesOnSourceProc()\n"
+        << "The destination fill boxes are not computable on the source processors."
+        << std::endl);
+}
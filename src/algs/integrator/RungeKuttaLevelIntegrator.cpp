@@ -13,7 +13,14 @@
 
 #include "algs/integrator/RungeKuttaLevelIntegrator.hpp"
 
+#include "algs/integrator/FusedMPIReduction.hpp"
+#include "algs/integrator/PatchLevelChangedPatchesFillPattern.hpp"
+
+#include "SAMRAI/math/ArrayDataBasicOps.h"
 #include "SAMRAI/pdat/CellData.h"
+#include "SAMRAI/pdat/CellGeometry.h"
+#include "SAMRAI/pdat/CellIterator.h"
+#include "SAMRAI/pdat/CellVariable.h"
 #include "SAMRAI/pdat/FaceData.h"
 #include "SAMRAI/pdat/FaceDataFactory.h"
 #include "SAMRAI/pdat/FaceVariable.h"
@@ -23,6 +30,7 @@
 #include "SAMRAI/pdat/OutersideVariable.h"
 #include "SAMRAI/pdat/SideData.h"
 #include "SAMRAI/pdat/SideDataFactory.h"
+#include "SAMRAI/pdat/SideIndex.h"
 #include "SAMRAI/pdat/SideVariable.h"
 #include "SAMRAI/xfer/CoarsenSchedule.h"
 #include "SAMRAI/hier/PatchData.h"
@@ -38,6 +46,8 @@
 #include "SAMRAI/tbox/Utilities.h"
 #include "SAMRAI/tbox/MathUtilities.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <fstream>
 #include <string>
@@ -217,6 +227,7 @@ boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_apply_value_detector
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_apply_gradient_detector;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_apply_multiresolution_detector;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_apply_integral_detector;
+boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_apply_multiple_detectors;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_tag_cells;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_coarsen_rich_extrap;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_get_level_dt;
@@ -224,6 +235,7 @@ boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_get_level_dt_sync;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_advance_level;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_new_advance_bdry_fill_comm;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_patch_num_kernel;
+boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_advance_copy_intermediate_data;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_advance_level_sync;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_std_level_sync;
 boost::shared_ptr<tbox::Timer> RungeKuttaLevelIntegrator::t_sync_new_levels;
@@ -268,6 +280,7 @@ RungeKuttaLevelIntegrator::RungeKuttaLevelIntegrator(
     d_lag_dt_computation(true),
     d_use_ghosts_for_dt(false),
     d_dt(tbox::MathUtilities<double>::getSignalingNaN()),
+    d_error_estimate_order(0),
     d_flux_is_face(true),
     d_flux_face_registered(false),
     d_flux_side_registered(false),
@@ -277,7 +290,22 @@ RungeKuttaLevelIntegrator::RungeKuttaLevelIntegrator(
     d_new(hier::VariableDatabase::getDatabase()->getContext("NEW")),
     d_plot_context(d_current),
     d_have_flux_on_level_zero(false),
-    d_distinguish_mpi_reduction_costs(false)
+    d_distinguish_mpi_reduction_costs(false),
+    d_batch_patch_num_cells_threshold(0),
+    d_use_sparse_refluxing(false),
+    d_swap_intermediate_data(false),
+    d_intermediate_data_swappable(true),
+    d_reuse_unchanged_patches_in_regrid(true),
+    d_use_local_time_stepping(false),
+    d_local_time_stepping_ratio(2),
+    d_use_adaptive_cfl(false),
+    d_cfl_min(tbox::MathUtilities<double>::getSignalingNaN()),
+    d_cfl_max(tbox::MathUtilities<double>::getSignalingNaN()),
+    d_adaptive_cfl_relative_tolerance(1.0e-3),
+    d_adaptive_cfl_absolute_tolerance(1.0e-6),
+    d_max_step_retries(3),
+    d_adaptive_cfl_error(0.0),
+    d_num_local_cell_updates(0.0)
 {
     TBOX_ASSERT(!object_name.empty());
     TBOX_ASSERT(patch_strategy != 0);
@@ -372,10 +400,43 @@ RungeKuttaLevelIntegrator::initializeLevelData(
      * time gets set when we allocate data, re-stamp it to current
      * time if we don't need to allocate.
      */
+    
+    std::set<hier::BoxId> unchanged_box_ids;
+    
     if (allocate_data)
     {
-        level->allocatePatchData(d_new_patch_init_data, init_data_time);
-        level->allocatePatchData(d_old_time_dep_data, init_data_time);
+        if (old_level && d_reuse_unchanged_patches_in_regrid)
+        {
+            /*
+             * Let the new patches that have the same boxes as the local patches of the old level
+             * take the patch data of the old patches. Since only the local patches are matched,
+             * the matched patches also have the same owner. The other new patches are allocated.
+             */
+            
+            reuseUnchangedPatchData(
+                unchanged_box_ids,
+                level,
+                old_level,
+                init_data_time);
+            
+            for (hier::PatchLevel::iterator ip(level->begin());
+                 ip != level->end();
+                 ip++)
+            {
+                const boost::shared_ptr<hier::Patch>& patch = *ip;
+                
+                if (unchanged_box_ids.find(patch->getBox().getBoxId()) == unchanged_box_ids.end())
+                {
+                    patch->allocatePatchData(d_new_patch_init_data, init_data_time);
+                    patch->allocatePatchData(d_old_time_dep_data, init_data_time);
+                }
+            }
+        }
+        else
+        {
+            level->allocatePatchData(d_new_patch_init_data, init_data_time);
+            level->allocatePatchData(d_old_time_dep_data, init_data_time);
+        }
     }
     else
     {
@@ -391,13 +452,36 @@ RungeKuttaLevelIntegrator::initializeLevelData(
     {
         t_init_level_create_sched->start();
         
-        boost::shared_ptr<xfer::RefineSchedule> sched(
-            d_fill_new_level->createSchedule(
+        boost::shared_ptr<xfer::RefineSchedule> sched;
+        
+        if (old_level && d_reuse_unchanged_patches_in_regrid && allocate_data)
+        {
+            /*
+             * Only fill the new or changed patches. The fill pattern has to be used on all the
+             * processors even if no patch is unchanged locally since the fill boxes are
+             * communicated.
+             */
+            
+            boost::shared_ptr<xfer::PatchLevelFillPattern> fill_pattern(
+                new PatchLevelChangedPatchesFillPattern(unchanged_box_ids));
+            
+            sched = d_fill_new_level->createSchedule(
+                fill_pattern,
+                level,
+                old_level,
+                level_number - 1,
+                hierarchy,
+                d_patch_strategy);
+        }
+        else
+        {
+            sched = d_fill_new_level->createSchedule(
                 level,
                 old_level,
                 level_number - 1,
                 hierarchy,
-                d_patch_strategy));
+                d_patch_strategy);
+        }
         
         mpi.Barrier();
         
@@ -464,6 +548,21 @@ RungeKuttaLevelIntegrator::initializeLevelData(
         patch->deallocatePatchData(d_temp_var_scratch_data);
     }
     d_patch_strategy->clearDataContext();
+    
+#ifdef HAVE_HDF5
+    /*
+     * If the simulation is restarted from the hierarchy data of a restart written with a different
+     * number of processes, overwrite the initial conditions of the time-dependent data with the
+     * data of the restart.
+     */
+    if (initial_time && d_restart_hierarchy_data_reader)
+    {
+        d_restart_hierarchy_data_reader->readLevelData(
+            level,
+            getCurrentTimeDependentPatchDataIndices());
+    }
+#endif
+    
     mpi.Barrier();
     t_init_level_fill_interior->stop();
     
@@ -504,10 +603,54 @@ RungeKuttaLevelIntegrator::resetHierarchyConfiguration(
     d_bdry_sched_advance.resize(finest_hiera_level + 1);
     d_bdry_sched_advance_new.resize(finest_hiera_level + 1);
     
+    d_bdry_sched_intermediate.resize(finest_hiera_level + 1);
+    d_bdry_sched_intermediate_level.resize(finest_hiera_level + 1);
+    
+    d_fill_flux_register_sched.resize(finest_hiera_level + 1);
+    d_fill_flux_register_sched_level.resize(finest_hiera_level + 1);
+    
+    d_patch_batches.resize(finest_hiera_level + 1);
+    d_patch_batches_level.resize(finest_hiera_level + 1);
+    
+    /*
+     * Discard the cached coarsen schedules between the pairs of levels that involve the reset
+     * levels. They are created again the first time that they are needed.
+     */
+    
+    d_coarsen_fluxsum_sched.resize(finest_hiera_level + 1);
+    d_coarsen_sync_sched.resize(finest_hiera_level + 1);
+    d_sync_initial_sched.resize(finest_hiera_level + 1);
+    d_coarsen_sched_coarse_level.resize(finest_hiera_level + 1);
+    d_coarsen_sched_fine_level.resize(finest_hiera_level + 1);
+    
+    d_reflux_boxes.resize(finest_hiera_level + 1);
+    
+    for (int ln = std::max(coarsest_level, 1); ln <= finest_hiera_level; ln++)
+    {
+        d_coarsen_fluxsum_sched[ln].reset();
+        d_coarsen_sync_sched[ln].reset();
+        d_sync_initial_sched[ln].reset();
+        
+        d_coarsen_sched_coarse_level[ln] = hierarchy->getPatchLevel(ln - 1);
+        d_coarsen_sched_fine_level[ln] = hierarchy->getPatchLevel(ln);
+        
+        d_reflux_boxes[ln].clear();
+        if (d_use_sparse_refluxing)
+        {
+            computeRefluxBoxes(
+                d_reflux_boxes[ln],
+                d_coarsen_sched_coarse_level[ln],
+                d_coarsen_sched_fine_level[ln]);
+        }
+    }
+    
     for (int ln = coarsest_level; ln <= finest_hiera_level; ln++)
     {
         boost::shared_ptr<hier::PatchLevel> level(hierarchy->getPatchLevel(ln));
         
+        buildPatchBatches(d_patch_batches[ln], level);
+        d_patch_batches_level[ln] = level;
+        
         t_advance_bdry_fill_create->start();
         
         d_bdry_sched_advance[ln] =
@@ -518,6 +661,35 @@ RungeKuttaLevelIntegrator::resetHierarchyConfiguration(
                 d_patch_strategy,
                 true);
         
+        /*
+         * Create the schedules of the intermediate data of the Runge-Kutta sub-steps. The schedule
+         * of the first sub-step is only needed by the fast patches with local time stepping and by
+         * the sub-intervals of the retried steps with adaptive CFL number.
+         */
+        
+        const bool use_first_sub_step_schedule = d_use_local_time_stepping || d_use_adaptive_cfl;
+        
+        d_bdry_sched_intermediate[ln].resize(d_number_steps);
+        for (int sn = (use_first_sub_step_schedule ? 0 : 1); sn < d_number_steps; sn++)
+        {
+            d_bdry_sched_intermediate[ln][sn] =
+                d_bdry_fill_intermediate[sn]->createSchedule(
+                    level,
+                    d_patch_strategy);
+        }
+        d_bdry_sched_intermediate_level[ln] = level;
+        
+        /*
+         * Create the schedule of the flux registers used to correct the slow patches with local
+         * time stepping.
+         */
+        
+        if (d_use_local_time_stepping)
+        {
+            d_fill_flux_register_sched[ln] = d_fill_flux_register->createSchedule(level);
+            d_fill_flux_register_sched_level[ln] = level;
+        }
+        
         t_advance_bdry_fill_create->stop();
      
         if (!d_lag_dt_computation && d_use_ghosts_for_dt)
@@ -535,6 +707,15 @@ RungeKuttaLevelIntegrator::resetHierarchyConfiguration(
             t_new_advance_bdry_fill_create->stop();
         }
     }
+    
+    /*
+     * Let the patch strategy update the data cached per patch of the reset levels.
+     */
+    
+    d_patch_strategy->resetHierarchyConfiguration(
+        hierarchy,
+        coarsest_level,
+        finest_hiera_level);
 }
 
 
@@ -915,6 +1096,149 @@ RungeKuttaLevelIntegrator::applyIntegralDetector(
 }
 
 
+/*
+ **************************************************************************************************
+ *
+ * Call patch routines to tag cells with all the detectors that are used. The ghost cells are
+ * filled once and the cells are tagged by all the detectors in a single loop over the patches.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::applyMultipleDetectors(
+    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+    const int level_number,
+    const double error_data_time,
+    const int tag_index,
+    const bool initial_time,
+    const bool uses_value_detector,
+    const bool uses_gradient_detector,
+    const bool uses_multiresolution_detector,
+    const bool uses_integral_detector,
+    const bool uses_richardson_extrapolation_too)
+{
+    TBOX_ASSERT(hierarchy);
+    TBOX_ASSERT((level_number >= 0) &&
+                (level_number <= hierarchy->getFinestLevelNumber()));
+    TBOX_ASSERT(hierarchy->getPatchLevel(level_number));
+    
+    t_apply_multiple_detectors->start();
+    
+    boost::shared_ptr<hier::PatchLevel> level(
+        hierarchy->getPatchLevel(level_number));
+    
+    level->allocatePatchData(d_saved_var_scratch_data, error_data_time);
+    level->allocatePatchData(d_temp_var_scratch_data, error_data_time);
+    
+    d_patch_strategy->setDataContext(d_scratch);
+    
+    const tbox::SAMRAI_MPI& mpi(level->getBoxLevel()->getMPI());
+    
+    t_error_bdry_fill_comm->start();
+    d_bdry_sched_advance[level_number]->fillData(error_data_time);
+    
+    if (s_barrier_after_error_bdry_fill_comm)
+    {
+        t_barrier_after_error_bdry_fill_comm->start();
+        mpi.Barrier();
+        t_barrier_after_error_bdry_fill_comm->stop();
+    }
+    t_error_bdry_fill_comm->stop();
+    
+    d_patch_strategy->preprocessTagCellsMultipleDetectors(
+        hierarchy,
+        level_number,
+        error_data_time,
+        initial_time,
+        uses_value_detector,
+        uses_gradient_detector,
+        uses_multiresolution_detector,
+        uses_integral_detector,
+        uses_richardson_extrapolation_too);
+    
+    t_tag_cells->start();
+    for (hier::PatchLevel::iterator ip(level->begin());
+         ip != level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = *ip;
+        
+        if (uses_integral_detector)
+        {
+            d_patch_strategy->tagCellsOnPatchIntegralDetector(
+                *patch,
+                error_data_time,
+                initial_time,
+                tag_index,
+                uses_value_detector,
+                uses_gradient_detector,
+                uses_multiresolution_detector,
+                uses_richardson_extrapolation_too);
+        }
+        
+        if (uses_multiresolution_detector)
+        {
+            d_patch_strategy->tagCellsOnPatchMultiresolutionDetector(
+                *patch,
+                error_data_time,
+                initial_time,
+                tag_index,
+                uses_value_detector,
+                uses_gradient_detector,
+                uses_integral_detector,
+                uses_richardson_extrapolation_too);
+        }
+        
+        if (uses_gradient_detector)
+        {
+            d_patch_strategy->tagCellsOnPatchGradientDetector(
+                *patch,
+                error_data_time,
+                initial_time,
+                tag_index,
+                uses_value_detector,
+                uses_multiresolution_detector,
+                uses_integral_detector,
+                uses_richardson_extrapolation_too);
+        }
+        
+        if (uses_value_detector)
+        {
+            d_patch_strategy->tagCellsOnPatchValueDetector(
+                *patch,
+                error_data_time,
+                initial_time,
+                tag_index,
+                uses_gradient_detector,
+                uses_multiresolution_detector,
+                uses_integral_detector,
+                uses_richardson_extrapolation_too);
+        }
+    }
+    t_tag_cells->stop();
+    
+    d_patch_strategy->postprocessTagCellsMultipleDetectors(
+        hierarchy,
+        level_number,
+        error_data_time,
+        initial_time,
+        uses_value_detector,
+        uses_gradient_detector,
+        uses_multiresolution_detector,
+        uses_integral_detector,
+        uses_richardson_extrapolation_too);
+    
+    d_patch_strategy->clearDataContext();
+    
+    copyTimeDependentData(level, d_scratch, d_current);
+    
+    level->deallocatePatchData(d_temp_var_scratch_data);
+    level->deallocatePatchData(d_saved_var_scratch_data);
+    
+    t_apply_multiple_detectors->stop();
+}
+
+
 /*
  **************************************************************************************************
  *
@@ -1188,6 +1512,16 @@ RungeKuttaLevelIntegrator::getLevelDt(
         
         double dt = tbox::MathUtilities<double>::getMax();
         
+        std::map<hier::GlobalId, double> patch_stable_dt;
+        
+        /*
+         * The level time increment is a global min over all patches. The reduction is posted as
+         * soon as the local min is known and is completed after the remaining local work.
+         */
+        
+        FusedMPIReduction dt_reduction(mpi);
+        int dt_idx = -1;
+        
         if (!d_use_ghosts_for_dt)
         {
             //tbox::plog << "!use ghosts for dt" << std::endl;
@@ -1210,6 +1544,12 @@ RungeKuttaLevelIntegrator::getLevelDt(
                         dt_time);
                 
                 dt = tbox::MathUtilities<double>::Min(dt, patch_dt);
+                
+                if (d_use_local_time_stepping)
+                {
+                    patch_stable_dt[patch->getGlobalId()] = patch_dt;
+                }
+                
                 //tbox::plog.precision(12);
                 //tbox::plog << "Level " << level->getLevelNumber()
                 //           << " Patch " << *p
@@ -1221,6 +1561,9 @@ RungeKuttaLevelIntegrator::getLevelDt(
                 patch->deallocatePatchData(d_temp_var_scratch_data);
             }
          
+            dt_idx = dt_reduction.addMin(dt);
+            dt_reduction.post();
+            
             d_patch_strategy->clearDataContext();
         }
         else
@@ -1251,6 +1594,12 @@ RungeKuttaLevelIntegrator::getLevelDt(
                         dt_time);
                 
                 dt = tbox::MathUtilities<double>::Min(dt, patch_dt);
+                
+                if (d_use_local_time_stepping)
+                {
+                    patch_stable_dt[patch->getGlobalId()] = patch_dt;
+                }
+                
                 //tbox::plog.precision(12);
                 //tbox::plog << "Level " << level->getLevelNumber()
                 //           << " Patch " << *ip
@@ -1262,6 +1611,9 @@ RungeKuttaLevelIntegrator::getLevelDt(
                 patch->deallocatePatchData(d_temp_var_scratch_data);
             }
             
+            dt_idx = dt_reduction.addMin(dt);
+            dt_reduction.post();
+            
             d_patch_strategy->clearDataContext();
             
             /*
@@ -1275,6 +1627,19 @@ RungeKuttaLevelIntegrator::getLevelDt(
             level->deallocatePatchData(d_saved_var_scratch_data);
         }
         
+        /*
+         * With local time stepping, the stable time increments of the patches are stored and the
+         * level time increment is the one of the slow patches.
+         */
+        
+        if (d_use_local_time_stepping)
+        {
+            storePatchStableDt(
+                level,
+                patch_stable_dt,
+                tbox::MathUtilities<double>::Min(d_cfl_init, d_cfl));
+        }
+        
         t_get_level_dt_sync->start();
         
         if (d_distinguish_mpi_reduction_costs)
@@ -1284,15 +1649,9 @@ RungeKuttaLevelIntegrator::getLevelDt(
             t_get_level_dt_mpi_reductions->start();
         }
         
-        /*
-         * The level time increment is a global min over all patches.
-         */
+        dt_reduction.complete();
         
-        global_dt = dt;
-        if (mpi.getSize() > 1)
-        {
-            mpi.AllReduce(&global_dt, 1, MPI_MIN);
-        }
+        global_dt = dt_reduction.getValue(dt_idx);
         global_dt *= tbox::MathUtilities<double>::Min(d_cfl_init, d_cfl);
         
         if (d_distinguish_mpi_reduction_costs)
@@ -1303,6 +1662,11 @@ RungeKuttaLevelIntegrator::getLevelDt(
         {
             t_get_level_dt_sync->stop();
         }
+        
+        if (d_use_local_time_stepping)
+        {
+            global_dt *= double(d_local_time_stepping_ratio);
+        }
     }
     else
     {
@@ -1539,7 +1903,6 @@ RungeKuttaLevelIntegrator::advanceLevel(
     }
     
     d_patch_strategy->clearDataContext();
-    fill_schedule.reset();
     
     preprocessFluxAndSourceData(
         level,
@@ -1551,10 +1914,10 @@ RungeKuttaLevelIntegrator::advanceLevel(
     
     /*
      * (5) Call user-routine to pre-process state data, if needed.
-     * (6) Initialize all fluxes with zero values
      * (6) Advance solution on all level patches (scratch storage).
      *     In looping over Runge-Kutta sub-steps,
-     *     (6a) Copy data from scatch data to the intermediate data.
+     *     (6a) Swap or copy data from scatch data to the intermediate data. All fluxes and sources
+     *          are initialized with zero values in the first sub-step.
      *          Dirchlet boundary conditions are applied at the coarse-fine boundaries of patches.
      *     (6b) Compute intermediate fluxes of current step.
      *     (6c) Advance one Runge-Kutta sub-step and accumulate the intermediate flux to the total
@@ -1583,129 +1946,199 @@ RungeKuttaLevelIntegrator::advanceLevel(
         const boost::shared_ptr<hier::Patch>& patch = *ip;
         
         patch->allocatePatchData(d_temp_var_scratch_data, current_time);
+    }
+    
+    /*
+     * Get the batches of patches of the level. They are built here if the level is not the one in
+     * the hierarchy that they were built for (e.g. a temporary level during regridding).
+     */
+    
+    std::vector<std::vector<boost::shared_ptr<hier::Patch> > > patch_batches_temp;
+    const std::vector<std::vector<boost::shared_ptr<hier::Patch> > >* patch_batches = nullptr;
+    
+    if (level_number < static_cast<int>(d_patch_batches_level.size()) &&
+        d_patch_batches_level[level_number] == level)
+    {
+        patch_batches = &d_patch_batches[level_number];
+    }
+    else
+    {
+        buildPatchBatches(patch_batches_temp, level);
+        patch_batches = &patch_batches_temp;
+    }
+    
+    /*
+     * Advance the solution with the Runge-Kutta sub-steps. With local time stepping, patches take
+     * different numbers of steps. With adaptive CFL number, the level may be advanced more than
+     * once per step if the step is retried.
+     */
+    
+    int num_level_advances = 1;
+    
+    if (d_use_local_time_stepping && !regrid_advance)
+    {
+        advanceLevelWithLocalTimeStepping(
+            level,
+            *patch_batches,
+            current_time,
+            dt);
+    }
+    else if (d_use_adaptive_cfl && !regrid_advance)
+    {
+        /*
+         * Check the step with the embedded Runge-Kutta method after each sub-interval. A rejected
+         * step is retried from the pre-advance state with twice as many sub-intervals. The fluxes
+         * and sources are accumulated over the sub-intervals.
+         */
         
-        // Fill all fluxes with zero values.
+        int num_sub_intervals = 1;
         
-        std::list<boost::shared_ptr<hier::Variable> >::iterator flux_var =
-            d_flux_variables.begin();
+        num_level_advances = 0;
         
-        while (flux_var != d_flux_variables.end())
-        {            
-            if (d_flux_is_face)
+        for (int ri = 0; ri <= d_max_step_retries; ri++)
+        {
+            const double dt_sub_interval = dt/double(num_sub_intervals);
+            
+            double error = 0.0;
+            bool is_admissible = true;
+            
+            for (int ti = 0; ti < num_sub_intervals; ti++)
             {
-                boost::shared_ptr<pdat::FaceData<double> > flux_data(
-                    BOOST_CAST<pdat::FaceData<double>, hier::PatchData>(
-                        patch->getPatchData(*flux_var, d_scratch)));
+                advanceRungeKuttaSubSteps(
+                    level,
+                    *patch_batches,
+                    current_time + double(ti)*dt_sub_interval,
+                    dt_sub_interval,
+                    ti > 0,
+                    ti == 0,
+                    regrid_advance);
+                
+                num_level_advances++;
+                
+                bool is_sub_interval_admissible = true;
+                
+                error = tbox::MathUtilities<double>::Max(error,
+                    checkRungeKuttaStep(level, is_sub_interval_admissible));
                 
-                TBOX_ASSERT(flux_data);
-                flux_data->fillAll(0.0);
+                is_admissible = is_admissible && is_sub_interval_admissible;
+                
+                /*
+                 * Stop at the first rejected sub-interval unless it is the last retry.
+                 */
+                if ((!is_admissible || error > 1.0) && ri < d_max_step_retries)
+                {
+                    break;
+                }
             }
-            else
+            
+            if (is_admissible && error <= 1.0)
             {
-                boost::shared_ptr<pdat::SideData<double> > flux_data(
-                    BOOST_CAST<pdat::SideData<double>, hier::PatchData>(
-                        patch->getPatchData(*flux_var, d_scratch)));
+                d_adaptive_cfl_error = tbox::MathUtilities<double>::Max(d_adaptive_cfl_error,
+                    error);
                 
-                TBOX_ASSERT(flux_data);
-                flux_data->fillAll(0.0);
+                break;
             }
             
-            flux_var++;
-        }
-        
-        // Fill all sources with zero values.
-        
-        std::list<boost::shared_ptr<hier::Variable> >::iterator source_var =
-            d_source_variables.begin();
-        
-        while (source_var != d_source_variables.end())
-        {
-            boost::shared_ptr<pdat::CellData<double> > source_data(
-                BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
-                    patch->getPatchData(*source_var, d_scratch)));
+            /*
+             * Reduce the CFL number of the next steps, since the step is too large.
+             */
             
-            source_data->fillAll(0.0);
+            adaptCflNumber(is_admissible ? error : tbox::MathUtilities<double>::getMax());
             
-            source_var++;
-        }
-    }
-    
-    const tbox::SAMRAI_MPI& mpi(hierarchy->getMPI());
-    for (int sn = 0; sn < d_number_steps; sn++)
-    {
-        d_patch_strategy->setDataContext(d_intermediate[sn]);
-        
-        // Copy scratch data to intermediate data corresponding to current step.
-        copyTimeDependentData(level, d_scratch, d_intermediate[sn]);
-        
-        /*
-         * Fill the ghost cell data for current intemediate data factory.
-         */
-        
-        boost::shared_ptr<xfer::RefineSchedule> fill_schedule_intermediate;
-        
-        if (sn > 0)
-        {
-            fill_schedule_intermediate = 
-                d_bdry_fill_intermediate[sn]->createSchedule(
-                    level,
-                    d_patch_strategy);
-            
-            if (regrid_advance)
-            {
-                t_error_bdry_fill_comm->start();
-            }
-            else
+            /*
+             * After the last retry, a step that is not accurate enough is accepted. A step with
+             * inadmissible state (e.g. negative density or pressure) cannot be continued.
+             */
+            if (ri == d_max_step_retries)
             {
-                t_advance_bdry_fill_comm->start();
+                if (!is_admissible)
+                {
+                    TBOX_ERROR(d_object_name
+                        << ":  "
+                        << "Step on level "
+                        << level_number
+                        << " from time "
+                        << current_time
+                        << " is not admissible after "
+                        << d_max_step_retries
+                        << " retries."
+                        << std::endl);
+                }
+                
+                TBOX_WARNING(d_object_name
+                    << ":  "
+                    << "Step on level "
+                    << level_number
+                    << " from time "
+                    << current_time
+                    << " is accepted after "
+                    << d_max_step_retries
+                    << " retries although it is not accurate enough."
+                    << std::endl);
+                
+                break;
             }
             
-            fill_schedule_intermediate->fillData(current_time);
+            tbox::plog << d_object_name
+                       << ": step on level "
+                       << level_number
+                       << " from time "
+                       << current_time
+                       << " is rejected and retried with "
+                       << 2*num_sub_intervals
+                       << " sub-intervals."
+                       << std::endl;
             
-            if (regrid_advance)
-            {
-                t_error_bdry_fill_comm->stop();
-            }
-            else
-            {
-                t_advance_bdry_fill_comm->stop();
-            }
-        }
-        
-        d_patch_strategy->setDataContext(d_scratch);
+            /*
+             * Reset the scratch data to the pre-advance state.
+             */
             
-        for (hier::PatchLevel::iterator ip(level->begin());
-             ip != level->end();
-             ip++)
-        {
-            const boost::shared_ptr<hier::Patch>& patch = *ip;
+            d_patch_strategy->setDataContext(d_scratch);
             
-            t_patch_num_kernel->start();
+            copyTimeDependentData(level, d_current, d_scratch);
             
-            // Compute flux corresponding to this sub-step.
-            d_patch_strategy->computeFluxesAndSourcesOnPatch(
-                *patch,
-                current_time,
-                dt,
-                sn,
-                d_intermediate[sn]);
+            t_advance_bdry_fill_comm->start();
+            fill_schedule->fillData(current_time);
+            t_advance_bdry_fill_comm->stop();
             
-            // Advance a Runge-Kutta sub-step.
-            d_patch_strategy->advanceSingleStepOnPatch(
-                *patch,
-                current_time,
-                dt,
-                d_alpha[sn],
-                d_beta[sn],
-                d_gamma[sn],
-                d_intermediate);
+            d_patch_strategy->clearDataContext();
             
-            t_patch_num_kernel->stop();
+            num_sub_intervals *= 2;
         }
         
-        fill_schedule_intermediate.reset();
+        /*
+         * The CFL number is adapted once the coarsest level is advanced, with the errors of the
+         * steps taken on all the levels since the last adaptation.
+         */
+        
+        if (level_number == 0)
+        {
+            adaptCflNumber(d_adaptive_cfl_error);
+            d_adaptive_cfl_error = 0.0;
+        }
+    }
+    else
+    {
+        advanceRungeKuttaSubSteps(
+            level,
+            *patch_batches,
+            current_time,
+            dt,
+            false,
+            true,
+            regrid_advance);
+    }
+    
+    fill_schedule.reset();
+    
+    if (!regrid_advance)
+    {
+        d_num_local_cell_updates +=
+            double(num_level_advances)*double(level->getLocalNumberOfCells());
     }
     
+    const tbox::SAMRAI_MPI& mpi(hierarchy->getMPI());
+    
     for (hier::PatchLevel::iterator ip(level->begin());
          ip != level->end();
          ip++)
@@ -1747,6 +2180,8 @@ RungeKuttaLevelIntegrator::advanceLevel(
     
     double dt_next = tbox::MathUtilities<double>::getMax();
     
+    std::map<hier::GlobalId, double> patch_stable_dt;
+    
     if (!regrid_advance)
     {
         if (d_use_cfl)
@@ -1804,9 +2239,19 @@ RungeKuttaLevelIntegrator::advanceLevel(
                 
                 dt_next = tbox::MathUtilities<double>::Min(dt_next, patch_dt);
                 
+                if (d_use_local_time_stepping)
+                {
+                    patch_stable_dt[patch->getGlobalId()] = patch_dt;
+                }
+                
                 patch->deallocatePatchData(d_temp_var_scratch_data);
             }
             d_patch_strategy->clearDataContext();
+            
+            if (d_use_local_time_stepping)
+            {
+                storePatchStableDt(level, patch_stable_dt, d_cfl);
+            }
         }
         else
         {
@@ -1815,6 +2260,15 @@ RungeKuttaLevelIntegrator::advanceLevel(
       
     } // !regrid_advance
     
+    /*
+     * The next time increment is a global min over all patches. The reduction is posted here and
+     * is completed after the local post-processing of the level.
+     */
+    
+    FusedMPIReduction dt_reduction(mpi);
+    const int dt_idx = dt_reduction.addMin(dt_next);
+    dt_reduction.post();
+    
     level->deallocatePatchData(d_saved_var_scratch_data);
     
     for (int sn = 0; sn < d_number_steps; sn++)
@@ -1841,16 +2295,18 @@ RungeKuttaLevelIntegrator::advanceLevel(
         t_advance_mpi_reductions->start();
     }
     
-    double next_dt = dt_next;
+    dt_reduction.complete();
     
-    if (mpi.getSize() > 1)
-    {
-        mpi.AllReduce(&next_dt, 1, MPI_MIN);
-    }
+    double next_dt = dt_reduction.getValue(dt_idx);
     
     if (d_use_cfl)
     {
         next_dt *= d_cfl;
+        
+        if (d_use_local_time_stepping && !regrid_advance)
+        {
+            next_dt *= double(d_local_time_stepping_ratio);
+        }
     }
     
     if (d_distinguish_mpi_reduction_costs)
@@ -1868,397 +2324,1447 @@ RungeKuttaLevelIntegrator::advanceLevel(
 
 /*
  **************************************************************************************************
- * 
- * Synchronize data between patch levels according to the standard flux correction algorithm.
- * 
+ *
+ * Advance the solution on the given batches of patches of a level by one Runge-Kutta step. The
+ * ghost cells of the intermediate data of the first sub-step are filled if fill_first_sub_step is
+ * true. Otherwise, the ghost cells of the scratch data are used. The flux and source data are
+ * initialized with zero values if zero_fluxes_and_sources is true. Otherwise, the fluxes and
+ * sources of the step are accumulated to the existing values.
+ *
  **************************************************************************************************
  */
 void
-RungeKuttaLevelIntegrator::standardLevelSynchronization(
-    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
-    const int coarsest_level,
-    const int finest_level,
-    const double sync_time,
-    const double old_time)
-{
-    TBOX_ASSERT(hierarchy);
-    
-    std::vector<double> old_times(finest_level - coarsest_level + 1);
-    for (int i = coarsest_level; i <= finest_level; i++)
-    {
-        old_times[i] = old_time;
-    }
-    
-    standardLevelSynchronization(
-        hierarchy,
-        coarsest_level,
-        finest_level,
-        sync_time,
-        old_times);
-}
-
-
-void
-RungeKuttaLevelIntegrator::standardLevelSynchronization(
-    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
-    const int coarsest_level,
-    const int finest_level,
-    const double sync_time,
-    const std::vector<double>& old_times)
+RungeKuttaLevelIntegrator::advanceRungeKuttaSubSteps(
+    const boost::shared_ptr<hier::PatchLevel>& level,
+    const std::vector<std::vector<boost::shared_ptr<hier::Patch> > >& patch_batches,
+    const double current_time,
+    const double dt,
+    const bool fill_first_sub_step,
+    const bool zero_fluxes_and_sources,
+    const bool regrid_advance)
 {
-    TBOX_ASSERT(hierarchy);
-    TBOX_ASSERT((coarsest_level >= 0)
-                && (coarsest_level < finest_level)
-                && (finest_level <= hierarchy->getFinestLevelNumber()));
-    TBOX_ASSERT(static_cast<int>(old_times.size()) >= finest_level);
-#ifdef HAMERS_DEBUG_CHECK_ASSERTIONS
-    for (int ln = coarsest_level; ln < finest_level; ln++)
-    {
-        TBOX_ASSERT(hierarchy->getPatchLevel(ln));
-        TBOX_ASSERT(sync_time >= old_times[ln]);
-    }
-#endif
-    TBOX_ASSERT(hierarchy->getPatchLevel(finest_level));
-    
-    t_std_level_sync->start();
+    const int level_number = level->getLevelNumber();
     
-    for (int fine_ln = finest_level; fine_ln > coarsest_level; --fine_ln)
+    for (int sn = 0; sn < d_number_steps; sn++)
     {
-        const int coarse_ln = fine_ln - 1;
+        d_patch_strategy->setDataContext(d_intermediate[sn]);
         
-        boost::shared_ptr<hier::PatchLevel> fine_level(
-           hierarchy->getPatchLevel(fine_ln));
+        /*
+         * Move scratch data to intermediate data corresponding to current step. The patch data are
+         * swapped between the contexts if possible. Otherwise, the data are copied.
+         */
         
-        boost::shared_ptr<hier::PatchLevel> coarse_level(
-           hierarchy->getPatchLevel(coarse_ln));
+        t_advance_copy_intermediate_data->start();
         
-        synchronizeLevelWithCoarser(
-            fine_level,
-            coarse_level,
-            sync_time,
-            old_times[coarse_ln]);
+        if (d_swap_intermediate_data && d_intermediate_data_swappable)
+        {
+            swapTimeDependentData(level, d_scratch, d_intermediate[sn]);
+        }
+        else
+        {
+            copyTimeDependentData(level, d_scratch, d_intermediate[sn]);
+        }
         
-        fine_level->deallocatePatchData(d_fluxsum_data);
-        fine_level->deallocatePatchData(d_flux_var_data);
-        fine_level->deallocatePatchData(d_source_var_data);
+        t_advance_copy_intermediate_data->stop();
         
-        if (coarse_ln > coarsest_level)
+        /*
+         * Fill the ghost cell data for current intemediate data factory.
+         */
+        
+        if (sn > 0 || fill_first_sub_step)
         {
-            coarse_level->deallocatePatchData(d_flux_var_data);
-            coarse_level->deallocatePatchData(d_source_var_data);
+            /*
+             * Use the schedule cached in resetHierarchyConfiguration() if the level is the one in
+             * the hierarchy that it was created for. Otherwise, generate a temporary schedule.
+             */
+            
+            boost::shared_ptr<xfer::RefineSchedule> fill_schedule_intermediate;
+            
+            if (level_number < static_cast<int>(d_bdry_sched_intermediate_level.size()) &&
+                d_bdry_sched_intermediate_level[level_number] == level &&
+                d_bdry_sched_intermediate[level_number][sn])
+            {
+                fill_schedule_intermediate = d_bdry_sched_intermediate[level_number][sn];
+            }
+            else
+            {
+                if (regrid_advance)
+                {
+                    t_error_bdry_fill_create->start();
+                }
+                else
+                {
+                    t_advance_bdry_fill_create->start();
+                }
+                
+                fill_schedule_intermediate =
+                    d_bdry_fill_intermediate[sn]->createSchedule(
+                        level,
+                        d_patch_strategy);
+                
+                if (regrid_advance)
+                {
+                    t_error_bdry_fill_create->stop();
+                }
+                else
+                {
+                    t_advance_bdry_fill_create->stop();
+                }
+            }
+            
+            if (regrid_advance)
+            {
+                t_error_bdry_fill_comm->start();
+            }
+            else
+            {
+                t_advance_bdry_fill_comm->start();
+            }
+            
+            fill_schedule_intermediate->fillData(current_time);
+            
+            if (regrid_advance)
+            {
+                t_error_bdry_fill_comm->stop();
+            }
+            else
+            {
+                t_advance_bdry_fill_comm->stop();
+            }
         }
-        else
+        
+        d_patch_strategy->setDataContext(d_scratch);
+            
+        for (int bi = 0; bi < static_cast<int>(patch_batches.size()); bi++)
         {
-            if (coarsest_level == 0)
+            const std::vector<boost::shared_ptr<hier::Patch> >& patch_batch = patch_batches[bi];
+            
+            t_patch_num_kernel->start();
+            
+            /*
+             * Fill the fluxes and sources with zero values right before they are first accumulated
+             * so that the data of the batch are still in cache.
+             */
+            if (sn == 0 && zero_fluxes_and_sources)
             {
-                coarse_level->deallocatePatchData(d_flux_var_data);
-                d_have_flux_on_level_zero = false;
-                coarse_level->deallocatePatchData(d_source_var_data);
+                for (int pi = 0; pi < static_cast<int>(patch_batch.size()); pi++)
+                {
+                    fillZeroFluxAndSourceData(*patch_batch[pi], d_scratch);
+                }
             }
+            
+            // Compute flux corresponding to this sub-step.
+            d_patch_strategy->computeFluxesAndSourcesOnPatchBatch(
+                patch_batch,
+                current_time,
+                dt,
+                sn,
+                d_intermediate[sn]);
+            
+            // Advance a Runge-Kutta sub-step.
+            d_patch_strategy->advanceSingleStepOnPatchBatch(
+                patch_batch,
+                current_time,
+                dt,
+                d_alpha[sn],
+                d_beta[sn],
+                d_gamma[sn],
+                d_intermediate);
+            
+            t_patch_num_kernel->stop();
         }
     }
-    
-    t_std_level_sync->stop();
 }
 
 
 /*
  **************************************************************************************************
- *                                                                       
- * Coarsen current solution data from finest hierarchy level specified down through the coarsest
- * hierarchy level specified, if initial_time is true (i.e., hierarchy is being constructed at
- * initial simulation time). After data is coarsened, the user's initialization routine is called
- * to reset data (as needed by the application) before that solution is further coarsened to the
- * next coarser level in the hierarchy. If initial_time is false, then this routine does nothing
- * In that case, interpolation of data from coarser levels is sufficient to set data on new levels
- * in the hierarchy during regridding.
- * 
- * NOTE: The fact that this routine does nothing when called at any time later than when the AMR
- *       hierarchy is constructed initially may need to change at some point based on application
- *       needs.
- * 
+ *
+ * Store the stable time increments of the local patches of a level scaled by the given CFL number.
+ *
  **************************************************************************************************
  */
 void
-RungeKuttaLevelIntegrator::synchronizeNewLevels(
-    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
-    const int coarsest_level,
-    const int finest_level,
-    const double sync_time,
-    const bool initial_time)
+RungeKuttaLevelIntegrator::storePatchStableDt(
+    const boost::shared_ptr<hier::PatchLevel>& level,
+    const std::map<hier::GlobalId, double>& patch_stable_dt,
+    const double cfl)
 {
-    TBOX_ASSERT(hierarchy);
-    TBOX_ASSERT((coarsest_level >= 0)
-                && (coarsest_level < finest_level)
-                && (finest_level <= hierarchy->getFinestLevelNumber()));
+    const int level_number = level->getLevelNumber();
     
-#ifdef HAMERS_DEBUG_CHECK_ASSERTIONS
-    for (int ln = coarsest_level; ln <= finest_level; ln++)
+    if (level_number >= static_cast<int>(d_patch_stable_dt.size()))
     {
-        TBOX_ASSERT(hierarchy->getPatchLevel(ln));
+        d_patch_stable_dt.resize(level_number + 1);
+        d_patch_stable_dt_level.resize(level_number + 1);
     }
-#endif
     
-    t_sync_new_levels->start();
+    d_patch_stable_dt[level_number].clear();
     
-    if (initial_time)
+    for (std::map<hier::GlobalId, double>::const_iterator it = patch_stable_dt.begin();
+         it != patch_stable_dt.end();
+         it++)
     {
-        d_patch_strategy->setDataContext(d_current);
-        
-        for (int fine_ln = finest_level; fine_ln > coarsest_level; --fine_ln)
-        {
-            const int coarse_ln = fine_ln - 1;
-            
-            boost::shared_ptr<hier::PatchLevel> fine_level(
-                hierarchy->getPatchLevel(fine_ln));
-            
-            boost::shared_ptr<hier::PatchLevel> coarse_level(
-                hierarchy->getPatchLevel(coarse_ln));
-            
-            t_sync_initial_create->start();
-            boost::shared_ptr<xfer::CoarsenSchedule> sched(
-                d_sync_initial_data->createSchedule(
-                    coarse_level,
-                    fine_level,
-                    d_patch_strategy));
-            t_sync_initial_create->stop();
-            
-            t_sync_initial_comm->start();
-            sched->coarsenData();
-            t_sync_initial_comm->stop();
-            
-            for (hier::PatchLevel::iterator p(coarse_level->begin());
-                 p != coarse_level->end();
-                 p++)
-            {
-                const boost::shared_ptr<hier::Patch>& patch = *p;
-                
-                patch->allocatePatchData(d_temp_var_scratch_data, sync_time);
-                
-                d_patch_strategy->initializeDataOnPatch(
-                    *patch,
-                    sync_time,
-                    initial_time);
-                
-                patch->deallocatePatchData(d_temp_var_scratch_data);
-            }
-        }
-        
-        d_patch_strategy->clearDataContext();
-    } // if (initial_time)
+        d_patch_stable_dt[level_number][it->first] = cfl*it->second;
+    }
     
-    t_sync_new_levels->stop();
+    d_patch_stable_dt_level[level_number] = level;
 }
 
 
 /*
  **************************************************************************************************
  *
- * Synchronize data between coarse and fine patch levels according to the standard flux correction
- * algorithm. The steps of the algorithm are:
- *
- *    (1) Replace coarse time-space flux integrals at coarse-fine boundaries with time-space flux
- *    integrals computed on fine level.
- *    (2) Repeat conservative difference on coarse level with corrected fluxes.
- *    (3) Conservatively coarsen solution on interior of fine level to coarse level.
+ * Check the step just taken on a level with the embedded Runge-Kutta method. The normalized error
+ * estimates and the admissibility of the new solution in the scratch space are reduced over all
+ * processes in a single fused reduction.
  *
  **************************************************************************************************
  */
-void
-RungeKuttaLevelIntegrator::synchronizeLevelWithCoarser(
-    const boost::shared_ptr<hier::PatchLevel>& fine_level,
-    const boost::shared_ptr<hier::PatchLevel>& coarse_level,
-    const double sync_time,
-    const double coarse_sim_time)
+double
+RungeKuttaLevelIntegrator::checkRungeKuttaStep(
+    const boost::shared_ptr<hier::PatchLevel>& level,
+    bool& is_admissible)
 {
-    TBOX_ASSERT(fine_level);
-    TBOX_ASSERT(coarse_level);
-    TBOX_ASSERT(coarse_level->getLevelNumber() ==
-       (fine_level->getLevelNumber() - 1));
-    TBOX_ASSERT_OBJDIM_EQUALITY2(*fine_level, *coarse_level);
-    TBOX_ASSERT(sync_time > coarse_sim_time);
-    
-    /*
-     * Coarsen flux integrals around fine patch boundaries to coarser level and replace coarse flux
-     * information where appropriate. NULL patch model is passed in to avoid over complicating coarsen
-     * process; i.e. patch model is not needed in coarsening of flux integrals.
-     */
-    
-    t_coarsen_fluxsum_create->start();
-    boost::shared_ptr<xfer::CoarsenSchedule> sched(
-        d_coarsen_fluxsum->createSchedule(
-            coarse_level,
-            fine_level,
-            0));
-    t_coarsen_fluxsum_create->stop();
-    
-    t_coarsen_fluxsum_comm->start();
-    sched->coarsenData();
-    t_coarsen_fluxsum_comm->stop();
+    TBOX_ASSERT(level);
     
-    /*
-     * Repeat conservative difference on coarser level.
-     */
-    coarse_level->allocatePatchData(d_saved_var_scratch_data, coarse_sim_time);
-    coarse_level->setTime(coarse_sim_time, d_flux_var_data);
+    double error_local = 0.0;
+    bool is_admissible_local = true;
     
     d_patch_strategy->setDataContext(d_scratch);
     
-    t_advance_bdry_fill_comm->start();
-    d_bdry_sched_advance[coarse_level->getLevelNumber()]->
-        fillData(coarse_sim_time);
-    t_advance_bdry_fill_comm->stop();
-    
-    const double reflux_dt = sync_time - coarse_sim_time;
-    
-    for (hier::PatchLevel::iterator ip(coarse_level->begin());
-         ip != coarse_level->end();
+    for (hier::PatchLevel::iterator ip(level->begin());
+         ip != level->end();
          ip++)
     {
         const boost::shared_ptr<hier::Patch>& patch = *ip;
         
-        patch->allocatePatchData(d_temp_var_scratch_data, coarse_sim_time);
-            
-        d_patch_strategy->synchronizeFluxes(*patch,
-           coarse_sim_time,
-           reflux_dt);
-        patch->deallocatePatchData(d_temp_var_scratch_data);
+        bool is_finite = true;
+        
+        error_local = tbox::MathUtilities<double>::Max(error_local,
+            computeErrorEstimateOnPatch(*patch, is_finite));
+        
+        if (!is_finite || !d_patch_strategy->isStateAdmissibleOnPatch(*patch))
+        {
+            is_admissible_local = false;
+        }
     }
     
     d_patch_strategy->clearDataContext();
     
-    copyTimeDependentData(coarse_level, d_scratch, d_new);
-    
-    coarse_level->deallocatePatchData(d_saved_var_scratch_data);
-    
-    /*
-     * Coarsen time-dependent data from fine patch interiors to coarse patches.
-     */
-    
-    t_coarsen_sync_create->start();
-    sched = d_coarsen_sync_data->createSchedule(
-        coarse_level,
-        fine_level,
-        d_patch_strategy);
-    t_coarsen_sync_create->stop();
-    
-    d_patch_strategy->setDataContext(d_new);
+    FusedMPIReduction step_reduction(level->getBoxLevel()->getMPI());
+    const int error_idx = step_reduction.addMax(error_local);
+    const int inadmissible_idx = step_reduction.addMax(is_admissible_local ? 0.0 : 1.0);
+    step_reduction.post();
+    step_reduction.complete();
     
-    t_coarsen_sync_comm->start();
-    sched->coarsenData();
-    t_coarsen_sync_comm->stop();
+    is_admissible = (step_reduction.getValue(inadmissible_idx) == 0.0);
     
-    d_patch_strategy->clearDataContext();
+    return step_reduction.getValue(error_idx);
 }
 
 
 /*
  **************************************************************************************************
  *
- * Reset time-dependent data on patch level by replacing current data with new. The boolean argument
- * is used for odd refinement ratios (in particular 3 used in certain applications).
+ * Compute the maximum normalized error estimate of the embedded Runge-Kutta method on a patch. The
+ * error estimate of each cell is the weighted sum of the intermediate solutions at the beginning of
+ * the sub-steps and the new solution in the scratch space, normalized by the absolute tolerance
+ * plus the relative tolerance times the larger magnitude of the old and new solutions. Only the
+ * cell-centered time-dependent variables are checked.
  *
  **************************************************************************************************
  */
-void
-RungeKuttaLevelIntegrator::resetTimeDependentData(
-   const boost::shared_ptr<hier::PatchLevel>& level,
-   const double new_time,
-   const bool can_be_refined)
+double
+RungeKuttaLevelIntegrator::computeErrorEstimateOnPatch(
+    const hier::Patch& patch,
+    bool& is_finite) const
 {
-    TBOX_ASSERT(level);
+    const int dim = patch.getDim().getValue();
+    const int num_stages = d_number_steps + 1;
     
-    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    TBOX_ASSERT(static_cast<int>(d_error_estimate_weights.size()) == num_stages);
     
-    double cur_time = 0.;
-    for (hier::PatchLevel::iterator ip(level->begin());
-         ip != level->end();
-         ip++)
+    is_finite = true;
+    
+    double error_max = 0.0;
+    
+    const hier::IntVector interior_dims = patch.getBox().numberCells();
+    
+    int interior_dims_padded[3];
+    for (int di = 0; di < 3; di++)
     {
-        const boost::shared_ptr<hier::Patch>& patch = *ip;
-        
-        std::list<boost::shared_ptr<hier::Variable> >::iterator time_dep_var =
+        interior_dims_padded[di] = (di < dim ? interior_dims[di] : 1);
+    }
+    
+    for (std::list<boost::shared_ptr<hier::Variable> >::const_iterator time_dep_var =
             d_time_dep_variables.begin();
+         time_dep_var != d_time_dep_variables.end();
+         time_dep_var++)
+    {
+        if (!boost::dynamic_pointer_cast<pdat::CellVariable<double> >(*time_dep_var))
+        {
+            continue;
+        }
         
-        while (time_dep_var != d_time_dep_variables.end())
+        /*
+         * Get the data of the stages (the intermediate solutions and the new solution) with the
+         * numbers of ghost cells and the dimensions of the ghost boxes padded to three dimensions.
+         */
+        
+        std::vector<boost::shared_ptr<pdat::CellData<double> > > stage_data(num_stages);
+        std::vector<int> num_ghosts(3*num_stages, 0);
+        std::vector<int> ghostcell_dims(3*num_stages, 1);
+        
+        for (int si = 0; si < num_stages; si++)
         {
-            int cur_indx =
-                variable_db->mapVariableAndContextToIndex(
+            stage_data[si] = BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                patch.getPatchData(
                     *time_dep_var,
-                    d_current);
-            int new_indx =
-                variable_db->mapVariableAndContextToIndex(
-                    *time_dep_var,
-                    d_new);
+                    si < d_number_steps ? d_intermediate[si] : d_scratch));
             
-            cur_time = patch->getPatchData(cur_indx)->getTime();
+            TBOX_ASSERT(stage_data[si]);
             
-            if (can_be_refined && d_number_time_data_levels == 3)
+            const hier::IntVector& num_ghosts_stage = stage_data[si]->getGhostCellWidth();
+            const hier::IntVector ghostcell_dims_stage = stage_data[si]->getGhostBox().numberCells();
+            
+            for (int di = 0; di < dim; di++)
             {
-                int old_indx = variable_db->mapVariableAndContextToIndex(
-                    *time_dep_var,
-                    d_old);
-                
-                patch->setPatchData(old_indx, patch->getPatchData(cur_indx));
-                
-                patch->setPatchData(cur_indx, patch->getPatchData(new_indx));
+                num_ghosts[3*si + di] = num_ghosts_stage[di];
+                ghostcell_dims[3*si + di] = ghostcell_dims_stage[di];
             }
-            else
+        }
+        
+        const int depth = stage_data[0]->getDepth();
+        
+        std::vector<const double*> u(num_stages);
+        std::vector<int> idx_row(num_stages);
+        
+        for (int vi = 0; vi < depth; vi++)
+        {
+            for (int si = 0; si < num_stages; si++)
             {
-                if (d_number_time_data_levels == 3)
+                u[si] = stage_data[si]->getPointer(vi);
+            }
+            
+            const double* const u_old = u[0];
+            const double* const u_new = u[num_stages - 1];
+            
+            for (int k = 0; k < interior_dims_padded[2]; k++)
+            {
+                for (int j = 0; j < interior_dims_padded[1]; j++)
                 {
-                    int old_indx = variable_db->mapVariableAndContextToIndex(
-                        *time_dep_var,
-                        d_old);
+                    // Compute the linear indices of the first cells in the row.
+                    for (int si = 0; si < num_stages; si++)
+                    {
+                        const int* n_g = &num_ghosts[3*si];
+                        const int* g_d = &ghostcell_dims[3*si];
+                        
+                        idx_row[si] = n_g[0] + (j + n_g[1])*g_d[0] + (k + n_g[2])*g_d[0]*g_d[1];
+                    }
                     
-                    patch->setPatchData(old_indx, patch->getPatchData(cur_indx));
+                    for (int i = 0; i < interior_dims_padded[0]; i++)
+                    {
+                        double error = 0.0;
+                        
+                        for (int si = 0; si < num_stages; si++)
+                        {
+                            error += d_error_estimate_weights[si]*u[si][idx_row[si] + i];
+                        }
+                        
+                        const double scale = d_adaptive_cfl_absolute_tolerance +
+                            d_adaptive_cfl_relative_tolerance*
+                                tbox::MathUtilities<double>::Max(
+                                    fabs(u_old[idx_row[0] + i]),
+                                    fabs(u_new[idx_row[num_stages - 1] + i]));
+                        
+                        const double error_normalized = fabs(error)/scale;
+                        
+                        // The comparison is false if the error is not a number.
+                        if (!(error_normalized <= tbox::MathUtilities<double>::getMax()))
+                        {
+                            is_finite = false;
+                        }
+                        else if (error_normalized > error_max)
+                        {
+                            error_max = error_normalized;
+                        }
+                    }
                 }
-                
-                patch->setPatchData(cur_indx, patch->getPatchData(new_indx));
             }
-            
-            patch->deallocatePatchData(new_indx);
-            
-            time_dep_var++;
         }
     }
     
-    level->setTime(new_time, d_new_patch_init_data);
-    
-    if (d_number_time_data_levels == 3)
-    {
-        level->setTime(cur_time, d_old_time_dep_data);
-    }
+    return error_max;
 }
 
 
 /*
  **************************************************************************************************
  *
- * Discard new data on level. This is used primarily to reset patch data after error estimation
- * (e.g., Richardson extrapolation.)
+ * Adapt the CFL number with the given normalized error estimate. The CFL number is scaled by
+ * safety factor 0.9 times the inverse of the error to the power of one over the order of the
+ * embedded method plus one. The scaling is limited to between 0.2 and 1.2 and the CFL number is
+ * limited to between d_cfl_min and d_cfl_max.
  *
  **************************************************************************************************
  */
 void
-RungeKuttaLevelIntegrator::resetDataToPreadvanceState(
-    const boost::shared_ptr<hier::PatchLevel>& level)
+RungeKuttaLevelIntegrator::adaptCflNumber(
+    const double error)
 {
-    TBOX_ASSERT(level);
+    double factor = 1.2;
     
-    /*
-     * De-allocate new context
-     */
-    level->deallocatePatchData(d_new_time_dep_data);
+    if (error > 0.0)
+    {
+        factor = 0.9*pow(1.0/error, 1.0/double(d_error_estimate_order + 1));
+        factor = tbox::MathUtilities<double>::Min(factor, 1.2);
+        factor = tbox::MathUtilities<double>::Max(factor, 0.2);
+    }
+    
+    d_cfl = tbox::MathUtilities<double>::Min(d_cfl*factor, d_cfl_max);
+    d_cfl = tbox::MathUtilities<double>::Max(d_cfl, d_cfl_min);
 }
 
 
 /*
  **************************************************************************************************
  *
- * Register given variable with algorithm according to specified algorithm role (i.e., RK_VAR_TYPE).
- * Assignment of descriptor indices to variable lists, component selectors, and communication
- * algorithms takes place here. The different cases are:
+ * Advance the solution on a level with local time stepping. The patches of the level are split
+ * into slow patches, whose stable time increments are not smaller than dt, and fast patches, which
+ * take d_local_time_stepping_ratio steps of dt/d_local_time_stepping_ratio. The patches whose
+ * stable time increments are unknown (e.g. new patches after regridding) are taken as fast patches.
+ *
+ * The slow patches are advanced first with the data of the fast patches at the current time. The
+ * fast patches are then advanced with the data of the slow patches linearly interpolated in time at
+ * the beginning of each step. Similar to the data at coarse-fine boundaries, the data of the
+ * neighboring patches of the other kind is fixed during the sub-steps of a Runge-Kutta step.
+ * Finally, the fluxes of the slow patches at the faces shared with fast patches are replaced by
+ * the fluxes accumulated by the fast patches and the conservative difference is repeated on the
+ * cells next to these faces.
+ *
+ * Each advance of the slow or fast patches copies the scratch data of the whole level to the
+ * intermediate data and fills the ghost cells of the whole level at every sub-step, since the
+ * patches that are not advanced are the sources of the ghost cells of the advanced patches. A step
+ * with both kinds of patches hence costs d_local_time_stepping_ratio + 1 times the level-wide
+ * copies and fills of a step without local time stepping. These are measured by the timers
+ * advance_copy_intermediate_data and advance_bdry_fill_comm. When all the patches of the level are
+ * of one kind, e.g. right after regridding, only that kind is advanced and no level-wide copies and
+ * fills are spent on the other kind.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::advanceLevelWithLocalTimeStepping(
+    const boost::shared_ptr<hier::PatchLevel>& level,
+    const std::vector<std::vector<boost::shared_ptr<hier::Patch> > >& patch_batches,
+    const double current_time,
+    const double dt)
+{
+    const int level_number = level->getLevelNumber();
+    
+    const double dt_fast = dt/double(d_local_time_stepping_ratio);
+    
+    /*
+     * Split the batches of patches into batches of slow patches and batches of fast patches.
+     */
+    
+    const std::map<hier::GlobalId, double>* patch_stable_dt = nullptr;
+    
+    if (level_number < static_cast<int>(d_patch_stable_dt_level.size()) &&
+        d_patch_stable_dt_level[level_number] == level)
+    {
+        patch_stable_dt = &d_patch_stable_dt[level_number];
+    }
+    
+    std::vector<std::vector<boost::shared_ptr<hier::Patch> > > slow_patch_batches;
+    std::vector<std::vector<boost::shared_ptr<hier::Patch> > > fast_patch_batches;
+    
+    std::vector<boost::shared_ptr<hier::Patch> > slow_patches;
+    std::set<hier::GlobalId> fast_patch_ids;
+    
+    for (int bi = 0; bi < static_cast<int>(patch_batches.size()); bi++)
+    {
+        std::vector<boost::shared_ptr<hier::Patch> > slow_patch_batch;
+        std::vector<boost::shared_ptr<hier::Patch> > fast_patch_batch;
+        
+        for (int pi = 0; pi < static_cast<int>(patch_batches[bi].size()); pi++)
+        {
+            const boost::shared_ptr<hier::Patch>& patch = patch_batches[bi][pi];
+            
+            bool is_slow_patch = false;
+            
+            if (patch_stable_dt)
+            {
+                std::map<hier::GlobalId, double>::const_iterator it =
+                    patch_stable_dt->find(patch->getGlobalId());
+                
+                if (it != patch_stable_dt->end() && it->second >= dt)
+                {
+                    is_slow_patch = true;
+                }
+            }
+            
+            if (is_slow_patch)
+            {
+                slow_patch_batch.push_back(patch);
+                slow_patches.push_back(patch);
+            }
+            else
+            {
+                fast_patch_batch.push_back(patch);
+                fast_patch_ids.insert(patch->getGlobalId());
+            }
+        }
+        
+        if (!slow_patch_batch.empty())
+        {
+            slow_patch_batches.push_back(slow_patch_batch);
+        }
+        
+        if (!fast_patch_batch.empty())
+        {
+            fast_patch_batches.push_back(fast_patch_batch);
+        }
+    }
+    
+    /*
+     * Count the slow and fast patches of the level on all processes.
+     */
+    
+    t_advance_mpi_reductions->start();
+    
+    FusedMPIReduction patch_count_reduction(level->getBoxLevel()->getMPI());
+    const int num_slow_patches_idx = patch_count_reduction.addSum(double(slow_patches.size()));
+    const int num_fast_patches_idx = patch_count_reduction.addSum(double(fast_patch_ids.size()));
+    patch_count_reduction.post();
+    patch_count_reduction.complete();
+    
+    t_advance_mpi_reductions->stop();
+    
+    const bool has_slow_patches = (patch_count_reduction.getValue(num_slow_patches_idx) > 0.0);
+    const bool has_fast_patches = (patch_count_reduction.getValue(num_fast_patches_idx) > 0.0);
+    
+    /*
+     * If all the patches are slow, the level is advanced with a single step.
+     */
+    
+    if (!has_fast_patches)
+    {
+        advanceRungeKuttaSubSteps(
+            level,
+            slow_patch_batches,
+            current_time,
+            dt,
+            false,
+            true,
+            false);
+        
+        return;
+    }
+    
+    /*
+     * Advance the slow patches with a single step and save their new data.
+     */
+    
+    if (has_slow_patches)
+    {
+        advanceRungeKuttaSubSteps(
+            level,
+            slow_patch_batches,
+            current_time,
+            dt,
+            false,
+            true,
+            false);
+        
+        for (int pi = 0; pi < static_cast<int>(slow_patches.size()); pi++)
+        {
+            copyTimeDependentDataOnPatch(*slow_patches[pi], d_scratch, d_new);
+        }
+    }
+    
+    /*
+     * Advance the fast patches with multiple steps. The fluxes and sources of the fast patches are
+     * accumulated over the steps.
+     */
+    
+    for (int ti = 0; ti < d_local_time_stepping_ratio; ti++)
+    {
+        const double theta = double(ti)/double(d_local_time_stepping_ratio);
+        
+        for (int pi = 0; pi < static_cast<int>(slow_patches.size()); pi++)
+        {
+            interpolateTimeDependentDataOnPatch(*slow_patches[pi], theta);
+        }
+        
+        advanceRungeKuttaSubSteps(
+            level,
+            fast_patch_batches,
+            current_time + double(ti)*dt_fast,
+            dt_fast,
+            ti > 0,
+            ti == 0,
+            false);
+    }
+    
+    for (int pi = 0; pi < static_cast<int>(slow_patches.size()); pi++)
+    {
+        copyTimeDependentDataOnPatch(*slow_patches[pi], d_new, d_scratch);
+    }
+    
+    /*
+     * Correct the fluxes of the slow patches at the faces shared with fast patches.
+     */
+    
+    if (has_slow_patches)
+    {
+        correctFluxesAtLocalTimeSteppingInterfaces(
+            level,
+            slow_patches,
+            fast_patch_ids,
+            current_time,
+            dt);
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Replace the fluxes of the slow patches at the faces shared with fast patches by the fluxes
+ * accumulated by the fast patches and repeat the conservative difference on the cells next to
+ * these faces. The fluxes at the boundaries of the fast patches and the kinds of the patches are
+ * exchanged through cell-centered registers whose ghost cells are filled from the neighboring
+ * patches. For the boundary cells on side si of direction di, the register stores the fluxes at
+ * the boundary faces in the components starting at (2*di + si)*depth.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::correctFluxesAtLocalTimeSteppingInterfaces(
+    const boost::shared_ptr<hier::PatchLevel>& level,
+    const std::vector<boost::shared_ptr<hier::Patch> >& slow_patches,
+    const std::set<hier::GlobalId>& fast_patch_ids,
+    const double current_time,
+    const double dt)
+{
+    const tbox::Dimension& dim = level->getDim();
+    
+    level->allocatePatchData(d_flux_register_data, current_time);
+    
+    /*
+     * Fill the registers on all patches.
+     */
+    
+    for (hier::PatchLevel::iterator ip(level->begin());
+         ip != level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = *ip;
+        
+        const hier::Box& patch_box = patch->getBox();
+        
+        const bool is_fast_patch =
+            (fast_patch_ids.find(patch->getGlobalId()) != fast_patch_ids.end());
+        
+        boost::shared_ptr<pdat::CellData<double> > patch_rate_data(
+            BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                patch->getPatchData(d_patch_rate_variable, d_scratch)));
+        
+        TBOX_ASSERT(patch_rate_data);
+        
+        patch_rate_data->fillAll(0.0);
+        patch_rate_data->fillAll(is_fast_patch ? double(d_local_time_stepping_ratio) : 1.0, patch_box);
+        
+        if (!is_fast_patch)
+        {
+            continue;
+        }
+        
+        std::list<boost::shared_ptr<hier::Variable> >::iterator flux_var =
+            d_flux_variables.begin();
+        
+        std::list<boost::shared_ptr<hier::Variable> >::iterator flux_register_var =
+            d_flux_register_variables.begin();
+        
+        while (flux_var != d_flux_variables.end())
+        {
+            boost::shared_ptr<pdat::SideData<double> > flux_data(
+                BOOST_CAST<pdat::SideData<double>, hier::PatchData>(
+                    patch->getPatchData(*flux_var, d_scratch)));
+            
+            boost::shared_ptr<pdat::CellData<double> > flux_register_data(
+                BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                    patch->getPatchData(*flux_register_var, d_scratch)));
+            
+            TBOX_ASSERT(flux_data);
+            TBOX_ASSERT(flux_register_data);
+            
+            const int depth = flux_data->getDepth();
+            
+            for (int di = 0; di < dim.getValue(); di++)
+            {
+                for (int si = 0; si < 2; si++)
+                {
+                    hier::Index boundary_lo(patch_box.lower());
+                    hier::Index boundary_hi(patch_box.upper());
+                    if (si == 0)
+                    {
+                        boundary_hi(di) = patch_box.lower(di);
+                    }
+                    else
+                    {
+                        boundary_lo(di) = patch_box.upper(di);
+                    }
+                    const hier::Box boundary_box(boundary_lo, boundary_hi, patch_box.getBlockId());
+                    
+                    pdat::CellIterator icend(pdat::CellGeometry::end(boundary_box));
+                    for (pdat::CellIterator ic(pdat::CellGeometry::begin(boundary_box));
+                         ic != icend;
+                         ic++)
+                    {
+                        const pdat::SideIndex side_index(
+                            *ic,
+                            di,
+                            si == 0 ? pdat::SideIndex::Lower : pdat::SideIndex::Upper);
+                        
+                        for (int ci = 0; ci < depth; ci++)
+                        {
+                            (*flux_register_data)(*ic, (2*di + si)*depth + ci) =
+                                (*flux_data)(side_index, ci);
+                        }
+                    }
+                }
+            }
+            
+            flux_var++;
+            flux_register_var++;
+        }
+    }
+    
+    /*
+     * Fill the ghost cells of the registers from the neighboring patches. Use the schedule cached
+     * in resetHierarchyConfiguration() if the level is the one in the hierarchy that it was created
+     * for. Otherwise, generate a temporary schedule.
+     */
+    
+    const int level_number = level->getLevelNumber();
+    
+    boost::shared_ptr<xfer::RefineSchedule> fill_schedule_flux_register;
+    
+    if (level_number < static_cast<int>(d_fill_flux_register_sched_level.size()) &&
+        d_fill_flux_register_sched_level[level_number] == level &&
+        d_fill_flux_register_sched[level_number])
+    {
+        fill_schedule_flux_register = d_fill_flux_register_sched[level_number];
+    }
+    else
+    {
+        t_advance_bdry_fill_create->start();
+        
+        fill_schedule_flux_register = d_fill_flux_register->createSchedule(level);
+        
+        t_advance_bdry_fill_create->stop();
+    }
+    
+    t_advance_bdry_fill_comm->start();
+    fill_schedule_flux_register->fillData(current_time);
+    t_advance_bdry_fill_comm->stop();
+    
+    /*
+     * Correct the fluxes and the solution of the slow patches.
+     */
+    
+    d_patch_strategy->setDataContext(d_scratch);
+    
+    for (int pi = 0; pi < static_cast<int>(slow_patches.size()); pi++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = slow_patches[pi];
+        
+        const hier::Box& patch_box = patch->getBox();
+        
+        boost::shared_ptr<pdat::CellData<double> > patch_rate_data(
+            BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                patch->getPatchData(d_patch_rate_variable, d_scratch)));
+        
+        TBOX_ASSERT(patch_rate_data);
+        
+        hier::BoxContainer reflux_boxes;
+        
+        for (int di = 0; di < dim.getValue(); di++)
+        {
+            for (int si = 0; si < 2; si++)
+            {
+                /*
+                 * Get the layer of ghost cells next to the side of the patch and the layer of
+                 * interior cells next to the side of the patch.
+                 */
+                
+                hier::Index ghost_lo(patch_box.lower());
+                hier::Index ghost_hi(patch_box.upper());
+                hier::Index boundary_lo(patch_box.lower());
+                hier::Index boundary_hi(patch_box.upper());
+                if (si == 0)
+                {
+                    ghost_lo(di) = patch_box.lower(di) - 1;
+                    ghost_hi(di) = patch_box.lower(di) - 1;
+                    boundary_hi(di) = patch_box.lower(di);
+                }
+                else
+                {
+                    ghost_lo(di) = patch_box.upper(di) + 1;
+                    ghost_hi(di) = patch_box.upper(di) + 1;
+                    boundary_lo(di) = patch_box.upper(di);
+                }
+                const hier::Box ghost_box(ghost_lo, ghost_hi, patch_box.getBlockId());
+                const hier::Box boundary_box(boundary_lo, boundary_hi, patch_box.getBlockId());
+                
+                bool is_side_corrected = false;
+                
+                std::list<boost::shared_ptr<hier::Variable> >::iterator flux_var =
+                    d_flux_variables.begin();
+                
+                std::list<boost::shared_ptr<hier::Variable> >::iterator flux_register_var =
+                    d_flux_register_variables.begin();
+                
+                while (flux_var != d_flux_variables.end())
+                {
+                    boost::shared_ptr<pdat::SideData<double> > flux_data(
+                        BOOST_CAST<pdat::SideData<double>, hier::PatchData>(
+                            patch->getPatchData(*flux_var, d_scratch)));
+                    
+                    boost::shared_ptr<pdat::CellData<double> > flux_register_data(
+                        BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                            patch->getPatchData(*flux_register_var, d_scratch)));
+                    
+                    TBOX_ASSERT(flux_data);
+                    TBOX_ASSERT(flux_register_data);
+                    
+                    const int depth = flux_data->getDepth();
+                    
+                    pdat::CellIterator icend(pdat::CellGeometry::end(ghost_box));
+                    for (pdat::CellIterator ic(pdat::CellGeometry::begin(ghost_box));
+                         ic != icend;
+                         ic++)
+                    {
+                        if ((*patch_rate_data)(*ic) > 1.0)
+                        {
+                            /*
+                             * The face is on the opposite side of the ghost cell in the neighboring
+                             * fast patch.
+                             */
+                            
+                            const pdat::SideIndex side_index(
+                                *ic,
+                                di,
+                                si == 0 ? pdat::SideIndex::Upper : pdat::SideIndex::Lower);
+                            
+                            for (int ci = 0; ci < depth; ci++)
+                            {
+                                (*flux_data)(side_index, ci) =
+                                    (*flux_register_data)(*ic, (2*di + (1 - si))*depth + ci);
+                            }
+                            
+                            is_side_corrected = true;
+                        }
+                    }
+                    
+                    flux_var++;
+                    flux_register_var++;
+                }
+                
+                if (is_side_corrected)
+                {
+                    hier::BoxContainer boundary_box_parts(boundary_box);
+                    boundary_box_parts.removeIntersections(reflux_boxes);
+                    reflux_boxes.spliceBack(boundary_box_parts);
+                }
+            }
+        }
+        
+        if (reflux_boxes.empty())
+        {
+            continue;
+        }
+        
+        /*
+         * Repeat the conservative difference from the current data on the cells next to the
+         * corrected faces.
+         */
+        
+        std::list<boost::shared_ptr<hier::Variable> >::iterator time_dep_var =
+            d_time_dep_variables.begin();
+        
+        while (time_dep_var != d_time_dep_variables.end())
+        {
+            boost::shared_ptr<pdat::CellData<double> > src_data(
+                BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                    patch->getPatchData(*time_dep_var, d_current)));
+            
+            boost::shared_ptr<pdat::CellData<double> > dst_data(
+                BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                    patch->getPatchData(*time_dep_var, d_scratch)));
+            
+            TBOX_ASSERT(src_data);
+            TBOX_ASSERT(dst_data);
+            
+            for (hier::BoxContainer::const_iterator ib(reflux_boxes.begin());
+                 ib != reflux_boxes.end();
+                 ib++)
+            {
+                dst_data->getArrayData().copy(src_data->getArrayData(), *ib);
+            }
+            
+            time_dep_var++;
+        }
+        
+        d_patch_strategy->synchronizeFluxesOnBoxes(*patch,
+            current_time,
+            dt,
+            reflux_boxes);
+    }
+    
+    level->deallocatePatchData(d_flux_register_data);
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Set the time-dependent scratch data on the interior of a patch to the linear interpolation of
+ * the current data and the new data with weight theta for the new data.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::interpolateTimeDependentDataOnPatch(
+    hier::Patch& patch,
+    const double theta)
+{
+    math::ArrayDataBasicOps<double> array_ops;
+    
+    std::list<boost::shared_ptr<hier::Variable> >::iterator time_dep_var =
+        d_time_dep_variables.begin();
+    
+    while (time_dep_var != d_time_dep_variables.end())
+    {
+        boost::shared_ptr<pdat::CellData<double> > current_data(
+            BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                patch.getPatchData(*time_dep_var, d_current)));
+        
+        boost::shared_ptr<pdat::CellData<double> > new_data(
+            BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                patch.getPatchData(*time_dep_var, d_new)));
+        
+        boost::shared_ptr<pdat::CellData<double> > scratch_data(
+            BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                patch.getPatchData(*time_dep_var, d_scratch)));
+        
+        TBOX_ASSERT(current_data);
+        TBOX_ASSERT(new_data);
+        TBOX_ASSERT(scratch_data);
+        
+        array_ops.linearSum(
+            scratch_data->getArrayData(),
+            1.0 - theta,
+            current_data->getArrayData(),
+            theta,
+            new_data->getArrayData(),
+            patch.getBox());
+        
+        time_dep_var++;
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ * 
+ * Synchronize data between patch levels according to the standard flux correction algorithm.
+ * 
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::standardLevelSynchronization(
+    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+    const int coarsest_level,
+    const int finest_level,
+    const double sync_time,
+    const double old_time)
+{
+    TBOX_ASSERT(hierarchy);
+    
+    std::vector<double> old_times(finest_level - coarsest_level + 1);
+    for (int i = coarsest_level; i <= finest_level; i++)
+    {
+        old_times[i] = old_time;
+    }
+    
+    standardLevelSynchronization(
+        hierarchy,
+        coarsest_level,
+        finest_level,
+        sync_time,
+        old_times);
+}
+
+
+void
+RungeKuttaLevelIntegrator::standardLevelSynchronization(
+    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+    const int coarsest_level,
+    const int finest_level,
+    const double sync_time,
+    const std::vector<double>& old_times)
+{
+    TBOX_ASSERT(hierarchy);
+    TBOX_ASSERT((coarsest_level >= 0)
+                && (coarsest_level < finest_level)
+                && (finest_level <= hierarchy->getFinestLevelNumber()));
+    TBOX_ASSERT(static_cast<int>(old_times.size()) >= finest_level);
+#ifdef HAMERS_DEBUG_CHECK_ASSERTIONS
+    for (int ln = coarsest_level; ln < finest_level; ln++)
+    {
+        TBOX_ASSERT(hierarchy->getPatchLevel(ln));
+        TBOX_ASSERT(sync_time >= old_times[ln]);
+    }
+#endif
+    TBOX_ASSERT(hierarchy->getPatchLevel(finest_level));
+    
+    t_std_level_sync->start();
+    
+    for (int fine_ln = finest_level; fine_ln > coarsest_level; --fine_ln)
+    {
+        const int coarse_ln = fine_ln - 1;
+        
+        boost::shared_ptr<hier::PatchLevel> fine_level(
+           hierarchy->getPatchLevel(fine_ln));
+        
+        boost::shared_ptr<hier::PatchLevel> coarse_level(
+           hierarchy->getPatchLevel(coarse_ln));
+        
+        synchronizeLevelWithCoarser(
+            fine_level,
+            coarse_level,
+            sync_time,
+            old_times[coarse_ln]);
+        
+        fine_level->deallocatePatchData(d_fluxsum_data);
+        fine_level->deallocatePatchData(d_flux_var_data);
+        fine_level->deallocatePatchData(d_source_var_data);
+        
+        if (coarse_ln > coarsest_level)
+        {
+            coarse_level->deallocatePatchData(d_flux_var_data);
+            coarse_level->deallocatePatchData(d_source_var_data);
+        }
+        else
+        {
+            if (coarsest_level == 0)
+            {
+                coarse_level->deallocatePatchData(d_flux_var_data);
+                d_have_flux_on_level_zero = false;
+                coarse_level->deallocatePatchData(d_source_var_data);
+            }
+        }
+    }
+    
+    t_std_level_sync->stop();
+}
+
+
+/*
+ **************************************************************************************************
+ *                                                                       
+ * Coarsen current solution data from finest hierarchy level specified down through the coarsest
+ * hierarchy level specified, if initial_time is true (i.e., hierarchy is being constructed at
+ * initial simulation time). After data is coarsened, the user's initialization routine is called
+ * to reset data (as needed by the application) before that solution is further coarsened to the
+ * next coarser level in the hierarchy. If initial_time is false, then this routine does nothing
+ * In that case, interpolation of data from coarser levels is sufficient to set data on new levels
+ * in the hierarchy during regridding.
+ * 
+ * NOTE: The fact that this routine does nothing when called at any time later than when the AMR
+ *       hierarchy is constructed initially may need to change at some point based on application
+ *       needs.
+ * 
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::synchronizeNewLevels(
+    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+    const int coarsest_level,
+    const int finest_level,
+    const double sync_time,
+    const bool initial_time)
+{
+    TBOX_ASSERT(hierarchy);
+    TBOX_ASSERT((coarsest_level >= 0)
+                && (coarsest_level < finest_level)
+                && (finest_level <= hierarchy->getFinestLevelNumber()));
+    
+#ifdef HAMERS_DEBUG_CHECK_ASSERTIONS
+    for (int ln = coarsest_level; ln <= finest_level; ln++)
+    {
+        TBOX_ASSERT(hierarchy->getPatchLevel(ln));
+    }
+#endif
+    
+    t_sync_new_levels->start();
+    
+    if (initial_time)
+    {
+        d_patch_strategy->setDataContext(d_current);
+        
+        for (int fine_ln = finest_level; fine_ln > coarsest_level; --fine_ln)
+        {
+            const int coarse_ln = fine_ln - 1;
+            
+            boost::shared_ptr<hier::PatchLevel> fine_level(
+                hierarchy->getPatchLevel(fine_ln));
+            
+            boost::shared_ptr<hier::PatchLevel> coarse_level(
+                hierarchy->getPatchLevel(coarse_ln));
+            
+            t_sync_initial_create->start();
+            boost::shared_ptr<xfer::CoarsenSchedule> sched(
+                getCoarsenSchedule(
+                    d_sync_initial_sched,
+                    d_sync_initial_data,
+                    coarse_level,
+                    fine_level,
+                    d_patch_strategy));
+            t_sync_initial_create->stop();
+            
+            t_sync_initial_comm->start();
+            sched->coarsenData();
+            t_sync_initial_comm->stop();
+            
+            for (hier::PatchLevel::iterator p(coarse_level->begin());
+                 p != coarse_level->end();
+                 p++)
+            {
+                const boost::shared_ptr<hier::Patch>& patch = *p;
+                
+                patch->allocatePatchData(d_temp_var_scratch_data, sync_time);
+                
+                d_patch_strategy->initializeDataOnPatch(
+                    *patch,
+                    sync_time,
+                    initial_time);
+                
+                patch->deallocatePatchData(d_temp_var_scratch_data);
+            }
+        }
+        
+        d_patch_strategy->clearDataContext();
+    } // if (initial_time)
+    
+    t_sync_new_levels->stop();
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Synchronize data between coarse and fine patch levels according to the standard flux correction
+ * algorithm. The steps of the algorithm are:
+ *
+ *    (1) Replace coarse time-space flux integrals at coarse-fine boundaries with time-space flux
+ *    integrals computed on fine level.
+ *    (2) Repeat conservative difference on coarse level with corrected fluxes.
+ *    (3) Conservatively coarsen solution on interior of fine level to coarse level.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::synchronizeLevelWithCoarser(
+    const boost::shared_ptr<hier::PatchLevel>& fine_level,
+    const boost::shared_ptr<hier::PatchLevel>& coarse_level,
+    const double sync_time,
+    const double coarse_sim_time)
+{
+    TBOX_ASSERT(fine_level);
+    TBOX_ASSERT(coarse_level);
+    TBOX_ASSERT(coarse_level->getLevelNumber() ==
+       (fine_level->getLevelNumber() - 1));
+    TBOX_ASSERT_OBJDIM_EQUALITY2(*fine_level, *coarse_level);
+    TBOX_ASSERT(sync_time > coarse_sim_time);
+    
+    /*
+     * Coarsen flux integrals around fine patch boundaries to coarser level and replace coarse flux
+     * information where appropriate. NULL patch model is passed in to avoid over complicating coarsen
+     * process; i.e. patch model is not needed in coarsening of flux integrals.
+     */
+    
+    t_coarsen_fluxsum_create->start();
+    boost::shared_ptr<xfer::CoarsenSchedule> sched(
+        getCoarsenSchedule(
+            d_coarsen_fluxsum_sched,
+            d_coarsen_fluxsum,
+            coarse_level,
+            fine_level,
+            0));
+    t_coarsen_fluxsum_create->stop();
+    
+    t_coarsen_fluxsum_comm->start();
+    sched->coarsenData();
+    t_coarsen_fluxsum_comm->stop();
+    
+    /*
+     * Repeat conservative difference on coarser level.
+     */
+    coarse_level->allocatePatchData(d_saved_var_scratch_data, coarse_sim_time);
+    coarse_level->setTime(coarse_sim_time, d_flux_var_data);
+    
+    const double reflux_dt = sync_time - coarse_sim_time;
+    
+    const int fine_ln = fine_level->getLevelNumber();
+    
+    if (d_use_sparse_refluxing &&
+        fine_ln < static_cast<int>(d_reflux_boxes.size()) &&
+        d_coarsen_sched_coarse_level[fine_ln] == coarse_level &&
+        d_coarsen_sched_fine_level[fine_ln] == fine_level)
+    {
+        /*
+         * Only the cells next to the coarse-fine boundaries get corrected fluxes. The cells
+         * elsewhere already have the values of the conservative difference and the cells covered
+         * by the finer level are replaced below. The conservative difference only uses the
+         * interior data so the ghost cells of the coarser level are not filled.
+         */
+        
+        const std::map<hier::GlobalId, hier::BoxContainer>& reflux_boxes = d_reflux_boxes[fine_ln];
+        
+        d_patch_strategy->setDataContext(d_scratch);
+        
+        for (hier::PatchLevel::iterator ip(coarse_level->begin());
+             ip != coarse_level->end();
+             ip++)
+        {
+            const boost::shared_ptr<hier::Patch>& patch = *ip;
+            
+            std::map<hier::GlobalId, hier::BoxContainer>::const_iterator it =
+                reflux_boxes.find(patch->getGlobalId());
+            
+            if (it == reflux_boxes.end())
+            {
+                continue;
+            }
+            
+            const hier::BoxContainer& patch_reflux_boxes = it->second;
+            
+            std::list<boost::shared_ptr<hier::Variable> >::iterator time_dep_var =
+                d_time_dep_variables.begin();
+            
+            while (time_dep_var != d_time_dep_variables.end())
+            {
+                patch->getPatchData(*time_dep_var, d_scratch)->copy(
+                    *patch->getPatchData(*time_dep_var, d_current));
+                
+                time_dep_var++;
+            }
+            
+            patch->allocatePatchData(d_temp_var_scratch_data, coarse_sim_time);
+            
+            d_patch_strategy->synchronizeFluxesOnBoxes(*patch,
+                coarse_sim_time,
+                reflux_dt,
+                patch_reflux_boxes);
+            
+            patch->deallocatePatchData(d_temp_var_scratch_data);
+            
+            /*
+             * Copy the refluxed cells to the new data.
+             */
+            
+            time_dep_var = d_time_dep_variables.begin();
+            
+            while (time_dep_var != d_time_dep_variables.end())
+            {
+                boost::shared_ptr<pdat::CellData<double> > src_data(
+                    BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                        patch->getPatchData(*time_dep_var, d_scratch)));
+                
+                boost::shared_ptr<pdat::CellData<double> > dst_data(
+                    BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                        patch->getPatchData(*time_dep_var, d_new)));
+                
+                TBOX_ASSERT(src_data);
+                TBOX_ASSERT(dst_data);
+                
+                for (hier::BoxContainer::const_iterator ib(patch_reflux_boxes.begin());
+                     ib != patch_reflux_boxes.end();
+                     ib++)
+                {
+                    dst_data->getArrayData().copy(src_data->getArrayData(), *ib);
+                }
+                
+                time_dep_var++;
+            }
+        }
+        
+        d_patch_strategy->clearDataContext();
+    }
+    else
+    {
+        d_patch_strategy->setDataContext(d_scratch);
+        
+        t_advance_bdry_fill_comm->start();
+        d_bdry_sched_advance[coarse_level->getLevelNumber()]->
+            fillData(coarse_sim_time);
+        t_advance_bdry_fill_comm->stop();
+        
+        for (hier::PatchLevel::iterator ip(coarse_level->begin());
+             ip != coarse_level->end();
+             ip++)
+        {
+            const boost::shared_ptr<hier::Patch>& patch = *ip;
+            
+            patch->allocatePatchData(d_temp_var_scratch_data, coarse_sim_time);
+                
+            d_patch_strategy->synchronizeFluxes(*patch,
+               coarse_sim_time,
+               reflux_dt);
+            patch->deallocatePatchData(d_temp_var_scratch_data);
+        }
+        
+        d_patch_strategy->clearDataContext();
+        
+        copyTimeDependentData(coarse_level, d_scratch, d_new);
+    }
+    
+    coarse_level->deallocatePatchData(d_saved_var_scratch_data);
+    
+    /*
+     * Coarsen time-dependent data from fine patch interiors to coarse patches.
+     */
+    
+    t_coarsen_sync_create->start();
+    sched = getCoarsenSchedule(
+        d_coarsen_sync_sched,
+        d_coarsen_sync_data,
+        coarse_level,
+        fine_level,
+        d_patch_strategy);
+    t_coarsen_sync_create->stop();
+    
+    d_patch_strategy->setDataContext(d_new);
+    
+    t_coarsen_sync_comm->start();
+    sched->coarsenData();
+    t_coarsen_sync_comm->stop();
+    
+    d_patch_strategy->clearDataContext();
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Reset time-dependent data on patch level by replacing current data with new. The boolean argument
+ * is used for odd refinement ratios (in particular 3 used in certain applications).
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::resetTimeDependentData(
+   const boost::shared_ptr<hier::PatchLevel>& level,
+   const double new_time,
+   const bool can_be_refined)
+{
+    TBOX_ASSERT(level);
+    
+    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    
+    double cur_time = 0.;
+    for (hier::PatchLevel::iterator ip(level->begin());
+         ip != level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = *ip;
+        
+        std::list<boost::shared_ptr<hier::Variable> >::iterator time_dep_var =
+            d_time_dep_variables.begin();
+        
+        while (time_dep_var != d_time_dep_variables.end())
+        {
+            int cur_indx =
+                variable_db->mapVariableAndContextToIndex(
+                    *time_dep_var,
+                    d_current);
+            int new_indx =
+                variable_db->mapVariableAndContextToIndex(
+                    *time_dep_var,
+                    d_new);
+            
+            cur_time = patch->getPatchData(cur_indx)->getTime();
+            
+            if (can_be_refined && d_number_time_data_levels == 3)
+            {
+                int old_indx = variable_db->mapVariableAndContextToIndex(
+                    *time_dep_var,
+                    d_old);
+                
+                patch->setPatchData(old_indx, patch->getPatchData(cur_indx));
+                
+                patch->setPatchData(cur_indx, patch->getPatchData(new_indx));
+            }
+            else
+            {
+                if (d_number_time_data_levels == 3)
+                {
+                    int old_indx = variable_db->mapVariableAndContextToIndex(
+                        *time_dep_var,
+                        d_old);
+                    
+                    patch->setPatchData(old_indx, patch->getPatchData(cur_indx));
+                }
+                
+                patch->setPatchData(cur_indx, patch->getPatchData(new_indx));
+            }
+            
+            patch->deallocatePatchData(new_indx);
+            
+            time_dep_var++;
+        }
+    }
+    
+    level->setTime(new_time, d_new_patch_init_data);
+    
+    if (d_number_time_data_levels == 3)
+    {
+        level->setTime(cur_time, d_old_time_dep_data);
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Discard new data on level. This is used primarily to reset patch data after error estimation
+ * (e.g., Richardson extrapolation.)
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::resetDataToPreadvanceState(
+    const boost::shared_ptr<hier::PatchLevel>& level)
+{
+    TBOX_ASSERT(level);
+    
+    /*
+     * De-allocate new context
+     */
+    level->deallocatePatchData(d_new_time_dep_data);
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Register given variable with algorithm according to specified algorithm role (i.e., RK_VAR_TYPE).
+ * Assignment of descriptor indices to variable lists, component selectors, and communication
+ * algorithms takes place here. The different cases are:
  *
  * TIME_DEP:
  *             The number of factories depends on the number of time levels of data that must be
@@ -2361,6 +3867,31 @@ RungeKuttaLevelIntegrator::registerVariable(
         
         d_coarsen_rich_extrap_init.reset(new xfer::CoarsenAlgorithm(dim));
         d_coarsen_rich_extrap_final.reset(new xfer::CoarsenAlgorithm(dim));
+        
+        if (d_use_local_time_stepping)
+        {
+            hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+            
+            d_fill_flux_register.reset(new xfer::RefineAlgorithm());
+            
+            d_patch_rate_variable.reset(new pdat::CellVariable<double>(
+                dim,
+                d_object_name + "_patch_rate",
+                1));
+            
+            int pr_id = variable_db->registerVariableAndContext(
+                d_patch_rate_variable,
+                d_scratch,
+                hier::IntVector::getOne(dim));
+            
+            d_flux_register_data.setFlag(pr_id);
+            
+            d_fill_flux_register->registerRefine(
+                pr_id,
+                pr_id,
+                pr_id,
+                boost::shared_ptr<hier::RefineOperator>());
+        }
     }
     
     hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
@@ -2443,11 +3974,45 @@ RungeKuttaLevelIntegrator::registerVariable(
             {
                 d_bdry_fill_intermediate[sn]->registerRefine(
                     intermediate_id[sn],
-                    scr_id,
+                    intermediate_id[sn],
                     intermediate_id[sn],
                     refine_op);
             }
             
+            /*
+             * Only the time-dependent variables that are synchronized between levels are advanced
+             * by the Runge-Kutta update, which rewrites the interior of their scratch data at every
+             * sub-step. The other time-dependent variables (e.g. the sensor fields of the refinement
+             * taggers, which are registered without coarsen and refine operators) keep their values
+             * in the scratch space through the sub-steps and are always copied to the intermediate
+             * space. The scratch and intermediate data of the advanced variables can only be swapped
+             * if they are cell data with the same numbers of ghost cells.
+             */
+            if (coarsen_name == "NO_COARSEN" || refine_name == "NO_REFINE")
+            {
+                d_copied_time_dep_variables.push_back(var);
+            }
+            else
+            {
+                d_swapped_time_dep_variables.push_back(var);
+                
+                if ((ghosts != ghosts_intermediate) ||
+                    !boost::dynamic_pointer_cast<pdat::CellVariable<double> >(var))
+                {
+                    d_intermediate_data_swappable = false;
+                }
+            }
+            
+            if (d_use_local_time_stepping &&
+                !boost::dynamic_pointer_cast<pdat::CellVariable<double> >(var))
+            {
+                TBOX_ERROR(d_object_name
+                           << ":  "
+                           << "Local time stepping is only supported with cell-centered "
+                           << "time-dependent variables."
+                           << std::endl);
+            }
+            
             /*
              * For data synchronization between levels, the coarsen algorithm will coarsen new data
              * on finer level to new data on coarser. Recall that coarser level data pointers will
@@ -2703,6 +4268,48 @@ RungeKuttaLevelIntegrator::registerVariable(
             
             d_coarsen_fluxsum->registerCoarsen(scr_id, fs_id, coarsen_op);
             
+            /*
+             * For local time stepping, a cell-centered register is created for each flux variable
+             * to exchange the fluxes at the boundaries of the fast patches with the neighboring
+             * patches on the same level.
+             */
+            if (d_use_local_time_stepping)
+            {
+                if (d_flux_is_face)
+                {
+                    TBOX_ERROR(d_object_name
+                               << ":  "
+                               << "Local time stepping is only supported with side-centered fluxes."
+                               << std::endl);
+                }
+                
+                boost::shared_ptr<pdat::SideDataFactory<double> > sdf(
+                    BOOST_CAST<pdat::SideDataFactory<double>,
+                    hier::PatchDataFactory>(var->getPatchDataFactory()));
+                TBOX_ASSERT(sdf);
+                
+                boost::shared_ptr<hier::Variable> flux_register(
+                    new pdat::CellVariable<double>(
+                        dim,
+                        var_name + "_flux_register",
+                        2*dim.getValue()*sdf->getDepth()));
+                
+                d_flux_register_variables.push_back(flux_register);
+                
+                int fr_id = variable_db->registerVariableAndContext(
+                    flux_register,
+                    d_scratch,
+                    hier::IntVector::getOne(dim));
+                
+                d_flux_register_data.setFlag(fr_id);
+                
+                d_fill_flux_register->registerRefine(
+                    fr_id,
+                    fr_id,
+                    fr_id,
+                    boost::shared_ptr<hier::RefineOperator>());
+            }
+            
             break;
         }
         case SOURCE:
@@ -3133,6 +4740,73 @@ RungeKuttaLevelIntegrator::copyTimeDependentData(
     TBOX_ASSERT(src_context);
     TBOX_ASSERT(dst_context);
     
+    for (hier::PatchLevel::iterator ip(level->begin());
+         ip != level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = *ip;
+        
+        copyTimeDependentDataOnPatch(*patch, src_context, dst_context);
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Copy time-dependent data from source space to destination space on a patch.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::copyTimeDependentDataOnPatch(
+    hier::Patch& patch,
+    const boost::shared_ptr<hier::VariableContext>& src_context,
+    const boost::shared_ptr<hier::VariableContext>& dst_context)
+{
+    std::list<boost::shared_ptr<hier::Variable> >::iterator time_dep_var =
+        d_time_dep_variables.begin();
+        
+    while (time_dep_var != d_time_dep_variables.end())
+    {
+        boost::shared_ptr<hier::PatchData> src_data(
+            patch.getPatchData(*time_dep_var, src_context));
+        
+        boost::shared_ptr<hier::PatchData> dst_data(
+            patch.getPatchData(*time_dep_var, dst_context));
+        
+        dst_data->copy(*src_data);
+        
+        time_dep_var++;
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Swap the time-dependent patch data between the scratch space and the intermediate space of a
+ * Runge-Kutta sub-step. After the swap, the intermediate space holds the data of the scratch space.
+ * The ghost cells of the scratch space are never changed during the sub-steps and the values at the
+ * coarse-fine boundaries are used by the intermediate data of all sub-steps. Hence, only the ghost
+ * cells are copied back to the new scratch data. Only the variables advanced by the Runge-Kutta
+ * update are swapped since the interior of their new scratch data is rewritten by the sub-step.
+ * The data of the other time-dependent variables are copied.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::swapTimeDependentData(
+    const boost::shared_ptr<hier::PatchLevel>& level,
+    const boost::shared_ptr<hier::VariableContext>& scratch_context,
+    const boost::shared_ptr<hier::VariableContext>& intermediate_context)
+{
+    TBOX_ASSERT(level);
+    TBOX_ASSERT(scratch_context);
+    TBOX_ASSERT(intermediate_context);
+    
+    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    
     for (hier::PatchLevel::iterator ip(level->begin());
          ip != level->end();
          ip++)
@@ -3140,15 +4814,57 @@ RungeKuttaLevelIntegrator::copyTimeDependentData(
         const boost::shared_ptr<hier::Patch>& patch = *ip;
         
         std::list<boost::shared_ptr<hier::Variable> >::iterator time_dep_var =
-            d_time_dep_variables.begin();
+            d_swapped_time_dep_variables.begin();
+        
+        while (time_dep_var != d_swapped_time_dep_variables.end())
+        {
+            const int scr_id = variable_db->mapVariableAndContextToIndex(
+                *time_dep_var,
+                scratch_context);
             
-        while (time_dep_var != d_time_dep_variables.end())
+            const int intermediate_id = variable_db->mapVariableAndContextToIndex(
+                *time_dep_var,
+                intermediate_context);
+            
+            boost::shared_ptr<pdat::CellData<double> > scr_data(
+                BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                    patch->getPatchData(scr_id)));
+            
+            boost::shared_ptr<pdat::CellData<double> > intermediate_data(
+                BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                    patch->getPatchData(intermediate_id)));
+            
+            TBOX_ASSERT(scr_data);
+            TBOX_ASSERT(intermediate_data);
+            TBOX_ASSERT(scr_data->getGhostBox().isSpatiallyEqual(intermediate_data->getGhostBox()));
+            
+            patch->setPatchData(intermediate_id, scr_data);
+            patch->setPatchData(scr_id, intermediate_data);
+            
+            intermediate_data->setTime(scr_data->getTime());
+            
+            hier::BoxContainer ghost_boxes(scr_data->getGhostBox());
+            ghost_boxes.removeIntersections(scr_data->getBox());
+            
+            for (hier::BoxContainer::const_iterator ib(ghost_boxes.begin());
+                 ib != ghost_boxes.end();
+                 ib++)
+            {
+                intermediate_data->getArrayData().copy(scr_data->getArrayData(), *ib);
+            }
+            
+            time_dep_var++;
+        }
+        
+        time_dep_var = d_copied_time_dep_variables.begin();
+        
+        while (time_dep_var != d_copied_time_dep_variables.end())
         {
             boost::shared_ptr<hier::PatchData> src_data(
-                patch->getPatchData(*time_dep_var, src_context));
+                patch->getPatchData(*time_dep_var, scratch_context));
             
             boost::shared_ptr<hier::PatchData> dst_data(
-                patch->getPatchData(*time_dep_var, dst_context));
+                patch->getPatchData(*time_dep_var, intermediate_context));
             
             dst_data->copy(*src_data);
             
@@ -3158,6 +4874,65 @@ RungeKuttaLevelIntegrator::copyTimeDependentData(
 }
 
 
+/*
+ **************************************************************************************************
+ *
+ * Fill the flux and source data of the given context on a patch with zero values.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::fillZeroFluxAndSourceData(
+    hier::Patch& patch,
+    const boost::shared_ptr<hier::VariableContext>& context)
+{
+    // Fill all fluxes with zero values.
+    
+    std::list<boost::shared_ptr<hier::Variable> >::iterator flux_var =
+        d_flux_variables.begin();
+    
+    while (flux_var != d_flux_variables.end())
+    {            
+        if (d_flux_is_face)
+        {
+            boost::shared_ptr<pdat::FaceData<double> > flux_data(
+                BOOST_CAST<pdat::FaceData<double>, hier::PatchData>(
+                    patch.getPatchData(*flux_var, context)));
+            
+            TBOX_ASSERT(flux_data);
+            flux_data->fillAll(0.0);
+        }
+        else
+        {
+            boost::shared_ptr<pdat::SideData<double> > flux_data(
+                BOOST_CAST<pdat::SideData<double>, hier::PatchData>(
+                    patch.getPatchData(*flux_var, context)));
+            
+            TBOX_ASSERT(flux_data);
+            flux_data->fillAll(0.0);
+        }
+        
+        flux_var++;
+    }
+    
+    // Fill all sources with zero values.
+    
+    std::list<boost::shared_ptr<hier::Variable> >::iterator source_var =
+        d_source_variables.begin();
+    
+    while (source_var != d_source_variables.end())
+    {
+        boost::shared_ptr<pdat::CellData<double> > source_data(
+            BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                patch.getPatchData(*source_var, context)));
+        
+        source_data->fillAll(0.0);
+        
+        source_var++;
+    }
+}
+
+
 /*
  **************************************************************************************************
  **************************************************************************************************
@@ -3336,6 +5111,32 @@ RungeKuttaLevelIntegrator::printClassData(
     os << "d_patch_strategy = "
        << (RungeKuttaPatchStrategy *)d_patch_strategy << std::endl;
     
+    os << "d_batch_patch_num_cells_threshold = "
+       << d_batch_patch_num_cells_threshold << std::endl;
+    os << "d_use_sparse_refluxing = "
+       << d_use_sparse_refluxing << std::endl;
+    os << "d_swap_intermediate_data = "
+       << d_swap_intermediate_data << std::endl;
+    os << "d_intermediate_data_swappable = "
+       << d_intermediate_data_swappable << std::endl;
+    os << "d_reuse_unchanged_patches_in_regrid = "
+       << d_reuse_unchanged_patches_in_regrid << std::endl;
+    os << "d_use_local_time_stepping = "
+       << d_use_local_time_stepping << std::endl;
+    os << "d_local_time_stepping_ratio = "
+       << d_local_time_stepping_ratio << std::endl;
+    os << "d_use_adaptive_cfl = "
+       << d_use_adaptive_cfl << std::endl;
+    
+    if (d_use_adaptive_cfl)
+    {
+        os << "d_cfl_min = " << d_cfl_min << "\n"
+           << "d_cfl_max = " << d_cfl_max << "\n"
+           << "d_adaptive_cfl_relative_tolerance = " << d_adaptive_cfl_relative_tolerance << "\n"
+           << "d_adaptive_cfl_absolute_tolerance = " << d_adaptive_cfl_absolute_tolerance << "\n"
+           << "d_max_step_retries = " << d_max_step_retries << std::endl;
+    }
+    
     os << std::endl;
     
     os << "Runge-Kutta weights:" << std::endl;
@@ -3393,12 +5194,50 @@ RungeKuttaLevelIntegrator::printClassData(
         }
         os << std::endl;
     }
+    if (!d_error_estimate_weights.empty())
+    {
+        os << "   d_error_estimate_weights = " << d_error_estimate_weights[0];
+        for (int i = 1; i < static_cast<int>(d_error_estimate_weights.size()); i++)
+        {
+            os << " , " << d_error_estimate_weights[i];
+        }
+        os << std::endl;
+        os << "   d_error_estimate_order = " << d_error_estimate_order << std::endl;
+    }
     os << std::endl;
     os << "NOTE: Not printing variable arrays, ComponentSelectors, communication schedules, etc."
        << std::endl;
 }
 
 
+/*
+ **************************************************************************************************
+ *
+ * Return the patch data indices of the time-dependent variables in the "current" context, which are
+ * the patch data registered for restart.
+ *
+ **************************************************************************************************
+ */
+std::vector<int>
+RungeKuttaLevelIntegrator::getCurrentTimeDependentPatchDataIndices() const
+{
+    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    
+    std::vector<int> data_ids;
+    data_ids.reserve(d_time_dep_variables.size());
+    
+    for (std::list<boost::shared_ptr<hier::Variable> >::const_iterator time_dep_var =
+            d_time_dep_variables.begin();
+         time_dep_var != d_time_dep_variables.end();
+         time_dep_var++)
+    {
+        data_ids.push_back(variable_db->mapVariableAndContextToIndex(*time_dep_var, d_current));
+    }
+    
+    return data_ids;
+}
+
+
 /*
  **************************************************************************************************
  *
@@ -3472,6 +5311,12 @@ RungeKuttaLevelIntegrator::putToRestart(
         
         RK_db->putDoubleVector(gamma_array_name, gamma_array);
     }
+    
+    if (!d_error_estimate_weights.empty())
+    {
+        RK_db->putDoubleVector("error_estimate_weights", d_error_estimate_weights);
+        RK_db->putInteger("error_estimate_order", d_error_estimate_order);
+    }
 }
 
 
@@ -3656,6 +5501,36 @@ RungeKuttaLevelIntegrator::getFromInput(
                                << std::endl);
                 }
             }
+            
+            /*
+             * The weights of the error estimate of the embedded method are optional.
+             */
+            
+            if (RK_db->keyExists("error_estimate_weights"))
+            {
+                size_t error_estimate_weights_size = RK_db->getArraySize("error_estimate_weights");
+                
+                if (static_cast<int>(error_estimate_weights_size) == d_number_steps + 1)
+                {
+                    d_error_estimate_weights = RK_db->getDoubleVector("error_estimate_weights");
+                }
+                else
+                {
+                    TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                               << "number of 'error_estimate_weights' entries must be = "
+                               << (d_number_steps + 1)
+                               << std::endl);
+                }
+                
+                d_error_estimate_order = RK_db->getInteger("error_estimate_order");
+                
+                if (d_error_estimate_order < 1)
+                {
+                    TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                               << "error_estimate_order should be positive."
+                               << std::endl);
+                }
+            }
         }
         else    // Use SSPRK(3, 3) Runge-Kutta scheme as the default scheme.
         {
@@ -3692,6 +5567,19 @@ RungeKuttaLevelIntegrator::getFromInput(
             d_gamma[2][0] = 0.0;
             d_gamma[2][1] = 0.0;
             d_gamma[2][2] = 2.0/3.0;
+            
+            /*
+             * The embedded second order method is Heun's method, whose solution is two times the
+             * intermediate solution of the third sub-step minus the old solution.
+             */
+            
+            d_error_estimate_weights.resize(d_number_steps + 1);
+            d_error_estimate_weights[0] = 1.0;
+            d_error_estimate_weights[1] = 0.0;
+            d_error_estimate_weights[2] = -2.0;
+            d_error_estimate_weights[3] = 1.0;
+            
+            d_error_estimate_order = 2;
         }
     }
     else if (input_db)
@@ -3702,28 +5590,181 @@ RungeKuttaLevelIntegrator::getFromInput(
         {
             d_use_cfl = input_db->getBoolWithDefault("use_cfl", true);
             
-            if (d_use_cfl)
+            if (d_use_cfl)
+            {
+                d_cfl = input_db->getDoubleWithDefault("cfl", d_cfl);
+                
+                d_cfl_init = input_db->getDoubleWithDefault("cfl_init", d_cfl_init);
+                
+                d_lag_dt_computation =
+                   input_db->getBoolWithDefault("lag_dt_computation",
+                      d_lag_dt_computation);
+                
+                d_use_ghosts_for_dt =
+                   input_db->getBoolWithDefault("use_ghosts_to_compute_dt",
+                      d_use_ghosts_for_dt);
+            }
+            else
+            {
+                d_dt = input_db->getDouble("dt");
+            }
+            
+            d_distinguish_mpi_reduction_costs =
+                input_db->getBoolWithDefault("DEV_distinguish_mpi_reduction_costs",
+                    d_distinguish_mpi_reduction_costs);
+        }
+    }
+    
+    /*
+     * The batching of patches, the sparse refluxing and the swapping of intermediate data do not
+     * change the results and are always read from the input database.
+     */
+    
+    if (input_db)
+    {
+        d_batch_patch_num_cells_threshold =
+            input_db->getIntegerWithDefault("batch_patch_num_cells_threshold",
+                d_batch_patch_num_cells_threshold);
+        
+        if (d_batch_patch_num_cells_threshold < 0)
+        {
+            TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                       << "batch_patch_num_cells_threshold should be non-negative."
+                       << std::endl);
+        }
+        
+        d_use_sparse_refluxing =
+            input_db->getBoolWithDefault("use_sparse_refluxing",
+                d_use_sparse_refluxing);
+        
+        d_swap_intermediate_data =
+            input_db->getBoolWithDefault("swap_intermediate_data",
+                d_swap_intermediate_data);
+        
+        d_reuse_unchanged_patches_in_regrid =
+            input_db->getBoolWithDefault("reuse_unchanged_patches_in_regrid",
+                d_reuse_unchanged_patches_in_regrid);
+    }
+    
+    /*
+     * The local time stepping is always read from the input database.
+     */
+    
+    if (input_db)
+    {
+        d_use_local_time_stepping =
+            input_db->getBoolWithDefault("use_local_time_stepping",
+                d_use_local_time_stepping);
+        
+        d_local_time_stepping_ratio =
+            input_db->getIntegerWithDefault("local_time_stepping_ratio",
+                d_local_time_stepping_ratio);
+        
+        if (d_local_time_stepping_ratio < 2)
+        {
+            TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                       << "local_time_stepping_ratio should be at least 2."
+                       << std::endl);
+        }
+        
+        if (d_use_local_time_stepping && !d_use_cfl)
+        {
+            TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                       << "Local time stepping cannot be used with a fixed dt."
+                       << std::endl);
+        }
+        
+        /*
+         * The slow patches keep their data in the scratch space while the fast patches are
+         * advanced. Hence, the scratch and intermediate data cannot be swapped.
+         */
+        if (d_use_local_time_stepping)
+        {
+            d_swap_intermediate_data = false;
+        }
+    }
+    
+    /*
+     * The adaptive CFL number is always read from the input database.
+     */
+    
+    if (input_db)
+    {
+        d_use_adaptive_cfl =
+            input_db->getBoolWithDefault("use_adaptive_cfl",
+                d_use_adaptive_cfl);
+        
+        if (d_use_adaptive_cfl)
+        {
+            if (!d_use_cfl)
+            {
+                TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                           << "Adaptive CFL number cannot be used with a fixed dt."
+                           << std::endl);
+            }
+            
+            if (d_use_local_time_stepping)
             {
-                d_cfl = input_db->getDoubleWithDefault("cfl", d_cfl);
-                
-                d_cfl_init = input_db->getDoubleWithDefault("cfl_init", d_cfl_init);
-                
-                d_lag_dt_computation =
-                   input_db->getBoolWithDefault("lag_dt_computation",
-                      d_lag_dt_computation);
-                
-                d_use_ghosts_for_dt =
-                   input_db->getBoolWithDefault("use_ghosts_to_compute_dt",
-                      d_use_ghosts_for_dt);
+                TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                           << "Adaptive CFL number cannot be used with local time stepping."
+                           << std::endl);
             }
-            else
+            
+            if (d_error_estimate_weights.empty())
             {
-                d_dt = input_db->getDouble("dt");
+                TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                           << "'error_estimate_weights' of the Runge-Kutta scheme are required"
+                           << " for adaptive CFL number."
+                           << std::endl);
             }
             
-            d_distinguish_mpi_reduction_costs =
-                input_db->getBoolWithDefault("DEV_distinguish_mpi_reduction_costs",
-                    d_distinguish_mpi_reduction_costs);
+            d_cfl_max = input_db->getDouble("cfl_max");
+            
+            d_cfl_min =
+                input_db->getDoubleWithDefault("cfl_min",
+                    0.1*d_cfl_max);
+            
+            if (d_cfl_min <= 0.0 || d_cfl_min > d_cfl_max)
+            {
+                TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                           << "cfl_min should be positive and not larger than cfl_max."
+                           << std::endl);
+            }
+            
+            d_adaptive_cfl_relative_tolerance =
+                input_db->getDoubleWithDefault("adaptive_cfl_relative_tolerance",
+                    d_adaptive_cfl_relative_tolerance);
+            
+            d_adaptive_cfl_absolute_tolerance =
+                input_db->getDoubleWithDefault("adaptive_cfl_absolute_tolerance",
+                    d_adaptive_cfl_absolute_tolerance);
+            
+            if (d_adaptive_cfl_relative_tolerance < 0.0 ||
+                d_adaptive_cfl_absolute_tolerance <= 0.0)
+            {
+                TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                           << "adaptive_cfl_relative_tolerance should be non-negative and"
+                           << " adaptive_cfl_absolute_tolerance should be positive."
+                           << std::endl);
+            }
+            
+            d_max_step_retries =
+                input_db->getIntegerWithDefault("max_step_retries",
+                    d_max_step_retries);
+            
+            if (d_max_step_retries < 0)
+            {
+                TBOX_ERROR(": RungeKuttaLevelIntegrator::getFromInput()\n"
+                           << "max_step_retries should be non-negative."
+                           << std::endl);
+            }
+            
+            /*
+             * The CFL number (adapted in the previous run if restarted) is the initial CFL number.
+             */
+            
+            d_cfl = tbox::MathUtilities<double>::Min(d_cfl, d_cfl_max);
+            d_cfl = tbox::MathUtilities<double>::Max(d_cfl, d_cfl_min);
         }
     }
 }
@@ -3790,6 +5831,403 @@ RungeKuttaLevelIntegrator::getFromRestart()
         d_beta[sn] = RK_db->getDoubleVector(beta_array_name);
         d_gamma[sn] = RK_db->getDoubleVector(gamma_array_name);
     }
+    
+    if (RK_db->keyExists("error_estimate_weights"))
+    {
+        d_error_estimate_weights = RK_db->getDoubleVector("error_estimate_weights");
+        d_error_estimate_order = RK_db->getInteger("error_estimate_order");
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Group the patches of a level into batches. Small patches with the same box dimensions are put
+ * into the same batch so that the patch strategy can share the per-patch setup of its numerical
+ * routines among them. The order of the patches is kept for the patches that are not batched.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::buildPatchBatches(
+    std::vector<std::vector<boost::shared_ptr<hier::Patch> > >& patch_batches,
+    const boost::shared_ptr<hier::PatchLevel>& level) const
+{
+    patch_batches.clear();
+    patch_batches.reserve(level->getLocalNumberOfPatches());
+    
+    // Map from the box dimensions of small patches to the indices of their batches.
+    std::map<std::vector<int>, int> batch_indices;
+    
+    for (hier::PatchLevel::iterator ip(level->begin());
+         ip != level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = *ip;
+        
+        const hier::Box& patch_box = patch->getBox();
+        
+        if (static_cast<int>(patch_box.size()) <= d_batch_patch_num_cells_threshold)
+        {
+            const hier::IntVector patch_dims = patch_box.numberCells();
+            
+            std::vector<int> batch_key(patch_dims.getDim().getValue());
+            for (int di = 0; di < patch_dims.getDim().getValue(); di++)
+            {
+                batch_key[di] = patch_dims[di];
+            }
+            
+            std::map<std::vector<int>, int>::const_iterator it = batch_indices.find(batch_key);
+            
+            if (it != batch_indices.end())
+            {
+                patch_batches[it->second].push_back(patch);
+            }
+            else
+            {
+                batch_indices.insert(std::pair<std::vector<int>, int>(
+                    batch_key,
+                    static_cast<int>(patch_batches.size())));
+                
+                patch_batches.push_back(std::vector<boost::shared_ptr<hier::Patch> >(1, patch));
+            }
+        }
+        else
+        {
+            patch_batches.push_back(std::vector<boost::shared_ptr<hier::Patch> >(1, patch));
+        }
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Compute the boxes of the cells of the local coarse patches that are next to the boundaries of the
+ * finer level. The footprint of the finer level is coarsened and shifted by the periodic shifts so
+ * that the cells next to the fine patches across the periodic boundaries are also found.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::computeRefluxBoxes(
+    std::map<hier::GlobalId, hier::BoxContainer>& reflux_boxes,
+    const boost::shared_ptr<hier::PatchLevel>& coarse_level,
+    const boost::shared_ptr<hier::PatchLevel>& fine_level) const
+{
+    TBOX_ASSERT(coarse_level);
+    TBOX_ASSERT(fine_level);
+    
+    const tbox::Dimension& dim = coarse_level->getDim();
+    
+    reflux_boxes.clear();
+    
+    const hier::IntVector& ratio = fine_level->getRatioToCoarserLevel();
+    
+    const hier::IntVector periodic_shift(
+        coarse_level->getGridGeometry()->getPeriodicShift(coarse_level->getRatioToLevelZero()));
+    
+    /*
+     * Get the number of periodic images of the footprint in each direction.
+     */
+    
+    int num_shifts = 1;
+    for (int di = 0; di < dim.getValue(); di++)
+    {
+        if (periodic_shift[di] != 0)
+        {
+            num_shifts *= 3;
+        }
+    }
+    
+    /*
+     * Compute the footprint of the finer level on the coarser level, including its periodic
+     * images.
+     */
+    
+    hier::BoxContainer fine_footprint;
+    
+    const hier::BoxContainer& fine_boxes = fine_level->getBoxes();
+    
+    for (hier::BoxContainer::const_iterator ib(fine_boxes.begin());
+         ib != fine_boxes.end();
+         ib++)
+    {
+        if (ib->isPeriodicImage())
+        {
+            continue;
+        }
+        
+        hier::Box coarsened_box(*ib);
+        coarsened_box.coarsen(ratio);
+        
+        for (int si = 0; si < num_shifts; si++)
+        {
+            hier::IntVector shift(hier::IntVector::getZero(dim));
+            
+            int count_shift = si;
+            for (int di = 0; di < dim.getValue(); di++)
+            {
+                if (periodic_shift[di] != 0)
+                {
+                    shift[di] = (count_shift%3 - 1)*periodic_shift[di];
+                    count_shift /= 3;
+                }
+            }
+            
+            hier::Box shifted_box(coarsened_box);
+            shifted_box.shift(shift);
+            
+            fine_footprint.pushBack(shifted_box);
+        }
+    }
+    
+    /*
+     * Find the cells of each local coarse patch that are next to the footprint but not covered by
+     * it.
+     */
+    
+    for (hier::PatchLevel::iterator ip(coarse_level->begin());
+         ip != coarse_level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = *ip;
+        
+        hier::BoxContainer patch_reflux_boxes;
+        
+        computePatchRefluxBoxes(
+            patch_reflux_boxes,
+            patch->getBox(),
+            fine_footprint);
+        
+        if (!patch_reflux_boxes.empty())
+        {
+            reflux_boxes.insert(std::pair<hier::GlobalId, hier::BoxContainer>(
+                patch->getGlobalId(),
+                patch_reflux_boxes));
+        }
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Compute the boxes of the cells of a coarse patch that are next to the footprint of the finer
+ * level and not covered by it. The grown boxes of neighboring fine patches overlap, so the overlap
+ * is removed before each box is added.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::computePatchRefluxBoxes(
+    hier::BoxContainer& patch_reflux_boxes,
+    const hier::Box& patch_box,
+    const hier::BoxContainer& fine_footprint)
+{
+    const tbox::Dimension& dim = patch_box.getDim();
+    
+    patch_reflux_boxes.clear();
+    
+    hier::Box patch_box_grown(patch_box);
+    patch_box_grown.grow(hier::IntVector::getOne(dim));
+    
+    for (hier::BoxContainer::const_iterator ib(fine_footprint.begin());
+         ib != fine_footprint.end();
+         ib++)
+    {
+        if (!ib->intersects(patch_box_grown))
+        {
+            continue;
+        }
+        
+        hier::Box reflux_box(*ib);
+        reflux_box.grow(hier::IntVector::getOne(dim));
+        reflux_box = reflux_box*patch_box;
+        
+        if (!reflux_box.empty())
+        {
+            /*
+             * The boxes must not overlap since the conservative difference is repeated once on
+             * each box.
+             */
+            
+            hier::BoxContainer reflux_box_parts(reflux_box);
+            reflux_box_parts.removeIntersections(patch_reflux_boxes);
+            patch_reflux_boxes.spliceBack(reflux_box_parts);
+        }
+    }
+    
+    if (!patch_reflux_boxes.empty())
+    {
+        patch_reflux_boxes.removeIntersections(fine_footprint);
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Let the local patches of a new level that have the same boxes as the local patches of the old
+ * level take the patch data of the old patches. The old patches are matched by their boxes and the
+ * new patches are only matched if the old patches have all the patch data to take allocated.
+ *
+ **************************************************************************************************
+ */
+void
+RungeKuttaLevelIntegrator::reuseUnchangedPatchData(
+    std::set<hier::BoxId>& unchanged_box_ids,
+    const boost::shared_ptr<hier::PatchLevel>& level,
+    const boost::shared_ptr<hier::PatchLevel>& old_level,
+    const double init_data_time) const
+{
+    TBOX_ASSERT(level);
+    TBOX_ASSERT(old_level);
+    
+    const int dim = level->getDim().getValue();
+    
+    unchanged_box_ids.clear();
+    
+    /*
+     * Get the patch data indices to take from the old patches.
+     */
+    
+    hier::ComponentSelector reused_data(d_new_patch_init_data);
+    reused_data.setOr(d_old_time_dep_data);
+    
+    std::vector<int> reused_data_indices;
+    for (int di = 0; di < reused_data.getSize(); di++)
+    {
+        if (reused_data.isSet(di))
+        {
+            reused_data_indices.push_back(di);
+        }
+    }
+    
+    /*
+     * Map the boxes of the local old patches to the old patches.
+     */
+    
+    std::map<std::vector<int>, boost::shared_ptr<hier::Patch> > old_patches;
+    
+    for (hier::PatchLevel::iterator ip(old_level->begin());
+         ip != old_level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& old_patch = *ip;
+        const hier::Box& old_box = old_patch->getBox();
+        
+        std::vector<int> box_key(2*dim);
+        for (int di = 0; di < dim; di++)
+        {
+            box_key[di] = old_box.lower()[di];
+            box_key[dim + di] = old_box.upper()[di];
+        }
+        
+        old_patches.insert(std::pair<std::vector<int>, boost::shared_ptr<hier::Patch> >(
+            box_key,
+            old_patch));
+    }
+    
+    /*
+     * Take the patch data of the matched old patches.
+     */
+    
+    for (hier::PatchLevel::iterator ip(level->begin());
+         ip != level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = *ip;
+        const hier::Box& box = patch->getBox();
+        
+        std::vector<int> box_key(2*dim);
+        for (int di = 0; di < dim; di++)
+        {
+            box_key[di] = box.lower()[di];
+            box_key[dim + di] = box.upper()[di];
+        }
+        
+        std::map<std::vector<int>, boost::shared_ptr<hier::Patch> >::const_iterator it_old =
+            old_patches.find(box_key);
+        
+        if (it_old == old_patches.end())
+        {
+            continue;
+        }
+        
+        const boost::shared_ptr<hier::Patch>& old_patch = it_old->second;
+        
+        bool is_data_allocated = true;
+        for (int ii = 0; ii < static_cast<int>(reused_data_indices.size()); ii++)
+        {
+            if (!old_patch->checkAllocated(reused_data_indices[ii]))
+            {
+                is_data_allocated = false;
+                break;
+            }
+        }
+        
+        if (!is_data_allocated)
+        {
+            continue;
+        }
+        
+        for (int ii = 0; ii < static_cast<int>(reused_data_indices.size()); ii++)
+        {
+            patch->setPatchData(
+                reused_data_indices[ii],
+                old_patch->getPatchData(reused_data_indices[ii]));
+        }
+        
+        patch->setTime(init_data_time, reused_data);
+        
+        unchanged_box_ids.insert(box.getBoxId());
+    }
+}
+
+
+/*
+ **************************************************************************************************
+ *
+ * Get the coarsen schedule of an algorithm between a pair of levels, using the cached one if the
+ * levels are the ones in the hierarchy that it may be cached for.
+ *
+ **************************************************************************************************
+ */
+boost::shared_ptr<xfer::CoarsenSchedule>
+RungeKuttaLevelIntegrator::getCoarsenSchedule(
+    std::vector<boost::shared_ptr<xfer::CoarsenSchedule> >& coarsen_schedules,
+    const boost::shared_ptr<xfer::CoarsenAlgorithm>& coarsen_algorithm,
+    const boost::shared_ptr<hier::PatchLevel>& coarse_level,
+    const boost::shared_ptr<hier::PatchLevel>& fine_level,
+    xfer::CoarsenPatchStrategy* coarsen_strategy)
+{
+    const int fine_ln = fine_level->getLevelNumber();
+    
+    const bool is_cacheable =
+        (fine_ln >= 0) &&
+        (fine_ln < static_cast<int>(coarsen_schedules.size())) &&
+        (d_coarsen_sched_coarse_level[fine_ln] == coarse_level) &&
+        (d_coarsen_sched_fine_level[fine_ln] == fine_level);
+    
+    if (is_cacheable && coarsen_schedules[fine_ln])
+    {
+        return coarsen_schedules[fine_ln];
+    }
+    
+    boost::shared_ptr<xfer::CoarsenSchedule> coarsen_schedule(
+        coarsen_algorithm->createSchedule(
+            coarse_level,
+            fine_level,
+            coarsen_strategy));
+    
+    if (is_cacheable)
+    {
+        coarsen_schedules[fine_ln] = coarsen_schedule;
+    }
+    
+    return coarsen_schedule;
 }
 
 
@@ -3836,6 +6274,8 @@ RungeKuttaLevelIntegrator::initializeCallback()
         getTimer("RungeKuttaLevelIntegrator::applyMultiresolutionDetector()");
     t_apply_integral_detector = tbox::TimerManager::getManager()->
         getTimer("RungeKuttaLevelIntegrator::applyIntegralDetector()");
+    t_apply_multiple_detectors = tbox::TimerManager::getManager()->
+        getTimer("RungeKuttaLevelIntegrator::applyMultipleDetectors()");
     t_tag_cells = tbox::TimerManager::getManager()->
         getTimer("RungeKuttaLevelIntegrator::tag_cells");
     t_coarsen_rich_extrap = tbox::TimerManager::getManager()->
@@ -3850,6 +6290,8 @@ RungeKuttaLevelIntegrator::initializeCallback()
         getTimer("RungeKuttaLevelIntegrator::new_advance_bdry_fill_comm");
     t_patch_num_kernel = tbox::TimerManager::getManager()->
         getTimer("RungeKuttaLevelIntegrator::patch_numerical_kernels");
+    t_advance_copy_intermediate_data = tbox::TimerManager::getManager()->
+        getTimer("RungeKuttaLevelIntegrator::advance_copy_intermediate_data");
     t_advance_level_sync = tbox::TimerManager::getManager()->
         getTimer("RungeKuttaLevelIntegrator::advanceLevel()_sync");
     t_std_level_sync = tbox::TimerManager::getManager()->
@@ -3896,6 +6338,7 @@ RungeKuttaLevelIntegrator::finalizeCallback()
     t_apply_gradient_detector.reset();
     t_apply_multiresolution_detector.reset();
     t_apply_integral_detector.reset();
+    t_apply_multiple_detectors.reset();
     t_tag_cells.reset();
     t_coarsen_rich_extrap.reset();
     t_get_level_dt.reset();
@@ -3903,6 +6346,7 @@ RungeKuttaLevelIntegrator::finalizeCallback()
     t_advance_level.reset();
     t_new_advance_bdry_fill_comm.reset();
     t_patch_num_kernel.reset();
+    t_advance_copy_intermediate_data.reset();
     t_advance_level_sync.reset();
     t_std_level_sync.reset();
     t_sync_new_levels.reset();
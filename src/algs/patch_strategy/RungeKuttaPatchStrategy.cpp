@@ -35,6 +35,66 @@ RungeKuttaPatchStrategy::~RungeKuttaPatchStrategy()
  **************************************************************************************************
  */
 
+void
+RungeKuttaPatchStrategy::computeFluxesAndSourcesOnPatchBatch(
+   const std::vector<boost::shared_ptr<hier::Patch> >& patches,
+   const double time,
+   const double dt,
+   const int RK_step_number,
+   const boost::shared_ptr<hier::VariableContext>& data_context)
+{
+   for (int pi = 0; pi < static_cast<int>(patches.size()); pi++)
+   {
+      computeFluxesAndSourcesOnPatch(
+         *patches[pi],
+         time,
+         dt,
+         RK_step_number,
+         data_context);
+   }
+}
+
+
+void
+RungeKuttaPatchStrategy::advanceSingleStepOnPatchBatch(
+   const std::vector<boost::shared_ptr<hier::Patch> >& patches,
+   const double time,
+   const double dt,
+   const std::vector<double>& alpha,
+   const std::vector<double>& beta,
+   const std::vector<double>& gamma,
+   const std::vector<boost::shared_ptr<hier::VariableContext> >& intermediate_context)
+{
+   for (int pi = 0; pi < static_cast<int>(patches.size()); pi++)
+   {
+      advanceSingleStepOnPatch(
+         *patches[pi],
+         time,
+         dt,
+         alpha,
+         beta,
+         gamma,
+         intermediate_context);
+   }
+}
+
+
+void
+RungeKuttaPatchStrategy::synchronizeFluxesOnBoxes(
+   hier::Patch& patch,
+   const double time,
+   const double dt,
+   const hier::BoxContainer& sync_boxes)
+{
+   NULL_USE(sync_boxes);
+   
+   synchronizeFluxes(
+      patch,
+      time,
+      dt);
+}
+
+
 void
 RungeKuttaPatchStrategy::preprocessTagCellsValueDetector(
    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
@@ -315,6 +375,138 @@ RungeKuttaPatchStrategy::tagCellsOnPatchIntegralDetector(
 }
 
 
+void
+RungeKuttaPatchStrategy::preprocessTagCellsMultipleDetectors(
+   const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+   const int level_number,
+   const double regrid_time,
+   const bool initial_error,
+   const bool uses_value_detector,
+   const bool uses_gradient_detector,
+   const bool uses_multiresolution_detector,
+   const bool uses_integral_detector,
+   const bool uses_richardson_extrapolation_too)
+{
+   if (uses_integral_detector)
+   {
+      preprocessTagCellsIntegralDetector(
+         patch_hierarchy,
+         level_number,
+         regrid_time,
+         initial_error,
+         uses_value_detector,
+         uses_gradient_detector,
+         uses_multiresolution_detector,
+         uses_richardson_extrapolation_too);
+   }
+   
+   if (uses_multiresolution_detector)
+   {
+      preprocessTagCellsMultiresolutionDetector(
+         patch_hierarchy,
+         level_number,
+         regrid_time,
+         initial_error,
+         uses_value_detector,
+         uses_gradient_detector,
+         uses_integral_detector,
+         uses_richardson_extrapolation_too);
+   }
+   
+   if (uses_gradient_detector)
+   {
+      preprocessTagCellsGradientDetector(
+         patch_hierarchy,
+         level_number,
+         regrid_time,
+         initial_error,
+         uses_value_detector,
+         uses_multiresolution_detector,
+         uses_integral_detector,
+         uses_richardson_extrapolation_too);
+   }
+   
+   if (uses_value_detector)
+   {
+      preprocessTagCellsValueDetector(
+         patch_hierarchy,
+         level_number,
+         regrid_time,
+         initial_error,
+         uses_gradient_detector,
+         uses_multiresolution_detector,
+         uses_integral_detector,
+         uses_richardson_extrapolation_too);
+   }
+}
+
+
+void
+RungeKuttaPatchStrategy::postprocessTagCellsMultipleDetectors(
+   const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+   const int level_number,
+   const double regrid_time,
+   const bool initial_error,
+   const bool uses_value_detector,
+   const bool uses_gradient_detector,
+   const bool uses_multiresolution_detector,
+   const bool uses_integral_detector,
+   const bool uses_richardson_extrapolation_too)
+{
+   if (uses_integral_detector)
+   {
+      postprocessTagCellsIntegralDetector(
+         patch_hierarchy,
+         level_number,
+         regrid_time,
+         initial_error,
+         uses_value_detector,
+         uses_gradient_detector,
+         uses_multiresolution_detector,
+         uses_richardson_extrapolation_too);
+   }
+   
+   if (uses_multiresolution_detector)
+   {
+      postprocessTagCellsMultiresolutionDetector(
+         patch_hierarchy,
+         level_number,
+         regrid_time,
+         initial_error,
+         uses_value_detector,
+         uses_gradient_detector,
+         uses_integral_detector,
+         uses_richardson_extrapolation_too);
+   }
+   
+   if (uses_gradient_detector)
+   {
+      postprocessTagCellsGradientDetector(
+         patch_hierarchy,
+         level_number,
+         regrid_time,
+         initial_error,
+         uses_value_detector,
+         uses_multiresolution_detector,
+         uses_integral_detector,
+         uses_richardson_extrapolation_too);
+   }
+   
+   if (uses_value_detector)
+   {
+      postprocessTagCellsValueDetector(
+         patch_hierarchy,
+         level_number,
+         regrid_time,
+         initial_error,
+         uses_gradient_detector,
+         uses_multiresolution_detector,
+         uses_integral_detector,
+         uses_richardson_extrapolation_too);
+   }
+}
+
+
 void
 RungeKuttaPatchStrategy::tagCellsOnPatchRichardsonExtrapolation(
    hier::Patch& patch,
@@ -405,3 +597,24 @@ RungeKuttaPatchStrategy::postprocessAdvanceLevelState(
    NULL_USE(last_step);
    NULL_USE(regrid_advance);
 }
+
+
+bool
+RungeKuttaPatchStrategy::isStateAdmissibleOnPatch(
+   hier::Patch& patch)
+{
+   NULL_USE(patch);
+   return true;
+}
+
+
+void
+RungeKuttaPatchStrategy::resetHierarchyConfiguration(
+   const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+   const int coarsest_level,
+   const int finest_level)
+{
+   NULL_USE(hierarchy);
+   NULL_USE(coarsest_level);
+   NULL_USE(finest_level);
+}
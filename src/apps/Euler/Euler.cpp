@@ -1,13 +1,17 @@
 #include "apps/Euler/Euler.hpp"
 
+#include "algs/integrator/FusedMPIReduction.hpp"
+
 #include "SAMRAI/geom/CartesianPatchGeometry.h"
 #include "SAMRAI/hier/BoxContainer.h"
 #include "SAMRAI/hier/Index.h"
 #include "SAMRAI/hier/PatchDataRestartManager.h"
 #include "SAMRAI/hier/VariableDatabase.h"
 #include "SAMRAI/math/HierarchyCellDataOpsReal.h"
+#include "SAMRAI/math/PatchCellDataBasicOps.h"
 #include "SAMRAI/mesh/TreeLoadBalancer.h"
 #include "SAMRAI/pdat/CellData.h"
+#include "SAMRAI/pdat/CellGeometry.h"
 #include "SAMRAI/pdat/CellIndex.h"
 #include "SAMRAI/pdat/CellIterator.h"
 #include "SAMRAI/pdat/SideIndex.h"
@@ -324,6 +328,18 @@ Euler::registerModelVariables(
         num_ghosts,
         num_ghosts_intermediate);
     
+    /*
+     * The Runge-Kutta update addresses all the conservative variables with the same numbers of
+     * ghost cells. Check this once here instead of at every update.
+     */
+    d_flow_model->checkGhostCellWidthsOfConservativeVariables(integrator->getScratchContext());
+    
+    for (int sn = 0; sn < static_cast<int>(integrator->getIntermediateContexts().size()); sn++)
+    {
+        d_flow_model->checkGhostCellWidthsOfConservativeVariables(
+            integrator->getIntermediateContexts()[sn]);
+    }
+    
     /*
      * Register the fluxes and sources.
      */
@@ -900,38 +916,15 @@ Euler::advanceSingleStepOnPatch(
     
     d_flow_model->registerPatchWithDataContext(patch, getDataContext());
     
-    std::vector<boost::shared_ptr<pdat::CellData<double> > > conservative_variables =
-        d_flow_model->getGlobalCellDataConservativeVariables();
-    
-    std::vector<hier::IntVector> num_ghosts_conservative_var;
-    num_ghosts_conservative_var.reserve(d_flow_model->getNumberOfEquations());
-    
-    std::vector<hier::IntVector> ghostcell_dims_conservative_var;
-    ghostcell_dims_conservative_var.reserve(d_flow_model->getNumberOfEquations());
+    hier::IntVector num_ghosts_conservative_var(d_dim);
+    hier::IntVector ghostcell_dims_conservative_var(d_dim);
     
     std::vector<double*> Q;
-    Q.reserve(d_flow_model->getNumberOfEquations());
     
-    int count_eqn = 0;
-    
-    for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
-    {
-        int depth = conservative_variables[vi]->getDepth();
-        
-        for (int di = 0; di < depth; di++)
-        {
-            // If the last element of the conservative variable vector is not in the system of
-            // equations, ignore it.
-            if (count_eqn >= d_flow_model->getNumberOfEquations())
-                break;
-            
-            Q.push_back(conservative_variables[vi]->getPointer(di));
-            num_ghosts_conservative_var.push_back(conservative_variables[vi]->getGhostCellWidth());
-            ghostcell_dims_conservative_var.push_back(conservative_variables[vi]->getGhostBox().numberCells());
-            
-            count_eqn++;
-        }
-    }
+    d_flow_model->getGlobalCellDataPointersConservativeVariables(
+        Q,
+        num_ghosts_conservative_var,
+        ghostcell_dims_conservative_var);
     
     d_flow_model->fillZeroGlobalCellDataConservativeVariables();
     
@@ -985,40 +978,15 @@ Euler::advanceSingleStepOnPatch(
         
         d_flow_model->registerPatchWithDataContext(patch, intermediate_context[n]);
         
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > conservative_variables_intermediate =
-            d_flow_model->getGlobalCellDataConservativeVariables();
-        
-        std::vector<hier::IntVector> num_ghosts_conservative_var_intermediate;
-        num_ghosts_conservative_var_intermediate.reserve(d_flow_model->getNumberOfEquations());
-        
-        std::vector<hier::IntVector> ghostcell_dims_conservative_var_intermediate;
-        ghostcell_dims_conservative_var_intermediate.reserve(d_flow_model->getNumberOfEquations());
+        hier::IntVector num_ghosts_conservative_var_intermediate(d_dim);
+        hier::IntVector ghostcell_dims_conservative_var_intermediate(d_dim);
         
         std::vector<double*> Q_intermediate;
-        Q_intermediate.reserve(d_flow_model->getNumberOfEquations());
-        
-        count_eqn = 0;
         
-        for (int vi = 0; vi < static_cast<int>(conservative_variables_intermediate.size()); vi++)
-        {
-            int depth = conservative_variables_intermediate[vi]->getDepth();
-            
-            for (int di = 0; di < depth; di++)
-            {
-                // If the last element of the conservative variable vector is not in the system of
-                // equations, ignore it.
-                if (count_eqn >= d_flow_model->getNumberOfEquations())
-                    break;
-                
-                Q_intermediate.push_back(conservative_variables_intermediate[vi]->getPointer(di));
-                num_ghosts_conservative_var_intermediate.push_back(
-                    conservative_variables_intermediate[vi]->getGhostCellWidth());
-                ghostcell_dims_conservative_var_intermediate.push_back(
-                    conservative_variables_intermediate[vi]->getGhostBox().numberCells());
-                
-                count_eqn++;
-            }
-        }
+        d_flow_model->getGlobalCellDataPointersConservativeVariables(
+            Q_intermediate,
+            num_ghosts_conservative_var_intermediate,
+            ghostcell_dims_conservative_var_intermediate);
         
         // Unregister the patch.
         d_flow_model->unregisterPatch();
@@ -1037,9 +1005,9 @@ Euler::advanceSingleStepOnPatch(
             {
                 for (int ei = 0; ei < d_flow_model->getNumberOfEquations(); ei++)
                 {
-                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[ei][0];
+                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[0];
                     const int num_ghosts_0_conservative_var_intermediate =
-                        num_ghosts_conservative_var_intermediate[ei][0];
+                        num_ghosts_conservative_var_intermediate[0];
                     
 #ifdef HAMERS_ENABLE_SIMD
                     #pragma omp simd
@@ -1062,7 +1030,7 @@ Euler::advanceSingleStepOnPatch(
                     double* F_x_intermediate = convective_flux_intermediate->getPointer(0, ei);
                     double* S_intermediate = source_intermediate->getPointer(ei);
                     
-                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[ei][0];
+                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[0];
                     
 #ifdef HAMERS_ENABLE_SIMD
                     #pragma omp simd
@@ -1136,16 +1104,16 @@ Euler::advanceSingleStepOnPatch(
             {
                 for (int ei = 0; ei < d_flow_model->getNumberOfEquations(); ei++)
                 {
-                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[ei][0];
-                    const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[ei][1];
-                    const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[ei][0];
+                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[0];
+                    const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[1];
+                    const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[0];
                     
                     const int num_ghosts_0_conservative_var_intermediate =
-                        num_ghosts_conservative_var_intermediate[ei][0];
+                        num_ghosts_conservative_var_intermediate[0];
                     const int num_ghosts_1_conservative_var_intermediate =
-                        num_ghosts_conservative_var_intermediate[ei][1];
+                        num_ghosts_conservative_var_intermediate[1];
                     const int ghostcell_dim_0_conservative_var_intermediate =
-                        ghostcell_dims_conservative_var_intermediate[ei][0];
+                        ghostcell_dims_conservative_var_intermediate[0];
                     
                     for (int j = 0; j < interior_dim_1; j++)
                     {
@@ -1176,9 +1144,9 @@ Euler::advanceSingleStepOnPatch(
                     double* F_y_intermediate = convective_flux_intermediate->getPointer(1, ei);
                     double* S_intermediate = source_intermediate->getPointer(ei);
                     
-                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[ei][0];
-                    const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[ei][1];
-                    const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[ei][0];
+                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[0];
+                    const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[1];
+                    const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[0];
                     
                     for (int j = 0; j < interior_dim_1; j++)
                     {
@@ -1302,22 +1270,22 @@ Euler::advanceSingleStepOnPatch(
             {
                 for (int ei = 0; ei < d_flow_model->getNumberOfEquations(); ei++)
                 {
-                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[ei][0];
-                    const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[ei][1];
-                    const int num_ghosts_2_conservative_var = num_ghosts_conservative_var[ei][2];
-                    const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[ei][0];
-                    const int ghostcell_dim_1_conservative_var = ghostcell_dims_conservative_var[ei][1];
+                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[0];
+                    const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[1];
+                    const int num_ghosts_2_conservative_var = num_ghosts_conservative_var[2];
+                    const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[0];
+                    const int ghostcell_dim_1_conservative_var = ghostcell_dims_conservative_var[1];
                     
                     const int num_ghosts_0_conservative_var_intermediate =
-                        num_ghosts_conservative_var_intermediate[ei][0];
+                        num_ghosts_conservative_var_intermediate[0];
                     const int num_ghosts_1_conservative_var_intermediate =
-                        num_ghosts_conservative_var_intermediate[ei][1];
+                        num_ghosts_conservative_var_intermediate[1];
                     const int num_ghosts_2_conservative_var_intermediate =
-                        num_ghosts_conservative_var_intermediate[ei][2];
+                        num_ghosts_conservative_var_intermediate[2];
                     const int ghostcell_dim_0_conservative_var_intermediate =
-                        ghostcell_dims_conservative_var_intermediate[ei][0];
+                        ghostcell_dims_conservative_var_intermediate[0];
                     const int ghostcell_dim_1_conservative_var_intermediate =
-                        ghostcell_dims_conservative_var_intermediate[ei][1];
+                        ghostcell_dims_conservative_var_intermediate[1];
                     
                     for (int k = 0; k < interior_dim_2; k++)
                     {
@@ -1357,11 +1325,11 @@ Euler::advanceSingleStepOnPatch(
                     double* F_z_intermediate = convective_flux_intermediate->getPointer(2, ei);
                     double* S_intermediate = source_intermediate->getPointer(ei);
                     
-                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[ei][0];
-                    const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[ei][1];
-                    const int num_ghosts_2_conservative_var = num_ghosts_conservative_var[ei][2];
-                    const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[ei][0];
-                    const int ghostcell_dim_1_conservative_var = ghostcell_dims_conservative_var[ei][1];
+                    const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[0];
+                    const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[1];
+                    const int num_ghosts_2_conservative_var = num_ghosts_conservative_var[2];
+                    const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[0];
+                    const int ghostcell_dim_1_conservative_var = ghostcell_dims_conservative_var[1];
                     
                     for (int k = 0; k < interior_dim_2; k++)
                     {
@@ -1548,6 +1516,25 @@ Euler::synchronizeFluxes(
     hier::Patch& patch,
     const double time,
     const double dt)
+{
+    synchronizeFluxesOnBoxes(
+        patch,
+        time,
+        dt,
+        hier::BoxContainer(patch.getBox()));
+}
+
+
+/*
+ * Correct the conservative variables on the given boxes of cells at coarse-fine boundaries by
+ * repeating conservative differencing with corrected fluxes.
+ */
+void
+Euler::synchronizeFluxesOnBoxes(
+    hier::Patch& patch,
+    const double time,
+    const double dt,
+    const hier::BoxContainer& sync_boxes)
 {
     NULL_USE(time);
     NULL_USE(dt);
@@ -1575,37 +1562,15 @@ Euler::synchronizeFluxes(
     
     d_flow_model->registerPatchWithDataContext(patch, getDataContext());
     
-    std::vector<boost::shared_ptr<pdat::CellData<double> > > conservative_variables =
-        d_flow_model->getGlobalCellDataConservativeVariables();
-    
-    std::vector<hier::IntVector> num_ghosts_conservative_var;
-    num_ghosts_conservative_var.reserve(d_flow_model->getNumberOfEquations());
-    
-    std::vector<hier::IntVector> ghostcell_dims_conservative_var;
-    ghostcell_dims_conservative_var.reserve(d_flow_model->getNumberOfEquations());
+    hier::IntVector num_ghosts_conservative_var(d_dim);
+    hier::IntVector ghostcell_dims_conservative_var(d_dim);
     
     std::vector<double*> Q;
-    Q.reserve(d_flow_model->getNumberOfEquations());
     
-    int count_eqn = 0;
-    
-    for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
-    {
-        int depth = conservative_variables[vi]->getDepth();
-        
-        for (int di = 0; di < depth; di++)
-        {
-            // If the last element of the conservative variable vector is not in the system of equations, ignore it.
-            if (count_eqn >= d_flow_model->getNumberOfEquations())
-                break;
-            
-            Q.push_back(conservative_variables[vi]->getPointer(di));
-            num_ghosts_conservative_var.push_back(conservative_variables[vi]->getGhostCellWidth());
-            ghostcell_dims_conservative_var.push_back(conservative_variables[vi]->getGhostBox().numberCells());
-            
-            count_eqn++;
-        }
-    }
+    d_flow_model->getGlobalCellDataPointersConservativeVariables(
+        Q,
+        num_ghosts_conservative_var,
+        ghostcell_dims_conservative_var);
     
     // Unregister the patch.
     d_flow_model->unregisterPatch();
@@ -1626,172 +1591,198 @@ Euler::synchronizeFluxes(
     TBOX_ASSERT(source->getGhostCellWidth() == hier::IntVector::getZero(d_dim));
 #endif
     
-    if (d_dim == tbox::Dimension(1))
+    for (hier::BoxContainer::const_iterator ib(sync_boxes.begin());
+         ib != sync_boxes.end();
+         ib++)
     {
-        /*
-         * Get the dimension and grid spacing.
-         */
-        
-        const int interior_dim_0 = interior_dims[0];
+        const hier::Box sync_box((*ib)*interior_box);
         
-        const double dx_0 = dx[0];
-        
-        for (int ei = 0; ei < d_flow_model->getNumberOfEquations(); ei++)
+        if (sync_box.empty())
         {
-            double *F_x = convective_flux->getPointer(0, ei);
-            double *S = source->getPointer(ei);
-            
-            const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[ei][0];
-            
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = 0; i < interior_dim_0; i++)
-            {
-                // Compute linear indices.
-                const int idx = i + num_ghosts_0_conservative_var;
-                const int idx_flux_x_L = i;
-                const int idx_flux_x_R = i + 1;
-                const int idx_source = i;
-                
-                Q[ei][idx] += (-(F_x[idx_flux_x_R] - F_x[idx_flux_x_L])/dx_0 +
-                                S[idx_source]);
-            }
+            continue;
         }
-    }
-    else if (d_dim == tbox::Dimension(2))
-    {
-        /*
-         * Get the dimensions and grid spacings.
-         */
-        
-        const int interior_dim_0 = interior_dims[0];
-        const int interior_dim_1 = interior_dims[1];
         
-        const double dx_0 = dx[0];
-        const double dx_1 = dx[1];
-        
-        for (int ei = 0; ei < d_flow_model->getNumberOfEquations(); ei++)
+        if (d_dim == tbox::Dimension(1))
         {
-            double *F_x = convective_flux->getPointer(0, ei);
-            double *F_y = convective_flux->getPointer(1, ei);
-            double *S = source->getPointer(ei);
+            /*
+             * Get the grid spacing.
+             */
+            
+            const double dx_0 = dx[0];
             
-            const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[ei][0];
-            const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[ei][1];
-            const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[ei][0];
+            const int sync_lo_0 = sync_box.lower()[0] - interior_box.lower()[0];
+            const int sync_hi_0 = sync_box.upper()[0] - interior_box.lower()[0];
             
-            for (int j = 0; j < interior_dim_1; j++)
+            for (int ei = 0; ei < d_flow_model->getNumberOfEquations(); ei++)
             {
+                double *F_x = convective_flux->getPointer(0, ei);
+                double *S = source->getPointer(ei);
+                
+                const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[0];
+                
 #ifdef HAMERS_ENABLE_SIMD
                 #pragma omp simd
 #endif
-                for (int i = 0; i < interior_dim_0; i++)
+                for (int i = sync_lo_0; i <= sync_hi_0; i++)
                 {
                     // Compute linear indices.
-                    const int idx = (i + num_ghosts_0_conservative_var) +
-                        (j + num_ghosts_1_conservative_var)*ghostcell_dim_0_conservative_var;
+                    const int idx = i + num_ghosts_0_conservative_var;
+                    const int idx_flux_x_L = i;
+                    const int idx_flux_x_R = i + 1;
+                    const int idx_source = i;
                     
-                    const int idx_flux_x_L = i +
-                        j*(interior_dim_0 + 1);
-                    
-                    const int idx_flux_x_R = (i + 1) +
-                        j*(interior_dim_0 + 1);
-                    
-                    const int idx_flux_y_B = i +
-                        j*interior_dim_0;
-                    
-                    const int idx_flux_y_T = i +
-                        (j + 1)*interior_dim_0;
-                    
-                    const int idx_source = i +
-                        j*interior_dim_0;
-                    
-                    Q[ei][idx] += (-(F_x[idx_flux_x_R] - F_x[idx_flux_x_L])/dx_0 -
-                                    (F_y[idx_flux_y_T] - F_y[idx_flux_y_B])/dx_1 +
+                    Q[ei][idx] += (-(F_x[idx_flux_x_R] - F_x[idx_flux_x_L])/dx_0 +
                                     S[idx_source]);
                 }
             }
         }
-    }
-    else if (d_dim == tbox::Dimension(3))
-    {
-        /*
-         * Get the dimensions and grid spacings.
-         */
-        
-        const int interior_dim_0 = interior_dims[0];
-        const int interior_dim_1 = interior_dims[1];
-        const int interior_dim_2 = interior_dims[2];
-        
-        const double dx_0 = dx[0];
-        const double dx_1 = dx[1];
-        const double dx_2 = dx[2];
-        
-        for (int ei = 0; ei < d_flow_model->getNumberOfEquations(); ei++)
+        else if (d_dim == tbox::Dimension(2))
         {
-            double *F_x = convective_flux->getPointer(0, ei);
-            double *F_y = convective_flux->getPointer(1, ei);
-            double *F_z = convective_flux->getPointer(2, ei);
-            double *S = source->getPointer(ei);
+            /*
+             * Get the dimensions and grid spacings.
+             */
+            
+            const int interior_dim_0 = interior_dims[0];
+            const int interior_dim_1 = interior_dims[1];
             
-            const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[ei][0];
-            const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[ei][1];
-            const int num_ghosts_2_conservative_var = num_ghosts_conservative_var[ei][2];
-            const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[ei][0];
-            const int ghostcell_dim_1_conservative_var = ghostcell_dims_conservative_var[ei][1];
+            const double dx_0 = dx[0];
+            const double dx_1 = dx[1];
+            
+            const int sync_lo_0 = sync_box.lower()[0] - interior_box.lower()[0];
+            const int sync_lo_1 = sync_box.lower()[1] - interior_box.lower()[1];
+            const int sync_hi_0 = sync_box.upper()[0] - interior_box.lower()[0];
+            const int sync_hi_1 = sync_box.upper()[1] - interior_box.lower()[1];
             
-            for (int k = 0; k < interior_dim_2; k++)
+            for (int ei = 0; ei < d_flow_model->getNumberOfEquations(); ei++)
             {
-                for (int j = 0; j < interior_dim_1; j++)
+                double *F_x = convective_flux->getPointer(0, ei);
+                double *F_y = convective_flux->getPointer(1, ei);
+                double *S = source->getPointer(ei);
+                
+                const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[0];
+                const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[1];
+                const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[0];
+                
+                for (int j = sync_lo_1; j <= sync_hi_1; j++)
                 {
 #ifdef HAMERS_ENABLE_SIMD
                     #pragma omp simd
 #endif
-                    for (int i = 0; i < interior_dim_0; i++)
+                    for (int i = sync_lo_0; i <= sync_hi_0; i++)
                     {
                         // Compute linear indices.
                         const int idx = (i + num_ghosts_0_conservative_var) +
-                            (j + num_ghosts_1_conservative_var)*ghostcell_dim_0_conservative_var +
-                            (k + num_ghosts_2_conservative_var)*ghostcell_dim_0_conservative_var*
-                                ghostcell_dim_1_conservative_var;
+                            (j + num_ghosts_1_conservative_var)*ghostcell_dim_0_conservative_var;
                         
                         const int idx_flux_x_L = i +
-                            j*(interior_dim_0 + 1) +
-                            k*(interior_dim_0 + 1)*interior_dim_1;
+                            j*(interior_dim_0 + 1);
                         
                         const int idx_flux_x_R = (i + 1) +
-                            j*(interior_dim_0 + 1) +
-                            k*(interior_dim_0 + 1)*interior_dim_1;
+                            j*(interior_dim_0 + 1);
                         
                         const int idx_flux_y_B = i +
-                            j*interior_dim_0 +
-                            k*interior_dim_0*(interior_dim_1 + 1);
+                            j*interior_dim_0;
                         
                         const int idx_flux_y_T = i +
-                            (j + 1)*interior_dim_0 +
-                            k*interior_dim_0*(interior_dim_1 + 1);
-                        
-                        const int idx_flux_z_B = i +
-                            j*interior_dim_0 +
-                            k*interior_dim_0*interior_dim_1;
-                        
-                        const int idx_flux_z_F = i +
-                            j*interior_dim_0 +
-                            (k + 1)*interior_dim_0*interior_dim_1;
+                            (j + 1)*interior_dim_0;
                         
                         const int idx_source = i +
-                            j*interior_dim_0 +
-                            k*interior_dim_0*interior_dim_1;
+                            j*interior_dim_0;
                         
                         Q[ei][idx] += (-(F_x[idx_flux_x_R] - F_x[idx_flux_x_L])/dx_0 -
-                                        (F_y[idx_flux_y_T] - F_y[idx_flux_y_B])/dx_1 -
-                                        (F_z[idx_flux_z_F] - F_z[idx_flux_z_B])/dx_2 +
+                                        (F_y[idx_flux_y_T] - F_y[idx_flux_y_B])/dx_1 +
                                         S[idx_source]);
                     }
                 }
             }
         }
+        else if (d_dim == tbox::Dimension(3))
+        {
+            /*
+             * Get the dimensions and grid spacings.
+             */
+            
+            const int interior_dim_0 = interior_dims[0];
+            const int interior_dim_1 = interior_dims[1];
+            const int interior_dim_2 = interior_dims[2];
+            
+            const double dx_0 = dx[0];
+            const double dx_1 = dx[1];
+            const double dx_2 = dx[2];
+            
+            const int sync_lo_0 = sync_box.lower()[0] - interior_box.lower()[0];
+            const int sync_lo_1 = sync_box.lower()[1] - interior_box.lower()[1];
+            const int sync_lo_2 = sync_box.lower()[2] - interior_box.lower()[2];
+            const int sync_hi_0 = sync_box.upper()[0] - interior_box.lower()[0];
+            const int sync_hi_1 = sync_box.upper()[1] - interior_box.lower()[1];
+            const int sync_hi_2 = sync_box.upper()[2] - interior_box.lower()[2];
+            
+            for (int ei = 0; ei < d_flow_model->getNumberOfEquations(); ei++)
+            {
+                double *F_x = convective_flux->getPointer(0, ei);
+                double *F_y = convective_flux->getPointer(1, ei);
+                double *F_z = convective_flux->getPointer(2, ei);
+                double *S = source->getPointer(ei);
+                
+                const int num_ghosts_0_conservative_var = num_ghosts_conservative_var[0];
+                const int num_ghosts_1_conservative_var = num_ghosts_conservative_var[1];
+                const int num_ghosts_2_conservative_var = num_ghosts_conservative_var[2];
+                const int ghostcell_dim_0_conservative_var = ghostcell_dims_conservative_var[0];
+                const int ghostcell_dim_1_conservative_var = ghostcell_dims_conservative_var[1];
+                
+                for (int k = sync_lo_2; k <= sync_hi_2; k++)
+                {
+                    for (int j = sync_lo_1; j <= sync_hi_1; j++)
+                    {
+#ifdef HAMERS_ENABLE_SIMD
+                        #pragma omp simd
+#endif
+                        for (int i = sync_lo_0; i <= sync_hi_0; i++)
+                        {
+                            // Compute linear indices.
+                            const int idx = (i + num_ghosts_0_conservative_var) +
+                                (j + num_ghosts_1_conservative_var)*ghostcell_dim_0_conservative_var +
+                                (k + num_ghosts_2_conservative_var)*ghostcell_dim_0_conservative_var*
+                                    ghostcell_dim_1_conservative_var;
+                            
+                            const int idx_flux_x_L = i +
+                                j*(interior_dim_0 + 1) +
+                                k*(interior_dim_0 + 1)*interior_dim_1;
+                            
+                            const int idx_flux_x_R = (i + 1) +
+                                j*(interior_dim_0 + 1) +
+                                k*(interior_dim_0 + 1)*interior_dim_1;
+                            
+                            const int idx_flux_y_B = i +
+                                j*interior_dim_0 +
+                                k*interior_dim_0*(interior_dim_1 + 1);
+                            
+                            const int idx_flux_y_T = i +
+                                (j + 1)*interior_dim_0 +
+                                k*interior_dim_0*(interior_dim_1 + 1);
+                            
+                            const int idx_flux_z_B = i +
+                                j*interior_dim_0 +
+                                k*interior_dim_0*interior_dim_1;
+                            
+                            const int idx_flux_z_F = i +
+                                j*interior_dim_0 +
+                                (k + 1)*interior_dim_0*interior_dim_1;
+                            
+                            const int idx_source = i +
+                                j*interior_dim_0 +
+                                k*interior_dim_0*interior_dim_1;
+                            
+                            Q[ei][idx] += (-(F_x[idx_flux_x_R] - F_x[idx_flux_x_L])/dx_0 -
+                                            (F_y[idx_flux_y_T] - F_y[idx_flux_y_B])/dx_1 -
+                                            (F_z[idx_flux_z_F] - F_z[idx_flux_z_B])/dx_2 +
+                                            S[idx_source]);
+                        }
+                    }
+                }
+            }
+        }
+        
     }
     
     /*
@@ -2096,6 +2087,115 @@ Euler::tagCellsOnPatchMultiresolutionDetector(
 }
 
 
+/*
+ * Preprocess before tagging cells using more than one detector.
+ */
+void
+Euler::preprocessTagCellsMultipleDetectors(
+   const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+   const int level_number,
+   const double regrid_time,
+   const bool initial_error,
+   const bool uses_value_detector,
+   const bool uses_gradient_detector,
+   const bool uses_multiresolution_detector,
+   const bool uses_integral_detector,
+   const bool uses_richardson_extrapolation_too)
+{
+    if (uses_integral_detector)
+    {
+        preprocessTagCellsIntegralDetector(
+            patch_hierarchy,
+            level_number,
+            regrid_time,
+            initial_error,
+            uses_value_detector,
+            uses_gradient_detector,
+            uses_multiresolution_detector,
+            uses_richardson_extrapolation_too);
+    }
+    
+    const bool uses_multiresolution_tagger =
+        uses_multiresolution_detector && (d_multiresolution_tagger != nullptr);
+    
+    const bool uses_gradient_tagger =
+        uses_gradient_detector && (d_gradient_tagger != nullptr);
+    
+    const bool uses_value_tagger =
+        uses_value_detector && (d_value_tagger != nullptr);
+    
+    boost::shared_ptr<hier::PatchLevel> level(
+        patch_hierarchy->getPatchLevel(level_number));
+    
+    /*
+     * Compute the values of all the taggers in one loop over the patches.
+     */
+    
+    for (hier::PatchLevel::iterator ip(level->begin());
+         ip != level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = *ip;
+        
+        if (uses_multiresolution_tagger)
+        {
+            d_multiresolution_tagger->computeMultiresolutionSensorValuesOnPatch(
+                *patch,
+                getDataContext());
+        }
+        
+        if (uses_gradient_tagger)
+        {
+            d_gradient_tagger->computeGradientSensorValuesOnPatch(
+                *patch,
+                getDataContext());
+        }
+        
+        if (uses_value_tagger)
+        {
+            d_value_tagger->computeValueTaggerValuesOnPatch(
+                *patch,
+                getDataContext());
+        }
+    }
+    
+    /*
+     * Get the statistics of all the taggers with a single reduction.
+     */
+    
+    std::vector<double*> statistics;
+    
+    if (uses_multiresolution_tagger)
+    {
+        d_multiresolution_tagger->getLocalSensorValueStatistics(
+            statistics,
+            patch_hierarchy,
+            level_number,
+            getDataContext());
+    }
+    
+    if (uses_gradient_tagger)
+    {
+        d_gradient_tagger->getLocalSensorValueStatistics(
+            statistics,
+            patch_hierarchy,
+            level_number,
+            getDataContext());
+    }
+    
+    if (uses_value_tagger)
+    {
+        d_value_tagger->getLocalValueStatistics(
+            statistics,
+            patch_hierarchy,
+            level_number,
+            getDataContext());
+    }
+    
+    RefinementTaggerStatistics::reduceMaxStatistics(statistics);
+}
+
+
 void
 Euler::setPhysicalBoundaryConditions(
     hier::Patch& patch,
@@ -2114,6 +2214,77 @@ Euler::setPhysicalBoundaryConditions(
 }
 
 
+void
+Euler::resetHierarchyConfiguration(
+    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+    const int coarsest_level,
+    const int finest_level)
+{
+    d_Euler_boundary_conditions->resetHierarchyConfiguration(
+        hierarchy,
+        coarsest_level,
+        finest_level);
+}
+
+
+bool
+Euler::isStateAdmissibleOnPatch(
+    hier::Patch& patch)
+{
+    /*
+     * Register the patch, density and pressure in the flow model and compute the corresponding
+     * cell data on the interior of the patch.
+     */
+    
+    d_flow_model->registerPatchWithDataContext(patch, getDataContext());
+    
+    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
+    num_subghosts_of_data.insert(
+        std::pair<std::string, hier::IntVector>(
+            "DENSITY", hier::IntVector::getZero(d_dim)));
+    num_subghosts_of_data.insert(
+        std::pair<std::string, hier::IntVector>(
+            "PRESSURE", hier::IntVector::getZero(d_dim)));
+    
+    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
+    
+    d_flow_model->computeGlobalDerivedCellData();
+    
+    boost::shared_ptr<pdat::CellData<double> > density =
+        d_flow_model->getGlobalCellData("DENSITY");
+    
+    boost::shared_ptr<pdat::CellData<double> > pressure =
+        d_flow_model->getGlobalCellData("PRESSURE");
+    
+    bool is_admissible = true;
+    
+    const hier::Box interior_box = patch.getBox();
+    
+    pdat::CellIterator icend(pdat::CellGeometry::end(interior_box));
+    for (pdat::CellIterator ic(pdat::CellGeometry::begin(interior_box));
+         ic != icend;
+         ic++)
+    {
+        const double rho = (*density)(*ic);
+        const double p = (*pressure)(*ic);
+        
+        if (!(rho > 0.0 && std::isfinite(rho) && p > 0.0 && std::isfinite(p)))
+        {
+            is_admissible = false;
+            break;
+        }
+    }
+    
+    /*
+     * Unregister the patch and data of all registered derived cell variables in the flow model.
+     */
+    
+    d_flow_model->unregisterPatch();
+    
+    return is_admissible;
+}
+
+
 void
 Euler::putToRestart(
     const boost::shared_ptr<tbox::Database>& restart_db) const
@@ -2495,7 +2666,7 @@ Euler::printDataStatistics(
 {
     const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
     
-    math::HierarchyCellDataOpsReal<double> cell_double_operator(patch_hierarchy, 0, 0);
+    math::PatchCellDataBasicOps<double> patch_cell_data_basic_ops;
     
     hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
     
@@ -2504,32 +2675,67 @@ Euler::printDataStatistics(
     std::vector<boost::shared_ptr<pdat::CellVariable<double> > > variables =
         d_flow_model->getConservativeVariables();
     
-    for (int vi = 0; vi < static_cast<int>(variables.size()); vi++)
+    const int num_variables = static_cast<int>(variables.size());
+    
+    /*
+     * Compute the local maxima and minima of all the variables and reduce them over all the
+     * processes with a single fused reduction.
+     */
+    
+    std::vector<double> var_max_local(num_variables, -tbox::MathUtilities<double>::getMax());
+    std::vector<double> var_min_local(num_variables, tbox::MathUtilities<double>::getMax());
+    
+    for (int li = 0; li < patch_hierarchy->getNumberOfLevels(); li++)
+    {
+        boost::shared_ptr<hier::PatchLevel> level(patch_hierarchy->getPatchLevel(li));
+        
+        for (hier::PatchLevel::iterator ip(level->begin());
+             ip != level->end();
+             ip++)
+        {
+            const boost::shared_ptr<hier::Patch>& patch = *ip;
+            
+            const hier::Box& patch_box = patch->getBox();
+            
+            for (int vi = 0; vi < num_variables; vi++)
+            {
+                const int var_id = variable_db->mapVariableAndContextToIndex(
+                    variables[vi],
+                    d_plot_context);
+                
+                boost::shared_ptr<pdat::CellData<double> > var_data(
+                    BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                        patch->getPatchData(var_id)));
+                
+                var_max_local[vi] = tbox::MathUtilities<double>::Max(var_max_local[vi],
+                    patch_cell_data_basic_ops.max(var_data, patch_box));
+                
+                var_min_local[vi] = tbox::MathUtilities<double>::Min(var_min_local[vi],
+                    patch_cell_data_basic_ops.min(var_data, patch_box));
+            }
+        }
+    }
+    
+    FusedMPIReduction var_reduction(mpi);
+    
+    std::vector<int> var_max_idx(num_variables);
+    std::vector<int> var_min_idx(num_variables);
+    
+    for (int vi = 0; vi < num_variables; vi++)
+    {
+        var_max_idx[vi] = var_reduction.addMax(var_max_local[vi]);
+        var_min_idx[vi] = var_reduction.addMin(var_min_local[vi]);
+    }
+    
+    var_reduction.post();
+    var_reduction.complete();
+    
+    for (int vi = 0; vi < num_variables; vi++)
     {
         const int var_depth = variables[vi]->getDepth();
-        const int var_id = variable_db->mapVariableAndContextToIndex(
-            variables[vi],
-            d_plot_context);
-        
-        double var_max_local = cell_double_operator.max(var_id);
-        double var_min_local = cell_double_operator.min(var_id);
-        
-        double var_max_global = 0.0;
-        double var_min_global = 0.0;
-        
-        mpi.Allreduce(
-            &var_max_local,
-            &var_max_global,
-            1,
-            MPI_DOUBLE,
-            MPI_MAX);
-        
-        mpi.Allreduce(
-            &var_min_local,
-            &var_min_global,
-            1,
-            MPI_DOUBLE,
-            MPI_MAX);
+        
+        const double var_max_global = var_reduction.getValue(var_max_idx[vi]);
+        const double var_min_global = var_reduction.getValue(var_min_idx[vi]);
         
         if (var_depth > 1)
         {
@@ -2540,6 +2746,8 @@ Euler::printDataStatistics(
             os << "Max/min " << variable_names[vi] << ": " << var_max_global << "/" << var_min_global << std::endl;
         }
     }
+    
+    d_convective_flux_reconstructor->printSchemeStatistics(os);
 }
 
 
@@ -5,6 +5,8 @@
 #include "util/basic_boundary_conditions/BasicCartesianBoundaryUtilities2.hpp"
 #include "util/basic_boundary_conditions/BasicCartesianBoundaryUtilities3.hpp"
 
+#include "boost/make_shared.hpp"
+
 //integer constant for debugging improperly set boundary data
 #define BOGUS_BDRY_DATA (-9999)
 
@@ -680,6 +682,9 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
     std::vector<boost::shared_ptr<pdat::CellData<double> > > conservative_var_data =
         d_flow_model->getGlobalCellDataConservativeVariables();
     
+    const boost::shared_ptr<PatchBoundaryDescriptor> bdry_descriptor(
+        getPatchBoundaryDescriptor(patch));
+    
     if (d_dim == tbox::Dimension(1))
     {
         /*
@@ -700,7 +705,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities1::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_scalar_bdry_node_conds,
                     d_bdry_node_conservative_var[vi],
@@ -711,7 +716,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities1::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_vector_bdry_node_conds,
                     d_bdry_node_conservative_var[vi],
@@ -739,7 +744,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities2::fillEdgeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     edge_locs,
                     d_scalar_bdry_edge_conds,
                     d_bdry_edge_conservative_var[vi],
@@ -750,7 +755,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities2::fillEdgeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     edge_locs,
                     d_vector_bdry_edge_conds,
                     d_bdry_edge_conservative_var[vi],
@@ -776,7 +781,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities2::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_scalar_bdry_node_conds,
                     d_bdry_edge_conservative_var[vi],
@@ -787,7 +792,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities2::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_vector_bdry_node_conds,
                     d_bdry_edge_conservative_var[vi],
@@ -815,7 +820,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillFaceBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     face_locs,
                     d_scalar_bdry_face_conds,
                     d_bdry_face_conservative_var[vi],
@@ -826,7 +831,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillFaceBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     face_locs,
                     d_vector_bdry_face_conds,
                     d_bdry_face_conservative_var[vi],
@@ -852,7 +857,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillEdgeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     edge_locs,
                     d_scalar_bdry_edge_conds,
                     d_bdry_face_conservative_var[vi],
@@ -863,7 +868,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillEdgeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     edge_locs,
                     d_vector_bdry_edge_conds,
                     d_bdry_face_conservative_var[vi],
@@ -889,7 +894,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_scalar_bdry_node_conds,
                     d_bdry_face_conservative_var[vi],
@@ -900,7 +905,7 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_vector_bdry_node_conds,
                     d_bdry_face_conservative_var[vi],
@@ -919,6 +924,72 @@ EulerBoundaryConditions::setPhysicalBoundaryConditions(
 }
 
 
+/*
+ * Build the descriptors of the physical boundary boxes of the patches on the levels in the range
+ * coarsest_level to finest_level of the hierarchy.
+ */
+void
+EulerBoundaryConditions::resetHierarchyConfiguration(
+    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+    const int coarsest_level,
+    const int finest_level)
+{
+    TBOX_ASSERT(hierarchy);
+    TBOX_ASSERT((coarsest_level >= 0)
+        && (coarsest_level <= finest_level)
+        && (finest_level <= hierarchy->getFinestLevelNumber()));
+    
+    d_patch_bdry_descriptors.resize(hierarchy->getFinestLevelNumber() + 1);
+    
+    for (int ln = coarsest_level; ln <= finest_level; ln++)
+    {
+        boost::shared_ptr<hier::PatchLevel> level(hierarchy->getPatchLevel(ln));
+        
+        std::map<hier::GlobalId, boost::shared_ptr<PatchBoundaryDescriptor> >&
+            patch_bdry_descriptors = d_patch_bdry_descriptors[ln];
+        
+        patch_bdry_descriptors.clear();
+        
+        for (hier::PatchLevel::iterator ip(level->begin());
+             ip != level->end();
+             ip++)
+        {
+            const boost::shared_ptr<hier::Patch>& patch = *ip;
+            
+            patch_bdry_descriptors[patch->getGlobalId()] =
+                boost::make_shared<PatchBoundaryDescriptor>(*patch);
+        }
+    }
+}
+
+
+/*
+ * Get the descriptor of the physical boundary boxes of the patch.
+ */
+boost::shared_ptr<PatchBoundaryDescriptor>
+EulerBoundaryConditions::getPatchBoundaryDescriptor(
+    const hier::Patch& patch) const
+{
+    const int level_number = patch.getPatchLevelNumber();
+    
+    if ((level_number >= 0) && (level_number < static_cast<int>(d_patch_bdry_descriptors.size())))
+    {
+        const std::map<hier::GlobalId, boost::shared_ptr<PatchBoundaryDescriptor> >&
+            patch_bdry_descriptors = d_patch_bdry_descriptors[level_number];
+        
+        std::map<hier::GlobalId, boost::shared_ptr<PatchBoundaryDescriptor> >::const_iterator
+            it = patch_bdry_descriptors.find(patch.getGlobalId());
+        
+        if (it != patch_bdry_descriptors.end() && it->second->isValidForPatch(patch))
+        {
+            return it->second;
+        }
+    }
+    
+    return boost::make_shared<PatchBoundaryDescriptor>(patch);
+}
+
+
 std::vector<double>
 EulerBoundaryConditions::readPrimitiveDataEntry(
     boost::shared_ptr<tbox::Database> db,
@@ -5,6 +5,8 @@
 #include "util/basic_boundary_conditions/BasicCartesianBoundaryUtilities2.hpp"
 #include "util/basic_boundary_conditions/BasicCartesianBoundaryUtilities3.hpp"
 
+#include "boost/make_shared.hpp"
+
 //integer constant for debugging improperly set boundary data
 #define BOGUS_BDRY_DATA (-9999)
 
@@ -725,6 +727,13 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
     const boost::shared_ptr<FlowModelBoundaryUtilities> flow_model_boundary_utilities =
         d_flow_model->getFlowModelBoundaryUtilities();
     
+    /*
+     * Get the descriptor of the physical boundary boxes of the patch.
+     */
+    
+    const boost::shared_ptr<PatchBoundaryDescriptor> bdry_descriptor(
+        getPatchBoundaryDescriptor(patch));
+    
     if (d_dim == tbox::Dimension(1))
     {
         /*
@@ -741,7 +750,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
         flow_model_boundary_utilities->
             fill1dNodeBoundaryData(
                 conservative_var_data,
-                patch,
+                *bdry_descriptor,
                 node_locs,
                 d_vector_bdry_node_conds,
                 d_bdry_node_conservative_var,
@@ -754,7 +763,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities1::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_scalar_bdry_node_conds,
                     d_bdry_node_conservative_var[vi],
@@ -765,7 +774,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities1::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_vector_bdry_node_conds,
                     d_bdry_node_conservative_var[vi],
@@ -789,7 +798,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
         flow_model_boundary_utilities->
             fill2dEdgeBoundaryData(
                 conservative_var_data,
-                patch,
+                *bdry_descriptor,
                 edge_locs,
                 d_vector_bdry_edge_conds,
                 d_bdry_edge_conservative_var,
@@ -802,7 +811,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities2::fillEdgeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     edge_locs,
                     d_scalar_bdry_edge_conds,
                     d_bdry_edge_conservative_var[vi],
@@ -813,7 +822,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities2::fillEdgeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     edge_locs,
                     d_vector_bdry_edge_conds,
                     d_bdry_edge_conservative_var[vi],
@@ -835,7 +844,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
         flow_model_boundary_utilities->
             fill2dNodeBoundaryData(
                 conservative_var_data,
-                patch,
+                *bdry_descriptor,
                 node_locs,
                 d_vector_bdry_node_conds,
                 d_bdry_edge_conservative_var,
@@ -848,7 +857,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities2::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_scalar_bdry_node_conds,
                     d_bdry_edge_conservative_var[vi],
@@ -859,7 +868,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities2::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_vector_bdry_node_conds,
                     d_bdry_edge_conservative_var[vi],
@@ -883,7 +892,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
         flow_model_boundary_utilities->
             fill3dFaceBoundaryData(
                 conservative_var_data,
-                patch,
+                *bdry_descriptor,
                 face_locs,
                 d_vector_bdry_face_conds,
                 d_bdry_face_conservative_var,
@@ -896,7 +905,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillFaceBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     face_locs,
                     d_scalar_bdry_face_conds,
                     d_bdry_face_conservative_var[vi],
@@ -907,7 +916,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillFaceBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     face_locs,
                     d_vector_bdry_face_conds,
                     d_bdry_face_conservative_var[vi],
@@ -929,7 +938,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
         flow_model_boundary_utilities->
             fill3dEdgeBoundaryData(
                 conservative_var_data,
-                patch,
+                *bdry_descriptor,
                 edge_locs,
                 d_vector_bdry_edge_conds,
                 d_bdry_face_conservative_var,
@@ -942,7 +951,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillEdgeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     edge_locs,
                     d_scalar_bdry_edge_conds,
                     d_bdry_face_conservative_var[vi],
@@ -953,7 +962,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillEdgeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     edge_locs,
                     d_vector_bdry_edge_conds,
                     d_bdry_face_conservative_var[vi],
@@ -975,7 +984,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
         flow_model_boundary_utilities->
             fill3dNodeBoundaryData(
                 conservative_var_data,
-                patch,
+                *bdry_descriptor,
                 node_locs,
                 d_vector_bdry_node_conds,
                 d_bdry_face_conservative_var,
@@ -988,7 +997,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_scalar_bdry_node_conds,
                     d_bdry_face_conservative_var[vi],
@@ -999,7 +1008,7 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
                 BasicCartesianBoundaryUtilities3::fillNodeBoundaryData(
                     conservative_var_names[vi],
                     conservative_var_data[vi],
-                    patch,
+                    *bdry_descriptor,
                     node_locs,
                     d_vector_bdry_node_conds,
                     d_bdry_face_conservative_var[vi],
@@ -1018,6 +1027,72 @@ NavierStokesBoundaryConditions::setPhysicalBoundaryConditions(
 }
 
 
+/*
+ * Build the descriptors of the physical boundary boxes of the patches on the levels in the range
+ * coarsest_level to finest_level of the hierarchy.
+ */
+void
+NavierStokesBoundaryConditions::resetHierarchyConfiguration(
+    const boost::shared_ptr<hier::PatchHierarchy>& hierarchy,
+    const int coarsest_level,
+    const int finest_level)
+{
+    TBOX_ASSERT(hierarchy);
+    TBOX_ASSERT((coarsest_level >= 0)
+        && (coarsest_level <= finest_level)
+        && (finest_level <= hierarchy->getFinestLevelNumber()));
+    
+    d_patch_bdry_descriptors.resize(hierarchy->getFinestLevelNumber() + 1);
+    
+    for (int ln = coarsest_level; ln <= finest_level; ln++)
+    {
+        boost::shared_ptr<hier::PatchLevel> level(hierarchy->getPatchLevel(ln));
+        
+        std::map<hier::GlobalId, boost::shared_ptr<PatchBoundaryDescriptor> >&
+            patch_bdry_descriptors = d_patch_bdry_descriptors[ln];
+        
+        patch_bdry_descriptors.clear();
+        
+        for (hier::PatchLevel::iterator ip(level->begin());
+             ip != level->end();
+             ip++)
+        {
+            const boost::shared_ptr<hier::Patch>& patch = *ip;
+            
+            patch_bdry_descriptors[patch->getGlobalId()] =
+                boost::make_shared<PatchBoundaryDescriptor>(*patch);
+        }
+    }
+}
+
+
+/*
+ * Get the descriptor of the physical boundary boxes of the patch.
+ */
+boost::shared_ptr<PatchBoundaryDescriptor>
+NavierStokesBoundaryConditions::getPatchBoundaryDescriptor(
+    const hier::Patch& patch) const
+{
+    const int level_number = patch.getPatchLevelNumber();
+    
+    if ((level_number >= 0) && (level_number < static_cast<int>(d_patch_bdry_descriptors.size())))
+    {
+        const std::map<hier::GlobalId, boost::shared_ptr<PatchBoundaryDescriptor> >&
+            patch_bdry_descriptors = d_patch_bdry_descriptors[level_number];
+        
+        std::map<hier::GlobalId, boost::shared_ptr<PatchBoundaryDescriptor> >::const_iterator
+            it = patch_bdry_descriptors.find(patch.getGlobalId());
+        
+        if (it != patch_bdry_descriptors.end() && it->second->isValidForPatch(patch))
+        {
+            return it->second;
+        }
+    }
+    
+    return boost::make_shared<PatchBoundaryDescriptor>(patch);
+}
+
+
 std::vector<double>
 NavierStokesBoundaryConditions::readPrimitiveDataEntry(
     boost::shared_ptr<tbox::Database> db,
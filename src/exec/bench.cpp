@@ -0,0 +1,959 @@
+#include "HAMeRS_config.hpp"
+
+#include "flow/convective_flux_reconstructors/ConvectiveFluxReconstructorManager.hpp"
+#include "flow/flow_models/FlowModelManager.hpp"
+#include "util/Directions.hpp"
+#include "util/basic_boundary_conditions/BasicCartesianBoundaryFillKernels.hpp"
+#include "util/wavelet_transform/WaveletTransformHarten.hpp"
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/geom/CartesianGridGeometry.h"
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/Index.h"
+#include "SAMRAI/hier/Patch.h"
+#include "SAMRAI/hier/PatchGeometry.h"
+#include "SAMRAI/hier/VariableDatabase.h"
+#include "SAMRAI/pdat/CellData.h"
+#include "SAMRAI/pdat/CellGeometry.h"
+#include "SAMRAI/pdat/CellIndex.h"
+#include "SAMRAI/pdat/CellIterator.h"
+#include "SAMRAI/pdat/CellVariable.h"
+#include "SAMRAI/pdat/SideData.h"
+#include "SAMRAI/pdat/SideVariable.h"
+#include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/InputDatabase.h"
+#include "SAMRAI/tbox/InputManager.h"
+#include "SAMRAI/tbox/PIO.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/SAMRAIManager.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include "boost/make_shared.hpp"
+#include "boost/shared_ptr.hpp"
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace SAMRAI;
+
+/*
+ *******************************************************************
+ *
+ * This is a micro-benchmark driver for the per-patch numerical
+ * kernels. A single synthetic patch is constructed and each kernel
+ * is driven through its class interface:
+ *
+ *    CONVECTIVE_FLUX_RECONSTRUCTOR - ConvectiveFluxReconstructor::
+ *       computeConvectiveFluxAndSourceOnPatch().
+ *
+ *    RIEMANN_SOLVER - FlowModelRiemannSolver::
+ *       computeConvectiveFluxFromConservativeVariables() in all
+ *       directions.
+ *
+ *    EQUATION_OF_STATE - EquationOfState::computePressure().
+ *
+ *    WAVELET_TRANSFORM_HARTEN - WaveletTransformHarten::
+ *       computeWaveletCoefficients().
+ *
+ *    BOUNDARY_FILL - BasicCartesianBoundaryFillKernels::
+ *       fillBoxFromInterior() with the mirror images on the ghost
+ *       cells of the conservative variables at all faces of the
+ *       patch, as in the REFLECT and SYMMETRY boundary conditions.
+ *
+ * The input file has the same "Main", "CartesianGeometry" and
+ * application ("Euler" or "NavierStokes") databases as the main
+ * program, so the flow model, the number of species and the
+ * convective flux reconstructor are set up the same way. The
+ * benchmark itself is configured by the "Benchmark" database:
+ *
+ *    Benchmark
+ *    {
+ *        application       = "Euler"   // Name of the application database.
+ *        patch_size        = 64, 64, 64
+ *        num_repetitions   = 10
+ *        kernels           = "CONVECTIVE_FLUX_RECONSTRUCTOR", "RIEMANN_SOLVER",
+ *                            "EQUATION_OF_STATE", "WAVELET_TRANSFORM_HARTEN",
+ *                            "BOUNDARY_FILL"
+ *        use_discontinuous_data                = FALSE
+ *        Harten_wavelet_num_level              = 3
+ *        Harten_wavelet_num_vanishing_moments  = 2
+ *        output_filename   = "bench.csv"
+ *    }
+ *
+ * For each kernel, the time per call, the number of interior cells
+ * updated per second, the number of bytes per interior cell and the
+ * achieved bandwidth are reported as comma-separated values. The
+ * bytes are the sizes of the patch data read and written through the
+ * kernel interface (including ghost cells), which is the compulsory
+ * memory traffic of the kernel. The temporary data internal to the
+ * kernels are not counted. For BOUNDARY_FILL, the bytes are the
+ * ghost cells written and the interior cells read, so the bandwidth
+ * is the boundary fill rate.
+ *
+ * The command line is:
+ *
+ *     executable <input file name>
+ *
+ *******************************************************************
+ */
+
+/*
+ * Timing of a kernel on the synthetic patch.
+ */
+struct BenchmarkRecord
+{
+    std::string kernel;
+    double seconds_per_call;
+    double bytes_per_call;
+};
+
+
+/*
+ * Get the number of bytes of the cell data, including the ghost cells.
+ */
+static double
+getCellDataBytes(const boost::shared_ptr<pdat::CellData<double> >& data)
+{
+    return double(data->getGhostBox().size())*double(data->getDepth())*double(sizeof(double));
+}
+
+
+/*
+ * Get the number of bytes of the side data in all directions, including the ghost cells.
+ */
+static double
+getSideDataBytes(const boost::shared_ptr<pdat::SideData<double> >& data)
+{
+    double bytes = 0.0;
+    
+    for (int di = 0; di < data->getDim().getValue(); di++)
+    {
+        bytes += double(data->getArrayData(di).getBox().size())*double(data->getDepth())*
+            double(sizeof(double));
+    }
+    
+    return bytes;
+}
+
+
+/*
+ * Get the average wall clock time of the kernel. The kernel is called once before the timing
+ * so that the pooled temporary data and the first touch of the memory are not timed.
+ */
+template<typename KERNEL>
+static double
+timeKernel(KERNEL kernel, const int num_repetitions)
+{
+    kernel();
+    
+    const std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+    
+    for (int ri = 0; ri < num_repetitions; ri++)
+    {
+        kernel();
+    }
+    
+    const std::chrono::steady_clock::time_point t_end = std::chrono::steady_clock::now();
+    
+    return std::chrono::duration<double>(t_end - t_start).count()/double(num_repetitions);
+}
+
+
+/*
+ * Get the synthetic primitive variables at the given cell. The primitive variables are ordered
+ * as the partial densities (or the density), velocity, pressure and volume fractions, which is the
+ * order expected by all the flow models.
+ */
+static void
+getSyntheticPrimitiveVariables(
+    std::vector<double>& V,
+    const hier::Index& idx,
+    const hier::IntVector& interior_dims,
+    const int num_species,
+    const bool use_discontinuous_data)
+{
+    const tbox::Dimension& dim = idx.getDim();
+    const int num_eqn = static_cast<int>(V.size());
+    
+    double phase = 0.0;
+    for (int di = 0; di < dim.getValue(); di++)
+    {
+        phase += double(2)*M_PI*(double(idx[di]) + double(1)/double(2))/double(interior_dims[di]);
+    }
+    
+    double rho = double(1) + double(1)/double(5)*sin(phase);
+    double p   = double(1) + double(1)/double(10)*cos(phase);
+    
+    if (use_discontinuous_data && (2*idx[0] >= interior_dims[0]))
+    {
+        rho *= double(1)/double(8);
+        p   *= double(1)/double(10);
+    }
+    
+    for (int si = 0; si < num_species; si++)
+    {
+        V[si] = rho/double(num_species);
+    }
+    
+    for (int di = 0; di < dim.getValue(); di++)
+    {
+        V[num_species + di] = double(1)/double(10)*sin(phase + double(di + 1));
+    }
+    
+    V[num_species + dim.getValue()] = p;
+    
+    for (int ei = num_species + dim.getValue() + 1; ei < num_eqn; ei++)
+    {
+        V[ei] = double(1)/double(num_species);
+    }
+}
+
+
+/*
+ * Set the conservative variables of the flow model on the patch, including the ghost cells, from
+ * the synthetic primitive variables.
+ */
+static void
+initializeConservativeVariables(
+    const boost::shared_ptr<FlowModel>& flow_model,
+    hier::Patch& patch,
+    const boost::shared_ptr<hier::VariableContext>& data_context,
+    const int num_species,
+    const bool use_discontinuous_data)
+{
+    const tbox::Dimension& dim = patch.getDim();
+    const int num_eqn = flow_model->getNumberOfEquations();
+    
+    const hier::Box interior_box = patch.getBox();
+    const hier::IntVector interior_dims = interior_box.numberCells();
+    
+    flow_model->registerPatchWithDataContext(patch, data_context);
+    
+    std::vector<double*> Q;
+    hier::IntVector num_ghosts(dim);
+    hier::IntVector ghostcell_dims(dim);
+    
+    flow_model->getGlobalCellDataPointersConservativeVariables(Q, num_ghosts, ghostcell_dims);
+    
+    hier::Box ghost_box = interior_box;
+    ghost_box.grow(num_ghosts);
+    
+    std::vector<double> V(num_eqn);
+    std::vector<const double*> V_ptr;
+    V_ptr.reserve(num_eqn);
+    for (int ei = 0; ei < num_eqn; ei++)
+    {
+        V_ptr.push_back(&V[ei]);
+    }
+    
+    std::vector<double*> Q_ptr(num_eqn);
+    
+    pdat::CellIterator icend(pdat::CellGeometry::end(ghost_box));
+    for (pdat::CellIterator ic(pdat::CellGeometry::begin(ghost_box));
+         ic != icend;
+         ic++)
+    {
+        hier::Index idx(*ic);
+        idx = idx - interior_box.lower();
+        
+        // Compute the linear index of the cell.
+        int idx_cell = 0;
+        int stride = 1;
+        for (int di = 0; di < dim.getValue(); di++)
+        {
+            idx_cell += (idx[di] + num_ghosts[di])*stride;
+            stride *= ghostcell_dims[di];
+        }
+        
+        getSyntheticPrimitiveVariables(V, idx, interior_dims, num_species, use_discontinuous_data);
+        
+        for (int ei = 0; ei < num_eqn; ei++)
+        {
+            Q_ptr[ei] = &Q[ei][idx_cell];
+        }
+        
+        flow_model->convertLocalCellDataPointersPrimitiveVariablesToConservativeVariables(V_ptr, Q_ptr);
+    }
+    
+    flow_model->unregisterPatch();
+}
+
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Initialize tbox::MPI and SAMRAI, enable logging, and process command line.
+     */
+    
+    tbox::SAMRAI_MPI::init(&argc, &argv);
+    tbox::SAMRAIManager::initialize();
+    tbox::SAMRAIManager::startup();
+    const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
+    
+    if (argc != 2)
+    {
+        tbox::pout << "USAGE:  "
+                   << argv[0]
+                   << " <input filename>"
+                   << std::endl;
+        tbox::SAMRAI_MPI::abort();
+        return -1;
+    }
+    
+    const std::string input_filename = argv[1];
+    
+    /*
+     * Create input database and parse all data in input file.
+     */
+    
+    boost::shared_ptr<tbox::InputDatabase> input_db(new tbox::InputDatabase("input_db"));
+    tbox::InputManager::getManager()->parseInputFile(input_filename, input_db);
+    
+    boost::shared_ptr<tbox::Database> main_db(input_db->getDatabase("Main"));
+    
+    const tbox::Dimension dim(static_cast<unsigned short>(main_db->getInteger("dim")));
+    
+    boost::shared_ptr<tbox::Database> benchmark_db(input_db->getDatabase("Benchmark"));
+    
+    const std::string application = benchmark_db->getStringWithDefault("application", "Euler");
+    
+    boost::shared_ptr<tbox::Database> app_db(input_db->getDatabase(application));
+    
+    std::vector<int> patch_size = benchmark_db->getIntegerVector("patch_size");
+    if (static_cast<int>(patch_size.size()) != dim.getValue())
+    {
+        TBOX_ERROR("hamers_bench: "
+            << "The number of entries in 'patch_size' is not equal to the problem dimension."
+            << std::endl);
+    }
+    
+    const int num_repetitions = benchmark_db->getIntegerWithDefault("num_repetitions", 10);
+    if (num_repetitions < 1)
+    {
+        TBOX_ERROR("hamers_bench: "
+            << "'num_repetitions' should be positive."
+            << std::endl);
+    }
+    
+    std::vector<std::string> kernels;
+    if (benchmark_db->keyExists("kernels"))
+    {
+        kernels = benchmark_db->getStringVector("kernels");
+    }
+    else
+    {
+        kernels.push_back("CONVECTIVE_FLUX_RECONSTRUCTOR");
+        kernels.push_back("RIEMANN_SOLVER");
+        kernels.push_back("EQUATION_OF_STATE");
+        kernels.push_back("WAVELET_TRANSFORM_HARTEN");
+        kernels.push_back("BOUNDARY_FILL");
+    }
+    
+    const bool use_discontinuous_data =
+        benchmark_db->getBoolWithDefault("use_discontinuous_data", false);
+    
+    const int Harten_wavelet_num_level =
+        benchmark_db->getIntegerWithDefault("Harten_wavelet_num_level", 3);
+    
+    const int Harten_wavelet_num_vanishing_moments =
+        benchmark_db->getIntegerWithDefault("Harten_wavelet_num_vanishing_moments", 2);
+    
+    const std::string output_filename = benchmark_db->getStringWithDefault("output_filename", "");
+    
+    /*
+     * Create the grid geometry, the flow model and the convective flux reconstructor in the same
+     * way as the applications.
+     */
+    
+    boost::shared_ptr<geom::CartesianGridGeometry> grid_geometry(
+        new geom::CartesianGridGeometry(
+            dim,
+            "CartesianGeometry",
+            input_db->getDatabase("CartesianGeometry")));
+    
+    const int num_species = app_db->getInteger("num_species");
+    
+    boost::shared_ptr<FlowModelManager> flow_model_manager(
+        new FlowModelManager(
+            "flow_model_manager",
+            dim,
+            grid_geometry,
+            num_species,
+            app_db->getDatabase("Flow_model"),
+            app_db->getString("flow_model")));
+    
+    boost::shared_ptr<FlowModel> flow_model = flow_model_manager->getFlowModel();
+    
+    const int num_eqn = flow_model->getNumberOfEquations();
+    
+    boost::shared_ptr<ConvectiveFluxReconstructorManager> convective_flux_reconstructor_manager(
+        new ConvectiveFluxReconstructorManager(
+            "convective_flux_reconstructor_manager",
+            dim,
+            grid_geometry,
+            num_eqn,
+            flow_model,
+            app_db->getDatabase("Convective_flux_reconstructor"),
+            app_db->getString("convective_flux_reconstructor")));
+    
+    boost::shared_ptr<ConvectiveFluxReconstructor> convective_flux_reconstructor =
+        convective_flux_reconstructor_manager->getConvectiveFluxReconstructor();
+    
+    /*
+     * Register the variables of the synthetic patch.
+     */
+    
+    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    
+    boost::shared_ptr<hier::VariableContext> data_context = variable_db->getContext("BENCHMARK");
+    
+    const hier::IntVector num_ghosts = convective_flux_reconstructor->getConvectiveFluxNumberOfGhostCells();
+    
+    std::vector<int> data_ids;
+    
+    std::vector<boost::shared_ptr<pdat::CellVariable<double> > > conservative_variables =
+        flow_model->getConservativeVariables();
+    
+    for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
+    {
+        data_ids.push_back(variable_db->registerVariableAndContext(
+            conservative_variables[vi],
+            data_context,
+            num_ghosts));
+    }
+    
+    boost::shared_ptr<pdat::SideVariable<double> > variable_convective_flux(
+        new pdat::SideVariable<double>(dim, "convective flux", num_eqn));
+    
+    boost::shared_ptr<pdat::CellVariable<double> > variable_source(
+        new pdat::CellVariable<double>(dim, "source", num_eqn));
+    
+    data_ids.push_back(variable_db->registerVariableAndContext(
+        variable_convective_flux,
+        data_context,
+        hier::IntVector::getZero(dim)));
+    
+    data_ids.push_back(variable_db->registerVariableAndContext(
+        variable_source,
+        data_context,
+        hier::IntVector::getZero(dim)));
+    
+    /*
+     * Create the synthetic patch and allocate the data on it.
+     */
+    
+    hier::Index patch_lo(dim, 0);
+    hier::Index patch_hi(dim, 0);
+    for (int di = 0; di < dim.getValue(); di++)
+    {
+        patch_hi[di] = patch_size[di] - 1;
+    }
+    
+    const hier::Box patch_box(
+        hier::Box(patch_lo, patch_hi, hier::BlockId(0)),
+        hier::LocalId(0),
+        mpi.getRank());
+    
+    hier::Patch patch(patch_box, variable_db->getPatchDescriptor());
+    
+    const hier::PatchGeometry::TwoDimBool touches_regular_bdry(dim, false);
+    grid_geometry->setGeometryDataOnPatch(
+        patch,
+        hier::IntVector::getOne(dim),
+        touches_regular_bdry);
+    
+    for (int i = 0; i < static_cast<int>(data_ids.size()); i++)
+    {
+        patch.allocatePatchData(data_ids[i]);
+    }
+    
+    initializeConservativeVariables(
+        flow_model,
+        patch,
+        data_context,
+        num_species,
+        use_discontinuous_data);
+    
+    const hier::Box interior_box = patch.getBox();
+    const double num_cells = double(interior_box.size());
+    
+    /*
+     * Get the conservative variables at two cells on either side of the patch center. They are
+     * used as the left and right states of the Riemann problems.
+     */
+    
+    std::vector<double> Q_L(num_eqn);
+    std::vector<double> Q_R(num_eqn);
+    
+    {
+        hier::Index idx_L(patch_lo);
+        hier::Index idx_R(patch_lo);
+        for (int di = 0; di < dim.getValue(); di++)
+        {
+            idx_L[di] = (patch_size[di] - 1)/2;
+            idx_R[di] = idx_L[di];
+        }
+        idx_R[0] += 1;
+        
+        flow_model->registerPatchWithDataContext(patch, data_context);
+        
+        std::vector<boost::shared_ptr<pdat::CellData<double> > > data_conservative_variables =
+            flow_model->getGlobalCellDataConservativeVariables();
+        
+        int count_eqn = 0;
+        for (int vi = 0; vi < static_cast<int>(data_conservative_variables.size()); vi++)
+        {
+            for (int depth = 0; depth < data_conservative_variables[vi]->getDepth(); depth++)
+            {
+                if (count_eqn >= num_eqn)
+                    break;
+                
+                Q_L[count_eqn] = (*data_conservative_variables[vi])(pdat::CellIndex(idx_L), depth);
+                Q_R[count_eqn] = (*data_conservative_variables[vi])(pdat::CellIndex(idx_R), depth);
+                
+                count_eqn++;
+            }
+        }
+        
+        flow_model->unregisterPatch();
+    }
+    
+    /*
+     * Benchmark the kernels.
+     */
+    
+    std::vector<BenchmarkRecord> records;
+    
+    for (int ki = 0; ki < static_cast<int>(kernels.size()); ki++)
+    {
+        BenchmarkRecord record;
+        record.kernel = kernels[ki];
+        
+        if (kernels[ki] == "CONVECTIVE_FLUX_RECONSTRUCTOR")
+        {
+            boost::shared_ptr<pdat::SideData<double> > data_convective_flux(
+                BOOST_CAST<pdat::SideData<double>, hier::PatchData>(
+                    patch.getPatchData(variable_convective_flux, data_context)));
+            
+            boost::shared_ptr<pdat::CellData<double> > data_source(
+                BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                    patch.getPatchData(variable_source, data_context)));
+            
+            /*
+             * The fluxes are only scaled by the time step size, so any positive value measures
+             * the same work.
+             */
+            
+            const double dt = 1.0e-6;
+            
+            record.seconds_per_call = timeKernel(
+                [&]()
+                {
+                    data_source->fillAll(0.0);
+                    
+                    convective_flux_reconstructor->computeConvectiveFluxAndSourceOnPatch(
+                        patch,
+                        variable_convective_flux,
+                        variable_source,
+                        data_context,
+                        0.0,
+                        dt,
+                        0);
+                },
+                num_repetitions);
+            
+            record.bytes_per_call = getSideDataBytes(data_convective_flux) + getCellDataBytes(data_source);
+            for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
+            {
+                record.bytes_per_call += getCellDataBytes(
+                    BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                        patch.getPatchData(conservative_variables[vi], data_context)));
+            }
+        }
+        else if (kernels[ki] == "RIEMANN_SOLVER")
+        {
+            flow_model->setupRiemannSolver();
+            
+            const boost::shared_ptr<FlowModelRiemannSolver>& riemann_solver =
+                flow_model->getFlowModelRiemannSolver();
+            
+            const std::string Riemann_solver_str =
+                benchmark_db->getStringWithDefault("Riemann_solver", "HLLC");
+            
+            RIEMANN_SOLVER::TYPE riemann_solver_type = RIEMANN_SOLVER::HLLC;
+            if (Riemann_solver_str == "HLLC_HLL")
+            {
+                riemann_solver_type = RIEMANN_SOLVER::HLLC_HLL;
+            }
+            else if (Riemann_solver_str != "HLLC")
+            {
+                TBOX_ERROR("hamers_bench: "
+                    << "Unknown Riemann_solver = '"
+                    << Riemann_solver_str
+                    << "' found."
+                    << std::endl);
+            }
+            
+            std::vector<boost::shared_ptr<pdat::SideData<double> > > conservative_variables_minus;
+            std::vector<boost::shared_ptr<pdat::SideData<double> > > conservative_variables_plus;
+            conservative_variables_minus.reserve(num_eqn);
+            conservative_variables_plus.reserve(num_eqn);
+            
+            for (int ei = 0; ei < num_eqn; ei++)
+            {
+                conservative_variables_minus.push_back(boost::make_shared<pdat::SideData<double> >(
+                    interior_box, 1, hier::IntVector::getOne(dim)));
+                
+                conservative_variables_plus.push_back(boost::make_shared<pdat::SideData<double> >(
+                    interior_box, 1, hier::IntVector::getOne(dim)));
+                
+                conservative_variables_minus[ei]->fillAll(Q_L[ei]);
+                conservative_variables_plus[ei]->fillAll(Q_R[ei]);
+            }
+            
+            boost::shared_ptr<pdat::SideData<double> > convective_flux_midpoint(
+                boost::make_shared<pdat::SideData<double> >(
+                    interior_box, num_eqn, hier::IntVector::getOne(dim)));
+            
+            record.seconds_per_call = timeKernel(
+                [&]()
+                {
+                    riemann_solver->computeConvectiveFluxFromConservativeVariables(
+                        convective_flux_midpoint,
+                        conservative_variables_minus,
+                        conservative_variables_plus,
+                        DIRECTION::X_DIRECTION,
+                        riemann_solver_type);
+                    
+                    if (dim > tbox::Dimension(1))
+                    {
+                        riemann_solver->computeConvectiveFluxFromConservativeVariables(
+                            convective_flux_midpoint,
+                            conservative_variables_minus,
+                            conservative_variables_plus,
+                            DIRECTION::Y_DIRECTION,
+                            riemann_solver_type);
+                    }
+                    
+                    if (dim > tbox::Dimension(2))
+                    {
+                        riemann_solver->computeConvectiveFluxFromConservativeVariables(
+                            convective_flux_midpoint,
+                            conservative_variables_minus,
+                            conservative_variables_plus,
+                            DIRECTION::Z_DIRECTION,
+                            riemann_solver_type);
+                    }
+                },
+                num_repetitions);
+            
+            record.bytes_per_call = getSideDataBytes(convective_flux_midpoint);
+            for (int ei = 0; ei < num_eqn; ei++)
+            {
+                record.bytes_per_call += getSideDataBytes(conservative_variables_minus[ei]) +
+                    getSideDataBytes(conservative_variables_plus[ei]);
+            }
+        }
+        else if (kernels[ki] == "EQUATION_OF_STATE")
+        {
+            const boost::shared_ptr<EquationOfStateMixingRules>& equation_of_state_mixing_rules =
+                flow_model->getEquationOfStateMixingRules();
+            
+            const boost::shared_ptr<EquationOfState>& equation_of_state =
+                equation_of_state_mixing_rules->getEquationOfState();
+            
+            /*
+             * Get the thermodynamic properties of the first species.
+             */
+            
+            const int num_thermo_properties =
+                equation_of_state_mixing_rules->getNumberOfSpeciesThermodynamicProperties();
+            
+            std::vector<double> thermo_properties(num_thermo_properties);
+            std::vector<double*> thermo_properties_ptr;
+            std::vector<const double*> thermo_properties_const_ptr;
+            thermo_properties_ptr.reserve(num_thermo_properties);
+            thermo_properties_const_ptr.reserve(num_thermo_properties);
+            for (int ti = 0; ti < num_thermo_properties; ti++)
+            {
+                thermo_properties_ptr.push_back(&thermo_properties[ti]);
+                thermo_properties_const_ptr.push_back(&thermo_properties[ti]);
+            }
+            
+            equation_of_state_mixing_rules->getSpeciesThermodynamicProperties(thermo_properties_ptr);
+            
+            boost::shared_ptr<pdat::CellData<double> > data_density(
+                boost::make_shared<pdat::CellData<double> >(interior_box, 1, num_ghosts));
+            
+            boost::shared_ptr<pdat::CellData<double> > data_internal_energy(
+                boost::make_shared<pdat::CellData<double> >(interior_box, 1, num_ghosts));
+            
+            boost::shared_ptr<pdat::CellData<double> > data_pressure(
+                boost::make_shared<pdat::CellData<double> >(interior_box, 1, num_ghosts));
+            
+            data_density->fillAll(1.0);
+            data_internal_energy->fillAll(2.5);
+            
+            record.seconds_per_call = timeKernel(
+                [&]()
+                {
+                    equation_of_state->computePressure(
+                        data_pressure,
+                        data_density,
+                        data_internal_energy,
+                        thermo_properties_const_ptr);
+                },
+                num_repetitions);
+            
+            record.bytes_per_call = getCellDataBytes(data_density) + getCellDataBytes(data_internal_energy) +
+                getCellDataBytes(data_pressure);
+        }
+        else if (kernels[ki] == "WAVELET_TRANSFORM_HARTEN")
+        {
+            boost::shared_ptr<WaveletTransformHarten> wavelet_transform_Harten(
+                new WaveletTransformHarten(
+                    "wavelet_transform_Harten",
+                    dim,
+                    Harten_wavelet_num_level,
+                    Harten_wavelet_num_vanishing_moments));
+            
+            const hier::IntVector num_wavelet_ghosts =
+                wavelet_transform_Harten->getWaveletTransformNumberOfGhostCells();
+            
+            boost::shared_ptr<pdat::CellData<double> > data_cell(
+                boost::make_shared<pdat::CellData<double> >(interior_box, 1, num_wavelet_ghosts));
+            
+            // Use the same synthetic density as the flow model.
+            std::vector<double> V(num_eqn);
+            const hier::IntVector interior_dims = interior_box.numberCells();
+            
+            const hier::Box ghost_box = data_cell->getGhostBox();
+            pdat::CellIterator icend(pdat::CellGeometry::end(ghost_box));
+            for (pdat::CellIterator ic(pdat::CellGeometry::begin(ghost_box));
+                 ic != icend;
+                 ic++)
+            {
+                hier::Index idx(*ic);
+                idx = idx - interior_box.lower();
+                
+                getSyntheticPrimitiveVariables(
+                    V,
+                    idx,
+                    interior_dims,
+                    num_species,
+                    use_discontinuous_data);
+                
+                double rho = 0.0;
+                for (int si = 0; si < num_species; si++)
+                {
+                    rho += V[si];
+                }
+                
+                (*data_cell)(*ic) = rho;
+            }
+            
+            std::vector<boost::shared_ptr<pdat::CellData<double> > > wavelet_coeffs;
+            wavelet_coeffs.reserve(Harten_wavelet_num_level);
+            for (int li = 0; li < Harten_wavelet_num_level; li++)
+            {
+                wavelet_coeffs.push_back(boost::make_shared<pdat::CellData<double> >(
+                    interior_box, 1, num_wavelet_ghosts));
+            }
+            
+            record.seconds_per_call = timeKernel(
+                [&]()
+                {
+                    wavelet_transform_Harten->computeWaveletCoefficients(
+                        wavelet_coeffs,
+                        data_cell,
+                        patch);
+                },
+                num_repetitions);
+            
+            record.bytes_per_call = getCellDataBytes(data_cell);
+            for (int li = 0; li < Harten_wavelet_num_level; li++)
+            {
+                record.bytes_per_call += getCellDataBytes(wavelet_coeffs[li]);
+            }
+        }
+        else if (kernels[ki] == "BOUNDARY_FILL")
+        {
+            std::vector<boost::shared_ptr<pdat::CellData<double> > > data_conservative_variables;
+            data_conservative_variables.reserve(conservative_variables.size());
+            for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
+            {
+                data_conservative_variables.push_back(
+                    BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                        patch.getPatchData(conservative_variables[vi], data_context)));
+            }
+            
+            /*
+             * Get the offset indices of the interior box and the fill boxes of the ghost cells at
+             * all faces of the patch.
+             */
+            
+            const hier::Index interior_box_lo_idx(dim, 0);
+            const hier::Index interior_box_hi_idx(interior_box.upper() - interior_box.lower());
+            
+            std::vector<hier::Index> fill_box_lo_idx;
+            std::vector<hier::Index> fill_box_hi_idx;
+            std::vector<int> bdry_direction;
+            std::vector<bool> is_lower_bdry;
+            
+            double num_ghost_cells_filled = 0.0;
+            
+            for (int di = 0; di < dim.getValue(); di++)
+            {
+                for (int si = 0; si < 2; si++)
+                {
+                    hier::Index lo_idx(interior_box_lo_idx);
+                    hier::Index hi_idx(interior_box_hi_idx);
+                    
+                    if (si == 0)
+                    {
+                        lo_idx[di] = -num_ghosts[di];
+                        hi_idx[di] = -1;
+                    }
+                    else
+                    {
+                        lo_idx[di] = interior_box_hi_idx[di] + 1;
+                        hi_idx[di] = interior_box_hi_idx[di] + num_ghosts[di];
+                    }
+                    
+                    double num_cells_fill_box = 1.0;
+                    for (int dj = 0; dj < dim.getValue(); dj++)
+                    {
+                        num_cells_fill_box *= double(hi_idx[dj] - lo_idx[dj] + 1);
+                    }
+                    
+                    fill_box_lo_idx.push_back(lo_idx);
+                    fill_box_hi_idx.push_back(hi_idx);
+                    bdry_direction.push_back(di);
+                    is_lower_bdry.push_back(si == 0);
+                    
+                    num_ghost_cells_filled += num_cells_fill_box;
+                }
+            }
+            
+            record.seconds_per_call = timeKernel(
+                [&]()
+                {
+                    for (int vi = 0; vi < static_cast<int>(data_conservative_variables.size()); vi++)
+                    {
+                        for (int bi = 0; bi < static_cast<int>(fill_box_lo_idx.size()); bi++)
+                        {
+                            BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                                data_conservative_variables[vi],
+                                fill_box_lo_idx[bi],
+                                fill_box_hi_idx[bi],
+                                interior_box_lo_idx,
+                                interior_box_hi_idx,
+                                bdry_direction[bi],
+                                is_lower_bdry[bi],
+                                true);
+                        }
+                    }
+                },
+                num_repetitions);
+            
+            record.bytes_per_call = 0.0;
+            for (int vi = 0; vi < static_cast<int>(data_conservative_variables.size()); vi++)
+            {
+                record.bytes_per_call += double(2)*num_ghost_cells_filled*
+                    double(data_conservative_variables[vi]->getDepth())*double(sizeof(double));
+            }
+        }
+        else
+        {
+            TBOX_ERROR("hamers_bench: "
+                << "Unknown kernel '""
+                << kernels[ki]
+                << "' found."
+                << std::endl);
+        }
+        
+        records.push_back(record);
+    }
+    
+    /*
+     * Output the results as comma-separated values.
+     */
+    
+    std::ostringstream patch_size_str;
+    for (int di = 0; di < dim.getValue(); di++)
+    {
+        if (di > 0)
+            patch_size_str << "x";
+        patch_size_str << patch_size[di];
+    }
+    
+    std::ostringstream results;
+    results << "kernel,dim,flow_model,num_species,num_eqn,patch_size,num_cells,num_repetitions,"
+            << "seconds_per_call,cells_per_second,bytes_per_cell,bandwidth_GB_per_second"
+            << std::endl;
+    
+    for (int ri = 0; ri < static_cast<int>(records.size()); ri++)
+    {
+        const double cells_per_second = num_cells/records[ri].seconds_per_call;
+        const double bytes_per_cell = records[ri].bytes_per_call/num_cells;
+        
+        results << records[ri].kernel << ","
+                << dim.getValue() << ","
+                << app_db->getString("flow_model") << ","
+                << num_species << ","
+                << num_eqn << ","
+                << patch_size_str.str() << ","
+                << interior_box.size() << ","
+                << num_repetitions << ","
+                << records[ri].seconds_per_call << ","
+                << cells_per_second << ","
+                << bytes_per_cell << ","
+                << cells_per_second*bytes_per_cell*1.0e-9
+                << std::endl;
+    }
+    
+    tbox::pout << results.str();
+    
+    if (!output_filename.empty() && mpi.getRank() == 0)
+    {
+        std::ofstream f_out(output_filename.c_str());
+        
+        if (!f_out.is_open())
+        {
+            TBOX_ERROR("hamers_bench: "
+                << "Failed to open file '"
+                << output_filename
+                << "' to output benchmark results!"
+                << std::endl);
+        }
+        
+        f_out << results.str();
+        f_out.close();
+    }
+    
+    /*
+     * Deallocate objects.
+     */
+    
+    for (int i = 0; i < static_cast<int>(data_ids.size()); i++)
+    {
+        patch.deallocatePatchData(data_ids[i]);
+    }
+    
+    convective_flux_reconstructor.reset();
+    convective_flux_reconstructor_manager.reset();
+    flow_model.reset();
+    flow_model_manager.reset();
+    grid_geometry.reset();
+    
+    tbox::SAMRAIManager::shutdown();
+    tbox::SAMRAIManager::finalize();
+    tbox::SAMRAI_MPI::finalize();
+    
+    return 0;
+}
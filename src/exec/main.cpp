@@ -4,6 +4,10 @@
 #include "algs/integrator/RungeKuttaLevelIntegrator.hpp"
 #include "apps/Euler/Euler.hpp"
 #include "apps/Navier-Stokes/NavierStokes.hpp"
+#include "extn/data_probes/DataProbes.hpp"
+#include "extn/restart_hierarchy_data/RestartHierarchyDataReader.hpp"
+#include "extn/restart_hierarchy_data/RestartHierarchyDataWriter.hpp"
+#include "extn/restart_writer/ExtendedRestartWriter.hpp"
 #include "extn/visit_data_writer/ExtendedVisItDataWriter.hpp"
 
 // Headers for basic SAMRAI objects
@@ -47,6 +51,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 
 #ifndef _MSC_VER
 #include <unistd.h>
@@ -404,6 +409,13 @@ int main(int argc, char *argv[])
     const bool write_restart = (restart_interval > 0)
                                 && !(restart_write_dirname.empty());
     
+    /*
+     * Get the name of the file for the performance summary of the time step loop. The summary
+     * is only written to the log if no file name is given.
+     */
+    const std::string performance_summary_filename =
+        main_db->getStringWithDefault("performance_summary_filename", "");
+    
     bool use_refined_timestepping = true;
     if (main_db->keyExists("timestepping"))
     {
@@ -431,6 +443,55 @@ int main(int argc, char *argv[])
     restart_manager->setDatabaseFactory(silo_database_factory);
 #endif
     
+    /*
+     * If the restart files were written with a different number of processes, restart from the
+     * hierarchy data instead. The hierarchy is then rebuilt from the boxes in the hierarchy data
+     * and the run is started as a new run at the time of the restart.
+     */
+#ifdef HAVE_HDF5
+    boost::shared_ptr<RestartHierarchyDataReader> restart_hierarchy_data_reader;
+    
+    if (is_from_restart)
+    {
+        int has_restart_files = 0;
+        if (mpi.getRank() == 0)
+        {
+            const std::string restart_nodes_dirname = restart_read_dirname + "/restore." +
+                tbox::Utilities::intToString(restore_num, 6) + "/nodes." +
+                tbox::Utilities::nodeToString(mpi.getSize());
+            
+            struct stat stat_buf;
+            if (stat(restart_nodes_dirname.c_str(), &stat_buf) == 0)
+            {
+                has_restart_files = 1;
+            }
+        }
+        mpi.Bcast(&has_restart_files, 1, MPI_INT, 0);
+        
+        if (has_restart_files == 0)
+        {
+            tbox::pout << "No restart files for "
+                       << mpi.getSize()
+                       << " processes are found. Restart from the hierarchy data."
+                       << std::endl;
+            
+            restart_hierarchy_data_reader.reset(
+                new RestartHierarchyDataReader(
+                    "RestartHierarchyDataReader",
+                    RestartHierarchyDataWriter::getHierarchyDataFilename(
+                        restart_read_dirname,
+                        restore_num),
+                    dim));
+            
+            input_db->getDatabase("TimeRefinementIntegrator")->putDouble(
+                "start_time",
+                restart_hierarchy_data_reader->getTime());
+            
+            is_from_restart = false;
+        }
+    }
+#endif
+    
     if (is_from_restart)
     {
         restart_manager->openRestartFile(
@@ -665,6 +726,47 @@ int main(int argc, char *argv[])
             RK_level_integrator,
             gridding_algorithm));
     
+    /*
+     * Set up the restart writer. The asynchronous writes and the retention of the restart files
+     * are set in the optional database "ExtendedRestartWriter".
+     */
+    boost::shared_ptr<ExtendedRestartWriter> restart_writer;
+    
+    if (!(restart_write_dirname.empty()))
+    {
+        boost::shared_ptr<tbox::Database> restart_writer_db;
+        if (input_db->keyExists("ExtendedRestartWriter"))
+        {
+            restart_writer_db = input_db->getDatabase("ExtendedRestartWriter");
+        }
+        
+        restart_writer.reset(
+            new ExtendedRestartWriter(
+                "ExtendedRestartWriter",
+                restart_write_dirname,
+                restart_writer_db));
+        
+        restart_writer->setHierarchyData(
+            patch_hierarchy,
+            RK_level_integrator->getCurrentTimeDependentPatchDataIndices());
+    }
+    
+    /*
+     * Set up the data probes, which are set in the optional database "DataProbes".
+     */
+    boost::shared_ptr<DataProbes> data_probes;
+    
+    if (input_db->keyExists("DataProbes"))
+    {
+        data_probes.reset(
+            new DataProbes(
+                "DataProbes",
+                dim,
+                input_db->getDatabase("DataProbes"),
+                grid_geometry,
+                RK_level_integrator->getCurrentContext()));
+    }
+    
     /*
      * Set up Visualization writer(s).  Note that the Euler application
      * creates some derived data quantities so we register the Euler model
@@ -710,10 +812,40 @@ int main(int argc, char *argv[])
     /*
      * Initialize hierarchy configuration and data on all patches.
      * Then, close restart file and write initial state for visualization.
+     *
+     * When restarting from the hierarchy data, the levels are built with the boxes in the
+     * hierarchy data as the refine boxes and the data is read from the hierarchy data after the
+     * levels are initialized. The step numbers continue from the step number of the restart.
      */
     
+    int iteration_num_offset = 0;
+    
+#ifdef HAVE_HDF5
+    if (restart_hierarchy_data_reader)
+    {
+        std::vector<hier::BoxContainer> restart_refine_boxes;
+        restart_hierarchy_data_reader->getRefineBoxes(restart_refine_boxes, patch_hierarchy);
+        
+        error_detector->setInitialHierarchyRefineBoxes(restart_refine_boxes);
+        RK_level_integrator->setRestartHierarchyDataReader(restart_hierarchy_data_reader);
+    }
+#endif
+    
     double dt_now = time_integrator->initializeHierarchy();
     
+#ifdef HAVE_HDF5
+    if (restart_hierarchy_data_reader)
+    {
+        error_detector->clearInitialHierarchyRefineBoxes();
+        RK_level_integrator->setRestartHierarchyDataReader(
+            boost::shared_ptr<RestartHierarchyDataReader>());
+        
+        iteration_num_offset = restart_hierarchy_data_reader->getStep();
+        
+        restart_hierarchy_data_reader.reset();
+    }
+#endif
+    
     double dt_const = 0.0;
     if (!(RK_level_integrator->usingRefinedTimestepping()))
     {
@@ -746,6 +878,18 @@ int main(int argc, char *argv[])
     tbox::pout << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     RK_level_integrator->printClassData(tbox::pout);
     
+    if (restart_writer)
+    {
+        tbox::pout << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+        restart_writer->printClassData(tbox::pout);
+    }
+    
+    if (data_probes)
+    {
+        tbox::pout << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+        data_probes->printClassData(tbox::pout);
+    }
+    
     tbox::pout << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     tbox::pout << std::endl;
     
@@ -762,13 +906,16 @@ int main(int argc, char *argv[])
         tbox::TimerManager::getManager()->getTimer(
             "apps::main::write_restart"));
     
+    boost::shared_ptr<tbox::Timer> t_sample_probes(
+        tbox::TimerManager::getManager()->getTimer("apps::main::sample_probes"));
+    
     t_write_viz->start();
 #ifdef HAVE_HDF5
     if (is_viz_dumping)
     {
         visit_data_writer->writePlotData(
             patch_hierarchy,
-            time_integrator->getIntegratorStep(),
+            time_integrator->getIntegratorStep() + iteration_num_offset,
             time_integrator->getIntegratorTime());
     }
 #endif
@@ -783,6 +930,16 @@ int main(int argc, char *argv[])
     }
     t_write_stat->stop();
     
+    t_sample_probes->start();
+    if (data_probes)
+    {
+        data_probes->sampleData(
+            patch_hierarchy,
+            time_integrator->getIntegratorStep() + iteration_num_offset,
+            time_integrator->getIntegratorTime());
+    }
+    t_sample_probes->stop();
+    
     /*
      * Time step loop.  Note that the step count and integration
      * time are maintained by algs::TimeRefinementIntegrator.
@@ -801,6 +958,51 @@ int main(int argc, char *argv[])
     
     int iteration_num = 0;
     
+    /*
+     * Names of the timers used to break down the wall clock time of the time step loop in the
+     * performance summary. Each timer is counted in one group only. The boundary fills for the
+     * error estimation (RungeKuttaLevelIntegrator::error_bdry_fill_comm) are done inside
+     * mesh::GriddingAlgorithm::regridAllFinerLevels() and their time belongs to the regrid group.
+     */
+    std::vector<std::string> regrid_timer_names;
+    regrid_timer_names.push_back("mesh::GriddingAlgorithm::regridAllFinerLevels()");
+    
+    std::vector<std::string> io_timer_names;
+    io_timer_names.push_back("apps::main::write_viz");
+    io_timer_names.push_back("apps::main::write_stat");
+    io_timer_names.push_back("apps::main::write_restart");
+    io_timer_names.push_back("apps::main::sample_probes");
+    
+    std::vector<std::string> comm_timer_names;
+    comm_timer_names.push_back("RungeKuttaLevelIntegrator::advance_bdry_fill_comm");
+    comm_timer_names.push_back("RungeKuttaLevelIntegrator::new_advance_bdry_fill_comm");
+    comm_timer_names.push_back("RungeKuttaLevelIntegrator::advance_mpi_reductions");
+    comm_timer_names.push_back("RungeKuttaLevelIntegrator::get_level_dt_mpi_reductions");
+    comm_timer_names.push_back("RungeKuttaLevelIntegrator::sync_initial_comm");
+    comm_timer_names.push_back("RungeKuttaLevelIntegrator::coarsen_fluxsum_comm");
+    comm_timer_names.push_back("RungeKuttaLevelIntegrator::coarsen_sync_comm");
+    
+    std::vector<std::vector<std::string> > timer_groups;
+    timer_groups.push_back(regrid_timer_names);
+    timer_groups.push_back(io_timer_names);
+    timer_groups.push_back(comm_timer_names);
+    
+    const int num_timer_groups = static_cast<int>(timer_groups.size());
+    
+    std::vector<double> timer_group_times_start(num_timer_groups, 0.0);
+    for (int gi = 0; gi < num_timer_groups; gi++)
+    {
+        for (int ti = 0; ti < static_cast<int>(timer_groups[gi].size()); ti++)
+        {
+            timer_group_times_start[gi] += tbox::TimerManager::getManager()->
+                getTimer(timer_groups[gi][ti])->getTotalWallclockTime();
+        }
+    }
+    
+    const int step_num_start = time_integrator->getIntegratorStep();
+    const double cell_updates_start = RK_level_integrator->getNumberOfLocalCellUpdates();
+    const double loop_wallclock_time_start = tbox::SAMRAI_MPI::Wtime();
+    
     tbox::pout << "Start simulation... " << std::endl;
     tbox::pout << std::endl;
     
@@ -809,7 +1011,7 @@ int main(int argc, char *argv[])
         dump_viz = false;
         dump_stat = false;
         
-        iteration_num = time_integrator->getIntegratorStep() + 1;
+        iteration_num = time_integrator->getIntegratorStep() + 1 + iteration_num_offset;
         
         // Check whether dt_now is larger than the time interval to next files dumping time.
         if ((viz_dump_setting == "CONSTANT_TIME_INTERVAL") &&
@@ -925,9 +1127,9 @@ int main(int argc, char *argv[])
                     {
                         t_write_restart->start();
                         
-                        tbox::RestartManager::getManager()->
-                            writeRestartFile(restart_write_dirname,
-                                             iteration_num);
+                        restart_writer->writeRestartFile(
+                            iteration_num,
+                            time_integrator->getIntegratorTime());
                         
                         t_write_restart->stop();
                         
@@ -954,9 +1156,9 @@ int main(int argc, char *argv[])
                     {
                         t_write_restart->start();
                         
-                        tbox::RestartManager::getManager()->
-                            writeRestartFile(restart_write_dirname,
-                                             iteration_num);
+                        restart_writer->writeRestartFile(
+                            iteration_num,
+                            time_integrator->getIntegratorTime());
                         
                         t_write_restart->stop();
                         
@@ -1013,6 +1215,21 @@ int main(int argc, char *argv[])
             }
         }
         
+        /*
+         * Sample the data probes. The probes check their own sample interval.
+         */
+        if (data_probes)
+        {
+            t_sample_probes->start();
+            
+            data_probes->sampleData(
+                patch_hierarchy,
+                iteration_num,
+                time_integrator->getIntegratorTime());
+            
+            t_sample_probes->stop();
+        }
+        
         /*
          * At specified intervals, write restart files.
          */
@@ -1022,9 +1239,9 @@ int main(int argc, char *argv[])
             {
                 t_write_restart->start();
                 
-                tbox::RestartManager::getManager()->
-                    writeRestartFile(restart_write_dirname,
-                                     iteration_num);
+                restart_writer->writeRestartFile(
+                    iteration_num,
+                    time_integrator->getIntegratorTime());
                 
                 t_write_restart->stop();
             }
@@ -1058,9 +1275,9 @@ int main(int argc, char *argv[])
             {
                 t_write_restart->start();
                 
-                tbox::RestartManager::getManager()->
-                    writeRestartFile(restart_write_dirname,
-                                     iteration_num);
+                restart_writer->writeRestartFile(
+                    iteration_num,
+                    time_integrator->getIntegratorTime());
                 
                 t_write_restart->stop();
                 
@@ -1086,6 +1303,121 @@ int main(int argc, char *argv[])
         }
     }
     
+    /*
+     * Write the samples of the data probes that are still buffered.
+     */
+    if (data_probes)
+    {
+        t_sample_probes->start();
+        
+        data_probes->flushData();
+        
+        t_sample_probes->stop();
+    }
+    
+    /*
+     * Wait for the restart files written asynchronously to be completed.
+     */
+    if (restart_writer)
+    {
+        t_write_restart->start();
+        
+        restart_writer->finalize();
+        
+        t_write_restart->stop();
+    }
+    
+    /*
+     * Output the performance summary of the time step loop. The wall clock times are the maximum
+     * over all processors and the cell updates are summed over all processors.
+     */
+    
+    double loop_wallclock_time = tbox::SAMRAI_MPI::Wtime() - loop_wallclock_time_start;
+    double num_cell_updates = RK_level_integrator->getNumberOfLocalCellUpdates() - cell_updates_start;
+    const int num_steps = time_integrator->getIntegratorStep() - step_num_start;
+    
+    std::vector<double> timer_group_times(num_timer_groups, 0.0);
+    for (int gi = 0; gi < num_timer_groups; gi++)
+    {
+        for (int ti = 0; ti < static_cast<int>(timer_groups[gi].size()); ti++)
+        {
+            timer_group_times[gi] += tbox::TimerManager::getManager()->
+                getTimer(timer_groups[gi][ti])->getTotalWallclockTime();
+        }
+        timer_group_times[gi] -= timer_group_times_start[gi];
+    }
+    
+    if (mpi.getSize() > 1)
+    {
+        mpi.AllReduce(&loop_wallclock_time, 1, MPI_MAX);
+        mpi.AllReduce(&num_cell_updates, 1, MPI_SUM);
+        mpi.AllReduce(&timer_group_times[0], num_timer_groups, MPI_MAX);
+    }
+    
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    const int num_cores = mpi.getSize()*num_threads;
+    
+    const double cell_updates_per_second_per_core = loop_wallclock_time > 0.0 ?
+        num_cell_updates/(loop_wallclock_time*double(num_cores)) : 0.0;
+    
+    std::vector<double> timer_group_fractions(num_timer_groups, 0.0);
+    for (int gi = 0; gi < num_timer_groups; gi++)
+    {
+        if (loop_wallclock_time > 0.0)
+        {
+            timer_group_fractions[gi] = timer_group_times[gi]/loop_wallclock_time;
+        }
+    }
+    
+    tbox::pout << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+    tbox::pout << std::endl;
+    tbox::pout << "Performance summary of the time step loop:" << std::endl;
+    tbox::pout << "Number of processes: " << mpi.getSize() << std::endl;
+    tbox::pout << "Number of threads per process: " << num_threads << std::endl;
+    tbox::pout << "Number of time steps: " << num_steps << std::endl;
+    tbox::pout << "Wall clock time: " << loop_wallclock_time << std::endl;
+    tbox::pout << "Number of cell updates: " << num_cell_updates << std::endl;
+    tbox::pout << "Cell updates per second per core: " << cell_updates_per_second_per_core << std::endl;
+    tbox::pout << "Regrid fraction: " << timer_group_fractions[0] << std::endl;
+    tbox::pout << "I/O fraction: " << timer_group_fractions[1] << std::endl;
+    tbox::pout << "Communication fraction: " << timer_group_fractions[2] << std::endl;
+    
+    if (!performance_summary_filename.empty() && mpi.getRank() == 0)
+    {
+        std::ofstream f_out;
+        f_out.open(performance_summary_filename.c_str());
+        
+        if (!f_out.is_open())
+        {
+            TBOX_ERROR("Failed to open file '"
+                << performance_summary_filename
+                << "' to output performance summary!"
+                << std::endl);
+        }
+        
+        f_out.precision(12);
+        
+        f_out << "{" << std::endl;
+        f_out << "    \"num_processes\": " << mpi.getSize() << "," << std::endl;
+        f_out << "    \"num_threads_per_process\": " << num_threads << "," << std::endl;
+        f_out << "    \"num_time_steps\": " << num_steps << "," << std::endl;
+        f_out << "    \"wallclock_time\": " << loop_wallclock_time << "," << std::endl;
+        f_out << "    \"num_cell_updates\": " << num_cell_updates << "," << std::endl;
+        f_out << "    \"cell_updates_per_second_per_core\": " << cell_updates_per_second_per_core << "," << std::endl;
+        f_out << "    \"regrid_time\": " << timer_group_times[0] << "," << std::endl;
+        f_out << "    \"io_time\": " << timer_group_times[1] << "," << std::endl;
+        f_out << "    \"communication_time\": " << timer_group_times[2] << "," << std::endl;
+        f_out << "    \"regrid_fraction\": " << timer_group_fractions[0] << "," << std::endl;
+        f_out << "    \"io_fraction\": " << timer_group_fractions[1] << "," << std::endl;
+        f_out << "    \"communication_fraction\": " << timer_group_fractions[2] << std::endl;
+        f_out << "}" << std::endl;
+        
+        f_out.close();
+    }
+    
     tbox::plog << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     tbox::plog << std::endl;
     tbox::plog << "Error statistics:\n";
@@ -1129,6 +1461,8 @@ int main(int argc, char *argv[])
 #ifdef HAVE_HDF5
     visit_data_writer.reset();
 #endif
+    restart_writer.reset();
+    data_probes.reset();
     
     if (Euler_app)
         delete Euler_app;
@@ -1,3 +1,6 @@
+#include "algs/integrator/FusedMPIReduction.hpp"
+#include "algs/integrator/RungeKuttaLevelIntegrator.hpp"
+#include "flow/flow_models/FlowModelManager.hpp"
 #include "util/mixing_rules/equations_of_bulk_viscosity/constant/EquationOfBulkViscosityConstant.hpp"
 #include "util/mixing_rules/equations_of_bulk_viscosity/Cramer/EquationOfBulkViscosityCramer.hpp"
 #include "util/mixing_rules/equations_of_mass_diffusivity/constant/EquationOfMassDiffusivityMixingRulesConstant.hpp"
@@ -6,14 +9,183 @@
 #include "util/mixing_rules/equations_of_shear_viscosity/Chapman-Enskog/EquationOfShearViscosityChapmanEnskog.hpp"
 #include "util/mixing_rules/equations_of_thermal_conductivity/constant/EquationOfThermalConductivityConstant.hpp"
 #include "util/mixing_rules/equations_of_thermal_conductivity/Prandtl/EquationOfThermalConductivityPrandtl.hpp"
+#include "util/wavelet_transform/WaveletTransformHarten.hpp"
 
+#include "SAMRAI/geom/CartesianGridGeometry.h"
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/BoxContainer.h"
+#include "SAMRAI/hier/Index.h"
+#include "SAMRAI/hier/Patch.h"
+#include "SAMRAI/hier/VariableDatabase.h"
+#include "SAMRAI/pdat/CellData.h"
+#include "SAMRAI/pdat/CellGeometry.h"
+#include "SAMRAI/pdat/CellIndex.h"
+#include "SAMRAI/pdat/CellIterator.h"
+#include "SAMRAI/pdat/SideData.h"
+#include "SAMRAI/pdat/SideGeometry.h"
+#include "SAMRAI/pdat/SideIndex.h"
+#include "SAMRAI/pdat/SideIterator.h"
 #include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/DatabaseBox.h"
 #include "SAMRAI/tbox/InputDatabase.h"
+#include "SAMRAI/tbox/MemoryDatabase.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/SAMRAIManager.h"
+
+#include "boost/make_shared.hpp"
+#include <limits>
 
 using namespace SAMRAI;
 
+/*
+ * Evaluate the scaling coefficient of Harten's transform at the given level directly from the cell
+ * data along one direction. The scaling coefficient at level 0 is the cell data itself.
+ */
+static double
+computeHartenScalingCoefficient(
+    const pdat::CellData<double>& cell_data,
+    const hier::Index& index,
+    const int direction,
+    const int level,
+    const int num_vanishing_moments)
+{
+    if (level == 0)
+    {
+        return cell_data(pdat::CellIndex(index));
+    }
+    
+    const int offset = 1 << (level - 1);
+    
+    hier::Index index_L(index);
+    hier::Index index_R(index);
+    index_L[direction] -= offset;
+    index_R[direction] += offset;
+    
+    const double f_L = computeHartenScalingCoefficient(cell_data, index_L, direction, level - 1,
+        num_vanishing_moments);
+    
+    const double f_R = computeHartenScalingCoefficient(cell_data, index_R, direction, level - 1,
+        num_vanishing_moments);
+    
+    if (num_vanishing_moments == 2)
+    {
+        return double(1)/double(2)*(f_L + f_R);
+    }
+    
+    hier::Index index_LL(index);
+    hier::Index index_RR(index);
+    index_LL[direction] -= 2*offset;
+    index_RR[direction] += 2*offset;
+    
+    const double f_LL = computeHartenScalingCoefficient(cell_data, index_LL, direction, level - 1,
+        num_vanishing_moments);
+    
+    const double f_RR = computeHartenScalingCoefficient(cell_data, index_RR, direction, level - 1,
+        num_vanishing_moments);
+    
+    return double(1)/double(6)*(-f_LL + double(4)*f_L + double(4)*f_R - f_RR);
+}
+
+
+/*
+ * Evaluate the one-dimensional wavelet coefficient and the unscaled local mean of Harten's
+ * transform at the given level directly from the cell data along one direction.
+ */
+static void
+computeHartenWaveletCoefficientAndLocalMean(
+    double& w,
+    double& f_mean,
+    const pdat::CellData<double>& cell_data,
+    const hier::Index& index,
+    const int direction,
+    const int level,
+    const int num_vanishing_moments)
+{
+    const int offset = 1 << level;
+    
+    hier::Index index_L(index);
+    hier::Index index_R(index);
+    index_L[direction] -= offset;
+    index_R[direction] += offset;
+    
+    const double f_L = computeHartenScalingCoefficient(cell_data, index_L, direction, level,
+        num_vanishing_moments);
+    
+    const double f = computeHartenScalingCoefficient(cell_data, index, direction, level,
+        num_vanishing_moments);
+    
+    const double f_R = computeHartenScalingCoefficient(cell_data, index_R, direction, level,
+        num_vanishing_moments);
+    
+    if (num_vanishing_moments == 2)
+    {
+        w = double(-1)/double(2)*(f_L - double(2)*f + f_R);
+        f_mean = f_L + double(2)*f + f_R;
+        
+        return;
+    }
+    
+    hier::Index index_LL(index);
+    hier::Index index_RR(index);
+    index_LL[direction] -= 2*offset;
+    index_RR[direction] += 2*offset;
+    
+    const double f_LL = computeHartenScalingCoefficient(cell_data, index_LL, direction, level,
+        num_vanishing_moments);
+    
+    const double f_RR = computeHartenScalingCoefficient(cell_data, index_RR, direction, level,
+        num_vanishing_moments);
+    
+    w = double(1)/double(6)*(f_LL - double(4)*f_L + double(6)*f - double(4)*f_R + f_RR);
+    f_mean = f_LL + double(4)*f_L + double(6)*f + double(4)*f_R + f_RR;
+}
+
+
+/*
+ * Repeat the conservative difference of the given fluxes and source on the cells of the given box
+ * in the same way as the flux synchronization of the applications.
+ */
+static void
+applyConservativeDifferenceOnBox(
+    pdat::CellData<double>& Q,
+    const pdat::SideData<double>& F,
+    const pdat::CellData<double>& S,
+    const hier::Box& box,
+    const double* const dx)
+{
+    const tbox::Dimension& dim = box.getDim();
+    
+    pdat::CellIterator icend(pdat::CellGeometry::end(box));
+    for (pdat::CellIterator ic(pdat::CellGeometry::begin(box));
+         ic != icend;
+         ic++)
+    {
+        double dQ = S(*ic);
+        
+        for (int di = 0; di < dim.getValue(); di++)
+        {
+            const pdat::SideIndex idx_face_L(*ic, di, pdat::SideIndex::Lower);
+            const pdat::SideIndex idx_face_R(*ic, di, pdat::SideIndex::Upper);
+            
+            dQ -= (F(idx_face_R) - F(idx_face_L))/dx[di];
+        }
+        
+        Q(*ic) += dQ;
+    }
+}
+
+
 int main(int argc, char *argv[])
 {
+    /*
+     * Initialize tbox::MPI and SAMRAI.
+     */
+    
+    tbox::SAMRAI_MPI::init(&argc, &argv);
+    tbox::SAMRAIManager::initialize();
+    tbox::SAMRAIManager::startup();
+    const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
+    
     /*
      * Set the dimension.
      */
@@ -469,5 +641,561 @@ int main(int argc, char *argv[])
     equation_of_mass_diffusivity_mixing_rules_db.reset();
     equation_of_mass_diffusivity_mixing_rules.reset();
     
+    /*
+     * Verify that the Harten wavelet transform is implemented correctly. The wavelet coefficients
+     * and local means of a smooth field are compared with a direct evaluation of the transform on
+     * the interior cells of a patch.
+     */
+    
+    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    
+    hier::Index patch_lo(dim, 0);
+    hier::Index patch_hi(dim, 11);
+    
+    const hier::Box interior_box(patch_lo, patch_hi, hier::BlockId(0));
+    
+    hier::Patch patch(
+        hier::Box(interior_box, hier::LocalId(0), mpi.getRank()),
+        variable_db->getPatchDescriptor());
+    
+    const int Harten_wavelet_num_level = 3;
+    
+    for (int k = 2; k <= 4; k += 2)
+    {
+        WaveletTransformHarten wavelet_transform_Harten(
+            "wavelet_transform_Harten",
+            dim,
+            Harten_wavelet_num_level,
+            k);
+        
+        const hier::IntVector num_wavelet_ghosts =
+            wavelet_transform_Harten.getWaveletTransformNumberOfGhostCells();
+        
+        boost::shared_ptr<pdat::CellData<double> > data_cell(
+            boost::make_shared<pdat::CellData<double> >(interior_box, 1, num_wavelet_ghosts));
+        
+        const hier::Box ghost_box = data_cell->getGhostBox();
+        pdat::CellIterator icend(pdat::CellGeometry::end(ghost_box));
+        for (pdat::CellIterator ic(pdat::CellGeometry::begin(ghost_box));
+             ic != icend;
+             ic++)
+        {
+            const hier::Index idx(*ic);
+            
+            double f = double(1);
+            for (int di = 0; di < dim.getValue(); di++)
+            {
+                f *= double(2) + sin(0.3*double(di + 1)*double(idx[di]) + 0.1*double(di));
+            }
+            
+            (*data_cell)(*ic) = f;
+        }
+        
+        std::vector<boost::shared_ptr<pdat::CellData<double> > > wavelet_coeffs;
+        std::vector<boost::shared_ptr<pdat::CellData<double> > > variable_local_means;
+        for (int li = 0; li < Harten_wavelet_num_level; li++)
+        {
+            wavelet_coeffs.push_back(boost::make_shared<pdat::CellData<double> >(
+                interior_box, 1, num_wavelet_ghosts));
+            
+            variable_local_means.push_back(boost::make_shared<pdat::CellData<double> >(
+                interior_box, 1, num_wavelet_ghosts));
+        }
+        
+        wavelet_transform_Harten.computeWaveletCoefficientsWithVariableLocalMeans(
+            wavelet_coeffs,
+            variable_local_means,
+            data_cell,
+            patch);
+        
+        const double mean_factor = (k == 2) ? double(1)/double(2) : double(1)/double(6);
+        
+        double error = 0.0;
+        
+        pdat::CellIterator icend_interior(pdat::CellGeometry::end(interior_box));
+        for (pdat::CellIterator ic(pdat::CellGeometry::begin(interior_box));
+             ic != icend_interior;
+             ic++)
+        {
+            for (int li = 0; li < Harten_wavelet_num_level; li++)
+            {
+                double w_sq_sum = 0.0;
+                double f_mean_sq_sum = 0.0;
+                
+                for (int di = 0; di < dim.getValue(); di++)
+                {
+                    double w = 0.0;
+                    double f_mean = 0.0;
+                    
+                    computeHartenWaveletCoefficientAndLocalMean(
+                        w,
+                        f_mean,
+                        *data_cell,
+                        *ic,
+                        di,
+                        li,
+                        k);
+                    
+                    w_sq_sum += w*w;
+                    f_mean_sq_sum += f_mean*f_mean;
+                }
+                
+                const double w_ref = sqrt(w_sq_sum);
+                const double f_mean_ref = mean_factor*sqrt(f_mean_sq_sum);
+                
+                error = fmax(error, fabs((*wavelet_coeffs[li])(*ic) - w_ref)/f_mean_ref);
+                error = fmax(error, fabs((*variable_local_means[li])(*ic) - f_mean_ref)/f_mean_ref);
+            }
+        }
+        
+        if (error < 1.0e-12)
+        {
+            std::cout << "WaveletTransformHarten with " << k << " vanishing moments is implemented correctly!"
+                << std::endl;
+        }
+        else
+        {
+            std::cout << "WaveletTransformHarten with " << k << " vanishing moments is not implemented correctly!"
+                << std::endl;
+        }
+    }
+    
+    /*
+     * Verify that the scaling limiter of the side primitive variables is implemented correctly.
+     * Some of the sides are given values out of the bounds of the five-equation model by Allaire et
+     * al. The bounded primitive variables must be within the bounds at all sides after limiting and
+     * the sides that are already within the bounds must not be changed.
+     */
+    
+    boost::shared_ptr<tbox::Database> grid_geometry_db(new tbox::MemoryDatabase("grid_geometry_db"));
+    
+    std::vector<int> domain_lo(dim.getValue(), 0);
+    std::vector<int> domain_hi(dim.getValue(), 11);
+    
+    std::vector<tbox::DatabaseBox> domain_boxes;
+    domain_boxes.push_back(tbox::DatabaseBox(dim, domain_lo.data(), domain_hi.data()));
+    
+    grid_geometry_db->putDatabaseBoxVector("domain_boxes", domain_boxes);
+    grid_geometry_db->putDoubleVector("x_lo", std::vector<double>(dim.getValue(), 0.0));
+    grid_geometry_db->putDoubleVector("x_up", std::vector<double>(dim.getValue(), 1.0));
+    
+    boost::shared_ptr<geom::CartesianGridGeometry> grid_geometry(
+        new geom::CartesianGridGeometry(
+            dim,
+            "CartesianGeometry",
+            grid_geometry_db));
+    
+    boost::shared_ptr<tbox::Database> flow_model_db(new tbox::MemoryDatabase("flow_model_db"));
+    
+    flow_model_db->putString("equation_of_state", "IDEAL_GAS");
+    
+    boost::shared_ptr<tbox::Database> equation_of_state_mixing_rules_db =
+        flow_model_db->putDatabase("Equation_of_state_mixing_rules");
+    
+    std::vector<double> species_gamma;
+    species_gamma.push_back(1.6);
+    species_gamma.push_back(1.4);
+    
+    std::vector<double> species_R;
+    species_R.push_back(1.0);
+    species_R.push_back(1.0);
+    
+    equation_of_state_mixing_rules_db->putDoubleVector("species_gamma", species_gamma);
+    equation_of_state_mixing_rules_db->putDoubleVector("species_R", species_R);
+    
+    boost::shared_ptr<FlowModelManager> flow_model_manager(
+        new FlowModelManager(
+            "flow_model_manager",
+            dim,
+            grid_geometry,
+            2,
+            flow_model_db,
+            "FIVE_EQN_ALLAIRE"));
+    
+    boost::shared_ptr<FlowModel> flow_model = flow_model_manager->getFlowModel();
+    
+    const int num_eqn = flow_model->getNumberOfEquations();
+    
+    std::vector<int> bounded_var_idx;
+    std::vector<double> bounds_lo;
+    std::vector<double> bounds_up;
+    
+    flow_model->getBoundsOfPrimitiveVariables(bounded_var_idx, bounds_lo, bounds_up);
+    
+    const int num_bounded_var = static_cast<int>(bounded_var_idx.size());
+    
+    std::vector<boost::shared_ptr<pdat::CellData<double> > > data_primitive_var;
+    data_primitive_var.push_back(boost::make_shared<pdat::CellData<double> >(
+        interior_box, num_eqn, hier::IntVector::getOne(dim)*2));
+    
+    const hier::Box ghost_box_primitive_var = data_primitive_var[0]->getGhostBox();
+    pdat::CellIterator icend_primitive_var(pdat::CellGeometry::end(ghost_box_primitive_var));
+    for (pdat::CellIterator ic(pdat::CellGeometry::begin(ghost_box_primitive_var));
+         ic != icend_primitive_var;
+         ic++)
+    {
+        const hier::Index idx(*ic);
+        
+        for (int ei = 0; ei < num_eqn; ei++)
+        {
+            double phase = double(ei);
+            for (int di = 0; di < dim.getValue(); di++)
+            {
+                phase += 0.3*double(di + 1)*double(idx[di]);
+            }
+            
+            (*data_primitive_var[0])(*ic, ei) = 0.5 + 0.25*sin(phase);
+        }
+    }
+    
+    std::vector<boost::shared_ptr<pdat::SideData<double> > > data_primitive_var_minus;
+    std::vector<boost::shared_ptr<pdat::SideData<double> > > data_primitive_var_plus;
+    for (int ei = 0; ei < num_eqn; ei++)
+    {
+        data_primitive_var_minus.push_back(boost::make_shared<pdat::SideData<double> >(
+            interior_box, 1, hier::IntVector::getOne(dim)));
+        
+        data_primitive_var_plus.push_back(boost::make_shared<pdat::SideData<double> >(
+            interior_box, 1, hier::IntVector::getOne(dim)));
+    }
+    
+    /*
+     * Set the side data at the limited sides in the first pass and check it after limiting in the
+     * second pass. The limited sides are the interior sides and the sides of the first ghost cells
+     * in the direction normal to the sides. Every third side is out of the bounds in one of the
+     * bounded primitive variables.
+     */
+    
+    for (int pass = 0; pass < 2; pass++)
+    {
+        int side_count = 0;
+        
+        bool is_bounded = true;
+        bool is_unchanged = true;
+        
+        for (int di = 0; di < dim.getValue(); di++)
+        {
+            hier::Index limited_lo(patch_lo);
+            hier::Index limited_hi(patch_hi);
+            limited_lo[di] -= 1;
+            limited_hi[di] += 1;
+            
+            const hier::Box limited_box(limited_lo, limited_hi, hier::BlockId(0));
+            
+            pdat::SideIterator isend(pdat::SideGeometry::end(limited_box, di));
+            for (pdat::SideIterator is(pdat::SideGeometry::begin(limited_box, di));
+                 is != isend;
+                 is++)
+            {
+                const pdat::SideIndex idx_side(*is);
+                
+                const pdat::CellIndex idx_cell_L(idx_side.toCell(pdat::SideIndex::Lower));
+                const pdat::CellIndex idx_cell_R(idx_side.toCell(pdat::SideIndex::Upper));
+                
+                const bool is_out_of_bounds = (side_count % 3 == 0);
+                const int bi_out_of_bounds = (side_count/3) % num_bounded_var;
+                
+                side_count++;
+                
+                for (int ei = 0; ei < num_eqn; ei++)
+                {
+                    double V_minus = 1.01*(*data_primitive_var[0])(idx_cell_L, ei);
+                    double V_plus = 0.99*(*data_primitive_var[0])(idx_cell_R, ei);
+                    
+                    if (is_out_of_bounds && ei == bounded_var_idx[bi_out_of_bounds])
+                    {
+                        if (bounds_up[bi_out_of_bounds] < std::numeric_limits<double>::max())
+                        {
+                            V_minus = bounds_up[bi_out_of_bounds] + 1.0;
+                            V_plus = bounds_up[bi_out_of_bounds] + 1.0;
+                        }
+                        else
+                        {
+                            V_minus = bounds_lo[bi_out_of_bounds] - 1.0;
+                            V_plus = bounds_lo[bi_out_of_bounds] - 1.0;
+                        }
+                    }
+                    
+                    if (pass == 0)
+                    {
+                        (*data_primitive_var_minus[ei])(idx_side) = V_minus;
+                        (*data_primitive_var_plus[ei])(idx_side) = V_plus;
+                    }
+                    else if (!is_out_of_bounds)
+                    {
+                        if (fabs((*data_primitive_var_minus[ei])(idx_side) - V_minus) > 1.0e-12 ||
+                            fabs((*data_primitive_var_plus[ei])(idx_side) - V_plus) > 1.0e-12)
+                        {
+                            is_unchanged = false;
+                        }
+                    }
+                }
+                
+                if (pass == 1)
+                {
+                    for (int bi = 0; bi < num_bounded_var; bi++)
+                    {
+                        const int ei = bounded_var_idx[bi];
+                        
+                        const double V_minus = (*data_primitive_var_minus[ei])(idx_side);
+                        const double V_plus = (*data_primitive_var_plus[ei])(idx_side);
+                        
+                        if (!(V_minus > bounds_lo[bi] && V_minus < bounds_up[bi]) ||
+                            !(V_plus > bounds_lo[bi] && V_plus < bounds_up[bi]))
+                        {
+                            is_bounded = false;
+                        }
+                    }
+                }
+            }
+        }
+        
+        if (pass == 0)
+        {
+            flow_model->limitGlobalSideDataPrimitiveVariables(
+                data_primitive_var_minus,
+                data_primitive_var_plus,
+                data_primitive_var);
+        }
+        else if (is_bounded && is_unchanged)
+        {
+            std::cout << "FlowModel::limitGlobalSideDataPrimitiveVariables() is implemented correctly!"
+                << std::endl;
+        }
+        else
+        {
+            std::cout << "FlowModel::limitGlobalSideDataPrimitiveVariables() is not implemented correctly!"
+                << std::endl;
+        }
+    }
+    
+    flow_model.reset();
+    flow_model_manager.reset();
+    grid_geometry.reset();
+    
+    /*
+     * Verify that the fused MPI reductions are implemented correctly by comparing them with
+     * separate reductions of the same values. The maxima, minima and sums are added in an
+     * interleaved order and the local values differ between the processes.
+     */
+    
+    const int num_reduced_values = 12;
+    
+    std::vector<double> global_values;
+    std::vector<int> value_idx;
+    global_values.reserve(num_reduced_values);
+    value_idx.reserve(num_reduced_values);
+    
+    FusedMPIReduction reduction(mpi);
+    
+    for (int vi = 0; vi < num_reduced_values; vi++)
+    {
+        const double value = pow(10.0, double(vi % 4))*sin(double(mpi.getRank() + 1) + double(vi));
+        
+        double global_value = value;
+        
+        if (vi % 3 == 0)
+        {
+            value_idx.push_back(reduction.addMax(value));
+            mpi.AllReduce(&global_value, 1, MPI_MAX);
+        }
+        else if (vi % 3 == 1)
+        {
+            value_idx.push_back(reduction.addMin(value));
+            mpi.AllReduce(&global_value, 1, MPI_MIN);
+        }
+        else
+        {
+            value_idx.push_back(reduction.addSum(value));
+            mpi.AllReduce(&global_value, 1, MPI_SUM);
+        }
+        
+        global_values.push_back(global_value);
+    }
+    
+    reduction.post();
+    reduction.complete();
+    
+    bool is_reduction_correct = true;
+    
+    for (int vi = 0; vi < num_reduced_values; vi++)
+    {
+        const double value = reduction.getValue(value_idx[vi]);
+        
+        if (vi % 3 == 2)
+        {
+            if (fabs(value - global_values[vi]) > 1.0e-12*fmax(fabs(global_values[vi]), 1.0))
+            {
+                is_reduction_correct = false;
+            }
+        }
+        else if (value != global_values[vi])
+        {
+            is_reduction_correct = false;
+        }
+    }
+    
+    if (is_reduction_correct)
+    {
+        std::cout << "FusedMPIReduction is implemented correctly!" << std::endl;
+    }
+    else
+    {
+        std::cout << "FusedMPIReduction is not implemented correctly!" << std::endl;
+    }
+    
+    /*
+     * Verify that the sparse refluxing is implemented correctly. The conservative difference with
+     * the corrected fluxes is repeated on the reflux boxes of a coarse patch next to the footprint
+     * of several fine patches. The result must be the same as repeating it on the whole patch on
+     * all the cells not covered by the footprint, which are the cells that are not overwritten by
+     * the coarsened fine data.
+     */
+    
+    hier::BoxContainer fine_footprint;
+    fine_footprint.pushBack(hier::Box(hier::Index(dim, 2), hier::Index(dim, 5), hier::BlockId(0)));
+    
+    hier::Index fine_lo(dim, 2);
+    hier::Index fine_hi(dim, 5);
+    fine_lo[0] = 6;
+    fine_hi[0] = 8;
+    fine_hi[1] = 7;
+    fine_footprint.pushBack(hier::Box(fine_lo, fine_hi, hier::BlockId(0)));
+    
+    fine_footprint.pushBack(hier::Box(hier::Index(dim, 10), hier::Index(dim, 13), hier::BlockId(0)));
+    
+    hier::BoxContainer reflux_boxes;
+    
+    RungeKuttaLevelIntegrator::computePatchRefluxBoxes(
+        reflux_boxes,
+        interior_box,
+        fine_footprint);
+    
+    const std::vector<double> dx(dim.getValue(), 0.1);
+    
+    pdat::CellData<double> data_current(interior_box, 1, hier::IntVector::getZero(dim));
+    pdat::CellData<double> data_source(interior_box, 1, hier::IntVector::getZero(dim));
+    pdat::SideData<double> data_flux(interior_box, 1, hier::IntVector::getZero(dim));
+    
+    pdat::CellIterator icend_reflux(pdat::CellGeometry::end(interior_box));
+    for (pdat::CellIterator ic(pdat::CellGeometry::begin(interior_box));
+         ic != icend_reflux;
+         ic++)
+    {
+        const hier::Index idx(*ic);
+        
+        data_current(*ic) = 1.0 + 0.5*sin(0.3*double(idx[0]) + 0.2*double(idx[1]) + 0.1*double(idx[2]));
+        data_source(*ic) = 0.01*cos(0.1*double(idx[0]) + 0.2*double(idx[1]) + 0.3*double(idx[2]));
+    }
+    
+    for (int di = 0; di < dim.getValue(); di++)
+    {
+        pdat::SideIterator isend(pdat::SideGeometry::end(interior_box, di));
+        for (pdat::SideIterator is(pdat::SideGeometry::begin(interior_box, di));
+             is != isend;
+             is++)
+        {
+            const hier::Index idx(*is);
+            
+            data_flux(*is) = 0.1*sin(0.2*double(idx[0]) + 0.3*double(idx[1]) + 0.4*double(idx[2]) + double(di));
+        }
+    }
+    
+    /*
+     * Advance the data with the uncorrected fluxes and then correct the fluxes at the faces of the
+     * cells covered by the footprint.
+     */
+    
+    pdat::CellData<double> data_new(interior_box, 1, hier::IntVector::getZero(dim));
+    data_new.copy(data_current);
+    
+    applyConservativeDifferenceOnBox(data_new, data_flux, data_source, interior_box, dx.data());
+    
+    for (hier::BoxContainer::const_iterator ib(fine_footprint.begin());
+         ib != fine_footprint.end();
+         ib++)
+    {
+        const hier::Box footprint_box((*ib)*interior_box);
+        
+        for (int di = 0; di < dim.getValue(); di++)
+        {
+            pdat::SideIterator isend(pdat::SideGeometry::end(footprint_box, di));
+            for (pdat::SideIterator is(pdat::SideGeometry::begin(footprint_box, di));
+                 is != isend;
+                 is++)
+            {
+                const hier::Index idx(*is);
+                
+                data_flux(*is) = 0.1*cos(0.4*double(idx[0]) + 0.3*double(idx[1]) + 0.2*double(idx[2]) + double(di));
+            }
+        }
+    }
+    
+    /*
+     * Dense refluxing: repeat the conservative difference on the whole patch.
+     */
+    
+    pdat::CellData<double> data_dense(interior_box, 1, hier::IntVector::getZero(dim));
+    data_dense.copy(data_current);
+    
+    applyConservativeDifferenceOnBox(data_dense, data_flux, data_source, interior_box, dx.data());
+    
+    /*
+     * Sparse refluxing: copy the current data on the reflux boxes and repeat the conservative
+     * difference on each of them in the same way as the level integrator.
+     */
+    
+    pdat::CellData<double> data_sparse(interior_box, 1, hier::IntVector::getZero(dim));
+    data_sparse.copy(data_new);
+    
+    for (hier::BoxContainer::const_iterator ib(reflux_boxes.begin());
+         ib != reflux_boxes.end();
+         ib++)
+    {
+        data_sparse.getArrayData().copy(data_current.getArrayData(), *ib);
+    }
+    
+    for (hier::BoxContainer::const_iterator ib(reflux_boxes.begin());
+         ib != reflux_boxes.end();
+         ib++)
+    {
+        applyConservativeDifferenceOnBox(data_sparse, data_flux, data_source, *ib, dx.data());
+    }
+    
+    hier::BoxContainer uncovered_boxes(interior_box);
+    uncovered_boxes.removeIntersections(fine_footprint);
+    
+    double error_reflux = 0.0;
+    double change_reflux = 0.0;
+    
+    for (hier::BoxContainer::const_iterator ib(uncovered_boxes.begin());
+         ib != uncovered_boxes.end();
+         ib++)
+    {
+        pdat::CellIterator icend_uncovered(pdat::CellGeometry::end(*ib));
+        for (pdat::CellIterator ic(pdat::CellGeometry::begin(*ib));
+             ic != icend_uncovered;
+             ic++)
+        {
+            error_reflux = fmax(error_reflux, fabs(data_sparse(*ic) - data_dense(*ic)));
+            change_reflux = fmax(change_reflux, fabs(data_dense(*ic) - data_new(*ic)));
+        }
+    }
+    
+    if (error_reflux < 1.0e-12 && change_reflux > 1.0e-3)
+    {
+        std::cout << "RungeKuttaLevelIntegrator::computePatchRefluxBoxes() is implemented correctly!"
+            << std::endl;
+    }
+    else
+    {
+        std::cout << "RungeKuttaLevelIntegrator::computePatchRefluxBoxes() is not implemented correctly!"
+            << std::endl;
+    }
+    
+    tbox::SAMRAIManager::shutdown();
+    tbox::SAMRAIManager::finalize();
+    tbox::SAMRAI_MPI::finalize();
+    
     return 0;
 }
@@ -0,0 +1,1011 @@
+#include "extn/data_probes/DataProbes.hpp"
+
+#include "extn/patch_hierarchies/ExtendedFlattenedHierarchy.hpp"
+
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/BoxContainer.h"
+#include "SAMRAI/hier/VariableDatabase.h"
+#include "SAMRAI/pdat/CellData.h"
+#include "SAMRAI/pdat/CellGeometry.h"
+#include "SAMRAI/pdat/CellIndex.h"
+#include "SAMRAI/pdat/CellIterator.h"
+#include "SAMRAI/pdat/CellVariable.h"
+#include "SAMRAI/tbox/TimerManager.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+boost::shared_ptr<tbox::Timer> DataProbes::t_sample_data;
+boost::shared_ptr<tbox::Timer> DataProbes::t_setup_probe_cells;
+boost::shared_ptr<tbox::Timer> DataProbes::t_flush_data;
+
+/*
+ * Count the number of patches sharing a visible cell, which is one plus the number of overlapped
+ * visible boxes of a patch containing the cell.
+ */
+static int
+getNumberOfOverlaps(
+    const hier::BoxContainer& overlapped_visible_boxes,
+    const hier::Index& cell_index)
+{
+    int num_overlaps = 1;
+    
+    for (hier::BoxContainer::BoxContainerConstIterator iob(overlapped_visible_boxes.begin());
+         iob != overlapped_visible_boxes.end();
+         iob++)
+    {
+        if (iob->contains(cell_index))
+        {
+            num_overlaps++;
+        }
+    }
+    
+    return num_overlaps;
+}
+
+
+DataProbes::DataProbes(
+    const std::string& object_name,
+    const tbox::Dimension& dim,
+    const boost::shared_ptr<tbox::Database>& input_db,
+    const boost::shared_ptr<geom::CartesianGridGeometry>& grid_geometry,
+    const boost::shared_ptr<hier::VariableContext>& data_context):
+        d_object_name(object_name),
+        d_dim(dim),
+        d_grid_geometry(grid_geometry),
+        d_mpi(tbox::SAMRAI_MPI::getSAMRAIWorld()),
+        d_probe_dirname("probes"),
+        d_sample_interval(1),
+        d_buffer_size(1000),
+        d_num_components(0),
+        d_sample_buffer_size(0)
+{
+    TBOX_ASSERT(!object_name.empty());
+    TBOX_ASSERT(input_db);
+    TBOX_ASSERT(grid_geometry);
+    TBOX_ASSERT(data_context);
+    
+    getFromInput(input_db);
+    
+    /*
+     * Get the patch data indices of the variables in the data context.
+     */
+    
+    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    
+    for (int vi = 0; vi < static_cast<int>(d_variable_names.size()); vi++)
+    {
+        boost::shared_ptr<pdat::CellVariable<double> > variable(
+            boost::dynamic_pointer_cast<pdat::CellVariable<double> >(
+                variable_db->getVariable(d_variable_names[vi])));
+        
+        if (!variable)
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "Variable '"
+                << d_variable_names[vi]
+                << "' is not a registered cell variable of double."
+                << std::endl);
+        }
+        
+        const int data_id = variable_db->mapVariableAndContextToIndex(variable, data_context);
+        
+        if (data_id < 0)
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "Variable '"
+                << d_variable_names[vi]
+                << "' has no patch data in context '"
+                << data_context->getName()
+                << "'."
+                << std::endl);
+        }
+        
+        d_variable_depths.push_back(variable->getDepth());
+        d_data_ids.push_back(data_id);
+        d_num_components += variable->getDepth();
+    }
+    
+    /*
+     * Get the offsets of the samples of the probes in the sample buffer.
+     */
+    
+    for (int pi = 0; pi < static_cast<int>(d_probe_names.size()); pi++)
+    {
+        d_probe_sample_offsets.push_back(d_sample_buffer_size);
+        d_sample_buffer_size += d_probe_num_samples[pi]*d_num_components;
+    }
+    
+    tbox::Utilities::recursiveMkdir(d_probe_dirname);
+    
+    if (d_mpi.getRank() == 0)
+    {
+        writeFileHeaders();
+    }
+    
+    if (!t_sample_data)
+    {
+        t_sample_data = tbox::TimerManager::getManager()->
+            getTimer("DataProbes::sampleData()");
+        t_setup_probe_cells = tbox::TimerManager::getManager()->
+            getTimer("DataProbes::setupProbeCells()");
+        t_flush_data = tbox::TimerManager::getManager()->
+            getTimer("DataProbes::flushData()");
+    }
+}
+
+
+DataProbes::~DataProbes()
+{
+    flushData();
+    
+    t_sample_data.reset();
+    t_setup_probe_cells.reset();
+    t_flush_data.reset();
+}
+
+
+/*
+ * Sample the data of all the probes if the step number is a multiple of the sample interval.
+ */
+void
+DataProbes::sampleData(
+    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+    const int step_num,
+    const double time)
+{
+    TBOX_ASSERT(patch_hierarchy);
+    
+    if ((step_num % d_sample_interval) != 0 || d_sample_buffer_size == 0)
+    {
+        return;
+    }
+    
+    t_sample_data->start();
+    
+    /*
+     * The probe cells are looked up again only after the hierarchy is regridded.
+     */
+    if (!isProbeCellsUpToDate(patch_hierarchy))
+    {
+        setupProbeCells(patch_hierarchy);
+    }
+    
+    std::vector<double> samples_local(d_sample_buffer_size, 0.0);
+    
+    for (int ln = 0; ln < patch_hierarchy->getNumberOfLevels(); ln++)
+    {
+        const boost::shared_ptr<hier::PatchLevel> level(patch_hierarchy->getPatchLevel(ln));
+        
+        for (hier::PatchLevel::iterator ip(level->begin());
+             ip != level->end();
+             ip++)
+        {
+            const boost::shared_ptr<hier::Patch> patch = *ip;
+            
+            std::map<hier::BoxId, std::vector<probeCellStruct> >::const_iterator it_probe_cells =
+                d_probe_cells[ln].find(patch->getBox().getBoxId());
+            
+            if (it_probe_cells == d_probe_cells[ln].end())
+            {
+                continue;
+            }
+            
+            const std::vector<probeCellStruct>& probe_cells = it_probe_cells->second;
+            
+            int component_offset = 0;
+            
+            for (int vi = 0; vi < static_cast<int>(d_data_ids.size()); vi++)
+            {
+                boost::shared_ptr<pdat::CellData<double> > data(
+                    BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                        patch->getPatchData(d_data_ids[vi])));
+                TBOX_ASSERT(data);
+                
+                const int depth = d_variable_depths[vi];
+                
+                for (int ci = 0; ci < static_cast<int>(probe_cells.size()); ci++)
+                {
+                    const pdat::CellIndex cell_index(probe_cells[ci].cell_index);
+                    const double weight = probe_cells[ci].weight;
+                    
+                    double* sample =
+                        &samples_local[probe_cells[ci].sample_offset + component_offset];
+                    
+                    for (int di = 0; di < depth; di++)
+                    {
+                        sample[di] += weight*(*data)(cell_index, di);
+                    }
+                }
+                
+                component_offset += depth;
+            }
+        }
+    }
+    
+    /*
+     * Each probe point is sampled by a single process and the integrals are summed over all
+     * processes, so the samples of all the probes are summed to the first process together.
+     */
+    
+    std::vector<double> samples_global(d_sample_buffer_size, 0.0);
+    
+    d_mpi.Reduce(
+        &samples_local[0],
+        &samples_global[0],
+        d_sample_buffer_size,
+        MPI_DOUBLE,
+        MPI_SUM,
+        0);
+    
+    if (d_mpi.getRank() == 0)
+    {
+        d_buffered_times.push_back(time);
+        d_buffered_samples.insert(
+            d_buffered_samples.end(),
+            samples_global.begin(),
+            samples_global.end());
+    }
+    
+    t_sample_data->stop();
+    
+    if (static_cast<int>(d_buffered_times.size()) >= d_buffer_size)
+    {
+        flushData();
+    }
+}
+
+
+/*
+ * Append the buffered samples to the files of the probes.
+ */
+void
+DataProbes::flushData()
+{
+    if (d_buffered_times.empty())
+    {
+        return;
+    }
+    
+    t_flush_data->start();
+    
+    const int num_records = static_cast<int>(d_buffered_times.size());
+    
+    for (int pi = 0; pi < static_cast<int>(d_probe_names.size()); pi++)
+    {
+        std::ofstream f_out;
+        f_out.open(getProbeFilename(pi).c_str(), std::ios::app);
+        
+        if (!f_out.is_open())
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "Failed to open file to output data of probe '"
+                << d_probe_names[pi]
+                << "'!"
+                << std::endl);
+        }
+        
+        f_out << std::scientific << std::setprecision(std::numeric_limits<double>::digits10);
+        
+        const int num_values = d_probe_num_samples[pi]*d_num_components;
+        
+        for (int ri = 0; ri < num_records; ri++)
+        {
+            const double* values =
+                &d_buffered_samples[ri*d_sample_buffer_size + d_probe_sample_offsets[pi]];
+            
+            f_out << d_buffered_times[ri];
+            for (int vi = 0; vi < num_values; vi++)
+            {
+                f_out << " " << values[vi];
+            }
+            f_out << "\n";
+        }
+        
+        f_out.close();
+    }
+    
+    d_buffered_times.clear();
+    d_buffered_samples.clear();
+    
+    t_flush_data->stop();
+}
+
+
+/*
+ * Print all characteristics of the data probes.
+ */
+void
+DataProbes::printClassData(std::ostream& os) const
+{
+    os << "\nPrint DataProbes object..."
+       << std::endl;
+    
+    os << std::endl;
+    
+    os << "DataProbes: this = "
+       << (DataProbes *)this
+       << std::endl;
+    
+    os << "d_object_name = "
+       << d_object_name
+       << std::endl;
+    
+    os << "d_probe_dirname = "
+       << d_probe_dirname
+       << std::endl;
+    
+    os << "d_sample_interval = "
+       << d_sample_interval
+       << std::endl;
+    
+    os << "d_buffer_size = "
+       << d_buffer_size
+       << std::endl;
+    
+    os << "d_variable_names = ";
+    for (int vi = 0; vi < static_cast<int>(d_variable_names.size()); vi++)
+    {
+        os << "\"" << d_variable_names[vi] << "\"";
+        if (vi < static_cast<int>(d_variable_names.size()) - 1)
+        {
+            os << ", ";
+        }
+    }
+    os << std::endl;
+    
+    os << "d_probe_names = ";
+    for (int pi = 0; pi < static_cast<int>(d_probe_names.size()); pi++)
+    {
+        os << "\"" << d_probe_names[pi] << "\"";
+        if (pi < static_cast<int>(d_probe_names.size()) - 1)
+        {
+            os << ", ";
+        }
+    }
+    os << std::endl;
+}
+
+
+/*
+ * Read the probes from the input database.
+ */
+void
+DataProbes::getFromInput(const boost::shared_ptr<tbox::Database>& input_db)
+{
+    d_probe_dirname = input_db->getStringWithDefault("probe_dirname", "probes");
+    
+    d_sample_interval = input_db->getIntegerWithDefault("sample_interval", 1);
+    
+    if (d_sample_interval <= 0)
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "'sample_interval' should be positive."
+            << std::endl);
+    }
+    
+    d_buffer_size = input_db->getIntegerWithDefault("buffer_size", 1000);
+    
+    if (d_buffer_size <= 0)
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "'buffer_size' should be positive."
+            << std::endl);
+    }
+    
+    if (input_db->keyExists("variables"))
+    {
+        d_variable_names = input_db->getStringVector("variables");
+    }
+    else
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "Key data 'variables' not found in input."
+            << std::endl);
+    }
+    
+    const double* x_lo = d_grid_geometry->getXLower();
+    const double* x_hi = d_grid_geometry->getXUpper();
+    
+    const std::vector<std::string> probe_keys = input_db->getAllKeys();
+    
+    for (int ki = 0; ki < static_cast<int>(probe_keys.size()); ki++)
+    {
+        const std::string& probe_name = probe_keys[ki];
+        
+        if (!input_db->isDatabase(probe_name))
+        {
+            continue;
+        }
+        
+        boost::shared_ptr<tbox::Database> probe_db(input_db->getDatabase(probe_name));
+        
+        if (!probe_db->keyExists("type"))
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "Key data 'type' not found in input of probe '"
+                << probe_name
+                << "'."
+                << std::endl);
+        }
+        
+        const std::string probe_type_str = probe_db->getString("type");
+        
+        DATA_PROBE::TYPE probe_type = DATA_PROBE::POINT;
+        std::vector<std::vector<double> > probe_points;
+        int normal_direction = 0;
+        double coordinate = 0.0;
+        
+        if (probe_type_str == "POINT")
+        {
+            probe_type = DATA_PROBE::POINT;
+            
+            probe_points.push_back(getCoordinatesFromInput(probe_db, probe_name, "point"));
+        }
+        else if (probe_type_str == "LINE")
+        {
+            probe_type = DATA_PROBE::LINE;
+            
+            const std::vector<double> start_point =
+                getCoordinatesFromInput(probe_db, probe_name, "start_point");
+            
+            const std::vector<double> end_point =
+                getCoordinatesFromInput(probe_db, probe_name, "end_point");
+            
+            const int num_points = probe_db->getInteger("number_of_points");
+            
+            if (num_points < 2)
+            {
+                TBOX_ERROR(d_object_name
+                    << ": "
+                    << "'number_of_points' of probe '"
+                    << probe_name
+                    << "' should be at least 2."
+                    << std::endl);
+            }
+            
+            for (int i = 0; i < num_points; i++)
+            {
+                const double s = double(i)/double(num_points - 1);
+                
+                std::vector<double> point(d_dim.getValue());
+                for (int di = 0; di < d_dim.getValue(); di++)
+                {
+                    point[di] = start_point[di] + s*(end_point[di] - start_point[di]);
+                }
+                
+                probe_points.push_back(point);
+            }
+        }
+        else if (probe_type_str == "PLANE")
+        {
+            probe_type = DATA_PROBE::PLANE;
+            
+            if (d_dim == tbox::Dimension(1))
+            {
+                TBOX_ERROR(d_object_name
+                    << ": "
+                    << "Probe '"
+                    << probe_name
+                    << "' of type 'PLANE' cannot be used for one-dimensional problems."
+                    << std::endl);
+            }
+            
+            const std::vector<double> corner_point =
+                getCoordinatesFromInput(probe_db, probe_name, "corner_point");
+            
+            const std::vector<double> first_edge =
+                getCoordinatesFromInput(probe_db, probe_name, "first_edge");
+            
+            const std::vector<double> second_edge =
+                getCoordinatesFromInput(probe_db, probe_name, "second_edge");
+            
+            const std::vector<int> num_points = probe_db->getIntegerVector("number_of_points");
+            
+            if (static_cast<int>(num_points.size()) != 2 || num_points[0] < 2 || num_points[1] < 2)
+            {
+                TBOX_ERROR(d_object_name
+                    << ": "
+                    << "'number_of_points' of probe '"
+                    << probe_name
+                    << "' should be two numbers that are at least 2."
+                    << std::endl);
+            }
+            
+            for (int j = 0; j < num_points[1]; j++)
+            {
+                const double t = double(j)/double(num_points[1] - 1);
+                
+                for (int i = 0; i < num_points[0]; i++)
+                {
+                    const double s = double(i)/double(num_points[0] - 1);
+                    
+                    std::vector<double> point(d_dim.getValue());
+                    for (int di = 0; di < d_dim.getValue(); di++)
+                    {
+                        point[di] = corner_point[di] + s*first_edge[di] + t*second_edge[di];
+                    }
+                    
+                    probe_points.push_back(point);
+                }
+            }
+        }
+        else if (probe_type_str == "SURFACE_INTEGRAL")
+        {
+            probe_type = DATA_PROBE::SURFACE_INTEGRAL;
+            
+            normal_direction = probe_db->getInteger("normal_direction");
+            
+            if (normal_direction < 0 || normal_direction >= d_dim.getValue())
+            {
+                TBOX_ERROR(d_object_name
+                    << ": "
+                    << "'normal_direction' of probe '"
+                    << probe_name
+                    << "' should be between 0 and "
+                    << d_dim.getValue() - 1
+                    << "."
+                    << std::endl);
+            }
+            
+            coordinate = probe_db->getDouble("coordinate");
+            
+            if (coordinate < x_lo[normal_direction] || coordinate > x_hi[normal_direction])
+            {
+                TBOX_ERROR(d_object_name
+                    << ": "
+                    << "The plane of probe '"
+                    << probe_name
+                    << "' is outside the physical domain."
+                    << std::endl);
+            }
+        }
+        else
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "Unknown type '"
+                << probe_type_str
+                << "' of probe '"
+                << probe_name
+                << "'."
+                << std::endl);
+        }
+        
+        for (int si = 0; si < static_cast<int>(probe_points.size()); si++)
+        {
+            for (int di = 0; di < d_dim.getValue(); di++)
+            {
+                if (probe_points[si][di] < x_lo[di] || probe_points[si][di] > x_hi[di])
+                {
+                    TBOX_ERROR(d_object_name
+                        << ": "
+                        << "Probe '"
+                        << probe_name
+                        << "' has points outside the physical domain."
+                        << std::endl);
+                }
+            }
+        }
+        
+        d_probe_names.push_back(probe_name);
+        d_probe_types.push_back(probe_type);
+        d_probe_points.push_back(probe_points);
+        d_probe_normal_directions.push_back(normal_direction);
+        d_probe_coordinates.push_back(coordinate);
+        
+        if (probe_type == DATA_PROBE::SURFACE_INTEGRAL)
+        {
+            d_probe_num_samples.push_back(1);
+        }
+        else
+        {
+            d_probe_num_samples.push_back(static_cast<int>(probe_points.size()));
+        }
+    }
+    
+    if (d_probe_names.empty())
+    {
+        TBOX_WARNING(d_object_name
+            << ": "
+            << "No probes are found in input."
+            << std::endl);
+    }
+}
+
+
+/*
+ * Read the coordinates of a point or the components of a vector of a probe from the input
+ * database.
+ */
+std::vector<double>
+DataProbes::getCoordinatesFromInput(
+    const boost::shared_ptr<tbox::Database>& probe_db,
+    const std::string& probe_name,
+    const std::string& key) const
+{
+    if (!probe_db->keyExists(key))
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "Key data '"
+            << key
+            << "' not found in input of probe '"
+            << probe_name
+            << "'."
+            << std::endl);
+    }
+    
+    const std::vector<double> coordinates = probe_db->getDoubleVector(key);
+    
+    if (static_cast<int>(coordinates.size()) != d_dim.getValue())
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "'"
+            << key
+            << "' of probe '"
+            << probe_name
+            << "' should have "
+            << d_dim.getValue()
+            << " components."
+            << std::endl);
+    }
+    
+    return coordinates;
+}
+
+
+/*
+ * Get the name of the file of a probe.
+ */
+std::string
+DataProbes::getProbeFilename(const int probe_index) const
+{
+    return d_probe_dirname + "/" + d_probe_names[probe_index] + ".dat";
+}
+
+
+/*
+ * Write the headers describing the columns to the files of the probes. The headers are appended
+ * so that the data of the previous runs of a restarted simulation is kept.
+ */
+void
+DataProbes::writeFileHeaders() const
+{
+    for (int pi = 0; pi < static_cast<int>(d_probe_names.size()); pi++)
+    {
+        std::ofstream f_out;
+        f_out.open(getProbeFilename(pi).c_str(), std::ios::app);
+        
+        if (!f_out.is_open())
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "Failed to open file to output data of probe '"
+                << d_probe_names[pi]
+                << "'!"
+                << std::endl);
+        }
+        
+        f_out << std::scientific << std::setprecision(std::numeric_limits<double>::digits10);
+        
+        f_out << "# Probe '" << d_probe_names[pi] << "' of type ";
+        switch (d_probe_types[pi])
+        {
+            case DATA_PROBE::POINT:
+            {
+                f_out << "POINT";
+                break;
+            }
+            case DATA_PROBE::LINE:
+            {
+                f_out << "LINE";
+                break;
+            }
+            case DATA_PROBE::PLANE:
+            {
+                f_out << "PLANE";
+                break;
+            }
+            case DATA_PROBE::SURFACE_INTEGRAL:
+            {
+                f_out << "SURFACE_INTEGRAL";
+                break;
+            }
+        }
+        f_out << "\n";
+        
+        f_out << "# Components of the variables:";
+        for (int vi = 0; vi < static_cast<int>(d_variable_names.size()); vi++)
+        {
+            for (int di = 0; di < d_variable_depths[vi]; di++)
+            {
+                f_out << " '" << d_variable_names[vi];
+                if (d_variable_depths[vi] > 1)
+                {
+                    f_out << " " << di;
+                }
+                f_out << "'";
+            }
+        }
+        f_out << "\n";
+        
+        if (d_probe_types[pi] == DATA_PROBE::SURFACE_INTEGRAL)
+        {
+            f_out << "# Columns: time, integrals of the components over the plane normal to"
+                  << " direction " << d_probe_normal_directions[pi]
+                  << " at " << d_probe_coordinates[pi] << "\n";
+        }
+        else
+        {
+            f_out << "# Columns: time, components at each of the following points\n";
+            
+            for (int si = 0; si < d_probe_num_samples[pi]; si++)
+            {
+                f_out << "# Point " << si << ":";
+                for (int di = 0; di < d_dim.getValue(); di++)
+                {
+                    f_out << " " << d_probe_points[pi][si][di];
+                }
+                f_out << "\n";
+            }
+        }
+        
+        f_out.close();
+    }
+}
+
+
+/*
+ * Check whether the levels of the hierarchy are the ones of the looked up probe cells. A level
+ * that is regridded is a new level object, so the weak pointer to the old level either expires or
+ * points to a different level.
+ */
+bool
+DataProbes::isProbeCellsUpToDate(
+    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy) const
+{
+    const int num_levels = patch_hierarchy->getNumberOfLevels();
+    
+    if (static_cast<int>(d_probe_cell_levels.size()) != num_levels)
+    {
+        return false;
+    }
+    
+    for (int ln = 0; ln < num_levels; ln++)
+    {
+        if (d_probe_cell_levels[ln].lock() != patch_hierarchy->getPatchLevel(ln))
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+
+/*
+ * Look up the cells of the local patches sampled by the probes and their weights. Only the cells
+ * visible in the flattened hierarchy are used, so each location is sampled on the finest level
+ * covering it. The weights of the cells shared by several patches are divided by the number of
+ * patches sharing them.
+ */
+void
+DataProbes::setupProbeCells(
+    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy)
+{
+    t_setup_probe_cells->start();
+    
+    const int num_levels = patch_hierarchy->getNumberOfLevels();
+    const int num_probes = static_cast<int>(d_probe_names.size());
+    
+    d_probe_cells.clear();
+    d_probe_cells.resize(num_levels);
+    
+    d_probe_cell_levels.clear();
+    d_probe_cell_levels.resize(num_levels);
+    
+    ExtendedFlattenedHierarchy flattened_hierarchy(*patch_hierarchy, 0, num_levels - 1);
+    
+    const double* x_lo = d_grid_geometry->getXLower();
+    const double* dx = d_grid_geometry->getDx();
+    
+    for (int ln = 0; ln < num_levels; ln++)
+    {
+        const boost::shared_ptr<hier::PatchLevel> level(patch_hierarchy->getPatchLevel(ln));
+        
+        d_probe_cell_levels[ln] = level;
+        
+        const hier::IntVector& ratio_to_level_zero = level->getRatioToLevelZero();
+        
+        /*
+         * Get the cell indices of the points of the probes and the indices of the planes of the
+         * surface integrals on the level.
+         */
+        
+        std::vector<std::vector<hier::Index> > probe_point_indices(num_probes);
+        std::vector<int> probe_plane_indices(num_probes, 0);
+        
+        for (int pi = 0; pi < num_probes; pi++)
+        {
+            if (d_probe_types[pi] == DATA_PROBE::SURFACE_INTEGRAL)
+            {
+                const int normal_direction = d_probe_normal_directions[pi];
+                
+                std::vector<double> point(x_lo, x_lo + d_dim.getValue());
+                point[normal_direction] = d_probe_coordinates[pi];
+                
+                probe_plane_indices[pi] =
+                    getCellIndexOfPoint(point, ratio_to_level_zero)[normal_direction];
+            }
+            else
+            {
+                for (int si = 0; si < d_probe_num_samples[pi]; si++)
+                {
+                    probe_point_indices[pi].push_back(
+                        getCellIndexOfPoint(d_probe_points[pi][si], ratio_to_level_zero));
+                }
+            }
+        }
+        
+        for (hier::PatchLevel::iterator ip(level->begin());
+             ip != level->end();
+             ip++)
+        {
+            const boost::shared_ptr<hier::Patch> patch = *ip;
+            
+            const hier::Box& patch_box = patch->getBox();
+            
+            const hier::BoxContainer& patch_visible_boxes =
+                flattened_hierarchy.getVisibleBoxes(patch_box, ln);
+            
+            const hier::BoxContainer& patch_overlapped_visible_boxes =
+                flattened_hierarchy.getOverlappedVisibleBoxes(patch_box, ln);
+            
+            std::vector<probeCellStruct> probe_cells;
+            
+            for (int pi = 0; pi < num_probes; pi++)
+            {
+                if (d_probe_types[pi] == DATA_PROBE::SURFACE_INTEGRAL)
+                {
+                    const int normal_direction = d_probe_normal_directions[pi];
+                    const int plane_index = probe_plane_indices[pi];
+                    
+                    /*
+                     * Get the area of the faces of the cells on the plane.
+                     */
+                    
+                    double area = 1.0;
+                    for (int di = 0; di < d_dim.getValue(); di++)
+                    {
+                        if (di != normal_direction)
+                        {
+                            area *= dx[di]/double(ratio_to_level_zero[di]);
+                        }
+                    }
+                    
+                    for (hier::BoxContainer::const_iterator ib(patch_visible_boxes.begin());
+                         ib != patch_visible_boxes.end();
+                         ib++)
+                    {
+                        const hier::Box& patch_visible_box = *ib;
+                        
+                        if (plane_index < patch_visible_box.lower()[normal_direction] ||
+                            plane_index > patch_visible_box.upper()[normal_direction])
+                        {
+                            continue;
+                        }
+                        
+                        hier::Index plane_lo(patch_visible_box.lower());
+                        hier::Index plane_hi(patch_visible_box.upper());
+                        plane_lo[normal_direction] = plane_index;
+                        plane_hi[normal_direction] = plane_index;
+                        
+                        const hier::Box plane_box(plane_lo, plane_hi, patch_box.getBlockId());
+                        
+                        pdat::CellIterator icend(pdat::CellGeometry::end(plane_box));
+                        for (pdat::CellIterator ic(pdat::CellGeometry::begin(plane_box));
+                             ic != icend;
+                             ++ic)
+                        {
+                            const hier::Index& cell_index = *ic;
+                            
+                            const probeCellStruct probe_cell = {
+                                cell_index,
+                                d_probe_sample_offsets[pi],
+                                area/double(getNumberOfOverlaps(
+                                    patch_overlapped_visible_boxes,
+                                    cell_index)) };
+                            
+                            probe_cells.push_back(probe_cell);
+                        }
+                    }
+                }
+                else
+                {
+                    for (int si = 0; si < d_probe_num_samples[pi]; si++)
+                    {
+                        const hier::Index& cell_index = probe_point_indices[pi][si];
+                        
+                        if (!patch_box.contains(cell_index))
+                        {
+                            continue;
+                        }
+                        
+                        for (hier::BoxContainer::const_iterator ib(patch_visible_boxes.begin());
+                             ib != patch_visible_boxes.end();
+                             ib++)
+                        {
+                            if (ib->contains(cell_index))
+                            {
+                                const probeCellStruct probe_cell = {
+                                    cell_index,
+                                    d_probe_sample_offsets[pi] + si*d_num_components,
+                                    1.0/double(getNumberOfOverlaps(
+                                        patch_overlapped_visible_boxes,
+                                        cell_index)) };
+                                
+                                probe_cells.push_back(probe_cell);
+                                
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            
+            if (!probe_cells.empty())
+            {
+                d_probe_cells[ln].insert(
+                    std::pair<hier::BoxId, std::vector<probeCellStruct> >(
+                        patch_box.getBoxId(),
+                        probe_cells));
+            }
+        }
+    }
+    
+    t_setup_probe_cells->stop();
+}
+
+
+/*
+ * Get the index of the cell containing a point on a level with the given refinement ratio to
+ * level zero. The points on the boundary of the domain are moved into the domain.
+ */
+hier::Index
+DataProbes::getCellIndexOfPoint(
+    const std::vector<double>& point,
+    const hier::IntVector& ratio_to_level_zero) const
+{
+    const double* x_lo = d_grid_geometry->getXLower();
+    const double* dx = d_grid_geometry->getDx();
+    
+    hier::Box domain_box(d_grid_geometry->getPhysicalDomain().getBoundingBox());
+    domain_box.refine(ratio_to_level_zero);
+    
+    hier::Index cell_index(d_dim);
+    
+    for (int di = 0; di < d_dim.getValue(); di++)
+    {
+        const double dx_level = dx[di]/double(ratio_to_level_zero[di]);
+        
+        const int idx = domain_box.lower()[di] +
+            static_cast<int>(std::floor((point[di] - x_lo[di])/dx_level));
+        
+        cell_index[di] = std::max(domain_box.lower()[di], std::min(domain_box.upper()[di], idx));
+    }
+    
+    return cell_index;
+}
@@ -0,0 +1,578 @@
+#include "extn/restart_hierarchy_data/RestartHierarchyDataReader.hpp"
+
+#ifdef HAVE_HDF5
+
+#include "SAMRAI/hier/BlockId.h"
+#include "SAMRAI/hier/Index.h"
+#include "SAMRAI/hier/VariableDatabase.h"
+#include "SAMRAI/pdat/ArrayData.h"
+#include "SAMRAI/pdat/CellData.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/TimerManager.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include "hdf5.h"
+
+#include <algorithm>
+
+boost::shared_ptr<tbox::Timer> RestartHierarchyDataReader::t_read_level_data;
+
+/*
+ * Open a dataset in a group.
+ */
+static hid_t
+openDataset(
+    const hid_t group_id,
+    const std::string& key)
+{
+#if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
+    return H5Dopen(group_id, key.c_str(), H5P_DEFAULT);
+#else
+    return H5Dopen(group_id, key.c_str());
+#endif
+}
+
+
+/*
+ * Open a group in a file.
+ */
+static hid_t
+openGroup(
+    const hid_t file_id,
+    const std::string& key)
+{
+#if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
+    return H5Gopen(file_id, key.c_str(), H5P_DEFAULT);
+#else
+    return H5Gopen(file_id, key.c_str());
+#endif
+}
+
+
+/*
+ * Get the number of values of a one-dimensional dataset.
+ */
+static hsize_t
+getDatasetSize(const hid_t dataset)
+{
+    hid_t space = H5Dget_space(dataset);
+    
+    hsize_t size = 0;
+    H5Sget_simple_extent_dims(space, &size, nullptr);
+    
+    H5Sclose(space);
+    
+    return size;
+}
+
+
+/*
+ * Read a one-dimensional integer dataset in a group. An empty vector is returned if the dataset
+ * does not exist.
+ */
+static std::vector<int>
+readIntegerDataset(
+    const hid_t group_id,
+    const std::string& key)
+{
+    std::vector<int> data;
+    
+    hid_t dataset = openDataset(group_id, key);
+    if (dataset >= 0)
+    {
+        data.resize(static_cast<size_t>(getDatasetSize(dataset)));
+        if (!data.empty())
+        {
+            H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data[0]);
+        }
+        
+        H5Dclose(dataset);
+    }
+    
+    return data;
+}
+
+
+/*
+ * Get the name of the group of a level.
+ */
+static std::string
+getLevelGroupName(const int level_number)
+{
+    return "level_" + tbox::Utilities::intToString(level_number, 4);
+}
+
+
+RestartHierarchyDataReader::RestartHierarchyDataReader(
+    const std::string& object_name,
+    const std::string& filename,
+    const tbox::Dimension& dim):
+        d_object_name(object_name),
+        d_filename(filename),
+        d_dim(dim),
+        d_time(0.0),
+        d_step(0)
+{
+    TBOX_ASSERT(!filename.empty());
+    
+    if (!t_read_level_data)
+    {
+        t_read_level_data = tbox::TimerManager::getManager()->
+            getTimer("RestartHierarchyDataReader::readLevelData()");
+    }
+    
+    /*
+     * The metadata is read by the first process and broadcast to the others. The integer buffer
+     * has the step number, the number of levels and, for each level, the ratio to level zero,
+     * the number of boxes and the lower and upper indices of the boxes.
+     */
+    
+    const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
+    
+    std::vector<int> int_buffer;
+    double time = 0.0;
+    
+    if (mpi.getRank() == 0)
+    {
+        readHierarchyMetadata(int_buffer, time);
+    }
+    
+    int int_buffer_size = static_cast<int>(int_buffer.size());
+    mpi.Bcast(&int_buffer_size, 1, MPI_INT, 0);
+    int_buffer.resize(int_buffer_size);
+    
+    mpi.Bcast(&int_buffer[0], int_buffer_size, MPI_INT, 0);
+    mpi.Bcast(&time, 1, MPI_DOUBLE, 0);
+    
+    const int dim_val = d_dim.getValue();
+    
+    d_time = time;
+    d_step = int_buffer[0];
+    
+    const int num_levels = int_buffer[1];
+    
+    d_level_ratios_to_level_zero.resize(num_levels, hier::IntVector::getOne(d_dim));
+    d_level_boxes.resize(num_levels);
+    d_level_box_offsets.resize(num_levels);
+    d_level_num_cells.resize(num_levels, 0);
+    
+    int count = 2;
+    for (int li = 0; li < num_levels; li++)
+    {
+        for (int di = 0; di < dim_val; di++)
+        {
+            d_level_ratios_to_level_zero[li][di] = int_buffer[count++];
+        }
+        
+        const int num_boxes = int_buffer[count++];
+        
+        d_level_boxes[li].reserve(num_boxes);
+        d_level_box_offsets[li].reserve(num_boxes);
+        
+        for (int bi = 0; bi < num_boxes; bi++)
+        {
+            hier::Index box_lo(d_dim);
+            hier::Index box_hi(d_dim);
+            for (int di = 0; di < dim_val; di++)
+            {
+                box_lo[di] = int_buffer[count++];
+            }
+            for (int di = 0; di < dim_val; di++)
+            {
+                box_hi[di] = int_buffer[count++];
+            }
+            
+            d_level_boxes[li].push_back(hier::Box(box_lo, box_hi, hier::BlockId(0)));
+            d_level_box_offsets[li].push_back(d_level_num_cells[li]);
+            d_level_num_cells[li] += d_level_boxes[li].back().size();
+        }
+    }
+}
+
+
+RestartHierarchyDataReader::~RestartHierarchyDataReader()
+{
+    t_read_level_data.reset();
+}
+
+
+/*
+ * Get the refine boxes of the coarser levels that reproduce the finer levels of the hierarchy.
+ */
+void
+RestartHierarchyDataReader::getRefineBoxes(
+    std::vector<hier::BoxContainer>& refine_boxes,
+    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy) const
+{
+    TBOX_ASSERT(patch_hierarchy);
+    
+    const int num_levels = getNumberOfLevels();
+    
+    if (num_levels > patch_hierarchy->getMaxNumberOfLevels())
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "The hierarchy data in file '"
+            << d_filename
+            << "' has "
+            << num_levels
+            << " levels, which is more than the maximum number of levels of the hierarchy."
+            << std::endl);
+    }
+    
+    refine_boxes.clear();
+    refine_boxes.resize(std::max(num_levels - 1, 0));
+    
+    for (int li = 1; li < num_levels; li++)
+    {
+        const hier::IntVector ratio_to_coarser =
+            d_level_ratios_to_level_zero[li]/d_level_ratios_to_level_zero[li - 1];
+        
+        if (ratio_to_coarser != patch_hierarchy->getRatioToCoarserLevel(li))
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "The refinement ratio of level "
+                << li
+                << " in file '"
+                << d_filename
+                << "' is different from the one of the hierarchy."
+                << std::endl);
+        }
+        
+        for (std::vector<hier::Box>::const_iterator bi = d_level_boxes[li].begin();
+             bi != d_level_boxes[li].end();
+             bi++)
+        {
+            hier::Box coarsened_box(*bi);
+            coarsened_box.coarsen(ratio_to_coarser);
+            refine_boxes[li - 1].pushBack(coarsened_box);
+        }
+    }
+}
+
+
+/*
+ * Read the cell data of the given patch data indices on the local patches of the level.
+ */
+void
+RestartHierarchyDataReader::readLevelData(
+    const boost::shared_ptr<hier::PatchLevel>& level,
+    const std::vector<int>& data_ids) const
+{
+    TBOX_ASSERT(level);
+    
+    const int level_number = level->getLevelNumber();
+    
+    if (level_number >= getNumberOfLevels())
+    {
+        return;
+    }
+    
+    t_read_level_data->start();
+    
+    if (level->getRatioToLevelZero() != d_level_ratios_to_level_zero[level_number])
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "The refinement ratio to level zero of level "
+            << level_number
+            << " in file '"
+            << d_filename
+            << "' is different from the one of the hierarchy."
+            << std::endl);
+    }
+    
+    const int dim_val = d_dim.getValue();
+    
+    const std::vector<hier::Box>& boxes = d_level_boxes[level_number];
+    const std::vector<size_t>& box_offsets = d_level_box_offsets[level_number];
+    const int num_boxes = static_cast<int>(boxes.size());
+    
+    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    
+    /*
+     * Every process opens the file on its own and reads only the parts of the boxes that overlap
+     * its patches.
+     */
+    
+    hid_t file_id = H5Fopen(d_filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file_id < 0)
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "Failed to open file '"
+            << d_filename
+            << "' to read the hierarchy data."
+            << std::endl);
+    }
+    
+    hid_t group_id = openGroup(file_id, getLevelGroupName(level_number));
+    TBOX_ASSERT(group_id >= 0);
+    
+    int num_uncovered_patches = 0;
+    
+    for (int vi = 0; vi < static_cast<int>(data_ids.size()); vi++)
+    {
+        boost::shared_ptr<hier::Variable> var;
+        variable_db->mapIndexToVariable(data_ids[vi], var);
+        TBOX_ASSERT(var);
+        
+        hid_t dataset = openDataset(group_id, var->getName());
+        if (dataset < 0)
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "Data of variable '"
+                << var->getName()
+                << "' is not found on level "
+                << level_number
+                << " in file '"
+                << d_filename
+                << "'."
+                << std::endl);
+        }
+        
+        hid_t file_space = H5Dget_space(dataset);
+        
+        const hsize_t dataset_size = getDatasetSize(dataset);
+        
+        for (hier::PatchLevel::iterator ip(level->begin());
+             ip != level->end();
+             ip++)
+        {
+            const boost::shared_ptr<hier::Patch> patch = *ip;
+            
+            const hier::Box& patch_box = patch->getBox();
+            
+            boost::shared_ptr<pdat::CellData<double> > data(
+                BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                    patch->getPatchData(data_ids[vi])));
+            TBOX_ASSERT(data);
+            
+            const hsize_t depth = static_cast<hsize_t>(data->getDepth());
+            
+            if (dataset_size != d_level_num_cells[level_number]*depth)
+            {
+                TBOX_ERROR(d_object_name
+                    << ": "
+                    << "The depth of variable '"
+                    << var->getName()
+                    << "' in file '"
+                    << d_filename
+                    << "' is different from the one of the patch data."
+                    << std::endl);
+            }
+            
+            size_t num_covered_cells = 0;
+            
+            for (int bi = 0; bi < num_boxes; bi++)
+            {
+                const hier::Box overlap_box = patch_box*boxes[bi];
+                if (overlap_box.empty())
+                {
+                    continue;
+                }
+                
+                /*
+                 * Select the overlap in the data of the box in the file. Each hyperslab selects
+                 * the rows of the overlap with the same component and the same index in the
+                 * third direction. The selected values are read in the order of the file, which
+                 * is the layout of pdat::ArrayData on the overlap.
+                 */
+                
+                const hsize_t box_num_cells = static_cast<hsize_t>(boxes[bi].size());
+                const hsize_t box_dim_0 = static_cast<hsize_t>(boxes[bi].numberCells(0));
+                const hsize_t box_dim_1 = dim_val > 1 ?
+                    static_cast<hsize_t>(boxes[bi].numberCells(1)) : 1;
+                
+                hsize_t overlap_offset_0 = static_cast<hsize_t>(
+                    overlap_box.lower()[0] - boxes[bi].lower()[0]);
+                hsize_t overlap_offset_1 = dim_val > 1 ? static_cast<hsize_t>(
+                    overlap_box.lower()[1] - boxes[bi].lower()[1]) : 0;
+                hsize_t overlap_offset_2 = dim_val > 2 ? static_cast<hsize_t>(
+                    overlap_box.lower()[2] - boxes[bi].lower()[2]) : 0;
+                
+                const hsize_t overlap_dim_0 = static_cast<hsize_t>(overlap_box.numberCells(0));
+                const hsize_t overlap_dim_1 = dim_val > 1 ?
+                    static_cast<hsize_t>(overlap_box.numberCells(1)) : 1;
+                const hsize_t overlap_dim_2 = dim_val > 2 ?
+                    static_cast<hsize_t>(overlap_box.numberCells(2)) : 1;
+                
+                H5Sselect_none(file_space);
+                
+                for (hsize_t ci = 0; ci < depth; ci++)
+                {
+                    for (hsize_t k = 0; k < overlap_dim_2; k++)
+                    {
+                        const hsize_t start = static_cast<hsize_t>(box_offsets[bi])*depth +
+                            ci*box_num_cells +
+                            (overlap_offset_2 + k)*box_dim_0*box_dim_1 +
+                            overlap_offset_1*box_dim_0 +
+                            overlap_offset_0;
+                        
+                        const hsize_t stride = box_dim_0;
+                        const hsize_t count = overlap_dim_1;
+                        const hsize_t block = overlap_dim_0;
+                        
+                        H5Sselect_hyperslab(
+                            file_space,
+                            H5S_SELECT_OR,
+                            &start,
+                            &stride,
+                            &count,
+                            &block);
+                    }
+                }
+                
+                pdat::ArrayData<double> overlap_data(overlap_box, data->getDepth());
+                
+                const hsize_t num_values = static_cast<hsize_t>(overlap_box.size())*depth;
+                hid_t memory_space = H5Screate_simple(1, &num_values, 0);
+                
+                herr_t errf = H5Dread(
+                    dataset,
+                    H5T_NATIVE_DOUBLE,
+                    memory_space,
+                    file_space,
+                    H5P_DEFAULT,
+                    overlap_data.getPointer());
+                
+                if (errf < 0)
+                {
+                    TBOX_ERROR(d_object_name
+                        << ": "
+                        << "Failed to read the data of variable '"
+                        << var->getName()
+                        << "' from file '"
+                        << d_filename
+                        << "'."
+                        << std::endl);
+                }
+                
+                H5Sclose(memory_space);
+                
+                data->getArrayData().copy(overlap_data, overlap_box);
+                
+                num_covered_cells += overlap_box.size();
+            }
+            
+            if (vi == 0 && num_covered_cells < patch_box.size())
+            {
+                num_uncovered_patches++;
+            }
+        }
+        
+        H5Sclose(file_space);
+        H5Dclose(dataset);
+    }
+    
+    H5Gclose(group_id);
+    H5Fclose(file_id);
+    
+    if (num_uncovered_patches > 0)
+    {
+        TBOX_WARNING(d_object_name
+            << ": "
+            << num_uncovered_patches
+            << " local patches on level "
+            << level_number
+            << " are not fully covered by the hierarchy data in file '"
+            << d_filename
+            << "'. The uncovered cells keep the initial conditions."
+            << std::endl);
+    }
+    
+    t_read_level_data->stop();
+}
+
+
+/*
+ * Read the time, the step number and the boxes of all the levels from the file.
+ */
+void
+RestartHierarchyDataReader::readHierarchyMetadata(
+    std::vector<int>& int_buffer,
+    double& time) const
+{
+    hid_t file_id = H5Fopen(d_filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file_id < 0)
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "Failed to open file '"
+            << d_filename
+            << "' to read the hierarchy data."
+            << std::endl);
+    }
+    
+    const int dim_val = d_dim.getValue();
+    
+    const std::vector<int> dim_data = readIntegerDataset(file_id, "dim");
+    const std::vector<int> step_data = readIntegerDataset(file_id, "step");
+    const std::vector<int> num_levels_data = readIntegerDataset(file_id, "number_of_levels");
+    
+    hid_t time_dataset = openDataset(file_id, "time");
+    
+    if (dim_data.size() != 1 || step_data.size() != 1 || num_levels_data.size() != 1 ||
+        time_dataset < 0)
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "File '"
+            << d_filename
+            << "' is not a file of hierarchy data."
+            << std::endl);
+    }
+    
+    if (dim_data[0] != dim_val)
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "The dimension of the hierarchy data in file '"
+            << d_filename
+            << "' is different from the dimension of the problem."
+            << std::endl);
+    }
+    
+    H5Dread(time_dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &time);
+    H5Dclose(time_dataset);
+    
+    const int num_levels = num_levels_data[0];
+    
+    int_buffer.clear();
+    int_buffer.push_back(step_data[0]);
+    int_buffer.push_back(num_levels);
+    
+    for (int li = 0; li < num_levels; li++)
+    {
+        hid_t group_id = openGroup(file_id, getLevelGroupName(li));
+        TBOX_ASSERT(group_id >= 0);
+        
+        const std::vector<int> ratio = readIntegerDataset(group_id, "ratio_to_level_zero");
+        const std::vector<int> boxes = readIntegerDataset(group_id, "boxes");
+        
+        H5Gclose(group_id);
+        
+        if (static_cast<int>(ratio.size()) != dim_val ||
+            static_cast<int>(boxes.size()) % (2*dim_val) != 0)
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "The boxes of level "
+                << li
+                << " in file '"
+                << d_filename
+                << "' are corrupted."
+                << std::endl);
+        }
+        
+        int_buffer.insert(int_buffer.end(), ratio.begin(), ratio.end());
+        int_buffer.push_back(static_cast<int>(boxes.size())/(2*dim_val));
+        int_buffer.insert(int_buffer.end(), boxes.begin(), boxes.end());
+    }
+    
+    H5Fclose(file_id);
+}
+
+#endif /* HAVE_HDF5 */
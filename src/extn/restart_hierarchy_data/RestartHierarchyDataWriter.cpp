@@ -0,0 +1,484 @@
+#include "extn/restart_hierarchy_data/RestartHierarchyDataWriter.hpp"
+
+#ifdef HAVE_HDF5
+
+#include "SAMRAI/hier/BoxId.h"
+#include "SAMRAI/hier/PatchLevel.h"
+#include "SAMRAI/hier/RealBoxConstIterator.h"
+#include "SAMRAI/hier/VariableDatabase.h"
+#include "SAMRAI/pdat/ArrayData.h"
+#include "SAMRAI/pdat/CellData.h"
+#include "SAMRAI/pdat/CellDataFactory.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/TimerManager.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include "hdf5.h"
+
+#include <map>
+
+boost::shared_ptr<tbox::Timer> RestartHierarchyDataWriter::t_write_hierarchy_data;
+
+/*
+ * Create a one-dimensional dataset of the given type and size in a group.
+ */
+static hid_t
+createDataset(
+    const hid_t group_id,
+    const std::string& key,
+    const hid_t type_id,
+    const hsize_t size)
+{
+    hid_t space = H5Screate_simple(1, &size, 0);
+    TBOX_ASSERT(space >= 0);
+    
+#if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
+    hid_t dataset = H5Dcreate(
+        group_id,
+        key.c_str(),
+        type_id,
+        space,
+        H5P_DEFAULT,
+        H5P_DEFAULT,
+        H5P_DEFAULT);
+#else
+    hid_t dataset = H5Dcreate(
+        group_id,
+        key.c_str(),
+        type_id,
+        space,
+        H5P_DEFAULT);
+#endif
+    TBOX_ASSERT(dataset >= 0);
+    
+    herr_t errf = H5Sclose(space);
+    TBOX_ASSERT(errf >= 0);
+    NULL_USE(errf);
+    
+    return dataset;
+}
+
+
+/*
+ * Open a dataset in a group.
+ */
+static hid_t
+openDataset(
+    const hid_t group_id,
+    const std::string& key)
+{
+#if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
+    return H5Dopen(group_id, key.c_str(), H5P_DEFAULT);
+#else
+    return H5Dopen(group_id, key.c_str());
+#endif
+}
+
+
+/*
+ * Create a one-dimensional integer dataset in a group and write the data to it if the data is
+ * given.
+ */
+static void
+writeIntegerDataset(
+    const hid_t group_id,
+    const std::string& key,
+    const int* data,
+    const hsize_t size)
+{
+    hid_t dataset = createDataset(group_id, key, H5T_NATIVE_INT, size);
+    
+    if (data != nullptr)
+    {
+        herr_t errf = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+        TBOX_ASSERT(errf >= 0);
+        NULL_USE(errf);
+    }
+    
+    H5Dclose(dataset);
+}
+
+
+/*
+ * Create a one-dimensional double dataset in a group and write the data to it if the data is
+ * given.
+ */
+static void
+writeDoubleDataset(
+    const hid_t group_id,
+    const std::string& key,
+    const double* data,
+    const hsize_t size)
+{
+    hid_t dataset = createDataset(group_id, key, H5T_NATIVE_DOUBLE, size);
+    
+    if (data != nullptr)
+    {
+        herr_t errf = H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+        TBOX_ASSERT(errf >= 0);
+        NULL_USE(errf);
+    }
+    
+    H5Dclose(dataset);
+}
+
+
+/*
+ * Get the name of the group of a level.
+ */
+static std::string
+getLevelGroupName(const int level_number)
+{
+    return "level_" + tbox::Utilities::intToString(level_number, 4);
+}
+
+
+RestartHierarchyDataWriter::RestartHierarchyDataWriter(
+    const std::string& object_name,
+    const tbox::Dimension& dim):
+        d_object_name(object_name),
+        d_dim(dim)
+{
+    if (!t_write_hierarchy_data)
+    {
+        t_write_hierarchy_data = tbox::TimerManager::getManager()->
+            getTimer("RestartHierarchyDataWriter::writeHierarchyData()");
+    }
+}
+
+
+RestartHierarchyDataWriter::~RestartHierarchyDataWriter()
+{
+    t_write_hierarchy_data.reset();
+}
+
+
+/*
+ * Write the cell data of the given patch data indices on all the levels of the hierarchy to the
+ * file.
+ */
+void
+RestartHierarchyDataWriter::writeHierarchyData(
+    const std::string& filename,
+    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+    const std::vector<int>& data_ids,
+    const double time,
+    const int step) const
+{
+    TBOX_ASSERT(!filename.empty());
+    TBOX_ASSERT(patch_hierarchy);
+    
+    t_write_hierarchy_data->start();
+    
+    const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
+    
+    const int dim = d_dim.getValue();
+    const int num_levels = patch_hierarchy->getNumberOfLevels();
+    const int num_vars = static_cast<int>(data_ids.size());
+    
+    /*
+     * Get the names and the depths of the variables.
+     */
+    
+    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    
+    std::vector<std::string> var_names(num_vars);
+    std::vector<int> var_depths(num_vars);
+    
+    for (int vi = 0; vi < num_vars; vi++)
+    {
+        boost::shared_ptr<hier::Variable> var;
+        if (!variable_db->mapIndexToVariable(data_ids[vi], var))
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "No variable is registered with patch data index "
+                << data_ids[vi]
+                << "."
+                << std::endl);
+        }
+        
+        boost::shared_ptr<pdat::CellDataFactory<double> > cell_data_factory(
+            BOOST_CAST<pdat::CellDataFactory<double>, hier::PatchDataFactory>(
+                variable_db->getPatchDescriptor()->getPatchDataFactory(data_ids[vi])));
+        
+        if (!cell_data_factory)
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "Variable '"
+                << var->getName()
+                << "' is not cell data of doubles."
+                << std::endl);
+        }
+        
+        var_names[vi] = var->getName();
+        var_depths[vi] = cell_data_factory->getDepth();
+    }
+    
+    /*
+     * Get the global boxes of all the levels and the offsets of the data of the boxes. The
+     * globalized boxes are ordered by the box ids on all processes.
+     */
+    
+    std::vector<std::vector<int> > level_boxes(num_levels);
+    std::vector<std::map<hier::BoxId, hsize_t> > level_box_offsets(num_levels);
+    std::vector<hsize_t> level_num_cells(num_levels, 0);
+    
+    for (int li = 0; li < num_levels; li++)
+    {
+        boost::shared_ptr<hier::PatchLevel> patch_level(patch_hierarchy->getPatchLevel(li));
+        
+        const hier::BoxContainer& global_boxes =
+            patch_level->getBoxLevel()->getGlobalizedVersion().getGlobalBoxes();
+        
+        for (hier::RealBoxConstIterator bi(global_boxes.realBegin());
+             bi != global_boxes.realEnd();
+             ++bi)
+        {
+            for (int di = 0; di < dim; di++)
+            {
+                level_boxes[li].push_back(bi->lower()[di]);
+            }
+            for (int di = 0; di < dim; di++)
+            {
+                level_boxes[li].push_back(bi->upper()[di]);
+            }
+            
+            level_box_offsets[li].insert(std::make_pair(bi->getBoxId(), level_num_cells[li]));
+            level_num_cells[li] += static_cast<hsize_t>(bi->size());
+        }
+    }
+    
+    /*
+     * Create the file with the datasets and write the metadata, then write the data of the local
+     * patches.
+     */
+    
+    const bool is_metadata_writer = (mpi.getRank() == 0);
+    
+#if defined(HAVE_MPI) && defined(H5_HAVE_PARALLEL)
+    /*
+     * All processes create the file and the datasets collectively and write the data of their
+     * patches independently.
+     */
+    hid_t file_access = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(file_access, mpi.getCommunicator(), MPI_INFO_NULL);
+    
+    hid_t file_id = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, file_access);
+    H5Pclose(file_access);
+    
+    const bool is_file_creator = true;
+    const bool is_token_passed = false;
+#else
+    /*
+     * The first process creates the file and the datasets, then the processes write the data of
+     * their patches one after another.
+     */
+    const bool is_file_creator = is_metadata_writer;
+    const bool is_token_passed = (mpi.getSize() > 1);
+    
+    const int token_tag = 0;
+    int token = 0;
+    
+    if (is_token_passed && mpi.getRank() > 0)
+    {
+        tbox::SAMRAI_MPI::Status status;
+        mpi.Recv(&token, 1, MPI_INT, mpi.getRank() - 1, token_tag, &status);
+    }
+    
+    hid_t file_id = -1;
+    if (is_file_creator)
+    {
+        file_id = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    }
+    else
+    {
+        file_id = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+    }
+#endif
+    
+    if (file_id < 0)
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "Failed to open file '"
+            << filename
+            << "' to write the hierarchy data."
+            << std::endl);
+    }
+    
+    if (is_file_creator)
+    {
+        writeIntegerDataset(file_id, "dim", is_metadata_writer ? &dim : nullptr, 1);
+        writeDoubleDataset(file_id, "time", is_metadata_writer ? &time : nullptr, 1);
+        writeIntegerDataset(file_id, "step", is_metadata_writer ? &step : nullptr, 1);
+        writeIntegerDataset(
+            file_id,
+            "number_of_levels",
+            is_metadata_writer ? &num_levels : nullptr,
+            1);
+        
+        for (int li = 0; li < num_levels; li++)
+        {
+#if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
+            hid_t group_id = H5Gcreate(
+                file_id,
+                getLevelGroupName(li).c_str(),
+                H5P_DEFAULT,
+                H5P_DEFAULT,
+                H5P_DEFAULT);
+#else
+            hid_t group_id = H5Gcreate(file_id, getLevelGroupName(li).c_str(), 0);
+#endif
+            TBOX_ASSERT(group_id >= 0);
+            
+            const hier::IntVector& ratio_to_level_zero =
+                patch_hierarchy->getPatchLevel(li)->getRatioToLevelZero();
+            
+            std::vector<int> ratio(dim);
+            for (int di = 0; di < dim; di++)
+            {
+                ratio[di] = ratio_to_level_zero[di];
+            }
+            
+            writeIntegerDataset(
+                group_id,
+                "ratio_to_level_zero",
+                is_metadata_writer ? &ratio[0] : nullptr,
+                static_cast<hsize_t>(dim));
+            
+            writeIntegerDataset(
+                group_id,
+                "boxes",
+                is_metadata_writer ? &level_boxes[li][0] : nullptr,
+                static_cast<hsize_t>(level_boxes[li].size()));
+            
+            for (int vi = 0; vi < num_vars; vi++)
+            {
+                hid_t dataset = createDataset(
+                    group_id,
+                    var_names[vi],
+                    H5T_NATIVE_DOUBLE,
+                    level_num_cells[li]*static_cast<hsize_t>(var_depths[vi]));
+                
+                H5Dclose(dataset);
+            }
+            
+            H5Gclose(group_id);
+        }
+    }
+    
+    for (int li = 0; li < num_levels; li++)
+    {
+        boost::shared_ptr<hier::PatchLevel> patch_level(patch_hierarchy->getPatchLevel(li));
+        
+#if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
+        hid_t group_id = H5Gopen(file_id, getLevelGroupName(li).c_str(), H5P_DEFAULT);
+#else
+        hid_t group_id = H5Gopen(file_id, getLevelGroupName(li).c_str());
+#endif
+        TBOX_ASSERT(group_id >= 0);
+        
+        for (int vi = 0; vi < num_vars; vi++)
+        {
+            hid_t dataset = openDataset(group_id, var_names[vi]);
+            TBOX_ASSERT(dataset >= 0);
+            
+            hid_t file_space = H5Dget_space(dataset);
+            
+            const hsize_t depth = static_cast<hsize_t>(var_depths[vi]);
+            
+            for (hier::PatchLevel::iterator ip(patch_level->begin());
+                 ip != patch_level->end();
+                 ip++)
+            {
+                const boost::shared_ptr<hier::Patch> patch = *ip;
+                
+                const hier::Box& patch_box = patch->getBox();
+                
+                boost::shared_ptr<pdat::CellData<double> > data(
+                    BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                        patch->getPatchData(data_ids[vi])));
+                TBOX_ASSERT(data);
+                
+                /*
+                 * Copy the interior data without the ghost cells, which is then contiguous in
+                 * the layout of the file.
+                 */
+                pdat::ArrayData<double> interior_data(patch_box, data->getDepth());
+                interior_data.copy(data->getArrayData(), patch_box);
+                
+                const hsize_t num_values = static_cast<hsize_t>(patch_box.size())*depth;
+                const hsize_t start = level_box_offsets[li][patch_box.getBoxId()]*depth;
+                
+                H5Sselect_hyperslab(
+                    file_space,
+                    H5S_SELECT_SET,
+                    &start,
+                    nullptr,
+                    &num_values,
+                    nullptr);
+                
+                hid_t memory_space = H5Screate_simple(1, &num_values, 0);
+                
+                herr_t errf = H5Dwrite(
+                    dataset,
+                    H5T_NATIVE_DOUBLE,
+                    memory_space,
+                    file_space,
+                    H5P_DEFAULT,
+                    interior_data.getPointer());
+                
+                if (errf < 0)
+                {
+                    TBOX_ERROR(d_object_name
+                        << ": "
+                        << "Failed to write the data of variable '"
+                        << var_names[vi]
+                        << "' to file '"
+                        << filename
+                        << "'."
+                        << std::endl);
+                }
+                
+                H5Sclose(memory_space);
+            }
+            
+            H5Sclose(file_space);
+            H5Dclose(dataset);
+        }
+        
+        H5Gclose(group_id);
+    }
+    
+    H5Fclose(file_id);
+    
+#if !(defined(HAVE_MPI) && defined(H5_HAVE_PARALLEL))
+    if (is_token_passed && mpi.getRank() < mpi.getSize() - 1)
+    {
+        mpi.Send(&token, 1, MPI_INT, mpi.getRank() + 1, token_tag);
+    }
+#else
+    NULL_USE(is_token_passed);
+#endif
+    
+    mpi.Barrier();
+    
+    t_write_hierarchy_data->stop();
+}
+
+
+/*
+ * Get the name of the file of the hierarchy data of a restore number in the restart directory.
+ */
+std::string
+RestartHierarchyDataWriter::getHierarchyDataFilename(
+    const std::string& restart_dirname,
+    const int restore_num)
+{
+    return restart_dirname + "/restore." + tbox::Utilities::intToString(restore_num, 6) +
+        "/hierarchy_data.hdf5";
+}
+
+#endif /* HAVE_HDF5 */
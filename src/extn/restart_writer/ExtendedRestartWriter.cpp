@@ -0,0 +1,480 @@
+#include "extn/restart_writer/ExtendedRestartWriter.hpp"
+
+#include "SAMRAI/tbox/RestartManager.h"
+#include "SAMRAI/tbox/TimerManager.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include <cstdio>
+#include <fstream>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+boost::shared_ptr<tbox::Timer> ExtendedRestartWriter::t_wait_for_pending_restart;
+
+/*
+ * Permission of the directories created for the restart files.
+ */
+#define RESTART_DIRECTORY_MODE (S_IRUSR | S_IWUSR | S_IXUSR | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH)
+
+/*
+ * Remove a file or an empty directory visited by nftw().
+ */
+static int
+removeDirectoryEntry(
+    const char* path,
+    const struct stat* stat_buf,
+    int type_flag,
+    struct FTW* ftw_buf)
+{
+    NULL_USE(stat_buf);
+    NULL_USE(type_flag);
+    NULL_USE(ftw_buf);
+    
+    return std::remove(path);
+}
+
+
+ExtendedRestartWriter::ExtendedRestartWriter(
+    const std::string& object_name,
+    const std::string& restart_write_dirname,
+    const boost::shared_ptr<tbox::Database>& input_db):
+        d_object_name(object_name),
+        d_mpi(tbox::SAMRAI_MPI::getSAMRAIWorld()),
+        d_restart_write_dirname(restart_write_dirname),
+        d_use_asynchronous_writes(false),
+        d_staging_dirname(""),
+        d_num_restarts_to_keep(0),
+        d_write_hierarchy_data(false),
+        d_pending_restore_num(-1),
+        d_is_drain_successful(true)
+{
+    TBOX_ASSERT(!object_name.empty());
+    TBOX_ASSERT(!restart_write_dirname.empty());
+    
+    if (input_db)
+    {
+        d_use_asynchronous_writes = input_db->getBoolWithDefault("use_asynchronous_writes", false);
+        
+        if (d_use_asynchronous_writes)
+        {
+            if (input_db->keyExists("staging_dirname"))
+            {
+                d_staging_dirname = input_db->getString("staging_dirname");
+            }
+            else
+            {
+                TBOX_ERROR(d_object_name
+                    << ": "
+                    << "Key data 'staging_dirname' not found in input when"
+                    << " 'use_asynchronous_writes' is TRUE."
+                    << std::endl);
+            }
+            
+            if (d_staging_dirname.empty() || d_staging_dirname == d_restart_write_dirname)
+            {
+                TBOX_ERROR(d_object_name
+                    << ": "
+                    << "'staging_dirname' should be non-empty and different from the"
+                    << " restart directory."
+                    << std::endl);
+            }
+        }
+        
+        d_num_restarts_to_keep = input_db->getIntegerWithDefault("number_of_restarts_to_keep", 0);
+        
+        if (d_num_restarts_to_keep < 0)
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "'number_of_restarts_to_keep' should be non-negative."
+                << std::endl);
+        }
+        
+        d_write_hierarchy_data = input_db->getBoolWithDefault("write_hierarchy_data", false);
+        
+#ifndef HAVE_HDF5
+        if (d_write_hierarchy_data)
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "'write_hierarchy_data' requires HAMeRS to be built with HDF5."
+                << std::endl);
+        }
+#endif
+    }
+    
+    if (!t_wait_for_pending_restart)
+    {
+        t_wait_for_pending_restart = tbox::TimerManager::getManager()->
+            getTimer("ExtendedRestartWriter::waitForPendingRestart()");
+    }
+}
+
+
+ExtendedRestartWriter::~ExtendedRestartWriter()
+{
+    /*
+     * The result of the copy cannot be checked collectively here. finalize() should have been
+     * called before.
+     */
+    if (d_drain_thread.joinable())
+    {
+        d_drain_thread.join();
+    }
+    
+    t_wait_for_pending_restart.reset();
+}
+
+
+/*
+ * Set the hierarchy and the patch data indices of the hierarchy data.
+ */
+void
+ExtendedRestartWriter::setHierarchyData(
+    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+    const std::vector<int>& data_ids)
+{
+    TBOX_ASSERT(patch_hierarchy);
+    
+    d_patch_hierarchy = patch_hierarchy;
+    d_hierarchy_data_ids = data_ids;
+    
+#ifdef HAVE_HDF5
+    if (d_write_hierarchy_data && !d_hierarchy_data_writer)
+    {
+        d_hierarchy_data_writer.reset(new RestartHierarchyDataWriter(
+            "hierarchy data writer",
+            patch_hierarchy->getDim()));
+    }
+#endif
+}
+
+
+/*
+ * Write the restart files of the given restore number and simulation time.
+ */
+void
+ExtendedRestartWriter::writeRestartFile(
+    const int restore_num,
+    const double restore_time)
+{
+    TBOX_ASSERT(restore_num >= 0);
+    
+    tbox::RestartManager* restart_manager = tbox::RestartManager::getManager();
+    
+    if (!d_use_asynchronous_writes)
+    {
+        restart_manager->writeRestartFile(d_restart_write_dirname, restore_num);
+        
+        writeHierarchyData(restore_num, restore_time);
+        
+        if (d_complete_restore_nums.empty() || d_complete_restore_nums.back() != restore_num)
+        {
+            d_complete_restore_nums.push_back(restore_num);
+        }
+        
+        removeOldRestarts();
+        
+        return;
+    }
+    
+    /*
+     * The staging directory and the background thread are reused only after the copy of the
+     * previous restart is finished.
+     */
+    waitForPendingRestart();
+    
+    const int num_procs = d_mpi.getSize();
+    const int proc_rank = d_mpi.getRank();
+    
+    const std::string proc_filename = "/proc." + tbox::Utilities::processorToString(proc_rank);
+    
+    const std::string staged_nodes_dirname =
+        getRestoreNodesDirname(d_staging_dirname, restore_num, num_procs);
+    
+    const std::string restart_nodes_dirname =
+        getRestoreNodesDirname(d_restart_write_dirname, restore_num, num_procs);
+    
+    /*
+     * The staging directory may be local to each node, so it is created by every process.
+     */
+    tbox::Utilities::recursiveMkdir(staged_nodes_dirname, RESTART_DIRECTORY_MODE, false);
+    
+    restart_manager->writeRestartFile(d_staging_dirname, restore_num);
+    
+    /*
+     * Create the restart directory before any process starts copying into it.
+     */
+    tbox::Utilities::recursiveMkdir(restart_nodes_dirname, RESTART_DIRECTORY_MODE, true);
+    d_mpi.Barrier();
+    
+    d_pending_restore_num = restore_num;
+    d_is_drain_successful = false;
+    
+    d_drain_thread = std::thread(
+        &ExtendedRestartWriter::drainStagedRestartFile,
+        staged_nodes_dirname + proc_filename,
+        restart_nodes_dirname + proc_filename,
+        &d_is_drain_successful);
+    
+    /*
+     * The hierarchy data is written while the restart files are copied in the background.
+     */
+    writeHierarchyData(restore_num, restore_time);
+}
+
+
+/*
+ * Wait for the restart files written asynchronously to be copied to the restart directory and
+ * apply the retention policy.
+ */
+void
+ExtendedRestartWriter::finalize()
+{
+    waitForPendingRestart();
+}
+
+
+/*
+ * Print all characteristics of the restart writer.
+ */
+void
+ExtendedRestartWriter::printClassData(std::ostream& os) const
+{
+    os << "\nPrint ExtendedRestartWriter object..."
+       << std::endl;
+    
+    os << std::endl;
+    
+    os << "ExtendedRestartWriter: this = "
+       << (ExtendedRestartWriter *)this
+       << std::endl;
+    
+    os << "d_object_name = "
+       << d_object_name
+       << std::endl;
+    
+    os << "d_restart_write_dirname = "
+       << d_restart_write_dirname
+       << std::endl;
+    
+    os << "d_use_asynchronous_writes = "
+       << d_use_asynchronous_writes
+       << std::endl;
+    
+    os << "d_staging_dirname = "
+       << d_staging_dirname
+       << std::endl;
+    
+    os << "d_num_restarts_to_keep = "
+       << d_num_restarts_to_keep
+       << std::endl;
+    
+    os << "d_write_hierarchy_data = "
+       << d_write_hierarchy_data
+       << std::endl;
+}
+
+
+/*
+ * Wait for the background copy of the last asynchronous restart to finish, check that it
+ * succeeded on all processes and apply the retention policy.
+ */
+void
+ExtendedRestartWriter::waitForPendingRestart()
+{
+    if (d_pending_restore_num < 0)
+    {
+        return;
+    }
+    
+    t_wait_for_pending_restart->start();
+    
+    if (d_drain_thread.joinable())
+    {
+        d_drain_thread.join();
+    }
+    
+    int is_drain_successful = d_is_drain_successful ? 1 : 0;
+    d_mpi.AllReduce(&is_drain_successful, 1, MPI_MIN);
+    
+    t_wait_for_pending_restart->stop();
+    
+    if (is_drain_successful == 1)
+    {
+        if (d_complete_restore_nums.empty() ||
+            d_complete_restore_nums.back() != d_pending_restore_num)
+        {
+            d_complete_restore_nums.push_back(d_pending_restore_num);
+        }
+        
+        /*
+         * Remove the emptied staging directories. Other processes on the same node may have
+         * removed them already, so the errors are ignored.
+         */
+        const std::string staged_nodes_dirname =
+            getRestoreNodesDirname(d_staging_dirname, d_pending_restore_num, d_mpi.getSize());
+        
+        rmdir(staged_nodes_dirname.c_str());
+        rmdir(getRestoreDirname(d_staging_dirname, d_pending_restore_num).c_str());
+    }
+    else
+    {
+        TBOX_WARNING(d_object_name
+            << ": "
+            << "The restart files of restore number "
+            << d_pending_restore_num
+            << " are not completely copied from '"
+            << d_staging_dirname
+            << "' to '"
+            << d_restart_write_dirname
+            << "'. The restart is incomplete and the staged files are kept."
+            << std::endl);
+    }
+    
+    d_pending_restore_num = -1;
+    
+    removeOldRestarts();
+}
+
+
+/*
+ * Remove the oldest complete restarts from the restart directory so that only the given number of
+ * the most recent ones are kept.
+ */
+void
+ExtendedRestartWriter::removeOldRestarts()
+{
+    if (d_num_restarts_to_keep <= 0)
+    {
+        return;
+    }
+    
+    while (static_cast<int>(d_complete_restore_nums.size()) > d_num_restarts_to_keep)
+    {
+        if (d_mpi.getRank() == 0)
+        {
+            removeDirectory(
+                getRestoreDirname(d_restart_write_dirname, d_complete_restore_nums.front()));
+        }
+        
+        d_complete_restore_nums.pop_front();
+    }
+}
+
+
+/*
+ * Write the hierarchy data of the given restore number and simulation time to the restart
+ * directory.
+ */
+void
+ExtendedRestartWriter::writeHierarchyData(
+    const int restore_num,
+    const double restore_time)
+{
+    if (!d_write_hierarchy_data)
+    {
+        return;
+    }
+    
+#ifdef HAVE_HDF5
+    if (!d_hierarchy_data_writer)
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "setHierarchyData() should be called before the hierarchy data is written."
+            << std::endl);
+    }
+    
+    tbox::Utilities::recursiveMkdir(
+        getRestoreDirname(d_restart_write_dirname, restore_num),
+        RESTART_DIRECTORY_MODE,
+        true);
+    d_mpi.Barrier();
+    
+    d_hierarchy_data_writer->writeHierarchyData(
+        RestartHierarchyDataWriter::getHierarchyDataFilename(d_restart_write_dirname, restore_num),
+        d_patch_hierarchy,
+        d_hierarchy_data_ids,
+        restore_time,
+        restore_num);
+#else
+    NULL_USE(restore_num);
+    NULL_USE(restore_time);
+#endif
+}
+
+
+/*
+ * Get the name of the directory of the restart files of a restore number in a root directory,
+ * without the sub-directory of the number of processes.
+ */
+std::string
+ExtendedRestartWriter::getRestoreDirname(
+    const std::string& root_dirname,
+    const int restore_num)
+{
+    return root_dirname + "/restore." + tbox::Utilities::intToString(restore_num, 6);
+}
+
+
+/*
+ * Get the name of the directory of the restart files of a restore number in a root directory,
+ * including the sub-directory of the number of processes. The name is the same as the one used
+ * by tbox::RestartManager.
+ */
+std::string
+ExtendedRestartWriter::getRestoreNodesDirname(
+    const std::string& root_dirname,
+    const int restore_num,
+    const int num_procs)
+{
+    return getRestoreDirname(root_dirname, restore_num) +
+        "/nodes." + tbox::Utilities::nodeToString(num_procs);
+}
+
+
+/*
+ * Copy a staged restart file to the restart directory and remove the staged file.
+ */
+void
+ExtendedRestartWriter::drainStagedRestartFile(
+    const std::string staged_filename,
+    const std::string restart_filename,
+    bool* is_drain_successful)
+{
+    bool is_copy_successful = false;
+    
+    {
+        std::ifstream staged_file(staged_filename.c_str(), std::ios::in | std::ios::binary);
+        std::ofstream restart_file(
+            restart_filename.c_str(),
+            std::ios::out | std::ios::binary | std::ios::trunc);
+        
+        if (staged_file.is_open() && restart_file.is_open())
+        {
+            restart_file << staged_file.rdbuf();
+            restart_file.close();
+            
+            is_copy_successful = !restart_file.fail();
+        }
+    }
+    
+    if (is_copy_successful)
+    {
+        std::remove(staged_filename.c_str());
+    }
+    
+    *is_drain_successful = is_copy_successful;
+}
+
+
+/*
+ * Remove a directory and all its contents.
+ */
+void
+ExtendedRestartWriter::removeDirectory(const std::string& dirname)
+{
+    nftw(dirname.c_str(), removeDirectoryEntry, 16, FTW_DEPTH | FTW_PHYS);
+}
@@ -1,21 +1,9 @@
 #include "flow/convective_flux_reconstructors/WCNS56/ConvectiveFluxReconstructorWCNS5-Z-HLLC-HLL.hpp"
 
-#define EPSILON HAMERS_EPSILON
-
-
-/*
- * Interger based power function.
- */
-static inline __attribute__((always_inline)) double ipow(double base, int exp)
-{
-    double result = base;
-    for (int i = 1; i < exp; i++)
-    {
-        result *= base;
-    }
+#include <algorithm>
 
-    return result;
-}
+#define EPSILON HAMERS_EPSILON
+#define WENO_BATCH_SIZE 8
 
 
 /*
@@ -25,23 +13,20 @@ static inline __attribute__((always_inline)) void computeLocalBeta(
     double* beta_0,
     double* beta_1,
     double* beta_2,
-    double** U_array,
-    int idx_side)
+    const double U_0,
+    const double U_1,
+    const double U_2,
+    const double U_3,
+    const double U_4)
 {
-    *beta_0 = double(1)/double(3)*(U_array[0][idx_side]*(double(4)*U_array[0][idx_side] -
-         double(19)*U_array[1][idx_side] + double(11)*U_array[2][idx_side]) +
-         U_array[1][idx_side]*(double(25)*U_array[1][idx_side] - double(31)*U_array[2][idx_side]) +
-         double(10)*U_array[2][idx_side]*U_array[2][idx_side]);
+    *beta_0 = double(1)/double(3)*(U_0*(double(4)*U_0 - double(19)*U_1 + double(11)*U_2) +
+         U_1*(double(25)*U_1 - double(31)*U_2) + double(10)*U_2*U_2);
     
-    *beta_1 = double(1)/double(3)*(U_array[1][idx_side]*(double(4)*U_array[1][idx_side] -
-         double(13)*U_array[2][idx_side] + double(5)*U_array[3][idx_side]) +
-         double(13)*U_array[2][idx_side]*(U_array[2][idx_side] - U_array[3][idx_side]) +
-         double(4)*U_array[3][idx_side]*U_array[3][idx_side]);
+    *beta_1 = double(1)/double(3)*(U_1*(double(4)*U_1 - double(13)*U_2 + double(5)*U_3) +
+         double(13)*U_2*(U_2 - U_3) + double(4)*U_3*U_3);
     
-    *beta_2 = double(1)/double(3)*(U_array[2][idx_side]*(double(10)*U_array[2][idx_side] -
-         double(31)*U_array[3][idx_side] + double(11)*U_array[4][idx_side]) +
-         U_array[3][idx_side]*(double(25)*U_array[3][idx_side] - double(19)*U_array[4][idx_side]) +
-         double(4)*U_array[4][idx_side]*U_array[4][idx_side]);
+    *beta_2 = double(1)/double(3)*(U_2*(double(10)*U_2 - double(31)*U_3 + double(11)*U_4) +
+         U_3*(double(25)*U_3 - double(19)*U_4) + double(4)*U_4*U_4);
 }
 
 
@@ -52,119 +37,224 @@ static inline __attribute__((always_inline)) void computeLocalBetaTilde(
     double* beta_tilde_0,
     double* beta_tilde_1,
     double* beta_tilde_2,
-    double** U_array,
-    int idx_side)
+    const double U_1,
+    const double U_2,
+    const double U_3,
+    const double U_4,
+    const double U_5)
 {
-    *beta_tilde_0 = double(1)/double(3)*(U_array[5][idx_side]*(double(4)*U_array[5][idx_side] -
-         double(19)*U_array[4][idx_side] + double(11)*U_array[3][idx_side]) +
-         U_array[4][idx_side]*(double(25)*U_array[4][idx_side] - double(31)*U_array[3][idx_side]) +
-         double(10)*U_array[3][idx_side]*U_array[3][idx_side]);
+    *beta_tilde_0 = double(1)/double(3)*(U_5*(double(4)*U_5 - double(19)*U_4 + double(11)*U_3) +
+         U_4*(double(25)*U_4 - double(31)*U_3) + double(10)*U_3*U_3);
     
-    *beta_tilde_1 = double(1)/double(3)*(U_array[4][idx_side]*(double(4)*U_array[4][idx_side] -
-         double(13)*U_array[3][idx_side] + double(5)*U_array[2][idx_side]) +
-         double(13)*U_array[3][idx_side]*(U_array[3][idx_side] - U_array[2][idx_side]) +
-         double(4)*U_array[2][idx_side]*U_array[2][idx_side]);
+    *beta_tilde_1 = double(1)/double(3)*(U_4*(double(4)*U_4 - double(13)*U_3 + double(5)*U_2) +
+         double(13)*U_3*(U_3 - U_2) + double(4)*U_2*U_2);
     
-    *beta_tilde_2 = double(1)/double(3)*(U_array[3][idx_side]*(double(10)*U_array[3][idx_side] -
-         double(31)*U_array[2][idx_side] + double(11)*U_array[1][idx_side]) +
-         U_array[2][idx_side]*(double(25)*U_array[2][idx_side] - double(19)*U_array[1][idx_side]) +
-         double(4)*U_array[1][idx_side]*U_array[1][idx_side]);
+    *beta_tilde_2 = double(1)/double(3)*(U_3*(double(10)*U_3 - double(31)*U_2 + double(11)*U_1) +
+         U_2*(double(25)*U_2 - double(19)*U_1) + double(4)*U_1*U_1);
 }
 
 
 /*
- * Perform local WENO interpolation of U_minus.
+ * Perform WENO interpolation of U_minus at a row of contiguous mid-points. The mid-points are
+ * interpolated in batches of WENO_BATCH_SIZE. For each batch, the ratios of tau_5 to the beta's,
+ * their powers and the weighted interpolation are computed in separate loops over the contiguous
+ * stencil arrays, so that the loop over the exponent p is not inside the vectorized loops. If SIMD
+ * is enabled, the loops are vectorized and compiled for the instruction sets selected at runtime.
  */
-static inline __attribute__((always_inline)) void performLocalWENOInterpolationMinus(
+static HAMERS_SIMD_TARGET_CLONES void performWENOInterpolationMinusOnRow(
    double* U_minus,
    double** U_array,
-   int idx_side,
+   int idx_side_start,
+   int num_sides,
    int p)
 {
-    /*
-     * Compute beta's.
-     */
-    
-    double beta_0, beta_1, beta_2;
-    
-    computeLocalBeta(&beta_0, &beta_1, &beta_2, U_array, idx_side);
-    
-    /*
-     * Compute the weights omega.
-     */
-    
-    double omega_0, omega_1, omega_2;
-    
-    double tau_5 = fabs(beta_0 - beta_2);
+    const double* __restrict__ U_0 = U_array[0] + idx_side_start;
+    const double* __restrict__ U_1 = U_array[1] + idx_side_start;
+    const double* __restrict__ U_2 = U_array[2] + idx_side_start;
+    const double* __restrict__ U_3 = U_array[3] + idx_side_start;
+    const double* __restrict__ U_4 = U_array[4] + idx_side_start;
     
-    omega_0 = double(1)/double(16)*(double(1) + ipow(tau_5/(beta_0 + EPSILON), p));
-    omega_1 = double(5)/double(8)*(double(1) + ipow(tau_5/(beta_1 + EPSILON), p));
-    omega_2 = double(5)/double(16)*(double(1) + ipow(tau_5/(beta_2 + EPSILON), p));
+    double* __restrict__ U_m = U_minus + idx_side_start;
     
-    double omega_sum = omega_0 + omega_1 + omega_2;
-    
-    omega_0 = omega_0/omega_sum;
-    omega_1 = omega_1/omega_sum;
-    omega_2 = omega_2/omega_sum;
-    
-    /*
-     * Compute U_minus.
-     */
+    double ratio_0[WENO_BATCH_SIZE], ratio_1[WENO_BATCH_SIZE], ratio_2[WENO_BATCH_SIZE];
+    double ratio_pow_0[WENO_BATCH_SIZE], ratio_pow_1[WENO_BATCH_SIZE], ratio_pow_2[WENO_BATCH_SIZE];
     
-    U_minus[idx_side] = double(3)/double(8)*omega_0*U_array[0][idx_side] +
-        (-double(10)/double(8)*omega_0 - double(1)/double(8)*omega_1)*U_array[1][idx_side] +
-        (double(15)/double(8)*omega_0 + double(6)/double(8)*omega_1 +
-        double(3)/double(8)*omega_2)*U_array[2][idx_side] +
-        (double(3)/double(8)*omega_1 + double(6)/double(8)*omega_2)*U_array[3][idx_side] -
-        double(1)/double(8)*omega_2*U_array[4][idx_side];
+    for (int ib = 0; ib < num_sides; ib += WENO_BATCH_SIZE)
+    {
+        const int batch_size = std::min(WENO_BATCH_SIZE, num_sides - ib);
+        
+        /*
+         * Compute beta's and the ratios of tau_5 to the beta's.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            double beta_0, beta_1, beta_2;
+            
+            computeLocalBeta(&beta_0, &beta_1, &beta_2,
+                U_0[idx], U_1[idx], U_2[idx], U_3[idx], U_4[idx]);
+            
+            const double tau_5 = fabs(beta_0 - beta_2);
+            
+            ratio_0[i] = tau_5/(beta_0 + EPSILON);
+            ratio_1[i] = tau_5/(beta_1 + EPSILON);
+            ratio_2[i] = tau_5/(beta_2 + EPSILON);
+            
+            ratio_pow_0[i] = ratio_0[i];
+            ratio_pow_1[i] = ratio_1[i];
+            ratio_pow_2[i] = ratio_2[i];
+        }
+        
+        /*
+         * Raise the ratios to the power p.
+         */
+        
+        for (int k = 1; k < p; k++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < batch_size; i++)
+            {
+                ratio_pow_0[i] *= ratio_0[i];
+                ratio_pow_1[i] *= ratio_1[i];
+                ratio_pow_2[i] *= ratio_2[i];
+            }
+        }
+        
+        /*
+         * Compute the weights omega and U_minus. The weights are normalized after the weighted sum
+         * of the interpolations of the stencils.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            const double omega_0 = double(1)/double(16)*(double(1) + ratio_pow_0[i]);
+            const double omega_1 = double(5)/double(8)*(double(1) + ratio_pow_1[i]);
+            const double omega_2 = double(5)/double(16)*(double(1) + ratio_pow_2[i]);
+            
+            const double omega_sum_inv = double(1)/(omega_0 + omega_1 + omega_2);
+            
+            U_m[idx] = omega_sum_inv*(
+                omega_0*(double(3)/double(8)*U_0[idx] - double(10)/double(8)*U_1[idx] +
+                    double(15)/double(8)*U_2[idx]) +
+                omega_1*(-double(1)/double(8)*U_1[idx] + double(6)/double(8)*U_2[idx] +
+                    double(3)/double(8)*U_3[idx]) +
+                omega_2*(double(3)/double(8)*U_2[idx] + double(6)/double(8)*U_3[idx] -
+                    double(1)/double(8)*U_4[idx]));
+        }
+    }
 }
 
 
 /*
- * Perform local WENO interpolation of U_plus.
+ * Perform WENO interpolation of U_plus at a row of contiguous mid-points. The mid-points are
+ * interpolated in batches of WENO_BATCH_SIZE in the same way as U_minus.
  */
-static inline __attribute__((always_inline)) void performLocalWENOInterpolationPlus(
+static HAMERS_SIMD_TARGET_CLONES void performWENOInterpolationPlusOnRow(
    double* U_plus,
    double** U_array,
-   int idx_side,
+   int idx_side_start,
+   int num_sides,
    int p)
 {
-    /*
-     * Compute beta_tilde's.
-     */
-    
-    double beta_tilde_0, beta_tilde_1, beta_tilde_2;
-    
-    computeLocalBetaTilde(&beta_tilde_0, &beta_tilde_1, &beta_tilde_2, U_array, idx_side);
-    
-    /*
-     * Compute the weights omega_upwind_tilde.
-     */
-    
-    double omega_tilde_0, omega_tilde_1, omega_tilde_2;
+    const double* __restrict__ U_1 = U_array[1] + idx_side_start;
+    const double* __restrict__ U_2 = U_array[2] + idx_side_start;
+    const double* __restrict__ U_3 = U_array[3] + idx_side_start;
+    const double* __restrict__ U_4 = U_array[4] + idx_side_start;
+    const double* __restrict__ U_5 = U_array[5] + idx_side_start;
     
-    double tau_5_tilde = fabs(beta_tilde_0 - beta_tilde_2);
+    double* __restrict__ U_p = U_plus + idx_side_start;
     
-    omega_tilde_0 = double(1)/double(16)*(double(1) + ipow(tau_5_tilde/(beta_tilde_0 + EPSILON), p));
-    omega_tilde_1 = double(5)/double(8)*(double(1) + ipow(tau_5_tilde/(beta_tilde_1 + EPSILON), p));
-    omega_tilde_2 = double(5)/double(16)*(double(1) + ipow(tau_5_tilde/(beta_tilde_2 + EPSILON), p));
+    double ratio_tilde_0[WENO_BATCH_SIZE], ratio_tilde_1[WENO_BATCH_SIZE], ratio_tilde_2[WENO_BATCH_SIZE];
+    double ratio_tilde_pow_0[WENO_BATCH_SIZE], ratio_tilde_pow_1[WENO_BATCH_SIZE],
+        ratio_tilde_pow_2[WENO_BATCH_SIZE];
     
-    double omega_tilde_sum = omega_tilde_0 + omega_tilde_1 + omega_tilde_2;
-    
-    omega_tilde_0 = omega_tilde_0/omega_tilde_sum;
-    omega_tilde_1 = omega_tilde_1/omega_tilde_sum;
-    omega_tilde_2 = omega_tilde_2/omega_tilde_sum;
-    
-    /*
-     * Compute U_plus.
-     */
-    
-    U_plus[idx_side] = double(3)/double(8)*omega_tilde_0*U_array[5][idx_side] +
-        (-double(10)/double(8)*omega_tilde_0 - double(1)/double(8)*omega_tilde_1)*U_array[4][idx_side] +
-        (double(15)/double(8)*omega_tilde_0 + double(6)/double(8)*omega_tilde_1 +
-        double(3)/double(8)*omega_tilde_2)*U_array[3][idx_side] +
-        (double(3)/double(8)*omega_tilde_1 + double(6)/double(8)*omega_tilde_2)*U_array[2][idx_side] -
-        double(1)/double(8)*omega_tilde_2*U_array[1][idx_side];
+    for (int ib = 0; ib < num_sides; ib += WENO_BATCH_SIZE)
+    {
+        const int batch_size = std::min(WENO_BATCH_SIZE, num_sides - ib);
+        
+        /*
+         * Compute beta_tilde's and the ratios of tau_5_tilde to the beta_tilde's.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            double beta_tilde_0, beta_tilde_1, beta_tilde_2;
+            
+            computeLocalBetaTilde(&beta_tilde_0, &beta_tilde_1, &beta_tilde_2,
+                U_1[idx], U_2[idx], U_3[idx], U_4[idx], U_5[idx]);
+            
+            const double tau_5_tilde = fabs(beta_tilde_0 - beta_tilde_2);
+            
+            ratio_tilde_0[i] = tau_5_tilde/(beta_tilde_0 + EPSILON);
+            ratio_tilde_1[i] = tau_5_tilde/(beta_tilde_1 + EPSILON);
+            ratio_tilde_2[i] = tau_5_tilde/(beta_tilde_2 + EPSILON);
+            
+            ratio_tilde_pow_0[i] = ratio_tilde_0[i];
+            ratio_tilde_pow_1[i] = ratio_tilde_1[i];
+            ratio_tilde_pow_2[i] = ratio_tilde_2[i];
+        }
+        
+        /*
+         * Raise the ratios to the power p.
+         */
+        
+        for (int k = 1; k < p; k++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < batch_size; i++)
+            {
+                ratio_tilde_pow_0[i] *= ratio_tilde_0[i];
+                ratio_tilde_pow_1[i] *= ratio_tilde_1[i];
+                ratio_tilde_pow_2[i] *= ratio_tilde_2[i];
+            }
+        }
+        
+        /*
+         * Compute the weights omega_tilde and U_plus. The weights are normalized after the
+         * weighted sum of the interpolations of the stencils.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            const double omega_tilde_0 = double(1)/double(16)*(double(1) + ratio_tilde_pow_0[i]);
+            const double omega_tilde_1 = double(5)/double(8)*(double(1) + ratio_tilde_pow_1[i]);
+            const double omega_tilde_2 = double(5)/double(16)*(double(1) + ratio_tilde_pow_2[i]);
+            
+            const double omega_tilde_sum_inv = double(1)/(omega_tilde_0 + omega_tilde_1 + omega_tilde_2);
+            
+            U_p[idx] = omega_tilde_sum_inv*(
+                omega_tilde_0*(double(3)/double(8)*U_5[idx] - double(10)/double(8)*U_4[idx] +
+                    double(15)/double(8)*U_3[idx]) +
+                omega_tilde_1*(-double(1)/double(8)*U_4[idx] + double(6)/double(8)*U_3[idx] +
+                    double(3)/double(8)*U_2[idx]) +
+                omega_tilde_2*(double(3)/double(8)*U_3[idx] + double(6)/double(8)*U_2[idx] -
+                    double(1)/double(8)*U_1[idx]));
+        }
+    }
 }
 
 
@@ -215,6 +305,8 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::printClassData(
     os << "d_constant_p = "
        << d_constant_p
        << std::endl;
+    
+    printCommonClassData(os);
 }
 
 
@@ -227,6 +319,36 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::putToRestart(
    const boost::shared_ptr<tbox::Database>& restart_db) const
 {
     restart_db->putInteger("d_constant_p", d_constant_p);
+    
+    putCommonDataToRestart(restart_db);
+}
+
+
+/*
+ * Get the coefficients of the linear interpolation used on smooth patches. The coefficients are
+ * those of the fifth order upwind-biased interpolations.
+ */
+void
+ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::getLinearInterpolationCoefficients(
+    std::vector<double>& coeffs_minus,
+    std::vector<double>& coeffs_plus) const
+{
+    coeffs_minus.resize(6);
+    coeffs_plus.resize(6);
+    
+    coeffs_minus[0] = double(3)/double(128);
+    coeffs_minus[1] = -double(20)/double(128);
+    coeffs_minus[2] = double(90)/double(128);
+    coeffs_minus[3] = double(60)/double(128);
+    coeffs_minus[4] = -double(5)/double(128);
+    coeffs_minus[5] = double(0);
+    
+    coeffs_plus[0] = double(0);
+    coeffs_plus[1] = -double(5)/double(128);
+    coeffs_plus[2] = double(60)/double(128);
+    coeffs_plus[3] = double(90)/double(128);
+    coeffs_plus[4] = -double(20)/double(128);
+    coeffs_plus[5] = double(3)/double(128);
 }
 
 
@@ -251,7 +373,7 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
      */
     
     const hier::IntVector interior_dims = variables_minus[0]->getBox().numberCells();
-    
+
 #ifdef HAMERS_DEBUG_CHECK_DEV_ASSERTIONS
     for (int ei = 0; ei < d_num_eqn; ei++)
     {
@@ -300,20 +422,15 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             
             double* U_L = variables_minus[ei]->getPointer(0);
             
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = -1; i < interior_dim_0 + 2; i++)
-            {
-                // Compute the linear index of the mid-point.
-                const int idx_midpoint_x = i + 1;
-                
-                performLocalWENOInterpolationMinus(
-                    U_L,
-                    U_array.data(),
-                    idx_midpoint_x,
-                    d_constant_p);
-            }
+            // Compute the linear index of the first mid-point.
+            const int idx_midpoint_x = 0;
+            
+            performWENOInterpolationMinusOnRow(
+                U_L,
+                U_array.data(),
+                idx_midpoint_x,
+                interior_dim_0 + 3,
+                d_constant_p);
         }
         
         for (int ei = 0; ei < d_num_eqn; ei++)
@@ -328,22 +445,17 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             
             double* U_R = variables_plus[ei]->getPointer(0);
             
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = -1; i < interior_dim_0 + 2; i++)
-            {
-                // Compute the linear index of the mid-point.
-                const int idx_midpoint_x = i + 1;
-                
-                performLocalWENOInterpolationPlus(
-                    U_R,
-                    U_array.data(),
-                    idx_midpoint_x,
-                    d_constant_p);
-            }
+            // Compute the linear index of the first mid-point.
+            const int idx_midpoint_x = 0;
+            
+            performWENOInterpolationPlusOnRow(
+                U_R,
+                U_array.data(),
+                idx_midpoint_x,
+                interior_dim_0 + 3,
+                d_constant_p);
         }
-        
+    
     } // if (d_dim == tbox::Dimension(1))
     else if (d_dim == tbox::Dimension(2))
     {
@@ -372,21 +484,15 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             
             for (int j = 0; j < interior_dim_1; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = -1; i < interior_dim_0 + 2; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_x = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 3);
-                    
-                    performLocalWENOInterpolationMinus(
-                        U_L,
-                        U_array.data(),
-                        idx_midpoint_x,
-                        d_constant_p);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3);
+                
+                performWENOInterpolationMinusOnRow(
+                    U_L,
+                    U_array.data(),
+                    idx_midpoint_x,
+                    interior_dim_0 + 3,
+                    d_constant_p);
             }
         }
         
@@ -404,21 +510,15 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             
             for (int j = 0; j < interior_dim_1; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = -1; i < interior_dim_0 + 2; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_x = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 3);
-                    
-                    performLocalWENOInterpolationPlus(
-                        U_R,
-                        U_array.data(),
-                        idx_midpoint_x,
-                        d_constant_p);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3);
+                
+                performWENOInterpolationPlusOnRow(
+                    U_R,
+                    U_array.data(),
+                    idx_midpoint_x,
+                    interior_dim_0 + 3,
+                    d_constant_p);
             }
         }
         
@@ -440,21 +540,16 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             
             for (int j = -1; j < interior_dim_1 + 2; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_y = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2);
-                    
-                    performLocalWENOInterpolationMinus(
-                        U_B,
-                        U_array.data(),
-                        idx_midpoint_y,
-                        d_constant_p);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_y = 1 +
+                    (j + 1)*(interior_dim_0 + 2);
+                
+                performWENOInterpolationMinusOnRow(
+                    U_B,
+                    U_array.data(),
+                    idx_midpoint_y,
+                    interior_dim_0,
+                    d_constant_p);
             }
         }
         
@@ -472,24 +567,19 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             
             for (int j = -1; j < interior_dim_1 + 2; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_y = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2);
-                    
-                    performLocalWENOInterpolationPlus(
-                        U_T,
-                        U_array.data(),
-                        idx_midpoint_y,
-                        d_constant_p);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_y = 1 +
+                    (j + 1)*(interior_dim_0 + 2);
+                
+                performWENOInterpolationPlusOnRow(
+                    U_T,
+                    U_array.data(),
+                    idx_midpoint_y,
+                    interior_dim_0,
+                    d_constant_p);
             }
         }
-        
+    
     } // if (d_dim == tbox::Dimension(2))
     else if (d_dim == tbox::Dimension(3))
     {
@@ -521,23 +611,17 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = -1; i < interior_dim_0 + 2; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_x = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 3) +
-                            (k + 1)*(interior_dim_0 + 3)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationMinus(
-                            U_L,
-                            U_array.data(),
-                            idx_midpoint_x,
-                            d_constant_p);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3) +
+                        (k + 1)*(interior_dim_0 + 3)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationMinusOnRow(
+                        U_L,
+                        U_array.data(),
+                        idx_midpoint_x,
+                        interior_dim_0 + 3,
+                        d_constant_p);
                 }
             }
         }
@@ -558,23 +642,17 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = -1; i < interior_dim_0 + 2; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_x = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 3) +
-                            (k + 1)*(interior_dim_0 + 3)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationPlus(
-                            U_R,
-                            U_array.data(),
-                            idx_midpoint_x,
-                            d_constant_p);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3) +
+                        (k + 1)*(interior_dim_0 + 3)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationPlusOnRow(
+                        U_R,
+                        U_array.data(),
+                        idx_midpoint_x,
+                        interior_dim_0 + 3,
+                        d_constant_p);
                 }
             }
         }
@@ -599,23 +677,18 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = -1; j < interior_dim_1 + 2; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_y = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 3);
-                        
-                        performLocalWENOInterpolationMinus(
-                            U_B,
-                            U_array.data(),
-                            idx_midpoint_y,
-                            d_constant_p);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_y = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 3);
+                    
+                    performWENOInterpolationMinusOnRow(
+                        U_B,
+                        U_array.data(),
+                        idx_midpoint_y,
+                        interior_dim_0,
+                        d_constant_p);
                 }
             }
         }
@@ -636,23 +709,18 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = -1; j < interior_dim_1 + 2; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_y = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 3);
-                        
-                        performLocalWENOInterpolationPlus(
-                            U_T,
-                            U_array.data(),
-                            idx_midpoint_y,
-                            d_constant_p);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_y = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 3);
+                    
+                    performWENOInterpolationPlusOnRow(
+                        U_T,
+                        U_array.data(),
+                        idx_midpoint_y,
+                        interior_dim_0,
+                        d_constant_p);
                 }
             }
         }
@@ -677,23 +745,18 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_z = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationMinus(
-                            U_B,
-                            U_array.data(),
-                            idx_midpoint_z,
-                            d_constant_p);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_z = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationMinusOnRow(
+                        U_B,
+                        U_array.data(),
+                        idx_midpoint_z,
+                        interior_dim_0,
+                        d_constant_p);
                 }
             }
         }
@@ -714,26 +777,21 @@ ConvectiveFluxReconstructorWCNS5_Z_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_z = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationPlus(
-                            U_F,
-                            U_array.data(),
-                            idx_midpoint_z,
-                            d_constant_p);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_z = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationPlusOnRow(
+                        U_F,
+                        U_array.data(),
+                        idx_midpoint_z,
+                        interior_dim_0,
+                        d_constant_p);
                 }
             }
         }
-        
+    
     } // if (d_dim == tbox::Dimension(3))
 }
@@ -2,6 +2,69 @@
 
 #define EPSILON HAMERS_EPSILON
 
+
+/*
+ * Compute the linearly interpolated value at a mid-point from the six cells of the stencil. The
+ * cells are at offsets -3 to 2 times the stride from the cell on the right of the mid-point.
+ */
+static inline __attribute__((always_inline)) double interpolateLinearly(
+    const double* const c,
+    const double* const U,
+    const int idx_cell_R,
+    const int stride)
+{
+    return c[0]*U[idx_cell_R - 3*stride] + c[1]*U[idx_cell_R - 2*stride] + c[2]*U[idx_cell_R - stride] +
+        c[3]*U[idx_cell_R] + c[4]*U[idx_cell_R + stride] + c[5]*U[idx_cell_R + 2*stride];
+}
+
+
+/*
+ * Compute the local smoothness indicator (normalized second order difference) of a cell in the
+ * direction with the given stride.
+ */
+static inline __attribute__((always_inline)) double computeLocalSmoothnessIndicator(
+    const double* const U,
+    const int idx_cell,
+    const int stride)
+{
+    return fabs(U[idx_cell + stride] - double(2)*U[idx_cell] + U[idx_cell - stride])/
+        (fabs(U[idx_cell + stride]) + double(2)*fabs(U[idx_cell]) + fabs(U[idx_cell - stride]) + EPSILON);
+}
+
+
+/*
+ * Get the next temporary patch data from a pool. The pooled data is reused if it has the same
+ * depth, number of ghost cells and box dimensions as the requested one. Otherwise, it is replaced
+ * by newly allocated data.
+ */
+template <typename TYPE>
+static boost::shared_ptr<TYPE> getPooledPatchData(
+    std::vector<boost::shared_ptr<TYPE> >& pool,
+    int& num_used,
+    const hier::Box& box,
+    const int depth,
+    const hier::IntVector& num_ghosts)
+{
+    if (num_used < static_cast<int>(pool.size()))
+    {
+        const boost::shared_ptr<TYPE>& data = pool[num_used];
+        
+        if (data->getDepth() != depth ||
+            data->getGhostCellWidth() != num_ghosts ||
+            data->getBox().numberCells() != box.numberCells())
+        {
+            pool[num_used].reset(new TYPE(box, depth, num_ghosts));
+        }
+    }
+    else
+    {
+        pool.push_back(boost::shared_ptr<TYPE>(new TYPE(box, depth, num_ghosts)));
+    }
+    
+    return pool[num_used++];
+}
+
+
 ConvectiveFluxReconstructorWCNS56::ConvectiveFluxReconstructorWCNS56(
     const std::string& object_name,
     const tbox::Dimension& dim,
@@ -28,6 +91,108 @@ ConvectiveFluxReconstructorWCNS56::ConvectiveFluxReconstructorWCNS56(
             d_has_advective_eqn_form = true;
         }
     }
+    
+    /*
+     * Get the settings of the hybrid scheme. The linear scheme is used on patches that are
+     * smooth enough.
+     */
+    
+    d_use_hybrid_scheme = d_convective_flux_reconstructor_db->
+        getBoolWithDefault("use_hybrid_scheme", false);
+    d_use_hybrid_scheme = d_convective_flux_reconstructor_db->
+        getBoolWithDefault("d_use_hybrid_scheme", d_use_hybrid_scheme);
+    
+    d_hybrid_smoothness_threshold = d_convective_flux_reconstructor_db->
+        getDoubleWithDefault("hybrid_smoothness_threshold", double(1.0e-2));
+    d_hybrid_smoothness_threshold = d_convective_flux_reconstructor_db->
+        getDoubleWithDefault("d_hybrid_smoothness_threshold", d_hybrid_smoothness_threshold);
+    
+    d_num_cells_linear_scheme = double(0);
+    d_num_cells_nonlinear_scheme = double(0);
+    
+    d_num_temp_side_data_used = 0;
+    d_num_temp_cell_data_used = 0;
+    
+    /*
+     * Get whether the projection variables are frozen at the first Runge-Kutta stage of each time
+     * step.
+     */
+    
+    d_freeze_projection_variables = d_convective_flux_reconstructor_db->
+        getBoolWithDefault("freeze_projection_variables", false);
+    d_freeze_projection_variables = d_convective_flux_reconstructor_db->
+        getBoolWithDefault("d_freeze_projection_variables", d_freeze_projection_variables);
+}
+
+
+/*
+ * Print the fractions of cells computed with the linear and nonlinear schemes since the last
+ * call.
+ */
+void
+ConvectiveFluxReconstructorWCNS56::printSchemeStatistics(std::ostream& os)
+{
+    if (d_use_hybrid_scheme)
+    {
+        const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
+        
+        double num_cells_local[2];
+        double num_cells_global[2];
+        
+        num_cells_local[0] = d_num_cells_linear_scheme;
+        num_cells_local[1] = d_num_cells_nonlinear_scheme;
+        
+        mpi.Allreduce(
+            num_cells_local,
+            num_cells_global,
+            2,
+            MPI_DOUBLE,
+            MPI_SUM);
+        
+        const double num_cells_total = num_cells_global[0] + num_cells_global[1];
+        
+        if (num_cells_total > double(0))
+        {
+            os << "Fraction of cells with linear/nonlinear scheme: "
+               << num_cells_global[0]/num_cells_total << "/"
+               << num_cells_global[1]/num_cells_total
+               << std::endl;
+        }
+        
+        d_num_cells_linear_scheme = double(0);
+        d_num_cells_nonlinear_scheme = double(0);
+    }
+}
+
+
+/*
+ * Print the settings shared by all WCNS56 schemes.
+ */
+void
+ConvectiveFluxReconstructorWCNS56::printCommonClassData(std::ostream& os) const
+{
+    os << "d_use_hybrid_scheme = "
+       << d_use_hybrid_scheme
+       << std::endl;
+    os << "d_hybrid_smoothness_threshold = "
+       << d_hybrid_smoothness_threshold
+       << std::endl;
+    os << "d_freeze_projection_variables = "
+       << d_freeze_projection_variables
+       << std::endl;
+}
+
+
+/*
+ * Put the settings shared by all WCNS56 schemes into the restart database.
+ */
+void
+ConvectiveFluxReconstructorWCNS56::putCommonDataToRestart(
+    const boost::shared_ptr<tbox::Database>& restart_db) const
+{
+    restart_db->putBool("d_use_hybrid_scheme", d_use_hybrid_scheme);
+    restart_db->putDouble("d_hybrid_smoothness_threshold", d_hybrid_smoothness_threshold);
+    restart_db->putBool("d_freeze_projection_variables", d_freeze_projection_variables);
 }
 
 
@@ -44,12 +209,13 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
     const double dt,
     const int RK_step_number)
 {
-    NULL_USE(time);
-    NULL_USE(RK_step_number);
-    
     d_flow_model->setupRiemannSolver();
     d_riemann_solver = d_flow_model->getFlowModelRiemannSolver();
     
+    // Start to hand out the pooled temporary patch data from the beginning.
+    d_num_temp_side_data_used = 0;
+    d_num_temp_cell_data_used = 0;
+    
     // Get the dimensions of box that covers the interior of patch.
     hier::Box interior_box = patch.getBox();
     const hier::IntVector interior_dims = interior_box.numberCells();
@@ -90,22 +256,22 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
     
     if (d_has_advective_eqn_form)
     {
-        velocity_midpoint.reset(new pdat::SideData<double>(
-            interior_box, d_dim.getValue(), hier::IntVector::getOne(d_dim)));
+        velocity_midpoint = getTemporarySideData(
+            interior_box, d_dim.getValue(), hier::IntVector::getOne(d_dim));
     }
     
-    boost::shared_ptr<pdat::SideData<double> > convective_flux_midpoint(
-        new pdat::SideData<double>(interior_box, d_num_eqn, hier::IntVector::getOne(d_dim)));
+    boost::shared_ptr<pdat::SideData<double> > convective_flux_midpoint =
+        getTemporarySideData(interior_box, d_num_eqn, hier::IntVector::getOne(d_dim));
     
-    boost::shared_ptr<pdat::SideData<double> > convective_flux_midpoint_HLLC(
-        new pdat::SideData<double>(interior_box, d_num_eqn, hier::IntVector::getOne(d_dim)));
+    boost::shared_ptr<pdat::SideData<double> > convective_flux_midpoint_HLLC =
+        getTemporarySideData(interior_box, d_num_eqn, hier::IntVector::getOne(d_dim));
     
     boost::shared_ptr<pdat::SideData<double> > convective_flux_midpoint_HLLC_HLL;
     
     if (d_dim > tbox::Dimension(1))
     {
-        convective_flux_midpoint_HLLC_HLL.reset(new pdat::SideData<double>(
-            interior_box, d_num_eqn, hier::IntVector::getOne(d_dim)));
+        convective_flux_midpoint_HLLC_HLL = getTemporarySideData(
+            interior_box, d_num_eqn, hier::IntVector::getOne(d_dim));
     }
     
     boost::shared_ptr<pdat::CellData<double> > velocity_derivatives;
@@ -115,19 +281,22 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
     
     if (d_dim > tbox::Dimension(1))
     {
-        velocity_derivatives.reset(new pdat::CellData<double>(
-            interior_box, d_dim.getValue()*d_dim.getValue(), hier::IntVector::getOne(d_dim)*2));
+        velocity_derivatives = getTemporaryCellData(
+            interior_box, d_dim.getValue()*d_dim.getValue(), hier::IntVector::getOne(d_dim)*2);
         
-        dilatation.reset(new pdat::CellData<double>(
-            interior_box, 1, hier::IntVector::getOne(d_dim)*2));
+        dilatation = getTemporaryCellData(
+            interior_box, 1, hier::IntVector::getOne(d_dim)*2);
         
-        vorticity_magnitude.reset(new pdat::CellData<double>(
-            interior_box, 1, hier::IntVector::getOne(d_dim)*2));
+        vorticity_magnitude = getTemporaryCellData(
+            interior_box, 1, hier::IntVector::getOne(d_dim)*2);
         
-        shock_sensor.reset(new pdat::SideData<double>(
-            interior_box, 1, hier::IntVector::getOne(d_dim)));
+        shock_sensor = getTemporarySideData(
+            interior_box, 1, hier::IntVector::getOne(d_dim));
     }
     
+    // Whether the linear scheme is used on the patch.
+    bool is_patch_smooth = false;
+    
     if (d_dim == tbox::Dimension(1))
     {
         /*
@@ -203,15 +372,9 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         std::vector<hier::IntVector> num_subghosts_conservative_var;
         num_subghosts_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> num_subghosts_primitive_var;
-        num_subghosts_primitive_var.reserve(d_num_eqn);
-        
         std::vector<double*> Q;
         Q.reserve(d_num_eqn);
         
-        std::vector<double*> V;
-        V.reserve(d_num_eqn);
-        
         int count_eqn = 0;
         
         for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
@@ -232,24 +395,16 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
             }
         }
         
-        count_eqn = 0;
+        /*
+         * Check whether the patch is smooth enough for the linear scheme.
+         */
         
-        for (int vi = 0; vi < static_cast<int>(primitive_variables.size()); vi++)
+        if (d_use_hybrid_scheme)
         {
-            int depth = primitive_variables[vi]->getDepth();
-            
-            for (int di = 0; di < depth; di++)
-            {
-                // If the last element of the primitive variable vector is not in the system of equations,
-                // ignore it.
-                if (count_eqn >= d_num_eqn)
-                    break;
-                
-                V.push_back(primitive_variables[vi]->getPointer(di));
-                num_subghosts_primitive_var.push_back(primitive_variables[vi]->getGhostCellWidth());
-                
-                count_eqn++;
-            }
+            is_patch_smooth = isPatchSmooth(
+                primitive_variables,
+                dilatation,
+                vorticity_magnitude);
         }
         
         /*
@@ -266,162 +421,122 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_minus;
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_plus;
         
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_minus;
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_plus;
-        
         /*
-         * Initialize temporary data containers for WENO interpolation.
+         * Initialize temporary data containers for the interpolated primitive variables.
          */
         
-        int num_projection_var = d_flow_model->getNumberOfProjectionVariablesForPrimitiveVariables();
-        projection_variables.reserve(num_projection_var);
-        
-        for (int vi = 0; vi < num_projection_var; vi++)
-        {
-            projection_variables.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
-        }
-        
-        characteristic_variables.resize(6);
-        
-        for (int m = 0; m < 6; m++)
-        {
-            characteristic_variables[m].reserve(d_num_eqn);
-            for (int ei = 0; ei < d_num_eqn; ei++)
-            {
-                characteristic_variables[m].push_back(boost::make_shared<pdat::SideData<double> >(
-                    interior_box, 1, hier::IntVector::getOne(d_dim)));
-            }
-        }
-        
-        characteristic_variables_minus.reserve(d_num_eqn);
-        characteristic_variables_plus.reserve(d_num_eqn);
         primitive_variables_minus.reserve(d_num_eqn);
         primitive_variables_plus.reserve(d_num_eqn);
         
         for (int ei = 0; ei < d_num_eqn; ei++)
         {
-            characteristic_variables_minus.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
-            
-            characteristic_variables_plus.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
-            
-            primitive_variables_minus.push_back(boost::make_shared<pdat::SideData<double> >(
+            primitive_variables_minus.push_back(getTemporarySideData(
                 interior_box, 1, hier::IntVector::getOne(d_dim)));
             
-            primitive_variables_plus.push_back(boost::make_shared<pdat::SideData<double> >(
+            primitive_variables_plus.push_back(getTemporarySideData(
                 interior_box, 1, hier::IntVector::getOne(d_dim)));
         }
         
-        bounded_flag_minus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
-        bounded_flag_plus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
-        /*
-         * Compute global side data of the projection variables for transformation between
-         * primitive variables and characteristic variables.
-         */
-        
-        d_flow_model->computeGlobalSideDataProjectionVariablesForPrimitiveVariables(
-            projection_variables);
-        
-        /*
-         * Transform primitive variables to characteristic variables.
-         */
-        
-        for (int m = 0; m < 6; m++)
-        {
-            d_flow_model->computeGlobalSideDataCharacteristicVariablesFromPrimitiveVariables(
-                characteristic_variables[m],
-                primitive_variables,
-                projection_variables,
-                m - 3);
-        }
-        
-        /*
-         * Peform WENO interpolation.
-         */
-        
-        performWENOInterpolation(
-            characteristic_variables_minus,
-            characteristic_variables_plus,
-            characteristic_variables);
-        
-        /*
-         * Transform characteristic variables back to primitive variables.
-         */
-        
-        d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
-            primitive_variables_minus,
-            characteristic_variables_minus,
-            projection_variables);
-        
-        d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
-            primitive_variables_plus,
-            characteristic_variables_plus,
-            projection_variables);
-        
-        /*
-         * Declare containers to store pointers for computing mid-point fluxes.
-         */
-        
-        std::vector<double*> V_minus;
-        std::vector<double*> V_plus;
-        V_minus.resize(d_num_eqn);
-        V_plus.resize(d_num_eqn);
-        
-        int* flag_minus = nullptr;
-        int* flag_plus = nullptr;
-        
-        /*
-         * Check whether the interpolated side primitive variables are within the bounds.
-         */
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_minus,
-            primitive_variables_minus);
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_plus,
-            primitive_variables_plus);
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in x-direction
-         * are out of bounds.
-         */
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
+        if (is_patch_smooth)
         {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(0);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(0);
+            /*
+             * Perform linear interpolation on the primitive variables directly. Since the
+             * characteristic projection is linear, this is the same as interpolating the
+             * characteristic variables with the optimal linear weights.
+             */
+            
+            performLinearInterpolation(
+                primitive_variables_minus,
+                primitive_variables_plus,
+                primitive_variables);
         }
-        
-        flag_minus = bounded_flag_minus->getPointer(0);
-        flag_plus = bounded_flag_plus->getPointer(0);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
+        else
         {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
+            /*
+             * Initialize temporary data containers for WENO interpolation.
+             */
             
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = -1; i < interior_dim_0 + 2; i++)
+            characteristic_variables.resize(6);
+            
+            for (int m = 0; m < 6; m++)
             {
-                // Compute the linear indices.
-                const int idx_midpoint_x = i + 1;
-                const int idx_cell_L = i - 1 + num_subghosts_0_primitive_var;
-                const int idx_cell_R = i + num_subghosts_0_primitive_var;
-                
-                if (flag_minus[idx_midpoint_x] == 0 || flag_plus[idx_midpoint_x] == 0)
+                characteristic_variables[m].reserve(d_num_eqn);
+                for (int ei = 0; ei < d_num_eqn; ei++)
                 {
-                    V_minus[ei][idx_midpoint_x] = V[ei][idx_cell_L];
-                    V_plus[ei][idx_midpoint_x] = V[ei][idx_cell_R];
+                    characteristic_variables[m].push_back(getTemporarySideData(
+                        interior_box, 1, hier::IntVector::getOne(d_dim)));
                 }
             }
+            
+            characteristic_variables_minus.reserve(d_num_eqn);
+            characteristic_variables_plus.reserve(d_num_eqn);
+            
+            for (int ei = 0; ei < d_num_eqn; ei++)
+            {
+                characteristic_variables_minus.push_back(getTemporarySideData(
+                    interior_box, 1, hier::IntVector::getOne(d_dim)));
+                
+                characteristic_variables_plus.push_back(getTemporarySideData(
+                    interior_box, 1, hier::IntVector::getOne(d_dim)));
+            }
+            
+            /*
+             * Compute global side data of the projection variables for transformation between
+             * primitive variables and characteristic variables or get the data frozen at the
+             * first Runge-Kutta stage.
+             */
+            
+            computeProjectionVariables(
+                projection_variables,
+                patch,
+                time,
+                RK_step_number);
+            
+            /*
+             * Transform primitive variables to characteristic variables.
+             */
+            
+            for (int m = 0; m < 6; m++)
+            {
+                d_flow_model->computeGlobalSideDataCharacteristicVariablesFromPrimitiveVariables(
+                    characteristic_variables[m],
+                    primitive_variables,
+                    projection_variables,
+                    m - 3);
+            }
+            
+            /*
+             * Peform WENO interpolation.
+             */
+            
+            performWENOInterpolation(
+                characteristic_variables_minus,
+                characteristic_variables_plus,
+                characteristic_variables);
+            
+            /*
+             * Transform characteristic variables back to primitive variables.
+             */
+            
+            d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
+                primitive_variables_minus,
+                characteristic_variables_minus,
+                projection_variables);
+            
+            d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
+                primitive_variables_plus,
+                characteristic_variables_plus,
+                projection_variables);
+            
+            /*
+             * Limit the interpolated side primitive variables with the positivity-preserving scaling
+             * limiter so that they are within the bounds.
+             */
+            
+            d_flow_model->limitGlobalSideDataPrimitiveVariables(
+                primitive_variables_minus,
+                primitive_variables_plus,
+                primitive_variables);
         }
         
         /*
@@ -737,21 +852,12 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         std::vector<hier::IntVector> num_subghosts_conservative_var;
         num_subghosts_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> num_subghosts_primitive_var;
-        num_subghosts_primitive_var.reserve(d_num_eqn);
-        
         std::vector<hier::IntVector> subghostcell_dims_conservative_var;
         subghostcell_dims_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> subghostcell_dims_primitive_var;
-        subghostcell_dims_primitive_var.reserve(d_num_eqn);
-        
         std::vector<double*> Q;
         Q.reserve(d_num_eqn);
         
-        std::vector<double*> V;
-        V.reserve(d_num_eqn);
-        
         int count_eqn = 0;
         
         for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
@@ -774,26 +880,16 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
             }
         }
         
-        count_eqn = 0;
+        /*
+         * Check whether the patch is smooth enough for the linear scheme.
+         */
         
-        for (int vi = 0; vi < static_cast<int>(primitive_variables.size()); vi++)
+        if (d_use_hybrid_scheme)
         {
-            int depth = primitive_variables[vi]->getDepth();
-            
-            for (int di = 0; di < depth; di++)
-            {
-                // If the last element of the primitive variable vector is not in the system of equations,
-                // ignore it.
-                if (count_eqn >= d_num_eqn)
-                    break;
-                
-                V.push_back(primitive_variables[vi]->getPointer(di));
-                num_subghosts_primitive_var.push_back(primitive_variables[vi]->getGhostCellWidth());
-                subghostcell_dims_primitive_var.push_back(
-                    primitive_variables[vi]->getGhostBox().numberCells());
-                
-                count_eqn++;
-            }
+            is_patch_smooth = isPatchSmooth(
+                primitive_variables,
+                dilatation,
+                vorticity_magnitude);
         }
         
         /*
@@ -810,148 +906,186 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_minus;
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_plus;
         
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_minus;
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_plus;
-        
         /*
-         * Initialize temporary data containers for WENO interpolation.
+         * Initialize temporary data containers for the interpolated primitive variables.
          */
         
-        int num_projection_var = d_flow_model->getNumberOfProjectionVariablesForPrimitiveVariables();
-        projection_variables.reserve(num_projection_var);
+        primitive_variables_minus.reserve(d_num_eqn);
+        primitive_variables_plus.reserve(d_num_eqn);
         
-        for (int vi = 0; vi < num_projection_var; vi++)
+        for (int ei = 0; ei < d_num_eqn; ei++)
         {
-            projection_variables.push_back(boost::make_shared<pdat::SideData<double> >(
+            primitive_variables_minus.push_back(getTemporarySideData(
+                interior_box, 1, hier::IntVector::getOne(d_dim)));
+            
+            primitive_variables_plus.push_back(getTemporarySideData(
                 interior_box, 1, hier::IntVector::getOne(d_dim)));
         }
         
-        characteristic_variables.resize(6);
-        
-        for (int m = 0; m < 6; m++)
+        if (is_patch_smooth)
+        {
+            /*
+             * Perform linear interpolation on the primitive variables directly. Since the
+             * characteristic projection is linear, this is the same as interpolating the
+             * characteristic variables with the optimal linear weights.
+             */
+            
+            performLinearInterpolation(
+                primitive_variables_minus,
+                primitive_variables_plus,
+                primitive_variables);
+        }
+        else
         {
-            characteristic_variables[m].reserve(d_num_eqn);
+            /*
+             * Initialize temporary data containers for WENO interpolation.
+             */
+            
+            characteristic_variables.resize(6);
+            
+            for (int m = 0; m < 6; m++)
+            {
+                characteristic_variables[m].reserve(d_num_eqn);
+                for (int ei = 0; ei < d_num_eqn; ei++)
+                {
+                    characteristic_variables[m].push_back(getTemporarySideData(
+                        interior_box, 1, hier::IntVector::getOne(d_dim)));
+                }
+            }
+            
+            characteristic_variables_minus.reserve(d_num_eqn);
+            characteristic_variables_plus.reserve(d_num_eqn);
+            
             for (int ei = 0; ei < d_num_eqn; ei++)
             {
-                characteristic_variables[m].push_back(boost::make_shared<pdat::SideData<double> >(
+                characteristic_variables_minus.push_back(getTemporarySideData(
+                    interior_box, 1, hier::IntVector::getOne(d_dim)));
+                
+                characteristic_variables_plus.push_back(getTemporarySideData(
                     interior_box, 1, hier::IntVector::getOne(d_dim)));
             }
-        }
-        
-        characteristic_variables_minus.reserve(d_num_eqn);
-        characteristic_variables_plus.reserve(d_num_eqn);
-        primitive_variables_minus.reserve(d_num_eqn);
-        primitive_variables_plus.reserve(d_num_eqn);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            characteristic_variables_minus.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
             
-            characteristic_variables_plus.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
+            /*
+             * Compute global side data of the projection variables for transformation between
+             * primitive variables and characteristic variables or get the data frozen at the
+             * first Runge-Kutta stage.
+             */
             
-            primitive_variables_minus.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
+            computeProjectionVariables(
+                projection_variables,
+                patch,
+                time,
+                RK_step_number);
             
-            primitive_variables_plus.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
+            /*
+             * Transform primitive variables to characteristic variables.
+             */
+            
+            for (int m = 0; m < 6; m++)
+            {
+                d_flow_model->computeGlobalSideDataCharacteristicVariablesFromPrimitiveVariables(
+                    characteristic_variables[m],
+                    primitive_variables,
+                    projection_variables,
+                    m - 3);
+            }
+            
+            /*
+             * Peform WENO interpolation.
+             */
+            
+            performWENOInterpolation(
+                characteristic_variables_minus,
+                characteristic_variables_plus,
+                characteristic_variables);
+            
+            /*
+             * Transform characteristic variables back to primitive variables.
+             */
+            
+            d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
+                primitive_variables_minus,
+                characteristic_variables_minus,
+                projection_variables);
+            
+            d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
+                primitive_variables_plus,
+                characteristic_variables_plus,
+                projection_variables);
+            
+            /*
+             * Limit the interpolated side primitive variables with the positivity-preserving scaling
+             * limiter so that they are within the bounds.
+             */
+            
+            d_flow_model->limitGlobalSideDataPrimitiveVariables(
+                primitive_variables_minus,
+                primitive_variables_plus,
+                primitive_variables);
         }
         
-        bounded_flag_minus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
-        bounded_flag_plus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
-        /*
-         * Compute global side data of the projection variables for transformation between
-         * primitive variables and characteristic variables.
-         */
-        
-        d_flow_model->computeGlobalSideDataProjectionVariablesForPrimitiveVariables(
-            projection_variables);
-        
         /*
-         * Transform primitive variables to characteristic variables.
+         * Compute mid-point flux in the x-direction.
          */
         
-        for (int m = 0; m < 6; m++)
+        if (is_patch_smooth)
         {
-            d_flow_model->computeGlobalSideDataCharacteristicVariablesFromPrimitiveVariables(
-                characteristic_variables[m],
-                primitive_variables,
-                projection_variables,
-                m - 3);
-        }
-        
-        /*
-         * Peform WENO interpolation.
-         */
-        
-        performWENOInterpolation(
-            characteristic_variables_minus,
-            characteristic_variables_plus,
-            characteristic_variables);
-        
-        /*
-         * Transform characteristic variables back to primitive variables.
-         */
-        
-        d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
-            primitive_variables_minus,
-            characteristic_variables_minus,
-            projection_variables);
-        
-        d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
-            primitive_variables_plus,
-            characteristic_variables_plus,
-            projection_variables);
-        
-        /*
-         * Declare containers to store pointers for computing mid-point fluxes.
-         */
-        
-        std::vector<double*> V_minus;
-        std::vector<double*> V_plus;
-        V_minus.resize(d_num_eqn);
-        V_plus.resize(d_num_eqn);
-        
-        int* flag_minus = nullptr;
-        int* flag_plus = nullptr;
-        
-        /*
-         * Check whether the interpolated side primitive variables are within the bounds.
-         */
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_minus,
-            primitive_variables_minus);
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_plus,
-            primitive_variables_plus);
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in x-direction
-         * are out of bounds.
-         */
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(0);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(0);
+            /*
+             * The interpolated states on both sides of the mid-points are identical on a smooth
+             * patch. Both Riemann solvers then reduce to the physical flux and the shock sensor
+             * is not needed.
+             */
+            
+            if (d_has_advective_eqn_form)
+            {
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::X_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            else
+            {
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::X_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
         }
-        
-        flag_minus = bounded_flag_minus->getPointer(0);
-        flag_plus = bounded_flag_plus->getPointer(0);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
+        else
         {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
+            if (d_has_advective_eqn_form)
+            {
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::X_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            else
+            {
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::X_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            
+            d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                convective_flux_midpoint_HLLC_HLL,
+                primitive_variables_minus,
+                primitive_variables_plus,
+                DIRECTION::X_DIRECTION,
+                RIEMANN_SOLVER::HLLC_HLL);
             
+            // Compute the Ducros-like shock sensor.
             for (int j = 0; j < interior_dim_1; j++)
             {
 #ifdef HAMERS_ENABLE_SIMD
@@ -959,210 +1093,111 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
 #endif
                 for (int i = -1; i < interior_dim_0 + 2; i++)
                 {
-                    // Compute the linear indices.
+                    // Compute the linear index of the side.
                     const int idx_midpoint_x = (i + 1) +
                         (j + 1)*(interior_dim_0 + 3);
                     
-                    const int idx_cell_L = (i - 1 + num_subghosts_0_primitive_var) +
-                        (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var;
+                    const int idx_L = (i + 1) +
+                        (j + 2)*(interior_dim_0 + 4);
                     
-                    const int idx_cell_R = (i + num_subghosts_0_primitive_var) +
-                        (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var;
+                    const int idx_R = (i + 2) +
+                        (j + 2)*(interior_dim_0 + 4);
                     
-                    if (flag_minus[idx_midpoint_x] == 0 || flag_plus[idx_midpoint_x] == 0)
-                    {
-                        V_minus[ei][idx_midpoint_x] = V[ei][idx_cell_L];
-                        V_plus[ei][idx_midpoint_x] = V[ei][idx_cell_R];
-                    }
+                    double theta_avg = 0.5*(theta[idx_L] + theta[idx_R]);
+                    double Omega_avg = 0.5*(Omega[idx_L] + Omega[idx_R]);
+                    
+                    s_x[idx_midpoint_x] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
                 }
             }
-        }
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in y-direction
-         * are out of bounds.
-         */
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(1);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(1);
-        }
-        
-        flag_minus = bounded_flag_minus->getPointer(1);
-        flag_plus = bounded_flag_plus->getPointer(1);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
             
-            for (int j = -1; j < interior_dim_1 + 2; j++)
+            for (int ei = 0; ei < d_num_eqn; ei++)
             {
+                for (int j = 0; j < interior_dim_1; j++)
+                {
 #ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
+                    #pragma omp simd
 #endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear indices.
-                    const int idx_midpoint_y = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2);
-                    
-                    const int idx_cell_B = (i + num_subghosts_0_primitive_var) +
-                        (j - 1 + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var;
-                    
-                    const int idx_cell_T = (i + num_subghosts_0_primitive_var) +
-                        (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var;
-                    
-                    if (flag_minus[idx_midpoint_y] == 0 || flag_plus[idx_midpoint_y] == 0)
+                    for (int i = -1; i < interior_dim_0 + 2; i++)
                     {
-                        V_minus[ei][idx_midpoint_y] = V[ei][idx_cell_B];
-                        V_plus[ei][idx_midpoint_y] = V[ei][idx_cell_T];
+                        // Compute the linear index of the side.
+                        const int idx_midpoint_x = (i + 1) +
+                            (j + 1)*(interior_dim_0 + 3);
+                        
+                        if (s_x[idx_midpoint_x] > 0.65)
+                        {
+                            F_midpoint_x[ei][idx_midpoint_x] = F_midpoint_HLLC_HLL_x[ei][idx_midpoint_x];
+                        }
+                        else
+                        {
+                            F_midpoint_x[ei][idx_midpoint_x] = F_midpoint_HLLC_x[ei][idx_midpoint_x];
+                        }
                     }
                 }
             }
         }
         
         /*
-         * Compute mid-point flux in the x-direction.
+         * Compute mid-point flux in the y-direction.
          */
         
-        if (d_has_advective_eqn_form)
-        {
-            d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
-                velocity_midpoint,
-                primitive_variables_minus,
-                primitive_variables_plus,
-                DIRECTION::X_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
-        else
-        {
-            d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
-                primitive_variables_minus,
-                primitive_variables_plus,
-                DIRECTION::X_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
-        
-        d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-            convective_flux_midpoint_HLLC_HLL,
-            primitive_variables_minus,
-            primitive_variables_plus,
-            DIRECTION::X_DIRECTION,
-            RIEMANN_SOLVER::HLLC_HLL);
-        
-        // Compute the Ducros-like shock sensor.
-        for (int j = 0; j < interior_dim_1; j++)
+        if (is_patch_smooth)
         {
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = -1; i < interior_dim_0 + 2; i++)
+            /*
+             * The interpolated states on both sides of the mid-points are identical on a smooth
+             * patch. Both Riemann solvers then reduce to the physical flux and the shock sensor
+             * is not needed.
+             */
+            
+            if (d_has_advective_eqn_form)
             {
-                // Compute the linear index of the side.
-                const int idx_midpoint_x = (i + 1) +
-                    (j + 1)*(interior_dim_0 + 3);
-                
-                const int idx_L = (i + 1) +
-                    (j + 2)*(interior_dim_0 + 4);
-                
-                const int idx_R = (i + 2) +
-                    (j + 2)*(interior_dim_0 + 4);
-                
-                double theta_avg = 0.5*(theta[idx_L] + theta[idx_R]);
-                double Omega_avg = 0.5*(Omega[idx_L] + Omega[idx_R]);
-                
-                s_x[idx_midpoint_x] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Y_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
             }
-        }
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            for (int j = 0; j < interior_dim_1; j++)
+            else
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = -1; i < interior_dim_0 + 2; i++)
-                {
-                    // Compute the linear index of the side.
-                    const int idx_midpoint_x = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 3);
-                    
-                    if (s_x[idx_midpoint_x] > 0.65)
-                    {
-                        F_midpoint_x[ei][idx_midpoint_x] = F_midpoint_HLLC_HLL_x[ei][idx_midpoint_x];
-                    }
-                    else
-                    {
-                        F_midpoint_x[ei][idx_midpoint_x] = F_midpoint_HLLC_x[ei][idx_midpoint_x];
-                    }
-                }
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Y_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
             }
         }
-        
-        /*
-         * Compute mid-point flux in the y-direction.
-         */
-        
-        if (d_has_advective_eqn_form)
-        {
-            d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
-                velocity_midpoint,
-                primitive_variables_minus,
-                primitive_variables_plus,
-                DIRECTION::Y_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
         else
         {
+            if (d_has_advective_eqn_form)
+            {
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Y_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            else
+            {
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Y_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            
             d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
+                convective_flux_midpoint_HLLC_HLL,
                 primitive_variables_minus,
                 primitive_variables_plus,
                 DIRECTION::Y_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
-        
-        d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-            convective_flux_midpoint_HLLC_HLL,
-            primitive_variables_minus,
-            primitive_variables_plus,
-            DIRECTION::Y_DIRECTION,
-            RIEMANN_SOLVER::HLLC_HLL);
-        
-        // Compute the Ducros-like shock sensor.
-        for (int j = -1; j < interior_dim_1 + 2; j++)
-        {
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = 0; i < interior_dim_0; i++)
-            {
-                // Compute the linear index of the side.
-                const int idx_midpoint_y = (i + 1) +
-                    (j + 1)*(interior_dim_0 + 2);
-                
-                const int idx_B = (i + 2) +
-                    (j + 1)*(interior_dim_0 + 4);
-                
-                const int idx_T = (i + 2) +
-                    (j + 2)*(interior_dim_0 + 4);
-                
-                double theta_avg = 0.5*(theta[idx_B] + theta[idx_T]);
-                double Omega_avg = 0.5*(Omega[idx_B] + Omega[idx_T]);
-                
-                s_y[idx_midpoint_y] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
-            }
-        }
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
+                RIEMANN_SOLVER::HLLC_HLL);
+            
+            // Compute the Ducros-like shock sensor.
             for (int j = -1; j < interior_dim_1 + 2; j++)
             {
 #ifdef HAMERS_ENABLE_SIMD
@@ -1174,13 +1209,40 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
                     const int idx_midpoint_y = (i + 1) +
                         (j + 1)*(interior_dim_0 + 2);
                     
-                    if (s_y[idx_midpoint_y] > 0.65)
-                    {
-                        F_midpoint_y[ei][idx_midpoint_y] = F_midpoint_HLLC_HLL_y[ei][idx_midpoint_y];
-                    }
-                    else
+                    const int idx_B = (i + 2) +
+                        (j + 1)*(interior_dim_0 + 4);
+                    
+                    const int idx_T = (i + 2) +
+                        (j + 2)*(interior_dim_0 + 4);
+                    
+                    double theta_avg = 0.5*(theta[idx_B] + theta[idx_T]);
+                    double Omega_avg = 0.5*(Omega[idx_B] + Omega[idx_T]);
+                    
+                    s_y[idx_midpoint_y] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
+                }
+            }
+            
+            for (int ei = 0; ei < d_num_eqn; ei++)
+            {
+                for (int j = -1; j < interior_dim_1 + 2; j++)
+                {
+#ifdef HAMERS_ENABLE_SIMD
+                    #pragma omp simd
+#endif
+                    for (int i = 0; i < interior_dim_0; i++)
                     {
-                        F_midpoint_y[ei][idx_midpoint_y] = F_midpoint_HLLC_y[ei][idx_midpoint_y];
+                        // Compute the linear index of the side.
+                        const int idx_midpoint_y = (i + 1) +
+                            (j + 1)*(interior_dim_0 + 2);
+                        
+                        if (s_y[idx_midpoint_y] > 0.65)
+                        {
+                            F_midpoint_y[ei][idx_midpoint_y] = F_midpoint_HLLC_HLL_y[ei][idx_midpoint_y];
+                        }
+                        else
+                        {
+                            F_midpoint_y[ei][idx_midpoint_y] = F_midpoint_HLLC_y[ei][idx_midpoint_y];
+                        }
                     }
                 }
             }
@@ -1664,21 +1726,12 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         std::vector<hier::IntVector> num_subghosts_conservative_var;
         num_subghosts_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> num_subghosts_primitive_var;
-        num_subghosts_primitive_var.reserve(d_num_eqn);
-        
         std::vector<hier::IntVector> subghostcell_dims_conservative_var;
         subghostcell_dims_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> subghostcell_dims_primitive_var;
-        subghostcell_dims_primitive_var.reserve(d_num_eqn);
-        
         std::vector<double*> Q;
         Q.reserve(d_num_eqn);
         
-        std::vector<double*> V;
-        V.reserve(d_num_eqn);
-        
         int count_eqn = 0;
         
         for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
@@ -1701,26 +1754,16 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
             }
         }
         
-        count_eqn = 0;
+        /*
+         * Check whether the patch is smooth enough for the linear scheme.
+         */
         
-        for (int vi = 0; vi < static_cast<int>(primitive_variables.size()); vi++)
+        if (d_use_hybrid_scheme)
         {
-            int depth = primitive_variables[vi]->getDepth();
-            
-            for (int di = 0; di < depth; di++)
-            {
-                // If the last element of the primitive variable vector is not in the system of equations,
-                // ignore it.
-                if (count_eqn >= d_num_eqn)
-                    break;
-                
-                V.push_back(primitive_variables[vi]->getPointer(di));
-                num_subghosts_primitive_var.push_back(primitive_variables[vi]->getGhostCellWidth());
-                subghostcell_dims_primitive_var.push_back(
-                    primitive_variables[vi]->getGhostBox().numberCells());
-                
-                count_eqn++;
-            }
+            is_patch_smooth = isPatchSmooth(
+                primitive_variables,
+                dilatation,
+                vorticity_magnitude);
         }
         
         /*
@@ -1737,150 +1780,186 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_minus;
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_plus;
         
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_minus;
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_plus;
-        
         /*
-         * Initialize temporary data containers for WENO interpolation.
+         * Initialize temporary data containers for the interpolated primitive variables.
          */
         
-        int num_projection_var = d_flow_model->getNumberOfProjectionVariablesForPrimitiveVariables();
-        projection_variables.reserve(num_projection_var);
-        
-        for (int vi = 0; vi < num_projection_var; vi++)
-        {
-            projection_variables.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
-        }
-        
-        characteristic_variables.resize(6);
-        
-        for (int m = 0; m < 6; m++)
-        {
-            characteristic_variables[m].reserve(d_num_eqn);
-            for (int ei = 0; ei < d_num_eqn; ei++)
-            {
-                characteristic_variables[m].push_back(boost::make_shared<pdat::SideData<double> >(
-                    interior_box, 1, hier::IntVector::getOne(d_dim)));
-            }
-        }
-        
-        characteristic_variables_minus.reserve(d_num_eqn);
-        characteristic_variables_plus.reserve(d_num_eqn);
         primitive_variables_minus.reserve(d_num_eqn);
         primitive_variables_plus.reserve(d_num_eqn);
         
         for (int ei = 0; ei < d_num_eqn; ei++)
         {
-            characteristic_variables_minus.push_back(boost::make_shared<pdat::SideData<double> >(
+            primitive_variables_minus.push_back(getTemporarySideData(
                 interior_box, 1, hier::IntVector::getOne(d_dim)));
             
-            characteristic_variables_plus.push_back(boost::make_shared<pdat::SideData<double> >(
+            primitive_variables_plus.push_back(getTemporarySideData(
                 interior_box, 1, hier::IntVector::getOne(d_dim)));
+        }
+        
+        if (is_patch_smooth)
+        {
+            /*
+             * Perform linear interpolation on the primitive variables directly. Since the
+             * characteristic projection is linear, this is the same as interpolating the
+             * characteristic variables with the optimal linear weights.
+             */
             
-            primitive_variables_minus.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
-            
-            primitive_variables_plus.push_back(boost::make_shared<pdat::SideData<double> >(
-                interior_box, 1, hier::IntVector::getOne(d_dim)));
+            performLinearInterpolation(
+                primitive_variables_minus,
+                primitive_variables_plus,
+                primitive_variables);
         }
-        
-        bounded_flag_minus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
-        bounded_flag_plus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
-        /*
-         * Compute global side data of the projection variables for transformation between
-         * primitive variables and characteristic variables.
-         */
-        
-        d_flow_model->computeGlobalSideDataProjectionVariablesForPrimitiveVariables(
-            projection_variables);
-        
-        /*
-         * Transform primitive variables to characteristic variables.
-         */
-        
-        for (int m = 0; m < 6; m++)
+        else
         {
-            d_flow_model->computeGlobalSideDataCharacteristicVariablesFromPrimitiveVariables(
-                characteristic_variables[m],
-                primitive_variables,
+            /*
+             * Initialize temporary data containers for WENO interpolation.
+             */
+            
+            characteristic_variables.resize(6);
+            
+            for (int m = 0; m < 6; m++)
+            {
+                characteristic_variables[m].reserve(d_num_eqn);
+                for (int ei = 0; ei < d_num_eqn; ei++)
+                {
+                    characteristic_variables[m].push_back(getTemporarySideData(
+                        interior_box, 1, hier::IntVector::getOne(d_dim)));
+                }
+            }
+            
+            characteristic_variables_minus.reserve(d_num_eqn);
+            characteristic_variables_plus.reserve(d_num_eqn);
+            
+            for (int ei = 0; ei < d_num_eqn; ei++)
+            {
+                characteristic_variables_minus.push_back(getTemporarySideData(
+                    interior_box, 1, hier::IntVector::getOne(d_dim)));
+                
+                characteristic_variables_plus.push_back(getTemporarySideData(
+                    interior_box, 1, hier::IntVector::getOne(d_dim)));
+            }
+            
+            /*
+             * Compute global side data of the projection variables for transformation between
+             * primitive variables and characteristic variables or get the data frozen at the
+             * first Runge-Kutta stage.
+             */
+            
+            computeProjectionVariables(
                 projection_variables,
-                m - 3);
+                patch,
+                time,
+                RK_step_number);
+            
+            /*
+             * Transform primitive variables to characteristic variables.
+             */
+            
+            for (int m = 0; m < 6; m++)
+            {
+                d_flow_model->computeGlobalSideDataCharacteristicVariablesFromPrimitiveVariables(
+                    characteristic_variables[m],
+                    primitive_variables,
+                    projection_variables,
+                    m - 3);
+            }
+            
+            /*
+             * Peform WENO interpolation.
+             */
+            
+            performWENOInterpolation(
+                characteristic_variables_minus,
+                characteristic_variables_plus,
+                characteristic_variables);
+            
+            /*
+             * Transform characteristic variables back to primitive variables.
+             */
+            
+            d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
+                primitive_variables_minus,
+                characteristic_variables_minus,
+                projection_variables);
+            
+            d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
+                primitive_variables_plus,
+                characteristic_variables_plus,
+                projection_variables);
+            
+            /*
+             * Limit the interpolated side primitive variables with the positivity-preserving scaling
+             * limiter so that they are within the bounds.
+             */
+            
+            d_flow_model->limitGlobalSideDataPrimitiveVariables(
+                primitive_variables_minus,
+                primitive_variables_plus,
+                primitive_variables);
         }
         
         /*
-         * Peform WENO interpolation.
-         */
-        
-        performWENOInterpolation(
-            characteristic_variables_minus,
-            characteristic_variables_plus,
-            characteristic_variables);
-        
-        /*
-         * Transform characteristic variables back to primitive variables.
-         */
-        
-        d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
-            primitive_variables_minus,
-            characteristic_variables_minus,
-            projection_variables);
-        
-        d_flow_model->computeGlobalSideDataPrimitiveVariablesFromCharacteristicVariables(
-            primitive_variables_plus,
-            characteristic_variables_plus,
-            projection_variables);
-        
-        /*
-         * Declare containers to store pointers for computing mid-point fluxes.
-         */
-        
-        std::vector<double*> V_minus;
-        std::vector<double*> V_plus;
-        V_minus.resize(d_num_eqn);
-        V_plus.resize(d_num_eqn);
-        
-        int* flag_minus = nullptr;
-        int* flag_plus = nullptr;
-        
-        /*
-         * Check whether the interpolated side primitive variables are within the bounds.
-         */
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_minus,
-            primitive_variables_minus);
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_plus,
-            primitive_variables_plus);
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in x-direction
-         * are out of bounds.
+         * Compute mid-point flux in the x-direction.
          */
         
-        for (int ei = 0; ei < d_num_eqn; ei++)
+        if (is_patch_smooth)
         {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(0);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(0);
+            /*
+             * The interpolated states on both sides of the mid-points are identical on a smooth
+             * patch. Both Riemann solvers then reduce to the physical flux and the shock sensor
+             * is not needed.
+             */
+            
+            if (d_has_advective_eqn_form)
+            {
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::X_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            else
+            {
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::X_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
         }
-        
-        flag_minus = bounded_flag_minus->getPointer(0);
-        flag_plus = bounded_flag_plus->getPointer(0);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
+        else
         {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int num_subghosts_2_primitive_var = num_subghosts_primitive_var[ei][2];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
-            const int subghostcell_dim_1_primitive_var = subghostcell_dims_primitive_var[ei][1];
+            if (d_has_advective_eqn_form)
+            {
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::X_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            else
+            {
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::X_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            
+            d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                convective_flux_midpoint_HLLC_HLL,
+                primitive_variables_minus,
+                primitive_variables_plus,
+                DIRECTION::X_DIRECTION,
+                RIEMANN_SOLVER::HLLC_HLL);
             
+            // Compute the Ducros-like shock sensor.
             for (int k = 0; k < interior_dim_2; k++)
             {
                 for (int j = 0; j < interior_dim_1; j++)
@@ -1890,26 +1969,55 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
 #endif
                     for (int i = -1; i < interior_dim_0 + 2; i++)
                     {
-                        // Compute the linear indices.
+                        // Compute the linear index of the side.
                         const int idx_midpoint_x = (i + 1) +
                             (j + 1)*(interior_dim_0 + 3) +
                             (k + 1)*(interior_dim_0 + 3)*
                                 (interior_dim_1 + 2);
                         
-                        const int idx_cell_L = (i - 1 + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
+                        const int idx_L = (i + 1) +
+                            (j + 2)*(interior_dim_0 + 4) +
+                            (k + 2)*(interior_dim_0 + 4)*
+                                (interior_dim_1 + 4);
                         
-                        const int idx_cell_R = (i + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
+                        const int idx_R = (i + 2) +
+                            (j + 2)*(interior_dim_0 + 4) +
+                            (k + 2)*(interior_dim_0 + 4)*
+                                (interior_dim_1 + 4);
                         
-                        if (flag_minus[idx_midpoint_x] == 0 || flag_plus[idx_midpoint_x] == 0)
+                        double theta_avg = 0.5*(theta[idx_L] + theta[idx_R]);
+                        double Omega_avg = 0.5*(Omega[idx_L] + Omega[idx_R]);
+                        
+                        s_x[idx_midpoint_x] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
+                    }
+                }
+            }
+            
+            for (int ei = 0; ei < d_num_eqn; ei++)
+            {
+                for (int k = 0; k < interior_dim_2; k++)
+                {
+                    for (int j = 0; j < interior_dim_1; j++)
+                    {
+#ifdef HAMERS_ENABLE_SIMD
+                        #pragma omp simd
+#endif
+                        for (int i = -1; i < interior_dim_0 + 2; i++)
                         {
-                            V_minus[ei][idx_midpoint_x] = V[ei][idx_cell_L];
-                            V_plus[ei][idx_midpoint_x] = V[ei][idx_cell_R];
+                            // Compute the linear index of the side.
+                            const int idx_midpoint_x = (i + 1) +
+                                (j + 1)*(interior_dim_0 + 3) +
+                                (k + 1)*(interior_dim_0 + 3)*
+                                    (interior_dim_1 + 2);
+                            
+                            if (s_x[idx_midpoint_x] > 0.65)
+                            {
+                                F_midpoint_x[ei][idx_midpoint_x] = F_midpoint_HLLC_HLL_x[ei][idx_midpoint_x];
+                            }
+                            else
+                            {
+                                F_midpoint_x[ei][idx_midpoint_x] = F_midpoint_HLLC_x[ei][idx_midpoint_x];
+                            }
                         }
                     }
                 }
@@ -1917,27 +2025,67 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         }
         
         /*
-         * Use first order interpolation if interpolated side primitive variables in y-direction
-         * are out of bounds.
+         * Compute mid-point flux in the y-direction.
          */
         
-        for (int ei = 0; ei < d_num_eqn; ei++)
+        if (is_patch_smooth)
         {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(1);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(1);
+            /*
+             * The interpolated states on both sides of the mid-points are identical on a smooth
+             * patch. Both Riemann solvers then reduce to the physical flux and the shock sensor
+             * is not needed.
+             */
+            
+            if (d_has_advective_eqn_form)
+            {
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Y_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            else
+            {
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Y_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
         }
-        
-        flag_minus = bounded_flag_minus->getPointer(1);
-        flag_plus = bounded_flag_plus->getPointer(1);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
+        else
         {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int num_subghosts_2_primitive_var = num_subghosts_primitive_var[ei][2];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
-            const int subghostcell_dim_1_primitive_var = subghostcell_dims_primitive_var[ei][1];
+            if (d_has_advective_eqn_form)
+            {
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Y_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            else
+            {
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Y_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            
+            d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                convective_flux_midpoint_HLLC_HLL,
+                primitive_variables_minus,
+                primitive_variables_plus,
+                DIRECTION::Y_DIRECTION,
+                RIEMANN_SOLVER::HLLC_HLL);
             
+            // Compute the Ducros-like shock sensor.
             for (int k = 0; k < interior_dim_2; k++)
             {
                 for (int j = -1; j < interior_dim_1 + 2; j++)
@@ -1947,26 +2095,55 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
 #endif
                     for (int i = 0; i < interior_dim_0; i++)
                     {
-                        // Compute the linear indices.
+                        // Compute the linear index of the side.
                         const int idx_midpoint_y = (i + 1) +
                             (j + 1)*(interior_dim_0 + 2) +
                             (k + 1)*(interior_dim_0 + 2)*
                                 (interior_dim_1 + 3);
                         
-                        const int idx_cell_B = (i + num_subghosts_0_primitive_var) +
-                            (j - 1 + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
+                        const int idx_B = (i + 2) +
+                            (j + 1)*(interior_dim_0 + 4) +
+                            (k + 2)*(interior_dim_0 + 4)*
+                                (interior_dim_1 + 4);
                         
-                        const int idx_cell_T = (i + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
+                        const int idx_T = (i + 2) +
+                            (j + 2)*(interior_dim_0 + 4) +
+                            (k + 2)*(interior_dim_0 + 4)*
+                                (interior_dim_1 + 4);
                         
-                        if (flag_minus[idx_midpoint_y] == 0 || flag_plus[idx_midpoint_y] == 0)
+                        double theta_avg = 0.5*(theta[idx_B] + theta[idx_T]);
+                        double Omega_avg = 0.5*(Omega[idx_B] + Omega[idx_T]);
+                        
+                        s_y[idx_midpoint_y] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
+                    }
+                }
+            }
+            
+            for (int ei = 0; ei < d_num_eqn; ei++)
+            {
+                for (int k = 0; k < interior_dim_2; k++)
+                {
+                    for (int j = -1; j < interior_dim_1 + 2; j++)
+                    {
+#ifdef HAMERS_ENABLE_SIMD
+                        #pragma omp simd
+#endif
+                        for (int i = 0; i < interior_dim_0; i++)
                         {
-                            V_minus[ei][idx_midpoint_y] = V[ei][idx_cell_B];
-                            V_plus[ei][idx_midpoint_y] = V[ei][idx_cell_T];
+                            // Compute the linear index of the side.
+                            const int idx_midpoint_y = (i + 1) +
+                                (j + 1)*(interior_dim_0 + 2) +
+                                (k + 1)*(interior_dim_0 + 2)*
+                                    (interior_dim_1 + 3);
+                            
+                            if (s_y[idx_midpoint_y] > 0.65)
+                            {
+                                F_midpoint_y[ei][idx_midpoint_y] = F_midpoint_HLLC_HLL_y[ei][idx_midpoint_y];
+                            }
+                            else
+                            {
+                                F_midpoint_y[ei][idx_midpoint_y] = F_midpoint_HLLC_y[ei][idx_midpoint_y];
+                            }
                         }
                     }
                 }
@@ -1974,27 +2151,67 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         }
         
         /*
-         * Use first order interpolation if interpolated side primitive variables in z-direction
-         * are out of bounds.
+         * Compute mid-point flux in the z-direction.
          */
         
-        for (int ei = 0; ei < d_num_eqn; ei++)
+        if (is_patch_smooth)
         {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(2);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(2);
+            /*
+             * The interpolated states on both sides of the mid-points are identical on a smooth
+             * patch. Both Riemann solvers then reduce to the physical flux and the shock sensor
+             * is not needed.
+             */
+            
+            if (d_has_advective_eqn_form)
+            {
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Z_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            else
+            {
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Z_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
         }
-        
-        flag_minus = bounded_flag_minus->getPointer(2);
-        flag_plus = bounded_flag_plus->getPointer(2);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
+        else
         {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int num_subghosts_2_primitive_var = num_subghosts_primitive_var[ei][2];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
-            const int subghostcell_dim_1_primitive_var = subghostcell_dims_primitive_var[ei][1];
+            if (d_has_advective_eqn_form)
+            {
+                d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    velocity_midpoint,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Z_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            else
+            {
+                d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                    convective_flux_midpoint_HLLC,
+                    primitive_variables_minus,
+                    primitive_variables_plus,
+                    DIRECTION::Z_DIRECTION,
+                    RIEMANN_SOLVER::HLLC);
+            }
+            
+            d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
+                convective_flux_midpoint_HLLC_HLL,
+                primitive_variables_minus,
+                primitive_variables_plus,
+                DIRECTION::Z_DIRECTION,
+                RIEMANN_SOLVER::HLLC_HLL);
             
+            // Compute the Ducros-like shock sensor.
             for (int k = -1; k < interior_dim_2 + 2; k++)
             {
                 for (int j = 0; j < interior_dim_1; j++)
@@ -2004,26 +2221,55 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
 #endif
                     for (int i = 0; i < interior_dim_0; i++)
                     {
-                        // Compute the linear indices.
+                        // Compute the linear index of the side.
                         const int idx_midpoint_z = (i + 1) +
                             (j + 1)*(interior_dim_0 + 2) +
                             (k + 1)*(interior_dim_0 + 2)*
                                 (interior_dim_1 + 2);
                         
-                        const int idx_cell_B = (i + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k - 1 + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
+                        const int idx_B = (i + 2) +
+                            (j + 2)*(interior_dim_0 + 4) +
+                            (k + 1)*(interior_dim_0 + 4)*
+                                (interior_dim_1 + 4);
                         
-                        const int idx_cell_F = (i + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
+                        const int idx_F = (i + 2) +
+                            (j + 2)*(interior_dim_0 + 4) +
+                            (k + 2)*(interior_dim_0 + 4)*
+                                (interior_dim_1 + 4);
                         
-                        if (flag_minus[idx_midpoint_z] == 0 || flag_plus[idx_midpoint_z] == 0)
+                        double theta_avg = 0.5*(theta[idx_B] + theta[idx_F]);
+                        double Omega_avg = 0.5*(Omega[idx_B] + Omega[idx_F]);
+                        
+                        s_z[idx_midpoint_z] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
+                    }
+                }
+            }
+            
+            for (int ei = 0; ei < d_num_eqn; ei++)
+            {
+                for (int k = -1; k < interior_dim_2 + 2; k++)
+                {
+                    for (int j = 0; j < interior_dim_1; j++)
+                    {
+#ifdef HAMERS_ENABLE_SIMD
+                        #pragma omp simd
+#endif
+                        for (int i = 0; i < interior_dim_0; i++)
                         {
-                            V_minus[ei][idx_midpoint_z] = V[ei][idx_cell_B];
-                            V_plus[ei][idx_midpoint_z] = V[ei][idx_cell_F];
+                            // Compute the linear index of the side.
+                            const int idx_midpoint_z = (i + 1) +
+                                (j + 1)*(interior_dim_0 + 2) +
+                                (k + 1)*(interior_dim_0 + 2)*
+                                    (interior_dim_1 + 2);
+                            
+                            if (s_z[idx_midpoint_z] > 0.65)
+                            {
+                                F_midpoint_z[ei][idx_midpoint_z] = F_midpoint_HLLC_HLL_z[ei][idx_midpoint_z];
+                            }
+                            else
+                            {
+                                F_midpoint_z[ei][idx_midpoint_z] = F_midpoint_HLLC_z[ei][idx_midpoint_z];
+                            }
                         }
                     }
                 }
@@ -2031,304 +2277,19 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         }
         
         /*
-         * Compute mid-point flux in the x-direction.
+         * Reconstruct the flux in the x-direction.
          */
         
-        if (d_has_advective_eqn_form)
-        {
-            d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
-                velocity_midpoint,
-                primitive_variables_minus,
-                primitive_variables_plus,
-                DIRECTION::X_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
-        else
-        {
-            d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
-                primitive_variables_minus,
-                primitive_variables_plus,
-                DIRECTION::X_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
-        
-        d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-            convective_flux_midpoint_HLLC_HLL,
-            primitive_variables_minus,
-            primitive_variables_plus,
-            DIRECTION::X_DIRECTION,
-            RIEMANN_SOLVER::HLLC_HLL);
-        
-        // Compute the Ducros-like shock sensor.
-        for (int k = 0; k < interior_dim_2; k++)
+        for (int ei = 0; ei < d_num_eqn; ei++)
         {
-            for (int j = 0; j < interior_dim_1; j++)
+            double* F_face_x = convective_flux->getPointer(0, ei);
+            
+            for (int k = 0; k < interior_dim_2; k++)
             {
+                for (int j = 0; j < interior_dim_1; j++)
+                {
 #ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = -1; i < interior_dim_0 + 2; i++)
-                {
-                    // Compute the linear index of the side.
-                    const int idx_midpoint_x = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 3) +
-                        (k + 1)*(interior_dim_0 + 3)*
-                            (interior_dim_1 + 2);
-                    
-                    const int idx_L = (i + 1) +
-                        (j + 2)*(interior_dim_0 + 4) +
-                        (k + 2)*(interior_dim_0 + 4)*
-                            (interior_dim_1 + 4);
-                    
-                    const int idx_R = (i + 2) +
-                        (j + 2)*(interior_dim_0 + 4) +
-                        (k + 2)*(interior_dim_0 + 4)*
-                            (interior_dim_1 + 4);
-                    
-                    double theta_avg = 0.5*(theta[idx_L] + theta[idx_R]);
-                    double Omega_avg = 0.5*(Omega[idx_L] + Omega[idx_R]);
-                    
-                    s_x[idx_midpoint_x] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
-                }
-            }
-        }
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            for (int k = 0; k < interior_dim_2; k++)
-            {
-                for (int j = 0; j < interior_dim_1; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = -1; i < interior_dim_0 + 2; i++)
-                    {
-                        // Compute the linear index of the side.
-                        const int idx_midpoint_x = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 3) +
-                            (k + 1)*(interior_dim_0 + 3)*
-                                (interior_dim_1 + 2);
-                        
-                        if (s_x[idx_midpoint_x] > 0.65)
-                        {
-                            F_midpoint_x[ei][idx_midpoint_x] = F_midpoint_HLLC_HLL_x[ei][idx_midpoint_x];
-                        }
-                        else
-                        {
-                            F_midpoint_x[ei][idx_midpoint_x] = F_midpoint_HLLC_x[ei][idx_midpoint_x];
-                        }
-                    }
-                }
-            }
-        }
-        
-        /*
-         * Compute mid-point flux in the y-direction.
-         */
-        
-        if (d_has_advective_eqn_form)
-        {
-            d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
-                velocity_midpoint,
-                primitive_variables_minus,
-                primitive_variables_plus,
-                DIRECTION::Y_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
-        else
-        {
-            d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
-                primitive_variables_minus,
-                primitive_variables_plus,
-                DIRECTION::Y_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
-        
-        d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-            convective_flux_midpoint_HLLC_HLL,
-            primitive_variables_minus,
-            primitive_variables_plus,
-            DIRECTION::Y_DIRECTION,
-            RIEMANN_SOLVER::HLLC_HLL);
-        
-        // Compute the Ducros-like shock sensor.
-        for (int k = 0; k < interior_dim_2; k++)
-        {
-            for (int j = -1; j < interior_dim_1 + 2; j++)
-            {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index of the side.
-                    const int idx_midpoint_y = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2) +
-                        (k + 1)*(interior_dim_0 + 2)*
-                            (interior_dim_1 + 3);
-                    
-                    const int idx_B = (i + 2) +
-                        (j + 1)*(interior_dim_0 + 4) +
-                        (k + 2)*(interior_dim_0 + 4)*
-                            (interior_dim_1 + 4);
-                    
-                    const int idx_T = (i + 2) +
-                        (j + 2)*(interior_dim_0 + 4) +
-                        (k + 2)*(interior_dim_0 + 4)*
-                            (interior_dim_1 + 4);
-                    
-                    double theta_avg = 0.5*(theta[idx_B] + theta[idx_T]);
-                    double Omega_avg = 0.5*(Omega[idx_B] + Omega[idx_T]);
-                    
-                    s_y[idx_midpoint_y] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
-                }
-            }
-        }
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            for (int k = 0; k < interior_dim_2; k++)
-            {
-                for (int j = -1; j < interior_dim_1 + 2; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the side.
-                        const int idx_midpoint_y = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 3);
-                        
-                        if (s_y[idx_midpoint_y] > 0.65)
-                        {
-                            F_midpoint_y[ei][idx_midpoint_y] = F_midpoint_HLLC_HLL_y[ei][idx_midpoint_y];
-                        }
-                        else
-                        {
-                            F_midpoint_y[ei][idx_midpoint_y] = F_midpoint_HLLC_y[ei][idx_midpoint_y];
-                        }
-                    }
-                }
-            }
-        }
-        
-        /*
-         * Compute mid-point flux in the z-direction.
-         */
-        
-        if (d_has_advective_eqn_form)
-        {
-            d_riemann_solver->computeConvectiveFluxAndVelocityFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
-                velocity_midpoint,
-                primitive_variables_minus,
-                primitive_variables_plus,
-                DIRECTION::Z_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
-        else
-        {
-            d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-                convective_flux_midpoint_HLLC,
-                primitive_variables_minus,
-                primitive_variables_plus,
-                DIRECTION::Z_DIRECTION,
-                RIEMANN_SOLVER::HLLC);
-        }
-        
-        d_riemann_solver->computeConvectiveFluxFromPrimitiveVariables(
-            convective_flux_midpoint_HLLC_HLL,
-            primitive_variables_minus,
-            primitive_variables_plus,
-            DIRECTION::Z_DIRECTION,
-            RIEMANN_SOLVER::HLLC_HLL);
-        
-        // Compute the Ducros-like shock sensor.
-        for (int k = -1; k < interior_dim_2 + 2; k++)
-        {
-            for (int j = 0; j < interior_dim_1; j++)
-            {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index of the side.
-                    const int idx_midpoint_z = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2) +
-                        (k + 1)*(interior_dim_0 + 2)*
-                            (interior_dim_1 + 2);
-                    
-                    const int idx_B = (i + 2) +
-                        (j + 2)*(interior_dim_0 + 4) +
-                        (k + 1)*(interior_dim_0 + 4)*
-                            (interior_dim_1 + 4);
-                    
-                    const int idx_F = (i + 2) +
-                        (j + 2)*(interior_dim_0 + 4) +
-                        (k + 2)*(interior_dim_0 + 4)*
-                            (interior_dim_1 + 4);
-                    
-                    double theta_avg = 0.5*(theta[idx_B] + theta[idx_F]);
-                    double Omega_avg = 0.5*(Omega[idx_B] + Omega[idx_F]);
-                    
-                    s_z[idx_midpoint_z] = -theta_avg/(fabs(theta_avg) + Omega_avg + EPSILON);
-                }
-            }
-        }
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            for (int k = -1; k < interior_dim_2 + 2; k++)
-            {
-                for (int j = 0; j < interior_dim_1; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the side.
-                        const int idx_midpoint_z = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 2);
-                        
-                        if (s_z[idx_midpoint_z] > 0.65)
-                        {
-                            F_midpoint_z[ei][idx_midpoint_z] = F_midpoint_HLLC_HLL_z[ei][idx_midpoint_z];
-                        }
-                        else
-                        {
-                            F_midpoint_z[ei][idx_midpoint_z] = F_midpoint_HLLC_z[ei][idx_midpoint_z];
-                        }
-                    }
-                }
-            }
-        }
-        
-        /*
-         * Reconstruct the flux in the x-direction.
-         */
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            double* F_face_x = convective_flux->getPointer(0, ei);
-            
-            for (int k = 0; k < interior_dim_2; k++)
-            {
-                for (int j = 0; j < interior_dim_1; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
+                    #pragma omp simd
 #endif
                     for (int i = 0; i < interior_dim_0 + 1; i++)
                     {
@@ -2645,4 +2606,693 @@ ConvectiveFluxReconstructorWCNS56::computeConvectiveFluxAndSourceOnPatch(
         d_flow_model->unregisterPatch();
         
     } // if (d_dim == tbox::Dimension(3))
+    
+    /*
+     * Record the number of cells computed with each scheme.
+     */
+    
+    if (d_use_hybrid_scheme)
+    {
+        if (is_patch_smooth)
+        {
+            d_num_cells_linear_scheme += double(interior_box.size());
+        }
+        else
+        {
+            d_num_cells_nonlinear_scheme += double(interior_box.size());
+        }
+    }
+}
+
+
+/*
+ * Get the coefficients of the linear interpolation used on smooth patches. The coefficients are
+ * those of the sixth order central interpolation.
+ */
+void
+ConvectiveFluxReconstructorWCNS56::getLinearInterpolationCoefficients(
+    std::vector<double>& coeffs_minus,
+    std::vector<double>& coeffs_plus) const
+{
+    coeffs_minus.resize(6);
+    
+    coeffs_minus[0] = double(3)/double(256);
+    coeffs_minus[1] = -double(25)/double(256);
+    coeffs_minus[2] = double(150)/double(256);
+    coeffs_minus[3] = double(150)/double(256);
+    coeffs_minus[4] = -double(25)/double(256);
+    coeffs_minus[5] = double(3)/double(256);
+    
+    coeffs_plus = coeffs_minus;
+}
+
+
+/*
+ * Check whether a patch is smooth enough for the linear scheme. The patch is smooth when the
+ * normalized second order differences of all primitive variables are below the threshold in all
+ * cells used by the interpolation stencils. In compression dominated cells flagged by the
+ * Ducros-like shock sensor, a tenth of the threshold is used so that steepening compressions are
+ * handled by the nonlinear scheme before a shock forms.
+ */
+bool
+ConvectiveFluxReconstructorWCNS56::isPatchSmooth(
+    const std::vector<boost::shared_ptr<pdat::CellData<double> > >& primitive_variables,
+    const boost::shared_ptr<pdat::CellData<double> >& dilatation,
+    const boost::shared_ptr<pdat::CellData<double> >& vorticity_magnitude) const
+{
+    const hier::Box interior_box = primitive_variables[0]->getBox();
+    const hier::IntVector interior_dims = interior_box.numberCells();
+    
+    /*
+     * Get the pointers to the primitive variables. The numbers of ghost cells and the dimensions
+     * of the ghost cell boxes are also determined.
+     */
+    
+    std::vector<hier::IntVector> num_subghosts_primitive_var;
+    num_subghosts_primitive_var.reserve(d_num_eqn);
+    
+    std::vector<hier::IntVector> subghostcell_dims_primitive_var;
+    subghostcell_dims_primitive_var.reserve(d_num_eqn);
+    
+    std::vector<double*> V;
+    V.reserve(d_num_eqn);
+    
+    int count_eqn = 0;
+    
+    for (int vi = 0; vi < static_cast<int>(primitive_variables.size()); vi++)
+    {
+        int depth = primitive_variables[vi]->getDepth();
+        
+        for (int di = 0; di < depth; di++)
+        {
+            // If the last element of the primitive variable vector is not in the system of equations,
+            // ignore it.
+            if (count_eqn >= d_num_eqn)
+                break;
+            
+#ifdef HAMERS_DEBUG_CHECK_ASSERTIONS
+            TBOX_ASSERT(primitive_variables[vi]->getGhostCellWidth() >= d_num_conv_ghosts);
+#endif
+            
+            V.push_back(primitive_variables[vi]->getPointer(di));
+            num_subghosts_primitive_var.push_back(primitive_variables[vi]->getGhostCellWidth());
+            subghostcell_dims_primitive_var.push_back(
+                primitive_variables[vi]->getGhostBox().numberCells());
+            
+            count_eqn++;
+        }
+    }
+    
+    /*
+     * Compute the maximum smoothness indicator of all primitive variables in all directions in
+     * the cells used by the interpolation stencils.
+     */
+    
+    boost::shared_ptr<pdat::CellData<double> > smoothness_indicator =
+        getTemporaryCellData(interior_box, 1, hier::IntVector::getOne(d_dim)*3);
+    
+    smoothness_indicator->fillAll(double(0));
+    
+    double* phi = smoothness_indicator->getPointer(0);
+    
+    if (d_dim == tbox::Dimension(1))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
+            
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = -3; i < interior_dim_0 + 3; i++)
+            {
+                // Compute the linear indices.
+                const int idx = i + 3;
+                const int idx_primitive_var = i + num_subghosts_0_primitive_var;
+                
+                phi[idx] = fmax(phi[idx], computeLocalSmoothnessIndicator(V[ei], idx_primitive_var, 1));
+            }
+        }
+    }
+    else if (d_dim == tbox::Dimension(2))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        const int interior_dim_1 = interior_dims[1];
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
+            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
+            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
+            
+            for (int j = -3; j < interior_dim_1 + 3; j++)
+            {
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd
+#endif
+                for (int i = -3; i < interior_dim_0 + 3; i++)
+                {
+                    // Compute the linear indices.
+                    const int idx = (i + 3) +
+                        (j + 3)*(interior_dim_0 + 6);
+                    
+                    const int idx_primitive_var = (i + num_subghosts_0_primitive_var) +
+                        (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var;
+                    
+                    phi[idx] = fmax(phi[idx], fmax(
+                        computeLocalSmoothnessIndicator(V[ei], idx_primitive_var, 1),
+                        computeLocalSmoothnessIndicator(V[ei], idx_primitive_var,
+                            subghostcell_dim_0_primitive_var)));
+                }
+            }
+        }
+    }
+    else if (d_dim == tbox::Dimension(3))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        const int interior_dim_1 = interior_dims[1];
+        const int interior_dim_2 = interior_dims[2];
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
+            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
+            const int num_subghosts_2_primitive_var = num_subghosts_primitive_var[ei][2];
+            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
+            const int subghostcell_dim_1_primitive_var = subghostcell_dims_primitive_var[ei][1];
+            
+            const int stride_z = subghostcell_dim_0_primitive_var*subghostcell_dim_1_primitive_var;
+            
+            for (int k = -3; k < interior_dim_2 + 3; k++)
+            {
+                for (int j = -3; j < interior_dim_1 + 3; j++)
+                {
+#ifdef HAMERS_ENABLE_SIMD
+                    #pragma omp simd
+#endif
+                    for (int i = -3; i < interior_dim_0 + 3; i++)
+                    {
+                        // Compute the linear indices.
+                        const int idx = (i + 3) +
+                            (j + 3)*(interior_dim_0 + 6) +
+                            (k + 3)*(interior_dim_0 + 6)*
+                                (interior_dim_1 + 6);
+                        
+                        const int idx_primitive_var = (i + num_subghosts_0_primitive_var) +
+                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
+                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
+                                subghostcell_dim_1_primitive_var;
+                        
+                        phi[idx] = fmax(phi[idx], fmax(
+                            computeLocalSmoothnessIndicator(V[ei], idx_primitive_var, 1),
+                            fmax(
+                                computeLocalSmoothnessIndicator(V[ei], idx_primitive_var,
+                                    subghostcell_dim_0_primitive_var),
+                                computeLocalSmoothnessIndicator(V[ei], idx_primitive_var,
+                                    stride_z))));
+                    }
+                }
+            }
+        }
+    }
+    
+    /*
+     * Check the smoothness indicator against the threshold.
+     */
+    
+    const int num_cells_smoothness_indicator = static_cast<int>(smoothness_indicator->getGhostBox().size());
+    
+    double phi_max = double(0);
+    
+#ifdef HAMERS_ENABLE_SIMD
+    #pragma omp simd reduction(max:phi_max)
+#endif
+    for (int idx = 0; idx < num_cells_smoothness_indicator; idx++)
+    {
+        phi_max = fmax(phi_max, phi[idx]);
+    }
+    
+    if (phi_max > d_hybrid_smoothness_threshold)
+    {
+        return false;
+    }
+    
+    /*
+     * Check the smoothness indicator against the reduced threshold in the compression dominated
+     * cells.
+     */
+    
+    if (d_dim > tbox::Dimension(1))
+    {
+        const double* const theta = dilatation->getPointer(0);
+        const double* const Omega = vorticity_magnitude->getPointer(0);
+        
+        double phi_compression_max = double(0);
+        
+        if (d_dim == tbox::Dimension(2))
+        {
+            const int interior_dim_0 = interior_dims[0];
+            const int interior_dim_1 = interior_dims[1];
+            
+            for (int j = -2; j < interior_dim_1 + 2; j++)
+            {
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd reduction(max:phi_compression_max)
+#endif
+                for (int i = -2; i < interior_dim_0 + 2; i++)
+                {
+                    // Compute the linear indices.
+                    const int idx = (i + 3) +
+                        (j + 3)*(interior_dim_0 + 6);
+                    
+                    const int idx_sensor = (i + 2) +
+                        (j + 2)*(interior_dim_0 + 4);
+                    
+                    const double s = -theta[idx_sensor]/(fabs(theta[idx_sensor]) + Omega[idx_sensor] + EPSILON);
+                    
+                    phi_compression_max = fmax(phi_compression_max, s > 0.65 ? phi[idx] : double(0));
+                }
+            }
+        }
+        else if (d_dim == tbox::Dimension(3))
+        {
+            const int interior_dim_0 = interior_dims[0];
+            const int interior_dim_1 = interior_dims[1];
+            const int interior_dim_2 = interior_dims[2];
+            
+            for (int k = -2; k < interior_dim_2 + 2; k++)
+            {
+                for (int j = -2; j < interior_dim_1 + 2; j++)
+                {
+#ifdef HAMERS_ENABLE_SIMD
+                    #pragma omp simd reduction(max:phi_compression_max)
+#endif
+                    for (int i = -2; i < interior_dim_0 + 2; i++)
+                    {
+                        // Compute the linear indices.
+                        const int idx = (i + 3) +
+                            (j + 3)*(interior_dim_0 + 6) +
+                            (k + 3)*(interior_dim_0 + 6)*
+                                (interior_dim_1 + 6);
+                        
+                        const int idx_sensor = (i + 2) +
+                            (j + 2)*(interior_dim_0 + 4) +
+                            (k + 2)*(interior_dim_0 + 4)*
+                                (interior_dim_1 + 4);
+                        
+                        const double s = -theta[idx_sensor]/(fabs(theta[idx_sensor]) + Omega[idx_sensor] + EPSILON);
+                        
+                        phi_compression_max = fmax(phi_compression_max, s > 0.65 ? phi[idx] : double(0));
+                    }
+                }
+            }
+        }
+        
+        if (phi_compression_max > double(1)/double(10)*d_hybrid_smoothness_threshold)
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+
+/*
+ * Perform linear interpolation of the primitive variables to the mid-points in all directions.
+ */
+void
+ConvectiveFluxReconstructorWCNS56::performLinearInterpolation(
+    std::vector<boost::shared_ptr<pdat::SideData<double> > >& variables_minus,
+    std::vector<boost::shared_ptr<pdat::SideData<double> > >& variables_plus,
+    const std::vector<boost::shared_ptr<pdat::CellData<double> > >& variables)
+{
+    const hier::Box interior_box = variables[0]->getBox();
+    const hier::IntVector interior_dims = interior_box.numberCells();
+    
+    /*
+     * Get the interpolation coefficients.
+     */
+    
+    std::vector<double> coeffs_minus;
+    std::vector<double> coeffs_plus;
+    
+    getLinearInterpolationCoefficients(coeffs_minus, coeffs_plus);
+    
+    const double* const c_minus = coeffs_minus.data();
+    const double* const c_plus = coeffs_plus.data();
+    
+    /*
+     * Get the pointers to the variables. The numbers of ghost cells and the dimensions of the
+     * ghost cell boxes are also determined.
+     */
+    
+    std::vector<hier::IntVector> num_subghosts_var;
+    num_subghosts_var.reserve(d_num_eqn);
+    
+    std::vector<hier::IntVector> subghostcell_dims_var;
+    subghostcell_dims_var.reserve(d_num_eqn);
+    
+    std::vector<double*> V;
+    V.reserve(d_num_eqn);
+    
+    int count_eqn = 0;
+    
+    for (int vi = 0; vi < static_cast<int>(variables.size()); vi++)
+    {
+        int depth = variables[vi]->getDepth();
+        
+        for (int di = 0; di < depth; di++)
+        {
+            // If the last element of the variable vector is not in the system of equations,
+            // ignore it.
+            if (count_eqn >= d_num_eqn)
+                break;
+            
+            V.push_back(variables[vi]->getPointer(di));
+            num_subghosts_var.push_back(variables[vi]->getGhostCellWidth());
+            subghostcell_dims_var.push_back(variables[vi]->getGhostBox().numberCells());
+            
+            count_eqn++;
+        }
+    }
+    
+    if (d_dim == tbox::Dimension(1))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            const int num_subghosts_0_var = num_subghosts_var[ei][0];
+            
+            double* V_minus_x = variables_minus[ei]->getPointer(0);
+            double* V_plus_x = variables_plus[ei]->getPointer(0);
+            
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = -1; i < interior_dim_0 + 2; i++)
+            {
+                // Compute the linear indices.
+                const int idx_midpoint_x = i + 1;
+                const int idx_cell_R = i + num_subghosts_0_var;
+                
+                V_minus_x[idx_midpoint_x] = interpolateLinearly(c_minus, V[ei], idx_cell_R, 1);
+                V_plus_x[idx_midpoint_x] = interpolateLinearly(c_plus, V[ei], idx_cell_R, 1);
+            }
+        }
+    }
+    else if (d_dim == tbox::Dimension(2))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        const int interior_dim_1 = interior_dims[1];
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            const int num_subghosts_0_var = num_subghosts_var[ei][0];
+            const int num_subghosts_1_var = num_subghosts_var[ei][1];
+            const int subghostcell_dim_0_var = subghostcell_dims_var[ei][0];
+            
+            /*
+             * Interpolate in the x-direction.
+             */
+            
+            double* V_minus_x = variables_minus[ei]->getPointer(0);
+            double* V_plus_x = variables_plus[ei]->getPointer(0);
+            
+            for (int j = 0; j < interior_dim_1; j++)
+            {
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd
+#endif
+                for (int i = -1; i < interior_dim_0 + 2; i++)
+                {
+                    // Compute the linear indices.
+                    const int idx_midpoint_x = (i + 1) +
+                        (j + 1)*(interior_dim_0 + 3);
+                    
+                    const int idx_cell_R = (i + num_subghosts_0_var) +
+                        (j + num_subghosts_1_var)*subghostcell_dim_0_var;
+                    
+                    V_minus_x[idx_midpoint_x] = interpolateLinearly(c_minus, V[ei], idx_cell_R, 1);
+                    V_plus_x[idx_midpoint_x] = interpolateLinearly(c_plus, V[ei], idx_cell_R, 1);
+                }
+            }
+            
+            /*
+             * Interpolate in the y-direction.
+             */
+            
+            double* V_minus_y = variables_minus[ei]->getPointer(1);
+            double* V_plus_y = variables_plus[ei]->getPointer(1);
+            
+            for (int j = -1; j < interior_dim_1 + 2; j++)
+            {
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd
+#endif
+                for (int i = 0; i < interior_dim_0; i++)
+                {
+                    // Compute the linear indices.
+                    const int idx_midpoint_y = (i + 1) +
+                        (j + 1)*(interior_dim_0 + 2);
+                    
+                    const int idx_cell_T = (i + num_subghosts_0_var) +
+                        (j + num_subghosts_1_var)*subghostcell_dim_0_var;
+                    
+                    V_minus_y[idx_midpoint_y] = interpolateLinearly(c_minus, V[ei], idx_cell_T,
+                        subghostcell_dim_0_var);
+                    V_plus_y[idx_midpoint_y] = interpolateLinearly(c_plus, V[ei], idx_cell_T,
+                        subghostcell_dim_0_var);
+                }
+            }
+        }
+    }
+    else if (d_dim == tbox::Dimension(3))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        const int interior_dim_1 = interior_dims[1];
+        const int interior_dim_2 = interior_dims[2];
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            const int num_subghosts_0_var = num_subghosts_var[ei][0];
+            const int num_subghosts_1_var = num_subghosts_var[ei][1];
+            const int num_subghosts_2_var = num_subghosts_var[ei][2];
+            const int subghostcell_dim_0_var = subghostcell_dims_var[ei][0];
+            const int subghostcell_dim_1_var = subghostcell_dims_var[ei][1];
+            
+            const int stride_z = subghostcell_dim_0_var*subghostcell_dim_1_var;
+            
+            /*
+             * Interpolate in the x-direction.
+             */
+            
+            double* V_minus_x = variables_minus[ei]->getPointer(0);
+            double* V_plus_x = variables_plus[ei]->getPointer(0);
+            
+            for (int k = 0; k < interior_dim_2; k++)
+            {
+                for (int j = 0; j < interior_dim_1; j++)
+                {
+#ifdef HAMERS_ENABLE_SIMD
+                    #pragma omp simd
+#endif
+                    for (int i = -1; i < interior_dim_0 + 2; i++)
+                    {
+                        // Compute the linear indices.
+                        const int idx_midpoint_x = (i + 1) +
+                            (j + 1)*(interior_dim_0 + 3) +
+                            (k + 1)*(interior_dim_0 + 3)*
+                                (interior_dim_1 + 2);
+                        
+                        const int idx_cell_R = (i + num_subghosts_0_var) +
+                            (j + num_subghosts_1_var)*subghostcell_dim_0_var +
+                            (k + num_subghosts_2_var)*subghostcell_dim_0_var*
+                                subghostcell_dim_1_var;
+                        
+                        V_minus_x[idx_midpoint_x] = interpolateLinearly(c_minus, V[ei], idx_cell_R, 1);
+                        V_plus_x[idx_midpoint_x] = interpolateLinearly(c_plus, V[ei], idx_cell_R, 1);
+                    }
+                }
+            }
+            
+            /*
+             * Interpolate in the y-direction.
+             */
+            
+            double* V_minus_y = variables_minus[ei]->getPointer(1);
+            double* V_plus_y = variables_plus[ei]->getPointer(1);
+            
+            for (int k = 0; k < interior_dim_2; k++)
+            {
+                for (int j = -1; j < interior_dim_1 + 2; j++)
+                {
+#ifdef HAMERS_ENABLE_SIMD
+                    #pragma omp simd
+#endif
+                    for (int i = 0; i < interior_dim_0; i++)
+                    {
+                        // Compute the linear indices.
+                        const int idx_midpoint_y = (i + 1) +
+                            (j + 1)*(interior_dim_0 + 2) +
+                            (k + 1)*(interior_dim_0 + 2)*
+                                (interior_dim_1 + 3);
+                        
+                        const int idx_cell_T = (i + num_subghosts_0_var) +
+                            (j + num_subghosts_1_var)*subghostcell_dim_0_var +
+                            (k + num_subghosts_2_var)*subghostcell_dim_0_var*
+                                subghostcell_dim_1_var;
+                        
+                        V_minus_y[idx_midpoint_y] = interpolateLinearly(c_minus, V[ei], idx_cell_T,
+                            subghostcell_dim_0_var);
+                        V_plus_y[idx_midpoint_y] = interpolateLinearly(c_plus, V[ei], idx_cell_T,
+                            subghostcell_dim_0_var);
+                    }
+                }
+            }
+            
+            /*
+             * Interpolate in the z-direction.
+             */
+            
+            double* V_minus_z = variables_minus[ei]->getPointer(2);
+            double* V_plus_z = variables_plus[ei]->getPointer(2);
+            
+            for (int k = -1; k < interior_dim_2 + 2; k++)
+            {
+                for (int j = 0; j < interior_dim_1; j++)
+                {
+#ifdef HAMERS_ENABLE_SIMD
+                    #pragma omp simd
+#endif
+                    for (int i = 0; i < interior_dim_0; i++)
+                    {
+                        // Compute the linear indices.
+                        const int idx_midpoint_z = (i + 1) +
+                            (j + 1)*(interior_dim_0 + 2) +
+                            (k + 1)*(interior_dim_0 + 2)*
+                                (interior_dim_1 + 2);
+                        
+                        const int idx_cell_F = (i + num_subghosts_0_var) +
+                            (j + num_subghosts_1_var)*subghostcell_dim_0_var +
+                            (k + num_subghosts_2_var)*subghostcell_dim_0_var*
+                                subghostcell_dim_1_var;
+                        
+                        V_minus_z[idx_midpoint_z] = interpolateLinearly(c_minus, V[ei], idx_cell_F, stride_z);
+                        V_plus_z[idx_midpoint_z] = interpolateLinearly(c_plus, V[ei], idx_cell_F, stride_z);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/*
+ * Compute the projection variables for the transformation between primitive variables and
+ * characteristic variables on a patch. If the projection variables are frozen, the data computed at
+ * the first Runge-Kutta stage of the time step is stored and reused at the later stages.
+ */
+void
+ConvectiveFluxReconstructorWCNS56::computeProjectionVariables(
+    std::vector<boost::shared_ptr<pdat::SideData<double> > >& projection_variables,
+    const hier::Patch& patch,
+    const double time,
+    const int RK_step_number)
+{
+    const hier::Box& interior_box = patch.getBox();
+    const int level_number = patch.getPatchLevelNumber();
+    
+    if (d_freeze_projection_variables)
+    {
+        if (level_number >= static_cast<int>(d_projection_variables_cache.size()))
+        {
+            d_projection_variables_cache.resize(level_number + 1);
+            d_projection_variables_time.resize(level_number + 1, std::numeric_limits<double>::quiet_NaN());
+        }
+        
+        std::map<hier::GlobalId, std::vector<boost::shared_ptr<pdat::SideData<double> > > >&
+            projection_variables_cache = d_projection_variables_cache[level_number];
+        
+        if (RK_step_number > 0)
+        {
+            if (d_projection_variables_time[level_number] == time)
+            {
+                std::map<hier::GlobalId, std::vector<boost::shared_ptr<pdat::SideData<double> > > >::const_iterator
+                    it = projection_variables_cache.find(patch.getGlobalId());
+                
+                if (it != projection_variables_cache.end() &&
+                    it->second[0]->getBox().isSpatiallyEqual(interior_box))
+                {
+                    projection_variables = it->second;
+                    
+                    return;
+                }
+            }
+        }
+        else if (d_projection_variables_time[level_number] != time)
+        {
+            // A new time step is started on the level. Discard the data of the old time step.
+            projection_variables_cache.clear();
+            d_projection_variables_time[level_number] = time;
+        }
+    }
+    
+    int num_projection_var = d_flow_model->getNumberOfProjectionVariablesForPrimitiveVariables();
+    
+    projection_variables.clear();
+    projection_variables.reserve(num_projection_var);
+    
+    for (int vi = 0; vi < num_projection_var; vi++)
+    {
+        projection_variables.push_back(boost::make_shared<pdat::SideData<double> >(
+            interior_box, 1, hier::IntVector::getOne(d_dim)));
+    }
+    
+    d_flow_model->computeGlobalSideDataProjectionVariablesForPrimitiveVariables(
+        projection_variables);
+    
+    if (d_freeze_projection_variables && RK_step_number == 0)
+    {
+        d_projection_variables_cache[level_number][patch.getGlobalId()] = projection_variables;
+    }
+}
+
+
+/*
+ * Get temporary side data of doubles from the pool of the reconstructor.
+ */
+boost::shared_ptr<pdat::SideData<double> >
+ConvectiveFluxReconstructorWCNS56::getTemporarySideData(
+    const hier::Box& interior_box,
+    const int depth,
+    const hier::IntVector& num_ghosts)
+{
+    return getPooledPatchData(
+        d_temp_side_data,
+        d_num_temp_side_data_used,
+        interior_box,
+        depth,
+        num_ghosts);
+}
+
+
+/*
+ * Get temporary cell data of doubles from the pool of the reconstructor.
+ */
+boost::shared_ptr<pdat::CellData<double> >
+ConvectiveFluxReconstructorWCNS56::getTemporaryCellData(
+    const hier::Box& interior_box,
+    const int depth,
+    const hier::IntVector& num_ghosts)
+{
+    return getPooledPatchData(
+        d_temp_cell_data,
+        d_num_temp_cell_data_used,
+        interior_box,
+        depth,
+        num_ghosts);
 }
@@ -1,23 +1,11 @@
 #include "flow/convective_flux_reconstructors/WCNS56/ConvectiveFluxReconstructorWCNS6-CU-M2-HLLC-HLL.hpp"
 
+#include <algorithm>
 #include <cfloat>
 
 #include "SAMRAI/geom/CartesianPatchGeometry.h"
 
-
-/*
- * Interger based power function.
- */
-static inline __attribute__((always_inline)) double ipow(double base, int exp)
-{
-    double result = base;
-    for (int i = 1; i < exp; i++)
-    {
-        result *= base;
-    }
-
-    return result;
-}
+#define WENO_BATCH_SIZE 8
 
 
 /*
@@ -28,38 +16,30 @@ static inline __attribute__((always_inline)) void computeLocalBeta(
     double* beta_1,
     double* beta_2,
     double* beta_3,
-    double** U_array,
-    int idx_side)
+    const double U_0,
+    const double U_1,
+    const double U_2,
+    const double U_3,
+    const double U_4,
+    const double U_5)
 {
-    *beta_0 = double(1)/double(3)*(U_array[0][idx_side]*(double(4)*U_array[0][idx_side] -
-         double(19)*U_array[1][idx_side] + double(11)*U_array[2][idx_side]) +
-         U_array[1][idx_side]*(double(25)*U_array[1][idx_side] - double(31)*U_array[2][idx_side]) +
-         double(10)*U_array[2][idx_side]*U_array[2][idx_side]);
-    
-    *beta_1 = double(1)/double(3)*(U_array[1][idx_side]*(double(4)*U_array[1][idx_side] -
-         double(13)*U_array[2][idx_side] + double(5)*U_array[3][idx_side]) +
-         double(13)*U_array[2][idx_side]*(U_array[2][idx_side] - U_array[3][idx_side]) +
-         double(4)*U_array[3][idx_side]*U_array[3][idx_side]);
-    
-    *beta_2 = double(1)/double(3)*(U_array[2][idx_side]*(double(10)*U_array[2][idx_side] -
-         double(31)*U_array[3][idx_side] + double(11)*U_array[4][idx_side]) +
-         U_array[3][idx_side]*(double(25)*U_array[3][idx_side] - double(19)*U_array[4][idx_side]) +
-         double(4)*U_array[4][idx_side]*U_array[4][idx_side]);
-    
-    *beta_3 = double(1)/double(232243200)*(U_array[0][idx_side]*(double(525910327)*U_array[0][idx_side] -
-         double(4562164630)*U_array[1][idx_side] + double(7799501420)*U_array[2][idx_side] -
-         double(6610694540)*U_array[3][idx_side] + double(2794296070)*U_array[4][idx_side] -
-         double(472758974)*U_array[5][idx_side]) + double(5)*U_array[1][idx_side]*
-        (double(2146987907)*U_array[1][idx_side] - double(7722406988)*U_array[2][idx_side] +
-         double(6763559276)*U_array[3][idx_side] - double(2926461814)*U_array[4][idx_side] +
-         double(503766638)*U_array[5][idx_side]) + double(20)*U_array[2][idx_side]*
-        (double(1833221603)*U_array[2][idx_side] - double(3358664662)*U_array[3][idx_side] +
-         double(1495974539)*U_array[4][idx_side] - double(263126407)*U_array[5][idx_side]) +
-        double(20)*U_array[3][idx_side]*(double(1607794163)*U_array[3][idx_side] -
-         double(1486026707)*U_array[4][idx_side] + double(268747951)*U_array[5][idx_side]) +
-        double(5)*U_array[4][idx_side]*(double(1432381427)*U_array[4][idx_side] -
-         double(536951582)*U_array[5][idx_side]) +
-        double(263126407)*U_array[5][idx_side]*U_array[5][idx_side]);
+    *beta_0 = double(1)/double(3)*(U_0*(double(4)*U_0 - double(19)*U_1 + double(11)*U_2) +
+         U_1*(double(25)*U_1 - double(31)*U_2) + double(10)*U_2*U_2);
+    
+    *beta_1 = double(1)/double(3)*(U_1*(double(4)*U_1 - double(13)*U_2 + double(5)*U_3) +
+         double(13)*U_2*(U_2 - U_3) + double(4)*U_3*U_3);
+    
+    *beta_2 = double(1)/double(3)*(U_2*(double(10)*U_2 - double(31)*U_3 + double(11)*U_4) +
+         U_3*(double(25)*U_3 - double(19)*U_4) + double(4)*U_4*U_4);
+    
+    *beta_3 = double(1)/double(232243200)*(U_0*(double(525910327)*U_0 - double(4562164630)*U_1 +
+         double(7799501420)*U_2 - double(6610694540)*U_3 + double(2794296070)*U_4 -
+         double(472758974)*U_5) + double(5)*U_1*(double(2146987907)*U_1 - double(7722406988)*U_2 +
+         double(6763559276)*U_3 - double(2926461814)*U_4 + double(503766638)*U_5) +
+         double(20)*U_2*(double(1833221603)*U_2 - double(3358664662)*U_3 + double(1495974539)*U_4 -
+         double(263126407)*U_5) + double(20)*U_3*(double(1607794163)*U_3 - double(1486026707)*U_4 +
+         double(268747951)*U_5) + double(5)*U_4*(double(1432381427)*U_4 - double(536951582)*U_5) +
+         double(263126407)*U_5*U_5);
 }
 
 
@@ -71,160 +51,276 @@ static inline __attribute__((always_inline)) void computeLocalBetaTilde(
     double* beta_tilde_1,
     double* beta_tilde_2,
     double* beta_tilde_3,
-    double** U_array,
-    int idx_side)
+    const double U_0,
+    const double U_1,
+    const double U_2,
+    const double U_3,
+    const double U_4,
+    const double U_5)
 {
-    *beta_tilde_0 = double(1)/double(3)*(U_array[5][idx_side]*(double(4)*U_array[5][idx_side] -
-         double(19)*U_array[4][idx_side] + double(11)*U_array[3][idx_side]) +
-         U_array[4][idx_side]*(double(25)*U_array[4][idx_side] - double(31)*U_array[3][idx_side]) +
-         double(10)*U_array[3][idx_side]*U_array[3][idx_side]);
-    
-    *beta_tilde_1 = double(1)/double(3)*(U_array[4][idx_side]*(double(4)*U_array[4][idx_side] -
-         double(13)*U_array[3][idx_side] + double(5)*U_array[2][idx_side]) +
-         double(13)*U_array[3][idx_side]*(U_array[3][idx_side] - U_array[2][idx_side]) +
-         double(4)*U_array[2][idx_side]*U_array[2][idx_side]);
-    
-    *beta_tilde_2 = double(1)/double(3)*(U_array[3][idx_side]*(double(10)*U_array[3][idx_side] -
-         double(31)*U_array[2][idx_side] + double(11)*U_array[1][idx_side]) +
-         U_array[2][idx_side]*(double(25)*U_array[2][idx_side] - double(19)*U_array[1][idx_side]) +
-         double(4)*U_array[1][idx_side]*U_array[1][idx_side]);
-    
-    *beta_tilde_3 = double(1)/double(232243200)*(U_array[5][idx_side]*(double(525910327)*U_array[5][idx_side] -
-         double(4562164630)*U_array[4][idx_side] + double(7799501420)*U_array[3][idx_side] -
-         double(6610694540)*U_array[2][idx_side] + double(2794296070)*U_array[1][idx_side] -
-         double(472758974)*U_array[0][idx_side]) + double(5)*U_array[4][idx_side]*
-        (double(2146987907)*U_array[4][idx_side] - double(7722406988)*U_array[3][idx_side] +
-         double(6763559276)*U_array[2][idx_side] - double(2926461814)*U_array[1][idx_side] +
-         double(503766638)*U_array[0][idx_side]) + double(20)*U_array[3][idx_side]*
-        (double(1833221603)*U_array[3][idx_side] - double(3358664662)*U_array[2][idx_side] +
-         double(1495974539)*U_array[1][idx_side] - double(263126407)*U_array[0][idx_side]) +
-        double(20)*U_array[2][idx_side]*(double(1607794163)*U_array[2][idx_side] -
-         double(1486026707)*U_array[1][idx_side] + double(268747951)*U_array[0][idx_side]) +
-        double(5)*U_array[1][idx_side]*(double(1432381427)*U_array[1][idx_side] -
-         double(536951582)*U_array[0][idx_side]) +
-        double(263126407)*U_array[0][idx_side]*U_array[0][idx_side]);
+    *beta_tilde_0 = double(1)/double(3)*(U_5*(double(4)*U_5 - double(19)*U_4 + double(11)*U_3) +
+         U_4*(double(25)*U_4 - double(31)*U_3) + double(10)*U_3*U_3);
+    
+    *beta_tilde_1 = double(1)/double(3)*(U_4*(double(4)*U_4 - double(13)*U_3 + double(5)*U_2) +
+         double(13)*U_3*(U_3 - U_2) + double(4)*U_2*U_2);
+    
+    *beta_tilde_2 = double(1)/double(3)*(U_3*(double(10)*U_3 - double(31)*U_2 + double(11)*U_1) +
+         U_2*(double(25)*U_2 - double(19)*U_1) + double(4)*U_1*U_1);
+    
+    *beta_tilde_3 = double(1)/double(232243200)*(U_5*(double(525910327)*U_5 - double(4562164630)*U_4 +
+         double(7799501420)*U_3 - double(6610694540)*U_2 + double(2794296070)*U_1 -
+         double(472758974)*U_0) + double(5)*U_4*(double(2146987907)*U_4 - double(7722406988)*U_3 +
+         double(6763559276)*U_2 - double(2926461814)*U_1 + double(503766638)*U_0) +
+         double(20)*U_3*(double(1833221603)*U_3 - double(3358664662)*U_2 + double(1495974539)*U_1 -
+         double(263126407)*U_0) + double(20)*U_2*(double(1607794163)*U_2 - double(1486026707)*U_1 +
+         double(268747951)*U_0) + double(5)*U_1*(double(1432381427)*U_1 - double(536951582)*U_0) +
+         double(263126407)*U_0*U_0);
 }
 
 
 /*
- * Perform local WENO interpolation of U_minus.
+ * Perform WENO interpolation of U_minus at a row of contiguous mid-points. The mid-points are
+ * interpolated in batches of WENO_BATCH_SIZE. For each batch, the bases of the weights, their powers
+ * and the weighted interpolation are computed in separate loops over the contiguous stencil arrays,
+ * so that the loop over the exponent q is not inside the vectorized loops. If SIMD is enabled, the
+ * loops are vectorized and compiled for the instruction sets selected at runtime.
  */
-static inline __attribute__((always_inline)) void performLocalWENOInterpolationMinus(
+static HAMERS_SIMD_TARGET_CLONES void performWENOInterpolationMinusOnRow(
    double* U_minus,
    double** U_array,
-   int idx_side,
+   int idx_side_start,
+   int num_sides,
    int q,
    double C,
    double Chi,
    double epsilon,
    double dx)
 {
-    /*
-     * Compute beta's.
-     */
-    
-    double beta_0, beta_1, beta_2, beta_3;
-    
-    computeLocalBeta(&beta_0, &beta_1, &beta_2, &beta_3, U_array, idx_side);
-    
-    /*
-     * Compute the weights omega.
-     */
-    
-    double omega_0, omega_1, omega_2, omega_3;
-    
-    double beta_avg = double(1)/double(8)*(beta_0 + beta_2 + 6*beta_1);
-    double tau_6 = fabs(beta_3 - beta_avg);
-    
-    omega_0 = double(1)/double(32)*ipow(C + tau_6/(beta_0 + epsilon*dx*dx)*
-        (beta_avg + Chi*dx*dx)/(beta_0 + Chi*dx*dx), q);
-    omega_1 = double(15)/double(32)*ipow(C + tau_6/(beta_1 + epsilon*dx*dx)*
-        (beta_avg + Chi*dx*dx)/(beta_1 + Chi*dx*dx), q);
-    omega_2 = double(15)/double(32)*ipow(C + tau_6/(beta_2 + epsilon*dx*dx)*
-        (beta_avg + Chi*dx*dx)/(beta_2 + Chi*dx*dx), q);
-    omega_3 = double(1)/double(32)*ipow(C + tau_6/(beta_3 + epsilon*dx*dx)*
-        (beta_avg + Chi*dx*dx)/(beta_3 + Chi*dx*dx), q);
+    const double* __restrict__ U_0 = U_array[0] + idx_side_start;
+    const double* __restrict__ U_1 = U_array[1] + idx_side_start;
+    const double* __restrict__ U_2 = U_array[2] + idx_side_start;
+    const double* __restrict__ U_3 = U_array[3] + idx_side_start;
+    const double* __restrict__ U_4 = U_array[4] + idx_side_start;
+    const double* __restrict__ U_5 = U_array[5] + idx_side_start;
     
-    double omega_sum = omega_0 + omega_1 + omega_2 + omega_3;
+    double* __restrict__ U_m = U_minus + idx_side_start;
     
-    omega_0 = omega_0/omega_sum;
-    omega_1 = omega_1/omega_sum;
-    omega_2 = omega_2/omega_sum;
-    omega_3 = omega_3/omega_sum;
+    const double epsilon_dx_sq = epsilon*dx*dx;
+    const double Chi_dx_sq = Chi*dx*dx;
     
-    /*
-     * Compute U_minus.
-     */
+    double base_0[WENO_BATCH_SIZE], base_1[WENO_BATCH_SIZE], base_2[WENO_BATCH_SIZE],
+        base_3[WENO_BATCH_SIZE];
+    double base_pow_0[WENO_BATCH_SIZE], base_pow_1[WENO_BATCH_SIZE], base_pow_2[WENO_BATCH_SIZE],
+        base_pow_3[WENO_BATCH_SIZE];
     
-    U_minus[idx_side] = double(3)/double(8)*omega_0*U_array[0][idx_side] +
-        (-double(10)/double(8)*omega_0 - double(1)/double(8)*omega_1)*U_array[1][idx_side] +
-        (double(15)/double(8)*omega_0 + double(6)/double(8)*omega_1 + double(3)/double(8)*omega_2)*
-            U_array[2][idx_side] +
-        (double(3)/double(8)*omega_1 + double(6)/double(8)*omega_2 + double(15)/double(8)*omega_3)*
-            U_array[3][idx_side] +
-        (-double(1)/double(8)*omega_2 - double(10)/double(8)*omega_3)*U_array[4][idx_side] +
-        double(3)/double(8)*omega_3*U_array[5][idx_side];
+    for (int ib = 0; ib < num_sides; ib += WENO_BATCH_SIZE)
+    {
+        const int batch_size = std::min(WENO_BATCH_SIZE, num_sides - ib);
+        
+        /*
+         * Compute beta's and the bases of the weights omega.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            double beta_0, beta_1, beta_2, beta_3;
+            
+            computeLocalBeta(&beta_0, &beta_1, &beta_2, &beta_3,
+                U_0[idx], U_1[idx], U_2[idx], U_3[idx], U_4[idx], U_5[idx]);
+            
+            const double beta_avg = double(1)/double(8)*(beta_0 + beta_2 + 6*beta_1);
+            const double tau_6 = fabs(beta_3 - beta_avg);
+            
+            const double tau_6_scaled = tau_6*(beta_avg + Chi_dx_sq);
+            
+            base_0[i] = C + tau_6_scaled/((beta_0 + epsilon_dx_sq)*(beta_0 + Chi_dx_sq));
+            base_1[i] = C + tau_6_scaled/((beta_1 + epsilon_dx_sq)*(beta_1 + Chi_dx_sq));
+            base_2[i] = C + tau_6_scaled/((beta_2 + epsilon_dx_sq)*(beta_2 + Chi_dx_sq));
+            base_3[i] = C + tau_6_scaled/((beta_3 + epsilon_dx_sq)*(beta_3 + Chi_dx_sq));
+            
+            base_pow_0[i] = base_0[i];
+            base_pow_1[i] = base_1[i];
+            base_pow_2[i] = base_2[i];
+            base_pow_3[i] = base_3[i];
+        }
+        
+        /*
+         * Raise the bases to the power q.
+         */
+        
+        for (int k = 1; k < q; k++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < batch_size; i++)
+            {
+                base_pow_0[i] *= base_0[i];
+                base_pow_1[i] *= base_1[i];
+                base_pow_2[i] *= base_2[i];
+                base_pow_3[i] *= base_3[i];
+            }
+        }
+        
+        /*
+         * Compute the weights omega and U_minus. The weights are normalized after the weighted sum
+         * of the interpolations of the stencils.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            const double omega_0 = double(1)/double(32)*base_pow_0[i];
+            const double omega_1 = double(15)/double(32)*base_pow_1[i];
+            const double omega_2 = double(15)/double(32)*base_pow_2[i];
+            const double omega_3 = double(1)/double(32)*base_pow_3[i];
+            
+            const double omega_sum_inv = double(1)/(omega_0 + omega_1 + omega_2 + omega_3);
+            
+            U_m[idx] = omega_sum_inv*(
+                omega_0*(double(3)/double(8)*U_0[idx] - double(10)/double(8)*U_1[idx] +
+                    double(15)/double(8)*U_2[idx]) +
+                omega_1*(-double(1)/double(8)*U_1[idx] + double(6)/double(8)*U_2[idx] +
+                    double(3)/double(8)*U_3[idx]) +
+                omega_2*(double(3)/double(8)*U_2[idx] + double(6)/double(8)*U_3[idx] -
+                    double(1)/double(8)*U_4[idx]) +
+                omega_3*(double(15)/double(8)*U_3[idx] - double(10)/double(8)*U_4[idx] +
+                    double(3)/double(8)*U_5[idx]));
+        }
+    }
 }
 
 
 /*
- * Perform local WENO interpolation of U_plus.
+ * Perform WENO interpolation of U_plus at a row of contiguous mid-points. The mid-points are
+ * interpolated in batches of WENO_BATCH_SIZE in the same way as U_minus.
  */
-static inline __attribute__((always_inline)) void performLocalWENOInterpolationPlus(
+static HAMERS_SIMD_TARGET_CLONES void performWENOInterpolationPlusOnRow(
    double* U_plus,
    double** U_array,
-   int idx_side,
+   int idx_side_start,
+   int num_sides,
    int q,
    double C,
    double Chi,
    double epsilon,
    double dx)
 {
-    /*
-     * Compute beta_tilde's.
-     */
-    
-    double beta_tilde_0, beta_tilde_1, beta_tilde_2, beta_tilde_3;
-    
-    computeLocalBetaTilde(&beta_tilde_0, &beta_tilde_1, &beta_tilde_2, &beta_tilde_3, U_array, idx_side);
-    
-    /*
-     * Compute the weights omega_tilde.
-     */
-    
-    double omega_tilde_0, omega_tilde_1, omega_tilde_2, omega_tilde_3;
+    const double* __restrict__ U_0 = U_array[0] + idx_side_start;
+    const double* __restrict__ U_1 = U_array[1] + idx_side_start;
+    const double* __restrict__ U_2 = U_array[2] + idx_side_start;
+    const double* __restrict__ U_3 = U_array[3] + idx_side_start;
+    const double* __restrict__ U_4 = U_array[4] + idx_side_start;
+    const double* __restrict__ U_5 = U_array[5] + idx_side_start;
     
-    double beta_avg_tilde = double(1)/double(8)*(beta_tilde_0 + beta_tilde_2 + 6*beta_tilde_1);
-    double tau_6_tilde = fabs(beta_tilde_3 - beta_avg_tilde);
+    double* __restrict__ U_p = U_plus + idx_side_start;
     
-    omega_tilde_0 = double(1)/double(32)*ipow(C + tau_6_tilde/(beta_tilde_0 + epsilon*dx*dx)*
-        (beta_avg_tilde + Chi*dx*dx)/(beta_tilde_0 + Chi*dx*dx), q);
-    omega_tilde_1 = double(15)/double(32)*ipow(C + tau_6_tilde/(beta_tilde_1 + epsilon*dx*dx)*
-        (beta_avg_tilde + Chi*dx*dx)/(beta_tilde_1 + Chi*dx*dx), q);
-    omega_tilde_2 = double(15)/double(32)*ipow(C + tau_6_tilde/(beta_tilde_2 + epsilon*dx*dx)*
-        (beta_avg_tilde + Chi*dx*dx)/(beta_tilde_2 + Chi*dx*dx), q);
-    omega_tilde_3 = double(1)/double(32)*ipow(C + tau_6_tilde/(beta_tilde_3 + epsilon*dx*dx)*
-        (beta_avg_tilde + Chi*dx*dx)/(beta_tilde_3 + Chi*dx*dx), q);
+    const double epsilon_dx_sq = epsilon*dx*dx;
+    const double Chi_dx_sq = Chi*dx*dx;
     
-    double omega_tilde_sum = omega_tilde_0 + omega_tilde_1 + omega_tilde_2 + omega_tilde_3;
+    double base_tilde_0[WENO_BATCH_SIZE], base_tilde_1[WENO_BATCH_SIZE], base_tilde_2[WENO_BATCH_SIZE],
+        base_tilde_3[WENO_BATCH_SIZE];
+    double base_tilde_pow_0[WENO_BATCH_SIZE], base_tilde_pow_1[WENO_BATCH_SIZE],
+        base_tilde_pow_2[WENO_BATCH_SIZE], base_tilde_pow_3[WENO_BATCH_SIZE];
     
-    omega_tilde_0 = omega_tilde_0/omega_tilde_sum;
-    omega_tilde_1 = omega_tilde_1/omega_tilde_sum;
-    omega_tilde_2 = omega_tilde_2/omega_tilde_sum;
-    omega_tilde_3 = omega_tilde_3/omega_tilde_sum;
-    
-    /*
-     * Compute U_plus.
-     */
-    
-    U_plus[idx_side] = double(3)/double(8)*omega_tilde_0*U_array[5][idx_side] +
-        (-double(10)/double(8)*omega_tilde_0 - double(1)/double(8)*omega_tilde_1)*U_array[4][idx_side] +
-        (double(15)/double(8)*omega_tilde_0 + double(6)/double(8)*omega_tilde_1 + double(3)/double(8)*omega_tilde_2)*
-            U_array[3][idx_side] +
-        (double(3)/double(8)*omega_tilde_1 + double(6)/double(8)*omega_tilde_2 + double(15)/double(8)*omega_tilde_3)*
-            U_array[2][idx_side] +
-        (-double(1)/double(8)*omega_tilde_2 - double(10)/double(8)*omega_tilde_3)*U_array[1][idx_side] +
-        double(3)/double(8)*omega_tilde_3*U_array[0][idx_side];
+    for (int ib = 0; ib < num_sides; ib += WENO_BATCH_SIZE)
+    {
+        const int batch_size = std::min(WENO_BATCH_SIZE, num_sides - ib);
+        
+        /*
+         * Compute beta_tilde's and the bases of the weights omega_tilde.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            double beta_tilde_0, beta_tilde_1, beta_tilde_2, beta_tilde_3;
+            
+            computeLocalBetaTilde(&beta_tilde_0, &beta_tilde_1, &beta_tilde_2, &beta_tilde_3,
+                U_0[idx], U_1[idx], U_2[idx], U_3[idx], U_4[idx], U_5[idx]);
+            
+            const double beta_avg_tilde = double(1)/double(8)*(beta_tilde_0 + beta_tilde_2 + 6*beta_tilde_1);
+            const double tau_6_tilde = fabs(beta_tilde_3 - beta_avg_tilde);
+            
+            const double tau_6_tilde_scaled = tau_6_tilde*(beta_avg_tilde + Chi_dx_sq);
+            
+            base_tilde_0[i] = C + tau_6_tilde_scaled/
+                ((beta_tilde_0 + epsilon_dx_sq)*(beta_tilde_0 + Chi_dx_sq));
+            base_tilde_1[i] = C + tau_6_tilde_scaled/
+                ((beta_tilde_1 + epsilon_dx_sq)*(beta_tilde_1 + Chi_dx_sq));
+            base_tilde_2[i] = C + tau_6_tilde_scaled/
+                ((beta_tilde_2 + epsilon_dx_sq)*(beta_tilde_2 + Chi_dx_sq));
+            base_tilde_3[i] = C + tau_6_tilde_scaled/
+                ((beta_tilde_3 + epsilon_dx_sq)*(beta_tilde_3 + Chi_dx_sq));
+            
+            base_tilde_pow_0[i] = base_tilde_0[i];
+            base_tilde_pow_1[i] = base_tilde_1[i];
+            base_tilde_pow_2[i] = base_tilde_2[i];
+            base_tilde_pow_3[i] = base_tilde_3[i];
+        }
+        
+        /*
+         * Raise the bases to the power q.
+         */
+        
+        for (int k = 1; k < q; k++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < batch_size; i++)
+            {
+                base_tilde_pow_0[i] *= base_tilde_0[i];
+                base_tilde_pow_1[i] *= base_tilde_1[i];
+                base_tilde_pow_2[i] *= base_tilde_2[i];
+                base_tilde_pow_3[i] *= base_tilde_3[i];
+            }
+        }
+        
+        /*
+         * Compute the weights omega_tilde and U_plus. The weights are normalized after the
+         * weighted sum of the interpolations of the stencils.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            const double omega_tilde_0 = double(1)/double(32)*base_tilde_pow_0[i];
+            const double omega_tilde_1 = double(15)/double(32)*base_tilde_pow_1[i];
+            const double omega_tilde_2 = double(15)/double(32)*base_tilde_pow_2[i];
+            const double omega_tilde_3 = double(1)/double(32)*base_tilde_pow_3[i];
+            
+            const double omega_tilde_sum_inv =
+                double(1)/(omega_tilde_0 + omega_tilde_1 + omega_tilde_2 + omega_tilde_3);
+            
+            U_p[idx] = omega_tilde_sum_inv*(
+                omega_tilde_0*(double(3)/double(8)*U_5[idx] - double(10)/double(8)*U_4[idx] +
+                    double(15)/double(8)*U_3[idx]) +
+                omega_tilde_1*(-double(1)/double(8)*U_4[idx] + double(6)/double(8)*U_3[idx] +
+                    double(3)/double(8)*U_2[idx]) +
+                omega_tilde_2*(double(3)/double(8)*U_3[idx] + double(6)/double(8)*U_2[idx] -
+                    double(1)/double(8)*U_1[idx]) +
+                omega_tilde_3*(double(15)/double(8)*U_2[idx] - double(10)/double(8)*U_1[idx] +
+                    double(3)/double(8)*U_0[idx]));
+        }
+    }
 }
 
 
@@ -299,6 +395,8 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::printClassData(
     os << "d_constant_epsilon = "
        << d_constant_epsilon
        << std::endl;
+    
+    printCommonClassData(os);
 }
 
 
@@ -314,6 +412,8 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::putToRestart(
     restart_db->putDouble("d_constant_C", d_constant_C);
     restart_db->putDouble("d_constant_Chi", d_constant_Chi);
     restart_db->putDouble("d_constant_epsilon", d_constant_epsilon);
+    
+    putCommonDataToRestart(restart_db);
 }
 
 
@@ -338,7 +438,7 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
      */
     
     const hier::IntVector interior_dims = variables_minus[0]->getBox().numberCells();
-    
+
 #ifdef HAMERS_DEBUG_CHECK_DEV_ASSERTIONS
     for (int ei = 0; ei < d_num_eqn; ei++)
     {
@@ -392,24 +492,19 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             
             double* U_L = variables_minus[ei]->getPointer(0);
             
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = -1; i < interior_dim_0 + 2; i++)
-            {
-                // Compute the linear index of the mid-point.
-                const int idx_midpoint_x = i + 1;
-                
-                performLocalWENOInterpolationMinus(
-                    U_L,
-                    U_array.data(),
-                    idx_midpoint_x,
-                    d_constant_q,
-                    d_constant_C,
-                    d_constant_Chi,
-                    d_constant_epsilon,
-                    dx);
-            }
+            // Compute the linear index of the first mid-point.
+            const int idx_midpoint_x = 0;
+            
+            performWENOInterpolationMinusOnRow(
+                U_L,
+                U_array.data(),
+                idx_midpoint_x,
+                interior_dim_0 + 3,
+                d_constant_q,
+                d_constant_C,
+                d_constant_Chi,
+                d_constant_epsilon,
+                dx);
         }
         
         for (int ei = 0; ei < d_num_eqn; ei++)
@@ -424,26 +519,21 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             
             double* U_R = variables_plus[ei]->getPointer(0);
             
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = -1; i < interior_dim_0 + 2; i++)
-            {
-                // Compute the linear index of the mid-point.
-                const int idx_midpoint_x = i + 1;
-                
-                performLocalWENOInterpolationPlus(
-                    U_R,
-                    U_array.data(),
-                    idx_midpoint_x,
-                    d_constant_q,
-                    d_constant_C,
-                    d_constant_Chi,
-                    d_constant_epsilon,
-                    dx);
-            }
+            // Compute the linear index of the first mid-point.
+            const int idx_midpoint_x = 0;
+            
+            performWENOInterpolationPlusOnRow(
+                U_R,
+                U_array.data(),
+                idx_midpoint_x,
+                interior_dim_0 + 3,
+                d_constant_q,
+                d_constant_C,
+                d_constant_Chi,
+                d_constant_epsilon,
+                dx);
         }
-        
+    
     } // if (d_dim == tbox::Dimension(1))
     else if (d_dim == tbox::Dimension(2))
     {
@@ -474,25 +564,19 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             
             for (int j = 0; j < interior_dim_1; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = -1; i < interior_dim_0 + 2; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_x = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 3);
-                    
-                    performLocalWENOInterpolationMinus(
-                        U_L,
-                        U_array.data(),
-                        idx_midpoint_x,
-                        d_constant_q,
-                        d_constant_C,
-                        d_constant_Chi,
-                        d_constant_epsilon,
-                        dx);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3);
+                
+                performWENOInterpolationMinusOnRow(
+                    U_L,
+                    U_array.data(),
+                    idx_midpoint_x,
+                    interior_dim_0 + 3,
+                    d_constant_q,
+                    d_constant_C,
+                    d_constant_Chi,
+                    d_constant_epsilon,
+                    dx);
             }
         }
         
@@ -510,25 +594,19 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             
             for (int j = 0; j < interior_dim_1; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = -1; i < interior_dim_0 + 2; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_x = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 3);
-                    
-                    performLocalWENOInterpolationPlus(
-                        U_R,
-                        U_array.data(),
-                        idx_midpoint_x,
-                        d_constant_q,
-                        d_constant_C,
-                        d_constant_Chi,
-                        d_constant_epsilon,
-                        dx);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3);
+                
+                performWENOInterpolationPlusOnRow(
+                    U_R,
+                    U_array.data(),
+                    idx_midpoint_x,
+                    interior_dim_0 + 3,
+                    d_constant_q,
+                    d_constant_C,
+                    d_constant_Chi,
+                    d_constant_epsilon,
+                    dx);
             }
         }
         
@@ -552,25 +630,20 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             
             for (int j = -1; j < interior_dim_1 + 2; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_y = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2);
-                    
-                    performLocalWENOInterpolationMinus(
-                        U_B,
-                        U_array.data(),
-                        idx_midpoint_y,
-                        d_constant_q,
-                        d_constant_C,
-                        d_constant_Chi,
-                        d_constant_epsilon,
-                        dx);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_y = 1 +
+                    (j + 1)*(interior_dim_0 + 2);
+                
+                performWENOInterpolationMinusOnRow(
+                    U_B,
+                    U_array.data(),
+                    idx_midpoint_y,
+                    interior_dim_0,
+                    d_constant_q,
+                    d_constant_C,
+                    d_constant_Chi,
+                    d_constant_epsilon,
+                    dx);
             }
         }
         
@@ -588,28 +661,23 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             
             for (int j = -1; j < interior_dim_1 + 2; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_y = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2);
-                    
-                    performLocalWENOInterpolationPlus(
-                        U_T,
-                        U_array.data(),
-                        idx_midpoint_y,
-                        d_constant_q,
-                        d_constant_C,
-                        d_constant_Chi,
-                        d_constant_epsilon,
-                        dx);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_y = 1 +
+                    (j + 1)*(interior_dim_0 + 2);
+                
+                performWENOInterpolationPlusOnRow(
+                    U_T,
+                    U_array.data(),
+                    idx_midpoint_y,
+                    interior_dim_0,
+                    d_constant_q,
+                    d_constant_C,
+                    d_constant_Chi,
+                    d_constant_epsilon,
+                    dx);
             }
         }
-        
+    
     } // if (d_dim == tbox::Dimension(2))
     else if (d_dim == tbox::Dimension(3))
     {
@@ -643,27 +711,21 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = -1; i < interior_dim_0 + 2; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_x = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 3) +
-                            (k + 1)*(interior_dim_0 + 3)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationMinus(
-                            U_L,
-                            U_array.data(),
-                            idx_midpoint_x,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_Chi,
-                            d_constant_epsilon,
-                            dx);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3) +
+                        (k + 1)*(interior_dim_0 + 3)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationMinusOnRow(
+                        U_L,
+                        U_array.data(),
+                        idx_midpoint_x,
+                        interior_dim_0 + 3,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_Chi,
+                        d_constant_epsilon,
+                        dx);
                 }
             }
         }
@@ -684,27 +746,21 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = -1; i < interior_dim_0 + 2; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_x = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 3) +
-                            (k + 1)*(interior_dim_0 + 3)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationPlus(
-                            U_R,
-                            U_array.data(),
-                            idx_midpoint_x,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_Chi,
-                            d_constant_epsilon,
-                            dx);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3) +
+                        (k + 1)*(interior_dim_0 + 3)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationPlusOnRow(
+                        U_R,
+                        U_array.data(),
+                        idx_midpoint_x,
+                        interior_dim_0 + 3,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_Chi,
+                        d_constant_epsilon,
+                        dx);
                 }
             }
         }
@@ -731,27 +787,22 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = -1; j < interior_dim_1 + 2; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_y = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 3);
-                        
-                        performLocalWENOInterpolationMinus(
-                            U_B,
-                            U_array.data(),
-                            idx_midpoint_y,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_Chi,
-                            d_constant_epsilon,
-                            dx);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_y = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 3);
+                    
+                    performWENOInterpolationMinusOnRow(
+                        U_B,
+                        U_array.data(),
+                        idx_midpoint_y,
+                        interior_dim_0,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_Chi,
+                        d_constant_epsilon,
+                        dx);
                 }
             }
         }
@@ -772,27 +823,22 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = -1; j < interior_dim_1 + 2; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_y = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 3);
-                        
-                        performLocalWENOInterpolationPlus(
-                            U_T,
-                            U_array.data(),
-                            idx_midpoint_y,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_Chi,
-                            d_constant_epsilon,
-                            dx);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_y = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 3);
+                    
+                    performWENOInterpolationPlusOnRow(
+                        U_T,
+                        U_array.data(),
+                        idx_midpoint_y,
+                        interior_dim_0,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_Chi,
+                        d_constant_epsilon,
+                        dx);
                 }
             }
         }
@@ -819,27 +865,22 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_z = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationMinus(
-                            U_B,
-                            U_array.data(),
-                            idx_midpoint_z,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_Chi,
-                            d_constant_epsilon,
-                            dx);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_z = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationMinusOnRow(
+                        U_B,
+                        U_array.data(),
+                        idx_midpoint_z,
+                        interior_dim_0,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_Chi,
+                        d_constant_epsilon,
+                        dx);
                 }
             }
         }
@@ -860,30 +901,25 @@ ConvectiveFluxReconstructorWCNS6_CU_M2_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_z = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationPlus(
-                            U_F,
-                            U_array.data(),
-                            idx_midpoint_z,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_Chi,
-                            d_constant_epsilon,
-                            dx);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_z = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationPlusOnRow(
+                        U_F,
+                        U_array.data(),
+                        idx_midpoint_z,
+                        interior_dim_0,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_Chi,
+                        d_constant_epsilon,
+                        dx);
                 }
             }
         }
-        
+    
     } // if (d_dim == tbox::Dimension(3))
 }
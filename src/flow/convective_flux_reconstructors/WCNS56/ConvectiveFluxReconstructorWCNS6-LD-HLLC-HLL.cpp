@@ -1,21 +1,9 @@
 #include "flow/convective_flux_reconstructors/WCNS56/ConvectiveFluxReconstructorWCNS6-LD-HLLC-HLL.hpp"
 
-#define EPSILON HAMERS_EPSILON
-
+#include <algorithm>
 
-/*
- * Interger based power function.
- */
-static inline __attribute__((always_inline)) double ipow(double base, int exp)
-{
-    double result = base;
-    for (int i = 1; i < exp; i++)
-    {
-        result *= base;
-    }
-
-    return result;
-}
+#define EPSILON HAMERS_EPSILON
+#define WENO_BATCH_SIZE 8
 
 
 /*
@@ -23,16 +11,18 @@ static inline __attribute__((always_inline)) double ipow(double base, int exp)
  */
 static inline __attribute__((always_inline)) void computeLocalSigma(
     double* sigma,
-    double** U_array,
-    int idx_side)
+    const double U_1,
+    const double U_2,
+    const double U_3,
+    const double U_4)
 {
     /*
      * Compute the sigma.
      */
     
-    const double alpha_1 = U_array[2][idx_side] - U_array[1][idx_side];
-    const double alpha_2 = U_array[3][idx_side] - U_array[2][idx_side];
-    const double alpha_3 = U_array[4][idx_side] - U_array[3][idx_side];
+    const double alpha_1 = U_2 - U_1;
+    const double alpha_2 = U_3 - U_2;
+    const double alpha_3 = U_4 - U_3;
     
     const double theta_1 = fabs(alpha_1 - alpha_2)/(fabs(alpha_1) + fabs(alpha_2) + EPSILON);
     const double theta_2 = fabs(alpha_2 - alpha_3)/(fabs(alpha_2) + fabs(alpha_3) + EPSILON);
@@ -49,38 +39,30 @@ static inline __attribute__((always_inline)) void computeLocalBeta(
     double* beta_1,
     double* beta_2,
     double* beta_3,
-    double** U_array,
-    int idx_side)
+    const double U_0,
+    const double U_1,
+    const double U_2,
+    const double U_3,
+    const double U_4,
+    const double U_5)
 {
-    *beta_0 = double(1)/double(3)*(U_array[0][idx_side]*(double(4)*U_array[0][idx_side] -
-         double(19)*U_array[1][idx_side] + double(11)*U_array[2][idx_side]) +
-         U_array[1][idx_side]*(double(25)*U_array[1][idx_side] - double(31)*U_array[2][idx_side]) +
-         double(10)*U_array[2][idx_side]*U_array[2][idx_side]);
-    
-    *beta_1 = double(1)/double(3)*(U_array[1][idx_side]*(double(4)*U_array[1][idx_side] -
-         double(13)*U_array[2][idx_side] + double(5)*U_array[3][idx_side]) +
-         double(13)*U_array[2][idx_side]*(U_array[2][idx_side] - U_array[3][idx_side]) +
-         double(4)*U_array[3][idx_side]*U_array[3][idx_side]);
-    
-    *beta_2 = double(1)/double(3)*(U_array[2][idx_side]*(double(10)*U_array[2][idx_side] -
-         double(31)*U_array[3][idx_side] + double(11)*U_array[4][idx_side]) +
-         U_array[3][idx_side]*(double(25)*U_array[3][idx_side] - double(19)*U_array[4][idx_side]) +
-         double(4)*U_array[4][idx_side]*U_array[4][idx_side]);
-    
-    *beta_3 = double(1)/double(232243200)*(U_array[0][idx_side]*(double(525910327)*U_array[0][idx_side] -
-         double(4562164630)*U_array[1][idx_side] + double(7799501420)*U_array[2][idx_side] -
-         double(6610694540)*U_array[3][idx_side] + double(2794296070)*U_array[4][idx_side] -
-         double(472758974)*U_array[5][idx_side]) + double(5)*U_array[1][idx_side]*
-        (double(2146987907)*U_array[1][idx_side] - double(7722406988)*U_array[2][idx_side] +
-         double(6763559276)*U_array[3][idx_side] - double(2926461814)*U_array[4][idx_side] +
-         double(503766638)*U_array[5][idx_side]) + double(20)*U_array[2][idx_side]*
-        (double(1833221603)*U_array[2][idx_side] - double(3358664662)*U_array[3][idx_side] +
-         double(1495974539)*U_array[4][idx_side] - double(263126407)*U_array[5][idx_side]) +
-        double(20)*U_array[3][idx_side]*(double(1607794163)*U_array[3][idx_side] -
-         double(1486026707)*U_array[4][idx_side] + double(268747951)*U_array[5][idx_side]) +
-        double(5)*U_array[4][idx_side]*(double(1432381427)*U_array[4][idx_side] -
-         double(536951582)*U_array[5][idx_side]) +
-        double(263126407)*U_array[5][idx_side]*U_array[5][idx_side]);
+    *beta_0 = double(1)/double(3)*(U_0*(double(4)*U_0 - double(19)*U_1 + double(11)*U_2) +
+         U_1*(double(25)*U_1 - double(31)*U_2) + double(10)*U_2*U_2);
+    
+    *beta_1 = double(1)/double(3)*(U_1*(double(4)*U_1 - double(13)*U_2 + double(5)*U_3) +
+         double(13)*U_2*(U_2 - U_3) + double(4)*U_3*U_3);
+    
+    *beta_2 = double(1)/double(3)*(U_2*(double(10)*U_2 - double(31)*U_3 + double(11)*U_4) +
+         U_3*(double(25)*U_3 - double(19)*U_4) + double(4)*U_4*U_4);
+    
+    *beta_3 = double(1)/double(232243200)*(U_0*(double(525910327)*U_0 - double(4562164630)*U_1 +
+         double(7799501420)*U_2 - double(6610694540)*U_3 + double(2794296070)*U_4 -
+         double(472758974)*U_5) + double(5)*U_1*(double(2146987907)*U_1 - double(7722406988)*U_2 +
+         double(6763559276)*U_3 - double(2926461814)*U_4 + double(503766638)*U_5) +
+         double(20)*U_2*(double(1833221603)*U_2 - double(3358664662)*U_3 + double(1495974539)*U_4 -
+         double(263126407)*U_5) + double(20)*U_3*(double(1607794163)*U_3 - double(1486026707)*U_4 +
+         double(268747951)*U_5) + double(5)*U_4*(double(1432381427)*U_4 - double(536951582)*U_5) +
+         double(263126407)*U_5*U_5);
 }
 
 
@@ -92,230 +74,403 @@ static inline __attribute__((always_inline)) void computeLocalBetaTilde(
     double* beta_tilde_1,
     double* beta_tilde_2,
     double* beta_tilde_3,
-    double** U_array,
-    int idx_side)
+    const double U_0,
+    const double U_1,
+    const double U_2,
+    const double U_3,
+    const double U_4,
+    const double U_5)
 {
-    *beta_tilde_0 = double(1)/double(3)*(U_array[5][idx_side]*(double(4)*U_array[5][idx_side] -
-         double(19)*U_array[4][idx_side] + double(11)*U_array[3][idx_side]) +
-         U_array[4][idx_side]*(double(25)*U_array[4][idx_side] - double(31)*U_array[3][idx_side]) +
-         double(10)*U_array[3][idx_side]*U_array[3][idx_side]);
-    
-    *beta_tilde_1 = double(1)/double(3)*(U_array[4][idx_side]*(double(4)*U_array[4][idx_side] -
-         double(13)*U_array[3][idx_side] + double(5)*U_array[2][idx_side]) +
-         double(13)*U_array[3][idx_side]*(U_array[3][idx_side] - U_array[2][idx_side]) +
-         double(4)*U_array[2][idx_side]*U_array[2][idx_side]);
-    
-    *beta_tilde_2 = double(1)/double(3)*(U_array[3][idx_side]*(double(10)*U_array[3][idx_side] -
-         double(31)*U_array[2][idx_side] + double(11)*U_array[1][idx_side]) +
-         U_array[2][idx_side]*(double(25)*U_array[2][idx_side] - double(19)*U_array[1][idx_side]) +
-         double(4)*U_array[1][idx_side]*U_array[1][idx_side]);
-    
-    *beta_tilde_3 = double(1)/double(232243200)*(U_array[5][idx_side]*(double(525910327)*U_array[5][idx_side] -
-         double(4562164630)*U_array[4][idx_side] + double(7799501420)*U_array[3][idx_side] -
-         double(6610694540)*U_array[2][idx_side] + double(2794296070)*U_array[1][idx_side] -
-         double(472758974)*U_array[0][idx_side]) + double(5)*U_array[4][idx_side]*
-        (double(2146987907)*U_array[4][idx_side] - double(7722406988)*U_array[3][idx_side] +
-         double(6763559276)*U_array[2][idx_side] - double(2926461814)*U_array[1][idx_side] +
-         double(503766638)*U_array[0][idx_side]) + double(20)*U_array[3][idx_side]*
-        (double(1833221603)*U_array[3][idx_side] - double(3358664662)*U_array[2][idx_side] +
-         double(1495974539)*U_array[1][idx_side] - double(263126407)*U_array[0][idx_side]) +
-        double(20)*U_array[2][idx_side]*(double(1607794163)*U_array[2][idx_side] -
-         double(1486026707)*U_array[1][idx_side] + double(268747951)*U_array[0][idx_side]) +
-        double(5)*U_array[1][idx_side]*(double(1432381427)*U_array[1][idx_side] -
-         double(536951582)*U_array[0][idx_side]) +
-        double(263126407)*U_array[0][idx_side]*U_array[0][idx_side]);
+    *beta_tilde_0 = double(1)/double(3)*(U_5*(double(4)*U_5 - double(19)*U_4 + double(11)*U_3) +
+         U_4*(double(25)*U_4 - double(31)*U_3) + double(10)*U_3*U_3);
+    
+    *beta_tilde_1 = double(1)/double(3)*(U_4*(double(4)*U_4 - double(13)*U_3 + double(5)*U_2) +
+         double(13)*U_3*(U_3 - U_2) + double(4)*U_2*U_2);
+    
+    *beta_tilde_2 = double(1)/double(3)*(U_3*(double(10)*U_3 - double(31)*U_2 + double(11)*U_1) +
+         U_2*(double(25)*U_2 - double(19)*U_1) + double(4)*U_1*U_1);
+    
+    *beta_tilde_3 = double(1)/double(232243200)*(U_5*(double(525910327)*U_5 - double(4562164630)*U_4 +
+         double(7799501420)*U_3 - double(6610694540)*U_2 + double(2794296070)*U_1 -
+         double(472758974)*U_0) + double(5)*U_4*(double(2146987907)*U_4 - double(7722406988)*U_3 +
+         double(6763559276)*U_2 - double(2926461814)*U_1 + double(503766638)*U_0) +
+         double(20)*U_3*(double(1833221603)*U_3 - double(3358664662)*U_2 + double(1495974539)*U_1 -
+         double(263126407)*U_0) + double(20)*U_2*(double(1607794163)*U_2 - double(1486026707)*U_1 +
+         double(268747951)*U_0) + double(5)*U_1*(double(1432381427)*U_1 - double(536951582)*U_0) +
+         double(263126407)*U_0*U_0);
 }
 
 
 /*
- * Perform local WENO interpolation of U_minus.
+ * Perform WENO interpolation of U_minus at a row of contiguous mid-points. The mid-points are
+ * interpolated in batches of WENO_BATCH_SIZE. For each batch, the ratios of tau_5 and tau_6 to the
+ * beta's, their powers and the weighted interpolation are computed in separate loops over the
+ * contiguous stencil arrays, so that the loops over the exponents p and q are not inside the
+ * vectorized loops. If SIMD is enabled, the loops are vectorized and compiled for the instruction
+ * sets selected at runtime.
  */
-static inline __attribute__((always_inline)) void performLocalWENOInterpolationMinus(
+static HAMERS_SIMD_TARGET_CLONES void performWENOInterpolationMinusOnRow(
    double* U_minus,
    double** U_array,
-   int idx_side,
+   int idx_side_start,
+   int num_sides,
    int p,
    int q,
    double C,
    double alpha_tau)
 {
-    /*
-     * Compute sigma.
-     */
-    
-    double sigma;
-    
-    computeLocalSigma(&sigma, U_array, idx_side);
-    
-    /*
-     * Compute beta's.
-     */
-    
-    double beta_0, beta_1, beta_2, beta_3;
-    
-    computeLocalBeta(&beta_0, &beta_1, &beta_2, &beta_3, U_array, idx_side);
-    
-    /*
-     * Compute the weights omega_upwind.
-     */
+    const double* __restrict__ U_0 = U_array[0] + idx_side_start;
+    const double* __restrict__ U_1 = U_array[1] + idx_side_start;
+    const double* __restrict__ U_2 = U_array[2] + idx_side_start;
+    const double* __restrict__ U_3 = U_array[3] + idx_side_start;
+    const double* __restrict__ U_4 = U_array[4] + idx_side_start;
+    const double* __restrict__ U_5 = U_array[5] + idx_side_start;
     
-    double omega_upwind_0, omega_upwind_1, omega_upwind_2;
-    
-    double tau_5 = fabs(beta_0 - beta_2);
-    
-    omega_upwind_0 = double(1)/double(16)*(double(1) + ipow(tau_5/(beta_0 + EPSILON), p));
-    omega_upwind_1 = double(5)/double(8)*(double(1) + ipow(tau_5/(beta_1 + EPSILON), p));
-    omega_upwind_2 = double(5)/double(16)*(double(1) + ipow(tau_5/(beta_2 + EPSILON), p));
-    
-    double omega_upwind_sum = omega_upwind_0 + omega_upwind_1 + omega_upwind_2;
-    
-    omega_upwind_0 = omega_upwind_0/omega_upwind_sum;
-    omega_upwind_1 = omega_upwind_1/omega_upwind_sum;
-    omega_upwind_2 = omega_upwind_2/omega_upwind_sum;
+    double* __restrict__ U_m = U_minus + idx_side_start;
     
     /*
-     * Compute the weights omega_central (store in omega first).
+     * sigma_blend is sigma where the upwind and central weights are blended and zero elsewhere.
      */
     
-    double omega_0, omega_1, omega_2, omega_3;
-    
-    double beta_avg = double(1)/double(8)*(beta_0 + beta_2 + double(6)*beta_1);
-    double tau_6 = fabs(beta_3 - beta_avg);
-    
-    omega_0 = double(1)/double(32)*(C + ipow(tau_6/(beta_0 + EPSILON), q));
-    omega_1 = double(15)/double(32)*(C + ipow(tau_6/(beta_1 + EPSILON), q));
-    omega_2 = double(15)/double(32)*(C + ipow(tau_6/(beta_2 + EPSILON), q));
-    omega_3 = double(1)/double(32)*(C + ipow(tau_6/(beta_3 + EPSILON), q));
+    double sigma_blend[WENO_BATCH_SIZE];
     
-    double omega_sum = omega_0 + omega_1 + omega_2 + omega_3;
+    double ratio_upwind_0[WENO_BATCH_SIZE], ratio_upwind_1[WENO_BATCH_SIZE],
+        ratio_upwind_2[WENO_BATCH_SIZE];
+    double ratio_upwind_pow_0[WENO_BATCH_SIZE], ratio_upwind_pow_1[WENO_BATCH_SIZE],
+        ratio_upwind_pow_2[WENO_BATCH_SIZE];
     
-    omega_0 = omega_0/omega_sum;
-    omega_1 = omega_1/omega_sum;
-    omega_2 = omega_2/omega_sum;
-    omega_3 = omega_3/omega_sum;
+    double ratio_central_0[WENO_BATCH_SIZE], ratio_central_1[WENO_BATCH_SIZE],
+        ratio_central_2[WENO_BATCH_SIZE], ratio_central_3[WENO_BATCH_SIZE];
+    double ratio_central_pow_0[WENO_BATCH_SIZE], ratio_central_pow_1[WENO_BATCH_SIZE],
+        ratio_central_pow_2[WENO_BATCH_SIZE], ratio_central_pow_3[WENO_BATCH_SIZE];
     
-    /*
-     * Compute the weights omega.
-     */
-    
-    double R_tau = fabs(tau_6/(beta_avg + EPSILON));
-    
-    if (R_tau > alpha_tau)
+    for (int ib = 0; ib < num_sides; ib += WENO_BATCH_SIZE)
     {
-        omega_0 = sigma*omega_upwind_0 + (double(1) - sigma)*omega_0;
-        omega_1 = sigma*omega_upwind_1 + (double(1) - sigma)*omega_1;
-        omega_2 = sigma*omega_upwind_2 + (double(1) - sigma)*omega_2;
-        omega_3 = (double(1) - sigma)*omega_3;
+        const int batch_size = std::min(WENO_BATCH_SIZE, num_sides - ib);
+        
+        /*
+         * Compute sigma, beta's and the ratios of tau_5 and tau_6 to the beta's.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            double sigma;
+            
+            computeLocalSigma(&sigma, U_1[idx], U_2[idx], U_3[idx], U_4[idx]);
+            
+            double beta_0, beta_1, beta_2, beta_3;
+            
+            computeLocalBeta(&beta_0, &beta_1, &beta_2, &beta_3,
+                U_0[idx], U_1[idx], U_2[idx], U_3[idx], U_4[idx], U_5[idx]);
+            
+            /*
+             * The reciprocals of the beta's are shared by the upwind and central weights.
+             */
+            
+            const double beta_0_inv = double(1)/(beta_0 + EPSILON);
+            const double beta_1_inv = double(1)/(beta_1 + EPSILON);
+            const double beta_2_inv = double(1)/(beta_2 + EPSILON);
+            const double beta_3_inv = double(1)/(beta_3 + EPSILON);
+            
+            const double tau_5 = fabs(beta_0 - beta_2);
+            
+            ratio_upwind_0[i] = tau_5*beta_0_inv;
+            ratio_upwind_1[i] = tau_5*beta_1_inv;
+            ratio_upwind_2[i] = tau_5*beta_2_inv;
+            
+            const double beta_avg = double(1)/double(8)*(beta_0 + beta_2 + double(6)*beta_1);
+            const double tau_6 = fabs(beta_3 - beta_avg);
+            
+            ratio_central_0[i] = tau_6*beta_0_inv;
+            ratio_central_1[i] = tau_6*beta_1_inv;
+            ratio_central_2[i] = tau_6*beta_2_inv;
+            ratio_central_3[i] = tau_6*beta_3_inv;
+            
+            const double R_tau = fabs(tau_6/(beta_avg + EPSILON));
+            
+            sigma_blend[i] = R_tau > alpha_tau ? sigma : double(0);
+            
+            ratio_upwind_pow_0[i] = ratio_upwind_0[i];
+            ratio_upwind_pow_1[i] = ratio_upwind_1[i];
+            ratio_upwind_pow_2[i] = ratio_upwind_2[i];
+            
+            ratio_central_pow_0[i] = ratio_central_0[i];
+            ratio_central_pow_1[i] = ratio_central_1[i];
+            ratio_central_pow_2[i] = ratio_central_2[i];
+            ratio_central_pow_3[i] = ratio_central_3[i];
+        }
+        
+        /*
+         * Raise the ratios to the powers p and q.
+         */
+        
+        for (int k = 1; k < p; k++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < batch_size; i++)
+            {
+                ratio_upwind_pow_0[i] *= ratio_upwind_0[i];
+                ratio_upwind_pow_1[i] *= ratio_upwind_1[i];
+                ratio_upwind_pow_2[i] *= ratio_upwind_2[i];
+            }
+        }
+        
+        for (int k = 1; k < q; k++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < batch_size; i++)
+            {
+                ratio_central_pow_0[i] *= ratio_central_0[i];
+                ratio_central_pow_1[i] *= ratio_central_1[i];
+                ratio_central_pow_2[i] *= ratio_central_2[i];
+                ratio_central_pow_3[i] *= ratio_central_3[i];
+            }
+        }
+        
+        /*
+         * Compute the weights omega_upwind and omega_central, blend them into the weights omega
+         * and compute U_minus.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            double omega_upwind_0 = double(1)/double(16)*(double(1) + ratio_upwind_pow_0[i]);
+            double omega_upwind_1 = double(5)/double(8)*(double(1) + ratio_upwind_pow_1[i]);
+            double omega_upwind_2 = double(5)/double(16)*(double(1) + ratio_upwind_pow_2[i]);
+            
+            const double omega_upwind_sum_inv =
+                double(1)/(omega_upwind_0 + omega_upwind_1 + omega_upwind_2);
+            
+            omega_upwind_0 *= omega_upwind_sum_inv;
+            omega_upwind_1 *= omega_upwind_sum_inv;
+            omega_upwind_2 *= omega_upwind_sum_inv;
+            
+            double omega_0 = double(1)/double(32)*(C + ratio_central_pow_0[i]);
+            double omega_1 = double(15)/double(32)*(C + ratio_central_pow_1[i]);
+            double omega_2 = double(15)/double(32)*(C + ratio_central_pow_2[i]);
+            double omega_3 = double(1)/double(32)*(C + ratio_central_pow_3[i]);
+            
+            const double omega_sum_inv = double(1)/(omega_0 + omega_1 + omega_2 + omega_3);
+            
+            const double sigma = sigma_blend[i];
+            const double one_minus_sigma = double(1) - sigma;
+            
+            omega_0 = sigma*omega_upwind_0 + one_minus_sigma*omega_sum_inv*omega_0;
+            omega_1 = sigma*omega_upwind_1 + one_minus_sigma*omega_sum_inv*omega_1;
+            omega_2 = sigma*omega_upwind_2 + one_minus_sigma*omega_sum_inv*omega_2;
+            omega_3 = one_minus_sigma*omega_sum_inv*omega_3;
+            
+            U_m[idx] =
+                omega_0*(double(3)/double(8)*U_0[idx] - double(10)/double(8)*U_1[idx] +
+                    double(15)/double(8)*U_2[idx]) +
+                omega_1*(-double(1)/double(8)*U_1[idx] + double(6)/double(8)*U_2[idx] +
+                    double(3)/double(8)*U_3[idx]) +
+                omega_2*(double(3)/double(8)*U_2[idx] + double(6)/double(8)*U_3[idx] -
+                    double(1)/double(8)*U_4[idx]) +
+                omega_3*(double(15)/double(8)*U_3[idx] - double(10)/double(8)*U_4[idx] +
+                    double(3)/double(8)*U_5[idx]);
+        }
     }
-    
-    /*
-     * Compute U_minus.
-     */
-    
-    U_minus[idx_side] = double(3)/double(8)*omega_0*U_array[0][idx_side] +
-        (-double(10)/double(8)*omega_0 - double(1)/double(8)*omega_1)*U_array[1][idx_side] +
-        (double(15)/double(8)*omega_0 + double(6)/double(8)*omega_1 + double(3)/double(8)*omega_2)*
-            U_array[2][idx_side] +
-        (double(3)/double(8)*omega_1 + double(6)/double(8)*omega_2 + double(15)/double(8)*omega_3)*
-            U_array[3][idx_side] +
-        (-double(1)/double(8)*omega_2 - double(10)/double(8)*omega_3)*U_array[4][idx_side] +
-        double(3)/double(8)*omega_3*U_array[5][idx_side];
 }
 
 
 /*
- * Perform local WENO interpolation of U_plus.
+ * Perform WENO interpolation of U_plus at a row of contiguous mid-points. The mid-points are
+ * interpolated in batches of WENO_BATCH_SIZE in the same way as U_minus.
  */
-static inline __attribute__((always_inline)) void performLocalWENOInterpolationPlus(
+static HAMERS_SIMD_TARGET_CLONES void performWENOInterpolationPlusOnRow(
    double* U_plus,
    double** U_array,
-   int idx_side,
+   int idx_side_start,
+   int num_sides,
    int p,
    int q,
    double C,
    double alpha_tau)
 {
-    /*
-     * Compute sigma.
-     */
-    
-    double sigma;
-    
-    computeLocalSigma(&sigma, U_array, idx_side);
-    
-    /*
-     * Compute beta_tilde's.
-     */
-    
-    double beta_tilde_0, beta_tilde_1, beta_tilde_2, beta_tilde_3;
-    
-    computeLocalBetaTilde(&beta_tilde_0, &beta_tilde_1, &beta_tilde_2, &beta_tilde_3, U_array, idx_side);
-    
-    /*
-     * Compute the weights omega_upwind_tilde.
-     */
-    
-    double omega_upwind_tilde_0, omega_upwind_tilde_1, omega_upwind_tilde_2;
-    
-    double tau_5_tilde = fabs(beta_tilde_0 - beta_tilde_2);
-    
-    omega_upwind_tilde_0 = double(1)/double(16)*(double(1) + ipow(tau_5_tilde/(beta_tilde_0 + EPSILON), p));
-    omega_upwind_tilde_1 = double(5)/double(8)*(double(1) + ipow(tau_5_tilde/(beta_tilde_1 + EPSILON), p));
-    omega_upwind_tilde_2 = double(5)/double(16)*(double(1) + ipow(tau_5_tilde/(beta_tilde_2 + EPSILON), p));
-    
-    double omega_upwind_tilde_sum = omega_upwind_tilde_0 + omega_upwind_tilde_1 + omega_upwind_tilde_2;
+    const double* __restrict__ U_0 = U_array[0] + idx_side_start;
+    const double* __restrict__ U_1 = U_array[1] + idx_side_start;
+    const double* __restrict__ U_2 = U_array[2] + idx_side_start;
+    const double* __restrict__ U_3 = U_array[3] + idx_side_start;
+    const double* __restrict__ U_4 = U_array[4] + idx_side_start;
+    const double* __restrict__ U_5 = U_array[5] + idx_side_start;
     
-    omega_upwind_tilde_0 = omega_upwind_tilde_0/omega_upwind_tilde_sum;
-    omega_upwind_tilde_1 = omega_upwind_tilde_1/omega_upwind_tilde_sum;
-    omega_upwind_tilde_2 = omega_upwind_tilde_2/omega_upwind_tilde_sum;
+    double* __restrict__ U_p = U_plus + idx_side_start;
     
     /*
-     * Compute the weights omega_central_tilde (store in omega_tilde first).
+     * sigma_blend is sigma where the upwind and central weights are blended and zero elsewhere.
      */
     
-    double omega_tilde_0, omega_tilde_1, omega_tilde_2, omega_tilde_3;
+    double sigma_blend[WENO_BATCH_SIZE];
     
-    double beta_avg_tilde = double(1)/double(8)*(beta_tilde_0 + beta_tilde_2 + double(6)*beta_tilde_1);
-    double tau_6_tilde = fabs(beta_tilde_3 - beta_avg_tilde);
+    double ratio_upwind_tilde_0[WENO_BATCH_SIZE], ratio_upwind_tilde_1[WENO_BATCH_SIZE],
+        ratio_upwind_tilde_2[WENO_BATCH_SIZE];
+    double ratio_upwind_tilde_pow_0[WENO_BATCH_SIZE], ratio_upwind_tilde_pow_1[WENO_BATCH_SIZE],
+        ratio_upwind_tilde_pow_2[WENO_BATCH_SIZE];
     
-    omega_tilde_0 = double(1)/double(32)*(C + ipow(tau_6_tilde/(beta_tilde_0 + EPSILON), q));
-    omega_tilde_1 = double(15)/double(32)*(C + ipow(tau_6_tilde/(beta_tilde_1 + EPSILON), q));
-    omega_tilde_2 = double(15)/double(32)*(C + ipow(tau_6_tilde/(beta_tilde_2 + EPSILON), q));
-    omega_tilde_3 = double(1)/double(32)*(C + ipow(tau_6_tilde/(beta_tilde_3 + EPSILON), q));
+    double ratio_central_tilde_0[WENO_BATCH_SIZE], ratio_central_tilde_1[WENO_BATCH_SIZE],
+        ratio_central_tilde_2[WENO_BATCH_SIZE], ratio_central_tilde_3[WENO_BATCH_SIZE];
+    double ratio_central_tilde_pow_0[WENO_BATCH_SIZE], ratio_central_tilde_pow_1[WENO_BATCH_SIZE],
+        ratio_central_tilde_pow_2[WENO_BATCH_SIZE], ratio_central_tilde_pow_3[WENO_BATCH_SIZE];
     
-    double omega_tilde_sum = omega_tilde_0 + omega_tilde_1 + omega_tilde_2 + omega_tilde_3;
-    
-    omega_tilde_0 = omega_tilde_0/omega_tilde_sum;
-    omega_tilde_1 = omega_tilde_1/omega_tilde_sum;
-    omega_tilde_2 = omega_tilde_2/omega_tilde_sum;
-    omega_tilde_3 = omega_tilde_3/omega_tilde_sum;
-    
-    /*
-     * Compute the weights omega_tilde.
-     */
-    
-    double R_tau_tilde = fabs(tau_6_tilde/(beta_avg_tilde + EPSILON));
-    
-    if (R_tau_tilde > alpha_tau)
+    for (int ib = 0; ib < num_sides; ib += WENO_BATCH_SIZE)
     {
-        omega_tilde_0 = sigma*omega_upwind_tilde_0 + (double(1) - sigma)*omega_tilde_0;
-        omega_tilde_1 = sigma*omega_upwind_tilde_1 + (double(1) - sigma)*omega_tilde_1;
-        omega_tilde_2 = sigma*omega_upwind_tilde_2 + (double(1) - sigma)*omega_tilde_2;
-        omega_tilde_3 = (double(1) - sigma)*omega_tilde_3;
+        const int batch_size = std::min(WENO_BATCH_SIZE, num_sides - ib);
+        
+        /*
+         * Compute sigma, beta_tilde's and the ratios of tau_5_tilde and tau_6_tilde to the
+         * beta_tilde's.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            double sigma;
+            
+            computeLocalSigma(&sigma, U_1[idx], U_2[idx], U_3[idx], U_4[idx]);
+            
+            double beta_tilde_0, beta_tilde_1, beta_tilde_2, beta_tilde_3;
+            
+            computeLocalBetaTilde(&beta_tilde_0, &beta_tilde_1, &beta_tilde_2, &beta_tilde_3,
+                U_0[idx], U_1[idx], U_2[idx], U_3[idx], U_4[idx], U_5[idx]);
+            
+            /*
+             * The reciprocals of the beta_tilde's are shared by the upwind and central weights.
+             */
+            
+            const double beta_tilde_0_inv = double(1)/(beta_tilde_0 + EPSILON);
+            const double beta_tilde_1_inv = double(1)/(beta_tilde_1 + EPSILON);
+            const double beta_tilde_2_inv = double(1)/(beta_tilde_2 + EPSILON);
+            const double beta_tilde_3_inv = double(1)/(beta_tilde_3 + EPSILON);
+            
+            const double tau_5_tilde = fabs(beta_tilde_0 - beta_tilde_2);
+            
+            ratio_upwind_tilde_0[i] = tau_5_tilde*beta_tilde_0_inv;
+            ratio_upwind_tilde_1[i] = tau_5_tilde*beta_tilde_1_inv;
+            ratio_upwind_tilde_2[i] = tau_5_tilde*beta_tilde_2_inv;
+            
+            const double beta_avg_tilde = double(1)/double(8)*(beta_tilde_0 + beta_tilde_2 +
+                double(6)*beta_tilde_1);
+            const double tau_6_tilde = fabs(beta_tilde_3 - beta_avg_tilde);
+            
+            ratio_central_tilde_0[i] = tau_6_tilde*beta_tilde_0_inv;
+            ratio_central_tilde_1[i] = tau_6_tilde*beta_tilde_1_inv;
+            ratio_central_tilde_2[i] = tau_6_tilde*beta_tilde_2_inv;
+            ratio_central_tilde_3[i] = tau_6_tilde*beta_tilde_3_inv;
+            
+            const double R_tau_tilde = fabs(tau_6_tilde/(beta_avg_tilde + EPSILON));
+            
+            sigma_blend[i] = R_tau_tilde > alpha_tau ? sigma : double(0);
+            
+            ratio_upwind_tilde_pow_0[i] = ratio_upwind_tilde_0[i];
+            ratio_upwind_tilde_pow_1[i] = ratio_upwind_tilde_1[i];
+            ratio_upwind_tilde_pow_2[i] = ratio_upwind_tilde_2[i];
+            
+            ratio_central_tilde_pow_0[i] = ratio_central_tilde_0[i];
+            ratio_central_tilde_pow_1[i] = ratio_central_tilde_1[i];
+            ratio_central_tilde_pow_2[i] = ratio_central_tilde_2[i];
+            ratio_central_tilde_pow_3[i] = ratio_central_tilde_3[i];
+        }
+        
+        /*
+         * Raise the ratios to the powers p and q.
+         */
+        
+        for (int k = 1; k < p; k++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < batch_size; i++)
+            {
+                ratio_upwind_tilde_pow_0[i] *= ratio_upwind_tilde_0[i];
+                ratio_upwind_tilde_pow_1[i] *= ratio_upwind_tilde_1[i];
+                ratio_upwind_tilde_pow_2[i] *= ratio_upwind_tilde_2[i];
+            }
+        }
+        
+        for (int k = 1; k < q; k++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < batch_size; i++)
+            {
+                ratio_central_tilde_pow_0[i] *= ratio_central_tilde_0[i];
+                ratio_central_tilde_pow_1[i] *= ratio_central_tilde_1[i];
+                ratio_central_tilde_pow_2[i] *= ratio_central_tilde_2[i];
+                ratio_central_tilde_pow_3[i] *= ratio_central_tilde_3[i];
+            }
+        }
+        
+        /*
+         * Compute the weights omega_upwind_tilde and omega_central_tilde, blend them into the
+         * weights omega_tilde and compute U_plus.
+         */
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = 0; i < batch_size; i++)
+        {
+            const int idx = ib + i;
+            
+            double omega_upwind_tilde_0 = double(1)/double(16)*(double(1) + ratio_upwind_tilde_pow_0[i]);
+            double omega_upwind_tilde_1 = double(5)/double(8)*(double(1) + ratio_upwind_tilde_pow_1[i]);
+            double omega_upwind_tilde_2 = double(5)/double(16)*(double(1) + ratio_upwind_tilde_pow_2[i]);
+            
+            const double omega_upwind_tilde_sum_inv =
+                double(1)/(omega_upwind_tilde_0 + omega_upwind_tilde_1 + omega_upwind_tilde_2);
+            
+            omega_upwind_tilde_0 *= omega_upwind_tilde_sum_inv;
+            omega_upwind_tilde_1 *= omega_upwind_tilde_sum_inv;
+            omega_upwind_tilde_2 *= omega_upwind_tilde_sum_inv;
+            
+            double omega_tilde_0 = double(1)/double(32)*(C + ratio_central_tilde_pow_0[i]);
+            double omega_tilde_1 = double(15)/double(32)*(C + ratio_central_tilde_pow_1[i]);
+            double omega_tilde_2 = double(15)/double(32)*(C + ratio_central_tilde_pow_2[i]);
+            double omega_tilde_3 = double(1)/double(32)*(C + ratio_central_tilde_pow_3[i]);
+            
+            const double omega_tilde_sum_inv =
+                double(1)/(omega_tilde_0 + omega_tilde_1 + omega_tilde_2 + omega_tilde_3);
+            
+            const double sigma = sigma_blend[i];
+            const double one_minus_sigma = double(1) - sigma;
+            
+            omega_tilde_0 = sigma*omega_upwind_tilde_0 + one_minus_sigma*omega_tilde_sum_inv*omega_tilde_0;
+            omega_tilde_1 = sigma*omega_upwind_tilde_1 + one_minus_sigma*omega_tilde_sum_inv*omega_tilde_1;
+            omega_tilde_2 = sigma*omega_upwind_tilde_2 + one_minus_sigma*omega_tilde_sum_inv*omega_tilde_2;
+            omega_tilde_3 = one_minus_sigma*omega_tilde_sum_inv*omega_tilde_3;
+            
+            U_p[idx] =
+                omega_tilde_0*(double(3)/double(8)*U_5[idx] - double(10)/double(8)*U_4[idx] +
+                    double(15)/double(8)*U_3[idx]) +
+                omega_tilde_1*(-double(1)/double(8)*U_4[idx] + double(6)/double(8)*U_3[idx] +
+                    double(3)/double(8)*U_2[idx]) +
+                omega_tilde_2*(double(3)/double(8)*U_3[idx] + double(6)/double(8)*U_2[idx] -
+                    double(1)/double(8)*U_1[idx]) +
+                omega_tilde_3*(double(15)/double(8)*U_2[idx] - double(10)/double(8)*U_1[idx] +
+                    double(3)/double(8)*U_0[idx]);
+        }
     }
-    
-    /*
-     * Compute U_plus.
-     */
-    
-    U_plus[idx_side] = double(3)/double(8)*omega_tilde_0*U_array[5][idx_side] +
-        (-double(10)/double(8)*omega_tilde_0 - double(1)/double(8)*omega_tilde_1)*U_array[4][idx_side] +
-        (double(15)/double(8)*omega_tilde_0 + double(6)/double(8)*omega_tilde_1 + double(3)/double(8)*omega_tilde_2)*
-            U_array[3][idx_side] +
-        (double(3)/double(8)*omega_tilde_1 + double(6)/double(8)*omega_tilde_2 + double(15)/double(8)*omega_tilde_3)*
-            U_array[2][idx_side] +
-        (-double(1)/double(8)*omega_tilde_2 - double(10)/double(8)*omega_tilde_3)*U_array[1][idx_side] +
-        double(3)/double(8)*omega_tilde_3*U_array[0][idx_side];
 }
 
 
@@ -390,6 +545,8 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::printClassData(
     os << "d_constant_alpha_tau = "
        << d_constant_alpha_tau
        << std::endl;
+    
+    printCommonClassData(os);
 }
 
 
@@ -405,6 +562,8 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::putToRestart(
     restart_db->putInteger("d_constant_q", d_constant_q);
     restart_db->putDouble("d_constant_C", d_constant_C);
     restart_db->putDouble("d_constant_alpha_tau", d_constant_alpha_tau);
+    
+    putCommonDataToRestart(restart_db);
 }
 
 
@@ -429,7 +588,7 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
      */
     
     const hier::IntVector interior_dims = variables_minus[0]->getBox().numberCells();
-    
+
 #ifdef HAMERS_DEBUG_CHECK_DEV_ASSERTIONS
     for (int ei = 0; ei < d_num_eqn; ei++)
     {
@@ -478,23 +637,18 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             
             double* U_L = variables_minus[ei]->getPointer(0);
             
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = -1; i < interior_dim_0 + 2; i++)
-            {
-                // Compute the linear index of the mid-point.
-                const int idx_midpoint_x = i + 1;
-                
-                performLocalWENOInterpolationMinus(
-                    U_L,
-                    U_array.data(),
-                    idx_midpoint_x,
-                    d_constant_p,
-                    d_constant_q,
-                    d_constant_C,
-                    d_constant_alpha_tau);
-            }
+            // Compute the linear index of the first mid-point.
+            const int idx_midpoint_x = 0;
+            
+            performWENOInterpolationMinusOnRow(
+                U_L,
+                U_array.data(),
+                idx_midpoint_x,
+                interior_dim_0 + 3,
+                d_constant_p,
+                d_constant_q,
+                d_constant_C,
+                d_constant_alpha_tau);
         }
         
         for (int ei = 0; ei < d_num_eqn; ei++)
@@ -509,25 +663,20 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             
             double* U_R = variables_plus[ei]->getPointer(0);
             
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = -1; i < interior_dim_0 + 2; i++)
-            {
-                // Compute the linear index of the mid-point.
-                const int idx_midpoint_x = i + 1;
-                
-                performLocalWENOInterpolationPlus(
-                    U_R,
-                    U_array.data(),
-                    idx_midpoint_x,
-                    d_constant_p,
-                    d_constant_q,
-                    d_constant_C,
-                    d_constant_alpha_tau);
-            }
+            // Compute the linear index of the first mid-point.
+            const int idx_midpoint_x = 0;
+            
+            performWENOInterpolationPlusOnRow(
+                U_R,
+                U_array.data(),
+                idx_midpoint_x,
+                interior_dim_0 + 3,
+                d_constant_p,
+                d_constant_q,
+                d_constant_C,
+                d_constant_alpha_tau);
         }
-        
+    
     } // if (d_dim == tbox::Dimension(1))
     else if (d_dim == tbox::Dimension(2))
     {
@@ -556,24 +705,18 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             
             for (int j = 0; j < interior_dim_1; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = -1; i < interior_dim_0 + 2; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_x = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 3);
-                    
-                    performLocalWENOInterpolationMinus(
-                        U_L,
-                        U_array.data(),
-                        idx_midpoint_x,
-                        d_constant_p,
-                        d_constant_q,
-                        d_constant_C,
-                        d_constant_alpha_tau);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3);
+                
+                performWENOInterpolationMinusOnRow(
+                    U_L,
+                    U_array.data(),
+                    idx_midpoint_x,
+                    interior_dim_0 + 3,
+                    d_constant_p,
+                    d_constant_q,
+                    d_constant_C,
+                    d_constant_alpha_tau);
             }
         }
         
@@ -591,24 +734,18 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             
             for (int j = 0; j < interior_dim_1; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = -1; i < interior_dim_0 + 2; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_x = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 3);
-                    
-                    performLocalWENOInterpolationPlus(
-                        U_R,
-                        U_array.data(),
-                        idx_midpoint_x,
-                        d_constant_p,
-                        d_constant_q,
-                        d_constant_C,
-                        d_constant_alpha_tau);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3);
+                
+                performWENOInterpolationPlusOnRow(
+                    U_R,
+                    U_array.data(),
+                    idx_midpoint_x,
+                    interior_dim_0 + 3,
+                    d_constant_p,
+                    d_constant_q,
+                    d_constant_C,
+                    d_constant_alpha_tau);
             }
         }
         
@@ -630,24 +767,19 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             
             for (int j = -1; j < interior_dim_1 + 2; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_y = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2);
-                    
-                    performLocalWENOInterpolationMinus(
-                        U_B,
-                        U_array.data(),
-                        idx_midpoint_y,
-                        d_constant_p,
-                        d_constant_q,
-                        d_constant_C,
-                        d_constant_alpha_tau);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_y = 1 +
+                    (j + 1)*(interior_dim_0 + 2);
+                
+                performWENOInterpolationMinusOnRow(
+                    U_B,
+                    U_array.data(),
+                    idx_midpoint_y,
+                    interior_dim_0,
+                    d_constant_p,
+                    d_constant_q,
+                    d_constant_C,
+                    d_constant_alpha_tau);
             }
         }
         
@@ -665,27 +797,22 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             
             for (int j = -1; j < interior_dim_1 + 2; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index of the mid-point.
-                    const int idx_midpoint_y = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2);
-                    
-                    performLocalWENOInterpolationPlus(
-                        U_T,
-                        U_array.data(),
-                        idx_midpoint_y,
-                        d_constant_p,
-                        d_constant_q,
-                        d_constant_C,
-                        d_constant_alpha_tau);
-                }
+                // Compute the linear index of the first mid-point.
+                const int idx_midpoint_y = 1 +
+                    (j + 1)*(interior_dim_0 + 2);
+                
+                performWENOInterpolationPlusOnRow(
+                    U_T,
+                    U_array.data(),
+                    idx_midpoint_y,
+                    interior_dim_0,
+                    d_constant_p,
+                    d_constant_q,
+                    d_constant_C,
+                    d_constant_alpha_tau);
             }
         }
-        
+    
     } // if (d_dim == tbox::Dimension(2))
     else if (d_dim == tbox::Dimension(3))
     {
@@ -717,26 +844,20 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = -1; i < interior_dim_0 + 2; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_x = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 3) +
-                            (k + 1)*(interior_dim_0 + 3)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationMinus(
-                            U_L,
-                            U_array.data(),
-                            idx_midpoint_x,
-                            d_constant_p,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_alpha_tau);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3) +
+                        (k + 1)*(interior_dim_0 + 3)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationMinusOnRow(
+                        U_L,
+                        U_array.data(),
+                        idx_midpoint_x,
+                        interior_dim_0 + 3,
+                        d_constant_p,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_alpha_tau);
                 }
             }
         }
@@ -757,26 +878,20 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = -1; i < interior_dim_0 + 2; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_x = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 3) +
-                            (k + 1)*(interior_dim_0 + 3)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationPlus(
-                            U_R,
-                            U_array.data(),
-                            idx_midpoint_x,
-                            d_constant_p,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_alpha_tau);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_x = (j + 1)*(interior_dim_0 + 3) +
+                        (k + 1)*(interior_dim_0 + 3)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationPlusOnRow(
+                        U_R,
+                        U_array.data(),
+                        idx_midpoint_x,
+                        interior_dim_0 + 3,
+                        d_constant_p,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_alpha_tau);
                 }
             }
         }
@@ -801,26 +916,21 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = -1; j < interior_dim_1 + 2; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_y = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 3);
-                        
-                        performLocalWENOInterpolationMinus(
-                            U_B,
-                            U_array.data(),
-                            idx_midpoint_y,
-                            d_constant_p,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_alpha_tau);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_y = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 3);
+                    
+                    performWENOInterpolationMinusOnRow(
+                        U_B,
+                        U_array.data(),
+                        idx_midpoint_y,
+                        interior_dim_0,
+                        d_constant_p,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_alpha_tau);
                 }
             }
         }
@@ -841,26 +951,21 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = -1; j < interior_dim_1 + 2; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_y = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 3);
-                        
-                        performLocalWENOInterpolationPlus(
-                            U_T,
-                            U_array.data(),
-                            idx_midpoint_y,
-                            d_constant_p,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_alpha_tau);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_y = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 3);
+                    
+                    performWENOInterpolationPlusOnRow(
+                        U_T,
+                        U_array.data(),
+                        idx_midpoint_y,
+                        interior_dim_0,
+                        d_constant_p,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_alpha_tau);
                 }
             }
         }
@@ -885,26 +990,21 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_z = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationMinus(
-                            U_B,
-                            U_array.data(),
-                            idx_midpoint_z,
-                            d_constant_p,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_alpha_tau);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_z = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationMinusOnRow(
+                        U_B,
+                        U_array.data(),
+                        idx_midpoint_z,
+                        interior_dim_0,
+                        d_constant_p,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_alpha_tau);
                 }
             }
         }
@@ -925,29 +1025,24 @@ ConvectiveFluxReconstructorWCNS6_LD_HLLC_HLL::performWENOInterpolation(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index of the mid-point.
-                        const int idx_midpoint_z = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 2);
-                        
-                        performLocalWENOInterpolationPlus(
-                            U_F,
-                            U_array.data(),
-                            idx_midpoint_z,
-                            d_constant_p,
-                            d_constant_q,
-                            d_constant_C,
-                            d_constant_alpha_tau);
-                    }
+                    // Compute the linear index of the first mid-point.
+                    const int idx_midpoint_z = 1 +
+                        (j + 1)*(interior_dim_0 + 2) +
+                        (k + 1)*(interior_dim_0 + 2)*
+                            (interior_dim_1 + 2);
+                    
+                    performWENOInterpolationPlusOnRow(
+                        U_F,
+                        U_array.data(),
+                        idx_midpoint_z,
+                        interior_dim_0,
+                        d_constant_p,
+                        d_constant_q,
+                        d_constant_C,
+                        d_constant_alpha_tau);
                 }
             }
         }
-        
+    
     } // if (d_dim == tbox::Dimension(3))
 }
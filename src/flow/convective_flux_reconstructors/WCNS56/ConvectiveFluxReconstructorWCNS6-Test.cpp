@@ -624,15 +624,9 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
         std::vector<hier::IntVector> num_subghosts_conservative_var;
         num_subghosts_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> num_subghosts_primitive_var;
-        num_subghosts_primitive_var.reserve(d_num_eqn);
-        
         std::vector<double*> Q;
         Q.reserve(d_num_eqn);
         
-        std::vector<double*> V;
-        V.reserve(d_num_eqn);
-        
         int count_eqn = 0;
         
         for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
@@ -653,26 +647,6 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
             }
         }
         
-        count_eqn = 0;
-        
-        for (int vi = 0; vi < static_cast<int>(primitive_variables.size()); vi++)
-        {
-            int depth = primitive_variables[vi]->getDepth();
-            
-            for (int di = 0; di < depth; di++)
-            {
-                // If the last element of the primitive variable vector is not in the system of equations,
-                // ignore it.
-                if (count_eqn >= d_num_eqn)
-                    break;
-                
-                V.push_back(primitive_variables[vi]->getPointer(di));
-                num_subghosts_primitive_var.push_back(primitive_variables[vi]->getGhostCellWidth());
-                
-                count_eqn++;
-            }
-        }
-        
         /*
          * Declare temporary data containers for WENO interpolation.
          */
@@ -687,9 +661,6 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_minus;
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_plus;
         
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_minus;
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_plus;
-        
         /*
          * Initialize temporary data containers for WENO interpolation.
          */
@@ -735,12 +706,6 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
                 interior_box, 1, hier::IntVector::getOne(d_dim)));
         }
         
-        bounded_flag_minus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
-        bounded_flag_plus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
         /*
          * Compute global side data of the projection variables for transformation between
          * primitive variables and characteristic variables.
@@ -802,64 +767,14 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
         t_characteristic_decomposition->stop();
         
         /*
-         * Declare containers to store pointers for computing mid-point fluxes.
+         * Limit the interpolated side primitive variables with the positivity-preserving scaling
+         * limiter so that they are within the bounds.
          */
         
-        std::vector<double*> V_minus;
-        std::vector<double*> V_plus;
-        V_minus.resize(d_num_eqn);
-        V_plus.resize(d_num_eqn);
-        
-        int* flag_minus = nullptr;
-        int* flag_plus = nullptr;
-        
-        /*
-         * Check whether the interpolated side primitive variables are within the bounds.
-         */
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_minus,
-            primitive_variables_minus);
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_plus,
-            primitive_variables_plus);
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in x-direction
-         * are out of bounds.
-         */
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(0);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(0);
-        }
-        
-        flag_minus = bounded_flag_minus->getPointer(0);
-        flag_plus = bounded_flag_plus->getPointer(0);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = -1; i < interior_dim_0 + 2; i++)
-            {
-                // Compute the linear indices.
-                const int idx_midpoint_x = i + 1;
-                const int idx_cell_L = i - 1 + num_subghosts_0_primitive_var;
-                const int idx_cell_R = i + num_subghosts_0_primitive_var;
-                
-                if (flag_minus[idx_midpoint_x] == 0 || flag_plus[idx_midpoint_x] == 0)
-                {
-                    V_minus[ei][idx_midpoint_x] = V[ei][idx_cell_L];
-                    V_plus[ei][idx_midpoint_x] = V[ei][idx_cell_R];
-                }
-            }
-        }
+        d_flow_model->limitGlobalSideDataPrimitiveVariables(
+            primitive_variables_minus,
+            primitive_variables_plus,
+            primitive_variables);
         
         /*
          * Compute mid-point flux in the x-direction.
@@ -1186,21 +1101,12 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
         std::vector<hier::IntVector> num_subghosts_conservative_var;
         num_subghosts_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> num_subghosts_primitive_var;
-        num_subghosts_primitive_var.reserve(d_num_eqn);
-        
         std::vector<hier::IntVector> subghostcell_dims_conservative_var;
         subghostcell_dims_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> subghostcell_dims_primitive_var;
-        subghostcell_dims_primitive_var.reserve(d_num_eqn);
-        
         std::vector<double*> Q;
         Q.reserve(d_num_eqn);
         
-        std::vector<double*> V;
-        V.reserve(d_num_eqn);
-        
         int count_eqn = 0;
         
         for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
@@ -1223,28 +1129,6 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
             }
         }
         
-        count_eqn = 0;
-        
-        for (int vi = 0; vi < static_cast<int>(primitive_variables.size()); vi++)
-        {
-            int depth = primitive_variables[vi]->getDepth();
-            
-            for (int di = 0; di < depth; di++)
-            {
-                // If the last element of the primitive variable vector is not in the system of equations,
-                // ignore it.
-                if (count_eqn >= d_num_eqn)
-                    break;
-                
-                V.push_back(primitive_variables[vi]->getPointer(di));
-                num_subghosts_primitive_var.push_back(primitive_variables[vi]->getGhostCellWidth());
-                subghostcell_dims_primitive_var.push_back(
-                    primitive_variables[vi]->getGhostBox().numberCells());
-                
-                count_eqn++;
-            }
-        }
-        
         /*
          * Declare temporary data containers for WENO interpolation.
          */
@@ -1259,9 +1143,6 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_minus;
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_plus;
         
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_minus;
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_plus;
-        
         /*
          * Initialize temporary data containers for WENO interpolation.
          */
@@ -1307,12 +1188,6 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
                 interior_box, 1, hier::IntVector::getOne(d_dim)));
         }
         
-        bounded_flag_minus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
-        bounded_flag_plus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
         /*
          * Compute global side data of the projection variables for transformation between
          * primitive variables and characteristic variables.
@@ -1374,120 +1249,14 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
         t_characteristic_decomposition->stop();
         
         /*
-         * Declare containers to store pointers for computing mid-point fluxes.
-         */
-        
-        std::vector<double*> V_minus;
-        std::vector<double*> V_plus;
-        V_minus.resize(d_num_eqn);
-        V_plus.resize(d_num_eqn);
-        
-        int* flag_minus = nullptr;
-        int* flag_plus = nullptr;
-        
-        /*
-         * Check whether the interpolated side primitive variables are within the bounds.
-         */
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_minus,
-            primitive_variables_minus);
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_plus,
-            primitive_variables_plus);
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in x-direction
-         * are out of bounds.
-         */
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(0);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(0);
-        }
-        
-        flag_minus = bounded_flag_minus->getPointer(0);
-        flag_plus = bounded_flag_plus->getPointer(0);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
-            
-            for (int j = 0; j < interior_dim_1; j++)
-            {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = -1; i < interior_dim_0 + 2; i++)
-                {
-                    // Compute the linear indices.
-                    const int idx_midpoint_x = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 3);
-                    
-                    const int idx_cell_L = (i - 1 + num_subghosts_0_primitive_var) +
-                        (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var;
-                    
-                    const int idx_cell_R = (i + num_subghosts_0_primitive_var) +
-                        (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var;
-                    
-                    if (flag_minus[idx_midpoint_x] == 0 || flag_plus[idx_midpoint_x] == 0)
-                    {
-                        V_minus[ei][idx_midpoint_x] = V[ei][idx_cell_L];
-                        V_plus[ei][idx_midpoint_x] = V[ei][idx_cell_R];
-                    }
-                }
-            }
-        }
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in y-direction
-         * are out of bounds.
+         * Limit the interpolated side primitive variables with the positivity-preserving scaling
+         * limiter so that they are within the bounds.
          */
         
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(1);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(1);
-        }
-        
-        flag_minus = bounded_flag_minus->getPointer(1);
-        flag_plus = bounded_flag_plus->getPointer(1);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
-            
-            for (int j = -1; j < interior_dim_1 + 2; j++)
-            {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear indices.
-                    const int idx_midpoint_y = (i + 1) +
-                        (j + 1)*(interior_dim_0 + 2);
-                    
-                    const int idx_cell_B = (i + num_subghosts_0_primitive_var) +
-                        (j - 1 + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var;
-                    
-                    const int idx_cell_T = (i + num_subghosts_0_primitive_var) +
-                        (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var;
-                    
-                    if (flag_minus[idx_midpoint_y] == 0 || flag_plus[idx_midpoint_y] == 0)
-                    {
-                        V_minus[ei][idx_midpoint_y] = V[ei][idx_cell_B];
-                        V_plus[ei][idx_midpoint_y] = V[ei][idx_cell_T];
-                    }
-                }
-            }
-        }
+        d_flow_model->limitGlobalSideDataPrimitiveVariables(
+            primitive_variables_minus,
+            primitive_variables_plus,
+            primitive_variables);
         
         /*
          * Compute mid-point flux in the x-direction.
@@ -2149,21 +1918,12 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
         std::vector<hier::IntVector> num_subghosts_conservative_var;
         num_subghosts_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> num_subghosts_primitive_var;
-        num_subghosts_primitive_var.reserve(d_num_eqn);
-        
         std::vector<hier::IntVector> subghostcell_dims_conservative_var;
         subghostcell_dims_conservative_var.reserve(d_num_eqn);
         
-        std::vector<hier::IntVector> subghostcell_dims_primitive_var;
-        subghostcell_dims_primitive_var.reserve(d_num_eqn);
-        
         std::vector<double*> Q;
         Q.reserve(d_num_eqn);
         
-        std::vector<double*> V;
-        V.reserve(d_num_eqn);
-        
         int count_eqn = 0;
         
         for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
@@ -2186,28 +1946,6 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
             }
         }
         
-        count_eqn = 0;
-        
-        for (int vi = 0; vi < static_cast<int>(primitive_variables.size()); vi++)
-        {
-            int depth = primitive_variables[vi]->getDepth();
-            
-            for (int di = 0; di < depth; di++)
-            {
-                // If the last element of the primitive variable vector is not in the system of equations,
-                // ignore it.
-                if (count_eqn >= d_num_eqn)
-                    break;
-                
-                V.push_back(primitive_variables[vi]->getPointer(di));
-                num_subghosts_primitive_var.push_back(primitive_variables[vi]->getGhostCellWidth());
-                subghostcell_dims_primitive_var.push_back(
-                    primitive_variables[vi]->getGhostBox().numberCells());
-                
-                count_eqn++;
-            }
-        }
-        
         /*
          * Declare temporary data containers for WENO interpolation.
          */
@@ -2222,9 +1960,6 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_minus;
         std::vector<boost::shared_ptr<pdat::SideData<double> > > primitive_variables_plus;
         
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_minus;
-        boost::shared_ptr<pdat::SideData<int> > bounded_flag_plus;
-        
         /*
          * Initialize temporary data containers for WENO interpolation.
          */
@@ -2270,12 +2005,6 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
                 interior_box, 1, hier::IntVector::getOne(d_dim)));
         }
         
-        bounded_flag_minus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
-        bounded_flag_plus.reset(
-            new pdat::SideData<int>(interior_box, 1, hier::IntVector::getOne(d_dim)));
-        
         /*
          * Compute global side data of the projection variables for transformation between
          * primitive variables and characteristic variables.
@@ -2337,199 +2066,14 @@ ConvectiveFluxReconstructorWCNS6_Test::computeConvectiveFluxAndSourceOnPatch(
         t_characteristic_decomposition->stop();
         
         /*
-         * Declare containers to store pointers for computing mid-point fluxes.
-         */
-        
-        std::vector<double*> V_minus;
-        std::vector<double*> V_plus;
-        V_minus.resize(d_num_eqn);
-        V_plus.resize(d_num_eqn);
-        
-        int* flag_minus = nullptr;
-        int* flag_plus = nullptr;
-        
-        /*
-         * Check whether the interpolated side primitive variables are within the bounds.
-         */
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_minus,
-            primitive_variables_minus);
-        
-        d_flow_model->checkGlobalSideDataPrimitiveVariablesBounded(
-            bounded_flag_plus,
-            primitive_variables_plus);
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in x-direction
-         * are out of bounds.
-         */
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(0);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(0);
-        }
-        
-        flag_minus = bounded_flag_minus->getPointer(0);
-        flag_plus = bounded_flag_plus->getPointer(0);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int num_subghosts_2_primitive_var = num_subghosts_primitive_var[ei][2];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
-            const int subghostcell_dim_1_primitive_var = subghostcell_dims_primitive_var[ei][1];
-            
-            for (int k = 0; k < interior_dim_2; k++)
-            {
-                for (int j = 0; j < interior_dim_1; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = -1; i < interior_dim_0 + 2; i++)
-                    {
-                        // Compute the linear indices.
-                        const int idx_midpoint_x = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 3) +
-                            (k + 1)*(interior_dim_0 + 3)*
-                                (interior_dim_1 + 2);
-                        
-                        const int idx_cell_L = (i - 1 + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
-                        
-                        const int idx_cell_R = (i + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
-                        
-                        if (flag_minus[idx_midpoint_x] == 0 || flag_plus[idx_midpoint_x] == 0)
-                        {
-                            V_minus[ei][idx_midpoint_x] = V[ei][idx_cell_L];
-                            V_plus[ei][idx_midpoint_x] = V[ei][idx_cell_R];
-                        }
-                    }
-                }
-            }
-        }
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in y-direction
-         * are out of bounds.
+         * Limit the interpolated side primitive variables with the positivity-preserving scaling
+         * limiter so that they are within the bounds.
          */
         
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(1);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(1);
-        }
-        
-        flag_minus = bounded_flag_minus->getPointer(1);
-        flag_plus = bounded_flag_plus->getPointer(1);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int num_subghosts_2_primitive_var = num_subghosts_primitive_var[ei][2];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
-            const int subghostcell_dim_1_primitive_var = subghostcell_dims_primitive_var[ei][1];
-            
-            for (int k = 0; k < interior_dim_2; k++)
-            {
-                for (int j = -1; j < interior_dim_1 + 2; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear indices.
-                        const int idx_midpoint_y = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 3);
-                        
-                        const int idx_cell_B = (i + num_subghosts_0_primitive_var) +
-                            (j - 1 + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
-                        
-                        const int idx_cell_T = (i + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
-                        
-                        if (flag_minus[idx_midpoint_y] == 0 || flag_plus[idx_midpoint_y] == 0)
-                        {
-                            V_minus[ei][idx_midpoint_y] = V[ei][idx_cell_B];
-                            V_plus[ei][idx_midpoint_y] = V[ei][idx_cell_T];
-                        }
-                    }
-                }
-            }
-        }
-        
-        /*
-         * Use first order interpolation if interpolated side primitive variables in z-direction
-         * are out of bounds.
-         */
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            V_minus[ei] = primitive_variables_minus[ei]->getPointer(2);
-            V_plus[ei] = primitive_variables_plus[ei]->getPointer(2);
-        }
-        
-        flag_minus = bounded_flag_minus->getPointer(2);
-        flag_plus = bounded_flag_plus->getPointer(2);
-        
-        for (int ei = 0; ei < d_num_eqn; ei++)
-        {
-            const int num_subghosts_0_primitive_var = num_subghosts_primitive_var[ei][0];
-            const int num_subghosts_1_primitive_var = num_subghosts_primitive_var[ei][1];
-            const int num_subghosts_2_primitive_var = num_subghosts_primitive_var[ei][2];
-            const int subghostcell_dim_0_primitive_var = subghostcell_dims_primitive_var[ei][0];
-            const int subghostcell_dim_1_primitive_var = subghostcell_dims_primitive_var[ei][1];
-            
-            for (int k = -1; k < interior_dim_2 + 2; k++)
-            {
-                for (int j = 0; j < interior_dim_1; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear indices.
-                        const int idx_midpoint_z = (i + 1) +
-                            (j + 1)*(interior_dim_0 + 2) +
-                            (k + 1)*(interior_dim_0 + 2)*
-                                (interior_dim_1 + 2);
-                        
-                        const int idx_cell_B = (i + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k - 1 + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
-                        
-                        const int idx_cell_F = (i + num_subghosts_0_primitive_var) +
-                            (j + num_subghosts_1_primitive_var)*subghostcell_dim_0_primitive_var +
-                            (k + num_subghosts_2_primitive_var)*subghostcell_dim_0_primitive_var*
-                                subghostcell_dim_1_primitive_var;
-                        
-                        if (flag_minus[idx_midpoint_z] == 0 || flag_plus[idx_midpoint_z] == 0)
-                        {
-                            V_minus[ei][idx_midpoint_z] = V[ei][idx_cell_B];
-                            V_plus[ei][idx_midpoint_z] = V[ei][idx_cell_F];
-                        }
-                    }
-                }
-            }
-        }
+        d_flow_model->limitGlobalSideDataPrimitiveVariables(
+            primitive_variables_minus,
+            primitive_variables_plus,
+            primitive_variables);
         
         /*
          * Compute mid-point flux in the x-direction.
@@ -1,5 +1,43 @@
 #include "flow/flow_models/FlowModel.hpp"
 
+#include "SAMRAI/hier/VariableDatabase.h"
+
+#include <algorithm>
+
+#define EPSILON HAMERS_EPSILON
+
+/*
+ * Fraction of the distance between the cell value and the bounds that the side values limited by
+ * the positivity-preserving limiter are kept away from the bounds.
+ */
+#define LIMITER_BOUND_FRACTION 1.0e-6
+
+
+/*
+ * Compute the scaling factor in [0, 1] of the deviation of a side value from the cell value so
+ * that the limited side value is within the bounds. The bounds are moved towards the cell value by
+ * a small fraction of their distances to the cell value so that the limited side value is strictly
+ * within the bounds if the cell value is. The factor is zero if the cell value is out of bounds.
+ */
+static inline __attribute__((always_inline)) double computeLimiterScalingFactor(
+    const double V_cell,
+    const double V_side,
+    const double bound_lo,
+    const double bound_up)
+{
+    const double V_bound_lo = bound_lo + LIMITER_BOUND_FRACTION*(V_cell - bound_lo);
+    const double V_bound_up = bound_up - LIMITER_BOUND_FRACTION*(bound_up - V_cell);
+    
+    const double theta_lo = (V_side < V_bound_lo) ?
+        std::max(V_cell - V_bound_lo, double(0))/std::max(V_cell - V_side, EPSILON) : double(1);
+    
+    const double theta_up = (V_side > V_bound_up) ?
+        std::max(V_bound_up - V_cell, double(0))/std::max(V_side - V_cell, EPSILON) : double(1);
+    
+    return std::min(theta_lo, theta_up);
+}
+
+
 /*
  * Register the required variables for the computation of diffusive flux in the
  * registered patch.
@@ -60,6 +98,571 @@ FlowModel::getDiffusiveFluxDiffusivities(
 }
 
 
+/*
+ * Check that all the conservative variables are registered with the same numbers of ghost cells in
+ * the given data context.
+ */
+void
+FlowModel::checkGhostCellWidthsOfConservativeVariables(
+    const boost::shared_ptr<hier::VariableContext>& data_context)
+{
+    hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
+    
+    std::vector<boost::shared_ptr<pdat::CellVariable<double> > > conservative_variables =
+        getConservativeVariables();
+    
+    TBOX_ASSERT(!conservative_variables.empty());
+    
+    std::vector<hier::IntVector> num_ghosts;
+    num_ghosts.reserve(conservative_variables.size());
+    
+    for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
+    {
+        const int data_id = variable_db->mapVariableAndContextToIndex(
+            conservative_variables[vi],
+            data_context);
+        
+        TBOX_ASSERT(data_id >= 0);
+        
+        num_ghosts.push_back(
+            variable_db->getPatchDescriptor()->getPatchDataFactory(data_id)->getGhostCellWidth());
+        
+        if (num_ghosts[vi] != num_ghosts[0])
+        {
+            TBOX_ERROR(d_object_name
+                << ": FlowModel::checkGhostCellWidthsOfConservativeVariables()\n"
+                << "The conservative variables are registered with different numbers of ghost"
+                << " cells in the context '"
+                << data_context->getName()
+                << "'."
+                << std::endl);
+        }
+    }
+}
+
+
+/*
+ * Get the pointers to the components of the global cell data of the conservative variables in the
+ * registered patch, one pointer for each equation. The numbers of ghost cells of the conservative
+ * variables are checked to be the same when the variables are registered.
+ */
+void
+FlowModel::getGlobalCellDataPointersConservativeVariables(
+    std::vector<double*>& conservative_variables_pointers,
+    hier::IntVector& num_ghosts,
+    hier::IntVector& ghostcell_dims)
+{
+    std::vector<boost::shared_ptr<pdat::CellData<double> > > conservative_variables =
+        getGlobalCellDataConservativeVariables();
+    
+    TBOX_ASSERT(!conservative_variables.empty());
+    
+    num_ghosts = conservative_variables[0]->getGhostCellWidth();
+    ghostcell_dims = conservative_variables[0]->getGhostBox().numberCells();
+    
+    conservative_variables_pointers.clear();
+    conservative_variables_pointers.reserve(d_num_eqn);
+    
+    for (int vi = 0; vi < static_cast<int>(conservative_variables.size()); vi++)
+    {
+        TBOX_ASSERT(conservative_variables[vi]->getGhostCellWidth() == num_ghosts);
+        
+        const int depth = conservative_variables[vi]->getDepth();
+        
+        for (int di = 0; di < depth; di++)
+        {
+            // If the last element of the conservative variable vector is not in the system of
+            // equations, ignore it.
+            if (static_cast<int>(conservative_variables_pointers.size()) >= d_num_eqn)
+                break;
+            
+            conservative_variables_pointers.push_back(conservative_variables[vi]->getPointer(di));
+        }
+    }
+}
+
+
+/*
+ * Limit the side primitive variables interpolated from the cells on the left (minus) and on the
+ * right (plus) of the sides with the Zhang-Shu scaling limiter.
+ */
+void
+FlowModel::limitGlobalSideDataPrimitiveVariables(
+    std::vector<boost::shared_ptr<pdat::SideData<double> > >& primitive_variables_minus,
+    std::vector<boost::shared_ptr<pdat::SideData<double> > >& primitive_variables_plus,
+    const std::vector<boost::shared_ptr<pdat::CellData<double> > >& primitive_variables)
+{
+    if (static_cast<int>(primitive_variables_minus.size()) != d_num_eqn ||
+        static_cast<int>(primitive_variables_plus.size()) != d_num_eqn)
+    {
+        TBOX_ERROR(d_object_name
+            << ": FlowModel::limitGlobalSideDataPrimitiveVariables()\n"
+            << "The number of side primitive variables are incorrect."
+            << std::endl);
+    }
+    
+    /*
+     * Get the bounded primitive variables.
+     */
+    
+    std::vector<int> bounded_var_idx;
+    std::vector<double> bounds_lo;
+    std::vector<double> bounds_up;
+    
+    getBoundsOfPrimitiveVariables(bounded_var_idx, bounds_lo, bounds_up);
+    
+    const int num_bounded_var = static_cast<int>(bounded_var_idx.size());
+    
+    if (num_bounded_var == 0)
+    {
+        return;
+    }
+    
+    /*
+     * Get the pointers to the components of the cell primitive variables. All the components must
+     * have the same numbers of ghost cells so that the same linear index can be used for every
+     * equation.
+     */
+    
+    TBOX_ASSERT(!primitive_variables.empty());
+    
+    const hier::IntVector num_ghosts_cell = primitive_variables[0]->getGhostCellWidth();
+    const hier::IntVector ghostcell_dims_cell = primitive_variables[0]->getGhostBox().numberCells();
+    
+    std::vector<const double*> V;
+    V.reserve(d_num_eqn);
+    
+    for (int vi = 0; vi < static_cast<int>(primitive_variables.size()); vi++)
+    {
+        if (primitive_variables[vi]->getGhostCellWidth() != num_ghosts_cell)
+        {
+            TBOX_ERROR(d_object_name
+                << ": FlowModel::limitGlobalSideDataPrimitiveVariables()\n"
+                << "The cell primitive variables have different numbers of ghost cells."
+                << std::endl);
+        }
+        
+        const int depth = primitive_variables[vi]->getDepth();
+        
+        for (int di = 0; di < depth; di++)
+        {
+            // If the last element of the primitive variable vector is not in the system of
+            // equations, ignore it.
+            if (static_cast<int>(V.size()) >= d_num_eqn)
+                break;
+            
+            V.push_back(primitive_variables[vi]->getPointer(di));
+        }
+    }
+    
+    /*
+     * Get the numbers of ghost cells and the dimensions of the ghost cell box of the side
+     * primitive variables. The sides of the first ghost cells in the direction normal to the sides
+     * are limited.
+     */
+    
+    const hier::IntVector interior_dims = primitive_variables[0]->getBox().numberCells();
+    
+    const hier::IntVector num_ghosts_side = primitive_variables_minus[0]->getGhostCellWidth();
+    const hier::IntVector ghostcell_dims_side = primitive_variables_minus[0]->getGhostBox().numberCells();
+    
+    for (int ei = 0; ei < d_num_eqn; ei++)
+    {
+        if (primitive_variables_minus[ei]->getGhostCellWidth() != num_ghosts_side ||
+            primitive_variables_plus[ei]->getGhostCellWidth() != num_ghosts_side)
+        {
+            TBOX_ERROR(d_object_name
+                << ": FlowModel::limitGlobalSideDataPrimitiveVariables()\n"
+                << "The side primitive variables have different numbers of ghost cells."
+                << std::endl);
+        }
+    }
+    
+    TBOX_ASSERT(num_ghosts_side >= hier::IntVector::getOne(d_dim));
+    TBOX_ASSERT(num_ghosts_cell >= num_ghosts_side + hier::IntVector::getOne(d_dim));
+    
+    std::vector<double*> V_minus;
+    std::vector<double*> V_plus;
+    V_minus.resize(d_num_eqn);
+    V_plus.resize(d_num_eqn);
+    
+    const int* const var_idx = bounded_var_idx.data();
+    const double* const V_lo = bounds_lo.data();
+    const double* const V_up = bounds_up.data();
+    
+    if (d_dim == tbox::Dimension(1))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        
+        const int num_ghosts_0_cell = num_ghosts_cell[0];
+        
+        const int num_ghosts_0_side = num_ghosts_side[0];
+        
+        /*
+         * Limit the side primitive variables in the x-direction.
+         */
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            V_minus[ei] = primitive_variables_minus[ei]->getPointer(0);
+            V_plus[ei] = primitive_variables_plus[ei]->getPointer(0);
+        }
+
+#ifdef HAMERS_ENABLE_SIMD
+        #pragma omp simd
+#endif
+        for (int i = -1; i < interior_dim_0 + 2; i++)
+        {
+            // Compute the linear indices.
+            const int idx_face = i + num_ghosts_0_side;
+            const int idx_cell_L = i - 1 + num_ghosts_0_cell;
+            const int idx_cell_R = i + num_ghosts_0_cell;
+            
+            double theta_minus = double(1);
+            double theta_plus = double(1);
+            
+            for (int bi = 0; bi < num_bounded_var; bi++)
+            {
+                const int ei = var_idx[bi];
+                
+                theta_minus = std::min(theta_minus, computeLimiterScalingFactor(
+                    V[ei][idx_cell_L], V_minus[ei][idx_face], V_lo[bi], V_up[bi]));
+                
+                theta_plus = std::min(theta_plus, computeLimiterScalingFactor(
+                    V[ei][idx_cell_R], V_plus[ei][idx_face], V_lo[bi], V_up[bi]));
+            }
+            
+            for (int ei = 0; ei < d_num_eqn; ei++)
+            {
+                V_minus[ei][idx_face] = V[ei][idx_cell_L] +
+                    theta_minus*(V_minus[ei][idx_face] - V[ei][idx_cell_L]);
+                
+                V_plus[ei][idx_face] = V[ei][idx_cell_R] +
+                    theta_plus*(V_plus[ei][idx_face] - V[ei][idx_cell_R]);
+            }
+        }
+    }
+    else if (d_dim == tbox::Dimension(2))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        const int interior_dim_1 = interior_dims[1];
+        
+        const int num_ghosts_0_cell = num_ghosts_cell[0];
+        const int num_ghosts_1_cell = num_ghosts_cell[1];
+        const int ghostcell_dim_0_cell = ghostcell_dims_cell[0];
+        
+        const int num_ghosts_0_side = num_ghosts_side[0];
+        const int num_ghosts_1_side = num_ghosts_side[1];
+        const int ghostcell_dim_0_side = ghostcell_dims_side[0];
+        
+        /*
+         * Limit the side primitive variables in the x-direction.
+         */
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            V_minus[ei] = primitive_variables_minus[ei]->getPointer(0);
+            V_plus[ei] = primitive_variables_plus[ei]->getPointer(0);
+        }
+        
+        for (int j = 0; j < interior_dim_1; j++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = -1; i < interior_dim_0 + 2; i++)
+            {
+                // Compute the linear indices.
+                const int idx_face = (i + num_ghosts_0_side) +
+                    (j + num_ghosts_1_side)*(ghostcell_dim_0_side + 1);
+                
+                const int idx_cell_L = (i - 1 + num_ghosts_0_cell) +
+                    (j + num_ghosts_1_cell)*ghostcell_dim_0_cell;
+                
+                const int idx_cell_R = (i + num_ghosts_0_cell) +
+                    (j + num_ghosts_1_cell)*ghostcell_dim_0_cell;
+                
+                double theta_minus = double(1);
+                double theta_plus = double(1);
+                
+                for (int bi = 0; bi < num_bounded_var; bi++)
+                {
+                    const int ei = var_idx[bi];
+                    
+                    theta_minus = std::min(theta_minus, computeLimiterScalingFactor(
+                        V[ei][idx_cell_L], V_minus[ei][idx_face], V_lo[bi], V_up[bi]));
+                    
+                    theta_plus = std::min(theta_plus, computeLimiterScalingFactor(
+                        V[ei][idx_cell_R], V_plus[ei][idx_face], V_lo[bi], V_up[bi]));
+                }
+                
+                for (int ei = 0; ei < d_num_eqn; ei++)
+                {
+                    V_minus[ei][idx_face] = V[ei][idx_cell_L] +
+                        theta_minus*(V_minus[ei][idx_face] - V[ei][idx_cell_L]);
+                    
+                    V_plus[ei][idx_face] = V[ei][idx_cell_R] +
+                        theta_plus*(V_plus[ei][idx_face] - V[ei][idx_cell_R]);
+                }
+            }
+        }
+        
+        /*
+         * Limit the side primitive variables in the y-direction.
+         */
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            V_minus[ei] = primitive_variables_minus[ei]->getPointer(1);
+            V_plus[ei] = primitive_variables_plus[ei]->getPointer(1);
+        }
+        
+        for (int j = -1; j < interior_dim_1 + 2; j++)
+        {
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < interior_dim_0; i++)
+            {
+                // Compute the linear indices.
+                const int idx_face = (i + num_ghosts_0_side) +
+                    (j + num_ghosts_1_side)*ghostcell_dim_0_side;
+                
+                const int idx_cell_B = (i + num_ghosts_0_cell) +
+                    (j - 1 + num_ghosts_1_cell)*ghostcell_dim_0_cell;
+                
+                const int idx_cell_T = (i + num_ghosts_0_cell) +
+                    (j + num_ghosts_1_cell)*ghostcell_dim_0_cell;
+                
+                double theta_minus = double(1);
+                double theta_plus = double(1);
+                
+                for (int bi = 0; bi < num_bounded_var; bi++)
+                {
+                    const int ei = var_idx[bi];
+                    
+                    theta_minus = std::min(theta_minus, computeLimiterScalingFactor(
+                        V[ei][idx_cell_B], V_minus[ei][idx_face], V_lo[bi], V_up[bi]));
+                    
+                    theta_plus = std::min(theta_plus, computeLimiterScalingFactor(
+                        V[ei][idx_cell_T], V_plus[ei][idx_face], V_lo[bi], V_up[bi]));
+                }
+                
+                for (int ei = 0; ei < d_num_eqn; ei++)
+                {
+                    V_minus[ei][idx_face] = V[ei][idx_cell_B] +
+                        theta_minus*(V_minus[ei][idx_face] - V[ei][idx_cell_B]);
+                    
+                    V_plus[ei][idx_face] = V[ei][idx_cell_T] +
+                        theta_plus*(V_plus[ei][idx_face] - V[ei][idx_cell_T]);
+                }
+            }
+        }
+    }
+    else if (d_dim == tbox::Dimension(3))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        const int interior_dim_1 = interior_dims[1];
+        const int interior_dim_2 = interior_dims[2];
+        
+        const int num_ghosts_0_cell = num_ghosts_cell[0];
+        const int num_ghosts_1_cell = num_ghosts_cell[1];
+        const int num_ghosts_2_cell = num_ghosts_cell[2];
+        const int ghostcell_dim_0_cell = ghostcell_dims_cell[0];
+        const int ghostcell_dim_1_cell = ghostcell_dims_cell[1];
+        
+        const int num_ghosts_0_side = num_ghosts_side[0];
+        const int num_ghosts_1_side = num_ghosts_side[1];
+        const int num_ghosts_2_side = num_ghosts_side[2];
+        const int ghostcell_dim_0_side = ghostcell_dims_side[0];
+        const int ghostcell_dim_1_side = ghostcell_dims_side[1];
+        
+        /*
+         * Limit the side primitive variables in the x-direction.
+         */
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            V_minus[ei] = primitive_variables_minus[ei]->getPointer(0);
+            V_plus[ei] = primitive_variables_plus[ei]->getPointer(0);
+        }
+        
+        for (int k = 0; k < interior_dim_2; k++)
+        {
+            for (int j = 0; j < interior_dim_1; j++)
+            {
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd
+#endif
+                for (int i = -1; i < interior_dim_0 + 2; i++)
+                {
+                    // Compute the linear indices.
+                    const int idx_face = (i + num_ghosts_0_side) +
+                        (j + num_ghosts_1_side)*(ghostcell_dim_0_side + 1) +
+                        (k + num_ghosts_2_side)*(ghostcell_dim_0_side + 1)*
+                            ghostcell_dim_1_side;
+                    
+                    const int idx_cell_L = (i - 1 + num_ghosts_0_cell) +
+                        (j + num_ghosts_1_cell)*ghostcell_dim_0_cell +
+                        (k + num_ghosts_2_cell)*ghostcell_dim_0_cell*
+                            ghostcell_dim_1_cell;
+                    
+                    const int idx_cell_R = (i + num_ghosts_0_cell) +
+                        (j + num_ghosts_1_cell)*ghostcell_dim_0_cell +
+                        (k + num_ghosts_2_cell)*ghostcell_dim_0_cell*
+                            ghostcell_dim_1_cell;
+                    
+                    double theta_minus = double(1);
+                    double theta_plus = double(1);
+                    
+                    for (int bi = 0; bi < num_bounded_var; bi++)
+                    {
+                        const int ei = var_idx[bi];
+                        
+                        theta_minus = std::min(theta_minus, computeLimiterScalingFactor(
+                            V[ei][idx_cell_L], V_minus[ei][idx_face], V_lo[bi], V_up[bi]));
+                        
+                        theta_plus = std::min(theta_plus, computeLimiterScalingFactor(
+                            V[ei][idx_cell_R], V_plus[ei][idx_face], V_lo[bi], V_up[bi]));
+                    }
+                    
+                    for (int ei = 0; ei < d_num_eqn; ei++)
+                    {
+                        V_minus[ei][idx_face] = V[ei][idx_cell_L] +
+                            theta_minus*(V_minus[ei][idx_face] - V[ei][idx_cell_L]);
+                        
+                        V_plus[ei][idx_face] = V[ei][idx_cell_R] +
+                            theta_plus*(V_plus[ei][idx_face] - V[ei][idx_cell_R]);
+                    }
+                }
+            }
+        }
+        
+        /*
+         * Limit the side primitive variables in the y-direction.
+         */
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            V_minus[ei] = primitive_variables_minus[ei]->getPointer(1);
+            V_plus[ei] = primitive_variables_plus[ei]->getPointer(1);
+        }
+        
+        for (int k = 0; k < interior_dim_2; k++)
+        {
+            for (int j = -1; j < interior_dim_1 + 2; j++)
+            {
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd
+#endif
+                for (int i = 0; i < interior_dim_0; i++)
+                {
+                    // Compute the linear indices.
+                    const int idx_face = (i + num_ghosts_0_side) +
+                        (j + num_ghosts_1_side)*ghostcell_dim_0_side +
+                        (k + num_ghosts_2_side)*ghostcell_dim_0_side*
+                            (ghostcell_dim_1_side + 1);
+                    
+                    const int idx_cell_B = (i + num_ghosts_0_cell) +
+                        (j - 1 + num_ghosts_1_cell)*ghostcell_dim_0_cell +
+                        (k + num_ghosts_2_cell)*ghostcell_dim_0_cell*
+                            ghostcell_dim_1_cell;
+                    
+                    const int idx_cell_T = (i + num_ghosts_0_cell) +
+                        (j + num_ghosts_1_cell)*ghostcell_dim_0_cell +
+                        (k + num_ghosts_2_cell)*ghostcell_dim_0_cell*
+                            ghostcell_dim_1_cell;
+                    
+                    double theta_minus = double(1);
+                    double theta_plus = double(1);
+                    
+                    for (int bi = 0; bi < num_bounded_var; bi++)
+                    {
+                        const int ei = var_idx[bi];
+                        
+                        theta_minus = std::min(theta_minus, computeLimiterScalingFactor(
+                            V[ei][idx_cell_B], V_minus[ei][idx_face], V_lo[bi], V_up[bi]));
+                        
+                        theta_plus = std::min(theta_plus, computeLimiterScalingFactor(
+                            V[ei][idx_cell_T], V_plus[ei][idx_face], V_lo[bi], V_up[bi]));
+                    }
+                    
+                    for (int ei = 0; ei < d_num_eqn; ei++)
+                    {
+                        V_minus[ei][idx_face] = V[ei][idx_cell_B] +
+                            theta_minus*(V_minus[ei][idx_face] - V[ei][idx_cell_B]);
+                        
+                        V_plus[ei][idx_face] = V[ei][idx_cell_T] +
+                            theta_plus*(V_plus[ei][idx_face] - V[ei][idx_cell_T]);
+                    }
+                }
+            }
+        }
+        
+        /*
+         * Limit the side primitive variables in the z-direction.
+         */
+        
+        for (int ei = 0; ei < d_num_eqn; ei++)
+        {
+            V_minus[ei] = primitive_variables_minus[ei]->getPointer(2);
+            V_plus[ei] = primitive_variables_plus[ei]->getPointer(2);
+        }
+        
+        for (int k = -1; k < interior_dim_2 + 2; k++)
+        {
+            for (int j = 0; j < interior_dim_1; j++)
+            {
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd
+#endif
+                for (int i = 0; i < interior_dim_0; i++)
+                {
+                    // Compute the linear indices.
+                    const int idx_face = (i + num_ghosts_0_side) +
+                        (j + num_ghosts_1_side)*ghostcell_dim_0_side +
+                        (k + num_ghosts_2_side)*ghostcell_dim_0_side*
+                            ghostcell_dim_1_side;
+                    
+                    const int idx_cell_B = (i + num_ghosts_0_cell) +
+                        (j + num_ghosts_1_cell)*ghostcell_dim_0_cell +
+                        (k - 1 + num_ghosts_2_cell)*ghostcell_dim_0_cell*
+                            ghostcell_dim_1_cell;
+                    
+                    const int idx_cell_F = (i + num_ghosts_0_cell) +
+                        (j + num_ghosts_1_cell)*ghostcell_dim_0_cell +
+                        (k + num_ghosts_2_cell)*ghostcell_dim_0_cell*
+                            ghostcell_dim_1_cell;
+                    
+                    double theta_minus = double(1);
+                    double theta_plus = double(1);
+                    
+                    for (int bi = 0; bi < num_bounded_var; bi++)
+                    {
+                        const int ei = var_idx[bi];
+                        
+                        theta_minus = std::min(theta_minus, computeLimiterScalingFactor(
+                            V[ei][idx_cell_B], V_minus[ei][idx_face], V_lo[bi], V_up[bi]));
+                        
+                        theta_plus = std::min(theta_plus, computeLimiterScalingFactor(
+                            V[ei][idx_cell_F], V_plus[ei][idx_face], V_lo[bi], V_up[bi]));
+                    }
+                    
+                    for (int ei = 0; ei < d_num_eqn; ei++)
+                    {
+                        V_minus[ei][idx_face] = V[ei][idx_cell_B] +
+                            theta_minus*(V_minus[ei][idx_face] - V[ei][idx_cell_B]);
+                        
+                        V_plus[ei][idx_face] = V[ei][idx_cell_F] +
+                            theta_plus*(V_plus[ei][idx_face] - V[ei][idx_cell_F]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
 /*
  * Setup the Riemann solver object.
  */
@@ -2,7 +2,6 @@
 
 #include "util/basic_boundary_conditions/CartesianBoundaryDefines.hpp"
 
-#include "SAMRAI/geom/CartesianPatchGeometry.h"
 #include "SAMRAI/hier/BoundaryBox.h"
 #include "SAMRAI/pdat/CellIndex.h"
 #include "SAMRAI/tbox/Utilities.h"
@@ -154,7 +153,7 @@ FlowModelBoundaryUtilitiesFiveEqnAllaire::getFromInput3d(
 void
 FlowModelBoundaryUtilitiesFiveEqnAllaire::fill1dNodeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_node_locs,
     const std::vector<int>& bdry_node_conds,
     const std::vector<std::vector<double> >& bdry_node_values,
@@ -171,7 +170,7 @@ FlowModelBoundaryUtilitiesFiveEqnAllaire::fill1dNodeBoundaryData(
 void
 FlowModelBoundaryUtilitiesFiveEqnAllaire::fill2dEdgeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_edge_locs,
     const std::vector<int>& bdry_edge_conds,
     const std::vector<std::vector<double> >& bdry_edge_values,
@@ -188,7 +187,7 @@ FlowModelBoundaryUtilitiesFiveEqnAllaire::fill2dEdgeBoundaryData(
 void
 FlowModelBoundaryUtilitiesFiveEqnAllaire::fill2dNodeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_node_locs,
     const std::vector<int>& bdry_node_conds,
     const std::vector<std::vector<double> >& bdry_edge_values,
@@ -205,7 +204,7 @@ FlowModelBoundaryUtilitiesFiveEqnAllaire::fill2dNodeBoundaryData(
 void
 FlowModelBoundaryUtilitiesFiveEqnAllaire::fill3dFaceBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_face_locs,
     const std::vector<int>& bdry_face_conds,
     const std::vector<std::vector<double> >& bdry_face_values,
@@ -222,7 +221,7 @@ FlowModelBoundaryUtilitiesFiveEqnAllaire::fill3dFaceBoundaryData(
 void
 FlowModelBoundaryUtilitiesFiveEqnAllaire::fill3dEdgeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_edge_locs,
     const std::vector<int>& bdry_edge_conds,
     const std::vector<std::vector<double> >& bdry_face_values,
@@ -239,7 +238,7 @@ FlowModelBoundaryUtilitiesFiveEqnAllaire::fill3dEdgeBoundaryData(
 void
 FlowModelBoundaryUtilitiesFiveEqnAllaire::fill3dNodeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_node_locs,
     const std::vector<int>& bdry_node_conds,
     const std::vector<std::vector<double> >& bdry_face_values,
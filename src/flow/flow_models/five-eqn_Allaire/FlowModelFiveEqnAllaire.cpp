@@ -4,6 +4,8 @@
 #include "flow/flow_models/five-eqn_Allaire/FlowModelRiemannSolverFiveEqnAllaire.hpp"
 #include "flow/flow_models/five-eqn_Allaire/FlowModelStatisticsUtilitiesFiveEqnAllaire.hpp"
 
+#include <limits>
+
 boost::shared_ptr<pdat::CellVariable<double> > FlowModelFiveEqnAllaire::s_variable_partial_densities;
 boost::shared_ptr<pdat::CellVariable<double> > FlowModelFiveEqnAllaire::s_variable_momentum;
 boost::shared_ptr<pdat::CellVariable<double> > FlowModelFiveEqnAllaire::s_variable_total_energy;
@@ -6312,6 +6314,43 @@ FlowModelFiveEqnAllaire::checkGlobalSideDataPrimitiveVariablesBounded(
 }
 
 
+/*
+ * Get the indices of the primitive variables that have to be within bounds and their lower and
+ * upper bounds.
+ */
+void
+FlowModelFiveEqnAllaire::getBoundsOfPrimitiveVariables(
+    std::vector<int>& bounded_var_idx,
+    std::vector<double>& bounds_lo,
+    std::vector<double>& bounds_up) const
+{
+    bounded_var_idx.clear();
+    bounds_lo.clear();
+    bounds_up.clear();
+    
+    // Partial densities.
+    for (int si = 0; si < d_num_species; si++)
+    {
+        bounded_var_idx.push_back(si);
+        bounds_lo.push_back(double(0));
+        bounds_up.push_back(std::numeric_limits<double>::max());
+    }
+    
+    // Pressure.
+    bounded_var_idx.push_back(d_num_species + d_dim.getValue());
+    bounds_lo.push_back(double(0));
+    bounds_up.push_back(std::numeric_limits<double>::max());
+    
+    // Volume fractions.
+    for (int si = 0; si < d_num_species - 1; si++)
+    {
+        bounded_var_idx.push_back(d_num_species + d_dim.getValue() + 1 + si);
+        bounds_lo.push_back(d_Z_bound_lo);
+        bounds_up.push_back(d_Z_bound_up);
+    }
+}
+
+
 /*
  * Convert vector of pointers of conservative cell data to vectors of pointers of primitive cell data.
  */
@@ -2,7 +2,6 @@
 
 #include "util/basic_boundary_conditions/CartesianBoundaryDefines.hpp"
 
-#include "SAMRAI/geom/CartesianPatchGeometry.h"
 #include "SAMRAI/hier/BoundaryBox.h"
 #include "SAMRAI/pdat/CellIndex.h"
 #include "SAMRAI/tbox/Utilities.h"
@@ -198,7 +197,7 @@ FlowModelBoundaryUtilitiesFourEqnConservative::getFromInput3d(
 void
 FlowModelBoundaryUtilitiesFourEqnConservative::fill1dNodeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_node_locs,
     const std::vector<int>& bdry_node_conds,
     const std::vector<std::vector<double> >& bdry_node_values,
@@ -224,14 +223,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill1dNodeBoundaryData(
     
     for (int vi = 0; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
-        TBOX_ASSERT_OBJDIM_EQUALITY3(*conservative_var_data[vi], patch, ghost_width_to_fill);
+        TBOX_ASSERT_OBJDIM_EQUALITY2(*conservative_var_data[vi], ghost_width_to_fill);
     }
     
-    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
-        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
-            patch.getPatchGeometry()));
-    TBOX_ASSERT(patch_geom);
-    
     hier::IntVector num_ghosts(conservative_var_data[0]->getGhostCellWidth());
     for (int vi = 1; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
@@ -258,44 +252,37 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill1dNodeBoundaryData(
             ghost_width_to_fill);
     }
     
-    // Get the dimensions of box that covers the interior of patch.
-    const hier::Box& interior_box(patch.getBox());
-    hier::Index interior_box_lo_idx(interior_box.lower());
-    hier::Index interior_box_hi_idx(interior_box.upper());
+    // Get the offset indices of box that covers the interior of patch.
+    const hier::Index& interior_box_lo_idx(bdry_descriptor.getInteriorBoxLowerIndex());
+    const hier::Index& interior_box_hi_idx(bdry_descriptor.getInteriorBoxUpperIndex());
     
     /*
-     * Offset the indices.
+     * Mark the node locations for applying boundary conditions.
      */
     
-    interior_box_lo_idx = interior_box_lo_idx - interior_box.lower();
-    interior_box_hi_idx = interior_box_hi_idx - interior_box.lower();
+    std::vector<bool> is_bdry_node_locs(NUM_1D_NODES, false);
+    for (int li = 0; li < static_cast<int>(bdry_node_locs.size()); li++)
+    {
+        is_bdry_node_locs[bdry_node_locs[li]] = true;
+    }
     
-    const std::vector<hier::BoundaryBox>& node_bdry =
-        patch_geom->getCodimensionBoundaries(BDRY::NODE1D);
+    const int num_node_bdry = bdry_descriptor.getNumberOfBoundaryBoxes(BDRY::NODE1D);
     
-    for (int ni = 0; ni < static_cast<int>(node_bdry.size()); ni++)
+    for (int ni = 0; ni < num_node_bdry; ni++)
     {
-        TBOX_ASSERT(node_bdry[ni].getBoundaryType() == BDRY::NODE1D);
-        
-        int node_loc = node_bdry[ni].getLocationIndex();
+        int node_loc = bdry_descriptor.getBoundaryLocationIndex(BDRY::NODE1D, ni);
         
-        if (std::find(bdry_node_locs.begin(), bdry_node_locs.end(), node_loc) !=
-            bdry_node_locs.end())
+        if (is_bdry_node_locs[node_loc])
         {
-            hier::Box fill_box(patch_geom->getBoundaryFillBox(
-                node_bdry[ni],
-                interior_box,
-                gcw_to_fill));
+            hier::Index fill_box_lo_idx(tbox::Dimension(1));
+            hier::Index fill_box_hi_idx(tbox::Dimension(1));
             
-            hier::Index fill_box_lo_idx(fill_box.lower());
-            hier::Index fill_box_hi_idx(fill_box.upper());
-            
-            /*
-             * Offset the indices.
-             */
-            
-            fill_box_lo_idx = fill_box_lo_idx - interior_box.lower();
-            fill_box_hi_idx = fill_box_hi_idx - interior_box.lower();
+            bdry_descriptor.getBoundaryFillBox(
+                fill_box_lo_idx,
+                fill_box_hi_idx,
+                BDRY::NODE1D,
+                ni,
+                gcw_to_fill);
             
             if ((bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::ADIABATIC_NO_SLIP) ||
                 (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::ISOTHERMAL_NO_SLIP))
@@ -590,7 +577,7 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill1dNodeBoundaryData(
 void
 FlowModelBoundaryUtilitiesFourEqnConservative::fill2dEdgeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_edge_locs,
     const std::vector<int>& bdry_edge_conds,
     const std::vector<std::vector<double> >& bdry_edge_values,
@@ -616,14 +603,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dEdgeBoundaryData(
     
     for (int vi = 0; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
-        TBOX_ASSERT_OBJDIM_EQUALITY3(*conservative_var_data[vi], patch, ghost_width_to_fill);
+        TBOX_ASSERT_OBJDIM_EQUALITY2(*conservative_var_data[vi], ghost_width_to_fill);
     }
     
-    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
-        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
-            patch.getPatchGeometry()));
-    TBOX_ASSERT(patch_geom);
-    
     hier::IntVector num_ghosts(conservative_var_data[0]->getGhostCellWidth());
     for (int vi = 1; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
@@ -650,44 +632,37 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dEdgeBoundaryData(
             ghost_width_to_fill);
     }
     
-    // Get the dimensions of box that covers the interior of patch.
-    const hier::Box& interior_box(patch.getBox());
-    hier::Index interior_box_lo_idx(interior_box.lower());
-    hier::Index interior_box_hi_idx(interior_box.upper());
+    // Get the offset indices of box that covers the interior of patch.
+    const hier::Index& interior_box_lo_idx(bdry_descriptor.getInteriorBoxLowerIndex());
+    const hier::Index& interior_box_hi_idx(bdry_descriptor.getInteriorBoxUpperIndex());
     
     /*
-     * Offset the indices.
+     * Mark the edge locations for applying boundary conditions.
      */
     
-    interior_box_lo_idx = interior_box_lo_idx - interior_box.lower();
-    interior_box_hi_idx = interior_box_hi_idx - interior_box.lower();
+    std::vector<bool> is_bdry_edge_locs(NUM_2D_EDGES, false);
+    for (int li = 0; li < static_cast<int>(bdry_edge_locs.size()); li++)
+    {
+        is_bdry_edge_locs[bdry_edge_locs[li]] = true;
+    }
     
-    const std::vector<hier::BoundaryBox>& edge_bdry =
-        patch_geom->getCodimensionBoundaries(BDRY::EDGE2D);
+    const int num_edge_bdry = bdry_descriptor.getNumberOfBoundaryBoxes(BDRY::EDGE2D);
     
-    for (int ei = 0; ei < static_cast<int>(edge_bdry.size()); ei++)
+    for (int ei = 0; ei < num_edge_bdry; ei++)
     {
-        TBOX_ASSERT(edge_bdry[ei].getBoundaryType() == BDRY::EDGE2D);
-        
-        int edge_loc = edge_bdry[ei].getLocationIndex();
+        int edge_loc = bdry_descriptor.getBoundaryLocationIndex(BDRY::EDGE2D, ei);
         
-        if (std::find(bdry_edge_locs.begin(), bdry_edge_locs.end(), edge_loc) !=
-            bdry_edge_locs.end())
+        if (is_bdry_edge_locs[edge_loc])
         {
-            hier::Box fill_box(patch_geom->getBoundaryFillBox(
-                edge_bdry[ei],
-                interior_box,
-                gcw_to_fill));
-            
-            hier::Index fill_box_lo_idx(fill_box.lower());
-            hier::Index fill_box_hi_idx(fill_box.upper());
-            
-            /*
-             * Offset the indices.
-             */
+            hier::Index fill_box_lo_idx(tbox::Dimension(2));
+            hier::Index fill_box_hi_idx(tbox::Dimension(2));
             
-            fill_box_lo_idx = fill_box_lo_idx - interior_box.lower();
-            fill_box_hi_idx = fill_box_hi_idx - interior_box.lower();
+            bdry_descriptor.getBoundaryFillBox(
+                fill_box_lo_idx,
+                fill_box_hi_idx,
+                BDRY::EDGE2D,
+                ei,
+                gcw_to_fill);
             
             if ((bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::ADIABATIC_NO_SLIP) ||
                 (bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::ISOTHERMAL_NO_SLIP))
@@ -733,9 +708,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dEdgeBoundaryData(
                 
                 if (bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::ADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                     {
-                        for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
+                        for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                         {
                             const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                 (j + num_subghosts_conservative_var[0][1])*
@@ -910,9 +885,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dEdgeBoundaryData(
                 }
                 else if (bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::ISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                     {
-                        for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
+                        for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                         {
                             const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                 (j + num_subghosts_conservative_var[0][1])*
@@ -1105,7 +1080,7 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dEdgeBoundaryData(
 void
 FlowModelBoundaryUtilitiesFourEqnConservative::fill2dNodeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_node_locs,
     const std::vector<int>& bdry_node_conds,
     const std::vector<std::vector<double> >& bdry_edge_values,
@@ -1131,14 +1106,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dNodeBoundaryData(
     
     for (int vi = 0; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
-        TBOX_ASSERT_OBJDIM_EQUALITY3(*conservative_var_data[vi], patch, ghost_width_to_fill);
+        TBOX_ASSERT_OBJDIM_EQUALITY2(*conservative_var_data[vi], ghost_width_to_fill);
     }
     
-    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
-        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
-            patch.getPatchGeometry()));
-    TBOX_ASSERT(patch_geom);
-    
     hier::IntVector num_ghosts(conservative_var_data[0]->getGhostCellWidth());
     for (int vi = 1; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
@@ -1165,44 +1135,37 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dNodeBoundaryData(
             ghost_width_to_fill);
     }
     
-    // Get the dimensions of box that covers the interior of patch.
-    const hier::Box& interior_box(patch.getBox());
-    hier::Index interior_box_lo_idx(interior_box.lower());
-    hier::Index interior_box_hi_idx(interior_box.upper());
+    // Get the offset indices of box that covers the interior of patch.
+    const hier::Index& interior_box_lo_idx(bdry_descriptor.getInteriorBoxLowerIndex());
+    const hier::Index& interior_box_hi_idx(bdry_descriptor.getInteriorBoxUpperIndex());
     
     /*
-     * Offset the indices.
+     * Mark the node locations for applying boundary conditions.
      */
     
-    interior_box_lo_idx = interior_box_lo_idx - interior_box.lower();
-    interior_box_hi_idx = interior_box_hi_idx - interior_box.lower();
+    std::vector<bool> is_bdry_node_locs(NUM_2D_NODES, false);
+    for (int li = 0; li < static_cast<int>(bdry_node_locs.size()); li++)
+    {
+        is_bdry_node_locs[bdry_node_locs[li]] = true;
+    }
     
-    const std::vector<hier::BoundaryBox>& node_bdry =
-        patch_geom->getCodimensionBoundaries(BDRY::NODE2D);
+    const int num_node_bdry = bdry_descriptor.getNumberOfBoundaryBoxes(BDRY::NODE2D);
     
-    for (int ni = 0; ni < static_cast<int>(node_bdry.size()); ni++)
+    for (int ni = 0; ni < num_node_bdry; ni++)
     {
-        TBOX_ASSERT(node_bdry[ni].getBoundaryType() == BDRY::NODE2D);
-        
-        int node_loc = node_bdry[ni].getLocationIndex();
+        int node_loc = bdry_descriptor.getBoundaryLocationIndex(BDRY::NODE2D, ni);
         
-        if (std::find(bdry_node_locs.begin(), bdry_node_locs.end(), node_loc) !=
-            bdry_node_locs.end())
+        if (is_bdry_node_locs[node_loc])
         {
-            hier::Box fill_box(patch_geom->getBoundaryFillBox(
-                node_bdry[ni],
-                interior_box,
-                gcw_to_fill));
+            hier::Index fill_box_lo_idx(tbox::Dimension(2));
+            hier::Index fill_box_hi_idx(tbox::Dimension(2));
             
-            hier::Index fill_box_lo_idx(fill_box.lower());
-            hier::Index fill_box_hi_idx(fill_box.upper());
-            
-            /*
-             * Offset the indices.
-             */
-            
-            fill_box_lo_idx = fill_box_lo_idx - interior_box.lower();
-            fill_box_hi_idx = fill_box_hi_idx - interior_box.lower();
+            bdry_descriptor.getBoundaryFillBox(
+                fill_box_lo_idx,
+                fill_box_hi_idx,
+                BDRY::NODE2D,
+                ni,
+                gcw_to_fill);
             
             int edge_loc_0 = -1;
             int edge_loc_1 = -1;
@@ -1285,9 +1248,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dNodeBoundaryData(
                 
                 if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::XADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                     {
-                        for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
+                        for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                         {
                             const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                 (j + num_subghosts_conservative_var[0][1])*
@@ -1428,9 +1391,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dNodeBoundaryData(
                 }
                 else if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::YADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                     {
-                        for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
+                        for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                         {
                             const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                 (j + num_subghosts_conservative_var[0][1])*
@@ -1571,9 +1534,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dNodeBoundaryData(
                 }
                 else if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::XISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                     {
-                        for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
+                        for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                         {
                             const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                 (j + num_subghosts_conservative_var[0][1])*
@@ -1721,9 +1684,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dNodeBoundaryData(
                 }
                 else if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::YISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                     {
-                        for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
+                        for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                         {
                             const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                 (j + num_subghosts_conservative_var[0][1])*
@@ -1882,7 +1845,7 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill2dNodeBoundaryData(
 void
 FlowModelBoundaryUtilitiesFourEqnConservative::fill3dFaceBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_face_locs,
     const std::vector<int>& bdry_face_conds,
     const std::vector<std::vector<double> >& bdry_face_values,
@@ -1908,14 +1871,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dFaceBoundaryData(
     
     for (int vi = 0; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
-        TBOX_ASSERT_OBJDIM_EQUALITY3(*conservative_var_data[vi], patch, ghost_width_to_fill);
+        TBOX_ASSERT_OBJDIM_EQUALITY2(*conservative_var_data[vi], ghost_width_to_fill);
     }
     
-    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
-        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
-            patch.getPatchGeometry()));
-    TBOX_ASSERT(patch_geom);
-    
     hier::IntVector num_ghosts(conservative_var_data[0]->getGhostCellWidth());
     for (int vi = 1; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
@@ -1942,44 +1900,37 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dFaceBoundaryData(
             ghost_width_to_fill);
     }
     
-    // Get the dimensions of box that covers the interior of patch.
-    const hier::Box& interior_box(patch.getBox());
-    hier::Index interior_box_lo_idx(interior_box.lower());
-    hier::Index interior_box_hi_idx(interior_box.upper());
+    // Get the offset indices of box that covers the interior of patch.
+    const hier::Index& interior_box_lo_idx(bdry_descriptor.getInteriorBoxLowerIndex());
+    const hier::Index& interior_box_hi_idx(bdry_descriptor.getInteriorBoxUpperIndex());
     
     /*
-     * Offset the indices.
+     * Mark the face locations for applying boundary conditions.
      */
     
-    interior_box_lo_idx = interior_box_lo_idx - interior_box.lower();
-    interior_box_hi_idx = interior_box_hi_idx - interior_box.lower();
+    std::vector<bool> is_bdry_face_locs(NUM_3D_FACES, false);
+    for (int li = 0; li < static_cast<int>(bdry_face_locs.size()); li++)
+    {
+        is_bdry_face_locs[bdry_face_locs[li]] = true;
+    }
     
-    const std::vector<hier::BoundaryBox>& face_bdry =
-        patch_geom->getCodimensionBoundaries(BDRY::FACE3D);
+    const int num_face_bdry = bdry_descriptor.getNumberOfBoundaryBoxes(BDRY::FACE3D);
     
-    for (int fi = 0; fi < static_cast<int>(face_bdry.size()); fi++)
+    for (int fi = 0; fi < num_face_bdry; fi++)
     {
-        TBOX_ASSERT(face_bdry[fi].getBoundaryType() == BDRY::FACE3D);
+        int face_loc = bdry_descriptor.getBoundaryLocationIndex(BDRY::FACE3D, fi);
         
-        int face_loc = face_bdry[fi].getLocationIndex();
-        
-        if (std::find(bdry_face_locs.begin(), bdry_face_locs.end(), face_loc) !=
-            bdry_face_locs.end())
+        if (is_bdry_face_locs[face_loc])
         {
-            hier::Box fill_box(patch_geom->getBoundaryFillBox(
-                face_bdry[fi],
-                interior_box,
-                gcw_to_fill));
-            
-            hier::Index fill_box_lo_idx(fill_box.lower());
-            hier::Index fill_box_hi_idx(fill_box.upper());
+            hier::Index fill_box_lo_idx(tbox::Dimension(3));
+            hier::Index fill_box_hi_idx(tbox::Dimension(3));
             
-            /*
-             * Offset the indices.
-             */
-            
-            fill_box_lo_idx = fill_box_lo_idx - interior_box.lower();
-            fill_box_hi_idx = fill_box_hi_idx - interior_box.lower();
+            bdry_descriptor.getBoundaryFillBox(
+                fill_box_lo_idx,
+                fill_box_hi_idx,
+                BDRY::FACE3D,
+                fi,
+                gcw_to_fill);
             
             if ((bdry_face_conds[face_loc] == BDRY_COND::FLOW_MODEL::ADIABATIC_NO_SLIP) ||
                 (bdry_face_conds[face_loc] == BDRY_COND::FLOW_MODEL::ISOTHERMAL_NO_SLIP))
@@ -2025,11 +1976,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dFaceBoundaryData(
                 
                 if (bdry_face_conds[face_loc] == BDRY_COND::FLOW_MODEL::ADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -2307,11 +2258,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dFaceBoundaryData(
                 }
                 else if (bdry_face_conds[face_loc] == BDRY_COND::FLOW_MODEL::ISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -2608,7 +2559,7 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dFaceBoundaryData(
 void
 FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_edge_locs,
     const std::vector<int>& bdry_edge_conds,
     const std::vector<std::vector<double> >& bdry_face_values,
@@ -2634,14 +2585,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
     
     for (int vi = 0; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
-        TBOX_ASSERT_OBJDIM_EQUALITY3(*conservative_var_data[vi], patch, ghost_width_to_fill);
+        TBOX_ASSERT_OBJDIM_EQUALITY2(*conservative_var_data[vi], ghost_width_to_fill);
     }
     
-    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
-        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
-            patch.getPatchGeometry()));
-    TBOX_ASSERT(patch_geom);
-    
     hier::IntVector num_ghosts(conservative_var_data[0]->getGhostCellWidth());
     for (int vi = 1; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
@@ -2668,44 +2614,37 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
             ghost_width_to_fill);
     }
     
-    // Get the dimensions of box that covers the interior of patch.
-    const hier::Box& interior_box(patch.getBox());
-    hier::Index interior_box_lo_idx(interior_box.lower());
-    hier::Index interior_box_hi_idx(interior_box.upper());
+    // Get the offset indices of box that covers the interior of patch.
+    const hier::Index& interior_box_lo_idx(bdry_descriptor.getInteriorBoxLowerIndex());
+    const hier::Index& interior_box_hi_idx(bdry_descriptor.getInteriorBoxUpperIndex());
     
     /*
-     * Offset the indices.
+     * Mark the edge locations for applying boundary conditions.
      */
     
-    interior_box_lo_idx = interior_box_lo_idx - interior_box.lower();
-    interior_box_hi_idx = interior_box_hi_idx - interior_box.lower();
+    std::vector<bool> is_bdry_edge_locs(NUM_3D_EDGES, false);
+    for (int li = 0; li < static_cast<int>(bdry_edge_locs.size()); li++)
+    {
+        is_bdry_edge_locs[bdry_edge_locs[li]] = true;
+    }
     
-    const std::vector<hier::BoundaryBox>& edge_bdry =
-        patch_geom->getCodimensionBoundaries(BDRY::EDGE3D);
+    const int num_edge_bdry = bdry_descriptor.getNumberOfBoundaryBoxes(BDRY::EDGE3D);
     
-    for (int ei = 0; ei < static_cast<int>(edge_bdry.size()); ei++)
+    for (int ei = 0; ei < num_edge_bdry; ei++)
     {
-        TBOX_ASSERT(edge_bdry[ei].getBoundaryType() == BDRY::EDGE3D);
+        int edge_loc(bdry_descriptor.getBoundaryLocationIndex(BDRY::EDGE3D, ei));
         
-        int edge_loc(edge_bdry[ei].getLocationIndex());
-        
-        if (std::find(bdry_edge_locs.begin(), bdry_edge_locs.end(), edge_loc) !=
-            bdry_edge_locs.end())
+        if (is_bdry_edge_locs[edge_loc])
         {
-            hier::Box fill_box(patch_geom->getBoundaryFillBox(
-                edge_bdry[ei],
-                interior_box,
-                gcw_to_fill));
-            
-            hier::Index fill_box_lo_idx(fill_box.lower());
-            hier::Index fill_box_hi_idx(fill_box.upper());
+            hier::Index fill_box_lo_idx(tbox::Dimension(3));
+            hier::Index fill_box_hi_idx(tbox::Dimension(3));
             
-            /*
-             * Offset the indices.
-             */
-            
-            fill_box_lo_idx = fill_box_lo_idx - interior_box.lower();
-            fill_box_hi_idx = fill_box_hi_idx - interior_box.lower();
+            bdry_descriptor.getBoundaryFillBox(
+                fill_box_lo_idx,
+                fill_box_hi_idx,
+                BDRY::EDGE3D,
+                ei,
+                gcw_to_fill);
             
             int face_loc_0 = -1;
             int face_loc_1 = -1;
@@ -2847,11 +2786,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
                 
                 if (bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::XADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -3025,11 +2964,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
                 }
                 else if (bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::YADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -3203,11 +3142,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
                 }
                 else if (bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::ZADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -3381,11 +3320,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
                 }
                 else if (bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::XISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -3566,11 +3505,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
                 }
                 else if (bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::YISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -3751,11 +3690,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
                 }
                 else if (bdry_edge_conds[edge_loc] == BDRY_COND::FLOW_MODEL::ZISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -3947,7 +3886,7 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dEdgeBoundaryData(
 void
 FlowModelBoundaryUtilitiesFourEqnConservative::fill3dNodeBoundaryData(
     const std::vector<boost::shared_ptr<pdat::CellData<double> > >& conservative_var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     std::vector<int>& bdry_node_locs,
     const std::vector<int>& bdry_node_conds,
     const std::vector<std::vector<double> >& bdry_face_values,
@@ -3973,14 +3912,9 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dNodeBoundaryData(
     
     for (int vi = 0; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
-        TBOX_ASSERT_OBJDIM_EQUALITY3(*conservative_var_data[vi], patch, ghost_width_to_fill);
+        TBOX_ASSERT_OBJDIM_EQUALITY2(*conservative_var_data[vi], ghost_width_to_fill);
     }
     
-    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
-        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
-            patch.getPatchGeometry()));
-    TBOX_ASSERT(patch_geom);
-    
     hier::IntVector num_ghosts(conservative_var_data[0]->getGhostCellWidth());
     for (int vi = 1; vi < static_cast<int>(conservative_var_data.size()); vi++)
     {
@@ -4007,44 +3941,37 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dNodeBoundaryData(
             ghost_width_to_fill);
     }
     
-    // Get the dimensions of box that covers the interior of patch.
-    const hier::Box& interior_box(patch.getBox());
-    hier::Index interior_box_lo_idx(interior_box.lower());
-    hier::Index interior_box_hi_idx(interior_box.upper());
+    // Get the offset indices of box that covers the interior of patch.
+    const hier::Index& interior_box_lo_idx(bdry_descriptor.getInteriorBoxLowerIndex());
+    const hier::Index& interior_box_hi_idx(bdry_descriptor.getInteriorBoxUpperIndex());
     
     /*
-     * Offset the indices.
+     * Mark the node locations for applying boundary conditions.
      */
     
-    interior_box_lo_idx = interior_box_lo_idx - interior_box.lower();
-    interior_box_hi_idx = interior_box_hi_idx - interior_box.lower();
+    std::vector<bool> is_bdry_node_locs(NUM_3D_NODES, false);
+    for (int li = 0; li < static_cast<int>(bdry_node_locs.size()); li++)
+    {
+        is_bdry_node_locs[bdry_node_locs[li]] = true;
+    }
     
-    const std::vector<hier::BoundaryBox>& node_bdry =
-        patch_geom->getCodimensionBoundaries(BDRY::NODE3D);
+    const int num_node_bdry = bdry_descriptor.getNumberOfBoundaryBoxes(BDRY::NODE3D);
     
-    for (int ni = 0; ni < static_cast<int>(node_bdry.size()); ni++)
+    for (int ni = 0; ni < num_node_bdry; ni++)
     {
-        TBOX_ASSERT(node_bdry[ni].getBoundaryType() == BDRY::NODE3D);
+        int node_loc(bdry_descriptor.getBoundaryLocationIndex(BDRY::NODE3D, ni));
         
-        int node_loc(node_bdry[ni].getLocationIndex());
-        
-        if (std::find(bdry_node_locs.begin(), bdry_node_locs.end(), node_loc) !=
-            bdry_node_locs.end())
+        if (is_bdry_node_locs[node_loc])
         {
-            hier::Box fill_box(patch_geom->getBoundaryFillBox(
-                node_bdry[ni],
-                interior_box,
-                gcw_to_fill));
-            
-            hier::Index fill_box_lo_idx(fill_box.lower());
-            hier::Index fill_box_hi_idx(fill_box.upper());
+            hier::Index fill_box_lo_idx(tbox::Dimension(3));
+            hier::Index fill_box_hi_idx(tbox::Dimension(3));
             
-            /*
-             * Offset the indices.
-             */
-            
-            fill_box_lo_idx = fill_box_lo_idx - interior_box.lower();
-            fill_box_hi_idx = fill_box_hi_idx - interior_box.lower();
+            bdry_descriptor.getBoundaryFillBox(
+                fill_box_lo_idx,
+                fill_box_hi_idx,
+                BDRY::NODE3D,
+                ni,
+                gcw_to_fill);
             
             int face_loc_0 = -1;
             int face_loc_1 = -1;
@@ -4166,11 +4093,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dNodeBoundaryData(
                 
                 if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::XADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -4344,11 +4271,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dNodeBoundaryData(
                 }
                 else if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::YADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -4522,11 +4449,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dNodeBoundaryData(
                 }
                 else if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::ZADIABATIC_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -4700,11 +4627,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dNodeBoundaryData(
                 }
                 else if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::XISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -4885,11 +4812,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dNodeBoundaryData(
                 }
                 else if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::YISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
@@ -5070,11 +4997,11 @@ FlowModelBoundaryUtilitiesFourEqnConservative::fill3dNodeBoundaryData(
                 }
                 else if (bdry_node_conds[node_loc] == BDRY_COND::FLOW_MODEL::ZISOTHERMAL_NO_SLIP)
                 {
-                    for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
+                    for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
                     {
                         for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
                         {
-                            for (int k = fill_box_lo_idx[2]; k <= fill_box_hi_idx[2]; k++)
+                            for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
                             {
                                 const int idx_cell_rho_Y = (i + num_subghosts_conservative_var[0][0]) +
                                     (j + num_subghosts_conservative_var[0][1])*
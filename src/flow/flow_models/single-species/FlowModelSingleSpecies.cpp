@@ -4,6 +4,8 @@
 #include "flow/flow_models/single-species/FlowModelRiemannSolverSingleSpecies.hpp"
 #include "flow/flow_models/single-species/FlowModelStatisticsUtilitiesSingleSpecies.hpp"
 
+#include <limits>
+
 boost::shared_ptr<pdat::CellVariable<double> > FlowModelSingleSpecies::s_variable_density;
 boost::shared_ptr<pdat::CellVariable<double> > FlowModelSingleSpecies::s_variable_momentum;
 boost::shared_ptr<pdat::CellVariable<double> > FlowModelSingleSpecies::s_variable_total_energy;
@@ -3873,6 +3875,32 @@ FlowModelSingleSpecies::checkGlobalSideDataPrimitiveVariablesBounded(
 }
 
 
+/*
+ * Get the indices of the primitive variables that have to be within bounds and their lower and
+ * upper bounds.
+ */
+void
+FlowModelSingleSpecies::getBoundsOfPrimitiveVariables(
+    std::vector<int>& bounded_var_idx,
+    std::vector<double>& bounds_lo,
+    std::vector<double>& bounds_up) const
+{
+    bounded_var_idx.clear();
+    bounds_lo.clear();
+    bounds_up.clear();
+    
+    // Density.
+    bounded_var_idx.push_back(0);
+    bounds_lo.push_back(double(0));
+    bounds_up.push_back(std::numeric_limits<double>::max());
+    
+    // Pressure.
+    bounded_var_idx.push_back(d_num_eqn - 1);
+    bounds_lo.push_back(double(0));
+    bounds_up.push_back(std::numeric_limits<double>::max());
+}
+
+
 /*
  * Convert vector of pointers of conservative cell data to vectors of pointers of primitive cell data.
  */
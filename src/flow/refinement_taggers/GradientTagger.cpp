@@ -1,4 +1,5 @@
 #include "flow/refinement_taggers/GradientTagger.hpp"
+#include "flow/refinement_taggers/RefinementTaggerStatistics.hpp"
 
 #include "boost/lexical_cast.hpp"
 
@@ -1541,6 +1542,54 @@ GradientTagger::computeGradientSensorValuesOnPatch(
     hier::Patch& patch,
     const boost::shared_ptr<hier::VariableContext>& data_context)
 {
+    /*
+     * Register the patch and all the variables required by the difference sensors in the flow
+     * model at once and compute the corresponding cell data.
+     */
+    
+    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
+    
+    for (int si = 0; si < static_cast<int>(d_gradient_sensors.size()); si++)
+    {
+        std::string sensor_key = d_gradient_sensors[si];
+        
+        if (sensor_key == "DIFFERENCE_FIRST_ORDER")
+        {
+            for (int vi = 0;
+                 vi < static_cast<int>(d_difference_first_order_variables.size());
+                 vi++)
+            {
+                num_subghosts_of_data.insert(
+                    std::pair<std::string, hier::IntVector>(
+                        d_difference_first_order_variables[vi],
+                        d_num_gradient_ghosts));
+            }
+        }
+        else if (sensor_key == "DIFFERENCE_SECOND_ORDER")
+        {
+            for (int vi = 0;
+                 vi < static_cast<int>(d_difference_second_order_variables.size());
+                 vi++)
+            {
+                num_subghosts_of_data.insert(
+                    std::pair<std::string, hier::IntVector>(
+                        d_difference_second_order_variables[vi],
+                        d_num_gradient_ghosts));
+            }
+        }
+    }
+    
+    if (num_subghosts_of_data.empty())
+    {
+        return;
+    }
+    
+    d_flow_model->registerPatchWithDataContext(patch, data_context);
+    
+    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
+    
+    d_flow_model->computeGlobalDerivedCellData();
+    
     // Loop over gradient sensors chosen.
     for (int si = 0; si < static_cast<int>(d_gradient_sensors.size()); si++)
     {
@@ -1557,22 +1606,6 @@ GradientTagger::computeGradientSensorValuesOnPatch(
                 
                 if (variable_key == "DENSITY")
                 {
-                    /*
-                     * Register the patch and density in the flow model and compute the
-                     * corresponding cell data.
-                     */
-                    
-                    d_flow_model->registerPatchWithDataContext(patch, data_context);
-                    
-                    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
-                    
-                    num_subghosts_of_data.insert(
-                        std::pair<std::string, hier::IntVector>("DENSITY", d_num_gradient_ghosts));
-                    
-                    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
-                    
-                    d_flow_model->computeGlobalDerivedCellData();
-                    
                     // Get the pointer to density data inside the flow model.
                     boost::shared_ptr<pdat::CellData<double> > data_density =
                         d_flow_model->getGlobalCellData("DENSITY");
@@ -1603,33 +1636,9 @@ GradientTagger::computeGradientSensorValuesOnPatch(
                             difference,
                             data_density);
                     }
-                    
-                    /*
-                     * Unregister the patch and data of all registered derived cell variables in
-                     * the flow model.
-                     */
-                    
-                    d_flow_model->unregisterPatch();
-                    
                 }
                 else if (variable_key ==  "TOTAL_ENERGY")
                 {
-                    /*
-                     * Register the patch and total energy in the flow model and compute the
-                     * corresponding cell data.
-                     */
-                    
-                    d_flow_model->registerPatchWithDataContext(patch, data_context);
-                    
-                    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
-                    
-                    num_subghosts_of_data.insert(
-                        std::pair<std::string, hier::IntVector>("TOTAL_ENERGY", d_num_gradient_ghosts));
-                    
-                    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
-                    
-                    d_flow_model->computeGlobalDerivedCellData();
-                    
                     // Get the pointer to total energy data inside the flow model.
                     boost::shared_ptr<pdat::CellData<double> > data_total_energy =
                         d_flow_model->getGlobalCellData("TOTAL_ENERGY");
@@ -1662,33 +1671,9 @@ GradientTagger::computeGradientSensorValuesOnPatch(
                             difference,
                             data_total_energy);
                     }
-                    
-                    /*
-                     * Unregister the patch and data of all registered derived cell variables in
-                     * the flow model.
-                     */
-                    
-                    d_flow_model->unregisterPatch();
-                    
                 }
                 else if (variable_key == "PRESSURE")
                 {
-                    /*
-                     * Register the patch and pressure in the flow model and compute the
-                     * corresponding cell data.
-                     */
-                    
-                    d_flow_model->registerPatchWithDataContext(patch, data_context);
-                    
-                    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
-                    
-                    num_subghosts_of_data.insert(
-                        std::pair<std::string, hier::IntVector>("PRESSURE", d_num_gradient_ghosts));
-                    
-                    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
-                    
-                    d_flow_model->computeGlobalDerivedCellData();
-                    
                     // Get the pointer to pressure data inside the flow model.
                     boost::shared_ptr<pdat::CellData<double> > data_pressure =
                         d_flow_model->getGlobalCellData("PRESSURE");
@@ -1721,14 +1706,6 @@ GradientTagger::computeGradientSensorValuesOnPatch(
                             difference,
                             data_pressure);
                     }
-                    
-                    /*
-                     * Unregister the patch and data of all registered derived cell variables in
-                     * the flow model.
-                     */
-                    
-                    d_flow_model->unregisterPatch();
-                    
                 }
                 else
                 {
@@ -1752,22 +1729,6 @@ GradientTagger::computeGradientSensorValuesOnPatch(
                 
                 if (variable_key == "DENSITY")
                 {
-                    /*
-                     * Register the patch and density in the flow model and compute the
-                     * corresponding cell data.
-                     */
-                    
-                    d_flow_model->registerPatchWithDataContext(patch, data_context);
-                    
-                    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
-                    
-                    num_subghosts_of_data.insert(
-                        std::pair<std::string, hier::IntVector>("DENSITY", d_num_gradient_ghosts));
-                    
-                    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
-                    
-                    d_flow_model->computeGlobalDerivedCellData();
-                    
                     // Get the pointer to density data inside the flow model.
                     boost::shared_ptr<pdat::CellData<double> > data_density =
                         d_flow_model->getGlobalCellData("DENSITY");
@@ -1800,33 +1761,9 @@ GradientTagger::computeGradientSensorValuesOnPatch(
                             difference,
                             data_density);
                     }
-                    
-                    /*
-                     * Unregister the patch and data of all registered derived cell variables in
-                     * the flow model.
-                     */
-                    
-                    d_flow_model->unregisterPatch();
-                    
                 }
                 else if (variable_key ==  "TOTAL_ENERGY")
                 {
-                    /*
-                     * Register the patch and total energy in the flow model and compute the
-                     * corresponding cell data.
-                     */
-                    
-                    d_flow_model->registerPatchWithDataContext(patch, data_context);
-                    
-                    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
-                    
-                    num_subghosts_of_data.insert(
-                        std::pair<std::string, hier::IntVector>("TOTAL_ENERGY", d_num_gradient_ghosts));
-                    
-                    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
-                    
-                    d_flow_model->computeGlobalDerivedCellData();
-                    
                     // Get the pointer to total energy data inside the flow model.
                     boost::shared_ptr<pdat::CellData<double> > data_total_energy =
                         d_flow_model->getGlobalCellData("TOTAL_ENERGY");
@@ -1859,33 +1796,9 @@ GradientTagger::computeGradientSensorValuesOnPatch(
                             difference,
                             data_total_energy);
                     }
-                    
-                    /*
-                     * Unregister the patch and data of all registered derived cell variables in
-                     * the flow model.
-                     */
-                    
-                    d_flow_model->unregisterPatch();
-                    
                 }
                 else if (variable_key == "PRESSURE")
                 {
-                    /*
-                     * Register the patch and pressure in the flow model and compute the
-                     * corresponding cell data.
-                     */
-                    
-                    d_flow_model->registerPatchWithDataContext(patch, data_context);
-                    
-                    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
-                    
-                    num_subghosts_of_data.insert(
-                        std::pair<std::string, hier::IntVector>("PRESSURE", d_num_gradient_ghosts));
-                    
-                    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
-                    
-                    d_flow_model->computeGlobalDerivedCellData();
-                    
                     // Get the pointer to pressure data inside the flow model.
                     boost::shared_ptr<pdat::CellData<double> > data_pressure =
                         d_flow_model->getGlobalCellData("PRESSURE");
@@ -1918,14 +1831,6 @@ GradientTagger::computeGradientSensorValuesOnPatch(
                             difference,
                             data_pressure);
                     }
-                    
-                    /*
-                     * Unregister the patch and data of all registered derived cell variables in
-                     * the flow model.
-                     */
-                    
-                    d_flow_model->unregisterPatch();
-                    
                 }
                 else
                 {
@@ -1938,7 +1843,13 @@ GradientTagger::computeGradientSensorValuesOnPatch(
                 }
             } // Loop over variables chosen.
         }
-    } // Loop over multiresolution sensors chosen.
+    } // Loop over gradient sensors chosen.
+    
+    /*
+     * Unregister the patch and data of all registered derived cell variables in the flow model.
+     */
+    
+    d_flow_model->unregisterPatch();
 }
 
 
@@ -1952,9 +1863,33 @@ GradientTagger::getSensorValueStatistics(
     const int level_number,
     const boost::shared_ptr<hier::VariableContext>& data_context)
 {
-    const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
+    std::vector<double*> statistics;
+    
+    getLocalSensorValueStatistics(
+        statistics,
+        patch_hierarchy,
+        level_number,
+        data_context);
     
-    math::HierarchyCellDataOpsReal<double> cell_double_operator(patch_hierarchy, level_number, level_number);
+    RefinementTaggerStatistics::reduceMaxStatistics(statistics);
+}
+
+
+/*
+ * Get the statistics of the sensor values that are required by the
+ * gradient sensors on the patches of a given patch level owned by the local
+ * process. Pointers to the statistics are collected so that they can be
+ * reduced together with those of the other taggers.
+ */
+void
+GradientTagger::getLocalSensorValueStatistics(
+    std::vector<double*>& statistics,
+    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+    const int level_number,
+    const boost::shared_ptr<hier::VariableContext>& data_context)
+{
+    boost::shared_ptr<hier::PatchLevel> level(
+        patch_hierarchy->getPatchLevel(level_number));
     
     hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
     
@@ -1980,15 +1915,10 @@ GradientTagger::getSensorValueStatistics(
                             d_difference_first_order_density,
                             data_context);
                         
-                        double w_max_rho_local = cell_double_operator.max(w_rho_id);
-                        d_difference_first_order_max_density = 0.0;
+                        d_difference_first_order_max_density =
+                            RefinementTaggerStatistics::getMaxOnLocalPatches(level, w_rho_id);
                         
-                        mpi.Allreduce(
-                            &w_max_rho_local,
-                            &d_difference_first_order_max_density,
-                            1,
-                            MPI_DOUBLE,
-                            MPI_MAX);
+                        statistics.push_back(&d_difference_first_order_max_density);
                     }
                     else if (variable_key == "TOTAL_ENERGY")
                     {
@@ -1996,15 +1926,10 @@ GradientTagger::getSensorValueStatistics(
                             d_difference_first_order_total_energy,
                             data_context);
                         
-                        double w_max_E_local = cell_double_operator.max(w_E_id);
-                        d_difference_first_order_max_total_energy = 0.0;
+                        d_difference_first_order_max_total_energy =
+                            RefinementTaggerStatistics::getMaxOnLocalPatches(level, w_E_id);
                         
-                        mpi.Allreduce(
-                            &w_max_E_local,
-                            &d_difference_first_order_max_total_energy,
-                            1,
-                            MPI_DOUBLE,
-                            MPI_MAX);
+                        statistics.push_back(&d_difference_first_order_max_total_energy);
                     }
                     else if (variable_key == "PRESSURE")
                     {
@@ -2012,15 +1937,10 @@ GradientTagger::getSensorValueStatistics(
                             d_difference_first_order_pressure,
                             data_context);
                         
-                        double w_max_p_local = cell_double_operator.max(w_p_id);
-                        d_difference_first_order_max_pressure = 0.0;
+                        d_difference_first_order_max_pressure =
+                            RefinementTaggerStatistics::getMaxOnLocalPatches(level, w_p_id);
                         
-                        mpi.Allreduce(
-                            &w_max_p_local,
-                            &d_difference_first_order_max_pressure,
-                            1,
-                            MPI_DOUBLE,
-                            MPI_MAX);
+                        statistics.push_back(&d_difference_first_order_max_pressure);
                     }
                 }
             }
@@ -2043,15 +1963,10 @@ GradientTagger::getSensorValueStatistics(
                             d_difference_second_order_density,
                             data_context);
                         
-                        double w_max_rho_local = cell_double_operator.max(w_rho_id);
-                        d_difference_second_order_max_density = 0.0;
+                        d_difference_second_order_max_density =
+                            RefinementTaggerStatistics::getMaxOnLocalPatches(level, w_rho_id);
                         
-                        mpi.Allreduce(
-                            &w_max_rho_local,
-                            &d_difference_second_order_max_density,
-                            1,
-                            MPI_DOUBLE,
-                            MPI_MAX);
+                        statistics.push_back(&d_difference_second_order_max_density);
                     }
                     else if (variable_key == "TOTAL_ENERGY")
                     {
@@ -2059,15 +1974,10 @@ GradientTagger::getSensorValueStatistics(
                             d_difference_second_order_total_energy,
                             data_context);
                         
-                        double w_max_E_local = cell_double_operator.max(w_E_id);
-                        d_difference_second_order_max_total_energy = 0.0;
+                        d_difference_second_order_max_total_energy =
+                            RefinementTaggerStatistics::getMaxOnLocalPatches(level, w_E_id);
                         
-                        mpi.Allreduce(
-                            &w_max_E_local,
-                            &d_difference_second_order_max_total_energy,
-                            1,
-                            MPI_DOUBLE,
-                            MPI_MAX);
+                        statistics.push_back(&d_difference_second_order_max_total_energy);
                     }
                     else if (variable_key == "PRESSURE")
                     {
@@ -2075,15 +1985,10 @@ GradientTagger::getSensorValueStatistics(
                             d_difference_second_order_pressure,
                             data_context);
                         
-                        double w_max_p_local = cell_double_operator.max(w_p_id);
-                        d_difference_second_order_max_pressure = 0.0;
+                        d_difference_second_order_max_pressure =
+                            RefinementTaggerStatistics::getMaxOnLocalPatches(level, w_p_id);
                         
-                        mpi.Allreduce(
-                            &w_max_p_local,
-                            &d_difference_second_order_max_pressure,
-                            1,
-                            MPI_DOUBLE,
-                            MPI_MAX);
+                        statistics.push_back(&d_difference_second_order_max_pressure);
                     }
                 }
             }
@@ -2384,6 +2289,33 @@ GradientTagger::tagCellsOnPatch(
         }
         else if (sensor_key == "JAMESON_GRADIENT")
         {
+            /*
+             * Register the patch and all the variables chosen in the flow model at once and
+             * compute the corresponding cell data.
+             */
+            
+            d_flow_model->registerPatchWithDataContext(patch, data_context);
+            
+            std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
+            
+            for (int vi = 0;
+                 vi < static_cast<int>(d_Jameson_gradient_variables.size());
+                 vi++)
+            {
+                num_subghosts_of_data.insert(
+                    std::pair<std::string, hier::IntVector>(
+                        d_Jameson_gradient_variables[vi],
+                        d_num_gradient_ghosts));
+            }
+            
+            d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
+            
+            d_flow_model->computeGlobalDerivedCellData();
+            
+            // Get the cell data of the variables and their gradients.
+            std::vector<boost::shared_ptr<pdat::CellData<double> > > variables_data;
+            std::vector<boost::shared_ptr<pdat::CellData<double> > > gradients;
+            
             // Loop over variables chosen.
             for (int vi = 0;
                  vi < static_cast<int>(d_Jameson_gradient_variables.size());
@@ -2392,161 +2324,19 @@ GradientTagger::tagCellsOnPatch(
                 // Get the key of the current variable.
                 std::string variable_key = d_Jameson_gradient_variables[vi];
                 
-                // Ge the tolerance for the current variable.
-                double tol = d_Jameson_gradient_tol[vi];
+                boost::shared_ptr<pdat::CellVariable<double> > gradient_variable;
                 
                 if (variable_key == "DENSITY")
                 {
-                    /*
-                     * Register the patch and density in the flow model and compute the
-                     * corresponding cell data.
-                     */
-                    
-                    d_flow_model->registerPatchWithDataContext(patch, data_context);
-                    
-                    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
-                    
-                    num_subghosts_of_data.insert(
-                        std::pair<std::string, hier::IntVector>("DENSITY", d_num_gradient_ghosts));
-                    
-                    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
-                    
-                    d_flow_model->computeGlobalDerivedCellData();
-                    
-                    /*
-                     * Get the pointer to density data inside the flow model.
-                     */
-                    
-                    boost::shared_ptr<pdat::CellData<double> > data_density =
-                        d_flow_model->getGlobalCellData("DENSITY");
-                    
-                    // Get the cell data of the density gradient.
-                    boost::shared_ptr<pdat::CellData<double> > gradient(
-                        BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
-                            patch.getPatchData(
-                                d_Jameson_gradient_density,
-                                data_context)));
-                    
-                    // Compute the gradient.
-                    d_gradient_sensor_Jameson->computeGradient(gradient, data_density, patch);
-                    
-                    // Tag the cells.
-                    tagCellsOnPatchWithGradientSensor(
-                        patch,
-                        tags,
-                        gradient,
-                        sensor_key,
-                        tol);
-                    
-                    /*
-                     * Unregister the patch and data of all registered derived cell variables in
-                     * the flow model.
-                     */
-                    
-                    d_flow_model->unregisterPatch();
-                    
+                    gradient_variable = d_Jameson_gradient_density;
                 }
                 else if (variable_key == "TOTAL_ENERGY")
                 {
-                    /*
-                     * Register the patch and total energy in the flow model and compute the
-                     * corresponding cell data.
-                     */
-                    
-                    d_flow_model->registerPatchWithDataContext(patch, data_context);
-                    
-                    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
-                    
-                    num_subghosts_of_data.insert(
-                        std::pair<std::string, hier::IntVector>("TOTAL_ENERGY", d_num_gradient_ghosts));
-                    
-                    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
-                    
-                    d_flow_model->computeGlobalDerivedCellData();
-                    
-                    /*
-                     * Get the pointer to total energy data inside the flow model.
-                     */
-                    
-                    boost::shared_ptr<pdat::CellData<double> > data_total_energy =
-                        d_flow_model->getGlobalCellData("TOTAL_ENERGY");
-                    
-                    // Get the cell data of the total energy gradient.
-                    boost::shared_ptr<pdat::CellData<double> > gradient(
-                        BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
-                            patch.getPatchData(
-                                d_Jameson_gradient_total_energy,
-                                data_context)));
-                    
-                    // Compute the gradient.
-                    d_gradient_sensor_Jameson->computeGradient(gradient, data_total_energy, patch);
-                    
-                    // Tag the cells.
-                    tagCellsOnPatchWithGradientSensor(
-                        patch,
-                        tags,
-                        gradient,
-                        sensor_key,
-                        tol);
-                    
-                    /*
-                     * Unregister the patch and data of all registered derived cell variables in
-                     * the flow model.
-                     */
-                    
-                    d_flow_model->unregisterPatch();
-                    
+                    gradient_variable = d_Jameson_gradient_total_energy;
                 }
                 else if (variable_key == "PRESSURE")
                 {
-                    /*
-                     * Register the patch and pressure in the flow model and compute the
-                     * corresponding cell data.
-                     */
-                    
-                    d_flow_model->registerPatchWithDataContext(patch, data_context);
-                    
-                    std::unordered_map<std::string, hier::IntVector> num_subghosts_of_data;
-                    
-                    num_subghosts_of_data.insert(
-                        std::pair<std::string, hier::IntVector>("PRESSURE", d_num_gradient_ghosts));
-                    
-                    d_flow_model->registerDerivedCellVariable(num_subghosts_of_data);
-                    
-                    d_flow_model->computeGlobalDerivedCellData();
-                    
-                    /*
-                     * Get the pointer to pressure data inside the flow model.
-                     */
-                    
-                    boost::shared_ptr<pdat::CellData<double> > data_pressure =
-                        d_flow_model->getGlobalCellData("PRESSURE");
-                    
-                    // Get the cell data of the pressure gradient.
-                    boost::shared_ptr<pdat::CellData<double> > gradient(
-                        BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
-                            patch.getPatchData(
-                                d_Jameson_gradient_pressure,
-                                data_context)));
-                    
-                    // Compute the gradient.
-                    d_gradient_sensor_Jameson->computeGradient(gradient, data_pressure, patch);
-                    
-                    // Tag the cells.
-                    tagCellsOnPatchWithGradientSensor(
-                        patch,
-                        tags,
-                        gradient,
-                        sensor_key,
-                        tol);
-                    
-                    /*
-                     * Unregister the patch and data of all registered derived cell variables in
-                     * the flow model.
-                     */
-                    
-                    d_flow_model->unregisterPatch();
-                    
+                    gradient_variable = d_Jameson_gradient_pressure;
                 }
                 else
                 {
@@ -2557,41 +2347,81 @@ GradientTagger::tagCellsOnPatch(
                         << "\nin input."
                         << std::endl);
                 }
-            } // Loop over variables chosen.
+                
+                variables_data.push_back(d_flow_model->getGlobalCellData(variable_key));
+                
+                gradients.push_back(
+                    BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                        patch.getPatchData(
+                            gradient_variable,
+                            data_context)));
+            }
+            
+            // Compute the gradients of all the variables in a single sweep.
+            d_gradient_sensor_Jameson->computeGradients(gradients, variables_data, patch);
+            
+            // Tag the cells.
+            tagCellsOnPatchWithGradientSensor(
+                patch,
+                tags,
+                gradients,
+                sensor_key,
+                d_Jameson_gradient_tol);
+            
+            /*
+             * Unregister the patch and data of all registered derived cell variables in the flow
+             * model.
+             */
+            
+            d_flow_model->unregisterPatch();
         }
     } // Loop over gradient sensors chosen.
 }
 
 
 /*
- * Tag cells on a patch using value of gradient sensor.
+ * Tag cells on a patch using values of gradient sensor of multiple variables. A cell is tagged
+ * when the sensor value of any of the variables is greater than the corresponding tolerance.
  */
 void
 GradientTagger::tagCellsOnPatchWithGradientSensor(
     hier::Patch& patch,
     const boost::shared_ptr<pdat::CellData<int> >& tags,
-    const boost::shared_ptr<pdat::CellData<double> >& gradient,
+    const std::vector<boost::shared_ptr<pdat::CellData<double> > >& gradients,
     const std::string& sensor_key,
-    const double tol)
+    const std::vector<double>& tols)
 {
 #ifdef HAMERS_DEBUG_CHECK_ASSERTIONS
     TBOX_ASSERT(tags->getGhostCellWidth() == hier::IntVector::getZero(d_dim));
+    TBOX_ASSERT(gradients.size() == tols.size());
 #endif
     
+    const int num_fields = static_cast<int>(gradients.size());
+    
+    if (num_fields == 0)
+    {
+        return;
+    }
+    
     // Get the dimensions of box that covers the interior of patch.
     const hier::Box interior_box = patch.getBox();
     const hier::IntVector interior_dims = interior_box.numberCells();
     
     // Get the number of ghost cells and dimensions of box that covers interior of patch plus
     // ghost cells.
-    const hier::IntVector num_ghosts_gradient_tagger = gradient->getGhostCellWidth();
-    const hier::IntVector ghostcell_dims_gradient_tagger = gradient->getGhostBox().numberCells();
+    const hier::IntVector num_ghosts_gradient_tagger = gradients[0]->getGhostCellWidth();
+    const hier::IntVector ghostcell_dims_gradient_tagger = gradients[0]->getGhostBox().numberCells();
     
     // Get the pointer of the tags.
     int* tag_ptr  = tags->getPointer(0);
     
-    // Get the pointer to the data.
-    double* psi = gradient->getPointer(0);
+    // Get the pointers to the data.
+    std::vector<double*> psi;
+    psi.reserve(num_fields);
+    for (int vi = 0; vi < num_fields; vi++)
+    {
+        psi.push_back(gradients[vi]->getPointer(0));
+    }
     
     if (sensor_key == "JAMESON_GRADIENT")
     {
@@ -2601,18 +2431,21 @@ GradientTagger::tagCellsOnPatchWithGradientSensor(
             
             const int num_ghosts_0_gradient_tagger = num_ghosts_gradient_tagger[0];
             
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = 0; i < interior_dim_0; i++)
+            for (int vi = 0; vi < num_fields; vi++)
             {
-                // Compute indices.
-                const int idx = i + num_ghosts_0_gradient_tagger;
-                const int idx_nghost = i;
+                const double* const psi_v = psi[vi];
+                const double tol = tols[vi];
                 
-                if (psi[idx] > tol)
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd
+#endif
+                for (int i = 0; i < interior_dim_0; i++)
                 {
-                    tag_ptr[idx_nghost] |= 1;
+                    // Compute indices.
+                    const int idx = i + num_ghosts_0_gradient_tagger;
+                    const int idx_nghost = i;
+                    
+                    tag_ptr[idx_nghost] |= (psi_v[idx] > tol);
                 }
             }
         }
@@ -2627,21 +2460,24 @@ GradientTagger::tagCellsOnPatchWithGradientSensor(
             
             for (int j = 0; j < interior_dim_1; j++)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
+                for (int vi = 0; vi < num_fields; vi++)
                 {
-                    // Compute indices.
-                    const int idx = (i + num_ghosts_0_gradient_tagger) +
-                        (j + num_ghosts_1_gradient_tagger)*ghostcell_dim_0_gradient_tagger;
-                    
-                    const int idx_nghost = i +
-                        j*interior_dim_0;
+                    const double* const psi_v = psi[vi];
+                    const double tol = tols[vi];
                     
-                    if (psi[idx] > tol)
+#ifdef HAMERS_ENABLE_SIMD
+                    #pragma omp simd
+#endif
+                    for (int i = 0; i < interior_dim_0; i++)
                     {
-                        tag_ptr[idx_nghost] |= 1;
+                        // Compute indices.
+                        const int idx = (i + num_ghosts_0_gradient_tagger) +
+                            (j + num_ghosts_1_gradient_tagger)*ghostcell_dim_0_gradient_tagger;
+                        
+                        const int idx_nghost = i +
+                            j*interior_dim_0;
+                        
+                        tag_ptr[idx_nghost] |= (psi_v[idx] > tol);
                     }
                 }
             }
@@ -2662,24 +2498,27 @@ GradientTagger::tagCellsOnPatchWithGradientSensor(
             {
                 for (int j = 0; j < interior_dim_1; j++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
+                    for (int vi = 0; vi < num_fields; vi++)
                     {
-                        // Compute indices.
-                        const int idx = (i + num_ghosts_0_gradient_tagger) +
-                            (j + num_ghosts_1_gradient_tagger)*ghostcell_dim_0_gradient_tagger +
-                            (k + num_ghosts_2_gradient_tagger)*ghostcell_dim_0_gradient_tagger*
-                                ghostcell_dim_1_gradient_tagger;
+                        const double* const psi_v = psi[vi];
+                        const double tol = tols[vi];
                         
-                        const int idx_nghost = i +
-                            j*interior_dim_0 +
-                            k*interior_dim_0*interior_dim_1;
-                        
-                        if (psi[idx] > tol)
+#ifdef HAMERS_ENABLE_SIMD
+                        #pragma omp simd
+#endif
+                        for (int i = 0; i < interior_dim_0; i++)
                         {
-                            tag_ptr[idx_nghost] |= 1;
+                            // Compute indices.
+                            const int idx = (i + num_ghosts_0_gradient_tagger) +
+                                (j + num_ghosts_1_gradient_tagger)*ghostcell_dim_0_gradient_tagger +
+                                (k + num_ghosts_2_gradient_tagger)*ghostcell_dim_0_gradient_tagger*
+                                    ghostcell_dim_1_gradient_tagger;
+                            
+                            const int idx_nghost = i +
+                                j*interior_dim_0 +
+                                k*interior_dim_0*interior_dim_1;
+                            
+                            tag_ptr[idx_nghost] |= (psi_v[idx] > tol);
                         }
                     }
                 }
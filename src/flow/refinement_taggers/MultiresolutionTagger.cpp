@@ -1,4 +1,5 @@
 #include "flow/refinement_taggers/MultiresolutionTagger.hpp"
+#include "flow/refinement_taggers/RefinementTaggerStatistics.hpp"
 
 #include <algorithm>
 #include "boost/lexical_cast.hpp"
@@ -612,6 +613,20 @@ MultiresolutionTagger::registerMultiresolutionTaggerVariables(
                 }
             }
             
+            /*
+             * The wavelet coefficients and Lipschitz's exponents are only required during the
+             * tagging. They are kept as time-dependent data only when they are plotted. Otherwise,
+             * they are registered as temporary data that only lives in the scratch context.
+             */
+            
+#ifdef HAMERS_PLOTTING_MULTIRESOLUTION_TAGGER
+            const RungeKuttaLevelIntegrator::RK_VAR_TYPE sensor_var_type =
+                RungeKuttaLevelIntegrator::TIME_DEP;
+#else
+            const RungeKuttaLevelIntegrator::RK_VAR_TYPE sensor_var_type =
+                RungeKuttaLevelIntegrator::TEMPORARY;
+#endif
+            
             for (int vi = 0; vi < static_cast<int>(d_Harten_wavelet_variables.size()); vi++)
             {
                 // Get the key of the current variable.
@@ -625,7 +640,7 @@ MultiresolutionTagger::registerMultiresolutionTaggerVariables(
                             d_Harten_wavelet_coeffs_density[li],
                             d_num_multiresolution_ghosts,
                             d_num_multiresolution_ghosts,
-                            RungeKuttaLevelIntegrator::TIME_DEP,
+                            sensor_var_type,
                                 d_grid_geometry,
                                 "NO_COARSEN",
                                 "NO_REFINE");
@@ -649,7 +664,7 @@ MultiresolutionTagger::registerMultiresolutionTaggerVariables(
                             d_Harten_Lipschitz_exponent_density,
                             d_num_multiresolution_ghosts,
                             d_num_multiresolution_ghosts,
-                            RungeKuttaLevelIntegrator::TIME_DEP,
+                            sensor_var_type,
                                 d_grid_geometry,
                                 "NO_COARSEN",
                                 "NO_REFINE");
@@ -663,7 +678,7 @@ MultiresolutionTagger::registerMultiresolutionTaggerVariables(
                             d_Harten_wavelet_coeffs_total_energy[li],
                             d_num_multiresolution_ghosts,
                             d_num_multiresolution_ghosts,
-                            RungeKuttaLevelIntegrator::TIME_DEP,
+                            sensor_var_type,
                             d_grid_geometry,
                             "NO_COARSEN",
                             "NO_REFINE");
@@ -687,7 +702,7 @@ MultiresolutionTagger::registerMultiresolutionTaggerVariables(
                             d_Harten_Lipschitz_exponent_total_energy,
                             d_num_multiresolution_ghosts,
                             d_num_multiresolution_ghosts,
-                            RungeKuttaLevelIntegrator::TIME_DEP,
+                            sensor_var_type,
                                 d_grid_geometry,
                                 "NO_COARSEN",
                                 "NO_REFINE");
@@ -701,7 +716,7 @@ MultiresolutionTagger::registerMultiresolutionTaggerVariables(
                             d_Harten_wavelet_coeffs_pressure[li],
                             d_num_multiresolution_ghosts,
                             d_num_multiresolution_ghosts,
-                            RungeKuttaLevelIntegrator::TIME_DEP,
+                            sensor_var_type,
                             d_grid_geometry,
                             "NO_COARSEN",
                             "NO_REFINE");
@@ -725,7 +740,7 @@ MultiresolutionTagger::registerMultiresolutionTaggerVariables(
                             d_Harten_Lipschitz_exponent_pressure,
                             d_num_multiresolution_ghosts,
                             d_num_multiresolution_ghosts,
-                            RungeKuttaLevelIntegrator::TIME_DEP,
+                            sensor_var_type,
                                 d_grid_geometry,
                                 "NO_COARSEN",
                                 "NO_REFINE");
@@ -1282,9 +1297,33 @@ MultiresolutionTagger::getSensorValueStatistics(
     const int level_number,
     const boost::shared_ptr<hier::VariableContext>& data_context)
 {
-    const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
+    std::vector<double*> statistics;
     
-    math::HierarchyCellDataOpsReal<double> cell_double_operator(patch_hierarchy, level_number, level_number);
+    getLocalSensorValueStatistics(
+        statistics,
+        patch_hierarchy,
+        level_number,
+        data_context);
+    
+    RefinementTaggerStatistics::reduceMaxStatistics(statistics);
+}
+
+
+/*
+ * Get the statistics of the sensor values that are required by the
+ * multiresolution sensors on the patches of a given patch level owned by the
+ * local process. Pointers to the statistics are collected so that they can be
+ * reduced together with those of the other taggers.
+ */
+void
+MultiresolutionTagger::getLocalSensorValueStatistics(
+    std::vector<double*>& statistics,
+    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+    const int level_number,
+    const boost::shared_ptr<hier::VariableContext>& data_context)
+{
+    boost::shared_ptr<hier::PatchLevel> level(
+        patch_hierarchy->getPatchLevel(level_number));
     
     hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
     
@@ -1310,15 +1349,10 @@ MultiresolutionTagger::getSensorValueStatistics(
                                 d_Harten_wavelet_coeffs_density[li],
                                 data_context);
                             
-                            double w_max_rho_local = cell_double_operator.max(w_rho_id);
-                            d_Harten_wavelet_coeffs_maxs_density[li] = 0.0;
+                            d_Harten_wavelet_coeffs_maxs_density[li] =
+                                RefinementTaggerStatistics::getMaxOnLocalPatches(level, w_rho_id);
                             
-                            mpi.Allreduce(
-                                &w_max_rho_local,
-                                &d_Harten_wavelet_coeffs_maxs_density[li],
-                                1,
-                                MPI_DOUBLE,
-                                MPI_MAX);
+                            statistics.push_back(&d_Harten_wavelet_coeffs_maxs_density[li]);
                         }
                     }
                     else if (variable_key == "TOTAL_ENERGY")
@@ -1329,15 +1363,10 @@ MultiresolutionTagger::getSensorValueStatistics(
                                 d_Harten_wavelet_coeffs_total_energy[li],
                                 data_context);
                             
-                            double w_E_max_local = cell_double_operator.max(w_E_id);
-                            d_Harten_wavelet_coeffs_maxs_total_energy[li] = 0.0;
+                            d_Harten_wavelet_coeffs_maxs_total_energy[li] =
+                                RefinementTaggerStatistics::getMaxOnLocalPatches(level, w_E_id);
                             
-                            mpi.Allreduce(
-                                &w_E_max_local,
-                                &d_Harten_wavelet_coeffs_maxs_total_energy[li],
-                                1,
-                                MPI_DOUBLE,
-                                MPI_MAX);
+                            statistics.push_back(&d_Harten_wavelet_coeffs_maxs_total_energy[li]);
                         }
                     }
                     else if (variable_key == "PRESSURE")
@@ -1348,15 +1377,10 @@ MultiresolutionTagger::getSensorValueStatistics(
                                 d_Harten_wavelet_coeffs_pressure[li],
                                 data_context);
                             
-                            double w_p_max_local = cell_double_operator.max(w_p_id);
-                            d_Harten_wavelet_coeffs_maxs_pressure[li] = 0.0;
+                            d_Harten_wavelet_coeffs_maxs_pressure[li] =
+                                RefinementTaggerStatistics::getMaxOnLocalPatches(level, w_p_id);
                             
-                            mpi.Allreduce(
-                                &w_p_max_local,
-                                &d_Harten_wavelet_coeffs_maxs_pressure[li],
-                                1,
-                                MPI_DOUBLE,
-                                MPI_MAX);
+                            statistics.push_back(&d_Harten_wavelet_coeffs_maxs_pressure[li]);
                         }
                     }
                 }
@@ -2170,14 +2194,7 @@ MultiresolutionTagger::tagCellsOnPatchWithWaveletSensor(
     const hier::IntVector num_ghosts_wavelet_coeffs = wavelet_coeffs[0]->getGhostCellWidth();
     const hier::IntVector ghostcell_dims_wavelet_coeffs = wavelet_coeffs[0]->getGhostBox().numberCells();
     
-    // Allocate temporary patch data.
-    boost::shared_ptr<pdat::CellData<int> > tags_multiresolution_tagger(
-        new pdat::CellData<int>(interior_box, d_dim.getValue(), hier::IntVector::getZero(d_dim)));
-    
-    tags_multiresolution_tagger->fillAll(1);
-    
-    // Get the pointers to the tags.
-    int* tag_ptr_multiresolution_tagger = tags_multiresolution_tagger->getPointer(0);
+    // Get the pointer to the tags.
     int* tag_ptr = tags->getPointer(0);
     
     // Get the pointers to the wavelet coefficients.
@@ -2211,125 +2228,64 @@ MultiresolutionTagger::tagCellsOnPatchWithWaveletSensor(
             sensor_key);
     }
     
+    // Compute the inverses of the global maximum wavelet coefficients at different levels.
+    std::vector<double> wavelet_coeffs_maxs_inv;
+    if (uses_global_tol)
+    {
+        for (int li = 0; li < d_Harten_wavelet_num_level; li++)
+        {
+            wavelet_coeffs_maxs_inv.push_back(double(1)/(wavelet_coeffs_maxs[li] + EPSILON));
+        }
+    }
+    
+    /*
+     * Evaluate all the criteria at all levels in a single pass over the cells and write the result
+     * straight into the tags. A cell is tagged by the sensor only when all the chosen criteria are
+     * satisfied.
+     */
+    
     if (d_dim == tbox::Dimension(1))
     {
         const int interior_dim_0 = interior_dims[0];
         
         const int num_ghosts_0_wavelet_coeffs = num_ghosts_wavelet_coeffs[0];
         
-        if (uses_global_tol)
+        for (int i = 0; i < interior_dim_0; i++)
         {
-            // Allocate temporary patch data.
-            boost::shared_ptr<pdat::CellData<int> > tags_global_tol(
-                new pdat::CellData<int>(interior_box, d_dim.getValue(), hier::IntVector::getZero(d_dim)));
-            
-            tags_global_tol->fillAll(0);
+            // Compute the linear indices.
+            const int idx = i + num_ghosts_0_wavelet_coeffs;
+            const int idx_nghost = i;
             
-            // Get the pointer to the tags.
-            int* tag_ptr_global_tol = tags_global_tol->getPointer(0);
+            int tag_multiresolution_tagger = 1;
             
-            for (int li = 0; li < d_Harten_wavelet_num_level; li++)
+            if (uses_global_tol)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
+                int tag_global_tol = 0;
+                for (int li = 0; li < d_Harten_wavelet_num_level; li++)
                 {
-                    // Compute the linear indices.
-                    const int idx = i + num_ghosts_0_wavelet_coeffs;
-                    const int idx_nghost = i;
-                    
-                    if (w[li][idx]/(wavelet_coeffs_maxs[li] + EPSILON) > global_tol)
-                    {
-                        tag_ptr_global_tol[idx_nghost] = 1;
-                    }
+                    tag_global_tol |= (w[li][idx]*wavelet_coeffs_maxs_inv[li] > global_tol);
                 }
-            }
-            
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = 0; i < interior_dim_0; i++)
-            {
-                // Compute the linear index.
-                const int idx_nghost = i;
                 
-                tag_ptr_multiresolution_tagger[idx_nghost] &= tag_ptr_global_tol[idx_nghost];
+                tag_multiresolution_tagger &= tag_global_tol;
             }
-        }
-        
-        if (uses_local_tol)
-        {
-            // Allocate temporary patch data.
-            boost::shared_ptr<pdat::CellData<int> > tags_local_tol(
-                new pdat::CellData<int>(interior_box, d_dim.getValue(), hier::IntVector::getZero(d_dim)));
-            
-            tags_local_tol->fillAll(0);
-            
-            // Get the pointer to the tags.
-            int* tag_ptr_local_tol = tags_local_tol->getPointer(0);
             
-            for (int li = 0; li < d_Harten_wavelet_num_level; li++)
+            if (uses_local_tol)
             {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
+                int tag_local_tol = 0;
+                for (int li = 0; li < d_Harten_wavelet_num_level; li++)
                 {
-                    // Compute the linear indices.
-                    const int idx = i + num_ghosts_0_wavelet_coeffs;
-                    const int idx_nghost = i;
-                    
-                    if (w[li][idx]/(u_mean[li][idx] + EPSILON) > local_tol)
-                    {
-                        tag_ptr_local_tol[idx_nghost] = 1;
-                    }
+                    tag_local_tol |= (w[li][idx]/(u_mean[li][idx] + EPSILON) > local_tol);
                 }
-            }
-            
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = 0; i < interior_dim_0; i++)
-            {
-                // Compute the linear index.
-                const int idx_nghost = i;
                 
-                tag_ptr_multiresolution_tagger[idx_nghost] &= tag_ptr_local_tol[idx_nghost];
+                tag_multiresolution_tagger &= tag_local_tol;
             }
-        }
-        
-        if (uses_alpha_tol)
-        {
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = 0; i < interior_dim_0; i++)
+            
+            if (uses_alpha_tol)
             {
-                // Compute the linear indices.
-                const int idx = i + num_ghosts_0_wavelet_coeffs;
-                const int idx_nghost = i;
-                
-                if (alpha[idx] < alpha_tol)
-                {
-                    tag_ptr_multiresolution_tagger[idx_nghost] &= 1;
-                }
-                else
-                {
-                    tag_ptr_multiresolution_tagger[idx_nghost] &= 0;
-                }
+                tag_multiresolution_tagger &= (alpha[idx] < alpha_tol);
             }
-        }
-        
-#ifdef HAMERS_ENABLE_SIMD
-        #pragma omp simd
-#endif
-        for (int i = 0; i < interior_dim_0; i++)
-        {
-            // Compute the linear index.
-            const int idx_nghost = i;
             
-            tag_ptr[idx_nghost] |= tag_ptr_multiresolution_tagger[idx_nghost];
+            tag_ptr[idx_nghost] |= tag_multiresolution_tagger;
         }
     }
     else if (d_dim == tbox::Dimension(2))
@@ -2341,142 +2297,46 @@ MultiresolutionTagger::tagCellsOnPatchWithWaveletSensor(
         const int num_ghosts_1_wavelet_coeffs = num_ghosts_wavelet_coeffs[1];
         const int ghostcell_dim_0_wavelet_coeffs = ghostcell_dims_wavelet_coeffs[0];
         
-        if (uses_global_tol)
+        for (int j = 0; j < interior_dim_1; j++)
         {
-            // Allocate temporary patch data.
-            boost::shared_ptr<pdat::CellData<int> > tags_global_tol(
-                new pdat::CellData<int>(interior_box, d_dim.getValue(), hier::IntVector::getZero(d_dim)));
-            
-            tags_global_tol->fillAll(0);
-            
-            // Get the pointer to the tags.
-            int* tag_ptr_global_tol = tags_global_tol->getPointer(0);
-            
-            for (int li = 0; li < d_Harten_wavelet_num_level; li++)
+            for (int i = 0; i < interior_dim_0; i++)
             {
-                for (int j = 0; j < interior_dim_1; j++)
+                // Compute the linear indices.
+                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
+                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
+                
+                const int idx_nghost = i + j*interior_dim_0;
+                
+                int tag_multiresolution_tagger = 1;
+                
+                if (uses_global_tol)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
+                    int tag_global_tol = 0;
+                    for (int li = 0; li < d_Harten_wavelet_num_level; li++)
                     {
-                        // Compute the linear indices.
-                        const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                            (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                        
-                        const int idx_nghost = i + j*interior_dim_0;
-                        
-                        if (w[li][idx]/(wavelet_coeffs_maxs[li] + EPSILON) > global_tol)
-                        {
-                            tag_ptr_global_tol[idx_nghost] = 1;
-                        }
+                        tag_global_tol |= (w[li][idx]*wavelet_coeffs_maxs_inv[li] > global_tol);
                     }
-                }
-            }
-            
-            for (int j = 0; j < interior_dim_1; j++)
-            {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index.
-                    const int idx_nghost = i + j*interior_dim_0;
                     
-                    tag_ptr_multiresolution_tagger[idx_nghost] &= tag_ptr_global_tol[idx_nghost];
+                    tag_multiresolution_tagger &= tag_global_tol;
                 }
-            }
-        }
-        
-        if (uses_local_tol)
-        {
-            // Allocate temporary patch data.
-            boost::shared_ptr<pdat::CellData<int> > tags_local_tol(
-                new pdat::CellData<int>(interior_box, d_dim.getValue(), hier::IntVector::getZero(d_dim)));
-            
-            tags_local_tol->fillAll(0);
-            
-            // Get the pointer to the tags.
-            int* tag_ptr_local_tol = tags_local_tol->getPointer(0);
-            
-            for (int li = 0; li < d_Harten_wavelet_num_level; li++)
-            {
-                for (int j = 0; j < interior_dim_1; j++)
+                
+                if (uses_local_tol)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
+                    int tag_local_tol = 0;
+                    for (int li = 0; li < d_Harten_wavelet_num_level; li++)
                     {
-                        // Compute the linear indices.
-                        const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                            (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                        
-                        const int idx_nghost = i + j*interior_dim_0;
-                        
-                        if (w[li][idx]/(u_mean[li][idx] + EPSILON) > local_tol)
-                        {
-                            tag_ptr_local_tol[idx_nghost] = 1;
-                        }
+                        tag_local_tol |= (w[li][idx]/(u_mean[li][idx] + EPSILON) > local_tol);
                     }
-                }
-            }
-            
-            for (int j = 0; j < interior_dim_1; j++)
-            {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index.
-                    const int idx_nghost = i + j*interior_dim_0;
                     
-                    tag_ptr_multiresolution_tagger[idx_nghost] &= tag_ptr_local_tol[idx_nghost];
+                    tag_multiresolution_tagger &= tag_local_tol;
                 }
-            }
-        }
-        
-        if (uses_alpha_tol)
-        {
-            for (int j = 0; j < interior_dim_1; j++)
-            {
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
+                
+                if (uses_alpha_tol)
                 {
-                    // Compute the linear indices.
-                    const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                    
-                    const int idx_nghost = i + j*interior_dim_0;
-                    
-                    if (alpha[idx] < alpha_tol)
-                    {
-                        tag_ptr_multiresolution_tagger[idx_nghost] &= 1;
-                    }
-                    else
-                    {
-                        tag_ptr_multiresolution_tagger[idx_nghost] &= 0;
-                    }
+                    tag_multiresolution_tagger &= (alpha[idx] < alpha_tol);
                 }
-            }
-        }
-        
-        for (int j = 0; j < interior_dim_1; j++)
-        {
-#ifdef HAMERS_ENABLE_SIMD
-            #pragma omp simd
-#endif
-            for (int i = 0; i < interior_dim_0; i++)
-            {
-                // Compute the linear index.
-                const int idx_nghost = i + j*interior_dim_0;
                 
-                tag_ptr[idx_nghost] |= tag_ptr_multiresolution_tagger[idx_nghost];
+                tag_ptr[idx_nghost] |= tag_multiresolution_tagger;
             }
         }
     }
@@ -2492,165 +2352,50 @@ MultiresolutionTagger::tagCellsOnPatchWithWaveletSensor(
         const int ghostcell_dim_0_wavelet_coeffs = ghostcell_dims_wavelet_coeffs[0];
         const int ghostcell_dim_1_wavelet_coeffs = ghostcell_dims_wavelet_coeffs[1];
         
-        if (uses_global_tol)
+        for (int k = 0; k < interior_dim_2; k++)
         {
-            // Allocate temporary patch data.
-            boost::shared_ptr<pdat::CellData<int> > tags_global_tol(
-                new pdat::CellData<int>(interior_box, d_dim.getValue(), hier::IntVector::getZero(d_dim)));
-            
-            tags_global_tol->fillAll(0);
-            
-            // Get the pointer to the tags.
-            int* tag_ptr_global_tol = tags_global_tol->getPointer(0);
-            
-            for (int li = 0; li < d_Harten_wavelet_num_level; li++)
+            for (int j = 0; j < interior_dim_1; j++)
             {
-                for (int k = 0; k < interior_dim_2; k++)
+                for (int i = 0; i < interior_dim_0; i++)
                 {
-                    for (int j = 0; j < interior_dim_1; j++)
+                    // Compute the linear indices.
+                    const int idx = (i + num_ghosts_0_wavelet_coeffs) +
+                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
+                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
+                            ghostcell_dim_1_wavelet_coeffs;
+                    
+                    const int idx_nghost = i + j*interior_dim_0 + k*interior_dim_0*interior_dim_1;
+                    
+                    int tag_multiresolution_tagger = 1;
+                    
+                    if (uses_global_tol)
                     {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = 0; i < interior_dim_0; i++)
+                        int tag_global_tol = 0;
+                        for (int li = 0; li < d_Harten_wavelet_num_level; li++)
                         {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                    ghostcell_dim_1_wavelet_coeffs;
-                            
-                            const int idx_nghost = i + j*interior_dim_0 + k*interior_dim_0*interior_dim_1;
-                            
-                            if (w[li][idx]/(wavelet_coeffs_maxs[li] + EPSILON) > global_tol)
-                            {
-                                tag_ptr_global_tol[idx_nghost] = 1;
-                            }
+                            tag_global_tol |= (w[li][idx]*wavelet_coeffs_maxs_inv[li] > global_tol);
                         }
-                    }
-                }
-            }
-            
-            for (int k = 0; k < interior_dim_2; k++)
-            {
-                for (int j = 0; j < interior_dim_1; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index.
-                        const int idx_nghost = i + j*interior_dim_0 + k*interior_dim_0*interior_dim_1;
                         
-                        tag_ptr_multiresolution_tagger[idx_nghost] &= tag_ptr_global_tol[idx_nghost];
+                        tag_multiresolution_tagger &= tag_global_tol;
                     }
-                }
-            }
-        }
-        
-        if (uses_local_tol)
-        {
-            // Allocate temporary patch data.
-            boost::shared_ptr<pdat::CellData<int> > tags_local_tol(
-                new pdat::CellData<int>(interior_box, d_dim.getValue(), hier::IntVector::getZero(d_dim)));
-            
-            tags_local_tol->fillAll(0);
-            
-            // Get the pointer to the tags.
-            int* tag_ptr_local_tol = tags_local_tol->getPointer(0);
-            
-            for (int li = 0; li < d_Harten_wavelet_num_level; li++)
-            {
-                for (int k = 0; k < interior_dim_2; k++)
-                {
-                    for (int j = 0; j < interior_dim_1; j++)
+                    
+                    if (uses_local_tol)
                     {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = 0; i < interior_dim_0; i++)
+                        int tag_local_tol = 0;
+                        for (int li = 0; li < d_Harten_wavelet_num_level; li++)
                         {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                    ghostcell_dim_1_wavelet_coeffs;
-                            
-                            const int idx_nghost = i + j*interior_dim_0 + k*interior_dim_0*interior_dim_1;
-                            
-                            if (w[li][idx]/(u_mean[li][idx] + EPSILON) > local_tol)
-                            {
-                                tag_ptr_local_tol[idx_nghost] = 1;
-                            }
+                            tag_local_tol |= (w[li][idx]/(u_mean[li][idx] + EPSILON) > local_tol);
                         }
-                    }
-                }
-            }
-            
-            for (int k = 0; k < interior_dim_2; k++)
-            {
-                for (int j = 0; j < interior_dim_1; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear index.
-                        const int idx_nghost = i + j*interior_dim_0 + k*interior_dim_0*interior_dim_1;
                         
-                        tag_ptr_multiresolution_tagger[idx_nghost] &= tag_ptr_local_tol[idx_nghost];
+                        tag_multiresolution_tagger &= tag_local_tol;
                     }
-                }
-            }
-        }
-        
-        if (uses_alpha_tol)
-        {
-            for (int k = 0; k < interior_dim_2; k++)
-            {
-                for (int j = 0; j < interior_dim_1; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
+                    
+                    if (uses_alpha_tol)
                     {
-                        // Compute the linear indices.
-                        const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                            (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                            (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                ghostcell_dim_1_wavelet_coeffs;
-                        
-                        const int idx_nghost = i + j*interior_dim_0 + k*interior_dim_0*interior_dim_1;
-                        
-                        if (alpha[idx] < alpha_tol)
-                        {
-                            tag_ptr_multiresolution_tagger[idx_nghost] &= 1;
-                        }
-                        else
-                        {
-                            tag_ptr_multiresolution_tagger[idx_nghost] &= 0;
-                        }
+                        tag_multiresolution_tagger &= (alpha[idx] < alpha_tol);
                     }
-                }
-            }
-        }
-        
-        for (int k = 0; k < interior_dim_2; k++)
-        {
-            for (int j = 0; j < interior_dim_1; j++)
-            {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = 0; i < interior_dim_0; i++)
-                {
-                    // Compute the linear index.
-                    const int idx_nghost = i + j*interior_dim_0 + k*interior_dim_0*interior_dim_1;
                     
-                    tag_ptr[idx_nghost] |= tag_ptr_multiresolution_tagger[idx_nghost];
+                    tag_ptr[idx_nghost] |= tag_multiresolution_tagger;
                 }
             }
         }
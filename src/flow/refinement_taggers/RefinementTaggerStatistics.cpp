@@ -0,0 +1,80 @@
+#include "flow/refinement_taggers/RefinementTaggerStatistics.hpp"
+
+#include "SAMRAI/math/PatchCellDataOpsReal.h"
+#include "SAMRAI/pdat/CellData.h"
+#include "SAMRAI/tbox/MathUtilities.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+
+/*
+ * Get the maximum of the interior values of the cell data on the patches of a level that are
+ * owned by the local process.
+ */
+double
+RefinementTaggerStatistics::getMaxOnLocalPatches(
+    const boost::shared_ptr<hier::PatchLevel>& level,
+    const int data_id)
+{
+    math::PatchCellDataOpsReal<double> patch_cell_double_operator;
+    
+    double max_local = -tbox::MathUtilities<double>::getMax();
+    
+    for (hier::PatchLevel::iterator ip(level->begin());
+         ip != level->end();
+         ip++)
+    {
+        const boost::shared_ptr<hier::Patch>& patch = *ip;
+        
+        boost::shared_ptr<pdat::CellData<double> > data(
+            BOOST_CAST<pdat::CellData<double>, hier::PatchData>(
+                patch->getPatchData(data_id)));
+
+#ifdef HAMERS_DEBUG_CHECK_ASSERTIONS
+        TBOX_ASSERT(data);
+#endif
+        
+        max_local = tbox::MathUtilities<double>::Max(
+            max_local,
+            patch_cell_double_operator.max(data, patch->getBox()));
+    }
+    
+    return max_local;
+}
+
+
+/*
+ * Replace the local statistics pointed to by the maxima over all processes with a single
+ * reduction.
+ */
+void
+RefinementTaggerStatistics::reduceMaxStatistics(
+    const std::vector<double*>& statistics)
+{
+    const int num_statistics = static_cast<int>(statistics.size());
+    
+    if (num_statistics == 0)
+    {
+        return;
+    }
+    
+    const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
+    
+    std::vector<double> statistics_local(num_statistics);
+    std::vector<double> statistics_global(num_statistics, 0.0);
+    
+    for (int i = 0; i < num_statistics; i++)
+    {
+        statistics_local[i] = *statistics[i];
+    }
+    
+    mpi.Allreduce(
+        statistics_local.data(),
+        statistics_global.data(),
+        num_statistics,
+        MPI_DOUBLE,
+        MPI_MAX);
+    
+    for (int i = 0; i < num_statistics; i++)
+    {
+        *statistics[i] = statistics_global[i];
+    }
+}
@@ -1,4 +1,5 @@
 #include "flow/refinement_taggers/ValueTagger.hpp"
+#include "flow/refinement_taggers/RefinementTaggerStatistics.hpp"
 
 #include <algorithm>
 #include "boost/lexical_cast.hpp"
@@ -1381,9 +1382,32 @@ ValueTagger::getValueStatistics(
     const int level_number,
     const boost::shared_ptr<hier::VariableContext>& data_context)
 {
-    const tbox::SAMRAI_MPI& mpi(tbox::SAMRAI_MPI::getSAMRAIWorld());
+    std::vector<double*> statistics;
     
-    math::HierarchyCellDataOpsReal<double> cell_double_operator(patch_hierarchy, level_number, level_number);
+    getLocalValueStatistics(
+        statistics,
+        patch_hierarchy,
+        level_number,
+        data_context);
+    
+    RefinementTaggerStatistics::reduceMaxStatistics(statistics);
+}
+
+
+/*
+ * Get the statistics of values that are required by the value tagger on the
+ * patches owned by the local process. Pointers to the statistics are collected
+ * so that they can be reduced together with those of the other taggers.
+ */
+void
+ValueTagger::getLocalValueStatistics(
+    std::vector<double*>& statistics,
+    const boost::shared_ptr<hier::PatchHierarchy>& patch_hierarchy,
+    const int level_number,
+    const boost::shared_ptr<hier::VariableContext>& data_context)
+{
+    boost::shared_ptr<hier::PatchLevel> level(
+        patch_hierarchy->getPatchLevel(level_number));
     
     hier::VariableDatabase* variable_db = hier::VariableDatabase::getDatabase();
     
@@ -1401,15 +1425,9 @@ ValueTagger::getValueStatistics(
                     d_value_tagger_variable_density,
                     data_context);
                 
-                double rho_max_local = cell_double_operator.max(rho_id);
-                d_value_tagger_max_density = 0.0;
+                d_value_tagger_max_density = RefinementTaggerStatistics::getMaxOnLocalPatches(level, rho_id);
                 
-                mpi.Allreduce(
-                    &rho_max_local,
-                    &d_value_tagger_max_density,
-                    1,
-                    MPI_DOUBLE,
-                    MPI_MAX);
+                statistics.push_back(&d_value_tagger_max_density);
             }
             else if (variable_key == "TOTAL_ENERGY")
             {
@@ -1417,15 +1435,10 @@ ValueTagger::getValueStatistics(
                     d_value_tagger_variable_total_energy,
                     data_context);
                 
-                double E_max_local = cell_double_operator.max(E_id);
-                d_value_tagger_max_total_energy = 0.0;
+                d_value_tagger_max_total_energy =
+                    RefinementTaggerStatistics::getMaxOnLocalPatches(level, E_id);
                 
-                mpi.Allreduce(
-                    &E_max_local,
-                    &d_value_tagger_max_total_energy,
-                    1,
-                    MPI_DOUBLE,
-                    MPI_MAX);
+                statistics.push_back(&d_value_tagger_max_total_energy);
             }
             else if (variable_key == "PRESSURE")
             {
@@ -1433,15 +1446,9 @@ ValueTagger::getValueStatistics(
                     d_value_tagger_variable_pressure,
                     data_context);
                 
-                double p_max_local = cell_double_operator.max(p_id);
-                d_value_tagger_max_pressure = 0.0;
+                d_value_tagger_max_pressure = RefinementTaggerStatistics::getMaxOnLocalPatches(level, p_id);
                 
-                mpi.Allreduce(
-                    &p_max_local,
-                    &d_value_tagger_max_pressure,
-                    1,
-                    MPI_DOUBLE,
-                    MPI_MAX);
+                statistics.push_back(&d_value_tagger_max_pressure);
             }
             else if (variable_key == "DILATATION")
             {
@@ -1449,15 +1456,10 @@ ValueTagger::getValueStatistics(
                     d_value_tagger_variable_dilatation,
                     data_context);
                 
-                double theta_max_local = cell_double_operator.max(theta_id);
-                d_value_tagger_max_dilatation = 0.0;
+                d_value_tagger_max_dilatation =
+                    RefinementTaggerStatistics::getMaxOnLocalPatches(level, theta_id);
                 
-                mpi.Allreduce(
-                    &theta_max_local,
-                    &d_value_tagger_max_dilatation,
-                    1,
-                    MPI_DOUBLE,
-                    MPI_MAX);
+                statistics.push_back(&d_value_tagger_max_dilatation);
             }
             else if (variable_key == "ENSTROPHY")
             {
@@ -1465,15 +1467,10 @@ ValueTagger::getValueStatistics(
                     d_value_tagger_variable_enstrophy,
                     data_context);
                 
-                double Omega_max_local = cell_double_operator.max(Omega_id);
-                d_value_tagger_max_enstrophy = 0.0;
+                d_value_tagger_max_enstrophy =
+                    RefinementTaggerStatistics::getMaxOnLocalPatches(level, Omega_id);
                 
-                mpi.Allreduce(
-                    &Omega_max_local,
-                    &d_value_tagger_max_enstrophy,
-                    1,
-                    MPI_DOUBLE,
-                    MPI_MAX);
+                statistics.push_back(&d_value_tagger_max_enstrophy);
             }
             else if (variable_key == "MASS_FRACTION" || variable_key == "MASS_FRACTIONS")
             {
@@ -1483,15 +1480,10 @@ ValueTagger::getValueStatistics(
                         d_value_tagger_variable_mass_fractions[si],
                         data_context);
                     
-                    double Y_max_local = cell_double_operator.max(Y_id);
-                    d_value_tagger_max_mass_fractions[si] = 0.0;
+                    d_value_tagger_max_mass_fractions[si] =
+                        RefinementTaggerStatistics::getMaxOnLocalPatches(level, Y_id);
                     
-                    mpi.Allreduce(
-                        &Y_max_local,
-                        &d_value_tagger_max_mass_fractions[si],
-                        1,
-                        MPI_DOUBLE,
-                        MPI_MAX);
+                    statistics.push_back(&d_value_tagger_max_mass_fractions[si]);
                 }
             }
         }
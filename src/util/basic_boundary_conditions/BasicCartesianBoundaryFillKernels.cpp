@@ -0,0 +1,277 @@
+#include "util/basic_boundary_conditions/BasicCartesianBoundaryFillKernels.hpp"
+
+#include "SAMRAI/tbox/Utilities.h"
+
+#include <vector>
+
+/*
+ * Get the offset lower and upper indices of the fill box, the number of ghost cells and the
+ * dimensions of the ghost box of the data, padded to three dimensions. The padded directions have
+ * a single cell and no ghost cells so that the same loops can be used in all dimensions.
+ */
+static void
+getPaddedBoxAndGhostBoxDimensions(
+    int* fill_lo,
+    int* fill_hi,
+    int* num_ghosts_padded,
+    int* ghostcell_dims_padded,
+    const boost::shared_ptr<pdat::CellData<double> >& var_data,
+    const hier::Index& fill_box_lo_idx,
+    const hier::Index& fill_box_hi_idx)
+{
+    const int dim = var_data->getDim().getValue();
+    
+    const hier::IntVector& num_ghosts = var_data->getGhostCellWidth();
+    const hier::IntVector ghostcell_dims = var_data->getGhostBox().numberCells();
+    
+    for (int di = 0; di < 3; di++)
+    {
+        if (di < dim)
+        {
+            fill_lo[di] = fill_box_lo_idx[di];
+            fill_hi[di] = fill_box_hi_idx[di];
+            num_ghosts_padded[di] = num_ghosts[di];
+            ghostcell_dims_padded[di] = ghostcell_dims[di];
+        }
+        else
+        {
+            fill_lo[di] = 0;
+            fill_hi[di] = 0;
+            num_ghosts_padded[di] = 0;
+            ghostcell_dims_padded[di] = 1;
+        }
+    }
+}
+
+
+/*
+ * Fill the cells of all depths of the data inside the fill box with constant values, one value for
+ * each depth.
+ */
+void
+BasicCartesianBoundaryFillKernels::fillBoxWithConstantValues(
+    const boost::shared_ptr<pdat::CellData<double> >& var_data,
+    const hier::Index& fill_box_lo_idx,
+    const hier::Index& fill_box_hi_idx,
+    const double* const values)
+{
+    TBOX_ASSERT(var_data);
+    TBOX_ASSERT(values != nullptr);
+    
+    int fill_lo[3];
+    int fill_hi[3];
+    int num_ghosts[3];
+    int ghostcell_dims[3];
+    
+    getPaddedBoxAndGhostBoxDimensions(
+        fill_lo,
+        fill_hi,
+        num_ghosts,
+        ghostcell_dims,
+        var_data,
+        fill_box_lo_idx,
+        fill_box_hi_idx);
+    
+    const int var_depth = var_data->getDepth();
+    
+    std::vector<double*> u;
+    u.reserve(var_depth);
+    for (int di = 0; di < var_depth; di++)
+    {
+        u.push_back(var_data->getPointer(di));
+    }
+    
+    const int fill_lo_0 = fill_lo[0];
+    const int fill_hi_0 = fill_hi[0];
+    const int num_ghosts_0 = num_ghosts[0];
+    
+    for (int k = fill_lo[2]; k <= fill_hi[2]; k++)
+    {
+        for (int j = fill_lo[1]; j <= fill_hi[1]; j++)
+        {
+            // Compute the linear index of the first cell in the row.
+            const int idx_row = (j + num_ghosts[1])*ghostcell_dims[0] +
+                (k + num_ghosts[2])*ghostcell_dims[0]*ghostcell_dims[1];
+            
+            for (int di = 0; di < var_depth; di++)
+            {
+                double* const u_row = u[di] + idx_row;
+                const double value = values[di];
+                
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd
+#endif
+                for (int i = fill_lo_0; i <= fill_hi_0; i++)
+                {
+                    u_row[i + num_ghosts_0] = value;
+                }
+            }
+        }
+    }
+}
+
+
+/*
+ * Fill the cells of all depths of the data inside the fill box with the data in the interior along
+ * the given boundary direction. The index of the interior cell in the boundary direction is
+ * pivot_start + pivot_stride*(index of ghost cell - lower index of fill box), where pivot_stride is
+ * zero for the cells next to the boundary and minus one for the mirror images.
+ */
+void
+BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+    const boost::shared_ptr<pdat::CellData<double> >& var_data,
+    const hier::Index& fill_box_lo_idx,
+    const hier::Index& fill_box_hi_idx,
+    const hier::Index& interior_box_lo_idx,
+    const hier::Index& interior_box_hi_idx,
+    const int bdry_direction,
+    const bool is_lower_bdry,
+    const bool use_mirror_image,
+    const int negated_depth)
+{
+    TBOX_ASSERT(var_data);
+    TBOX_ASSERT(bdry_direction >= 0 && bdry_direction < var_data->getDim().getValue());
+    
+    int fill_lo[3];
+    int fill_hi[3];
+    int num_ghosts[3];
+    int ghostcell_dims[3];
+    
+    getPaddedBoxAndGhostBoxDimensions(
+        fill_lo,
+        fill_hi,
+        num_ghosts,
+        ghostcell_dims,
+        var_data,
+        fill_box_lo_idx,
+        fill_box_hi_idx);
+    
+    int pivot_start = 0;
+    int pivot_stride = 0;
+    
+    if (is_lower_bdry)
+    {
+        if (use_mirror_image)
+        {
+            pivot_start = interior_box_lo_idx[bdry_direction] +
+                (fill_hi[bdry_direction] - fill_lo[bdry_direction]);
+            pivot_stride = -1;
+        }
+        else
+        {
+            pivot_start = interior_box_lo_idx[bdry_direction];
+        }
+    }
+    else
+    {
+        pivot_start = interior_box_hi_idx[bdry_direction];
+        if (use_mirror_image)
+        {
+            pivot_stride = -1;
+        }
+    }
+    
+    const int var_depth = var_data->getDepth();
+    
+    std::vector<double*> u;
+    std::vector<double> sign;
+    u.reserve(var_depth);
+    sign.reserve(var_depth);
+    for (int di = 0; di < var_depth; di++)
+    {
+        u.push_back(var_data->getPointer(di));
+        sign.push_back(di == negated_depth ? -1.0 : 1.0);
+    }
+    
+    const int fill_lo_0 = fill_lo[0];
+    const int fill_hi_0 = fill_hi[0];
+    const int num_ghosts_0 = num_ghosts[0];
+    
+    for (int k = fill_lo[2]; k <= fill_hi[2]; k++)
+    {
+        for (int j = fill_lo[1]; j <= fill_hi[1]; j++)
+        {
+            // Compute the linear index of the first cell in the row.
+            const int idx_row = (j + num_ghosts[1])*ghostcell_dims[0] +
+                (k + num_ghosts[2])*ghostcell_dims[0]*ghostcell_dims[1];
+            
+            if (bdry_direction == 0)
+            {
+                /*
+                 * The pivot cells are in the same row. The row is filled with a broadcast of the
+                 * cell next to the boundary or a reversed copy of the cells near the boundary.
+                 */
+                
+                const int idx_pivot_start = idx_row + pivot_start + num_ghosts_0;
+                
+                for (int di = 0; di < var_depth; di++)
+                {
+                    double* const u_row = u[di] + idx_row;
+                    
+                    if (pivot_stride == 0)
+                    {
+                        const double value = sign[di]*u[di][idx_pivot_start];
+                        
+#ifdef HAMERS_ENABLE_SIMD
+                        #pragma omp simd
+#endif
+                        for (int i = fill_lo_0; i <= fill_hi_0; i++)
+                        {
+                            u_row[i + num_ghosts_0] = value;
+                        }
+                    }
+                    else
+                    {
+                        const double* const u_pivot = u[di] + idx_pivot_start + fill_lo_0;
+                        const double s = sign[di];
+                        
+#ifdef HAMERS_ENABLE_SIMD
+                        #pragma omp simd
+#endif
+                        for (int i = fill_lo_0; i <= fill_hi_0; i++)
+                        {
+                            u_row[i + num_ghosts_0] = s*u_pivot[-i];
+                        }
+                    }
+                }
+            }
+            else
+            {
+                /*
+                 * The pivot cells are in another row. The row is filled with a contiguous copy of
+                 * the pivot row.
+                 */
+                
+                int j_pivot = j;
+                int k_pivot = k;
+                
+                if (bdry_direction == 1)
+                {
+                    j_pivot = pivot_start + pivot_stride*(j - fill_lo[1]);
+                }
+                else
+                {
+                    k_pivot = pivot_start + pivot_stride*(k - fill_lo[2]);
+                }
+                
+                const int idx_pivot_row = (j_pivot + num_ghosts[1])*ghostcell_dims[0] +
+                    (k_pivot + num_ghosts[2])*ghostcell_dims[0]*ghostcell_dims[1];
+                
+                for (int di = 0; di < var_depth; di++)
+                {
+                    double* const u_row = u[di] + idx_row;
+                    const double* const u_pivot_row = u[di] + idx_pivot_row;
+                    const double s = sign[di];
+                    
+#ifdef HAMERS_ENABLE_SIMD
+                    #pragma omp simd
+#endif
+                    for (int i = fill_lo_0; i <= fill_hi_0; i++)
+                    {
+                        u_row[i + num_ghosts_0] = s*u_pivot_row[i + num_ghosts_0];
+                    }
+                }
+            }
+        }
+    }
+}
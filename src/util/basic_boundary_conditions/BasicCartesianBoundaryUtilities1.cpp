@@ -3,7 +3,6 @@
 #include "util/basic_boundary_conditions/BasicBoundaryConditions.hpp"
 #include "util/basic_boundary_conditions/CartesianBoundaryDefines.hpp"
 
-#include "SAMRAI/geom/CartesianPatchGeometry.h"
 #include "SAMRAI/hier/BoundaryBox.h"
 #include "SAMRAI/pdat/CellIndex.h"
 #include "SAMRAI/tbox/Utilities.h"
@@ -86,7 +85,7 @@ void
 BasicCartesianBoundaryUtilities1::fillNodeBoundaryData(
     const std::string& var_name,
     const boost::shared_ptr<pdat::CellData<double> >& var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     const std::vector<int>& bdry_node_locs,
     const std::vector<int>& bdry_node_conds,
     const std::vector<double>& bdry_node_values,
@@ -101,15 +100,10 @@ BasicCartesianBoundaryUtilities1::fillNodeBoundaryData(
     TBOX_ASSERT(static_cast<int>(bdry_node_values.size()) == NUM_1D_NODES*(var_data->getDepth()));
     
     TBOX_DIM_ASSERT(ghost_width_to_fill.getDim() == tbox::Dimension(1));
-    TBOX_ASSERT_OBJDIM_EQUALITY3(*var_data, patch, ghost_width_to_fill);
+    TBOX_ASSERT_OBJDIM_EQUALITY2(*var_data, ghost_width_to_fill);
     
     NULL_USE(var_name);
     
-    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
-        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
-            patch.getPatchGeometry()));
-    TBOX_ASSERT(patch_geom);
-    
     const hier::IntVector& num_ghosts(var_data->getGhostCellWidth());
     
     /*
@@ -129,48 +123,42 @@ BasicCartesianBoundaryUtilities1::fillNodeBoundaryData(
             ghost_width_to_fill);
     }
     
-    // Get the dimensions of box that covers the interior of patch.
-    const hier::Box& interior_box(patch.getBox());
-    hier::Index interior_box_lo_idx(interior_box.lower());
-    hier::Index interior_box_hi_idx(interior_box.upper());
-    
-    /*
-     * Offset the indices.
-     */
-    interior_box_lo_idx = interior_box_lo_idx - interior_box.lower();
-    interior_box_hi_idx = interior_box_hi_idx - interior_box.lower();
+    // Get the offset indices of box that covers the interior of patch.
+    const hier::Index& interior_box_lo_idx(bdry_descriptor.getInteriorBoxLowerIndex());
+    const hier::Index& interior_box_hi_idx(bdry_descriptor.getInteriorBoxUpperIndex());
     
     // Get the dimensions of box that covers interior of patch plus
     // ghost cells.
     const hier::IntVector ghostcell_dims = var_data->getGhostBox().numberCells();
     
-    const std::vector<hier::BoundaryBox>& node_bdry =
-        patch_geom->getCodimensionBoundaries(BDRY::NODE1D);
+    /*
+     * Mark the node locations for applying boundary conditions.
+     */
+    std::vector<bool> is_bdry_node_locs(NUM_1D_NODES, false);
+    for (int li = 0; li < static_cast<int>(bdry_node_locs.size()); li++)
+    {
+        is_bdry_node_locs[bdry_node_locs[li]] = true;
+    }
+    
+    const int num_node_bdry = bdry_descriptor.getNumberOfBoundaryBoxes(BDRY::NODE1D);
     
     const int var_depth = var_data->getDepth();
     
-    for (int ni = 0; ni < static_cast<int>(node_bdry.size()); ni++)
+    for (int ni = 0; ni < num_node_bdry; ni++)
     {
-        TBOX_ASSERT(node_bdry[ni].getBoundaryType() == BDRY::NODE1D);
+        int node_loc = bdry_descriptor.getBoundaryLocationIndex(BDRY::NODE1D, ni);
         
-        int node_loc = node_bdry[ni].getLocationIndex();
-        
-        if (std::find(bdry_node_locs.begin(), bdry_node_locs.end(), node_loc) !=
-            bdry_node_locs.end())
+        if (is_bdry_node_locs[node_loc])
         {
-            hier::Box fill_box(patch_geom->getBoundaryFillBox(
-                node_bdry[ni],
-                interior_box,
-                gcw_to_fill));
-            
-            hier::Index fill_box_lo_idx(fill_box.lower());
-            hier::Index fill_box_hi_idx(fill_box.upper());
+            hier::Index fill_box_lo_idx(tbox::Dimension(1));
+            hier::Index fill_box_hi_idx(tbox::Dimension(1));
             
-            /*
-             * Offset the indices.
-             */
-            fill_box_lo_idx = fill_box_lo_idx - interior_box.lower();
-            fill_box_hi_idx = fill_box_hi_idx - interior_box.lower();
+            bdry_descriptor.getBoundaryFillBox(
+                fill_box_lo_idx,
+                fill_box_hi_idx,
+                BDRY::NODE1D,
+                ni,
+                gcw_to_fill);
             
             if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::DIRICHLET)
             {
@@ -12,9 +12,9 @@
 #include "util/basic_boundary_conditions/BasicCartesianBoundaryUtilities2.hpp"
 
 #include "util/basic_boundary_conditions/BasicBoundaryConditions.hpp"
+#include "util/basic_boundary_conditions/BasicCartesianBoundaryFillKernels.hpp"
 #include "util/basic_boundary_conditions/CartesianBoundaryDefines.hpp"
 
-#include "SAMRAI/geom/CartesianPatchGeometry.h"
 #include "SAMRAI/hier/BoundaryBox.h"
 #include "SAMRAI/pdat/CellIndex.h"
 #include "SAMRAI/tbox/Utilities.h"
@@ -116,7 +116,7 @@ void
 BasicCartesianBoundaryUtilities2::fillEdgeBoundaryData(
     const std::string& var_name,
     const boost::shared_ptr<pdat::CellData<double> >& var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     const std::vector<int>& bdry_edge_locs,
     const std::vector<int>& bdry_edge_conds,
     const std::vector<double>& bdry_edge_values,
@@ -131,15 +131,10 @@ BasicCartesianBoundaryUtilities2::fillEdgeBoundaryData(
     TBOX_ASSERT(static_cast<int>(bdry_edge_values.size()) == NUM_2D_EDGES*(var_data->getDepth()));
     
     TBOX_DIM_ASSERT(ghost_width_to_fill.getDim() == tbox::Dimension(2));
-    TBOX_ASSERT_OBJDIM_EQUALITY3(*var_data, patch, ghost_width_to_fill);
+    TBOX_ASSERT_OBJDIM_EQUALITY2(*var_data, ghost_width_to_fill);
     
     NULL_USE(var_name);
     
-    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
-        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
-            patch.getPatchGeometry()));
-    TBOX_ASSERT(patch_geom);
-    
     const hier::IntVector& num_ghosts(var_data->getGhostCellWidth());
     
     /*
@@ -159,64 +154,53 @@ BasicCartesianBoundaryUtilities2::fillEdgeBoundaryData(
             ghost_width_to_fill);
     }
     
-    // Get the dimensions of box that covers the interior of patch.
-    const hier::Box& interior_box(patch.getBox());
-    hier::Index interior_box_lo_idx(interior_box.lower());
-    hier::Index interior_box_hi_idx(interior_box.upper());
+    // Get the offset indices of box that covers the interior of patch.
+    const hier::Index& interior_box_lo_idx(bdry_descriptor.getInteriorBoxLowerIndex());
+    const hier::Index& interior_box_hi_idx(bdry_descriptor.getInteriorBoxUpperIndex());
     
     /*
-     * Offset the indices.
+     * Mark the edge locations for applying boundary conditions.
      */
-    interior_box_lo_idx = interior_box_lo_idx - interior_box.lower();
-    interior_box_hi_idx = interior_box_hi_idx - interior_box.lower();
-    
-    // Get the dimensions of box that covers interior of patch plus
-    // ghost cells.
-    const hier::IntVector ghostcell_dims = var_data->getGhostBox().numberCells();
+    std::vector<bool> is_bdry_edge_locs(NUM_2D_EDGES, false);
+    for (int li = 0; li < static_cast<int>(bdry_edge_locs.size()); li++)
+    {
+        is_bdry_edge_locs[bdry_edge_locs[li]] = true;
+    }
     
-    const std::vector<hier::BoundaryBox>& edge_bdry =
-        patch_geom->getCodimensionBoundaries(BDRY::EDGE2D);
+    const int num_edge_bdry = bdry_descriptor.getNumberOfBoundaryBoxes(BDRY::EDGE2D);
     
     const int var_depth = var_data->getDepth();
     
-    for (int ei = 0; ei < static_cast<int>(edge_bdry.size()); ei++)
+    for (int ei = 0; ei < num_edge_bdry; ei++)
     {
-        TBOX_ASSERT(edge_bdry[ei].getBoundaryType() == BDRY::EDGE2D);
+        int edge_loc = bdry_descriptor.getBoundaryLocationIndex(BDRY::EDGE2D, ei);
         
-        int edge_loc = edge_bdry[ei].getLocationIndex();
-        
-        if (std::find(bdry_edge_locs.begin(), bdry_edge_locs.end(), edge_loc) !=
-            bdry_edge_locs.end())
+        if (is_bdry_edge_locs[edge_loc])
         {
-            hier::Box fill_box(patch_geom->getBoundaryFillBox(
-                edge_bdry[ei],
-                interior_box,
-                gcw_to_fill));
+            hier::Index fill_box_lo_idx(tbox::Dimension(2));
+            hier::Index fill_box_hi_idx(tbox::Dimension(2));
             
-            hier::Index fill_box_lo_idx(fill_box.lower());
-            hier::Index fill_box_hi_idx(fill_box.upper());
+            bdry_descriptor.getBoundaryFillBox(
+                fill_box_lo_idx,
+                fill_box_hi_idx,
+                BDRY::EDGE2D,
+                ei,
+                gcw_to_fill);
             
             /*
-             * Offset the indices.
+             * The boundary locations are ordered as XLO, XHI, YLO and YHI.
              */
-            fill_box_lo_idx = fill_box_lo_idx - interior_box.lower();
-            fill_box_hi_idx = fill_box_hi_idx - interior_box.lower();
+            
+            const int bdry_direction = edge_loc/2;
+            const bool is_lower_bdry = (edge_loc%2 == 0);
             
             if (bdry_edge_conds[edge_loc] == BDRY_COND::BASIC::DIRICHLET)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = bdry_edge_values[edge_loc*var_depth + di];
-                        }
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxWithConstantValues(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    &bdry_edge_values[edge_loc*var_depth]);
             }
             else if (bdry_edge_conds[edge_loc] == BDRY_COND::BASIC::NEUMANN)
             {
@@ -224,129 +208,40 @@ BasicCartesianBoundaryUtilities2::fillEdgeBoundaryData(
             }
             else if (bdry_edge_conds[edge_loc] == BDRY_COND::BASIC::FLOW)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        int idx_cell_pivot = idx_cell;
-                        
-                        if (edge_loc == BDRY_LOC::XLO)
-                        {
-                            idx_cell_pivot = (interior_box_lo_idx[0] + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc == BDRY_LOC::XHI)
-                        {
-                            idx_cell_pivot = (interior_box_hi_idx[0] + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc == BDRY_LOC::YLO)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_lo_idx[1] + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc == BDRY_LOC::YHI)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_hi_idx[1] + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = var_data->getPointer(di)[idx_cell_pivot];
-                        }
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    interior_box_lo_idx,
+                    interior_box_hi_idx,
+                    bdry_direction,
+                    is_lower_bdry,
+                    false);
             }
             else if (bdry_edge_conds[edge_loc] == BDRY_COND::BASIC::REFLECT)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        int idx_cell_pivot = idx_cell;
-                        
-                        if (edge_loc == BDRY_LOC::XLO)
-                        {
-                            idx_cell_pivot = (interior_box_lo_idx[0] + (fill_box_hi_idx[0] - i) + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc == BDRY_LOC::XHI)
-                        {
-                            idx_cell_pivot = (interior_box_hi_idx[0] - (i - fill_box_lo_idx[0]) + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc == BDRY_LOC::YLO)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_lo_idx[1] + (fill_box_hi_idx[1] - j) + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc == BDRY_LOC::YHI)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_hi_idx[1] - (j - fill_box_lo_idx[1]) + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = var_data->getPointer(di)[idx_cell_pivot];
-                        }
-                        
-                        if (edge_loc == BDRY_LOC::XLO || edge_loc == BDRY_LOC::XHI)
-                        {
-                            var_data->getPointer(0)[idx_cell] = -var_data->getPointer(0)[idx_cell_pivot];
-                        }
-                        else if (edge_loc == BDRY_LOC::YLO || edge_loc == BDRY_LOC::YHI)
-                        {
-                            var_data->getPointer(1)[idx_cell] = -var_data->getPointer(1)[idx_cell_pivot];
-                        }
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    interior_box_lo_idx,
+                    interior_box_hi_idx,
+                    bdry_direction,
+                    is_lower_bdry,
+                    true,
+                    bdry_direction);
             }
             else if (bdry_edge_conds[edge_loc] == BDRY_COND::BASIC::SYMMETRY)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        int idx_cell_pivot = idx_cell;
-                        
-                        if (edge_loc == BDRY_LOC::XLO)
-                        {
-                            idx_cell_pivot = (interior_box_lo_idx[0] + (fill_box_hi_idx[0] - i) + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc == BDRY_LOC::XHI)
-                        {
-                            idx_cell_pivot = (interior_box_hi_idx[0] - (i - fill_box_lo_idx[0]) + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc == BDRY_LOC::YLO)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_lo_idx[1] + (fill_box_hi_idx[1] - j) + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc == BDRY_LOC::YHI)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_hi_idx[1] - (j - fill_box_lo_idx[1]) + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = var_data->getPointer(di)[idx_cell_pivot];
-                        }
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    interior_box_lo_idx,
+                    interior_box_hi_idx,
+                    bdry_direction,
+                    is_lower_bdry,
+                    true);
             }
             else
             {
@@ -380,7 +275,7 @@ void
 BasicCartesianBoundaryUtilities2::fillNodeBoundaryData(
     const std::string& var_name,
     const boost::shared_ptr<pdat::CellData<double> >& var_data,
-    const hier::Patch& patch,
+    const PatchBoundaryDescriptor& bdry_descriptor,
     const std::vector<int>& bdry_node_locs,
     const std::vector<int>& bdry_node_conds,
     const std::vector<double>& bdry_edge_values,
@@ -395,15 +290,10 @@ BasicCartesianBoundaryUtilities2::fillNodeBoundaryData(
     TBOX_ASSERT(static_cast<int>(bdry_edge_values.size()) == NUM_2D_EDGES*(var_data->getDepth()));
     
     TBOX_DIM_ASSERT(ghost_width_to_fill.getDim() == tbox::Dimension(2));
-    TBOX_ASSERT_OBJDIM_EQUALITY3(*var_data, patch, ghost_width_to_fill);
+    TBOX_ASSERT_OBJDIM_EQUALITY2(*var_data, ghost_width_to_fill);
     
     NULL_USE(var_name);
     
-    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
-        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
-            patch.getPatchGeometry()));
-    TBOX_ASSERT(patch_geom);
-    
     const hier::IntVector& num_ghosts(var_data->getGhostCellWidth());
     
     /*
@@ -423,48 +313,38 @@ BasicCartesianBoundaryUtilities2::fillNodeBoundaryData(
             ghost_width_to_fill);
     }
     
-    // Get the dimensions of box that covers the interior of patch.
-    const hier::Box& interior_box(patch.getBox());
-    hier::Index interior_box_lo_idx(interior_box.lower());
-    hier::Index interior_box_hi_idx(interior_box.upper());
+    // Get the offset indices of box that covers the interior of patch.
+    const hier::Index& interior_box_lo_idx(bdry_descriptor.getInteriorBoxLowerIndex());
+    const hier::Index& interior_box_hi_idx(bdry_descriptor.getInteriorBoxUpperIndex());
     
     /*
-     * Offset the indices.
+     * Mark the node locations for applying boundary conditions.
      */
-    interior_box_lo_idx = interior_box_lo_idx - interior_box.lower();
-    interior_box_hi_idx = interior_box_hi_idx - interior_box.lower();
-    
-    // Get the dimensions of box that covers interior of patch plus
-    // ghost cells.
-    const hier::IntVector ghostcell_dims = var_data->getGhostBox().numberCells();
+    std::vector<bool> is_bdry_node_locs(NUM_2D_NODES, false);
+    for (int li = 0; li < static_cast<int>(bdry_node_locs.size()); li++)
+    {
+        is_bdry_node_locs[bdry_node_locs[li]] = true;
+    }
     
-    const std::vector<hier::BoundaryBox>& node_bdry =
-        patch_geom->getCodimensionBoundaries(BDRY::NODE2D);
+    const int num_node_bdry = bdry_descriptor.getNumberOfBoundaryBoxes(BDRY::NODE2D);
     
     const int var_depth = var_data->getDepth();
     
-    for (int ni = 0; ni < static_cast<int>(node_bdry.size()); ni++)
+    for (int ni = 0; ni < num_node_bdry; ni++)
     {
-        TBOX_ASSERT(node_bdry[ni].getBoundaryType() == BDRY::NODE2D);
+        int node_loc = bdry_descriptor.getBoundaryLocationIndex(BDRY::NODE2D, ni);
         
-        int node_loc = node_bdry[ni].getLocationIndex();
-        
-        if (std::find(bdry_node_locs.begin(), bdry_node_locs.end(), node_loc) !=
-            bdry_node_locs.end())
+        if (is_bdry_node_locs[node_loc])
         {
-            hier::Box fill_box(patch_geom->getBoundaryFillBox(
-                node_bdry[ni],
-                interior_box,
-                gcw_to_fill));
+            hier::Index fill_box_lo_idx(tbox::Dimension(2));
+            hier::Index fill_box_hi_idx(tbox::Dimension(2));
             
-            hier::Index fill_box_lo_idx(fill_box.lower());
-            hier::Index fill_box_hi_idx(fill_box.upper());
-            
-            /*
-             * Offset the indices.
-             */
-            fill_box_lo_idx = fill_box_lo_idx - interior_box.lower();
-            fill_box_hi_idx = fill_box_hi_idx - interior_box.lower();
+            bdry_descriptor.getBoundaryFillBox(
+                fill_box_lo_idx,
+                fill_box_hi_idx,
+                BDRY::NODE2D,
+                ni,
+                gcw_to_fill);
             
             int edge_loc_0 = -1;
             int edge_loc_1 = -1;
@@ -503,37 +383,19 @@ BasicCartesianBoundaryUtilities2::fillNodeBoundaryData(
             
             if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::XDIRICHLET)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = bdry_edge_values[edge_loc_0*var_depth + di];
-                        }
-                        
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxWithConstantValues(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    &bdry_edge_values[edge_loc_0*var_depth]);
             }
             else if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::YDIRICHLET)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = bdry_edge_values[edge_loc_1*var_depth + di];
-                        }
-                        
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxWithConstantValues(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    &bdry_edge_values[edge_loc_1*var_depth]);
             }
             else if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::XNEUMANN)
             {
@@ -545,181 +407,77 @@ BasicCartesianBoundaryUtilities2::fillNodeBoundaryData(
             }
             else if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::XFLOW)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        int idx_cell_pivot = idx_cell;
-                        
-                        if (edge_loc_0 == BDRY_LOC::XLO)
-                        {
-                            idx_cell_pivot = (interior_box_lo_idx[0] + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc_0 == BDRY_LOC::XHI)
-                        {
-                            idx_cell_pivot = (interior_box_hi_idx[0] + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = var_data->getPointer(di)[idx_cell_pivot];
-                        }
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    interior_box_lo_idx,
+                    interior_box_hi_idx,
+                    0,
+                    (edge_loc_0 == BDRY_LOC::XLO),
+                    false);
             }
             else if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::YFLOW)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        int idx_cell_pivot = idx_cell;
-                        
-                        if (edge_loc_1 == BDRY_LOC::YLO)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_lo_idx[1] + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc_1 == BDRY_LOC::YHI)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_hi_idx[1] + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = var_data->getPointer(di)[idx_cell_pivot];
-                        }
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    interior_box_lo_idx,
+                    interior_box_hi_idx,
+                    1,
+                    (edge_loc_1 == BDRY_LOC::YLO),
+                    false);
             }
             else if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::XREFLECT)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        int idx_cell_pivot = idx_cell;
-                        
-                        if (edge_loc_0 == BDRY_LOC::XLO)
-                        {
-                            idx_cell_pivot = (interior_box_lo_idx[0] + (fill_box_hi_idx[0] - i) + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc_0 == BDRY_LOC::XHI)
-                        {
-                            idx_cell_pivot = (interior_box_hi_idx[0] - (i - fill_box_lo_idx[0]) + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = var_data->getPointer(di)[idx_cell_pivot];
-                        }
-                        
-                        var_data->getPointer(0)[idx_cell] = -var_data->getPointer(0)[idx_cell_pivot];
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    interior_box_lo_idx,
+                    interior_box_hi_idx,
+                    0,
+                    (edge_loc_0 == BDRY_LOC::XLO),
+                    true,
+                    0);
             }
             else if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::YREFLECT)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        int idx_cell_pivot = idx_cell;
-                        
-                        if (edge_loc_1 == BDRY_LOC::YLO)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_lo_idx[1] + (fill_box_hi_idx[1] - j) + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc_1 == BDRY_LOC::YHI)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_hi_idx[1] - (j - fill_box_lo_idx[1]) + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = var_data->getPointer(di)[idx_cell_pivot];
-                        }
-                        
-                        var_data->getPointer(1)[idx_cell] = -var_data->getPointer(1)[idx_cell_pivot];
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    interior_box_lo_idx,
+                    interior_box_hi_idx,
+                    1,
+                    (edge_loc_1 == BDRY_LOC::YLO),
+                    true,
+                    1);
             }
             else if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::XSYMMETRY)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        int idx_cell_pivot = idx_cell;
-                        
-                        if (edge_loc_0 == BDRY_LOC::XLO)
-                        {
-                            idx_cell_pivot = (interior_box_lo_idx[0] + (fill_box_hi_idx[0] - i) + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc_0 == BDRY_LOC::XHI)
-                        {
-                            idx_cell_pivot = (interior_box_hi_idx[0] - (i - fill_box_lo_idx[0]) + num_ghosts[0]) +
-                                (j + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = var_data->getPointer(di)[idx_cell_pivot];
-                        }
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    interior_box_lo_idx,
+                    interior_box_hi_idx,
+                    0,
+                    (edge_loc_0 == BDRY_LOC::XLO),
+                    true);
             }
             else if (bdry_node_conds[node_loc] == BDRY_COND::BASIC::YSYMMETRY)
             {
-                for (int i = fill_box_lo_idx[0]; i <= fill_box_hi_idx[0]; i++)
-                {
-                    for (int j = fill_box_lo_idx[1]; j <= fill_box_hi_idx[1]; j++)
-                    {
-                        const int idx_cell = (i + num_ghosts[0]) +
-                            (j + num_ghosts[1])*ghostcell_dims[0];
-                        
-                        int idx_cell_pivot = idx_cell;
-                        
-                        if (edge_loc_1 == BDRY_LOC::YLO)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_lo_idx[1] + (fill_box_hi_idx[1] - j) + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        else if (edge_loc_1 == BDRY_LOC::YHI)
-                        {
-                            idx_cell_pivot = (i + num_ghosts[0]) +
-                                (interior_box_hi_idx[1] - (j - fill_box_lo_idx[1]) + num_ghosts[1])*ghostcell_dims[0];
-                        }
-                        
-                        for (int di = 0; di < var_depth; di++)
-                        {
-                            var_data->getPointer(di)[idx_cell] = var_data->getPointer(di)[idx_cell_pivot];
-                        }
-                    }
-                }
+                BasicCartesianBoundaryFillKernels::fillBoxFromInterior(
+                    var_data,
+                    fill_box_lo_idx,
+                    fill_box_hi_idx,
+                    interior_box_lo_idx,
+                    interior_box_hi_idx,
+                    1,
+                    (edge_loc_1 == BDRY_LOC::YLO),
+                    true);
             }
             else
             {
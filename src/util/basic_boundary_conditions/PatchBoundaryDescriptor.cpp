@@ -0,0 +1,125 @@
+#include "util/basic_boundary_conditions/PatchBoundaryDescriptor.hpp"
+
+#include "SAMRAI/geom/CartesianPatchGeometry.h"
+#include "SAMRAI/hier/BoundaryBox.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+/*
+ * Construct the descriptor of the physical boundary boxes of the patch.
+ */
+PatchBoundaryDescriptor::PatchBoundaryDescriptor(const hier::Patch& patch):
+    d_patch_box(patch.getBox()),
+    d_interior_box_lo_idx(patch.getDim()),
+    d_interior_box_hi_idx(patch.getDim())
+{
+    const boost::shared_ptr<geom::CartesianPatchGeometry> patch_geom(
+        BOOST_CAST<geom::CartesianPatchGeometry, hier::PatchGeometry>(
+            patch.getPatchGeometry()));
+    TBOX_ASSERT(patch_geom);
+    
+    const int dim = patch.getDim().getValue();
+    
+    /*
+     * Offset the indices of the interior box.
+     */
+    
+    d_interior_box_lo_idx = d_patch_box.lower() - d_patch_box.lower();
+    d_interior_box_hi_idx = d_patch_box.upper() - d_patch_box.lower();
+    
+    d_bdry_locs.resize(dim);
+    d_bdry_box_lo.resize(dim);
+    d_bdry_box_hi.resize(dim);
+    d_bdry_box_sides.resize(dim);
+    
+    for (int codim = 1; codim <= dim; codim++)
+    {
+        const std::vector<hier::BoundaryBox>& bdry_boxes =
+            patch_geom->getCodimensionBoundaries(codim);
+        
+        const int num_bdry_boxes = static_cast<int>(bdry_boxes.size());
+        
+        std::vector<int>& bdry_locs = d_bdry_locs[codim - 1];
+        std::vector<int>& bdry_box_lo = d_bdry_box_lo[codim - 1];
+        std::vector<int>& bdry_box_hi = d_bdry_box_hi[codim - 1];
+        std::vector<int>& bdry_box_sides = d_bdry_box_sides[codim - 1];
+        
+        bdry_locs.reserve(num_bdry_boxes);
+        bdry_box_lo.reserve(num_bdry_boxes*dim);
+        bdry_box_hi.reserve(num_bdry_boxes*dim);
+        bdry_box_sides.reserve(num_bdry_boxes*dim);
+        
+        for (int bi = 0; bi < num_bdry_boxes; bi++)
+        {
+            TBOX_ASSERT(bdry_boxes[bi].getBoundaryType() == codim);
+            
+            bdry_locs.push_back(bdry_boxes[bi].getLocationIndex());
+            
+            const hier::Box& bdry_box = bdry_boxes[bi].getBox();
+            
+            for (int di = 0; di < dim; di++)
+            {
+                bdry_box_lo.push_back(bdry_box.lower()[di] - d_patch_box.lower()[di]);
+                bdry_box_hi.push_back(bdry_box.upper()[di] - d_patch_box.lower()[di]);
+                
+                if (bdry_box.lower()[di] < d_patch_box.lower()[di])
+                {
+                    bdry_box_sides.push_back(-1);
+                }
+                else if (bdry_box.upper()[di] > d_patch_box.upper()[di])
+                {
+                    bdry_box_sides.push_back(1);
+                }
+                else
+                {
+                    bdry_box_sides.push_back(0);
+                }
+            }
+        }
+    }
+}
+
+
+/*
+ * Get the offset lower and upper indices of the boundary fill box of a boundary box of the given
+ * codimension for the ghost cell width to fill.
+ */
+void
+PatchBoundaryDescriptor::getBoundaryFillBox(
+    hier::Index& fill_box_lo_idx,
+    hier::Index& fill_box_hi_idx,
+    const int codim,
+    const int bi,
+    const hier::IntVector& gcw_to_fill) const
+{
+    const int dim = d_patch_box.getDim().getValue();
+    
+    TBOX_ASSERT(codim >= 1 && codim <= dim);
+    TBOX_ASSERT(bi >= 0 && bi < getNumberOfBoundaryBoxes(codim));
+    TBOX_ASSERT(fill_box_lo_idx.getDim().getValue() == dim);
+    TBOX_ASSERT(fill_box_hi_idx.getDim().getValue() == dim);
+    TBOX_ASSERT(gcw_to_fill.getDim().getValue() == dim);
+    
+    const int* bdry_box_lo = &d_bdry_box_lo[codim - 1][bi*dim];
+    const int* bdry_box_hi = &d_bdry_box_hi[codim - 1][bi*dim];
+    const int* bdry_box_sides = &d_bdry_box_sides[codim - 1][bi*dim];
+    
+    for (int di = 0; di < dim; di++)
+    {
+        if (bdry_box_sides[di] == -1)
+        {
+            fill_box_lo_idx[di] = d_interior_box_lo_idx[di] - gcw_to_fill[di];
+            fill_box_hi_idx[di] = d_interior_box_lo_idx[di] - 1;
+        }
+        else if (bdry_box_sides[di] == 1)
+        {
+            fill_box_lo_idx[di] = d_interior_box_hi_idx[di] + 1;
+            fill_box_hi_idx[di] = d_interior_box_hi_idx[di] + gcw_to_fill[di];
+        }
+        else
+        {
+            fill_box_lo_idx[di] = bdry_box_lo[di];
+            fill_box_hi_idx[di] = bdry_box_hi[di];
+        }
+    }
+}
+
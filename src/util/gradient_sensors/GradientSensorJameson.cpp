@@ -360,3 +360,215 @@ GradientSensorJameson::computeGradient(
         }
     }
 }
+
+
+/*
+ * Compute the gradients of multiple cell data in a single sweep over the patch. The directional
+ * second differences and local means are computed on the fly for all the cell data in each row of
+ * cells so that no temporary data is needed.
+ */
+void
+GradientSensorJameson::computeGradients(
+    std::vector<boost::shared_ptr<pdat::CellData<double> > >& gradients,
+    const std::vector<boost::shared_ptr<pdat::CellData<double> > >& cell_data,
+    hier::Patch& patch)
+{
+    TBOX_ASSERT(gradients.size() == cell_data.size());
+    
+    const int num_fields = static_cast<int>(cell_data.size());
+    
+    if (num_fields == 0)
+    {
+        return;
+    }
+    
+    // Get the number of ghost cells of the cell data and gradient data.
+    const hier::IntVector num_ghosts_cell_data = cell_data[0]->getGhostCellWidth();
+    const hier::IntVector num_ghosts_gradient = gradients[0]->getGhostCellWidth();
+    
+    if (num_ghosts_cell_data < d_num_gradient_ghosts)
+    {
+        TBOX_ERROR(d_object_name
+            << ": "
+            << "The ghost cell width is smaller than required."
+            << std::endl);
+    }
+    
+    for (int vi = 1; vi < num_fields; vi++)
+    {
+        if (cell_data[vi]->getGhostCellWidth() != num_ghosts_cell_data ||
+            gradients[vi]->getGhostCellWidth() != num_ghosts_gradient)
+        {
+            TBOX_ERROR(d_object_name
+                << ": "
+                << "The cell data or gradients don't have same ghost cell width."
+                << std::endl);
+        }
+    }
+    
+    // Get the dimensions of box that covers the interior of patch.
+    const hier::Box interior_box = patch.getBox();
+    const hier::IntVector interior_dims = interior_box.numberCells();
+    
+    // Get the dimensions of box that covers interior of patch plus ghost cells.
+    const hier::Box ghost_box_cell_data = cell_data[0]->getGhostBox();
+    const hier::IntVector ghostcell_dims_cell_data = ghost_box_cell_data.numberCells();
+    
+    const hier::Box ghost_box_gradient = gradients[0]->getGhostBox();
+    const hier::IntVector ghostcell_dims_gradient = ghost_box_gradient.numberCells();
+    
+    // Get the pointers to the cell data and gradients.
+    std::vector<double*> f;
+    std::vector<double*> psi;
+    f.reserve(num_fields);
+    psi.reserve(num_fields);
+    for (int vi = 0; vi < num_fields; vi++)
+    {
+        f.push_back(cell_data[vi]->getPointer(0));
+        psi.push_back(gradients[vi]->getPointer(0));
+    }
+    
+    if (d_dim == tbox::Dimension(1))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        
+        const int num_ghosts_0_cell_data = num_ghosts_cell_data[0];
+        const int num_ghosts_0_gradient = num_ghosts_gradient[0];
+        
+        for (int vi = 0; vi < num_fields; vi++)
+        {
+            const double* const f_v = f[vi];
+            double* const psi_v = psi[vi];
+            
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int i = 0; i < interior_dim_0; i++)
+            {
+                // Compute the linear indices.
+                const int idx = i + num_ghosts_0_gradient;
+                const int idx_x_L = i - 1 + num_ghosts_0_cell_data;
+                const int idx_x   = i + num_ghosts_0_cell_data;
+                const int idx_x_R = i + 1 + num_ghosts_0_cell_data;
+                
+                const double psi_x  = f_v[idx_x_R] - double(2)*f_v[idx_x] + f_v[idx_x_L];
+                const double mean_x = f_v[idx_x_R] + double(2)*f_v[idx_x] + f_v[idx_x_L];
+                
+                psi_v[idx] = fabs(psi_x)/(mean_x + double(EPSILON));
+            }
+        }
+    }
+    else if (d_dim == tbox::Dimension(2))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        const int interior_dim_1 = interior_dims[1];
+        
+        const int num_ghosts_0_cell_data = num_ghosts_cell_data[0];
+        const int num_ghosts_1_cell_data = num_ghosts_cell_data[1];
+        const int ghostcell_dim_0_cell_data = ghostcell_dims_cell_data[0];
+        
+        const int num_ghosts_0_gradient = num_ghosts_gradient[0];
+        const int num_ghosts_1_gradient = num_ghosts_gradient[1];
+        const int ghostcell_dim_0_gradient = ghostcell_dims_gradient[0];
+        
+        for (int j = 0; j < interior_dim_1; j++)
+        {
+            for (int vi = 0; vi < num_fields; vi++)
+            {
+                const double* const f_v = f[vi];
+                double* const psi_v = psi[vi];
+                
+#ifdef HAMERS_ENABLE_SIMD
+                #pragma omp simd
+#endif
+                for (int i = 0; i < interior_dim_0; i++)
+                {
+                    // Compute the linear indices.
+                    const int idx = (i + num_ghosts_0_gradient) +
+                        (j + num_ghosts_1_gradient)*ghostcell_dim_0_gradient;
+                    
+                    const int idx_cell_data = (i + num_ghosts_0_cell_data) +
+                        (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
+                    
+                    const int idx_x_L = idx_cell_data - 1;
+                    const int idx_x_R = idx_cell_data + 1;
+                    const int idx_y_B = idx_cell_data - ghostcell_dim_0_cell_data;
+                    const int idx_y_T = idx_cell_data + ghostcell_dim_0_cell_data;
+                    
+                    const double psi_x  = f_v[idx_x_R] - double(2)*f_v[idx_cell_data] + f_v[idx_x_L];
+                    const double psi_y  = f_v[idx_y_T] - double(2)*f_v[idx_cell_data] + f_v[idx_y_B];
+                    const double mean_x = f_v[idx_x_R] + double(2)*f_v[idx_cell_data] + f_v[idx_x_L];
+                    const double mean_y = f_v[idx_y_T] + double(2)*f_v[idx_cell_data] + f_v[idx_y_B];
+                    
+                    psi_v[idx] = sqrt(psi_x*psi_x + psi_y*psi_y)/
+                        (sqrt(mean_x*mean_x + mean_y*mean_y) + double(EPSILON));
+                }
+            }
+        }
+    }
+    else if (d_dim == tbox::Dimension(3))
+    {
+        const int interior_dim_0 = interior_dims[0];
+        const int interior_dim_1 = interior_dims[1];
+        const int interior_dim_2 = interior_dims[2];
+        
+        const int num_ghosts_0_cell_data = num_ghosts_cell_data[0];
+        const int num_ghosts_1_cell_data = num_ghosts_cell_data[1];
+        const int num_ghosts_2_cell_data = num_ghosts_cell_data[2];
+        const int ghostcell_dim_0_cell_data = ghostcell_dims_cell_data[0];
+        const int ghostcell_dim_1_cell_data = ghostcell_dims_cell_data[1];
+        
+        const int num_ghosts_0_gradient = num_ghosts_gradient[0];
+        const int num_ghosts_1_gradient = num_ghosts_gradient[1];
+        const int num_ghosts_2_gradient = num_ghosts_gradient[2];
+        const int ghostcell_dim_0_gradient = ghostcell_dims_gradient[0];
+        const int ghostcell_dim_1_gradient = ghostcell_dims_gradient[1];
+        
+        const int stride_z_cell_data = ghostcell_dim_0_cell_data*ghostcell_dim_1_cell_data;
+        
+        for (int k = 0; k < interior_dim_2; k++)
+        {
+            for (int j = 0; j < interior_dim_1; j++)
+            {
+                for (int vi = 0; vi < num_fields; vi++)
+                {
+                    const double* const f_v = f[vi];
+                    double* const psi_v = psi[vi];
+                    
+#ifdef HAMERS_ENABLE_SIMD
+                    #pragma omp simd
+#endif
+                    for (int i = 0; i < interior_dim_0; i++)
+                    {
+                        // Compute the linear indices.
+                        const int idx = (i + num_ghosts_0_gradient) +
+                            (j + num_ghosts_1_gradient)*ghostcell_dim_0_gradient +
+                            (k + num_ghosts_2_gradient)*ghostcell_dim_0_gradient*
+                                ghostcell_dim_1_gradient;
+                        
+                        const int idx_cell_data = (i + num_ghosts_0_cell_data) +
+                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
+                            (k + num_ghosts_2_cell_data)*stride_z_cell_data;
+                        
+                        const int idx_x_L = idx_cell_data - 1;
+                        const int idx_x_R = idx_cell_data + 1;
+                        const int idx_y_B = idx_cell_data - ghostcell_dim_0_cell_data;
+                        const int idx_y_T = idx_cell_data + ghostcell_dim_0_cell_data;
+                        const int idx_z_B = idx_cell_data - stride_z_cell_data;
+                        const int idx_z_F = idx_cell_data + stride_z_cell_data;
+                        
+                        const double psi_x  = f_v[idx_x_R] - double(2)*f_v[idx_cell_data] + f_v[idx_x_L];
+                        const double psi_y  = f_v[idx_y_T] - double(2)*f_v[idx_cell_data] + f_v[idx_y_B];
+                        const double psi_z  = f_v[idx_z_F] - double(2)*f_v[idx_cell_data] + f_v[idx_z_B];
+                        const double mean_x = f_v[idx_x_R] + double(2)*f_v[idx_cell_data] + f_v[idx_x_L];
+                        const double mean_y = f_v[idx_y_T] + double(2)*f_v[idx_cell_data] + f_v[idx_y_B];
+                        const double mean_z = f_v[idx_z_F] + double(2)*f_v[idx_cell_data] + f_v[idx_z_B];
+                        
+                        psi_v[idx] = sqrt(psi_x*psi_x + psi_y*psi_y + psi_z*psi_z)/
+                            (sqrt(mean_x*mean_x + mean_y*mean_y + mean_z*mean_z) + double(EPSILON));
+                    }
+                }
+            }
+        }
+    }
+}
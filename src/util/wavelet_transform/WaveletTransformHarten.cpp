@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cfloat>
 
+#define NUM_LINES_PER_BLOCK 8
+
 WaveletTransformHarten::WaveletTransformHarten(
     const std::string& object_name,
     const tbox::Dimension& dim,
@@ -222,6 +224,7 @@ WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans(
         for (int li = 0; li < d_num_level; li++)
         {
             f_mean.push_back(variable_local_means[li]->getPointer(0));
+            variable_local_means[li]->fillAll(double(0));
         }
     }
     
@@ -238,226 +241,274 @@ WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans(
             depth);
     }
     
-    if (d_dim == tbox::Dimension(1))
+    /*
+     * Perform the transformation line by line in each direction. All levels of scaling and wavelet
+     * coefficients of a block of lines are computed in small line buffers while the data is still
+     * in cache. The one-dimensional wavelet coefficients and local means are accumulated into the
+     * output arrays so that no full-patch temporary data is needed for the intermediate levels.
+     */
+    
+    for (int di = 0; di < d_dim.getValue(); di++)
     {
-        const int interior_dim_0 = interior_dims[0];
-        
-        const int num_ghosts_0_cell_data = num_ghosts_cell_data[0];
-        const int num_ghosts_0_wavelet_coeffs = num_ghosts_wavelet_coeffs[0];
-        
-        // Allocate scaling function coefficients.
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > scaling_coeffs_x;
-        for (int li = 0; li < d_num_level; li++)
+        // Get the pointer to the (smoothed) cell data in the current direction.
+        if (smooth_cell_data)
         {
-            scaling_coeffs_x.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
+            f = smoothed_cell_data->getPointer(di);
         }
-        
-        // Get the pointers to the scaling function coefficients and initialize them with zero values.
-        std::vector<double*> f_x;
-        for (int li = 0; li < d_num_level; li++)
+        else
         {
-            f_x.push_back(scaling_coeffs_x[li]->getPointer(0));
-            scaling_coeffs_x[li]->fillAll(double(0));
+            f = cell_data->getPointer(depth);
         }
         
-        /*
-         * Compute scaling and wavelet coefficients at first level.
-         */
+        transformLinesInDirection(
+            w,
+            f_mean,
+            f,
+            di,
+            interior_dims,
+            num_ghosts_cell_data,
+            ghostcell_dims_cell_data,
+            num_ghosts_wavelet_coeffs,
+            ghostcell_dims_wavelet_coeffs);
+    }
+    
+    /*
+     * Compute the multi-dimensional wavelet coefficients and local means from the accumulated sums
+     * of squares of the one-dimensional quantities.
+     */
+    
+    if (d_dim > tbox::Dimension(1))
+    {
+        const double mean_factor = (d_k == 2) ? double(1)/double(2) : double(1)/double(6);
+        
+        const int num_cells_wavelet_coeffs = static_cast<int>(ghost_box_wavelet_coeffs.size());
         
-        switch (d_k)
+        for (int li = 0; li < d_num_level; li++)
         {
-            case 2:
+#ifdef HAMERS_ENABLE_SIMD
+            #pragma omp simd
+#endif
+            for (int idx = 0; idx < num_cells_wavelet_coeffs; idx++)
+            {
+                w[li][idx] = sqrt(w[li][idx]);
+            }
+            
+            if (compute_variable_local_means)
             {
-                /*
-                 * Compute scaling and wavelet coefficients in the x-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the x-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(0);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + 1;
-                const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - 1;
-                
 #ifdef HAMERS_ENABLE_SIMD
                 #pragma omp simd
 #endif
-                for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
-                {
-                    // Compute the linear indices.
-                    const int idx = i + num_ghosts_0_wavelet_coeffs;
-                    
-                    const int idx_cell_data     = i + num_ghosts_0_cell_data;
-                    const int idx_cell_data_x_L = i - 1 + num_ghosts_0_cell_data;
-                    const int idx_cell_data_x_R = i + 1 + num_ghosts_0_cell_data;
-                    
-                    f_x[0][idx] = double(1)/double(2)*(f[idx_cell_data_x_L] + f[idx_cell_data_x_R]);
-                    
-                    w[0][idx] = double(-1)/double(2)*(f[idx_cell_data_x_L] - double(2)*f[idx_cell_data] +
-                                                      f[idx_cell_data_x_R]);
-                    w[0][idx] = fabs(w[0][idx]);
-                }
-                
-                if (compute_variable_local_means)
+                for (int idx = 0; idx < num_cells_wavelet_coeffs; idx++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear indices.
-                        const int idx = i + num_ghosts_0_wavelet_coeffs;
-                        
-                        const int idx_cell_data     = i + num_ghosts_0_cell_data;
-                        const int idx_cell_data_x_L = i - 1 + num_ghosts_0_cell_data;
-                        const int idx_cell_data_x_R = i + 1 + num_ghosts_0_cell_data;
-                        
-                        f_mean[0][idx] = double(1)/double(2)*(f[idx_cell_data_x_L] + double(2)*f[idx_cell_data] +
-                                                              f[idx_cell_data_x_R]);
-                    }
+                    f_mean[li][idx] = mean_factor*sqrt(f_mean[li][idx]);
                 }
-                
-                break;
             }
-            case 4:
+        }
+    }
+}
+
+
+/*
+ * Compute the scaling and wavelet coefficients at all levels along the lines in one direction.
+ * The lines are processed in blocks. For each block, the data is gathered into a contiguous
+ * buffer with the block index running fastest and all levels are computed from the buffers before
+ * moving on to the next block. In one dimension, the wavelet coefficients and local means are
+ * written directly. In multiple dimensions, their squares are accumulated into the output arrays.
+ */
+void
+WaveletTransformHarten::transformLinesInDirection(
+    std::vector<double*>& w,
+    std::vector<double*>& f_mean,
+    const double* const f,
+    const int direction,
+    const hier::IntVector& interior_dims,
+    const hier::IntVector& num_ghosts_cell_data,
+    const hier::IntVector& ghostcell_dims_cell_data,
+    const hier::IntVector& num_ghosts_wavelet_coeffs,
+    const hier::IntVector& ghostcell_dims_wavelet_coeffs)
+{
+    const int dim = d_dim.getValue();
+    
+    const bool compute_variable_local_means = !f_mean.empty();
+    
+    // Compute the strides of the cell data and wavelet coefficients in different directions.
+    int stride_cell_data[3] = {1, 1, 1};
+    int stride_wavelet_coeffs[3] = {1, 1, 1};
+    for (int di = 1; di < dim; di++)
+    {
+        stride_cell_data[di] = stride_cell_data[di - 1]*ghostcell_dims_cell_data[di - 1];
+        stride_wavelet_coeffs[di] = stride_wavelet_coeffs[di - 1]*ghostcell_dims_wavelet_coeffs[di - 1];
+    }
+    
+    const int stride_line_cell_data = stride_cell_data[direction];
+    const int stride_line_wavelet_coeffs = stride_wavelet_coeffs[direction];
+    
+    // Get the length of the lines.
+    const int num_ghosts_line = d_num_wavelet_ghosts[direction];
+    const int interior_dim_line = interior_dims[direction];
+    const int line_length = interior_dim_line + 2*num_ghosts_line;
+    
+    /*
+     * Get the transverse directions and their extents. Only the lines that contribute to the
+     * multi-dimensional wavelet coefficients at the coarsest level are required.
+     */
+    
+    const int transverse_width = d_p*pow(2, d_num_level);
+    
+    int transverse_directions[2] = {0, 0};
+    int transverse_extents[2] = {1, 1};
+    int num_transverse_directions = 0;
+    for (int di = 0; di < dim; di++)
+    {
+        if (di != direction)
+        {
+            transverse_directions[num_transverse_directions] = di;
+            transverse_extents[num_transverse_directions] = interior_dims[di] + 2*transverse_width;
+            num_transverse_directions++;
+        }
+    }
+    
+    const int num_lines = transverse_extents[0]*transverse_extents[1];
+    
+    const double mean_factor = (d_k == 2) ? double(1)/double(2) : double(1)/double(6);
+    
+    // Allocate the line buffers.
+    std::vector<double> f_lines_0(line_length*NUM_LINES_PER_BLOCK);
+    std::vector<double> f_lines_1(line_length*NUM_LINES_PER_BLOCK);
+    std::vector<double> w_lines(line_length*NUM_LINES_PER_BLOCK);
+    
+    int idx_base_cell_data[NUM_LINES_PER_BLOCK];
+    int idx_base_wavelet_coeffs[NUM_LINES_PER_BLOCK];
+    int dist_from_interior[NUM_LINES_PER_BLOCK];
+    
+    for (int l_start = 0; l_start < num_lines; l_start += NUM_LINES_PER_BLOCK)
+    {
+        const int num_lines_block = std::min(NUM_LINES_PER_BLOCK, num_lines - l_start);
+        
+        /*
+         * Compute the linear indices of the first interior cell of each line and the distance of
+         * the line from the interior of the patch.
+         */
+        
+        for (int b = 0; b < num_lines_block; b++)
+        {
+            const int l = l_start + b;
+            
+            int transverse_index[2] = {0, 0};
+            transverse_index[0] = l%transverse_extents[0] - transverse_width;
+            transverse_index[1] = l/transverse_extents[0] - transverse_width;
+            
+            idx_base_cell_data[b] = num_ghosts_cell_data[direction]*stride_line_cell_data;
+            idx_base_wavelet_coeffs[b] = num_ghosts_wavelet_coeffs[direction]*stride_line_wavelet_coeffs;
+            dist_from_interior[b] = 0;
+            
+            for (int ti = 0; ti < num_transverse_directions; ti++)
             {
-                /*
-                 * Compute scaling and wavelet coefficients in the x-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the x-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(0);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
+                const int dt = transverse_directions[ti];
+                const int t = transverse_index[ti];
                 
-                // Compute the starting and ending indices.
-                const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + 2;
-                const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - 2;
+                idx_base_cell_data[b] += (t + num_ghosts_cell_data[dt])*stride_cell_data[dt];
+                idx_base_wavelet_coeffs[b] += (t + num_ghosts_wavelet_coeffs[dt])*stride_wavelet_coeffs[dt];
                 
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
+                if (t < 0)
                 {
-                    // Compute the linear indices.
-                    const int idx = i + num_ghosts_0_wavelet_coeffs;
-                    
-                    const int idx_cell_data      = i + num_ghosts_0_cell_data;
-                    const int idx_cell_data_x_LL = i - 2 + num_ghosts_0_cell_data;
-                    const int idx_cell_data_x_L  = i - 1 + num_ghosts_0_cell_data;
-                    const int idx_cell_data_x_R  = i + 1 + num_ghosts_0_cell_data;
-                    const int idx_cell_data_x_RR = i + 2 + num_ghosts_0_cell_data;
-                    
-                    f_x[0][idx] = double(1)/double(6)*(-f[idx_cell_data_x_LL] + double(4)*f[idx_cell_data_x_L] +
-                                                       double(4)*f[idx_cell_data_x_R] - f[idx_cell_data_x_RR]);
-                    
-                    w[0][idx] = double(1)/double(6)*(f[idx_cell_data_x_LL] - double(4)*f[idx_cell_data_x_L] +
-                                                     double(6)*f[idx_cell_data] - double(4)*f[idx_cell_data_x_R] +
-                                                     f[idx_cell_data_x_RR]);
-                    
-                    w[0][idx] = fabs(w[0][idx]);
+                    dist_from_interior[b] = std::max(dist_from_interior[b], -t);
                 }
-                
-                if (compute_variable_local_means)
+                else if (t >= interior_dims[dt])
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = 0; i < interior_dim_0; i++)
-                    {
-                        // Compute the linear indices.
-                        const int idx = i + num_ghosts_0_wavelet_coeffs;
-                        
-                        const int idx_cell_data      = i + num_ghosts_0_cell_data;
-                        const int idx_cell_data_x_LL = i - 2 + num_ghosts_0_cell_data;
-                        const int idx_cell_data_x_L  = i - 1 + num_ghosts_0_cell_data;
-                        const int idx_cell_data_x_R  = i + 1 + num_ghosts_0_cell_data;
-                        const int idx_cell_data_x_RR = i + 2 + num_ghosts_0_cell_data;
-                        
-                        f_mean[0][idx] = double(1)/double(6)*(f[idx_cell_data_x_LL] + double(4)*f[idx_cell_data_x_L] +
-                                                              double(6)*f[idx_cell_data] + double(4)*f[idx_cell_data_x_R] +
-                                                              f[idx_cell_data_x_RR]);
-                    }
+                    dist_from_interior[b] = std::max(dist_from_interior[b], t - interior_dims[dt] + 1);
                 }
-                
-                break;
             }
-            default:
+        }
+        
+        /*
+         * Gather the cell data of the block of lines.
+         */
+        
+        double* f_prev = f_lines_0.data();
+        double* f_next = f_lines_1.data();
+        
+        for (int m = 0; m < line_length; m++)
+        {
+            const int i = m - num_ghosts_line;
+            
+            for (int b = 0; b < num_lines_block; b++)
             {
-                TBOX_ERROR(d_object_name
-                    << ": WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans()\n"
-                    << "number of vanishing moments = "
-                    << d_k
-                    << " not supported."
-                    << std::endl);
+                f_prev[m*NUM_LINES_PER_BLOCK + b] = f[idx_base_cell_data[b] + i*stride_line_cell_data];
             }
         }
         
         /*
-         * Compute scaling and wavelet coefficients at higher levels.
+         * Compute scaling and wavelet coefficients at all levels.
          */
         
-        for (int li = 1; li < d_num_level; li++)
+        for (int li = 0; li < d_num_level; li++)
         {
             const int offset = pow(2, li);
             
+            // Compute the starting and ending indices along the lines.
+            const int m_lo = d_p*offset;
+            const int m_hi = line_length - d_q*offset;
+            
+            // Offsets of the stencil in the line buffers.
+            const int s_1 = offset*NUM_LINES_PER_BLOCK;
+            const int s_2 = 2*offset*NUM_LINES_PER_BLOCK;
+            
             switch (d_k)
             {
                 case 2:
                 {
-                    /*
-                     * Compute scaling and wavelet coefficients in the x-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + offset;
-                    const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - offset;
-                    
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
+                    for (int m = m_lo; m < m_hi; m++)
                     {
-                        // Compute the linear indices.
-                        const int idx     = i + num_ghosts_0_wavelet_coeffs;
-                        const int idx_x_L = i - offset + num_ghosts_0_wavelet_coeffs;
-                        const int idx_x_R = i + offset + num_ghosts_0_wavelet_coeffs;
-                        
-                        f_x[li][idx] = double(1)/double(2)*(f_x[li-1][idx_x_L] + f_x[li-1][idx_x_R]);
+                        const int idx_line = m*NUM_LINES_PER_BLOCK;
                         
-                        w[li][idx]   = double(-1)/double(2)*(f_x[li-1][idx_x_L] - double(2)*f_x[li-1][idx] +
-                                                             f_x[li-1][idx_x_R]);
-                        
-                        w[li][idx] = fabs(w[li][idx]);
+#ifdef HAMERS_ENABLE_SIMD
+                        #pragma omp simd
+#endif
+                        for (int b = 0; b < num_lines_block; b++)
+                        {
+                            const int idx   = idx_line + b;
+                            const int idx_L = idx - s_1;
+                            const int idx_R = idx + s_1;
+                            
+                            f_next[idx] = double(1)/double(2)*(f_prev[idx_L] + f_prev[idx_R]);
+                            
+                            w_lines[idx] = double(-1)/double(2)*(f_prev[idx_L] - double(2)*f_prev[idx] +
+                                                                 f_prev[idx_R]);
+                        }
                     }
                     
                     if (compute_variable_local_means)
                     {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = 0; i < interior_dim_0; i++)
+                        for (int b = 0; b < num_lines_block; b++)
                         {
-                            // Compute the linear indices.
-                            const int idx     = i + num_ghosts_0_wavelet_coeffs;
-                            const int idx_x_L = i - offset + num_ghosts_0_wavelet_coeffs;
-                            const int idx_x_R = i + offset + num_ghosts_0_wavelet_coeffs;
+                            if (dist_from_interior[b] > 0)
+                            {
+                                continue;
+                            }
                             
-                            f_mean[li][idx] = double(1)/double(2)*(f_x[li-1][idx_x_L] + double(2)*f_x[li-1][idx] +
-                                                                   f_x[li-1][idx_x_R]);
+#ifdef HAMERS_ENABLE_SIMD
+                            #pragma omp simd
+#endif
+                            for (int i = 0; i < interior_dim_line; i++)
+                            {
+                                const int idx   = (i + num_ghosts_line)*NUM_LINES_PER_BLOCK + b;
+                                const int idx_L = idx - s_1;
+                                const int idx_R = idx + s_1;
+                                
+                                const int idx_mean = idx_base_wavelet_coeffs[b] + i*stride_line_wavelet_coeffs;
+                                
+                                const double f_mean_line = f_prev[idx_L] + double(2)*f_prev[idx] + f_prev[idx_R];
+                                
+                                if (dim == 1)
+                                {
+                                    f_mean[li][idx_mean] = mean_factor*f_mean_line;
+                                }
+                                else
+                                {
+                                    f_mean[li][idx_mean] += f_mean_line*f_mean_line;
+                                }
+                            }
                         }
                     }
                     
@@ -465,53 +516,64 @@ WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans(
                 }
                 case 4:
                 {
-                    /*
-                     * Compute scaling and wavelet coefficients in the x-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + 2*offset;
-                    const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - 2*offset;
-                    
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
+                    for (int m = m_lo; m < m_hi; m++)
                     {
-                        // Compute indices.
-                        const int idx      = i + num_ghosts_0_wavelet_coeffs;
-                        const int idx_x_LL = i - 2*offset + num_ghosts_0_wavelet_coeffs;
-                        const int idx_x_L  = i - offset + num_ghosts_0_wavelet_coeffs;
-                        const int idx_x_R  = i + offset + num_ghosts_0_wavelet_coeffs;
-                        const int idx_x_RR = i + 2*offset + num_ghosts_0_wavelet_coeffs;
-                        
-                        f_x[li][idx] = double(1)/double(6)*(-f_x[li-1][idx_x_LL] + double(4)*f_x[li-1][idx_x_L] +
-                                                            double(4)*f_x[li-1][idx_x_R] - f_x[li-1][idx_x_RR]);
+                        const int idx_line = m*NUM_LINES_PER_BLOCK;
                         
-                        w[li][idx] = double(1)/double(6)*(f_x[li-1][idx_x_LL] - double(4)*f_x[li-1][idx_x_L] +
-                                                          double(6)*f_x[li-1][idx] - double(4)*f_x[li-1][idx_x_R] +
-                                                          f_x[li-1][idx_x_RR]);
-                        
-                        w[li][idx] = fabs(w[li][idx]);
+#ifdef HAMERS_ENABLE_SIMD
+                        #pragma omp simd
+#endif
+                        for (int b = 0; b < num_lines_block; b++)
+                        {
+                            const int idx    = idx_line + b;
+                            const int idx_LL = idx - s_2;
+                            const int idx_L  = idx - s_1;
+                            const int idx_R  = idx + s_1;
+                            const int idx_RR = idx + s_2;
+                            
+                            f_next[idx] = double(1)/double(6)*(-f_prev[idx_LL] + double(4)*f_prev[idx_L] +
+                                                               double(4)*f_prev[idx_R] - f_prev[idx_RR]);
+                            
+                            w_lines[idx] = double(1)/double(6)*(f_prev[idx_LL] - double(4)*f_prev[idx_L] +
+                                                                double(6)*f_prev[idx] - double(4)*f_prev[idx_R] +
+                                                                f_prev[idx_RR]);
+                        }
                     }
                     
                     if (compute_variable_local_means)
                     {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = 0; i < interior_dim_0; i++)
+                        for (int b = 0; b < num_lines_block; b++)
                         {
-                            // Compute indices.
-                            const int idx      = i + num_ghosts_0_wavelet_coeffs;
-                            const int idx_x_LL = i - 2*offset + num_ghosts_0_wavelet_coeffs;
-                            const int idx_x_L  = i - offset + num_ghosts_0_wavelet_coeffs;
-                            const int idx_x_R  = i + offset + num_ghosts_0_wavelet_coeffs;
-                            const int idx_x_RR = i + 2*offset + num_ghosts_0_wavelet_coeffs;
+                            if (dist_from_interior[b] > 0)
+                            {
+                                continue;
+                            }
                             
-                            f_mean[li][idx] = double(1)/double(6)*(f_x[li-1][idx_x_LL] + double(4)*f_x[li-1][idx_x_L] +
-                                                                   double(6)*f_x[li-1][idx] + double(4)*f_x[li-1][idx_x_R] +
-                                                                   f_x[li-1][idx_x_RR]);
+#ifdef HAMERS_ENABLE_SIMD
+                            #pragma omp simd
+#endif
+                            for (int i = 0; i < interior_dim_line; i++)
+                            {
+                                const int idx    = (i + num_ghosts_line)*NUM_LINES_PER_BLOCK + b;
+                                const int idx_LL = idx - s_2;
+                                const int idx_L  = idx - s_1;
+                                const int idx_R  = idx + s_1;
+                                const int idx_RR = idx + s_2;
+                                
+                                const int idx_mean = idx_base_wavelet_coeffs[b] + i*stride_line_wavelet_coeffs;
+                                
+                                const double f_mean_line = f_prev[idx_LL] + double(4)*f_prev[idx_L] +
+                                    double(6)*f_prev[idx] + double(4)*f_prev[idx_R] + f_prev[idx_RR];
+                                
+                                if (dim == 1)
+                                {
+                                    f_mean[li][idx_mean] = mean_factor*f_mean_line;
+                                }
+                                else
+                                {
+                                    f_mean[li][idx_mean] += f_mean_line*f_mean_line;
+                                }
+                            }
                         }
                     }
                     
@@ -520,1855 +582,56 @@ WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans(
                 default:
                 {
                     TBOX_ERROR(d_object_name
-                        << ": WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans()\n"
+                        << ": WaveletTransformHarten::transformLinesInDirection()\n"
                         << "number of vanishing moments = "
                         << d_k
                         << " not supported."
                         << std::endl);
                 }
             }
-        }
-    }
-    else if (d_dim == tbox::Dimension(2))
-    {
-        const int interior_dim_0 = interior_dims[0];
-        const int interior_dim_1 = interior_dims[1];
-        
-        const int num_ghosts_0_cell_data = num_ghosts_cell_data[0];
-        const int num_ghosts_1_cell_data = num_ghosts_cell_data[1];
-        const int ghostcell_dim_0_cell_data = ghostcell_dims_cell_data[0];
-        
-        const int num_ghosts_0_wavelet_coeffs = num_ghosts_wavelet_coeffs[0];
-        const int num_ghosts_1_wavelet_coeffs = num_ghosts_wavelet_coeffs[1];
-        const int ghostcell_dim_0_wavelet_coeffs = ghostcell_dims_wavelet_coeffs[0];
-        
-        // Allocate wavelet coefficients in different dimensions.
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > wavelet_coeffs_x;
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > wavelet_coeffs_y;
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > scaling_coeffs_x;
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > scaling_coeffs_y;
-        for (int li = 0; li < d_num_level; li++)
-        {
-            wavelet_coeffs_x.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-            wavelet_coeffs_y.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-            scaling_coeffs_x.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-            scaling_coeffs_y.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-        }
-        
-        // Get the pointers to the one-dimensional wavelet coefficients and initialize them with zero values.
-        std::vector<double*> w_x;
-        std::vector<double*> w_y;
-        std::vector<double*> f_x;
-        std::vector<double*> f_y;
-        for (int li = 0; li < d_num_level; li++)
-        {
-            w_x.push_back(wavelet_coeffs_x[li]->getPointer(0));
-            w_y.push_back(wavelet_coeffs_y[li]->getPointer(0));
-            f_x.push_back(scaling_coeffs_x[li]->getPointer(0));
-            f_y.push_back(scaling_coeffs_y[li]->getPointer(0));
             
-            wavelet_coeffs_x[li]->fillAll(double(0));
-            wavelet_coeffs_y[li]->fillAll(double(0));
-            scaling_coeffs_x[li]->fillAll(double(0));
-            scaling_coeffs_y[li]->fillAll(double(0));
-        }
-        
-        /*
-         * Compute scaling and wavelet coefficients at first level.
-         */
-        
-        switch (d_k)
-        {
-            case 2:
+            /*
+             * Write the wavelet coefficients of the block of lines. In one dimension, the absolute
+             * values are stored in the whole computed range. In multiple dimensions, the squares are
+             * accumulated in the range where the multi-dimensional coefficients are required.
+             */
+            
+            if (dim == 1)
             {
-                /*
-                 * Compute scaling and wavelet coefficients in the x-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the x-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(0);
-                }
-                else
+                for (int m = m_lo; m < m_hi; m++)
                 {
-                    f = cell_data->getPointer(depth);
+                    const int i = m - num_ghosts_line;
+                    
+                    w[li][idx_base_wavelet_coeffs[0] + i] = fabs(w_lines[m*NUM_LINES_PER_BLOCK]);
                 }
+            }
+            else
+            {
+                const int combined_width = d_p*pow(2, li + 1);
                 
-                // Compute the starting and ending indices.
-                const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + 1;
-                const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - 1;
-                const int j_bound_lo_x = -d_num_wavelet_ghosts[1];
-                const int j_bound_hi_x = interior_dim_1 + d_num_wavelet_ghosts[1];
+                const int m_lo_combined = std::max(m_lo, num_ghosts_line - combined_width);
+                const int m_hi_combined = std::min(m_hi, num_ghosts_line + interior_dim_line + combined_width);
                 
-                for (int j = j_bound_lo_x; j < j_bound_hi_x; j++)
+                for (int b = 0; b < num_lines_block; b++)
                 {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
+                    if (dist_from_interior[b] > combined_width)
                     {
-                        // Compute the linear indices.
-                        const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                            (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                        
-                        const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_x_L = (i - 1 + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_x_R = (i + 1 + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        f_x[0][idx] = double(1)/double(2)*(f[idx_cell_data_x_L] + f[idx_cell_data_x_R]);
-                        
-                        w_x[0][idx] = double(-1)/double(2)*(f[idx_cell_data_x_L] - double(2)*f[idx_cell_data] +
-                                                            f[idx_cell_data_x_R]);
+                        continue;
                     }
-                }
-                
-                /*
-                 * Compute scaling and wavelet coefficients in the y-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the y-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(1);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_y = -d_num_wavelet_ghosts[0];
-                const int i_bound_hi_y = interior_dim_0 + d_num_wavelet_ghosts[0];
-                const int j_bound_lo_y = -d_num_wavelet_ghosts[1] + 1;
-                const int j_bound_hi_y = interior_dim_1 + d_num_wavelet_ghosts[1] - 1;
-                
-                for (int j = j_bound_lo_y; j < j_bound_hi_y; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = i_bound_lo_y; i < i_bound_hi_y; i++)
+                    
+                    double* w_li = w[li] + idx_base_wavelet_coeffs[b];
+                    
+                    for (int m = m_lo_combined; m < m_hi_combined; m++)
                     {
-                        // Compute the linear indices.
-                        const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                            (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
+                        const int i = m - num_ghosts_line;
+                        const double w_line = w_lines[m*NUM_LINES_PER_BLOCK + b];
                         
-                        const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_y_B = (i + num_ghosts_0_cell_data) +
-                            (j - 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_y_T = (i + num_ghosts_0_cell_data) +
-                            (j + 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        f_y[0][idx] = double(1)/double(2)*(f[idx_cell_data_y_B] + f[idx_cell_data_y_T]);
-                        
-                        w_y[0][idx] = double(-1)/double(2)*(f[idx_cell_data_y_B] - double(2)*f[idx_cell_data] +
-                                                            f[idx_cell_data_y_T]);
-                    }
-                }
-                
-                if (compute_variable_local_means)
-                {
-                    for (int j = 0; j < interior_dim_1; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = 0; i < interior_dim_0; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_x_L = (i - 1 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_x_R = (i + 1 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_y_B = (i + num_ghosts_0_cell_data) +
-                                (j - 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_y_T = (i + num_ghosts_0_cell_data) +
-                                (j + 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            double f_mean_x = f[idx_cell_data_x_L] + double(2)*f[idx_cell_data] +
-                                              f[idx_cell_data_x_R];
-                            
-                            double f_mean_y = f[idx_cell_data_y_B] + double(2)*f[idx_cell_data] +
-                                              f[idx_cell_data_y_T];
-                            
-                            f_mean[0][idx] = double(1)/double(2)*sqrt(f_mean_x*f_mean_x + f_mean_y*f_mean_y);
-                        }
+                        w_li[i*stride_line_wavelet_coeffs] += w_line*w_line;
                     }
                 }
-                
-                break;
             }
-            case 4:
-            {
-                /*
-                 * Compute scaling and wavelet coefficients in the x-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the x-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(0);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + 2;
-                const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - 2;
-                const int j_bound_lo_x = -d_num_wavelet_ghosts[1];
-                const int j_bound_hi_x = interior_dim_1 + d_num_wavelet_ghosts[1];
-                
-                for (int j = j_bound_lo_x; j < j_bound_hi_x; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
-                    {
-                        // Compute the linear indices.
-                        const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                            (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                        
-                        const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_x_LL = (i - 2 + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_x_L = (i - 1 + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_x_R = (i + 1 + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_x_RR = (i + 2 + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        f_x[0][idx] = double(1)/double(6)*(-f[idx_cell_data_x_LL] + double(4)*f[idx_cell_data_x_L] +
-                                                           double(4)*f[idx_cell_data_x_R] - f[idx_cell_data_x_RR]);
-                        
-                        w_x[0][idx] = double(1)/double(6)*(f[idx_cell_data_x_LL] - double(4)*f[idx_cell_data_x_L] +
-                                                           double(6)*f[idx_cell_data] - double(4)*f[idx_cell_data_x_R] +
-                                                           f[idx_cell_data_x_RR]);
-                    }
-                }
-                
-                /*
-                 * Compute scaling and wavelet coefficients in the y-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the y-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(1);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_y = -d_num_wavelet_ghosts[0];
-                const int i_bound_hi_y = interior_dim_0 + d_num_wavelet_ghosts[0];
-                const int j_bound_lo_y = -d_num_wavelet_ghosts[1] + 2;
-                const int j_bound_hi_y = interior_dim_1 + d_num_wavelet_ghosts[1] - 2;
-                
-                for (int j = j_bound_lo_y; j < j_bound_hi_y; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = i_bound_lo_y; i < i_bound_hi_y; i++)
-                    {
-                        // Compute indices.
-                        const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                            (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                        
-                        const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                            (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_y_BB = (i + num_ghosts_0_cell_data) +
-                            (j - 2 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_y_B = (i + num_ghosts_0_cell_data) +
-                            (j - 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_y_T = (i + num_ghosts_0_cell_data) +
-                            (j + 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        const int idx_cell_data_y_TT = (i + num_ghosts_0_cell_data) +
-                            (j + 2 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                        
-                        f_y[0][idx] = double(1)/double(6)*(-f[idx_cell_data_y_BB] + double(4)*f[idx_cell_data_y_B] +
-                                                           double(4)*f[idx_cell_data_y_T] - f[idx_cell_data_y_TT]);
-                        
-                        w_y[0][idx] = double(1)/double(6)*(f[idx_cell_data_y_BB] - double(4)*f[idx_cell_data_y_B] +
-                                                           double(6)*f[idx_cell_data] - double(4)*f[idx_cell_data_y_T] +
-                                                           f[idx_cell_data_y_TT]);
-                    }
-                }
-                
-                if (compute_variable_local_means)
-                {
-                    for (int j = 0; j < interior_dim_1; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = 0; i < interior_dim_0; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_x_LL = (i - 2 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_x_L = (i - 1 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_x_R = (i + 1 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_x_RR = (i + 2 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_y_BB = (i + num_ghosts_0_cell_data) +
-                                (j - 2 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_y_B = (i + num_ghosts_0_cell_data) +
-                                (j - 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_y_T = (i + num_ghosts_0_cell_data) +
-                                (j + 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            const int idx_cell_data_y_TT = (i + num_ghosts_0_cell_data) +
-                                (j + 2 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data;
-                            
-                            double f_mean_x = f[idx_cell_data_x_LL] + double(4)*f[idx_cell_data_x_L] +
-                                double(6)*f[idx_cell_data] + double(4)*f[idx_cell_data_x_R] + f[idx_cell_data_x_RR];
-                            
-                            double f_mean_y = f[idx_cell_data_y_BB] + double(4)*f[idx_cell_data_y_B] +
-                                double(6)*f[idx_cell_data] + double(4)*f[idx_cell_data_y_T] + f[idx_cell_data_y_TT];
-                            
-                            f_mean[0][idx] = double(1)/double(6)*sqrt(f_mean_x*f_mean_x + f_mean_y*f_mean_y);
-                        }
-                    }
-                }
-                
-                break;
-            }
-            default:
-            {
-                TBOX_ERROR(d_object_name
-                    << ": WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans()\n"
-                    << "number of vanishing moments = "
-                    << d_k
-                    << " not supported."
-                    << std::endl);
-            }
-        }
-        
-        /*
-         * Compute scaling and wavelet coefficients at higher levels.
-         */
-        
-        for (int li = 1; li < d_num_level; li++)
-        {
-            const int offset = pow(2, li);
-            
-            switch (d_k)
-            {
-                case 2:
-                {
-                    /*
-                     * Compute scaling and wavelet coefficients in the x-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + offset;
-                    const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - offset;
-                    const int j_bound_lo_x = -d_num_wavelet_ghosts[1];
-                    const int j_bound_hi_x = interior_dim_1 + d_num_wavelet_ghosts[1];
-                    
-                    for (int j = j_bound_lo_x; j < j_bound_hi_x; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_x_L = (i - offset + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_x_R = (i + offset + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            f_x[li][idx] = double(1)/double(2)*(f_x[li-1][idx_x_L] + f_x[li-1][idx_x_R]);
-                            
-                            w_x[li][idx] = double(-1)/double(2)*(f_x[li-1][idx_x_L] - double(2)*f_x[li-1][idx] +
-                                                                 f_x[li-1][idx_x_R]);
-                        }
-                    }
-                    
-                    /*
-                     * Compute scaling and wavelet coefficients in the y-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_y = -d_num_wavelet_ghosts[0];
-                    const int i_bound_hi_y = interior_dim_0 + d_num_wavelet_ghosts[0];
-                    const int j_bound_lo_y = -d_num_wavelet_ghosts[1] + offset;
-                    const int j_bound_hi_y = interior_dim_1 + d_num_wavelet_ghosts[1] - offset;
-                    
-                    for (int j = j_bound_lo_y; j < j_bound_hi_y; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_y; i < i_bound_hi_y; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_y_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j - offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_y_T = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            f_y[li][idx] = double(1)/double(2)*(f_y[li-1][idx_y_B] + f_y[li-1][idx_y_T]);
-                            
-                            w_y[li][idx] = double(-1)/double(2)*(f_y[li-1][idx_y_B] - double(2)*f_y[li-1][idx] +
-                                                                 f_y[li-1][idx_y_T]);
-                        }
-                    }
-                    
-                    if (compute_variable_local_means)
-                    {
-                        for (int j = 0; j < interior_dim_1; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = 0; i < interior_dim_0; i++)
-                            {
-                                // Compute the linear indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_x_L = (i - offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_x_R = (i + offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_y_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j - offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_y_T = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                double f_mean_x = f_x[li-1][idx_x_L] + double(2)*f_x[li-1][idx] +
-                                    f_x[li-1][idx_x_R];
-                                
-                                double f_mean_y = f_y[li-1][idx_y_B] + double(2)*f_y[li-1][idx] +
-                                    f_y[li-1][idx_y_T];
-                                
-                                f_mean[li][idx] = double(1)/double(2)*sqrt(f_mean_x*f_mean_x + f_mean_y*f_mean_y);
-                            }
-                        }
-                    }
-                    
-                    break;
-                }
-                case 4:
-                {
-                    /*
-                     * Compute scaling and wavelet coefficients in the x-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + 2*offset;
-                    const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - 2*offset;
-                    const int j_bound_lo_x = -d_num_wavelet_ghosts[1];
-                    const int j_bound_hi_x = interior_dim_1 + d_num_wavelet_ghosts[1];
-                    
-                    for (int j = j_bound_lo_x; j < j_bound_hi_x; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_x_LL = (i - 2*offset + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_x_L = (i - offset + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_x_R = (i + offset + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_x_RR = (i + 2*offset + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            f_x[li][idx] = double(1)/double(6)*(-f_x[li-1][idx_x_LL] + double(4)*f_x[li-1][idx_x_L] +
-                                                                double(4)*f_x[li-1][idx_x_R] - f_x[li-1][idx_x_RR]);
-                            
-                            w_x[li][idx] = double(1)/double(6)*(f_x[li-1][idx_x_LL] - double(4)*f_x[li-1][idx_x_L] +
-                                                                double(6)*f_x[li-1][idx] - double(4)*f_x[li-1][idx_x_R] +
-                                                                f_x[li-1][idx_x_RR]);
-                        }
-                    }
-                    
-                    /*
-                     * Compute scaling and wavelet coefficients in the y-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_y = -d_num_wavelet_ghosts[0];
-                    const int i_bound_hi_y = interior_dim_0 + d_num_wavelet_ghosts[0];
-                    const int j_bound_lo_y = -d_num_wavelet_ghosts[1] + 2*offset;
-                    const int j_bound_hi_y = interior_dim_1 + d_num_wavelet_ghosts[1] - 2*offset;
-                    
-                    for (int j = j_bound_lo_y; j < j_bound_hi_y; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_y; i < i_bound_hi_y; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_y_BB = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j - 2*offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_y_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j - offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_y_T = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            const int idx_y_TT = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + 2*offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                            
-                            f_y[li][idx] = double(1)/double(6)*(-f_y[li-1][idx_y_BB] + double(4)*f_y[li-1][idx_y_B] +
-                                                                double(4)*f_y[li-1][idx_y_T] - f_y[li-1][idx_y_TT]);
-                            
-                            w_y[li][idx] = double(1)/double(6)*(f_y[li-1][idx_y_BB] - double(4)*f_y[li-1][idx_y_B] +
-                                                                double(6)*f_y[li-1][idx] - double(4)*f_y[li-1][idx_y_T] +
-                                                                f_y[li-1][idx_y_TT]);
-                        }
-                    }
-                    
-                    if (compute_variable_local_means)
-                    {
-                        for (int j = 0; j < interior_dim_1; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = 0; i < interior_dim_0; i++)
-                            {
-                                // Compute the linear indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_x_LL = (i - 2*offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_x_L = (i - offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_x_R = (i + offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_x_RR = (i + 2*offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_y_BB = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j - 2*offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_y_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j - offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_y_T = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                const int idx_y_TT = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + 2*offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                                
-                                double f_mean_x = f_x[li-1][idx_x_LL] + double(4)*f_x[li-1][idx_x_L] +
-                                    double(6)*f_x[li-1][idx] + double(4)*f_x[li-1][idx_x_R] + f_x[li-1][idx_x_RR];
-                                
-                                double f_mean_y = f_y[li-1][idx_y_BB] + double(4)*f_y[li-1][idx_y_B] +
-                                    double(6)*f_y[li-1][idx] + double(4)*f_y[li-1][idx_y_T] + f_y[li-1][idx_y_TT];
-                                
-                                f_mean[li][idx] = double(1)/double(6)*sqrt(f_mean_x*f_mean_x + f_mean_y*f_mean_y);
-                            }
-                        }
-                    }
-                    
-                    break;
-                }
-                default:
-                {
-                    TBOX_ERROR(d_object_name
-                        << ": WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans()\n"
-                        << "number of vanishing moments = "
-                        << d_k
-                        << " not supported."
-                        << std::endl);
-                }
-            }
-        }
-        
-        /*
-         * Compute the two-dimensional wavelet coefficients from the one-dimensional wavelet coefficients.
-         */
-        
-        for (int li = 0; li < d_num_level; li++)
-        {
-            const int offset = pow(2, li + 1);
-            
-            // Compute the starting and ending indices.
-            const int start_index_i = -d_p*offset;
-            const int end_index_i = interior_dim_0 + d_q*offset;
-            const int start_index_j = -d_p*offset;
-            const int end_index_j = interior_dim_1 + d_q*offset;
-            
-            for (int j = start_index_j; j < end_index_j; j++)
-            {
-#ifdef HAMERS_ENABLE_SIMD
-                #pragma omp simd
-#endif
-                for (int i = start_index_i; i < end_index_i; i++)
-                {
-                    const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs;
-                    
-                    w[li][idx] = sqrt(w_x[li][idx]*w_x[li][idx] + w_y[li][idx]*w_y[li][idx]);
-                }
-            }
-        }
-    }
-    else if (d_dim == tbox::Dimension(3))
-    {
-        const int interior_dim_0 = interior_dims[0];
-        const int interior_dim_1 = interior_dims[1];
-        const int interior_dim_2 = interior_dims[2];
-        
-        const int num_ghosts_0_cell_data = num_ghosts_cell_data[0];
-        const int num_ghosts_1_cell_data = num_ghosts_cell_data[1];
-        const int num_ghosts_2_cell_data = num_ghosts_cell_data[2];
-        const int ghostcell_dim_0_cell_data = ghostcell_dims_cell_data[0];
-        const int ghostcell_dim_1_cell_data = ghostcell_dims_cell_data[1];
-        
-        const int num_ghosts_0_wavelet_coeffs = num_ghosts_wavelet_coeffs[0];
-        const int num_ghosts_1_wavelet_coeffs = num_ghosts_wavelet_coeffs[1];
-        const int num_ghosts_2_wavelet_coeffs = num_ghosts_wavelet_coeffs[2];
-        const int ghostcell_dim_0_wavelet_coeffs = ghostcell_dims_wavelet_coeffs[0];
-        const int ghostcell_dim_1_wavelet_coeffs = ghostcell_dims_wavelet_coeffs[1];
-        
-        // Allocate wavelet coefficients in different dimensions.
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > wavelet_coeffs_x;
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > wavelet_coeffs_y;
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > wavelet_coeffs_z;
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > scaling_coeffs_x;
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > scaling_coeffs_y;
-        std::vector<boost::shared_ptr<pdat::CellData<double> > > scaling_coeffs_z;
-        for (int li = 0; li < d_num_level; li++)
-        {
-            wavelet_coeffs_x.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-            wavelet_coeffs_y.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-            wavelet_coeffs_z.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-            scaling_coeffs_x.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-            scaling_coeffs_y.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-            scaling_coeffs_z.push_back(boost::make_shared<pdat::CellData<double> >(
-                interior_box, 1, num_ghosts_wavelet_coeffs));
-        }
-        
-        // Get the pointers to the one-dimensional wavelet coefficients and initialize them with zero values.
-        std::vector<double*> w_x;
-        std::vector<double*> w_y;
-        std::vector<double*> w_z;
-        std::vector<double*> f_x;
-        std::vector<double*> f_y;
-        std::vector<double*> f_z;
-        for (int li = 0; li < d_num_level; li++)
-        {
-            w_x.push_back(wavelet_coeffs_x[li]->getPointer(0));
-            w_y.push_back(wavelet_coeffs_y[li]->getPointer(0));
-            w_z.push_back(wavelet_coeffs_z[li]->getPointer(0));
-            f_x.push_back(scaling_coeffs_x[li]->getPointer(0));
-            f_y.push_back(scaling_coeffs_y[li]->getPointer(0));
-            f_z.push_back(scaling_coeffs_z[li]->getPointer(0));
-            
-            wavelet_coeffs_x[li]->fillAll(double(0));
-            wavelet_coeffs_y[li]->fillAll(double(0));
-            wavelet_coeffs_z[li]->fillAll(double(0));
-            scaling_coeffs_x[li]->fillAll(double(0));
-            scaling_coeffs_y[li]->fillAll(double(0));
-            scaling_coeffs_z[li]->fillAll(double(0));
-        }
-        
-        /*
-         * Compute scaling and wavelet coefficients at first level.
-         */
-        switch (d_k)
-        {
-            case 2:
-            {
-                /*
-                 * Compute scaling and wavelet coefficients in the x-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the x-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(0);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + 1;
-                const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - 1;
-                const int j_bound_lo_x = -d_num_wavelet_ghosts[1];
-                const int j_bound_hi_x = interior_dim_1 + d_num_wavelet_ghosts[1];
-                const int k_bound_lo_x = -d_num_wavelet_ghosts[2];
-                const int k_bound_hi_x = interior_dim_2 + d_num_wavelet_ghosts[2];
-                
-                for (int k = k_bound_lo_x; k < k_bound_hi_x; k++)
-                {
-                    for (int j = j_bound_lo_x; j < j_bound_hi_x; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                    ghostcell_dim_1_wavelet_coeffs;
-                            
-                            const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_x_L = (i - 1 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_x_R = (i + 1 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            f_x[0][idx] = double(1)/double(2)*(f[idx_cell_data_x_L] + f[idx_cell_data_x_R]);
-                            
-                            w_x[0][idx] = double(-1)/double(2)*(f[idx_cell_data_x_L] - double(2)*f[idx_cell_data] +
-                                                                f[idx_cell_data_x_R]);
-                        }
-                    }
-                }
-                
-                /*
-                 * Compute scaling and wavelet coefficients in the y-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the y-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(1);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_y = -d_num_wavelet_ghosts[0];
-                const int i_bound_hi_y = interior_dim_0 + d_num_wavelet_ghosts[0];
-                const int j_bound_lo_y = -d_num_wavelet_ghosts[1] + 1;
-                const int j_bound_hi_y = interior_dim_1 + d_num_wavelet_ghosts[1] - 1;
-                const int k_bound_lo_y = -d_num_wavelet_ghosts[2];
-                const int k_bound_hi_y = interior_dim_2 + d_num_wavelet_ghosts[2];
-                
-                for (int k = k_bound_lo_y; k < k_bound_hi_y; k++)
-                {
-                    for (int j = j_bound_lo_y; j < j_bound_hi_y; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_y; i < i_bound_hi_y; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                    ghostcell_dim_1_wavelet_coeffs;
-                            
-                            const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_y_B = (i + num_ghosts_0_cell_data) +
-                                (j - 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_y_T = (i + num_ghosts_0_cell_data) +
-                                (j + 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            f_y[0][idx] = double(1)/double(2)*(f[idx_cell_data_y_B] + f[idx_cell_data_y_T]);
-                            
-                            w_y[0][idx] = double(-1)/double(2)*(f[idx_cell_data_y_B] - double(2)*f[idx_cell_data] +
-                                                                f[idx_cell_data_y_T]);
-                        }
-                    }
-                }
-                
-                /*
-                 * Compute scaling and wavelet coefficients in the z-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the z-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(2);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_z = -d_num_wavelet_ghosts[0];
-                const int i_bound_hi_z = interior_dim_0 + d_num_wavelet_ghosts[0];
-                const int j_bound_lo_z = -d_num_wavelet_ghosts[1];
-                const int j_bound_hi_z = interior_dim_1 + d_num_wavelet_ghosts[1];
-                const int k_bound_lo_z = -d_num_wavelet_ghosts[2] + 1;
-                const int k_bound_hi_z = interior_dim_2 + d_num_wavelet_ghosts[1] - 1;
-                
-                for (int k = k_bound_lo_z; k < k_bound_hi_z; k++)
-                {
-                    for (int j = j_bound_lo_z; j < j_bound_hi_z; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_z; i < i_bound_hi_z; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                    ghostcell_dim_1_wavelet_coeffs;
-                            
-                            const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_z_B = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k - 1 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_z_F = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + 1 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            f_z[0][idx] = double(1)/double(2)*(f[idx_cell_data_z_B] + f[idx_cell_data_z_F]);
-                            
-                            w_z[0][idx] = double(-1)/double(2)*(f[idx_cell_data_z_B] - double(2)*f[idx_cell_data] +
-                                                                f[idx_cell_data_z_F]);
-                        }
-                    }
-                }
-                
-                if (compute_variable_local_means)
-                {
-                    for (int k = 0; k < interior_dim_2; k++)
-                    {
-                        for (int j = 0; j < interior_dim_1; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = 0; i < interior_dim_0; i++)
-                            {
-                                // Compute the indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_x_L = (i - 1 + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_x_R = (i + 1 + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_y_B = (i + num_ghosts_0_cell_data) +
-                                    (j - 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_y_T = (i + num_ghosts_0_cell_data) +
-                                    (j + 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_z_B = (i + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k - 1 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_z_F = (i + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + 1 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                double f_mean_x = f[idx_cell_data_x_L] + double(2)*f[idx_cell_data] +
-                                    f[idx_cell_data_x_R];
-                                
-                                double f_mean_y = f[idx_cell_data_y_B] + double(2)*f[idx_cell_data] +
-                                    f[idx_cell_data_y_T];
-                                
-                                double f_mean_z = f[idx_cell_data_z_B] + double(2)*f[idx_cell_data] +
-                                    f[idx_cell_data_z_F];
-                                
-                                f_mean[0][idx] = double(1)/double(2)*sqrt(f_mean_x*f_mean_x + f_mean_y*f_mean_y +
-                                                                          f_mean_z*f_mean_z);
-                            }
-                        }
-                    }
-                }
-                
-                break;
-            }
-            case 4:
-            {
-                /*
-                 * Compute scaling and wavelet coefficients in the x-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the x-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(0);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + 2;
-                const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - 2;
-                const int j_bound_lo_x = -d_num_wavelet_ghosts[1];
-                const int j_bound_hi_x = interior_dim_1 + d_num_wavelet_ghosts[1];
-                const int k_bound_lo_x = -d_num_wavelet_ghosts[2];
-                const int k_bound_hi_x = interior_dim_2 + d_num_wavelet_ghosts[2];
-                
-                for (int k = k_bound_lo_x; k < k_bound_hi_x; k++)
-                {
-                    for (int j = j_bound_lo_x; j < j_bound_hi_x; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
-                        {
-                            // Compute the indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                    ghostcell_dim_1_wavelet_coeffs;
-                            
-                            const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_x_LL = (i - 2 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_x_L = (i - 1 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_x_R = (i + 1 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_x_RR = (i + 2 + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            f_x[0][idx] = double(1)/double(6)*(-f[idx_cell_data_x_LL] + double(4)*f[idx_cell_data_x_L] +
-                                                               double(4)*f[idx_cell_data_x_R] - f[idx_cell_data_x_RR]);
-                            
-                            w_x[0][idx] = double(1)/double(6)*(f[idx_cell_data_x_LL] - double(4)*f[idx_cell_data_x_L] +
-                                                               double(6)*f[idx_cell_data] - double(4)*f[idx_cell_data_x_R] +
-                                                               f[idx_cell_data_x_RR]);
-                        }
-                    }
-                }
-                
-                /*
-                 * Compute scaling and wavelet coefficients in the y-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the y-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(1);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_y = -d_num_wavelet_ghosts[0];
-                const int i_bound_hi_y = interior_dim_0 + d_num_wavelet_ghosts[0];
-                const int j_bound_lo_y = -d_num_wavelet_ghosts[1] + 2;
-                const int j_bound_hi_y = interior_dim_1 + d_num_wavelet_ghosts[1] - 2;
-                const int k_bound_lo_y = -d_num_wavelet_ghosts[2];
-                const int k_bound_hi_y = interior_dim_2 + d_num_wavelet_ghosts[2];
-                
-                for (int k = k_bound_lo_y; k < k_bound_hi_y; k++)
-                {
-                    for (int j = j_bound_lo_y; j < j_bound_hi_y; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_y; i < i_bound_hi_y; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                    ghostcell_dim_1_wavelet_coeffs;
-                            
-                            const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_y_BB = (i + num_ghosts_0_cell_data) +
-                                (j - 2 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_y_B = (i + num_ghosts_0_cell_data) +
-                                (j - 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_y_T = (i + num_ghosts_0_cell_data) +
-                                (j + 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_y_TT = (i + num_ghosts_0_cell_data) +
-                                (j + 2 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            f_y[0][idx] = double(1)/double(6)*(-f[idx_cell_data_y_BB] + double(4)*f[idx_cell_data_y_B] +
-                                                               double(4)*f[idx_cell_data_y_T] - f[idx_cell_data_y_TT]);
-                            
-                            w_y[0][idx] = double(1)/double(6)*(f[idx_cell_data_y_BB] - double(4)*f[idx_cell_data_y_B] +
-                                                               double(6)*f[idx_cell_data] - double(4)*f[idx_cell_data_y_T] +
-                                                               f[idx_cell_data_y_TT]);
-                        }
-                    }
-                }
-                
-                /*
-                 * Compute scaling and wavelet coefficients in the z-direction.
-                 */
-                
-                // Get the pointer to the smoothed cell data in the z-direction.
-                if (smooth_cell_data)
-                {
-                    f = smoothed_cell_data->getPointer(2);
-                }
-                else
-                {
-                    f = cell_data->getPointer(depth);
-                }
-                
-                // Compute the starting and ending indices.
-                const int i_bound_lo_z = -d_num_wavelet_ghosts[0];
-                const int i_bound_hi_z = interior_dim_0 + d_num_wavelet_ghosts[0];
-                const int j_bound_lo_z = -d_num_wavelet_ghosts[1];
-                const int j_bound_hi_z = interior_dim_1 + d_num_wavelet_ghosts[1];
-                const int k_bound_lo_z = -d_num_wavelet_ghosts[2] + 2;
-                const int k_bound_hi_z = interior_dim_2 + d_num_wavelet_ghosts[1] - 2;
-                
-                for (int k = k_bound_lo_z; k < k_bound_hi_z; k++)
-                {
-                    for (int j = j_bound_lo_z; j < j_bound_hi_z; j++)
-                    {
-#ifdef HAMERS_ENABLE_SIMD
-                        #pragma omp simd
-#endif
-                        for (int i = i_bound_lo_z; i < i_bound_hi_z; i++)
-                        {
-                            // Compute the linear indices.
-                            const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                    ghostcell_dim_1_wavelet_coeffs;
-                            
-                            const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_z_BB = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k - 2 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_z_B = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k - 1 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_z_F = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + 1 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            const int idx_cell_data_z_FF = (i + num_ghosts_0_cell_data) +
-                                (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                (k + 2 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                    ghostcell_dim_1_cell_data;
-                            
-                            f_z[0][idx] = double(1)/double(6)*(-f[idx_cell_data_z_BB] + double(4)*f[idx_cell_data_z_B] +
-                                                               double(4)*f[idx_cell_data_z_F] - f[idx_cell_data_z_FF]);
-                            
-                            w_z[0][idx] = double(1)/double(6)*(f[idx_cell_data_z_BB] - double(4)*f[idx_cell_data_z_B] +
-                                                               double(6)*f[idx_cell_data] - double(4)*f[idx_cell_data_z_F] +
-                                                               f[idx_cell_data_z_FF]);
-                        }
-                    }
-                }
-                
-                if (compute_variable_local_means)
-                {
-                    for (int k = 0; k < interior_dim_2; k++)
-                    {
-                        for (int j = 0; j < interior_dim_1; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = 0; i < interior_dim_0; i++)
-                            {
-                                // Compute the linear indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_cell_data = (i + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_x_LL = (i - 2 + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_x_L = (i - 1 + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_x_R = (i + 1 + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_x_RR = (i + 2 + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_y_BB = (i + num_ghosts_0_cell_data) +
-                                    (j - 2 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_y_B = (i + num_ghosts_0_cell_data) +
-                                    (j - 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_y_T = (i + num_ghosts_0_cell_data) +
-                                    (j + 1 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_y_TT = (i + num_ghosts_0_cell_data) +
-                                    (j + 2 + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_z_BB = (i + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k - 2 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_z_B = (i + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k - 1 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_z_F = (i + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + 1 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                const int idx_cell_data_z_FF = (i + num_ghosts_0_cell_data) +
-                                    (j + num_ghosts_1_cell_data)*ghostcell_dim_0_cell_data +
-                                    (k + 2 + num_ghosts_2_cell_data)*ghostcell_dim_0_cell_data*
-                                        ghostcell_dim_1_cell_data;
-                                
-                                double f_mean_x = f[idx_cell_data_x_LL] + double(4)*f[idx_cell_data_x_L] +
-                                    double(6)*f[idx_cell_data] + double(4)*f[idx_cell_data_x_R] + f[idx_cell_data_x_RR];
-                                
-                                double f_mean_y = f[idx_cell_data_y_BB] + double(4)*f[idx_cell_data_y_B] +
-                                    double(6)*f[idx_cell_data] + double(4)*f[idx_cell_data_y_T] + f[idx_cell_data_y_TT];
-                                
-                                double f_mean_z = f[idx_cell_data_z_BB] + double(4)*f[idx_cell_data_z_B] +
-                                    double(6)*f[idx_cell_data] + double(4)*f[idx_cell_data_z_F] + f[idx_cell_data_z_FF];
-                                
-                                f_mean[0][idx] = double(1)/double(6)*sqrt(f_mean_x*f_mean_x + f_mean_y*f_mean_y +
-                                                                          f_mean_z*f_mean_z);
-                            }
-                        }
-                    }
-                }
-                
-                break;
-            }
-            default:
-            {
-                TBOX_ERROR(d_object_name
-                    << ": WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans()\n"
-                    << "number of vanishing moments = "
-                    << d_k
-                    << " not supported."
-                    << std::endl);
-            }
-        }
-        
-        /*
-         * Compute scaling and wavelet coefficients at higher levels.
-         */
-        
-        for (int li = 1; li < d_num_level; li++)
-        {
-            const int offset = pow(2, li);
-            
-            switch (d_k)
-            {
-                case 2:
-                {
-                    /*
-                     * Compute scaling and wavelet coefficients in the x-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + offset;
-                    const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - offset;
-                    const int j_bound_lo_x = -d_num_wavelet_ghosts[1];
-                    const int j_bound_hi_x = interior_dim_1 + d_num_wavelet_ghosts[1];
-                    const int k_bound_lo_x = -d_num_wavelet_ghosts[2];
-                    const int k_bound_hi_x = interior_dim_2 + d_num_wavelet_ghosts[2];
-                    
-                    for (int k = k_bound_lo_x; k < k_bound_hi_x; k++)
-                    {
-                        for (int j = j_bound_lo_x; j < j_bound_hi_x; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
-                            {
-                                // Compute the linear indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_x_L = (i - offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_x_R = (i + offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                f_x[li][idx] = double(1)/double(2)*(f_x[li-1][idx_x_L] + f_x[li-1][idx_x_R]);
-                                
-                                w_x[li][idx] = double(-1)/double(2)*(f_x[li-1][idx_x_L] - double(2)*f_x[li-1][idx] +
-                                                                     f_x[li-1][idx_x_R]);
-                            }
-                        }
-                    }
-                    
-                    /*
-                     * Compute scaling and wavelet coefficients in the y-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_y = -d_num_wavelet_ghosts[0];
-                    const int i_bound_hi_y = interior_dim_0 + d_num_wavelet_ghosts[0];
-                    const int j_bound_lo_y = -d_num_wavelet_ghosts[1] + offset ;
-                    const int j_bound_hi_y = interior_dim_1 + d_num_wavelet_ghosts[1] - offset;
-                    const int k_bound_lo_y = -d_num_wavelet_ghosts[2];
-                    const int k_bound_hi_y = interior_dim_2 + d_num_wavelet_ghosts[2];
-                    
-                    for (int k = k_bound_lo_y; k < k_bound_hi_y; k++)
-                    {
-                        for (int j = j_bound_lo_y; j < j_bound_hi_y; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = i_bound_lo_y; i < i_bound_hi_y; i++)
-                            {
-                                // Compute the linear indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_y_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j - offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_y_T = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                f_y[li][idx] = double(1)/double(2)*(f_y[li-1][idx_y_B] + f_y[li-1][idx_y_T]);
-                                
-                                w_y[li][idx] = double(-1)/double(2)*(f_y[li-1][idx_y_B] - double(2)*f_y[li-1][idx] +
-                                                                     f_y[li-1][idx_y_T]);
-                            }
-                        }
-                    }
-                    
-                    /*
-                     * Compute scaling and wavelet coefficients in the z-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_z = -d_num_wavelet_ghosts[0];
-                    const int i_bound_hi_z = interior_dim_0 + d_num_wavelet_ghosts[0];
-                    const int j_bound_lo_z = -d_num_wavelet_ghosts[1];
-                    const int j_bound_hi_z = interior_dim_1 + d_num_wavelet_ghosts[1];
-                    const int k_bound_lo_z = -d_num_wavelet_ghosts[2] + offset ;
-                    const int k_bound_hi_z = interior_dim_2 + d_num_wavelet_ghosts[2] - offset;
-                    
-                    for (int k = k_bound_lo_z; k < k_bound_hi_z; k++)
-                    {
-                        for (int j = j_bound_lo_z; j < j_bound_hi_z; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = i_bound_lo_z; i < i_bound_hi_z; i++)
-                            {
-                                // Compute the linear indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_z_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k - offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_z_F = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                f_z[li][idx] = double(1)/double(2)*(f_z[li-1][idx_z_B] + f_z[li-1][idx_z_F]);
-                                
-                                w_z[li][idx] = double(-1)/double(2)*(f_z[li-1][idx_z_B] - double(2)*f_z[li-1][idx] +
-                                                                     f_z[li-1][idx_z_F]);
-                            }
-                        }
-                    }
-                    
-                    if (compute_variable_local_means)
-                    {
-                        for (int k = 0; k < interior_dim_2; k++)
-                        {
-                            for (int j = 0; j < interior_dim_1; j++)
-                            {
-#ifdef HAMERS_ENABLE_SIMD
-                                #pragma omp simd
-#endif
-                                for (int i = 0; i < interior_dim_0; i++)
-                                {
-                                    // Compute the linear indices.
-                                    const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_x_L = (i - offset + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_x_R = (i + offset + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_y_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j - offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_y_T = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_z_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k - offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_z_F = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    double f_mean_x = f_x[li-1][idx_x_L] + double(2)*f_x[li-1][idx] +
-                                        f_x[li-1][idx_x_R];
-                                    
-                                    double f_mean_y = f_y[li-1][idx_y_B] + double(2)*f_y[li-1][idx] +
-                                        f_y[li-1][idx_y_T];
-                                    
-                                    double f_mean_z = f_z[li-1][idx_z_B] + double(2)*f_z[li-1][idx] +
-                                        f_z[li-1][idx_z_F];
-                                    
-                                    f_mean[li][idx] = double(1)/double(2)*sqrt(f_mean_x*f_mean_x + f_mean_y*f_mean_y +
-                                                                               f_mean_z*f_mean_z);
-                                }
-                            }
-                        }
-                    }
-                    
-                    break;
-                }
-                case 4:
-                {
-                    /*
-                     * Compute scaling and wavelet coefficients in the x-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_x = -d_num_wavelet_ghosts[0] + 2*offset;
-                    const int i_bound_hi_x = interior_dim_0 + d_num_wavelet_ghosts[0] - 2*offset;
-                    const int j_bound_lo_x = -d_num_wavelet_ghosts[1];
-                    const int j_bound_hi_x = interior_dim_1 + d_num_wavelet_ghosts[1];
-                    const int k_bound_lo_x = -d_num_wavelet_ghosts[2];
-                    const int k_bound_hi_x = interior_dim_2 + d_num_wavelet_ghosts[2];
-                    
-                    for (int k = k_bound_lo_x; k < k_bound_hi_x; k++)
-                    {
-                        for (int j = j_bound_lo_x; j < j_bound_hi_x; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = i_bound_lo_x; i < i_bound_hi_x; i++)
-                            {
-                                // Compute the linear indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_x_LL = (i - 2*offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_x_L = (i - offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_x_R = (i + offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_x_RR = (i + 2*offset + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                f_x[li][idx] = double(1)/double(6)*(-f_x[li-1][idx_x_LL] + double(4)*f_x[li-1][idx_x_L] +
-                                                                    double(4)*f_x[li-1][idx_x_R] - f_x[li-1][idx_x_RR]);
-                                
-                                w_x[li][idx] = double(1)/double(6)*(f_x[li-1][idx_x_LL] - double(4)*f_x[li-1][idx_x_L] +
-                                                                    double(6)*f_x[li-1][idx] - double(4)*f_x[li-1][idx_x_R] +
-                                                                    f_x[li-1][idx_x_RR]);
-                            }
-                        }
-                    }
-                    
-                    /*
-                     * Compute scaling and wavelet coefficients in the y-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_y = -d_num_wavelet_ghosts[0];
-                    const int i_bound_hi_y = interior_dim_0 + d_num_wavelet_ghosts[0];
-                    const int j_bound_lo_y = -d_num_wavelet_ghosts[1] + 2*offset;
-                    const int j_bound_hi_y = interior_dim_1 + d_num_wavelet_ghosts[1] - 2*offset;
-                    const int k_bound_lo_y = -d_num_wavelet_ghosts[2];
-                    const int k_bound_hi_y = interior_dim_2 + d_num_wavelet_ghosts[2];
-                    
-                    for (int k = k_bound_lo_y; k < k_bound_hi_y; k++)
-                    {
-                        for (int j = j_bound_lo_y; j < j_bound_hi_y; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = i_bound_lo_y; i < i_bound_hi_y; i++)
-                            {
-                                // Compute the linear indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_y_BB = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j - 2*offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_y_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j - offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_y_T = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_y_TT = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + 2*offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                f_y[li][idx] = double(1)/double(6)*(-f_y[li-1][idx_y_BB] + double(4)*f_y[li-1][idx_y_B] +
-                                                                    double(4)*f_y[li-1][idx_y_T] - f_y[li-1][idx_y_TT]);
-                                
-                                w_y[li][idx] = double(1)/double(6)*(f_y[li-1][idx_y_BB] - double(4)*f_y[li-1][idx_y_B] +
-                                                                    double(6)*f_y[li-1][idx] - double(4)*f_y[li-1][idx_y_T] +
-                                                                    f_y[li-1][idx_y_TT]);
-                            }
-                        }
-                    }
-                    
-                    /*
-                     * Compute scaling and wavelet coefficients in the z-direction.
-                     */
-                    
-                    // Compute the starting and ending indices.
-                    const int i_bound_lo_z = -d_num_wavelet_ghosts[0];
-                    const int i_bound_hi_z = interior_dim_0 + d_num_wavelet_ghosts[0];
-                    const int j_bound_lo_z = -d_num_wavelet_ghosts[1];
-                    const int j_bound_hi_z = interior_dim_1 + d_num_wavelet_ghosts[1];
-                    const int k_bound_lo_z = -d_num_wavelet_ghosts[2] + 2*offset;
-                    const int k_bound_hi_z = interior_dim_2 + d_num_wavelet_ghosts[2] - 2*offset;
-                    
-                    for (int k = k_bound_lo_z; k < k_bound_hi_z; k++)
-                    {
-                        for (int j = j_bound_lo_z; j < j_bound_hi_z; j++)
-                        {
-#ifdef HAMERS_ENABLE_SIMD
-                            #pragma omp simd
-#endif
-                            for (int i = i_bound_lo_z; i < i_bound_hi_z; i++)
-                            {
-                                // Compute indices.
-                                const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_z_BB = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k - 2*offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_z_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k - offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_z_F = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                const int idx_z_FF = (i + num_ghosts_0_wavelet_coeffs) +
-                                    (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                    (k + 2*offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                        ghostcell_dim_1_wavelet_coeffs;
-                                
-                                f_z[li][idx] = double(1)/double(6)*(-f_z[li-1][idx_z_BB] + double(4)*f_z[li-1][idx_z_B] +
-                                                                    double(4)*f_z[li-1][idx_z_F] - f_z[li-1][idx_z_FF]);
-                                
-                                w_z[li][idx] = double(1)/double(6)*(f_z[li-1][idx_z_BB] - double(4)*f_z[li-1][idx_z_B] +
-                                                                    double(6)*f_z[li-1][idx] - double(4)*f_z[li-1][idx_z_F] +
-                                                                    f_z[li-1][idx_z_FF]);
-                            }
-                        }
-                    }
-                    
-                    if (compute_variable_local_means)
-                    {
-                        for (int k = 0; k < interior_dim_2; k++)
-                        {
-                            for (int j = 0; j < interior_dim_1; j++)
-                            {
-#ifdef HAMERS_ENABLE_SIMD
-                                #pragma omp simd
-#endif
-                                for (int i = 0; i < interior_dim_0; i++)
-                                {
-                                    // Compute the linear indices.
-                                    const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_x_LL = (i - 2*offset + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_x_L = (i - offset + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_x_R = (i + offset + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_x_RR = (i + 2*offset + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_y_BB = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j - 2*offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_y_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j - offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_y_T = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_y_TT = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + 2*offset + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_z_BB = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k - 2*offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_z_B = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k - offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_z_F = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    const int idx_z_FF = (i + num_ghosts_0_wavelet_coeffs) +
-                                        (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                                        (k + 2*offset + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                            ghostcell_dim_1_wavelet_coeffs;
-                                    
-                                    double f_mean_x = f_x[li-1][idx_x_LL] + double(4)*f_x[li-1][idx_x_L] +
-                                        double(6)*f_x[li-1][idx] + double(4)*f_x[li-1][idx_x_R] + f_x[li-1][idx_x_RR];
-                                    
-                                    double f_mean_y = f_y[li-1][idx_y_BB] + double(4)*f_y[li-1][idx_y_B] +
-                                        double(6)*f_y[li-1][idx] + double(4)*f_y[li-1][idx_y_T] + f_y[li-1][idx_y_TT];
-                                    
-                                    double f_mean_z = f_z[li-1][idx_z_BB] + double(4)*f_z[li-1][idx_z_B] +
-                                        double(6)*f_z[li-1][idx] + double(4)*f_z[li-1][idx_z_F] + f_z[li-1][idx_z_FF];
-                                    
-                                    f_mean[li][idx] = double(1)/double(6)*sqrt(f_mean_x*f_mean_x + f_mean_y*f_mean_y +
-                                                                               f_mean_z*f_mean_z);
-                                }
-                            }
-                        }
-                    }
-                    
-                    break;
-                }
-                default:
-                {
-                    TBOX_ERROR(d_object_name
-                        << ": WaveletTransformHarten::computeWaveletCoefficientsWithVariableLocalMeans()\n"
-                        << "number of vanishing moments = "
-                        << d_k
-                        << " not supported."
-                        << std::endl);
-                }
-            }
-        }        
-        
-        /*
-         * Compute the three-dimensional wavelet coefficients from the one-dimensional wavelet coefficients.
-         */
-        
-        for (int li = 0; li < d_num_level; li++)
-        {
-            const int offset = pow(2, li + 1);
             
-            // Compute the starting and ending indices.
-            const int start_index_i = -d_p*offset;
-            const int end_index_i = interior_dim_0 + d_q*offset;
-            const int start_index_j = -d_p*offset;
-            const int end_index_j = interior_dim_1 + d_q*offset;
-            const int start_index_k = -d_p*offset;
-            const int end_index_k = interior_dim_2 + d_q*offset;
-            
-            for (int k = start_index_k; k < end_index_k; k++)
-            {
-                for (int j = start_index_j; j < end_index_j; j++)
-                {
-#ifdef HAMERS_ENABLE_SIMD
-                    #pragma omp simd
-#endif
-                    for (int i = start_index_i; i < end_index_i; i++)
-                    {
-                        const int idx = (i + num_ghosts_0_wavelet_coeffs) +
-                            (j + num_ghosts_1_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs +
-                            (k + num_ghosts_2_wavelet_coeffs)*ghostcell_dim_0_wavelet_coeffs*
-                                ghostcell_dim_1_wavelet_coeffs;
-                        
-                        w[li][idx] = sqrt(w_x[li][idx]*w_x[li][idx] + w_y[li][idx]*w_y[li][idx] +
-                                          w_z[li][idx]*w_z[li][idx]);
-                    }
-                }
-            }
+            std::swap(f_prev, f_next);
         }
     }
 }